@@ -234,6 +234,7 @@ HEADERS += \
     ./src/qt/notes_table_model.h \
     ./src/qt/outline_tree_model.h \
     ./src/qt/outlines_table_model.h \
+    ./src/qt/sortable_table_model.h \
     ./src/qt/model_meta_definitions.h \
     ./src/qt/note_view_model.h \
     ./src/qt/note_view_presenter.h \
@@ -288,6 +289,7 @@ HEADERS += \
     src/qt/dialogs/wingman_dialog.h \
     src/qt/dialogs/sync_library_dialog.h \
     src/qt/dialogs/terminal_dialog.h \
+    src/qt/dialogs/diagnostics_dialog.h \
     src/qt/kanban_column_model.h \
     src/qt/kanban_column_presenter.h \
     src/qt/kanban_column_view.h \
@@ -356,6 +358,7 @@ SOURCES += \
     ./src/qt/notes_table_model.cpp \
     ./src/qt/outline_tree_model.cpp \
     ./src/qt/outlines_table_model.cpp \
+    ./src/qt/sortable_table_model.cpp \
     ./src/qt/note_view_model.cpp \
     ./src/qt/note_view_presenter.cpp \
     ./src/qt/note_view.cpp \
@@ -409,6 +412,7 @@ SOURCES += \
     src/qt/dialogs/wingman_dialog.cpp \
     src/qt/dialogs/sync_library_dialog.cpp \
     src/qt/dialogs/terminal_dialog.cpp \
+    src/qt/dialogs/diagnostics_dialog.cpp \
     src/qt/kanban_column_model.cpp \
     src/qt/kanban_column_presenter.cpp \
     src/qt/kanban_column_view.cpp \
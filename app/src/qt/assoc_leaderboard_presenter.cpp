@@ -39,6 +39,7 @@ AssocLeaderboardPresenter::AssocLeaderboardPresenter(AssocLeaderboardView* view,
         SLOT(slotShowNote(const QItemSelection&, const QItemSelection&)));
 
     lastAssociations = nullptr;
+    leaderboardNote = nullptr;
 }
 
 AssocLeaderboardPresenter::~AssocLeaderboardPresenter()
@@ -61,6 +62,11 @@ void AssocLeaderboardPresenter::slotShowNote(const QItemSelection& selected, con
         note->incReads();
         note->makeDirty();
 
+        // user's choice is a training sample for associations assessment
+        if(leaderboardNote) {
+            orloj->getMind()->confirmAssociation(leaderboardNote, note, leaderboard);
+        }
+
         orloj->showFacetNoteView(note);
     } // else do nothing
 }
@@ -70,6 +76,13 @@ void AssocLeaderboardPresenter::refresh(AssociatedNotes* associations)
     if(associations->getAssociations()->size()) {
 
         lastAssociations = associations;
+        if(associations->getSourceType() == NOTE) {
+            leaderboardNote = associations->getNote();
+            leaderboard = *associations->getAssociations();
+        } else {
+            leaderboardNote = nullptr;
+            leaderboard.clear();
+        }
 
         switch(associations->getSourceType()) {
         case OUTLINE:
@@ -90,6 +103,8 @@ void AssocLeaderboardPresenter::refresh(AssociatedNotes* associations)
             model->addRow(i.first, i.second);
         }
     } else {
+        leaderboardNote = nullptr;
+        leaderboard.clear();
         model->removeAllRows();
     }
 
@@ -46,6 +46,10 @@ private:
 
     AssociatedNotes* lastAssociations;
 
+    // Note associations shown to user (copied as associations are deleted by caller)
+    const Note* leaderboardNote;
+    std::vector<std::pair<Note*,float>> leaderboard;
+
 public:
     explicit AssocLeaderboardPresenter(AssocLeaderboardView* view, OrlojPresenter* orloj);
     AssocLeaderboardPresenter(const AssocLeaderboardPresenter&) = delete;
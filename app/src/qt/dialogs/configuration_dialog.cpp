@@ -781,6 +781,10 @@ void ConfigurationDialog::WingmanTab::refresh()
         llmProvidersCombo->addItem(
             QString::fromStdString(openAiComboLabel), WingmanLlmProviders::WINGMAN_PROVIDER_OPENAI);
     }
+    if(config.canWingmanLlamaCpp()) {
+        llmProvidersCombo->addItem(
+            QString{"llama.cpp"}, WingmanLlmProviders::WINGMAN_PROVIDER_LLAMACPP);
+    }
     openAiApiKeyEdit->setText(QString::fromStdString(config.getWingmanOpenAiApiKey()));
     // set the last selected provider
     llmProvidersCombo->setCurrentIndex(
@@ -0,0 +1,145 @@
+/*
+ diagnostics_dialog.cpp     MindForger thinking notebook
+
+ Copyright (C) 2016-2025 Martin Dvorak <martin.dvorak@mindforger.com>
+
+ This program is free software; you can redistribute it and/or
+ modify it under the terms of the GNU General Public License
+ as published by the Free Software Foundation; either version 2
+ of the License, or (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+#include "diagnostics_dialog.h"
+
+using namespace std;
+
+namespace m8r {
+
+DiagnosticsDialog::DiagnosticsDialog(QWidget* parent)
+    : QDialog(parent)
+{
+    // widgets
+    label = new QLabel{
+        tr(
+            "Timers and counters of learning, parsing, search, rendering,\n"
+            "associations and persistence hot paths (times in milliseconds):"
+        ),
+        parent};
+
+    probesEdit = new QPlainTextEdit{this};
+    probesEdit->setReadOnly(true);
+    probesEdit->setLineWrapMode(QPlainTextEdit::NoWrap);
+    probesEdit->setFont(QFontDatabase::systemFont(QFontDatabase::FixedFont));
+
+    enabledCheck = new QCheckBox{tr("&Enable instrumentation")};
+
+    refreshButton = new QPushButton{tr("&Refresh")};
+    refreshButton->setDefault(true);
+    resetButton = new QPushButton{tr("Re&set")};
+    saveButton = new QPushButton{tr("Save &JSON...")};
+    closeButton = new QPushButton{tr("&Close")};
+
+    // signals
+    QObject::connect(
+        refreshButton, SIGNAL(clicked()),
+        this, SLOT(handleRefresh()));
+    QObject::connect(
+        resetButton, SIGNAL(clicked()),
+        this, SLOT(handleReset()));
+    QObject::connect(
+        saveButton, SIGNAL(clicked()),
+        this, SLOT(handleSave()));
+    QObject::connect(
+        enabledCheck, SIGNAL(toggled(bool)),
+        this, SLOT(handleEnabled(bool)));
+    QObject::connect(
+        closeButton, SIGNAL(clicked()),
+        this, SLOT(close()));
+
+    // assembly
+    QVBoxLayout* mainLayout = new QVBoxLayout{};
+    mainLayout->addWidget(label);
+    mainLayout->addWidget(probesEdit);
+    mainLayout->addWidget(enabledCheck);
+
+    QHBoxLayout* buttonLayout = new QHBoxLayout{};
+    buttonLayout->addStretch(1);
+    buttonLayout->addWidget(closeButton);
+    buttonLayout->addWidget(saveButton);
+    buttonLayout->addWidget(resetButton);
+    buttonLayout->addWidget(refreshButton);
+    buttonLayout->addStretch();
+
+    mainLayout->addLayout(buttonLayout);
+    setLayout(mainLayout);
+
+    // dialog
+    setWindowTitle(tr("Diagnostics"));
+    resize(fontMetrics().averageCharWidth()*120, fontMetrics().height()*30);
+    setModal(true);
+}
+
+DiagnosticsDialog::~DiagnosticsDialog()
+{
+    delete label;
+    delete probesEdit;
+    delete enabledCheck;
+    delete refreshButton;
+    delete resetButton;
+    delete saveButton;
+    delete closeButton;
+}
+
+void DiagnosticsDialog::show()
+{
+    enabledCheck->setChecked(Instrumentation::isEnabled());
+    handleRefresh();
+
+    QDialog::show();
+}
+
+void DiagnosticsDialog::handleRefresh()
+{
+    probesEdit->setPlainText(QString::fromStdString(Instrumentation::toString()));
+}
+
+void DiagnosticsDialog::handleReset()
+{
+    Instrumentation::reset();
+    handleRefresh();
+}
+
+void DiagnosticsDialog::handleSave()
+{
+    QString fileName = QFileDialog::getSaveFileName(
+        this,
+        tr("Save Diagnostics"),
+        QString{"mindforger-diagnostics.json"},
+        tr("JSON (*.json)"));
+    if(!fileName.isEmpty()) {
+        QFile file{fileName};
+        if(file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+            file.write(QByteArray::fromStdString(Instrumentation::toJson()));
+            file.close();
+        } else {
+            QMessageBox::critical(
+                this,
+                tr("Save Diagnostics"),
+                tr("Unable to write diagnostics to file '%1'").arg(fileName));
+        }
+    }
+}
+
+void DiagnosticsDialog::handleEnabled(bool enabled)
+{
+    Instrumentation::setEnabled(enabled);
+}
+
+} // m8r namespace
@@ -0,0 +1,65 @@
+/*
+ diagnostics_dialog.h     MindForger thinking notebook
+
+ Copyright (C) 2016-2025 Martin Dvorak <martin.dvorak@mindforger.com>
+
+ This program is free software; you can redistribute it and/or
+ modify it under the terms of the GNU General Public License
+ as published by the Free Software Foundation; either version 2
+ of the License, or (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+#ifndef M8RUI_DIAGNOSTICS_DIALOG_H
+#define M8RUI_DIAGNOSTICS_DIALOG_H
+
+#include "../../lib/src/gear/instrumentation.h"
+
+#include <QtWidgets>
+
+namespace m8r {
+
+/**
+ * @brief Diagnostics dialog showing hot path instrumentation probes.
+ *
+ * The dialog is instantiated in main window presenter.
+ */
+class DiagnosticsDialog : public QDialog
+{
+    Q_OBJECT
+
+private:
+    QLabel* label;
+    QPlainTextEdit* probesEdit;
+    QCheckBox* enabledCheck;
+
+    QPushButton* refreshButton;
+    QPushButton* resetButton;
+    QPushButton* saveButton;
+    QPushButton* closeButton;
+
+public:
+    explicit DiagnosticsDialog(QWidget* parent);
+    DiagnosticsDialog(const DiagnosticsDialog&) = delete;
+    DiagnosticsDialog(const DiagnosticsDialog&&) = delete;
+    DiagnosticsDialog& operator=(const DiagnosticsDialog&) = delete;
+    DiagnosticsDialog& operator=(const DiagnosticsDialog&&) = delete;
+    ~DiagnosticsDialog();
+
+    void show();
+
+private slots:
+    void handleRefresh();
+    void handleReset();
+    void handleSave();
+    void handleEnabled(bool enabled);
+};
+
+}
+#endif // M8RUI_DIAGNOSTICS_DIALOG_H
@@ -64,6 +64,8 @@ ExportCsvFileDialog::ExportCsvFileDialog(
     oheTagsCardinalitySpin->setMinimum(DEFAULT_OHE_CARDINALITY);
     oheTagsCardinalitySpin->setMaximum(10000);
 
+    columnarCheck = new QCheckBox(tr("export columnar binary format for ML"), this);
+
     // IMPROVE disable/enable find button if text/path is valid: freedom vs validation
     exportButton = new QPushButton{tr("Export")};
     exportButton->setDefault(true);
@@ -76,6 +78,9 @@ ExportCsvFileDialog::ExportCsvFileDialog(
     QObject::connect(
         oheTagsCheck, SIGNAL(clicked(bool)),
         this, SLOT(enableDisableOheCardinality(bool)));
+    QObject::connect(
+        columnarCheck, SIGNAL(clicked(bool)),
+        this, SLOT(refreshPath()));
     QObject::connect(
         fileNameEdit, SIGNAL(textChanged(const QString&)),
         this, SLOT(refreshPath()));
@@ -107,6 +112,7 @@ ExportCsvFileDialog::ExportCsvFileDialog(
     mainLayout->addWidget(oheTagsCheck);
     mainLayout->addWidget(oheTagsCardinalityLabel);
     mainLayout->addWidget(oheTagsCardinalitySpin);
+    mainLayout->addWidget(columnarCheck);
 
     QHBoxLayout* buttonLayout = new QHBoxLayout{};
     buttonLayout->addStretch(1);
@@ -136,6 +142,7 @@ void ExportCsvFileDialog::show()
 #else
     dirEdit->setText(homeDirectory);
 #endif
+    columnarCheck->setChecked(false);
 
     refreshPath();
 
@@ -167,7 +174,10 @@ void ExportCsvFileDialog::refreshPath()
         name = QString::fromStdString(normalizeToNcName(name.toStdString(),'-'));
     }
     // path = dir + name
-    QString path = directory+name+extension;
+    QString path = directory+name+(
+        columnarCheck->isChecked()
+        ?QString::fromStdString(File::EXTENSION_MFCOL)
+        :extension);
 
     pathEdit->setText(path);
 }
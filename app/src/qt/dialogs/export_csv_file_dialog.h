@@ -50,6 +50,8 @@ protected:
     QLabel* oheTagsCardinalityLabel;
     QSpinBox* oheTagsCardinalitySpin;
 
+    QCheckBox* columnarCheck;
+
     QPushButton* exportButton;
     QPushButton* closeButton;
 
@@ -67,6 +69,7 @@ public:
     QString getFilePath() const { return pathEdit->text(); }
     bool isOheTags() const { return oheTagsCheck->isChecked(); }
     int getOheTagsCardinality() const { return oheTagsCardinalitySpin->value(); }
+    bool isColumnar() const { return columnarCheck->isChecked(); }
 
 private slots:
     void enableDisableOheCardinality(bool enable);
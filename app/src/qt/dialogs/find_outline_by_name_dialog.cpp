@@ -29,8 +29,10 @@ FindOutlineByNameDialog::FindOutlineByNameDialog(QWidget *parent)
 {
     // widgets
     listView = new QListView(this);
-    // list view model must be set - use of this type of mode enable the use of string lists controlling its content
-    listView->setModel(&listViewModel);
+    // list view model shows matches only - rows are not hidden one by one
+    listViewModel = new MatchesListModel(listViewStrings, this);
+    listView->setModel(listViewModel);
+    listView->setUniformItemSizes(true);
     // disable editation of the list item on doble click
     listView->setEditTriggers(QAbstractItemView::NoEditTriggers);
 
@@ -57,6 +59,8 @@ FindOutlineByNameDialog::FindOutlineByNameDialog(QWidget *parent)
     // signals
     connect(lineEdit, SIGNAL(textChanged(const QString &)), this, SLOT(enableFindButton(const QString&)));
     connect(lineEdit, SIGNAL(returnPressed()), this, SLOT(handleReturn()));
+    connect(caseCheckBox, SIGNAL(stateChanged(int)), this, SLOT(refreshMatches()));
+    connect(keywordsCheckBox, SIGNAL(stateChanged(int)), this, SLOT(refreshMatches()));
     connect(findButton, SIGNAL(clicked()), this, SLOT(handleChoice()));
     connect(closeButton, SIGNAL(clicked()), this, SLOT(close()));
 
@@ -90,6 +94,7 @@ FindOutlineByNameDialog::~FindOutlineByNameDialog()
     delete label;
     delete lineEdit;
     delete listView;
+    delete listViewModel;
     delete caseCheckBox;
     delete findButton;
     delete closeButton;
@@ -111,89 +116,62 @@ void FindOutlineByNameDialog::show(
         scopeCheckBox->setVisible(false);
     }
 
+    // names are converted and case folded once - keystrokes just query the finder
+    matches.clear();
+    listViewModel->setMatches(matches);
     things.clear();
     listViewStrings.clear();
+    finder.clear();
     bool useCustomNames = customizedNames!=nullptr && customizedNames->size()>0;
     if(ts.size()) {
+        listViewStrings.reserve(static_cast<int>(ts.size()));
         for(size_t i=0; i<ts.size(); i++) {
             things.push_back(ts[i]);
             if(useCustomNames) {
                 listViewStrings << QString::fromStdString(customizedNames->at(i));
             } else {
-                if(ts.at(i)->getName().size()) {
-                    listViewStrings << QString::fromStdString(ts[i]->getName());
-                } else {
-                    listViewStrings << "";
-                }
+                listViewStrings << QString::fromStdString(ts[i]->getName());
             }
+            finder.add(ts[i]->getName());
         }
-        ((QStringListModel*)listView->model())->setStringList(listViewStrings);
     }
 
-    findButton->setEnabled(things.size());
-
     if(init) {
         lineEdit->clear();
         lineEdit->setFocus();
-    } else {
-        enableFindButton(lineEdit->text());
     }
+    enableFindButton(lineEdit->text());
 
     QDialog::show();
 }
 
 void FindOutlineByNameDialog::enableFindButton(const QString& text)
 {
-    listViewStrings.clear();
-    if(!text.isEmpty()) {
-        if(keywordsCheckBox->isEnabled() && keywordsCheckBox->isChecked()) {
-            int visible = 0;
-            int row = 0;
-            for(Thing* e:things) {
-                QString s = QString::fromStdString(e->getName());
-                if(stringMatchByKeywords(text, s, caseCheckBox->isChecked())) {
-                    listView->setRowHidden(row, false);
-                    visible++;
-                } else {
-                    listView->setRowHidden(row, true);
-                }
-                row++;
-            }
-            findButton->setEnabled(visible);
-        } else {
-            Qt::CaseSensitivity c = caseCheckBox->isChecked()?Qt::CaseInsensitive:Qt::CaseSensitive;
-            // IMPROVE find a list view method giving # of visible rows
-            int visible = 0;
-            int row = 0;
-            for(Thing* e:things) {
-                QString s = QString::fromStdString(e->getName());
-                if(s.startsWith(text,c)) {
-                    listView->setRowHidden(row, false);
-                    visible++;
-                } else {
-                    listView->setRowHidden(row, true);
-                }
-                row++;
-            }
-            findButton->setEnabled(visible);
-        }
-    } else {
-        for(size_t row = 0; row<things.size(); row++) {
-            listView->setRowHidden(row, false);
-        }
-        findButton->setEnabled(things.size());
-    }
+    FuzzyFinder::Mode mode
+        = keywordsCheckBox->isEnabled() && keywordsCheckBox->isChecked()
+        ? FuzzyFinder::Mode::KEYWORDS
+        : FuzzyFinder::Mode::PREFIX;
+    finder.find(
+        text.toStdString(),
+        mode,
+        caseCheckBox->isChecked(),
+        text.isEmpty()? things.size(): MAX_MATCHES,
+        matches);
+    listViewModel->setMatches(matches);
+
+    findButton->setEnabled(listViewModel->rowCount());
+}
+
+void FindOutlineByNameDialog::refreshMatches()
+{
+    enableFindButton(lineEdit->text());
 }
 
 void FindOutlineByNameDialog::handleReturn()
 {
     if(findButton->isEnabled()) {
-        for(size_t row = 0; row<things.size(); row++) {
-            if(!listView->isRowHidden(row)) {
-                choice = things[row];
-                break;
-            }
-        }
+        // the first row is the best match
+        choice = things[listViewModel->getNameIndex(0)];
 
         QDialog::close();
         emit searchFinished();
@@ -203,7 +181,7 @@ void FindOutlineByNameDialog::handleReturn()
 void FindOutlineByNameDialog::handleChoice()
 {
     if(listView->currentIndex().isValid()) {
-        choice = things[listView->currentIndex().row()];
+        choice = things[listViewModel->getNameIndex(listView->currentIndex().row())];
 
         QDialog::close();
         emit searchFinished();
@@ -24,6 +24,7 @@
 #include <QtWidgets>
 
 #include "../../lib/src/mind/ontology/thing_class_rel_triple.h"
+#include "../../lib/src/gear/fuzzy_finder.h"
 
 namespace m8r {
 
@@ -41,12 +42,9 @@ class FindOutlineByNameDialog : public QDialog
         {}
         void keyPressEvent(QKeyEvent* event) override {
             if(event->key() == Qt::Key_Down) {
-                // find the first visible row
-                for(int row = 0; row<target->model()->rowCount(); row++) {
-                    if(!target->isRowHidden(row)) {
-                        target->setCurrentIndex(target->model()->index(row,0));
-                        break;
-                    }
+                // the first row is the best match
+                if(target->model()->rowCount()) {
+                    target->setCurrentIndex(target->model()->index(0,0));
                 }
                 target->setFocus();
             }
@@ -54,17 +52,54 @@ class FindOutlineByNameDialog : public QDialog
         }
     };
 
+    /**
+     * @brief List model which shows (top) matches only.
+     */
+    class MatchesListModel : public QAbstractListModel
+    {
+    private:
+        const QList<QString>& names;
+        std::vector<FuzzyFinder::Match> matches;
+    public:
+        explicit MatchesListModel(const QList<QString>& names, QObject* parent)
+            : QAbstractListModel(parent), names(names)
+        {}
+        int rowCount(const QModelIndex& parent=QModelIndex()) const override {
+            return parent.isValid()? 0: static_cast<int>(matches.size());
+        }
+        QVariant data(const QModelIndex& index, int role=Qt::DisplayRole) const override {
+            if(index.isValid() && role == Qt::DisplayRole && index.row() < rowCount()) {
+                return names[static_cast<int>(matches[index.row()].index)];
+            }
+            return QVariant{};
+        }
+        size_t getNameIndex(int row) const { return matches[row].index; }
+        /**
+         * @brief Replace matches by the new ones.
+         */
+        void setMatches(std::vector<FuzzyFinder::Match>& newMatches) {
+            beginResetModel();
+            matches.swap(newMatches);
+            endResetModel();
+        }
+    };
+
+    // maximum number of (best) matches shown for non-empty search string
+    static constexpr size_t MAX_MATCHES = 1000;
+
 private:
     MyLineEdit* lineEdit;
     QListView* listView;
     QList<QString> listViewStrings;
-    QStringListModel listViewModel;
+    MatchesListModel* listViewModel;
     QCheckBox* caseCheckBox;
     QCheckBox* keywordsCheckBox;
     QPushButton* closeButton;
 
     Thing* choice;
     std::vector<Thing*> things;
+    FuzzyFinder finder;
+    std::vector<FuzzyFinder::Match> matches;
 
 protected:
     QLabel* label;
@@ -98,6 +133,7 @@ signals:
 
 private slots:
     void enableFindButton(const QString &text);
+    void refreshMatches();
     void handleChoice();
     void handleReturn();
 };
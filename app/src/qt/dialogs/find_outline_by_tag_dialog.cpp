@@ -148,7 +148,7 @@ void FindOutlineByTagDialog::handleTagsChanged()
     if(choosenTags.size()) {
         int visible = 0;
         for(Thing* e:things) {
-            const std::vector<const Tag*>* thingTags;
+            const TagVector* thingTags;
             if(mode==ThingsMode::OUTLINES) {
                 Outline* o = static_cast<Outline*>(e);
                 thingTags = o->getTags();
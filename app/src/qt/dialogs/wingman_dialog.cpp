@@ -31,7 +31,8 @@ WingmanDialog::WingmanDialog(QWidget* parent)
   firstRun{true},
   mode{WingmanDialogModes::WINGMAN_DIALOG_MODE_TEXT},
   context{},
-  lastAnswer{}
+  lastAnswer{},
+  streamedAnswerPosition{-1}
 {
     setWindowTitle(tr("Wingman Chat"));
 
@@ -400,6 +401,29 @@ void WingmanDialog::appendAnswerToChat(
     chatWindow->ensureCursorVisible();
 }
 
+void WingmanDialog::setStreamedAnswer(const string& answer)
+{
+    clearStreamedAnswer();
+
+    chatWindow->moveCursor(QTextCursor::End);
+    streamedAnswerPosition = chatWindow->textCursor().position();
+    chatWindow->insertPlainText(QString::fromStdString(answer));
+
+    chatWindow->moveCursor(QTextCursor::End);
+    chatWindow->ensureCursorVisible();
+}
+
+void WingmanDialog::clearStreamedAnswer()
+{
+    if(streamedAnswerPosition >= 0) {
+        QTextCursor cursor = chatWindow->textCursor();
+        cursor.setPosition(streamedAnswerPosition);
+        cursor.movePosition(QTextCursor::End, QTextCursor::KeepAnchor);
+        cursor.removeSelectedText();
+        streamedAnswerPosition = -1;
+    }
+}
+
 void WingmanDialog::runPrompt()
 {
     // TODO help
@@ -75,6 +75,8 @@ private:
     QString context;
     QString lastPromptLabel;
     std::string lastAnswer;
+    // chat window position where streamed answer preview starts (-1 if none)
+    int streamedAnswerPosition;
 
     QTextEdit* chatWindow;
 
@@ -125,6 +127,12 @@ public:
         const std::string& answerDescriptor,
         const WingmanDialogModes& contextType,
         bool error=false);
+    /**
+     * @brief Show partial answer as it is being streamed - the preview is
+     * replaced by the next call and removed by clearStreamedAnswer().
+     */
+    void setStreamedAnswer(const std::string& answer);
+    void clearStreamedAnswer();
 
     void setPromptsLabel(const QString& label) {
         lastPromptLabel = promptsLabel->text();
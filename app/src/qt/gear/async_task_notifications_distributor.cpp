@@ -44,6 +44,10 @@ AsyncTaskNotificationsDistributor::AsyncTaskNotificationsDistributor(MainWindowP
     QObject::connect(
         this, SIGNAL(signalRefreshCurrentNotePreview()),
         mwp->getOrloj(), SLOT(slotRefreshCurrentNotePreview()));
+
+    QObject::connect(
+        this, SIGNAL(signalLearnRepositoryChanges()),
+        mwp, SLOT(slotLearnRepositoryChanges()));
 }
 
 AsyncTaskNotificationsDistributor::~AsyncTaskNotificationsDistributor()
@@ -67,6 +71,9 @@ void AsyncTaskNotificationsDistributor::run()
     while(true) {
         msleep(static_cast<unsigned long>(sleepInterval));
 
+        // files changed outside of MindForger are learned by Mind in the main thread
+        emit signalLearnRepositoryChanges();
+
 
 
         /*
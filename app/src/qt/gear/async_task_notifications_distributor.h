@@ -119,6 +119,7 @@ signals:
     void refreshHeaderLeaderboardByValue(AssociatedNotes* associations);
     void refreshLeaderboardByValue(AssociatedNotes* associations);
     void signalRefreshCurrentNotePreview();
+    void signalLearnRepositoryChanges();
 
 public slots:
     void slotConfigurationUpdated();
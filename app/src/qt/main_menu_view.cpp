@@ -1061,6 +1061,9 @@ MainMenuView::MainMenuView(MainWindowView& mainWindowView)
     actionHelpCheckForUpdates = new QAction(QIcon(":/menu-icons/download.svg"), tr("&Check for Updates"), mainWindow);
     actionHelpCheckForUpdates->setStatusTip(tr("Check for MindForger updates"));
 
+    actionHelpDiagnostics = new QAction(QIcon(":/menu-icons/bug.svg"), tr("&Diagnostics"), mainWindow);
+    actionHelpDiagnostics->setStatusTip(tr("Show learning, search, rendering and persistence timers"));
+
     actionHelpAboutQt = new QAction(QIcon(":/menu-icons/about_qt.svg"), tr("About &Qt"), mainWindow);
     actionHelpAboutQt->setStatusTip(tr("About Qt..."));
 
@@ -1073,6 +1076,7 @@ MainMenuView::MainMenuView(MainWindowView& mainWindowView)
     menuHelp->addSeparator();
     menuHelp->addAction(actionHelpReportBug);
     menuHelp->addAction(actionHelpCheckForUpdates);
+    menuHelp->addAction(actionHelpDiagnostics);
     menuHelp->addSeparator();
     menuHelp->addAction(actionHelpMarkdown);
     menuHelp->addAction(actionHelpMathQuickReference);
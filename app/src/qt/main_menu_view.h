@@ -280,6 +280,7 @@ public:
     QAction* actionHelpReportBug;
     QAction* actionHelpCheckForUpdates;
     QAction* actionHelpAboutQt;
+    QAction* actionHelpDiagnostics;
     QAction* actionHelpAbout;
 
     void showModeAwareFacet(bool repositoryMode, bool mfMode);
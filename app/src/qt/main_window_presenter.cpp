@@ -29,17 +29,22 @@ namespace m8r {
 
 MainWindowPresenter::MainWindowPresenter(MainWindowView& view)
     : view(view),
-      config(Configuration::getInstance())
+      config(Configuration::getInstance()),
+      repositoryChangedOutline{nullptr},
+      repositoryChangedOutlineUnlearned{false},
+      libraryScanWatcher{nullptr}
 {
     mind = new Mind{config};
+    mind->addRepositoryChangeListener(this);
 
     // representations
     this->htmlRepresentation
         = mind->getHtmlRepresentation();
     this->mdRepresentation
         = &htmlRepresentation->getMarkdownRepresentation();
+    // debounced configuration persistence shared w/ Mind
     this->mdConfigRepresentation
-        = new MarkdownConfigurationRepresentation{};
+        = mind->getConfigurationStore();
     this->mdRepositoryConfigRepresentation
         = new MarkdownRepositoryConfigurationRepresentation{};
     this->mdDocumentRepresentation
@@ -74,6 +79,7 @@ MainWindowPresenter::MainWindowPresenter(MainWindowView& view)
     refactorNoteToOutlineDialog = new RefactorNoteToOutlineDialog{&view};
     configDialog = new ConfigurationDialog{&view};
     terminalDialog = new TerminalDialog{&view};
+    diagnosticsDialog = new DiagnosticsDialog{&view};
     insertImageDialog = new InsertImageDialog{&view};
     insertLinkDialog = new InsertLinkDialog{&view};
     rowsAndDepthDialog = new RowsAndDepthDialog(&view);
@@ -222,10 +228,16 @@ MainWindowPresenter::MainWindowPresenter(MainWindowView& view)
 
     // let Mind to learn active repository & preserve desired state
     mind->learn();
+    // learn files changed outside of MindForger
+    mind->repositoryWatch();
 }
 
 MainWindowPresenter::~MainWindowPresenter()
 {
+    if(libraryScanWatcher) {
+        // worker thread uses library information source and repository
+        libraryScanWatcher->waitForFinished();
+    }
     if(mind) delete mind;
     if(mainMenu) delete mainMenu;
     if(statusBar) delete statusBar;
@@ -242,7 +254,6 @@ MainWindowPresenter::~MainWindowPresenter()
     if(newLibraryDialog) delete newLibraryDialog;
     if(wingmanDialog) delete wingmanDialog;
 
-    delete this->mdConfigRepresentation;
     delete this->mdRepositoryConfigRepresentation;
     delete this->mdDocumentRepresentation;
 }
@@ -275,7 +286,7 @@ void MainWindowPresenter::showInitialView()
                 if(!string{START_TO_OUTLINES}.compare(config.getStartupView())) {
                     orloj->showFacetOutlineList(mind->getOutlines());
                 } else if(!string{START_TO_OUTLINES_TREE}.compare(config.getStartupView())) {
-                    orloj->showFacetOutlinesMap(mind->outlinesMapGet());
+                    orloj->showFacetOutlinesMap();
                 } else if(!string{START_TO_TAGS}.compare(config.getStartupView())) {
                     orloj->showFacetTagCloud();
                 } else if(!string{START_TO_RECENT}.compare(config.getStartupView())) {
@@ -742,6 +753,50 @@ void MainWindowPresenter::doActionMindLearnRepository()
     } // else directory closed / nothing choosen
 }
 
+void MainWindowPresenter::slotLearnRepositoryChanges()
+{
+    // changes are queued by the watcher until the user leaves editors and dialogs
+    if(!mind->isRepositoryWatched()
+       || orloj->isFacetActive(OrlojPresenterFacets::FACET_EDIT_NOTE)
+       || orloj->isFacetActive(OrlojPresenterFacets::FACET_EDIT_OUTLINE_HEADER)
+       || QApplication::activeModalWidget())
+    {
+        return;
+    }
+
+    repositoryChangedOutline = nullptr;
+    repositoryChangedOutlineUnlearned = false;
+    size_t changes = mind->repositoryLearnChanges(0);
+    if(changes) {
+        bool outlineViewActive
+            = orloj->isFacetActive(OrlojPresenterFacets::FACET_VIEW_OUTLINE)
+              || orloj->isFacetActive(OrlojPresenterFacets::FACET_VIEW_OUTLINE_HEADER)
+              || orloj->isFacetActive(OrlojPresenterFacets::FACET_VIEW_NOTE);
+        if(outlineViewActive && repositoryChangedOutline) {
+            orloj->showFacetOutline(repositoryChangedOutline);
+        } else if(!outlineViewActive || repositoryChangedOutlineUnlearned) {
+            // other views may refer to replaced Os/Ns > show refreshed Os
+            orloj->showFacetOutlineList(mind->getOutlines());
+        }
+        statusBar->showInfo(
+            tr("Learned %1 change(s) made outside of MindForger").arg(changes));
+    }
+}
+
+void MainWindowPresenter::learned(Outline* outline, Outline* replaced)
+{
+    if(replaced && replaced==orloj->getOutlineView()->getCurrentOutline()) {
+        repositoryChangedOutline = outline;
+    }
+}
+
+void MainWindowPresenter::unlearned(Outline* outline)
+{
+    if(outline==orloj->getOutlineView()->getCurrentOutline()) {
+        repositoryChangedOutlineUnlearned = true;
+    }
+}
+
 void MainWindowPresenter::doActionMindLearnFile()
 {
     QString homeDirectory
@@ -774,6 +829,7 @@ void MainWindowPresenter::doActionMindRelearn(QString path)
         mdConfigRepresentation->save(config);
         // learn and show
         mind->learn();
+        mind->repositoryWatch();
         showInitialView();
     } else {
         QMessageBox::critical(
@@ -1135,7 +1191,7 @@ void MainWindowPresenter::doActionViewOutlinesMap()
          &&
        config.getActiveRepository()->getMode()==Repository::RepositoryMode::REPOSITORY)
     {
-        orloj->showFacetOutlinesMap(mind->outlinesMapGet());
+        orloj->showFacetOutlinesMap();
     }
 }
 
@@ -1782,10 +1838,8 @@ void MainWindowPresenter::doActionOpenRunToolDialog(
         else if(orloj->isFacetActive(OrlojPresenterFacets::FACET_LIST_OUTLINES)) {
             int row = orloj->getOutlinesTable()->getCurrentRow();
             if(row != OutlinesTablePresenter::NO_ROW) {
-                QStandardItem* item
-                    = orloj->getOutlinesTable()->getModel()->item(row);
-                if(item) {
-                    Outline* outline = item->data(Qt::UserRole + 1).value<Outline*>();
+                Outline* outline = orloj->getOutlinesTable()->getModel()->getOutline(row);
+                if(outline) {
                     phrase = QString::fromStdString(outline->getName());
                 }
             }
@@ -2043,20 +2097,16 @@ void MainWindowPresenter::handleActionWingman(bool showDialog)
     } else if(orloj->isFacetActive(OrlojPresenterFacets::FACET_LIST_OUTLINES)) {
         int row = orloj->getOutlinesTable()->getCurrentRow();
         if(row != OutlinesTablePresenter::NO_ROW) {
-            QStandardItem* item
-                = orloj->getOutlinesTable()->getModel()->item(row);
-            if(item) {
-                Outline* o = item->data(Qt::UserRole + 1).value<Outline*>();
-                if(o) {
-                    contextTextName = QString::fromStdString(o->getName());
-                    string contextTextStr{};
-                    auto oFormat = o->getFormat();
-                    o->setFormat(MarkdownDocument::Format::MARKDOWN);
-                    mdRepresentation->to(o, &contextTextStr);
-                    o->setFormat(oFormat);
-                    contextText = QString::fromStdString(contextTextStr);
-                    contextType = WingmanDialogModes::WINGMAN_DIALOG_MODE_OUTLINE;
-                }
+            Outline* o = orloj->getOutlinesTable()->getModel()->getOutline(row);
+            if(o) {
+                contextTextName = QString::fromStdString(o->getName());
+                string contextTextStr{};
+                auto oFormat = o->getFormat();
+                o->setFormat(MarkdownDocument::Format::MARKDOWN);
+                mdRepresentation->to(o, &contextTextStr);
+                o->setFormat(oFormat);
+                contextText = QString::fromStdString(contextTextStr);
+                contextType = WingmanDialogModes::WINGMAN_DIALOG_MODE_OUTLINE;
             }
         }
     } else if(orloj->isFacetActive(OrlojPresenterFacets::FACET_MAP_OUTLINES)) {
@@ -2098,12 +2148,50 @@ void MainWindowPresenter::handleActionWingman(bool showDialog)
     }
 }
 
+/**
+ * @brief Wingman chat listener which collects streamed answer tokens
+ * for the (main thread) Wingman dialog preview.
+ */
+class WingmanDialogChatListener : public WingmanChatListener
+{
+private:
+    mutex answerMutex;
+    string answer;
+    bool changed;
+
+public:
+    explicit WingmanDialogChatListener()
+        : answerMutex{}, answer{}, changed{false}
+    {}
+    WingmanDialogChatListener(const WingmanDialogChatListener&) = delete;
+    WingmanDialogChatListener(const WingmanDialogChatListener&&) = delete;
+    WingmanDialogChatListener& operator =(const WingmanDialogChatListener&) = delete;
+    WingmanDialogChatListener& operator =(const WingmanDialogChatListener&&) = delete;
+    virtual ~WingmanDialogChatListener() {}
+
+    virtual bool onToken(const string& token) override {
+        lock_guard<mutex> criticalSection{answerMutex};
+        answer.append(token);
+        changed = true;
+        return !isCancelled();
+    }
+
+    /**
+     * @brief Get answer streamed so far - false if nothing changed since the last call.
+     */
+    bool getAnswer(string& answer) {
+        lock_guard<mutex> criticalSection{answerMutex};
+        if(changed) {
+            answer = this->answer;
+            changed = false;
+            return true;
+        }
+        return false;
+    }
+};
+
 void MainWindowPresenter::slotRunWingmanFromDialog(bool showDialog)
 {
-    return;
-    /*
-    bool runAsynchronously = true;
-
     // pull prompt from the dialog & prepare prompt from the dialog
     string prompt = this->wingmanDialog->getPrompt();
 
@@ -2125,101 +2213,88 @@ void MainWindowPresenter::slotRunWingmanFromDialog(bool showDialog)
     this->wingmanDialog->setPromptsLabel(promptLabel);
     statusBar->showInfo(promptLabel);
 
-    // run
-    CommandWingmanChat commandWingmanChat{
-        prompt,
-        "",
-        WingmanStatusCode::WINGMAN_STATUS_CODE_OK,
-        "",
-        "",
-        0,
-        0,
-        ""
-    };
+    // command and listener are shared w/ the streaming thread
+    shared_ptr<CommandWingmanChat> commandWingmanChat = make_shared<CommandWingmanChat>(
+        CommandWingmanChat{
+            prompt,
+            "",
+            WingmanStatusCode::WINGMAN_STATUS_CODE_OK,
+            "",
+            "",
+            0,
+            0,
+            "",
+            false
+        });
+    shared_ptr<WingmanDialogChatListener> listener
+        = make_shared<WingmanDialogChatListener>();
+
     // measure time
     auto start = std::chrono::high_resolution_clock::now();
-    if(runAsynchronously) {
-        const int progressStep = 100; // 100ms
-        const int progressLimit = progressStep*10*30; // 30s
-        int progress = 0;
-
-        // hint maximum: progressLimit to show progress steps, 0 to show animated
-        this->wingmanDialog->resetProgress(0);
-        this->wingmanDialog->setProgressVisible(true);
-
-        QFuture<CommandWingmanChat> future = QtConcurrent::run(
-            this->mind,
-            &Mind::wingmanChat,
-            commandWingmanChat);
-
-        // wait for the future to finish
-        QFutureWatcher<void> futureWatcher{};
-        futureWatcher.setFuture(future);
-        // blocking wait: futureWatcher.waitForFinished();
-
-        // hint: the purpose of progress is not to cancel the run in case of time out,
-        // but just to visualize a progress...
-        while(!futureWatcher.isFinished() && progress < progressLimit) {
-            MF_DEBUG(
-                progress << "/" << progressLimit <<
-                " Wingman is talking to the GPT provider..." << endl
-            );
-            QApplication::processEvents();
-            QThread::msleep(progressStep); // portable sleep
-            progress += progressStep;
-            this->wingmanDialog->setProgressValue(progress);
-        }
-        this->wingmanDialog->setProgressValue(progressLimit);
 
-        commandWingmanChat = future.result();
+    const int progressStep = 100; // 100ms
+    const int progressLimit = progressStep*10*30; // 30s
+    int progress = 0;
 
-        // HIDE progress dialog
-        this->wingmanDialog->setProgressVisible(false);
+    // hint maximum: progressLimit to show progress steps, 0 to show animated
+    this->wingmanDialog->resetProgress(0);
+    this->wingmanDialog->setProgressVisible(true);
 
-        // check the result
-        if (future.isFinished()) {
-            statusBar->showInfo(QString(tr("Wingman received an answer from the GPT provider")));
-        } else {
-            statusBar->showError(QString(tr("Wingman failed to receive an answer from the GPT provider")));
-
-            // PUSH answer to the chat dialog
-            this->wingmanDialog->appendAnswerToChat(
-                "Wingman failed to get answer from the GPT provider.<br/><br/>"+commandWingmanChat.answerMarkdown,
-                "",
-                this->wingmanDialog->getContextType(),
-                true
-            );
+    shared_future<bool> result = mind->wingmanChatStream(commandWingmanChat, listener);
 
-            return;
+    // show answer tokens as they arrive, the request is cancelled on time out
+    string streamedAnswer{};
+    while(result.wait_for(chrono::milliseconds(0)) != future_status::ready) {
+        if(progress >= progressLimit) {
+            listener->cancel();
+            result.wait();
+            break;
+        }
+        if(listener->getAnswer(streamedAnswer)) {
+            this->wingmanDialog->setStreamedAnswer(streamedAnswer);
         }
+        QApplication::processEvents();
+        QThread::msleep(progressStep); // portable sleep
+        progress += progressStep;
+        this->wingmanDialog->setProgressValue(progress);
+    }
+    this->wingmanDialog->setProgressValue(progressLimit);
+    this->wingmanDialog->clearStreamedAnswer();
+
+    // HIDE progress dialog
+    this->wingmanDialog->setProgressVisible(false);
+
+    if(result.get()) {
+        statusBar->showInfo(QString(tr("Wingman received an answer from the GPT provider")));
     } else {
-        mind->wingmanChat(commandWingmanChat);
+        statusBar->showError(QString(tr("Wingman failed to receive an answer from the GPT provider")));
     }
+
     auto end = std::chrono::high_resolution_clock::now();
     auto duration = std::chrono::duration_cast<std::chrono::seconds>(end - start);
-    // wingmanProgressDialog->hide();
     string answerDescriptor{
-        "[model: " + commandWingmanChat.answerLlmModel +
+        "[model: " + commandWingmanChat->answerLlmModel +
         ", tokens (prompt/answer): " +
-        std::to_string(commandWingmanChat.promptTokens) + "/" + std::to_string(commandWingmanChat.answerTokens) +
+        std::to_string(commandWingmanChat->promptTokens) + "/" + std::to_string(commandWingmanChat->answerTokens) +
         ", time: " +
         std::to_string(duration.count()) +
         "s, status: " +
-        (commandWingmanChat.status==WingmanStatusCode::WINGMAN_STATUS_CODE_OK?"OK":"ERROR") +
+        (commandWingmanChat->status==WingmanStatusCode::WINGMAN_STATUS_CODE_OK?"OK":"ERROR") +
+        (commandWingmanChat->cached?", cached":"") +
         "]"
     };
 
     // PUSH answer to the chat dialog
-    if(WingmanStatusCode::WINGMAN_STATUS_CODE_ERROR == commandWingmanChat.status) {
+    if(WingmanStatusCode::WINGMAN_STATUS_CODE_ERROR == commandWingmanChat->status) {
         this->wingmanDialog->appendAnswerToChat(
-            commandWingmanChat.errorMessage,
+            commandWingmanChat->errorMessage,
             answerDescriptor,
             this->wingmanDialog->getContextType(),
             true
         );
     } else {
         this->wingmanDialog->appendAnswerToChat(
-            commandWingmanChat.answerMarkdown,
+            commandWingmanChat->answerMarkdown,
             answerDescriptor,
             this->wingmanDialog->getContextType()
         );
@@ -2227,7 +2302,6 @@ void MainWindowPresenter::slotRunWingmanFromDialog(bool showDialog)
 
     this->wingmanDialog->setLastPromptLabel();
     this->wingmanDialog->selectPrompt();
-*/
 }
 
 void MainWindowPresenter::slotWingmanAppendFromDialog()
@@ -2479,7 +2553,7 @@ void MainWindowPresenter::doActionOutlineHome()
             // if O has tag, then toggle (remove) it, else set the tag
             if(o->hasTag(t)) {
                 o->removeTag(t);
-                mind->remind().remember(o->getKey());
+                mind->remember(o->getKey());
                 statusBar->showInfo(tr("Home tag toggled/removed - Notebook '%1' is no longer home").arg(o->getName().c_str()));
             } else {
                 if(mind->setOutlineUniqueTag(t, o->getKey())) {
@@ -2574,15 +2648,34 @@ void MainWindowPresenter::handleMindCsvExport()
         StatusBarProgressCallbackCtx callbackCtx{statusBar};
         map<const Tag*,int> tagsCardinality{};
         mind->getTagsCardinality(tagsCardinality);
-        mind->remind().exportToCsv(
-            exportMemoryToCsvDialog->getFilePath().toStdString(),
-            tagsCardinality,
-            exportMemoryToCsvDialog->isOheTags()
-            ?exportMemoryToCsvDialog->getOheTagsCardinality()
-            :-1,
-            &callbackCtx
-            //[](float progress){ cout << "Export progress: " << progress << endl; }
-        );
+        bool exported;
+        if(exportMemoryToCsvDialog->isColumnar()) {
+            exported = mind->remind().exportToColumnar(
+                exportMemoryToCsvDialog->getFilePath().toStdString(),
+                tagsCardinality,
+                exportMemoryToCsvDialog->isOheTags()
+                ?exportMemoryToCsvDialog->getOheTagsCardinality()
+                :-1,
+                &callbackCtx
+            );
+        } else {
+            exported = mind->remind().exportToCsv(
+                exportMemoryToCsvDialog->getFilePath().toStdString(),
+                tagsCardinality,
+                exportMemoryToCsvDialog->isOheTags()
+                ?exportMemoryToCsvDialog->getOheTagsCardinality()
+                :-1,
+                &callbackCtx
+            );
+        }
+        if(!exported) {
+            QMessageBox::critical(
+                &view,
+                tr("Export Error"),
+                tr("Unable to write export file!")
+            );
+            return;
+        }
         statusBar->showInfo(
             "Export to CSV file '"
             + exportMemoryToCsvDialog->getFilePath().toStdString()
@@ -2988,7 +3081,7 @@ void MainWindowPresenter::doActionNoteClone()
             bool deep = choice == QMessageBox::Yes;
             Note* clonedNote = mind->noteClone(orloj->getOutlineView()->getCurrentOutline()->getKey(), n, deep);
             if(clonedNote) {
-                mind->remind().remember(orloj->getOutlineView()->getCurrentOutline()->getKey());
+                mind->remember(orloj->getOutlineView()->getCurrentOutline()->getKey());
                 // IMPROVE smarter refresh of outline tree (do less then overall load)
                 orloj->showFacetOutline(orloj->getOutlineView()->getCurrentOutline());
                 // select Note in the tree
@@ -3381,15 +3474,42 @@ void MainWindowPresenter::handleNewLibrary()
     newLibraryDialog->hide();
 
     // index library documents
-    FilesystemInformationSource informationSource{
-        uri,
-        *orloj->getMind(),
-        *mdDocumentRepresentation,
-    };
+    indexLibrary(
+        new FilesystemInformationSource{
+            uri,
+            *orloj->getMind(),
+            *mdDocumentRepresentation,
+        },
+        false);
+}
+
+void MainWindowPresenter::handleLibraryIndexed(
+    FilesystemInformationSource* informationSource, bool synchronize)
+{
+    // changes are applied to memory by UI thread which owns Mind
+    FilesystemInformationSource::ErrorCode code = libraryScanWatcher->result();
+    libraryScanWatcher->deleteLater();
+    libraryScanWatcher = nullptr;
+    setLibraryActionsEnabled(true);
+
+    if(FilesystemInformationSource::ErrorCode::SUCCESS == code) {
+        code = informationSource->applyToMemory();
+        statusBar->showInfo(
+            tr("Library synchronized: %1 new, %2 changed, %3 moved and %4 orphaned documents")
+                .arg(informationSource->getAddedCount())
+                .arg(informationSource->getModifiedCount())
+                .arg(informationSource->getRenamedCount())
+                .arg(informationSource->getOrphansCount()));
+    } else {
+        statusBar->clear();
+    }
+    MF_DEBUG("Library: " << informationSource->getPath() << " indexed w/ code " << static_cast<int>(code) << endl);
+    delete informationSource;
+
+    if(synchronize) {
+        return;
+    }
 
-    FilesystemInformationSource::ErrorCode code = informationSource.indexToMemory(
-        *config.getActiveRepository()
-    );
     if(FilesystemInformationSource::ErrorCode::LIBRARY_ALREADY_EXISTS == code) {
         QMessageBox::critical(
             &view,
@@ -3411,8 +3531,6 @@ void MainWindowPresenter::handleNewLibrary()
 
     // TODO Library menu enabled in case of MF/repository only
 
-    MF_DEBUG("New Library: " << uri << " has been added to MindForger" << endl);
-
     // show Os view
     orloj->showFacetOutlineList(mind->getOutlines());
 }
@@ -3452,17 +3570,56 @@ void MainWindowPresenter::handleSyncLibrary()
     string librarySrcDir
         = syncLibraryDialog->getLibraryPathsCombo()->currentText().toStdString();
 
-    FilesystemInformationSource informationSource{
-        librarySrcDir,
-        *orloj->getMind(),
-        *mdDocumentRepresentation,
-    };
-
-    informationSource.indexToMemory(*config.getActiveRepository(), true);
+    indexLibrary(
+        new FilesystemInformationSource{
+            librarySrcDir,
+            *orloj->getMind(),
+            *mdDocumentRepresentation,
+        },
+        true);
 
     rmLibraryDialog->reset();
 }
 
+/**
+ * @brief Scan library documents in a worker thread.
+ *
+ * Presenter takes ownership of the information source - scan result is
+ * applied to memory once the scan is finished (see handleLibraryIndexed()).
+ */
+void MainWindowPresenter::indexLibrary(
+    FilesystemInformationSource* informationSource, bool synchronize)
+{
+    if(libraryScanWatcher) {
+        // library actions are disabled while scanning
+        delete informationSource;
+        return;
+    }
+
+    statusBar->showInfo(tr("Scanning library documents..."));
+    setLibraryActionsEnabled(false);
+
+    libraryScanWatcher = new QFutureWatcher<FilesystemInformationSource::ErrorCode>{this};
+    QObject::connect(
+        libraryScanWatcher, &QFutureWatcher<FilesystemInformationSource::ErrorCode>::finished,
+        this, [this, informationSource, synchronize]() {
+            handleLibraryIndexed(informationSource, synchronize);
+        });
+
+    // filesystem is scanned (walk, stat, hash) by a worker thread - Mind is not touched
+    Repository* repository = config.getActiveRepository();
+    libraryScanWatcher->setFuture(QtConcurrent::run(
+        [informationSource, repository, synchronize]() {
+            return informationSource->scan(*repository, synchronize);
+        }));
+}
+
+void MainWindowPresenter::setLibraryActionsEnabled(bool enabled)
+{
+    mainMenu->getView()->actionLibraryAdd->setEnabled(enabled);
+    mainMenu->getView()->actionLibrarySync->setEnabled(enabled);
+    mainMenu->getView()->actionLibraryDeprecate->setEnabled(enabled);
+}
 
 void MainWindowPresenter::doActionLibraryRm()
 {
@@ -3968,6 +4125,11 @@ void MainWindowPresenter::doActionEmojisDialog()
 }
 
 
+void MainWindowPresenter::doActionHelpDiagnostics()
+{
+    diagnosticsDialog->show();
+}
+
 void MainWindowPresenter::doActionHelpAboutMindForger()
 {
     // IMPROVE move this to view: remove this method and route signal to MainWindowView
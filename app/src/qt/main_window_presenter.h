@@ -58,6 +58,7 @@
 #include "dialogs/new_repository_dialog.h"
 #include "dialogs/new_file_dialog.h"
 #include "dialogs/terminal_dialog.h"
+#include "dialogs/diagnostics_dialog.h"
 #include "dialogs/export_csv_file_dialog.h"
 #include "dialogs/export_file_dialog.h"
 
@@ -90,7 +91,7 @@ class FtsDialogPresenter;
  *
  */
 // TODO rename to AppWindowPresenter
-class MainWindowPresenter : public QObject
+class MainWindowPresenter : public QObject, public RepositoryChangeListener
 {
     Q_OBJECT
 
@@ -109,7 +110,7 @@ private:
 
     MarkdownOutlineRepresentation* mdRepresentation;
     HtmlOutlineRepresentation* htmlRepresentation;
-    MarkdownConfigurationRepresentation* mdConfigRepresentation;
+    ConfigurationStore* mdConfigRepresentation;
     MarkdownRepositoryConfigurationRepresentation* mdRepositoryConfigRepresentation;
     MarkdownDocumentRepresentation* mdDocumentRepresentation;
 
@@ -137,6 +138,7 @@ private:
     RefactorNoteToOutlineDialog* refactorNoteToOutlineDialog;
     ConfigurationDialog* configDialog;
     TerminalDialog* terminalDialog;
+    DiagnosticsDialog* diagnosticsDialog;
     InsertImageDialog* insertImageDialog;
     InsertLinkDialog* insertLinkDialog;
     RowsAndDepthDialog* rowsAndDepthDialog;
@@ -145,6 +147,13 @@ private:
     ExportFileDialog* exportOutlineToHtmlDialog;
     ExportCsvFileDialog* exportMemoryToCsvDialog;
 
+    // O shown by Orloj which was changed outside of MindForger: replacement or unlearned
+    Outline* repositoryChangedOutline;
+    bool repositoryChangedOutlineUnlearned;
+
+    // library documents scan running in a worker thread (nullptr if there is no scan)
+    QFutureWatcher<FilesystemInformationSource::ErrorCode>* libraryScanWatcher;
+
 public:
     explicit MainWindowPresenter(MainWindowView& view);
     MainWindowPresenter(const MainWindowPresenter&) = delete;
@@ -157,7 +166,7 @@ public:
     MainWindowView& getView() const { return view; }
     const Configuration& getConfiguration() const { return config; }
     MarkdownOutlineRepresentation* getMarkdownRepresentation() const { return mdRepresentation; }
-    MarkdownConfigurationRepresentation* getConfigRepresentation() const { return mdConfigRepresentation; }
+    ConfigurationStore* getConfigRepresentation() const { return mdConfigRepresentation; }
     HtmlOutlineRepresentation* getHtmlRepresentation() const { return htmlRepresentation; }
     AsyncTaskNotificationsDistributor* getDistributor() const { return distributor; }
 
@@ -176,6 +185,10 @@ public:
     // N view
     void handleNoteViewLinkClicked(const QUrl& url);
 
+    // repository changes made outside of MindForger
+    virtual void learned(Outline* outline, Outline* replaced) override;
+    virtual void unlearned(Outline* outline) override;
+
 public slots:
     // mind
 #ifdef DO_MF_DEBUG
@@ -196,6 +209,7 @@ public slots:
     void doActionMindToggleThink();
     void doActionMindToggleAutolink();
     void doActionMindLearnRepository();
+    void slotLearnRepositoryChanges();
     void doActionMindLearnFile();
     void doActionMindRelearn(QString path);
     void doActionMindTimeTagScope();
@@ -377,6 +391,7 @@ public slots:
     void doActionHelpDiagrams();
     void doActionHelpReportBug();
     void doActionHelpCheckForUpdates();
+    void doActionHelpDiagnostics();
     void doActionEmojisDialog();
     void doActionHelpAboutMindForger();
 
@@ -387,6 +402,9 @@ private:
     void injectMarkdownText(const QString& text, bool newline=false, int offset=0);
     void injectDiagramBlock(const QString& diagramText);
     void copyLinkOrImageToRepository(const std::string& srcPath, QString& path);
+    void indexLibrary(FilesystemInformationSource* informationSource, bool synchronize);
+    void handleLibraryIndexed(FilesystemInformationSource* informationSource, bool synchronize);
+    void setLibraryActionsEnabled(bool enabled);
 
     void statusInfoPreviewFlickering();
 };
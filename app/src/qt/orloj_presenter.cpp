@@ -30,7 +30,9 @@ OrlojPresenter::OrlojPresenter(
     Mind* mind
 ) : activeFacet{OrlojPresenterFacets::FACET_NONE},
     config{Configuration::getInstance()},
-    skipEditNoteCheck{false}
+    skipEditNoteCheck{false},
+    outlinesMapLoading{false},
+    outlinesMapLoadingFacet{OrlojPresenterFacets::FACET_NONE}
 {
     this->mainPresenter = mainPresenter;
     this->view = view;
@@ -360,10 +362,46 @@ void OrlojPresenter::showFacetOutlineList(const vector<Outline*>& outlines)
     mainPresenter->getStatusBar()->showMindStatistics();
 }
 
-void OrlojPresenter::showFacetOutlinesMap(Outline* outlinesMap)
+void OrlojPresenter::showFacetOutlinesMap()
+{
+    if(outlinesMapLoading) {
+        // map will be shown by slotOutlinesMapPrepared()
+        return;
+    }
+
+    // map is parsed off the UI thread - synchronization w/ Os is cheap (hashed)
+    if(mind->outlinesMapPrepare()) {
+        Outline::Patch patch{Outline::Patch::Diff::NO, 0, 0};
+        Outline* outlinesMap = mind->outlinesMapGet(&patch);
+        showFacetOutlinesMap(outlinesMap, &patch);
+    } else {
+        outlinesMapLoading = true;
+        outlinesMapLoadingFacet = activeFacet;
+        mainPresenter->getStatusBar()->showInfo(tr("Loading notebooks map..."));
+        QTimer::singleShot(50, this, SLOT(slotOutlinesMapPrepared()));
+    }
+}
+
+void OrlojPresenter::slotOutlinesMapPrepared()
+{
+    if(!mind->outlinesMapPrepare()) {
+        QTimer::singleShot(50, this, SLOT(slotOutlinesMapPrepared()));
+        return;
+    }
+
+    outlinesMapLoading = false;
+    // don't steal the view if user moved on while the map was loading
+    if(activeFacet == outlinesMapLoadingFacet) {
+        Outline::Patch patch{Outline::Patch::Diff::NO, 0, 0};
+        Outline* outlinesMap = mind->outlinesMapGet(&patch);
+        showFacetOutlinesMap(outlinesMap, &patch);
+    }
+}
+
+void OrlojPresenter::showFacetOutlinesMap(Outline* outlinesMap, Outline::Patch* patch)
 {
     setFacet(OrlojPresenterFacets::FACET_MAP_OUTLINES);
-    outlinesMapPresenter->refresh(outlinesMap);
+    outlinesMapPresenter->refresh(outlinesMap, patch);
     view->showFacetOutlinesMap();
     mainPresenter->getMainMenu()->showFacetOutlinesMap();
     mainPresenter->getStatusBar()->showMindStatistics();
@@ -471,6 +509,9 @@ void OrlojPresenter::showFacetOutline(Outline* outline)
     outline->incReads();
     outline->makeDirty();
 
+    // O is rendered (views keep copies) > no reader holds bodies of other Os
+    mind->remind().getLazyBodies().trim();
+
     mainPresenter->getMainMenu()->showFacetOutlineView();
 
     mainPresenter->getStatusBar()->showInfo(QString("Notebook '%1'   %2").arg(outline->getName().c_str()).arg(outline->getKey().c_str()));
@@ -523,10 +564,8 @@ void OrlojPresenter::slotShowSelectedOutline()
     {
         int row = outlinesTablePresenter->getCurrentRow();
         if(row != OutlinesTablePresenter::NO_ROW) {
-            QStandardItem* item = outlinesTablePresenter->getModel()->item(row);
-            // TODO introduce name my user role - replace constant with my enum name > do it for whole file e.g. MfDataRole
-            if(item) {
-                Outline* outline = item->data(Qt::UserRole + 1).value<Outline*>();
+            Outline* outline = outlinesTablePresenter->getModel()->getOutline(row);
+            if(outline) {
                 showFacetOutline(outline);
                 return;
             } else {
@@ -553,10 +592,10 @@ void OrlojPresenter::slotShowOutline(const QItemSelection& selected, const QItem
         QModelIndexList indices = selected.indexes();
         if(indices.size()) {
             const QModelIndex& index = indices.at(0);
-            QStandardItem* item = outlinesTablePresenter->getModel()->itemFromIndex(index);
-            // TODO introduce name my user role - replace constant with my enum name > do it for whole file e.g. MfDataRole
-            Outline* outline = item->data(Qt::UserRole + 1).value<Outline*>();
-            showFacetOutline(outline);
+            Outline* outline = outlinesTablePresenter->getModel()->getOutline(index.row());
+            if(outline) {
+                showFacetOutline(outline);
+            }
         } else {
             mainPresenter->getStatusBar()->showInfo(QString(tr("No Notebook selected!")));
         }
@@ -853,10 +892,11 @@ void OrlojPresenter::slotShowNote(const QItemSelection& selected, const QItemSel
     QModelIndexList indices = selected.indexes();
     if(indices.size()) {
         const QModelIndex& index = indices.at(0);
-        QStandardItem* item
-            = outlineViewPresenter->getOutlineTree()->getModel()->itemFromIndex(index);
-        // IMPROVE make my role constant
-        Note* note = item->data(Qt::UserRole + 1).value<Note*>();
+        Note* note
+            = outlineViewPresenter->getOutlineTree()->getModel()->getNote(index.row());
+        if(!note) {
+            return;
+        }
 
         note->incReads();
         note->makeDirty();
@@ -931,18 +971,15 @@ void OrlojPresenter::slotShowSelectedRecentNote()
     if(activeFacet == OrlojPresenterFacets::FACET_RECENT_NOTES) {
         int row = recentNotesTablePresenter->getCurrentRow();
         if(row != RecentNotesTablePresenter::NO_ROW) {
-            QStandardItem* item;
+            const Note* note;
             switch(activeFacet) {
             case OrlojPresenterFacets::FACET_RECENT_NOTES:
-                item = recentNotesTablePresenter->getModel()->item(row);
+                note = recentNotesTablePresenter->getModel()->getNote(row);
                 break;
             default:
-                item = nullptr;
+                note = nullptr;
             }
-            // TODO make my role constant
-            if(item) {
-                const Note* note = item->data(Qt::UserRole + 1).value<const Note*>();
-
+            if(note) {
                 showFacetOutline(note->getOutline());
                 if(note->getType() != note->getOutline()->getOutlineDescriptorNoteType()) {
                     // IMPROVE make this more efficient
@@ -967,9 +1004,10 @@ void OrlojPresenter::slotShowRecentNote(const QItemSelection& selected, const QI
         QModelIndexList indices = selected.indexes();
         if(indices.size()) {
             const QModelIndex& index = indices.at(0);
-            QStandardItem* item = recentNotesTablePresenter->getModel()->itemFromIndex(index);
-            // TODO make my role constant
-            const Note* note = item->data(Qt::UserRole + 1).value<const Note*>();
+            const Note* note = recentNotesTablePresenter->getModel()->getNote(index.row());
+            if(!note) {
+                return;
+            }
 
             showFacetOutline(note->getOutline());
             if(note->getType() != note->getOutline()->getOutlineDescriptorNoteType()) {
@@ -123,6 +123,10 @@ private:
 
     bool skipEditNoteCheck;
 
+    // Os map is being parsed in a worker thread, facet active when it was requested
+    bool outlinesMapLoading;
+    OrlojPresenterFacets outlinesMapLoadingFacet;
+
 public:
     explicit OrlojPresenter(MainWindowPresenter* mainPresenter,
         OrlojView* view,
@@ -199,7 +203,14 @@ public:
     );
     void showFacetTagCloud();
     void showFacetOutlineList(const std::vector<Outline*>& outlines);
-    void showFacetOutlinesMap(Outline* outlinesMap);
+    /**
+     * @brief Load (in a worker thread), synchronize and show Os map.
+     *
+     * Map is shown by slotOutlinesMapPrepared() once it's parsed - unless
+     * user leaves the facet in the meantime.
+     */
+    void showFacetOutlinesMap();
+    void showFacetOutlinesMap(Outline* outlinesMap, Outline::Patch* patch=nullptr);
     void showFacetRecentNotes(const std::vector<Note*>& notes);
     void showFacetKnowledgeGraphNavigator();
     void showFacetFtsResult(std::vector<Note*>* result);
@@ -223,6 +234,7 @@ public slots:
     void slotShowOutlines();
     void slotShowSelectedOutline();
     void slotMapShowSelectedOutline();
+    void slotOutlinesMapPrepared();
     void slotShowOutline(const QItemSelection& selected, const QItemSelection& deselected);
     void slotShowOutlineHeader();
     void slotShowNote(const QItemSelection& selected, const QItemSelection& deselected);
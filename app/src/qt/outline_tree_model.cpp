@@ -27,27 +27,37 @@ using namespace std;
 namespace m8r {
 
 OutlineTreeModel::OutlineTreeModel(QObject *parent, HtmlOutlineRepresentation* htmlRepresentation)
-    : QStandardItemModel(parent), htmlRepresentation(htmlRepresentation)
+    : QAbstractTableModel(parent),
+      htmlRepresentation(htmlRepresentation),
+      outline(nullptr),
+      rows(0)
 {
-    setColumnCount(5);
-    setRowCount(0);
 }
 
-void OutlineTreeModel::removeAllRows()
+void OutlineTreeModel::setOutline(Outline* outline)
 {
-    QStandardItemModel::clear();
-
-    QList<QString> tableHeader;
-    tableHeader
-            << tr("Notebook Outline") // tree of Notes is in fact Notebook's outline
-            << tr("Done")
-            << tr("Rs")
-            << tr("Ws")
-            << tr("Modified");
-    setHorizontalHeaderLabels(tableHeader);
+    beginResetModel();
+    this->outline = outline;
+    rows = outline? static_cast<int>(outline->getNotesCount()): 0;
+    endResetModel();
 }
 
-void OutlineTreeModel::createNameText(string& html, Note* note)
+QVariant OutlineTreeModel::headerData(int section, Qt::Orientation orientation, int role) const
+{
+    if(orientation == Qt::Horizontal && role == Qt::DisplayRole) {
+        switch(section) {
+        // tree of Notes is in fact Notebook's outline
+        case 0: return tr("Notebook Outline");
+        case 1: return tr("Done");
+        case 2: return tr("Rs");
+        case 3: return tr("Ws");
+        case 4: return tr("Modified");
+        }
+    }
+    return QAbstractTableModel::headerData(section, orientation, role);
+}
+
+void OutlineTreeModel::createNameText(string& html, Note* note) const
 {
     for(auto depth=0; depth<note->getDepth(); depth++) {
         html += "&nbsp;&nbsp;&nbsp;&nbsp;";
@@ -59,49 +69,69 @@ void OutlineTreeModel::createNameText(string& html, Note* note)
     htmlRepresentation->noteTypeToHtml(note->getType(), html);
 }
 
-void OutlineTreeModel::createRowFor(Note* note, QList<QStandardItem*>& rowItems)
+Note* OutlineTreeModel::getNote(int row) const
 {
-    // name
-    string name{};
-    name.reserve(200);
-    createNameText(name, note);
-    QStandardItem* noteItem = new QStandardItem{QString::fromStdString(name)};
-    // TODO declare custom role
-    noteItem->setData(QVariant::fromValue(note), Qt::UserRole + 1);
-    rowItems += noteItem;
-    // %
-    QString s{};
-    if(note->getProgress()) {
-        s.clear();
-        s += QString::number(note->getProgress());
-        s += "%";
-        rowItems += new QStandardItem{s};
-    } else {
-        rowItems += new QStandardItem{""};
+    if(outline && row >= 0 && row < rows && static_cast<size_t>(row) < outline->getNotesCount()) {
+        return outline->getNotes()[row];
     }
-    // rd/wr
-    rowItems += new QStandardItem{QString::number(note->getReads())};
-    rowItems += new QStandardItem{QString::number(note->getRevision())};
-    // pretty
-    s = note->getModifiedPretty().c_str();
-    rowItems += new QStandardItem{s};
+    return nullptr;
 }
 
-
-void OutlineTreeModel::addNote(Note* note)
+QVariant OutlineTreeModel::data(const QModelIndex& index, int role) const
 {
-    QList<QStandardItem*> items;
-    createRowFor(note, items);
-    appendRow(items);
+    Note* note = getNote(index.row());
+    if(!note) {
+        return QVariant{};
+    }
+
+    if(role == Qt::UserRole + 1) {
+        // TODO declare custom role
+        return QVariant::fromValue(note);
+    }
+
+    if(role != Qt::DisplayRole) {
+        return QVariant{};
+    }
+
+    switch(index.column()) {
+    case 0: {
+        string name{};
+        name.reserve(200);
+        createNameText(name, note);
+        return QString::fromStdString(name);
+    }
+    case 1:
+        if(note->getProgress()) {
+            QString s{QString::number(note->getProgress())};
+            s += "%";
+            return s;
+        }
+        return QString{};
+    case 2:
+        return QString::number(note->getReads());
+    case 3:
+        return QString::number(note->getRevision());
+    case 4:
+        return QString::fromStdString(note->getModifiedPretty());
+    }
+
+    return QVariant{};
 }
 
 int OutlineTreeModel::insertNote(Note* note)
 {
     if(note) {
-        QList<QStandardItem*> items;
-        createRowFor(note, items);
         int offset = note->getOutline()->getNoteOffset(note);
-        insertRow(offset, items);
+        if(note->getOutline() == outline
+           && static_cast<size_t>(rows+1) == outline->getNotesCount()
+           && offset >= 0)
+        {
+            beginInsertRows(QModelIndex(), offset, offset);
+            rows++;
+            endInsertRows();
+        } else {
+            setOutline(note->getOutline());
+        }
         return offset;
     } else {
         return 0;
@@ -110,46 +140,34 @@ int OutlineTreeModel::insertNote(Note* note)
 
 int OutlineTreeModel::getRowByNote(const Note* note)
 {
-    for(int row = 0; row<rowCount(); row++) {
-        if(item(row)->data().value<Note*>() == note) {
-            return row;
+    if(outline) {
+        const vector<Note*>& notes = outline->getNotes();
+        for(int row = 0; row<rows && static_cast<size_t>(row)<notes.size(); row++) {
+            if(notes[row] == note) {
+                return row;
+            }
         }
     }
     return NO_INDEX;
 }
 
-void OutlineTreeModel::refresh(Note* note, int row, bool set)
+void OutlineTreeModel::refresh(int first, int last)
 {
-    if(row > NO_INDEX) {
-        if(set) {
-            // TODO declare custom role
-            item(row,0)->setData(QVariant::fromValue(note), Qt::UserRole + 1);
-        }
-
-        string s{};
-        s.reserve(100);
-        createNameText(s, note);
-        // refresh content
-        item(row,0)->setText(QString::fromStdString(s));
-
-        if(note->getProgress()) {
-            s.clear();
-            s += std::to_string(note->getProgress());
-            s += "%";
-            item(row,1)->setText(QString::fromStdString(s));
-        } else {
-            item(row,1)->setText("");
-        }
-
-        item(row,2)->setText(QString::number(note->getReads()));
-        item(row,3)->setText(QString::number(note->getRevision()));
-        item(row,4)->setText(QString::fromStdString(note->getModifiedPretty()));
+    if(last >= rows) {
+        last = rows-1;
+    }
+    if(first >= 0 && first <= last) {
+        // notify widget about changes - cells are formatted when painted
+        emit dataChanged(index(first, 0), index(last, COLUMN_COUNT-1));
+    }
+}
 
-        QModelIndex from = createIndex(row, 0, item(row,0));
-        QModelIndex to = createIndex(row, 3, item(row,3));
+void OutlineTreeModel::refresh(Note* note, int row)
+{
+    UNUSED_ARG(note);
 
-        // notify widget about changes
-        emit dataChanged(from,to);
+    if(row > NO_INDEX) {
+        refresh(row, row);
     }
 }
 
@@ -159,13 +177,11 @@ void OutlineTreeModel::refresh(Note* note, QModelIndexList selection)
 
     // determine row number by note attached to the row - selection or iteration
     if(selection.size()) {
-        // TODO declare custom role
-        if(item(selection[0].row())->data(Qt::UserRole + 1).value<Note*>() == note) {
+        if(getNote(selection[0].row()) == note) {
             row = selection[0].row();
         }
     }
     if(row <= NO_INDEX) {
-        // IMPROVE UI note that has both Note and QStandardItem refs
         row = getRowByNote(note);
     }
 
@@ -26,19 +26,33 @@
 #include "../../lib/src/model/note.h"
 #include "../../lib/src/representations/html/html_outline_representation.h"
 
-#include "notes_table_model.h"
+#include "model_meta_definitions.h"
 #include "gear/qutils.h"
 
 namespace m8r {
 
-class OutlineTreeModel : public QStandardItemModel
+/**
+ * @brief Virtual model of Notebook's Notes tree.
+ *
+ * Rows are read straight from O's vector of Ns and cells are formatted
+ * on demand i.e. only for visible rows. Changes are propagated to views
+ * by fine grained dataChanged() signals driven by O patches.
+ */
+class OutlineTreeModel : public QAbstractTableModel
 {
     Q_OBJECT
 
+public:
+    static constexpr int COLUMN_COUNT = 5;
+
 private:
     HtmlOutlineRepresentation* htmlRepresentation;
     QList<QModelIndex> noselection;
 
+    Outline* outline;
+    // number of rows announced to views (O's Ns might be already changed)
+    int rows;
+
 public:
     OutlineTreeModel(QObject *parent, HtmlOutlineRepresentation* htmlRepresentation);
     OutlineTreeModel(const OutlineTreeModel&) = delete;
@@ -46,17 +60,34 @@ public:
     OutlineTreeModel &operator=(const OutlineTreeModel&) = delete;
     OutlineTreeModel &operator=(const OutlineTreeModel&&) = delete;
 
-    void removeAllRows();
-    void addNote(Note* note);
+    Outline* getOutline() const { return outline; }
+    void setOutline(Outline* outline);
+    void removeAllRows() { setOutline(nullptr); }
+    /**
+     * @brief Announce N which has been already inserted to the O.
+     */
     int insertNote(Note* note);
     int getRowByNote(const Note* note);
+    Note* getNote(int row) const;
     void refresh(Note* note) { refresh(note, noselection); }
-    void refresh(Note* note, int row, bool set=false);
+    void refresh(Note* note, int row);
     void refresh(Note* note, QModelIndexList selection);
+    /**
+     * @brief Refresh rows [first, last].
+     */
+    void refresh(int first, int last);
+
+    virtual int rowCount(const QModelIndex& parent=QModelIndex()) const override {
+        return parent.isValid()? 0: rows;
+    }
+    virtual int columnCount(const QModelIndex& parent=QModelIndex()) const override {
+        return parent.isValid()? 0: COLUMN_COUNT;
+    }
+    virtual QVariant data(const QModelIndex& index, int role=Qt::DisplayRole) const override;
+    virtual QVariant headerData(int section, Qt::Orientation orientation, int role=Qt::DisplayRole) const override;
 
 private:
-    void createNameText(std::string& name, Note* note);
-    void createRowFor(Note* note, QList<QStandardItem*>& rowItems);
+    void createNameText(std::string& name, Note* note) const;
 };
 
 }
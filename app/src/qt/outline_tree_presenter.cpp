@@ -93,27 +93,23 @@ void OutlineTreePresenter::refresh(Outline* outline, Outline::Patch* patch)
     //   Unfortunately PATCH will NOT help if VIEW is filtered and everyhing must be
     // refreshed.
     if(outline) {
-        if(patch) {
-            const vector<Note*>& notes = outline->getNotes();
+        if(patch
+           && model->getOutline() == outline
+           && static_cast<size_t>(model->rowCount()) == outline->getNotesCount())
+        {
+            // Ns are read from O by the model on paint > just invalidate changed rows
             switch(patch->diff) {
             case Outline::Patch::Diff::CHANGE:
-                for(unsigned int i=patch->start; i<=patch->start+patch->count; i++) {
-                    model->refresh(notes[i], i, false);
-                }
-                break;
             case Outline::Patch::Diff::MOVE:
-                for(unsigned int i=patch->start; i<=patch->start+patch->count; i++) {
-                    model->refresh(notes[i], i, true);
-                }
+                model->refresh(
+                    static_cast<int>(patch->start),
+                    static_cast<int>(patch->start+patch->count));
                 break;
             default:
                 break;
             }
-        } else {
-            model->removeAllRows();
-            for(Note* note:outline->getNotes()) {
-                model->addNote(note);
-            }
+        } else if(!patch || patch->diff != Outline::Patch::Diff::NO) {
+            model->setOutline(outline);
         }
 
         // forget / time scope: hide view rows ~ there is full model, I just hide what's visible > patch should work
@@ -192,7 +188,7 @@ Note* OutlineTreePresenter::getCurrentNote() const
     int row = getCurrentRow();
     // IMPROVE constant w/ a name
     if(row != -1) {
-        return model->item(row)->data().value<Note*>();
+        return model->getNote(row);
     }
 
     return nullptr;
@@ -208,7 +204,7 @@ Note* OutlineTreePresenter::getAdjacentNote() const
     int row = getCurrentRow();
     if(row != NO_ROW) {
         if(row > 0) {
-            return model->item(row-1)->data().value<Note*>();
+            return model->getNote(row-1);
         }
         // ELSE row == 0 and child row cannot be selected
         // as its not clear upfront whether/how many
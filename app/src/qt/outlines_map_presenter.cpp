@@ -95,6 +95,13 @@ void OutlinesMapPresenter::refresh(Outline* outline, Outline::Patch* patch)
     //   Unfortunately PATCH will NOT help if VIEW is filtered and everyhing must be
     // refreshed.
     if(outline) {
+        if(patch
+           && patch->diff != Outline::Patch::Diff::MOVE
+           && model->rowCount() != static_cast<int>(outline->getNotesCount()))
+        {
+            // model doesn't mirror the map (e.g. it's shown for the first time)
+            patch = nullptr;
+        }
         if(patch) {
             const vector<Note*>& notes = outline->getNotes();
             switch(patch->diff) {
@@ -104,7 +111,14 @@ void OutlinesMapPresenter::refresh(Outline* outline, Outline::Patch* patch)
                 }
                 break;
             case Outline::Patch::Diff::MOVE:
-                for(unsigned int i=patch->start; i<=patch->start+patch->count; i++) {
+                // map synchronization may add/remove Ns > align the number of rows
+                while(model->rowCount() < static_cast<int>(notes.size())) {
+                    model->addNote(notes[model->rowCount()]);
+                }
+                if(model->rowCount() > static_cast<int>(notes.size())) {
+                    model->removeRows(notes.size(), model->rowCount()-notes.size());
+                }
+                for(unsigned int i=patch->start; i<=patch->start+patch->count && i<notes.size(); i++) {
                     model->refresh(notes[i], i, true);
                 }
                 break;
@@ -23,118 +23,133 @@ namespace m8r {
 using namespace std;
 
 OutlinesTableModel::OutlinesTableModel(QObject* parent, HtmlOutlineRepresentation* htmlRepresentation)
-    : QStandardItemModel(parent), htmlRepresentation(htmlRepresentation)
+    : SortableTableModel(parent), htmlRepresentation(htmlRepresentation)
 {
-    setColumnCount(5);
-    setRowCount(0);
 }
 
-void OutlinesTableModel::removeAllRows()
+OutlinesTableModel::~OutlinesTableModel()
 {
-    QStandardItemModel::clear();
-
-    QList<QString> tableHeader;
-    tableHeader
-        << tr("Notebooks")
-        << tr("Importance")
-        << tr("Urgency")
-        << tr("Done")
-        << tr("Ns")
-        << tr("Rs")
-        << tr("Ws")
-        << tr("Modified");
-    // IMPROVE set tooltips: items w/ tooltips instead of just strings
-    setHorizontalHeaderLabels(tableHeader);
 }
 
-void OutlinesTableModel::addRow(Outline* outline)
+void OutlinesTableModel::setOutlines(const vector<Outline*>& outlines)
 {
-    QList<QStandardItem*> items;
-    QStandardItem* item;
-
-    string html{}, tooltip{};
-    html.reserve(500);
-    tooltip.reserve(500);
-
-    if(outline->getName().size()) {
-        tooltip = outline->getName();
-        html = tooltip;
-    } else {
-        tooltip = outline->getKey();
-        // IMPROVE parse out file name
-        string dir{};
-        pathToDirectoryAndFile(tooltip, dir, html);
+    beginResetModel();
+    this->outlines = outlines;
+    resetRows(outlines.size());
+    endResetModel();
+}
+
+Outline* OutlinesTableModel::getOutline(int row) const
+{
+    if(row >= 0 && row < rowCount()) {
+        return outlines[toIndex(row)];
     }
-    htmlRepresentation->tagsToHtml(outline->getTags(), html);
-    // IMPROVE make showing of type  configurable
-    htmlRepresentation->outlineTypeToHtml(outline->getType(), html);
-    // item
-    item = new QStandardItem(QString::fromStdString(html));
-    item->setToolTip(QString::fromStdString(tooltip));
-    // TODO under which ROLE this is > I should declare CUSTOM role (user+1 as constant)
-    item->setData(QVariant::fromValue(outline));
-    items += item;
-
-    // IMPROVE refactor to methods
-    QString s;
-
-    s.clear();
-    // stupid and ugly: correct sorting is ensured by making appropriate HTML (alpha sort), don't know how to sort using data role
-    s += "<div title='";
-    s += QChar(outline->getImportance());
-    s += "'>";
-    if(outline->getImportance() > 0) {
-        for(int i=0; i<=4; i++) {
-            if(outline->getImportance()>i) {
-                s += QChar(U_CODE_IMPORTANCE_ON);
-            } else {
-                s += QChar(U_CODE_IMPORTANCE_OFF);
-            }
+    return nullptr;
+}
+
+QVariant OutlinesTableModel::headerData(int section, Qt::Orientation orientation, int role) const
+{
+    if(orientation == Qt::Horizontal && role == Qt::DisplayRole) {
+        switch(section) {
+        case 0: return tr("Notebooks");
+        case 1: return tr("Importance");
+        case 2: return tr("Urgency");
+        case 3: return tr("Done");
+        case 4: return tr("Ns");
+        case 5: return tr("Rs");
+        case 6: return tr("Ws");
+        case 7: return tr("Modified");
         }
     }
-    s += "</div>";
-    item = new QStandardItem(s);
-    item->setData(QVariant::fromValue((int8_t)(outline->getImportance())), Qt::UserRole);
-    items += item;
-
-    s.clear();
-    if(outline->getUrgency()>0) {
-        for(int i=0; i<=4; i++) {
-            if(outline->getUrgency()>i) {
-                s += QChar(U_CODE_URGENCY_ON);
-            } else {
-                s += QChar(U_CODE_URGENCY_OFF);
-            }
-        }
+    return QAbstractTableModel::headerData(section, orientation, role);
+}
+
+QVariant OutlinesTableModel::data(const QModelIndex& index, int role) const
+{
+    Outline* outline = getOutline(index.row());
+    if(!outline) {
+        return QVariant{};
     }
-    item = new QStandardItem(s);
-    item->setData(QVariant::fromValue((int8_t)(outline->getUrgency())), Qt::UserRole);
-    items += item;
-
-    s.clear();
-    if(outline->getProgress() > 0) {
-        s += QString::number(outline->getProgress());
-        s += "%";
+
+    if(role == Qt::UserRole + 1) {
+        // TODO declare custom role
+        return QVariant::fromValue(outline);
     }
-    items += new QStandardItem(s);
 
-    item = new QStandardItem();
-    item->setData(QVariant::fromValue((unsigned)(outline->getNotesCount())), Qt::DisplayRole);
-    items += item;
+    if(role == Qt::ToolTipRole && index.column() == 0) {
+        return QString::fromStdString(
+            outline->getName().size()? outline->getName(): outline->getKey());
+    }
 
-    item = new QStandardItem();
-    item->setData(QVariant(outline->getReads()), Qt::DisplayRole);
-    items += item;
+    if(role != Qt::DisplayRole) {
+        return QVariant{};
+    }
 
-    item = new QStandardItem();
-    item->setData(QVariant(outline->getRevision()), Qt::DisplayRole);
-    items += item;
+    QString s{};
+    switch(index.column()) {
+    case 0: {
+        string html{};
+        html.reserve(500);
+        if(outline->getName().size()) {
+            html = outline->getName();
+        } else {
+            // IMPROVE parse out file name
+            string dir{};
+            pathToDirectoryAndFile(outline->getKey(), dir, html);
+        }
+        htmlRepresentation->tagsToHtml(outline->getTags(), html);
+        // IMPROVE make showing of type  configurable
+        htmlRepresentation->outlineTypeToHtml(outline->getType(), html);
+        return QString::fromStdString(html);
+    }
+    case 1:
+        if(outline->getImportance() > 0) {
+            for(int i=0; i<=4; i++) {
+                s += QChar(outline->getImportance()>i? U_CODE_IMPORTANCE_ON: U_CODE_IMPORTANCE_OFF);
+            }
+        }
+        return s;
+    case 2:
+        if(outline->getUrgency() > 0) {
+            for(int i=0; i<=4; i++) {
+                s += QChar(outline->getUrgency()>i? U_CODE_URGENCY_ON: U_CODE_URGENCY_OFF);
+            }
+        }
+        return s;
+    case 3:
+        if(outline->getProgress() > 0) {
+            s += QString::number(outline->getProgress());
+            s += "%";
+        }
+        return s;
+    case 4:
+        return QVariant::fromValue(static_cast<unsigned>(outline->getNotesCount()));
+    case 5:
+        return QVariant(outline->getReads());
+    case 6:
+        return QVariant(outline->getRevision());
+    case 7:
+        return prettyTime(index.column(), toIndex(index.row()), outline->getModified());
+    }
 
-    s.clear();
-    s += outline->getModifiedPretty().c_str();
-    items += new QStandardItem(s);
+    return QVariant{};
+}
 
-    appendRow(items);
+bool OutlinesTableModel::lessThan(int column, int a, int b) const
+{
+    const Outline* oa = outlines[a];
+    const Outline* ob = outlines[b];
+    switch(column) {
+    case 0: return oa->getName() < ob->getName();
+    case 1: return oa->getImportance() < ob->getImportance();
+    case 2: return oa->getUrgency() < ob->getUrgency();
+    case 3: return oa->getProgress() < ob->getProgress();
+    case 4: return oa->getNotesCount() < ob->getNotesCount();
+    case 5: return oa->getReads() < ob->getReads();
+    case 6: return oa->getRevision() < ob->getRevision();
+    case 7: return oa->getModified() < ob->getModified();
+    }
+    return false;
 }
 
 } // m8r namespace
@@ -20,26 +20,50 @@
 #define M8RUI_OUTLINES_TABLE_MODEL_H
 
 #include <string>
+#include <vector>
 
 #include <QtWidgets>
 
 #include "model_meta_definitions.h"
+#include "sortable_table_model.h"
 #include "../../lib/src/representations/unicode.h"
 #include "../../lib/src/representations/html/html_outline_representation.h"
 
 namespace m8r {
 
-class OutlinesTableModel : public QStandardItemModel
+/**
+ * @brief Virtual model of Notebooks table - cells are formatted on demand.
+ */
+class OutlinesTableModel : public SortableTableModel
 {
     Q_OBJECT
 
+public:
+    static constexpr int COLUMN_COUNT = 8;
+
+private:
     HtmlOutlineRepresentation* htmlRepresentation;
+    std::vector<Outline*> outlines;
 
 public:
     OutlinesTableModel(QObject* parent, HtmlOutlineRepresentation* htmlRepresentation);
+    OutlinesTableModel(const OutlinesTableModel&) = delete;
+    OutlinesTableModel(const OutlinesTableModel&&) = delete;
+    OutlinesTableModel &operator=(const OutlinesTableModel&) = delete;
+    OutlinesTableModel &operator=(const OutlinesTableModel&&) = delete;
+    ~OutlinesTableModel();
+
+    void setOutlines(const std::vector<Outline*>& outlines);
+    Outline* getOutline(int row) const;
+
+    virtual int columnCount(const QModelIndex& parent=QModelIndex()) const override {
+        return parent.isValid()? 0: COLUMN_COUNT;
+    }
+    virtual QVariant data(const QModelIndex& index, int role=Qt::DisplayRole) const override;
+    virtual QVariant headerData(int section, Qt::Orientation orientation, int role=Qt::DisplayRole) const override;
 
-    void removeAllRows();
-    void addRow(Outline* outline);
+protected:
+    virtual bool lessThan(int column, int a, int b) const override;
 };
 
 }
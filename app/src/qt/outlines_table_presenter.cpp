@@ -37,12 +37,9 @@ OutlinesTablePresenter::OutlinesTablePresenter(OutlinesTableView* view, HtmlOutl
 
 void OutlinesTablePresenter::refresh(const vector<Outline*>& outlines)
 {
-    model->removeAllRows();
+    // virtual model: no items are created - cells are formatted for visible rows only
+    model->setOutlines(outlines);
     if(outlines.size()) {
-        for(Outline* outline:outlines) {
-            model->addRow(outline);
-        }
-
         view->sortByColumn(
             Configuration::getInstance().getUiOsTableSortColumn(),
             Configuration::getInstance().isUiOsTableSortOrder()?Qt::SortOrder::AscendingOrder:Qt::SortOrder::DescendingOrder
@@ -23,85 +23,109 @@ namespace m8r {
 using namespace std;
 
 RecentNotesTableModel::RecentNotesTableModel(QObject* parent, HtmlOutlineRepresentation* htmlRepresentation)
-    : QStandardItemModel(parent), htmlRepresentation(htmlRepresentation)
+    : SortableTableModel(parent), htmlRepresentation(htmlRepresentation)
 {
-    setColumnCount(5);
-    setRowCount(0);
 }
 
 RecentNotesTableModel::~RecentNotesTableModel()
 {
 }
 
-void RecentNotesTableModel::removeAllRows()
+void RecentNotesTableModel::setNotes(const vector<Note*>& notes, size_t limit)
 {
-    QStandardItemModel::clear();
-
-    QList<QString> tableHeader;
-    tableHeader
-        << tr("Recent Notes")
-        << tr("Notebook")
-        << tr("Rs")
-        << tr("Ws")
-        << tr("Read")
-        << tr("Modified");
-    // IMPROVE set tooltips: items w/ tooltips instead of just strings
-    setHorizontalHeaderLabels(tableHeader);
+    beginResetModel();
+    this->notes.assign(notes.begin(), notes.begin()+min(limit, notes.size()));
+    resetRows(this->notes.size());
+    endResetModel();
 }
 
-void RecentNotesTableModel::addRow(const Note* n)
+const Note* RecentNotesTableModel::getNote(int row) const
 {
-    QList<QStandardItem*> items;
-    QStandardItem* item;
-
-    string html{}, tooltip{};
-    html.reserve(500);
-    tooltip.reserve(500);
-
-    if(n->getName().size()) {
-        tooltip = n->getName();
-        html = tooltip;
-    } else {
-        tooltip = n->getMangledName();
-        // IMPROVE parse out file name
-        string dir{};
-        pathToDirectoryAndFile(tooltip, dir, html);
+    if(row >= 0 && row < rowCount()) {
+        return notes[toIndex(row)];
     }
-    htmlRepresentation->tagsToHtml(n->getTags(), html);
-    // IMPROVE make showing of type  configurable
-    htmlRepresentation->noteTypeToHtml(n->getType(), html);
+    return nullptr;
+}
 
-    // item
-    item = new QStandardItem(QString::fromStdString(html));
-    item->setToolTip(QString::fromStdString(tooltip));
-    // TODO under which ROLE this is > I should declare CUSTOM role (user+1 as constant)
-    item->setData(QVariant::fromValue(n));
-    items += item;
+QVariant RecentNotesTableModel::headerData(int section, Qt::Orientation orientation, int role) const
+{
+    if(orientation == Qt::Horizontal && role == Qt::DisplayRole) {
+        switch(section) {
+        case 0: return tr("Recent Notes");
+        case 1: return tr("Notebook");
+        case 2: return tr("Rs");
+        case 3: return tr("Ws");
+        case 4: return tr("Read");
+        case 5: return tr("Modified");
+        }
+    }
+    return QAbstractTableModel::headerData(section, orientation, role);
+}
 
-    // IMPROVE refactor to methods
-    QString s;
+QVariant RecentNotesTableModel::data(const QModelIndex& index, int role) const
+{
+    const Note* n = getNote(index.row());
+    if(!n) {
+        return QVariant{};
+    }
 
-    s.clear();
-    s += n->getOutline()->getName().c_str();
-    items += new QStandardItem(s);
+    if(role == Qt::UserRole + 1) {
+        // TODO declare custom role
+        return QVariant::fromValue(n);
+    }
 
-    item = new QStandardItem();
-    item->setData(QVariant(n->getReads()), Qt::DisplayRole);
-    items += item;
+    if(role == Qt::ToolTipRole && index.column() == 0) {
+        return QString::fromStdString(n->getName().size()? n->getName(): n->getMangledName());
+    }
 
-    item = new QStandardItem();
-    item->setData(QVariant(n->getRevision()), Qt::DisplayRole);
-    items += item;
+    if(role != Qt::DisplayRole) {
+        return QVariant{};
+    }
 
-    s.clear();
-    s += n->getReadPretty().c_str();
-    items += new QStandardItem(s);
+    switch(index.column()) {
+    case 0: {
+        string html{};
+        html.reserve(500);
+        if(n->getName().size()) {
+            html = n->getName();
+        } else {
+            // IMPROVE parse out file name
+            string dir{};
+            pathToDirectoryAndFile(n->getMangledName(), dir, html);
+        }
+        htmlRepresentation->tagsToHtml(n->getTags(), html);
+        // IMPROVE make showing of type  configurable
+        htmlRepresentation->noteTypeToHtml(n->getType(), html);
+        return QString::fromStdString(html);
+    }
+    case 1:
+        return QString::fromStdString(n->getOutline()->getName());
+    case 2:
+        return QVariant(n->getReads());
+    case 3:
+        return QVariant(n->getRevision());
+    case 4:
+        return prettyTime(index.column(), toIndex(index.row()), n->getRead());
+    case 5:
+        return prettyTime(index.column(), toIndex(index.row()), n->getModified());
+    }
 
-    s.clear();
-    s += n->getModifiedPretty().c_str();
-    items += new QStandardItem(s);
+    return QVariant{};
+}
 
-    appendRow(items);
+bool RecentNotesTableModel::lessThan(int column, int a, int b) const
+{
+    const Note* na = notes[a];
+    const Note* nb = notes[b];
+    switch(column) {
+    case 0: return na->getName() < nb->getName();
+    case 1: return na->getOutline()->getName() < nb->getOutline()->getName();
+    case 2: return na->getReads() < nb->getReads();
+    case 3: return na->getRevision() < nb->getRevision();
+    case 4: return na->getRead() < nb->getRead();
+    case 5: return na->getModified() < nb->getModified();
+    }
+    return false;
 }
 
 } // m8r namespace
@@ -19,18 +19,29 @@
 #ifndef M8RUI_RECENT_NOTES_TABLE_MODEL_H
 #define M8RUI_RECENT_NOTES_TABLE_MODEL_H
 
+#include <vector>
+
 #include <QtWidgets>
 
 #include "model_meta_definitions.h"
+#include "sortable_table_model.h"
 #include "../../lib/src/representations/html/html_outline_representation.h"
 
 namespace m8r {
 
-class RecentNotesTableModel : public QStandardItemModel
+/**
+ * @brief Virtual model of recent Notes table - cells are formatted on demand.
+ */
+class RecentNotesTableModel : public SortableTableModel
 {
     Q_OBJECT
 
+public:
+    static constexpr int COLUMN_COUNT = 6;
+
+private:
     HtmlOutlineRepresentation* htmlRepresentation;
+    std::vector<const Note*> notes;
 
 public:
     explicit RecentNotesTableModel(QObject* parent, HtmlOutlineRepresentation* htmlRepresentation);
@@ -40,8 +51,20 @@ public:
     RecentNotesTableModel &operator=(const RecentNotesTableModel&&) = delete;
     ~RecentNotesTableModel();
 
-    void removeAllRows();
-    void addRow(const Note* n);
+    /**
+     * @brief Show (at most limit) Notes.
+     */
+    void setNotes(const std::vector<Note*>& notes, size_t limit);
+    const Note* getNote(int row) const;
+
+    virtual int columnCount(const QModelIndex& parent=QModelIndex()) const override {
+        return parent.isValid()? 0: COLUMN_COUNT;
+    }
+    virtual QVariant data(const QModelIndex& index, int role=Qt::DisplayRole) const override;
+    virtual QVariant headerData(int section, Qt::Orientation orientation, int role=Qt::DisplayRole) const override;
+
+protected:
+    virtual bool lessThan(int column, int a, int b) const override;
 };
 
 }
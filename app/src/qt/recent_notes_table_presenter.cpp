@@ -41,14 +41,7 @@ RecentNotesTablePresenter::~RecentNotesTablePresenter()
 
 void RecentNotesTablePresenter::refresh(const vector<Note*>& notes)
 {
-    model->removeAllRows();
-    if(notes.size()) {
-        int uiLimit = Configuration::getInstance().getRecentNotesUiLimit();
-        for(Note* n:notes) {
-            if(uiLimit) uiLimit--; else break;
-            model->addRow(n);
-        }
-    }
+    model->setNotes(notes, static_cast<size_t>(Configuration::getInstance().getRecentNotesUiLimit()));
 
     // order by read timestamp
     view->sortByColumn(4, Qt::SortOrder::DescendingOrder);
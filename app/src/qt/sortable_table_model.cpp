@@ -0,0 +1,107 @@
+/*
+ sortable_table_model.cpp     MindForger thinking notebook
+
+ Copyright (C) 2016-2025 Martin Dvorak <martin.dvorak@mindforger.com>
+
+ This program is free software; you can redistribute it and/or
+ modify it under the terms of the GNU General Public License
+ as published by the Free Software Foundation; either version 2
+ of the License, or (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+#include "sortable_table_model.h"
+
+#include <algorithm>
+
+#include "../../lib/src/gear/datetime_utils.h"
+
+namespace m8r {
+
+using namespace std;
+
+SortableTableModel::SortableTableModel(QObject* parent)
+    : QAbstractTableModel(parent),
+      prettyTimes{},
+      prettyTimesMinute{0}
+{
+}
+
+SortableTableModel::~SortableTableModel()
+{
+}
+
+void SortableTableModel::resetRows(size_t count)
+{
+    rows.resize(count);
+    for(size_t i=0; i<count; i++) {
+        rows[i] = static_cast<int>(i);
+    }
+    prettyTimes.clear();
+}
+
+QString SortableTableModel::prettyTime(int column, int index, time_t time) const
+{
+    time_t minute = datetimeNow() / 60;
+    if(minute != prettyTimesMinute) {
+        prettyTimesMinute = minute;
+        prettyTimes.clear();
+    }
+
+    if(static_cast<size_t>(column) >= prettyTimes.size()) {
+        prettyTimes.resize(column+1);
+    }
+    vector<PrettyTime>& columnTimes = prettyTimes[column];
+    if(columnTimes.size() != rows.size()) {
+        columnTimes.resize(rows.size(), PrettyTime{0, QString{}});
+    }
+
+    PrettyTime& pretty = columnTimes[index];
+    if(pretty.html.isEmpty() || pretty.time != time) {
+        pretty.time = time;
+        pretty.html = QString::fromStdString(datetimeToPrettyHtml(time));
+    }
+    return pretty.html;
+}
+
+void SortableTableModel::sort(int column, Qt::SortOrder order)
+{
+    if(column < 0 || column >= columnCount() || rows.size() < 2) {
+        return;
+    }
+
+    emit layoutAboutToBeChanged();
+
+    vector<int> unsorted{rows};
+    if(order == Qt::AscendingOrder) {
+        stable_sort(rows.begin(), rows.end(), [this, column](int a, int b) {
+            return lessThan(column, a, b);
+        });
+    } else {
+        stable_sort(rows.begin(), rows.end(), [this, column](int a, int b) {
+            return lessThan(column, b, a);
+        });
+    }
+
+    // keep selection and current index on the same items
+    vector<int> indexToRow(rows.size());
+    for(size_t row=0; row<rows.size(); row++) {
+        indexToRow[rows[row]] = static_cast<int>(row);
+    }
+    QModelIndexList from = persistentIndexList();
+    QModelIndexList to{};
+    for(const QModelIndex& index:from) {
+        to << this->index(indexToRow[unsorted[index.row()]], index.column());
+    }
+    changePersistentIndexList(from, to);
+
+    emit layoutChanged();
+}
+
+} // m8r namespace
@@ -0,0 +1,88 @@
+/*
+ sortable_table_model.h     MindForger thinking notebook
+
+ Copyright (C) 2016-2025 Martin Dvorak <martin.dvorak@mindforger.com>
+
+ This program is free software; you can redistribute it and/or
+ modify it under the terms of the GNU General Public License
+ as published by the Free Software Foundation; either version 2
+ of the License, or (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+#ifndef M8RUI_SORTABLE_TABLE_MODEL_H
+#define M8RUI_SORTABLE_TABLE_MODEL_H
+
+#include <ctime>
+#include <vector>
+
+#include <QtWidgets>
+
+namespace m8r {
+
+/**
+ * @brief Virtual table model w/ rows sorted by index permutation.
+ *
+ * Models inheriting this class read rows straight from (library) vectors
+ * and format cells on demand in data() i.e. only visible rows are formatted.
+ * Sorting permutes row indices, the vector is never copied or reordered.
+ */
+class SortableTableModel : public QAbstractTableModel
+{
+private:
+    struct PrettyTime {
+        time_t time;
+        QString html;
+    };
+
+    // column ~ pretty times of items on vector indices
+    mutable std::vector<std::vector<PrettyTime>> prettyTimes;
+    // minute in which pretty times were rendered
+    mutable time_t prettyTimesMinute;
+
+protected:
+    // row ~ index to the underlying vector
+    std::vector<int> rows;
+
+public:
+    explicit SortableTableModel(QObject* parent);
+    SortableTableModel(const SortableTableModel&) = delete;
+    SortableTableModel(const SortableTableModel&&) = delete;
+    SortableTableModel &operator=(const SortableTableModel&) = delete;
+    SortableTableModel &operator=(const SortableTableModel&&) = delete;
+    virtual ~SortableTableModel() override;
+
+    virtual int rowCount(const QModelIndex& parent=QModelIndex()) const override {
+        return parent.isValid()? 0: static_cast<int>(rows.size());
+    }
+    virtual void sort(int column, Qt::SortOrder order=Qt::AscendingOrder) override;
+
+protected:
+    /**
+     * @brief Compare vector items on given indices by column.
+     */
+    virtual bool lessThan(int column, int a, int b) const = 0;
+
+    /**
+     * @brief Set identity permutation - call it between model reset begin and end.
+     */
+    void resetRows(size_t count);
+    int toIndex(int row) const { return rows[row]; }
+
+    /**
+     * @brief Pretty time of the item on given vector index shown in given column.
+     *
+     * Pretty time is relative to now - it's cached until the time changes
+     * (e.g. item is modified) or until the next minute.
+     */
+    QString prettyTime(int column, int index, time_t time) const;
+};
+
+}
+#endif // M8RUI_SORTABLE_TABLE_MODEL_H
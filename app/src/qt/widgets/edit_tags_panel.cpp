@@ -156,7 +156,7 @@ void EditTagsPanel::refreshOntologyTags()
     ((QStringListModel*)completer->model())->setStringList(completerStrings);
 }
 
-void EditTagsPanel::refresh(const vector<const Tag*>* noteTags)
+void EditTagsPanel::refresh(const TagVector* noteTags)
 {
     lineEdit->clear();
     clearTagList();
@@ -79,7 +79,7 @@ public:
     }
     void clearTagList();
     void refreshOntologyTags();
-    void refresh(const std::vector<const Tag*>* noteTags);
+    void refresh(const TagVector* noteTags);
     const std::vector<const Tag*>& getTags();
     std::vector<std::string>& getTagsAsStrings(std::vector<std::string>& tags) const;
     std::set<std::string>& getTagsAsStringSet(std::set<std::string>& tagSet) const;
@@ -80,9 +80,11 @@ win32{
 
 SOURCES += \
     ./src/repository_indexer.cpp \
+    ./src/repository_watcher.cpp \
     ./src/gear/datetime_utils.cpp \
     ./src/gear/file_utils.cpp \
     ./src/gear/string_utils.cpp \
+    ./src/gear/string_pool.cpp \
     ./src/mind/ontology/ontology.cpp \
     ./src/model/note_type.cpp \
     ./src/model/note.cpp \
@@ -102,6 +104,7 @@ SOURCES += \
     ./src/representations/markdown/markdown_section_metadata.cpp \
     ./src/representations/outline_representation.cpp \
     ./src/mind/galaxy.cpp \
+    ./src/mind/lazy_outline_bodies.cpp \
     ./src/mind/memory_dwell.cpp \
     ./src/mind/memory.cpp \
     ./src/mind/mind.cpp \
@@ -110,6 +113,7 @@ SOURCES += \
     ./src/install/installer.cpp \
     ./src/config/repository.cpp \
     ./src/mind/ontology/thing_class_rel_triple.cpp \
+    ./src/mind/ontology/relationship_store.cpp \
     ./src/mind/aspect/time_scope_aspect.cpp \
     ./src/representations/markdown/markdown_configuration_representation.cpp \
     ./src/config/time_scope.cpp \
@@ -121,13 +125,18 @@ SOURCES += \
     src/mind/ai/llm/wingman.cpp \
     src/mind/ai/llm/mock_wingman.cpp \
     src/mind/ai/llm/openai_wingman.cpp \
+    src/mind/ai/llm/llamacpp_wingman.cpp \
+    src/mind/ai/llm/wingman_cache.cpp \
     src/mind/dikw/dikw_pyramid.cpp \
     src/mind/dikw/filesystem_information.cpp \
+    src/mind/dikw/library_manifest.cpp \
     src/mind/dikw/information.cpp \
     src/model/eisenhower_matrix.cpp \
     src/model/kanban.cpp \
     src/model/organizer.cpp \
     src/persistence/configuration_persistence.cpp \
+    src/persistence/configuration_store.cpp \
+    src/persistence/outlines_snapshot.cpp \
     src/persistence/persistence.cpp \
     src/representations/markdown/markdown_document.cpp \
     src/representations/html/html_document.cpp \
@@ -141,7 +150,12 @@ SOURCES += \
     src/mind/ai/nlp/string_char_provider.cpp \
     src/mind/ai/nn/genann.c \
     src/mind/ai/nlp/word_frequency_list.cpp \
+    src/mind/ai/nlp/bm25_index.cpp \
     src/gear/trie.cpp \
+    src/gear/directory_walker.cpp \
+    src/gear/instrumentation.cpp \
+    src/gear/fuzzy_finder.cpp \
+    src/gear/executor.cpp \
     src/mind/ai/nlp/stemmer/stemmer.cpp \
     src/mind/ai/ai_aa_bow.cpp \
     src/mind/ai/ai_aa_weighted_fts.cpp \
@@ -150,12 +164,16 @@ SOURCES += \
     src/mind/aspect/tag_scope_aspect.cpp \
     src/mind/aspect/mind_scope_aspect.cpp \
     src/mind/knowledge_graph.cpp \
+    src/mind/relationship_graph.cpp \
+    src/mind/tags_cardinality.cpp \
     src/representations/markdown/markdown_document_representation.cpp \
     src/representations/markdown/markdown_repository_configuration_representation.cpp \
     src/representations/twiki/twiki_outline_representation.cpp \
     src/mind/associated_notes.cpp \
     src/mind/ai/autolinking_preprocessor.cpp \
     src/representations/csv/csv_outline_representation.cpp \
+    src/representations/json/json_writer.cpp \
+    src/representations/json/json_sax_parser.cpp \
     src/mind/ai/autolinking/naive_autolinking_preprocessor.cpp \
     src/representations/markdown/cmark_gfm_markdown_transcoder.cpp \
     src/mind/ai/autolinking/autolinking_mind.cpp \
@@ -171,6 +189,7 @@ HEADERS += \
     ./src/debug.h \
     ./src/exceptions.h \
     ./src/repository_indexer.h \
+    ./src/repository_watcher.h \
     ./src/3rdparty/hoedown/autolink.h \
     ./src/3rdparty/hoedown/buffer.h \
     ./src/3rdparty/hoedown/document.h \
@@ -183,6 +202,8 @@ HEADERS += \
     ./src/gear/hash_map.h \
     ./src/gear/lang_utils.h \
     ./src/gear/string_utils.h \
+    ./src/gear/string_pool.h \
+    ./src/gear/small_vector.h \
     ./src/mind/ontology/ontology_vocabulary.h \
     ./src/mind/ontology/ontology.h \
     ./src/model/note_type.h \
@@ -206,6 +227,7 @@ HEADERS += \
     ./src/representations/markdown/markdown.h \
     ./src/representations/outline_representation.h \
     ./src/mind/galaxy.h \
+    ./src/mind/lazy_outline_bodies.h \
     ./src/mind/memory_dwell.h \
     ./src/mind/memory.h \
     ./src/mind/mind.h \
@@ -217,6 +239,7 @@ HEADERS += \
     ./src/config/repository.h \
     ./src/definitions.h \
     ./src/mind/ontology/thing_class_rel_triple.h \
+    ./src/mind/ontology/relationship_store.h \
     ./src/mind/ontology/taxonomy.h \
     ./src/mind/aspect/aspect.h \
     ./src/mind/aspect/time_scope_aspect.h \
@@ -229,14 +252,19 @@ HEADERS += \
     ./src/gear/math_utils.h \
     ./src/mind/dikw/dikw_pyramid.h \
     ./src/mind/dikw/filesystem_information.h \
+    ./src/mind/dikw/library_manifest.h \
     src/mind/ai/llm/wingman.h \
     src/mind/ai/llm/mock_wingman.h \
     src/mind/ai/llm/openai_wingman.h \
+    src/mind/ai/llm/llamacpp_wingman.h \
+    src/mind/ai/llm/wingman_cache.h \
     src/mind/dikw/information.h \
     src/model/eisenhower_matrix.h \
     src/model/kanban.h \
     src/model/organizer.h \
     src/persistence/configuration_persistence.h \
+    src/persistence/configuration_store.h \
+    src/persistence/outlines_snapshot.h \
     src/representations/markdown/markdown_document.h \
     src/representations/html/html_document.h \
     src/representations/markdown/markdown_document_representation.h \
@@ -252,7 +280,12 @@ HEADERS += \
     src/mind/ai/nlp/string_char_provider.h \
     src/mind/ai/nn/genann.h \
     src/mind/ai/nlp/word_frequency_list.h \
+    src/mind/ai/nlp/bm25_index.h \
     src/gear/trie.h \
+    src/gear/directory_walker.h \
+    src/gear/instrumentation.h \
+    src/gear/fuzzy_finder.h \
+    src/gear/executor.h \
     src/mind/ai/nlp/char_provider.h \
     src/mind/ai/nlp/stemmer/stemmer.h \
     src/mind/ai/nlp/stemmer/stemming/danish_stem.h \
@@ -283,11 +316,15 @@ HEADERS += \
     src/mind/aspect/mind_scope_aspect.h \
     src/compilation.h \
     src/mind/knowledge_graph.h \
+    src/mind/relationship_graph.h \
+    src/mind/tags_cardinality.h \
     src/representations/twiki/twiki_outline_representation.h \
     src/mind/associated_notes.h \
     src/mind/ai/autolinking_preprocessor.h \
     src/representations/representation_interceptor.h \
     src/representations/csv/csv_outline_representation.h \
+    src/representations/json/json_writer.h \
+    src/representations/json/json_sax_parser.h \
     src/mind/ai/autolinking/naive_autolinking_preprocessor.h \
     src/representations/markdown/markdown_transcoder.h \
     src/representations/representation_type.h \
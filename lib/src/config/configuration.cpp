@@ -39,6 +39,8 @@ const string Configuration::DEFAULT_UI_HTML_CSS_THEME = string{UI_DEFAULT_HTML_C
 const string Configuration::DEFAULT_EDITOR_FONT= string{UI_DEFAULT_EDITOR_FONT};
 const string Configuration::DEFAULT_TIME_SCOPE = string{"0y0m0d0h0m"};
 const string Configuration::DEFAULT_WINGMAN_LLM_MODEL_OPENAI = string{"gpt-3.5-turbo"};
+const string Configuration::DEFAULT_WINGMAN_LLM_MODEL_LLAMACPP = string{"llama"};
+const string Configuration::DEFAULT_WINGMAN_LLAMACPP_URL = string{"http://localhost:8080/v1/chat/completions"};
 
 Configuration::Configuration()
     : asyncMindThreshold{},
@@ -53,9 +55,12 @@ Configuration::Configuration()
       wingmanProvider{DEFAULT_WINGMAN_LLM_PROVIDER},
       wingmanApiKey{},
       wingmanOpenAiApiKey{},
+      wingmanLlamaCppUrl{},
       wingmanLlmModel{DEFAULT_WINGMAN_LLM_MODEL_OPENAI},
       md2HtmlOptions{},
       distributorSleepInterval{DEFAULT_DISTRIBUTOR_SLEEP_INTERVAL},
+      lazyMemoryCap{DEFAULT_LAZY_MEMORY_CAP},
+      workerThreads{DEFAULT_WORKER_THREADS},
       markdownQuoteSections{},
       recentIncludeOs{DEFAULT_RECENT_INCLUDE_OS},
       uiNerdTargetAudience{DEFAULT_UI_NERD_MENU},
@@ -152,6 +157,7 @@ void Configuration::clear()
     wingmanProvider = DEFAULT_WINGMAN_LLM_PROVIDER;
     wingmanApiKey.clear();
     wingmanOpenAiApiKey.clear();
+    wingmanLlamaCppUrl.clear();
     wingmanLlmModel.clear();
     timeScopeAsString.assign(DEFAULT_TIME_SCOPE);
     tagsScope.clear();
@@ -177,6 +183,8 @@ void Configuration::clear()
     }
 
     distributorSleepInterval = DEFAULT_DISTRIBUTOR_SLEEP_INTERVAL;
+    lazyMemoryCap = DEFAULT_LAZY_MEMORY_CAP;
+    workerThreads = DEFAULT_WORKER_THREADS;
 
     // GUI
     uiNerdTargetAudience = false;
@@ -287,6 +295,7 @@ void Configuration::setActiveRepository(
             mindPath += activeRepository->getDir();
 
             outlinesMapPath.clear();
+            outlinesSnapshotPath.clear();
 
             limboPath.clear();
             limboPath += activeRepository->getDir();
@@ -305,6 +314,22 @@ void Configuration::setActiveRepository(
                 outlinesMapPath+=FILE_PATH_SEPARATOR;
                 outlinesMapPath+=FILENAME_OUTLINES_MAP;
 
+                // snapshot is derived data > per-user cache keyed by repository path
+                string configDir{}, configFile{};
+                pathToDirectoryAndFile(configFilePath, configDir, configFile);
+                char repositoryHash[17];
+                snprintf(
+                    repositoryHash, sizeof(repositoryHash), "%016llx",
+                    static_cast<unsigned long long>(stringHash64(activeRepository->getDir())));
+                outlinesSnapshotPath+=configDir;
+                outlinesSnapshotPath+=FILE_PATH_SEPARATOR;
+                outlinesSnapshotPath+=DIRNAME_M8R_CACHE;
+                outlinesSnapshotPath+=FILE_PATH_SEPARATOR;
+                outlinesSnapshotPath+=FILENAME_OUTLINES_SNAPSHOT;
+                outlinesSnapshotPath+="-";
+                outlinesSnapshotPath+=repositoryHash;
+                outlinesSnapshotPath+=".bin";
+
                 limboPath+=FILE_PATH_SEPARATOR;
                 limboPath+=DIRNAME_LIMBO;
 
@@ -460,6 +485,46 @@ bool Configuration::initWingmanOpenAi() {
     return false;
 }
 
+bool Configuration::canWingmanLlamaCpp()
+{
+    // server availability is checked on request - offline server is just an error
+    return getWingmanLlamaCppUrl().size() > 0;
+}
+
+std::string Configuration::getWingmanLlamaCppUrl() const
+{
+    if(wingmanLlamaCppUrl.size() > 0) {
+        return wingmanLlamaCppUrl;
+    }
+    const char* urlEnv = std::getenv(ENV_VAR_LLAMACPP_URL);
+    if(urlEnv != nullptr && strlen(urlEnv) > 0) {
+        return urlEnv;
+    }
+
+    return DEFAULT_WINGMAN_LLAMACPP_URL;
+}
+
+/**
+ * @brief Check whether llama.cpp Wingman requirements are satisfied.
+ *
+ * llama.cpp server (or any other OpenAI API compatible local server)
+ * does not require API key, just the URL of chat completions endpoint.
+*/
+bool Configuration::initWingmanLlamaCpp() {
+    MF_DEBUG("  Configuration::initWingmanLlamaCpp()" << endl);
+    if(canWingmanLlamaCpp()) {
+        wingmanApiKey.clear();
+        wingmanLlmModel = DEFAULT_WINGMAN_LLM_MODEL_LLAMACPP;
+        wingmanProvider = WingmanLlmProviders::WINGMAN_PROVIDER_LLAMACPP;
+        return true;
+    }
+
+    wingmanApiKey.clear();
+    wingmanLlmModel.clear();
+    wingmanProvider = WingmanLlmProviders::WINGMAN_PROVIDER_NONE;
+    return false;
+}
+
 bool Configuration::initWingman()
 {
     MF_DEBUG(
@@ -485,6 +550,10 @@ bool Configuration::initWingman()
         MF_DEBUG("  OpenAI Wingman provider CONFIGURED" << endl);
         initialized = initWingmanOpenAi();
         break;
+    case WingmanLlmProviders::WINGMAN_PROVIDER_LLAMACPP:
+        MF_DEBUG("  llama.cpp Wingman provider CONFIGURED" << endl);
+        initialized = initWingmanLlamaCpp();
+        break;
     default:
         MF_DEBUG(
             "  ERROR: unable to CONFIGURE UNKNOWN Wingman provider: "
@@ -48,7 +48,8 @@ namespace m8r {
 enum WingmanLlmProviders {
     WINGMAN_PROVIDER_NONE,
     WINGMAN_PROVIDER_MOCK,
-    WINGMAN_PROVIDER_OPENAI
+    WINGMAN_PROVIDER_OPENAI,
+    WINGMAN_PROVIDER_LLAMACPP
     // TODO WINGMAN_PROVIDER_GOOGLE,
 };
 
@@ -64,6 +65,10 @@ constexpr const auto FILE_PATH_M8R_REPOSITORY = "~/mindforger-repository";
 
 constexpr const auto FILENAME_M8R_CONFIGURATION = ".mindforger.md";
 constexpr const auto FILENAME_OUTLINES_MAP = "outlines-map.md";
+// per-user cache (next to configuration file) is not synchronized w/ repositories
+constexpr const auto DIRNAME_M8R_CACHE = ".mindforger-cache";
+// snapshot file name is suffixed w/ repository path hash
+constexpr const auto FILENAME_OUTLINES_SNAPSHOT = "outlines-snapshot";
 constexpr const auto DIRNAME_MEMORY = "memory";
 constexpr const auto DIRNAME_MIND = "mind";
 constexpr const auto DIRNAME_LIMBO = "limbo";
@@ -177,6 +182,8 @@ struct KnowledgeTool
 
 // Wingman LLM models API keys
 constexpr const auto ENV_VAR_OPENAI_API_KEY = "MINDFORGER_OPENAI_API_KEY";
+// OpenAI API compatible llama.cpp server chat completions endpoint
+constexpr const auto ENV_VAR_LLAMACPP_URL = "MINDFORGER_LLAMACPP_URL";
 
 // improve platform/language specific
 constexpr const auto DEFAULT_NEW_OUTLINE = "# New Markdown File\n\nThis is a new Markdown file created by MindForger.\n\n#Section 1\nThe first section.\n\n";
@@ -255,10 +262,14 @@ public:
     static constexpr const int DEFAULT_ASYNC_MIND_THRESHOLD_BOW = 200;
     static constexpr const int DEFAULT_ASYNC_MIND_THRESHOLD_WEIGHTED_FTS = 20000;
     static constexpr const int DEFAULT_DISTRIBUTOR_SLEEP_INTERVAL = 500;
+    static constexpr const int DEFAULT_LAZY_MEMORY_CAP = 0;
+    static constexpr const int DEFAULT_WORKER_THREADS = 0;
 
     static const std::string DEFAULT_ACTIVE_REPOSITORY_PATH;
     static const std::string DEFAULT_TIME_SCOPE;
     static const std::string DEFAULT_WINGMAN_LLM_MODEL_OPENAI;
+    static const std::string DEFAULT_WINGMAN_LLM_MODEL_LLAMACPP;
+    static const std::string DEFAULT_WINGMAN_LLAMACPP_URL;
 
     static constexpr const bool DEFAULT_AUTOLINKING = false;
     static constexpr const bool DEFAULT_AUTOLINKING_COLON_SPLIT = true;
@@ -322,6 +333,7 @@ private:
     std::string memoryPath;
     std::string mindPath;
     std::string outlinesMapPath;
+    std::string outlinesSnapshotPath;
     std::string limboPath;
 
     // repository configuration (when in repository mode)
@@ -374,6 +386,7 @@ private:
     WingmanLlmProviders wingmanProvider; // "none", "Mock", "OpenAI", ...
     std::string wingmanApiKey; // API key of the currently configured Wingman LLM provider
     std::string wingmanOpenAiApiKey; // OpenAI API specified by user in the config, env or UI
+    std::string wingmanLlamaCppUrl; // llama.cpp server URL specified by user in the config or env
     std::string wingmanLlmModel; // preferred LLM model the currently configured provider, like "gpt-3.5-turbo"
 
     TimeScope timeScope;
@@ -382,6 +395,16 @@ private:
     unsigned int md2HtmlOptions;
     AssociationAssessmentAlgorithm aaAlgorithm;
     int distributorSleepInterval;
+    /**
+     * @brief Lazy memory cap (MB) of Ns descriptions kept in memory.
+     *
+     * If 0, then Ns descriptions of all Outlines are kept in memory. Otherwise
+     * Ns descriptions are loaded on demand and the least recently used ones
+     * are evicted from memory when the cap is exceeded.
+     */
+    int lazyMemoryCap;
+    // threads of the executor shared by Mind background tasks (0 ~ CPU count)
+    int workerThreads;
 
     bool markdownQuoteSections;
     /**
@@ -460,6 +483,7 @@ public:
     const std::string& getMemoryPath() const { return memoryPath; }
     const std::string& getMindPath() const { return mindPath; }
     const std::string& getOutlinesMapPath() const { return outlinesMapPath; }
+    const std::string& getOutlinesSnapshotPath() const { return outlinesSnapshotPath; }
     const std::string& getLimboPath() const { return limboPath; }
     const char* getRepositoryPathFromEnv();
     /**
@@ -536,6 +560,10 @@ public:
     void setAaAlgorithm(AssociationAssessmentAlgorithm aaa) { aaAlgorithm = aaa; }
     int getDistributorSleepInterval() const { return distributorSleepInterval; }
     void setDistributorSleepInterval(int sleepInterval) { distributorSleepInterval = sleepInterval; }
+    int getLazyMemoryCap() const { return lazyMemoryCap; }
+    void setLazyMemoryCap(int lazyMemoryCap) { this->lazyMemoryCap = lazyMemoryCap; }
+    int getWorkerThreads() const { return workerThreads; }
+    void setWorkerThreads(int workerThreads) { this->workerThreads = workerThreads; }
     bool isMarkdownQuoteSections() const { return markdownQuoteSections; }
     void setMarkdownQuoteSections(bool markdownQuoteSections) { this->markdownQuoteSections = markdownQuoteSections; }
     bool isRecentIncludeOs() const { return recentIncludeOs; }
@@ -551,6 +579,8 @@ public:
             return "mock";
         } else if(provider == WingmanLlmProviders::WINGMAN_PROVIDER_OPENAI) {
             return "openai";
+        } else if(provider == WingmanLlmProviders::WINGMAN_PROVIDER_LLAMACPP) {
+            return "llamacpp";
         }
 
         return "none";
@@ -561,9 +591,11 @@ public:
     bool canWingmanMock() { return false; }
 #endif
     bool canWingmanOpenAi();
+    bool canWingmanLlamaCpp();
 private:
     bool initWingmanMock();
     bool initWingmanOpenAi();
+    bool initWingmanLlamaCpp();
     /**
      * @brief Initialize Wingman's LLM provider.
      */
@@ -571,6 +603,11 @@ private:
 public:
     std::string getWingmanOpenAiApiKey() const { return wingmanOpenAiApiKey; }
     void setWingmanOpenAiApiKey(std::string apiKey) { wingmanOpenAiApiKey = apiKey; }
+    /**
+     * @brief Get llama.cpp server chat completions URL - configured, from env or default.
+     */
+    std::string getWingmanLlamaCppUrl() const;
+    void setWingmanLlamaCppUrl(std::string url) { wingmanLlamaCppUrl = url; }
     /**
      * @brief Get API key of the currently configured Wingman LLM provider.
      */
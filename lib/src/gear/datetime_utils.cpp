@@ -18,6 +18,8 @@
  */
 #include "datetime_utils.h"
 
+#include <atomic>
+
 using namespace std;
 
 namespace m8r {
@@ -110,6 +112,115 @@ time_t datetimeSeconds(struct tm* datetime)
     return mktime(datetime);
 }
 
+/*
+ * Fast timestamp parser
+ */
+
+namespace {
+
+constexpr long long SECONDS_PER_DAY = 24*60*60;
+constexpr size_t UTC_OFFSET_CACHE_SIZE = 64;
+
+struct UtcOffset
+{
+    long long day;
+    long long offset;
+    unsigned generation;
+};
+
+// entries w/ generation 0 are invalid
+atomic<unsigned> timezoneGeneration{1};
+thread_local UtcOffset utcOffsetCache[UTC_OFFSET_CACHE_SIZE];
+
+/**
+ * @brief Days since 1970-01-01 in (proleptic) Gregorian calendar.
+ *
+ * See http://howardhinnant.github.io/date_algorithms.html#days_from_civil
+ */
+inline long long daysFromCivil(long long y, unsigned m, unsigned d)
+{
+    y -= m <= 2;
+    const long long era = (y >= 0 ? y : y-399) / 400;
+    const unsigned yoe = static_cast<unsigned>(y - era * 400);
+    const unsigned doy = (153*(m>2 ? m-3 : m+9) + 2)/5 + d-1;
+    const unsigned doe = yoe * 365 + yoe/4 - yoe/100 + doy;
+    return era * 146097 + static_cast<long long>(doe) - 719468;
+}
+
+inline bool parseDigits(const char* s, size_t count, unsigned& result)
+{
+    result = 0;
+    for(size_t i=0; i<count; i++) {
+        if(s[i] < '0' || s[i] > '9') {
+            return false;
+        }
+        result = result*10 + static_cast<unsigned>(s[i]-'0');
+    }
+    return true;
+}
+
+/**
+ * @brief Get local (standard time) UTC offset of the day using mktime() semantics.
+ */
+bool utcOffset(long long day, unsigned y, unsigned m, unsigned d, long long& offset)
+{
+    const unsigned generation = timezoneGeneration.load(memory_order_relaxed);
+    UtcOffset& cached = utcOffsetCache[static_cast<size_t>(day) % UTC_OFFSET_CACHE_SIZE];
+    if(cached.generation == generation && cached.day == day) {
+        offset = cached.offset;
+        return true;
+    }
+
+    struct tm noon;
+    memset(&noon, 0, sizeof noon);
+    noon.tm_year = static_cast<int>(y) - 1900;
+    noon.tm_mon = static_cast<int>(m) - 1;
+    noon.tm_mday = static_cast<int>(d);
+    noon.tm_hour = 12;
+    const time_t seconds = mktime(&noon);
+    if(seconds == static_cast<time_t>(-1)) {
+        return false;
+    }
+
+    offset = day*SECONDS_PER_DAY + 12*60*60 - static_cast<long long>(seconds);
+    cached.day = day;
+    cached.offset = offset;
+    cached.generation = generation;
+    return true;
+}
+
+} // anonymous namespace
+
+time_t datetimeParse(const char* s, size_t length)
+{
+    // YYYY-MM-DD HH:MM:SS
+    unsigned y, m, d, hh, mm, ss;
+    if(length >= 19
+       && s[4] == '-' && s[7] == '-' && s[10] == ' ' && s[13] == ':' && s[16] == ':'
+       && parseDigits(s, 4, y) && parseDigits(s+5, 2, m) && parseDigits(s+8, 2, d)
+       && parseDigits(s+11, 2, hh) && parseDigits(s+14, 2, mm) && parseDigits(s+17, 2, ss)
+       && y >= 1900 && m >= 1 && m <= 12 && d >= 1 && d <= 31
+       && hh <= 23 && mm <= 59 && ss <= 60)
+    {
+        const long long day = daysFromCivil(y, m, d);
+        long long offset;
+        if(utcOffset(day, y, m, d, offset)) {
+            return static_cast<time_t>(day*SECONDS_PER_DAY + hh*3600 + mm*60 + ss - offset);
+        }
+    }
+
+    struct tm datetime;
+    memset(&datetime, 0, sizeof datetime);
+    string copy{s, length};
+    datetimeFrom(copy.c_str(), &datetime);
+    return datetimeSeconds(&datetime);
+}
+
+void datetimeTimezoneChanged()
+{
+    timezoneGeneration++;
+}
+
 enum class Pretty
 {
     TODAY,
@@ -129,8 +240,16 @@ std::string datetimeToPrettyHtml(const time_t* seconds)
     time_t now;
     time(&now);
 
-    tm tsS = *localtime(seconds);
-    tm* nowS = localtime(&now);
+    // pretty strings are rendered on demand (e.g. for visible UI rows) from any thread
+    tm tsS, nowTm;
+#ifndef _WIN32
+    localtime_r(seconds, &tsS);
+    localtime_r(&now, &nowTm);
+#else
+    localtime_s(&tsS, seconds);
+    localtime_s(&nowTm, &now);
+#endif
+    tm* nowS = &nowTm;
 
     Pretty pretty = Pretty::LONG_TIME_AGO;
 
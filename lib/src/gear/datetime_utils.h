@@ -45,6 +45,18 @@ time_t datetimeNow();
 time_t datetimeSeconds(struct tm* datetime);
 struct tm *datetimeFrom(const char* s);
 struct tm *datetimeFrom(const char* s, struct tm* datetime);
+/**
+ * @brief Parse %Y-%m-%d %H:%M:%S timestamp to seconds.
+ *
+ * Equivalent of datetimeSeconds(datetimeFrom(s)) w/o strptime() and w/o
+ * mktime() timezone lookup for every timestamp - UTC offset is computed
+ * once per day and cached. Input in other format falls back to strptime().
+ */
+time_t datetimeParse(const char* s, size_t length);
+/**
+ * @brief Invalidate cached UTC offsets (call after TZ/tzset() change).
+ */
+void datetimeTimezoneChanged();
 char *datetimeTo(const struct tm *datetime, char* result);
 std::string datetimeToString(const time_t ts);
 std::string datetimeToPrettyHtml(const time_t ts);
@@ -0,0 +1,194 @@
+/*
+ directory_walker.cpp     MindForger thinking notebook
+
+ Copyright (C) 2016-2025 Martin Dvorak <martin.dvorak@mindforger.com>
+
+ This program is free software; you can redistribute it and/or
+ modify it under the terms of the GNU General Public License
+ as published by the Free Software Foundation; either version 2
+ of the License, or (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+#include "directory_walker.h"
+
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <cstring>
+#ifndef _WIN32
+  #include <unistd.h>
+#endif
+
+#include <algorithm>
+#include <condition_variable>
+#include <iterator>
+#include <mutex>
+#include <thread>
+
+#include "../definitions.h"
+#include "executor.h"
+#include "file_utils.h"
+
+namespace m8r {
+
+using namespace std;
+
+constexpr unsigned DirectoryWalker::MAX_THREADS;
+
+DirectoryWalker::DirectoryWalker(unsigned threads, bool recursive)
+    : threads{threads},
+      recursive{recursive}
+{
+    if(!this->threads) {
+        this->threads = thread::hardware_concurrency();
+        if(!this->threads) this->threads = 2;
+        if(this->threads > MAX_THREADS) this->threads = MAX_THREADS;
+    }
+}
+
+DirectoryWalker::~DirectoryWalker()
+{
+}
+
+bool DirectoryWalker::stat(const string& path, FileStat& file)
+{
+    file.path = path;
+    struct stat fileStat;
+    if(::stat(path.c_str(), &fileStat) != 0) {
+        file.modified = 0;
+        file.size = 0;
+        return false;
+    }
+    file.modified = fileStat.st_mtime;
+    file.size = fileStat.st_size;
+    return true;
+}
+
+void DirectoryWalker::scan(
+    const string& directory,
+    vector<FileStat>& files,
+    vector<string>& subdirectories)
+{
+#ifdef _WIN32
+    DIR* dir = opendir(directory.c_str());
+    if(!dir) {
+        return;
+    }
+    const struct dirent* entry;
+    while((entry = readdir(dir))) {
+        if(strcmp(entry->d_name, ".") == 0 || strcmp(entry->d_name, "..") == 0) {
+            continue;
+        }
+        string path{directory};
+        path += FILE_PATH_SEPARATOR;
+        path += entry->d_name;
+        if(entry->d_type == DT_DIR) {
+            subdirectories.push_back(path);
+        } else {
+            FileStat file{};
+            stat(path, file);
+            files.push_back(std::move(file));
+        }
+    }
+    closedir(dir);
+#else
+    int fd = ::open(directory.c_str(), O_RDONLY|O_DIRECTORY|O_CLOEXEC);
+    if(fd < 0) {
+        return;
+    }
+    DIR* dir = ::fdopendir(fd);
+    if(!dir) {
+        ::close(fd);
+        return;
+    }
+    const struct dirent* entry;
+    struct stat fileStat;
+    while((entry = ::readdir(dir))) {
+        if(strcmp(entry->d_name, ".") == 0 || strcmp(entry->d_name, "..") == 0) {
+            continue;
+        }
+
+        bool isDirectory = entry->d_type == DT_DIR;
+        if(entry->d_type == DT_UNKNOWN) {
+            // some filesystems don't report entry type
+            isDirectory = ::fstatat(fd, entry->d_name, &fileStat, AT_SYMLINK_NOFOLLOW) == 0
+                && S_ISDIR(fileStat.st_mode);
+        }
+
+        FileStat file{directory, 0, 0};
+        file.path += FILE_PATH_SEPARATOR;
+        file.path += entry->d_name;
+        if(isDirectory) {
+            subdirectories.push_back(std::move(file.path));
+        } else {
+            if(::fstatat(fd, entry->d_name, &fileStat, 0) == 0) {
+                file.modified = fileStat.st_mtime;
+                file.size = fileStat.st_size;
+            }
+            files.push_back(std::move(file));
+        }
+    }
+    // closes fd as well
+    ::closedir(dir);
+#endif
+}
+
+void DirectoryWalker::walk(const string& directory, vector<FileStat>& files) const
+{
+    files.clear();
+
+    mutex queueMutex{};
+    condition_variable queued{};
+    vector<string> directories{directory};
+    unsigned busy = 0;
+
+    auto worker = [&]() {
+        vector<FileStat> found{};
+        vector<string> subdirectories{};
+
+        unique_lock<mutex> queueLock{queueMutex};
+        while(true) {
+            queued.wait(queueLock, [&]{ return !directories.empty() || busy == 0; });
+            if(directories.empty()) {
+                // queue is empty and nobody scans ~ walk is finished
+                break;
+            }
+            string d{std::move(directories.back())};
+            directories.pop_back();
+            busy++;
+
+            queueLock.unlock();
+            scan(d, found, subdirectories);
+            queueLock.lock();
+
+            busy--;
+            if(recursive) {
+                for(string& s:subdirectories) {
+                    directories.push_back(std::move(s));
+                }
+            }
+            subdirectories.clear();
+            queued.notify_all();
+        }
+
+        files.insert(files.end(), make_move_iterator(found.begin()), make_move_iterator(found.end()));
+    };
+
+    // single directory doesn't need threads
+    if(threads < 2 || !recursive) {
+        worker();
+    } else {
+        // worker which starts when the queue is drained finishes immediately
+        Executor::getInstance().parallelFor(threads, [&worker](size_t) { worker(); }, threads);
+    }
+
+    sort(files.begin(), files.end());
+}
+
+} // m8r namespace
@@ -0,0 +1,91 @@
+/*
+ directory_walker.h     MindForger thinking notebook
+
+ Copyright (C) 2016-2025 Martin Dvorak <martin.dvorak@mindforger.com>
+
+ This program is free software; you can redistribute it and/or
+ modify it under the terms of the GNU General Public License
+ as published by the Free Software Foundation; either version 2
+ of the License, or (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+#ifndef M8R_DIRECTORY_WALKER_H
+#define M8R_DIRECTORY_WALKER_H
+
+#include <ctime>
+#include <string>
+#include <vector>
+
+namespace m8r {
+
+/**
+ * @brief File found by directory walk w/ metadata captured by the walk.
+ */
+struct FileStat
+{
+    std::string path;
+    time_t modified;
+    size_t size;
+
+    bool operator<(const FileStat& other) const { return path < other.path; }
+};
+
+/**
+ * @brief Parallel directory walker.
+ *
+ * Directories are scanned in parallel on the shared executor - lanes share a work queue
+ * of (sub)directories to be scanned. Directory entries are stat-ed relative
+ * to the directory file descriptor (fstatat) as they are read, therefore
+ * modification time and size of files are known w/o additional syscalls.
+ *
+ * Result is a contiguous table of files sorted by path, so it is
+ * deterministic regardless of the order in which threads scanned directories.
+ * Directories are not included, symbolic links to directories are reported
+ * as files (they are not followed).
+ */
+class DirectoryWalker
+{
+public:
+    static constexpr unsigned MAX_THREADS = 8;
+
+private:
+    unsigned threads;
+    bool recursive;
+
+public:
+    /**
+     * @param threads   number of scanning lanes - 0 to detect it.
+     */
+    explicit DirectoryWalker(unsigned threads=0, bool recursive=true);
+    DirectoryWalker(const DirectoryWalker&) = delete;
+    DirectoryWalker(const DirectoryWalker&&) = delete;
+    DirectoryWalker& operator=(const DirectoryWalker&) = delete;
+    DirectoryWalker& operator=(const DirectoryWalker&&) = delete;
+    ~DirectoryWalker();
+
+    /**
+     * @brief Walk directory and replace given files w/ the sorted table of found files.
+     */
+    void walk(const std::string& directory, std::vector<FileStat>& files) const;
+
+    /**
+     * @brief Stat single file - false if it doesn't exist.
+     */
+    static bool stat(const std::string& path, FileStat& file);
+
+private:
+    static void scan(
+        const std::string& directory,
+        std::vector<FileStat>& files,
+        std::vector<std::string>& subdirectories);
+};
+
+}
+#endif // M8R_DIRECTORY_WALKER_H
@@ -0,0 +1,352 @@
+/*
+ executor.cpp     MindForger thinking notebook
+
+ Copyright (C) 2016-2025 Martin Dvorak <martin.dvorak@mindforger.com>
+
+ This program is free software; you can redistribute it and/or
+ modify it under the terms of the GNU General Public License
+ as published by the Free Software Foundation; either version 2
+ of the License, or (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+#include "executor.h"
+
+namespace m8r {
+
+using namespace std;
+
+constexpr unsigned Executor::MAX_WORKERS;
+constexpr unsigned Executor::PRIORITIES;
+constexpr unsigned Executor::NO_WORKER;
+
+thread_local Executor* Executor::currentExecutor = nullptr;
+thread_local unsigned Executor::currentWorker = Executor::NO_WORKER;
+
+atomic<unsigned> Executor::configuredWorkers{0};
+atomic<bool> Executor::instantiated{false};
+
+/*
+ * Task group
+ */
+
+Executor::TaskGroup::TaskGroup(Executor& executor, Priority priority)
+    : executor(executor),
+      priority{priority},
+      jobs{},
+      state{make_shared<State>()}
+{
+    state->done = 0;
+}
+
+Executor::TaskGroup::~TaskGroup()
+{
+    wait();
+}
+
+void Executor::TaskGroup::claimAndRun(Job& job, State& state)
+{
+    if(!job.claimed.exchange(true)) {
+        job.task();
+
+        lock_guard<mutex> lock{state.mutex};
+        state.done++;
+        state.finished.notify_all();
+    }
+}
+
+void Executor::TaskGroup::run(Task task)
+{
+    shared_ptr<Job> job = make_shared<Job>();
+    job->claimed = false;
+    job->task = std::move(task);
+    jobs.push_back(job);
+
+    // job which is claimed by wait() is just released by the worker
+    shared_ptr<State> s = state;
+    executor.post([job, s]() { claimAndRun(*job, *s); }, priority);
+}
+
+void Executor::TaskGroup::wait()
+{
+    // run jobs which haven't been picked by any worker yet on this thread
+    for(shared_ptr<Job>& job:jobs) {
+        claimAndRun(*job, *state);
+    }
+
+    unique_lock<mutex> lock{state->mutex};
+    state->finished.wait(lock, [this]() { return state->done == jobs.size(); });
+    jobs.clear();
+    state->done = 0;
+}
+
+/*
+ * Executor
+ */
+
+bool Executor::configure(unsigned workers)
+{
+    if(instantiated) {
+        return false;
+    }
+    configuredWorkers = workers;
+    return true;
+}
+
+Executor& Executor::getInstance()
+{
+    static Executor executor{(instantiated = true, configuredWorkers.load())};
+    return executor;
+}
+
+Executor::Executor(unsigned workers)
+    : workers{},
+      backgroundLimit{},
+      injectionMutex{},
+      injection{},
+      idleMutex{},
+      idle{},
+      backgroundRunning{0},
+      shutdown{false},
+      executed{0},
+      stolen{0},
+      dropped{0}
+{
+    if(!workers) {
+        workers = thread::hardware_concurrency();
+        if(!workers) workers = 2;
+    }
+    if(workers > MAX_WORKERS) workers = MAX_WORKERS;
+    backgroundLimit = workers > 1? workers-1: 1;
+    for(unsigned p=0; p<PRIORITIES; p++) {
+        pending[p] = 0;
+    }
+
+    // all deques must exist before any worker starts to steal
+    for(unsigned w=0; w<workers; w++) {
+        this->workers.push_back(unique_ptr<Worker>{new Worker{}});
+    }
+    for(unsigned w=0; w<workers; w++) {
+        this->workers[w]->thread = thread{&Executor::workerLoop, this, w};
+    }
+}
+
+Executor::~Executor()
+{
+    {
+        lock_guard<mutex> lock{idleMutex};
+        shutdown = true;
+    }
+    idle.notify_all();
+
+    for(unique_ptr<Worker>& worker:workers) {
+        worker->thread.join();
+    }
+}
+
+void Executor::post(Task task, Priority priority)
+{
+    enqueue(Entry{std::move(task), nullptr, priority});
+}
+
+void Executor::post(Task task, Priority priority, const CancellationToken& token)
+{
+    enqueue(Entry{std::move(task), token.cancelled, priority});
+}
+
+void Executor::enqueue(Entry&& entry)
+{
+    const unsigned p = static_cast<unsigned>(entry.priority);
+    if(currentExecutor == this) {
+        // task forked by a worker stays local unless it's stolen
+        Worker& worker = *workers[currentWorker];
+        lock_guard<mutex> lock{worker.mutex};
+        worker.queues[p].push_back(std::move(entry));
+        pending[p]++;
+    } else {
+        lock_guard<mutex> lock{injectionMutex};
+        injection[p].push_back(std::move(entry));
+        pending[p]++;
+    }
+
+    wakeUp();
+}
+
+void Executor::wakeUp()
+{
+    // sync w/ the idle worker which has just checked the state
+    {
+        lock_guard<mutex> lock{idleMutex};
+    }
+    idle.notify_one();
+}
+
+bool Executor::popFront(deque<Entry>& queue, Entry& entry)
+{
+    if(queue.empty()) {
+        return false;
+    }
+    entry = std::move(queue.front());
+    queue.pop_front();
+    return true;
+}
+
+bool Executor::pop(unsigned self, bool limitBackground, Entry& entry)
+{
+    for(unsigned p=0; p<PRIORITIES; p++) {
+        if(!pending[p]) {
+            continue;
+        }
+
+        // reserve the slot of the background task
+        const bool background = p == static_cast<unsigned>(Priority::BACKGROUND);
+        if(background) {
+            unsigned running = backgroundRunning;
+            do {
+                if(limitBackground && running >= backgroundLimit) {
+                    return false;
+                }
+            } while(!backgroundRunning.compare_exchange_weak(running, running+1));
+        }
+
+        // own deque - LIFO
+        if(self != NO_WORKER) {
+            Worker& worker = *workers[self];
+            lock_guard<mutex> lock{worker.mutex};
+            if(!worker.queues[p].empty()) {
+                entry = std::move(worker.queues[p].back());
+                worker.queues[p].pop_back();
+                pending[p]--;
+                return true;
+            }
+        }
+
+        // injected tasks - FIFO
+        {
+            lock_guard<mutex> lock{injectionMutex};
+            if(popFront(injection[p], entry)) {
+                pending[p]--;
+                return true;
+            }
+        }
+
+        // steal from other workers - FIFO i.e. the oldest (typically biggest) tasks
+        const size_t count = workers.size();
+        const size_t first = self != NO_WORKER? self+1: 0;
+        for(size_t i=0; i<count; i++) {
+            const size_t victim = (first+i) % count;
+            if(victim == self) {
+                continue;
+            }
+            Worker& worker = *workers[victim];
+            lock_guard<mutex> lock{worker.mutex};
+            if(popFront(worker.queues[p], entry)) {
+                pending[p]--;
+                stolen++;
+                return true;
+            }
+        }
+
+        if(background) {
+            backgroundRunning--;
+        }
+    }
+
+    return false;
+}
+
+bool Executor::runOne(unsigned self, bool limitBackground)
+{
+    Entry entry{};
+    if(!pop(self, limitBackground, entry)) {
+        return false;
+    }
+
+    if(entry.cancelled && *entry.cancelled) {
+        // destroyed task breaks the promise of its future
+        dropped++;
+    } else {
+        entry.task();
+        executed++;
+    }
+    entry.task = nullptr;
+
+    if(entry.priority == Priority::BACKGROUND) {
+        backgroundRunning--;
+        // background slot is free again
+        if(pending[static_cast<unsigned>(Priority::BACKGROUND)]) {
+            wakeUp();
+        }
+    }
+    return true;
+}
+
+bool Executor::isRunnable() const
+{
+    return pending[static_cast<unsigned>(Priority::INTERACTIVE)]
+        || (pending[static_cast<unsigned>(Priority::BACKGROUND)] && backgroundRunning < backgroundLimit);
+}
+
+bool Executor::help()
+{
+    return runOne(currentExecutor == this? currentWorker: NO_WORKER, false);
+}
+
+void Executor::workerLoop(unsigned self)
+{
+    currentExecutor = this;
+    currentWorker = self;
+
+    while(true) {
+        // limit background tasks unless the queues are drained on shutdown
+        if(runOne(self, !shutdown)) {
+            continue;
+        }
+
+        unique_lock<mutex> lock{idleMutex};
+        if(shutdown && !pending[0] && !pending[1]) {
+            return;
+        }
+        idle.wait(lock, [this]() { return shutdown || isRunnable(); });
+    }
+}
+
+void Executor::parallelFor(
+    size_t count,
+    const function<void(size_t)>& body,
+    unsigned parallelism,
+    Priority priority)
+{
+    size_t lanes = parallelism? parallelism: getWorkersCount()+1;
+    if(lanes > count) {
+        lanes = count;
+    }
+    if(lanes < 2) {
+        for(size_t i=0; i<count; i++) {
+            body(i);
+        }
+        return;
+    }
+
+    // lanes take next index when done ~ indices may differ in cost
+    atomic<size_t> next{0};
+    auto lane = [&next, count, &body]() {
+        for(size_t i=next++; i<count; i=next++) {
+            body(i);
+        }
+    };
+    TaskGroup group{*this, priority};
+    for(size_t l=1; l<lanes; l++) {
+        group.run(lane);
+    }
+    lane();
+    group.wait();
+}
+
+} // m8r namespace
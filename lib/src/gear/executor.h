@@ -0,0 +1,294 @@
+/*
+ executor.h     MindForger thinking notebook
+
+ Copyright (C) 2016-2025 Martin Dvorak <martin.dvorak@mindforger.com>
+
+ This program is free software; you can redistribute it and/or
+ modify it under the terms of the GNU General Public License
+ as published by the Free Software Foundation; either version 2
+ of the License, or (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+#ifndef M8R_EXECUTOR_H
+#define M8R_EXECUTOR_H
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace m8r {
+
+/**
+ * @brief Library-wide work stealing executor.
+ *
+ * Fixed pool of worker threads where each worker owns a deque per priority:
+ * tasks submitted by a worker are pushed to its own deque and popped LIFO
+ * (cache warm), idle workers steal FIFO from the deques of other workers.
+ * Tasks submitted from outside of the pool (UI, tests, ...) are enqueued
+ * to the shared injection queue.
+ *
+ * INTERACTIVE tasks (associations leaderboard, rendering, ...) are always
+ * picked before BACKGROUND tasks (learning, training, ...) and BACKGROUND
+ * tasks may occupy at most all but one worker so that interactive requests
+ * are served even if the Mind is busy dreaming.
+ *
+ * Threads which wait for the completion of tasks (TaskGroup, parallelFor(),
+ * wait(), ...) run queued tasks meanwhile, therefore tasks can be nested
+ * and composed w/o risk of the pool starvation deadlock.
+ */
+class Executor
+{
+public:
+    static constexpr unsigned MAX_WORKERS = 32;
+
+    enum class Priority {
+        INTERACTIVE = 0,
+        BACKGROUND = 1
+    };
+
+    typedef std::function<void()> Task;
+
+    /**
+     * @brief Cancellation token shared by submitter and tasks.
+     *
+     * Tasks submitted w/ a cancelled token are dropped w/o being run - their
+     * future reports broken promise. Running tasks may check the token
+     * to finish early.
+     */
+    class CancellationToken
+    {
+        friend class Executor;
+    private:
+        std::shared_ptr<std::atomic<bool>> cancelled;
+    public:
+        explicit CancellationToken() : cancelled{std::make_shared<std::atomic<bool>>(false)} {}
+
+        void cancel() { *cancelled = true; }
+        bool isCancelled() const { return *cancelled; }
+    };
+
+    /**
+     * @brief Fork/join group of tasks.
+     *
+     * Tasks run on the pool, wait() runs inline the tasks which haven't been
+     * picked by any worker yet and waits for the ones which are running.
+     * Therefore tasks may safely reference the state of the waiting thread.
+     */
+    class TaskGroup
+    {
+    private:
+        struct Job {
+            std::atomic<bool> claimed;
+            Task task;
+        };
+        struct State {
+            std::mutex mutex;
+            std::condition_variable finished;
+            size_t done;
+        };
+
+        Executor& executor;
+        Priority priority;
+        std::vector<std::shared_ptr<Job>> jobs;
+        std::shared_ptr<State> state;
+
+    public:
+        explicit TaskGroup(Executor& executor, Priority priority=Priority::INTERACTIVE);
+        TaskGroup(const TaskGroup&) = delete;
+        TaskGroup(const TaskGroup&&) = delete;
+        TaskGroup& operator=(const TaskGroup&) = delete;
+        TaskGroup& operator=(const TaskGroup&&) = delete;
+        ~TaskGroup();
+
+        void run(Task task);
+        void wait();
+
+    private:
+        static void claimAndRun(Job& job, State& state);
+    };
+
+private:
+    static constexpr unsigned PRIORITIES = 2;
+    static constexpr unsigned NO_WORKER = 0xFFFFFFFF;
+
+    struct Entry {
+        Task task;
+        std::shared_ptr<std::atomic<bool>> cancelled;
+        Priority priority;
+    };
+
+    struct Worker {
+        std::mutex mutex;
+        std::deque<Entry> queues[PRIORITIES];
+        std::thread thread;
+    };
+
+    // index of the worker thread in the pool of the executor
+    static thread_local Executor* currentExecutor;
+    static thread_local unsigned currentWorker;
+
+    static std::atomic<unsigned> configuredWorkers;
+    static std::atomic<bool> instantiated;
+
+    std::vector<std::unique_ptr<Worker>> workers;
+    unsigned backgroundLimit;
+
+    // tasks submitted from outside of the pool
+    std::mutex injectionMutex;
+    std::deque<Entry> injection[PRIORITIES];
+
+    std::mutex idleMutex;
+    std::condition_variable idle;
+    // queued tasks per priority (updated under the lock of the queue)
+    std::atomic<size_t> pending[PRIORITIES];
+    std::atomic<unsigned> backgroundRunning;
+    std::atomic<bool> shutdown;
+
+    std::atomic<unsigned long> executed;
+    std::atomic<unsigned long> stolen;
+    std::atomic<unsigned long> dropped;
+
+public:
+    /**
+     * @brief Set the size of the library-wide executor (0 ~ CPU count).
+     *
+     * Returns false if library-wide executor already runs (size cannot be changed).
+     */
+    static bool configure(unsigned workers);
+    static Executor& getInstance();
+
+    /**
+     * @param workers   number of worker threads - 0 to detect it.
+     */
+    explicit Executor(unsigned workers=0);
+    Executor(const Executor&) = delete;
+    Executor(const Executor&&) = delete;
+    Executor& operator=(const Executor&) = delete;
+    Executor& operator=(const Executor&&) = delete;
+    ~Executor();
+
+    unsigned getWorkersCount() const { return static_cast<unsigned>(workers.size()); }
+    bool isWorkerThread() const { return currentExecutor == this; }
+    unsigned long getExecutedCount() const { return executed; }
+    unsigned long getStolenCount() const { return stolen; }
+    unsigned long getDroppedCount() const { return dropped; }
+
+    /**
+     * @brief Run task on the pool (fire and forget).
+     */
+    void post(Task task, Priority priority=Priority::BACKGROUND);
+    void post(Task task, Priority priority, const CancellationToken& token);
+
+    /**
+     * @brief Run callable on the pool and get the future of its result.
+     */
+    template<typename F>
+    auto submit(F&& f, Priority priority=Priority::BACKGROUND)
+        -> std::future<typename std::result_of<F()>::type>
+    {
+        typedef typename std::result_of<F()>::type R;
+        auto task = std::make_shared<std::packaged_task<R()>>(std::forward<F>(f));
+        std::future<R> result = task->get_future();
+        post([task]() { (*task)(); }, priority);
+        return result;
+    }
+
+    template<typename F>
+    auto submit(F&& f, Priority priority, const CancellationToken& token)
+        -> std::future<typename std::result_of<F()>::type>
+    {
+        typedef typename std::result_of<F()>::type R;
+        auto task = std::make_shared<std::packaged_task<R()>>(std::forward<F>(f));
+        std::future<R> result = task->get_future();
+        post([task]() { (*task)(); }, priority, token);
+        return result;
+    }
+
+    /**
+     * @brief Run continuation on the pool once the future is ready.
+     *
+     * Continuation gets the (ready) future as parameter.
+     */
+    template<typename T, typename F>
+    auto then(const std::shared_future<T>& f, F&& continuation, Priority priority=Priority::BACKGROUND)
+        -> std::shared_future<typename std::result_of<F(const std::shared_future<T>&)>::type>
+    {
+        typename std::decay<F>::type c{std::forward<F>(continuation)};
+        return submit(
+            [this, f, c]() {
+                wait(f);
+                return c(f);
+            },
+            priority).share();
+    }
+
+    /**
+     * @brief Get future which is ready once all given futures are ready.
+     */
+    template<typename T>
+    std::shared_future<void> whenAll(const std::vector<std::shared_future<T>>& futures, Priority priority=Priority::BACKGROUND)
+    {
+        return submit(
+            [this, futures]() {
+                for(const std::shared_future<T>& f:futures) {
+                    wait(f);
+                }
+            },
+            priority).share();
+    }
+
+    /**
+     * @brief Wait for the future and run queued tasks meanwhile.
+     */
+    template<typename Future>
+    void wait(const Future& f)
+    {
+        while(f.wait_for(std::chrono::seconds(0)) != std::future_status::ready) {
+            if(!help()) {
+                f.wait_for(std::chrono::milliseconds(1));
+            }
+        }
+    }
+
+    /**
+     * @brief Call body for indices [0, count) using at most given number of lanes
+     * (0 ~ workers + calling thread) - calling thread participates.
+     */
+    void parallelFor(
+        size_t count,
+        const std::function<void(size_t)>& body,
+        unsigned parallelism=0,
+        Priority priority=Priority::INTERACTIVE);
+
+    /**
+     * @brief Run one queued task on the calling thread - false if there is none.
+     */
+    bool help();
+
+private:
+    void enqueue(Entry&& entry);
+    static bool popFront(std::deque<Entry>& queue, Entry& entry);
+    bool pop(unsigned self, bool limitBackground, Entry& entry);
+    bool runOne(unsigned self, bool limitBackground);
+    bool isRunnable() const;
+    void wakeUp();
+    void workerLoop(unsigned self);
+};
+
+}
+#endif // M8R_EXECUTOR_H
@@ -38,6 +38,7 @@ std::ostream& operator<<(std::ostream& out, const filesystem::Path& p) {
 
 const std::string File::EXTENSION_HTML = ".html";
 const std::string File::EXTENSION_CSV= ".csv";
+const std::string File::EXTENSION_MFCOL= ".mfcol";
 
 const std::string File::EXTENSION_MD_MD = ".md";
 const std::string File::EXTENSION_MD_MARKDOWN = ".markdown";
@@ -328,6 +329,46 @@ void stringToFile(const string& filename, const string& content)
     out.close();
 }
 
+bool stringToFileAtomic(const string& filename, const string& content)
+{
+    // write sibling temp file first so that readers never see a partially written file
+    string tmpFilename{filename};
+    tmpFilename += ".tmp";
+
+    FILE* out = fopen(tmpFilename.c_str(), "wb");
+    if(!out) {
+        MF_DEBUG("Unable to open temporary file: " << tmpFilename << endl);
+        return false;
+    }
+    bool written = fwrite(content.c_str(), 1, content.size(), out) == content.size();
+    written = fflush(out)==0 && written;
+#ifndef _WIN32
+    written = fsync(fileno(out))==0 && written;
+#endif
+    written = fclose(out)==0 && written;
+    if(!written) {
+        MF_DEBUG("Unable to write temporary file: " << tmpFilename << endl);
+        remove(tmpFilename.c_str());
+        return false;
+    }
+
+#ifdef _WIN32
+    if(!MoveFileExA(
+           tmpFilename.c_str(),
+           filename.c_str(),
+           MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH))
+#else
+    if(rename(tmpFilename.c_str(), filename.c_str()))
+#endif
+    {
+        MF_DEBUG("Unable to rename " << tmpFilename << " to " << filename << endl);
+        remove(tmpFilename.c_str());
+        return false;
+    }
+
+    return true;
+}
+
 time_t fileModificationTime(const string* filename)
 {
 #ifdef __linux__
@@ -79,6 +79,7 @@ namespace filesystem {
     {
         static const std::string EXTENSION_HTML;
         static const std::string EXTENSION_CSV;
+        static const std::string EXTENSION_MFCOL;
 
         static const std::string EXTENSION_MD_MD;
         static const std::string EXTENSION_MD_MARKDOWN;
@@ -233,6 +234,12 @@ bool stringToLines(const std::string* text, std::vector<std::string*>& lines);
 bool fileToLines(const std::string* filename, std::vector<std::string*>& lines, size_t& filesize);
 std::string* fileToString(const std::string& filename);
 void stringToFile(const std::string& filename, const std::string& content);
+/**
+ * @brief Write string to temporary file and rename it over the target file.
+ *
+ * Target file is either left intact or fully replaced - it's never partially written.
+ */
+bool stringToFileAtomic(const std::string& filename, const std::string& content);
 time_t fileModificationTime(const std::string* filename);
 bool copyFile(const std::string& from, const std::string& to);
 bool moveFile(const std::string& from, const std::string& to);
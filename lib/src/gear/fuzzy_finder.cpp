@@ -0,0 +1,340 @@
+/*
+ fuzzy_finder.cpp     MindForger thinking notebook
+
+ Copyright (C) 2016-2025 Martin Dvorak <martin.dvorak@mindforger.com>
+
+ This program is free software; you can redistribute it and/or
+ modify it under the terms of the GNU General Public License
+ as published by the Free Software Foundation; either version 2
+ of the License, or (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+#include "fuzzy_finder.h"
+
+#include <algorithm>
+#include <cctype>
+#include <cstring>
+
+#include "executor.h"
+#include "string_utils.h"
+
+using namespace std;
+
+namespace m8r {
+
+namespace {
+
+// bytes of UTF-8 multi-byte sequences are considered to be word characters
+inline bool isWordChar(char c)
+{
+    return (c & 0x80) || isalnum(static_cast<unsigned char>(c));
+}
+
+inline bool isWordStart(const char* s, size_t i)
+{
+    return i == 0 || !isWordChar(s[i-1]);
+}
+
+inline size_t findSubstring(const char* s, size_t n, const string& k, size_t from)
+{
+    if(k.size() > n) {
+        return string::npos;
+    }
+    const char* last = s + n - k.size();
+    for(const char* p = s + from; p <= last; p++) {
+        p = static_cast<const char*>(memchr(p, k[0], last - p + 1));
+        if(!p) {
+            break;
+        }
+        if(!memcmp(p, k.data(), k.size())) {
+            return p - s;
+        }
+    }
+    return string::npos;
+}
+
+/*
+ * Keyword found as a substring: prefer occurrence at word start and close
+ * to the beginning of the name.
+ */
+bool scoreSubstring(const char* s, size_t n, const string& k, int& score)
+{
+    size_t pos = findSubstring(s, n, k, 0);
+    if(pos == string::npos) {
+        return false;
+    }
+    size_t wordPos = pos;
+    while(wordPos != string::npos && !isWordStart(s, wordPos)) {
+        wordPos = findSubstring(s, n, k, wordPos+1);
+    }
+    if(wordPos != string::npos) {
+        score += wordPos == 0? 100: 60;
+        pos = wordPos;
+    } else {
+        score += 20;
+    }
+    score -= static_cast<int>(min<size_t>(pos, 20));
+    return true;
+}
+
+/*
+ * Keyword characters found in order: consecutive characters and characters
+ * at word starts are rewarded, gaps are penalized.
+ */
+bool scoreSubsequence(const char* s, size_t n, const string& k, int& score)
+{
+    // substring is the best subsequence
+    int substringScore = 0;
+    if(scoreSubstring(s, n, k, substringScore)) {
+        score += substringScore + 6*static_cast<int>(k.size());
+        return true;
+    }
+
+    int subsequenceScore = 0;
+    size_t previous = string::npos;
+    size_t i = 0;
+    for(char c:k) {
+        while(i < n && s[i] != c) {
+            i++;
+        }
+        if(i == n) {
+            return false;
+        }
+        subsequenceScore++;
+        if(previous != string::npos && i == previous+1) {
+            subsequenceScore += 5;
+        } else if(isWordStart(s, i)) {
+            subsequenceScore += i == 0? 10: 8;
+        } else {
+            subsequenceScore -= static_cast<int>(min<size_t>(previous == string::npos? i: i-previous-1, 5));
+        }
+        previous = i++;
+    }
+    score += subsequenceScore;
+    return true;
+}
+
+} // anonymous namespace
+
+FuzzyFinder::FuzzyFinder()
+    : lastMode(Mode::KEYWORDS),
+      lastIgnoreCase(true),
+      lastValid(false),
+      threads(0)
+{
+    clear();
+}
+
+FuzzyFinder::~FuzzyFinder()
+{
+}
+
+void FuzzyFinder::clear()
+{
+    names.clear();
+    foldedNames.clear();
+    offsets.clear();
+    offsets.push_back(0);
+
+    lastValid = false;
+    candidates.clear();
+}
+
+void FuzzyFinder::index(const vector<string>& names)
+{
+    clear();
+
+    size_t bytes = 0;
+    for(const string& n:names) {
+        bytes += n.size();
+    }
+    this->names.reserve(bytes);
+    foldedNames.reserve(bytes);
+    offsets.reserve(names.size()+1);
+
+    for(const string& n:names) {
+        add(n);
+    }
+}
+
+void FuzzyFinder::add(const string& name)
+{
+    names.append(name);
+    stringToLower(name, foldedNames);
+    offsets.push_back(names.size());
+
+    lastValid = false;
+}
+
+void FuzzyFinder::setThreads(unsigned threads)
+{
+    this->threads = threads;
+}
+
+bool FuzzyFinder::score(
+    size_t index,
+    const vector<string>& keywords,
+    Mode mode,
+    bool ignoreCase,
+    int& score) const
+{
+    const char* s = (ignoreCase? foldedNames.data(): names.data()) + offsets[index];
+    const size_t n = offsets[index+1] - offsets[index];
+
+    score = 0;
+    switch(mode) {
+    case Mode::PREFIX:
+        if(keywords[0].size() > n || memcmp(s, keywords[0].data(), keywords[0].size())) {
+            return false;
+        }
+        score = 100;
+        break;
+    case Mode::KEYWORDS:
+        for(const string& k:keywords) {
+            if(!scoreSubstring(s, n, k, score)) {
+                return false;
+            }
+        }
+        break;
+    case Mode::FUZZY:
+        for(const string& k:keywords) {
+            if(!scoreSubsequence(s, n, k, score)) {
+                return false;
+            }
+        }
+        break;
+    }
+
+    // shorter names (closer to the query) first
+    score -= static_cast<int>(min<size_t>(n/4, 25));
+    return true;
+}
+
+void FuzzyFinder::score(
+    const vector<string>& keywords,
+    Mode mode,
+    bool ignoreCase,
+    const Match* source,
+    size_t from,
+    size_t to,
+    vector<Match>& matches) const
+{
+    int s;
+    for(size_t i=from; i<to; i++) {
+        const size_t index = source? source[i].index: i;
+        if(score(index, keywords, mode, ignoreCase, s)) {
+            matches.push_back(Match{index, s});
+        }
+    }
+}
+
+size_t FuzzyFinder::find(
+    const string& query,
+    Mode mode,
+    bool ignoreCase,
+    size_t limit,
+    vector<Match>& result)
+{
+    result.clear();
+
+    string q{};
+    if(ignoreCase) {
+        stringToLower(query, q);
+    } else {
+        q = query;
+    }
+
+    vector<string> keywords{};
+    if(mode == Mode::PREFIX) {
+        if(!q.empty()) {
+            keywords.push_back(q);
+        }
+    } else {
+        size_t begin = 0;
+        while(begin < q.size()) {
+            size_t end = q.find(' ', begin);
+            if(end == string::npos) {
+                end = q.size();
+            }
+            if(end > begin) {
+                keywords.push_back(q.substr(begin, end-begin));
+            }
+            begin = end+1;
+        }
+    }
+
+    if(keywords.empty()) {
+        lastValid = false;
+        for(size_t i=0; i<size() && i<limit; i++) {
+            result.push_back(Match{i, 0});
+        }
+        return size();
+    }
+
+    // typing narrows the previous result set
+    const bool narrow = lastValid
+        && mode == lastMode
+        && ignoreCase == lastIgnoreCase
+        && stringStartsWith(q, lastQuery);
+    vector<Match> source{};
+    if(narrow) {
+        source.swap(candidates);
+    }
+    const size_t count = narrow? source.size(): size();
+    const Match* sourceMatches = narrow? source.data(): nullptr;
+
+    candidates.clear();
+    Executor& executor = Executor::getInstance();
+    unsigned workersCount = threads? threads: executor.getWorkersCount()+1;
+    if(count >= PARALLEL_THRESHOLD && workersCount > 1) {
+        const size_t chunk = (count + workersCount - 1) / workersCount;
+        vector<vector<Match>> chunks(workersCount);
+        executor.parallelFor(
+            workersCount,
+            [this, &keywords, mode, ignoreCase, sourceMatches, count, chunk, &chunks](size_t w) {
+                const size_t from = min(count, w*chunk);
+                const size_t to = min(count, from+chunk);
+                score(keywords, mode, ignoreCase, sourceMatches, from, to, chunks[w]);
+            },
+            workersCount);
+        size_t matches = 0;
+        for(unsigned w=0; w<workersCount; w++) {
+            matches += chunks[w].size();
+        }
+        candidates.reserve(matches);
+        for(vector<Match>& c:chunks) {
+            candidates.insert(candidates.end(), c.begin(), c.end());
+        }
+    } else {
+        score(keywords, mode, ignoreCase, sourceMatches, 0, count, candidates);
+    }
+
+    lastQuery = q;
+    lastMode = mode;
+    lastIgnoreCase = ignoreCase;
+    lastValid = true;
+
+    // top matches
+    auto better = [](const Match& a, const Match& b) {
+        return a.score > b.score || (a.score == b.score && a.index < b.index);
+    };
+    if(candidates.size() > limit) {
+        result.assign(candidates.begin(), candidates.end());
+        partial_sort(result.begin(), result.begin()+limit, result.end(), better);
+        result.resize(limit);
+    } else {
+        result = candidates;
+        sort(result.begin(), result.end(), better);
+    }
+
+    return candidates.size();
+}
+
+} // m8r namespace
@@ -0,0 +1,134 @@
+/*
+ fuzzy_finder.h     MindForger thinking notebook
+
+ Copyright (C) 2016-2025 Martin Dvorak <martin.dvorak@mindforger.com>
+
+ This program is free software; you can redistribute it and/or
+ modify it under the terms of the GNU General Public License
+ as published by the Free Software Foundation; either version 2
+ of the License, or (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+#ifndef M8R_FUZZY_FINDER_H
+#define M8R_FUZZY_FINDER_H
+
+#include <string>
+#include <vector>
+
+#include "../debug.h"
+
+namespace m8r {
+
+/**
+ * @brief Fuzzy finder of (Outline, Note, ...) names.
+ *
+ * Names are indexed once - they are copied to a contiguous buffer along
+ * with their case folded copy. Each search narrows the previous result
+ * set if the query extends the previous query (typing), otherwise all
+ * names are scanned. Large candidate sets are scored in parallel and only
+ * top matches are returned sorted by score.
+ */
+class FuzzyFinder
+{
+public:
+    enum class Mode {
+        // name starts with the query
+        PREFIX,
+        // name contains all space separated keywords
+        KEYWORDS,
+        // name contains characters of all space separated keywords in order
+        FUZZY
+    };
+
+    struct Match {
+        size_t index;
+        int score;
+    };
+
+    // candidate sets smaller than this are scored by the calling thread
+    static constexpr size_t PARALLEL_THRESHOLD = 20000;
+
+private:
+    // names (and case folded names) stored one after another
+    std::string names;
+    std::string foldedNames;
+    std::vector<size_t> offsets;
+
+    // previous search used to narrow the next one
+    std::string lastQuery;
+    Mode lastMode;
+    bool lastIgnoreCase;
+    bool lastValid;
+    std::vector<Match> candidates;
+
+    unsigned threads;
+
+public:
+    explicit FuzzyFinder();
+    FuzzyFinder(const FuzzyFinder&) = delete;
+    FuzzyFinder(const FuzzyFinder&&) = delete;
+    FuzzyFinder& operator=(const FuzzyFinder&) = delete;
+    FuzzyFinder& operator=(const FuzzyFinder&&) = delete;
+    ~FuzzyFinder();
+
+    void clear();
+    /**
+     * @brief Index names - name index is used as match index.
+     */
+    void index(const std::vector<std::string>& names);
+    void add(const std::string& name);
+    size_t size() const { return offsets.size()-1; }
+    std::string getName(size_t index) const {
+        return names.substr(offsets[index], offsets[index+1]-offsets[index]);
+    }
+
+    /**
+     * @brief Set number of threads used to score large candidate sets (0 ~ executor workers).
+     */
+    void setThreads(unsigned threads);
+
+    /**
+     * @brief Find names matching the query.
+     *
+     * Empty query matches all names in the index order.
+     *
+     * @param limit     maximum number of top matches to return.
+     * @param result    top matches sorted by score (descending) and index.
+     * @return number of all matching names.
+     */
+    size_t find(
+        const std::string& query,
+        Mode mode,
+        bool ignoreCase,
+        size_t limit,
+        std::vector<Match>& result);
+
+private:
+    bool score(
+        size_t index,
+        const std::vector<std::string>& keywords,
+        Mode mode,
+        bool ignoreCase,
+        int& score) const;
+    /**
+     * @brief Score names [from, to) of source matches (or of the index if source is nullptr).
+     */
+    void score(
+        const std::vector<std::string>& keywords,
+        Mode mode,
+        bool ignoreCase,
+        const Match* source,
+        size_t from,
+        size_t to,
+        std::vector<Match>& matches) const;
+};
+
+}
+#endif // M8R_FUZZY_FINDER_H
@@ -0,0 +1,339 @@
+/*
+ instrumentation.cpp     MindForger thinking notebook
+
+ Copyright (C) 2016-2025 Martin Dvorak <martin.dvorak@mindforger.com>
+
+ This program is free software; you can redistribute it and/or
+ modify it under the terms of the GNU General Public License
+ as published by the Free Software Foundation; either version 2
+ of the License, or (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+#include "instrumentation.h"
+
+#include <iomanip>
+#include <iostream>
+#include <mutex>
+#include <sstream>
+
+using namespace std;
+
+namespace m8r {
+
+#ifdef DO_MF_DEBUG
+atomic<bool> Instrumentation::enabled{true};
+#else
+atomic<bool> Instrumentation::enabled{false};
+#endif
+
+namespace {
+
+/*
+ * Slots are written by the owner thread only, therefore plain load/store
+ * (no read-modify-write) is sufficient - atomics just make concurrent
+ * snapshot reads well defined.
+ */
+struct ProbeSlot {
+    atomic<uint64_t> count;
+    atomic<uint64_t> sum;
+    atomic<uint64_t> min;
+    atomic<uint64_t> max;
+    atomic<uint64_t> histogram[Instrumentation::HISTOGRAM_BUCKETS];
+};
+
+/*
+ * Block of probe slots owned by a thread. Blocks are never deleted - when
+ * the thread finishes, its block is released and reused by a new thread
+ * so that samples of finished threads are kept.
+ */
+struct ThreadBlock {
+    ProbeSlot slots[Instrumentation::MAX_PROBES];
+    atomic<bool> inUse;
+    ThreadBlock* next;
+
+    ThreadBlock() : inUse{true}, next{nullptr} {
+        clear();
+    }
+
+    void clear() {
+        for(ProbeSlot& s:slots) {
+            s.count.store(0, memory_order_relaxed);
+            s.sum.store(0, memory_order_relaxed);
+            s.min.store(0, memory_order_relaxed);
+            s.max.store(0, memory_order_relaxed);
+            for(atomic<uint64_t>& h:s.histogram) {
+                h.store(0, memory_order_relaxed);
+            }
+        }
+    }
+};
+
+struct Registry {
+    mutex probesMutex;
+    string probeNames[Instrumentation::MAX_PROBES];
+    Instrumentation::ProbeType probeTypes[Instrumentation::MAX_PROBES];
+    atomic<int> probesCount{0};
+
+    atomic<ThreadBlock*> blocks{nullptr};
+
+    ThreadBlock* acquireBlock() {
+        for(ThreadBlock* b=blocks.load(memory_order_acquire); b; b=b->next) {
+            bool expected = false;
+            if(b->inUse.compare_exchange_strong(expected, true, memory_order_acquire)) {
+                return b;
+            }
+        }
+
+        ThreadBlock* b = new ThreadBlock{};
+        b->next = blocks.load(memory_order_relaxed);
+        while(!blocks.compare_exchange_weak(b->next, b, memory_order_release, memory_order_relaxed));
+        return b;
+    }
+};
+
+Registry& registry()
+{
+    static Registry r{};
+    return r;
+}
+
+struct ThreadBlockHolder {
+    ThreadBlock* block;
+
+    ThreadBlockHolder() : block{registry().acquireBlock()} {}
+    ~ThreadBlockHolder() {
+        block->inUse.store(false, memory_order_release);
+    }
+};
+
+inline ProbeSlot& threadSlot(int probeId)
+{
+    static thread_local ThreadBlockHolder holder{};
+    return holder.block->slots[probeId];
+}
+
+inline int histogramBucket(uint64_t micros)
+{
+    int bucket = 0;
+    while(micros && bucket < Instrumentation::HISTOGRAM_BUCKETS-1) {
+        micros >>= 1;
+        bucket++;
+    }
+    return bucket;
+}
+
+inline void add(atomic<uint64_t>& a, uint64_t delta)
+{
+    a.store(a.load(memory_order_relaxed)+delta, memory_order_relaxed);
+}
+
+} // anonymous namespace
+
+uint64_t Instrumentation::ProbeStats::percentile(double p) const
+{
+    if(!count) {
+        return 0;
+    }
+    uint64_t rank = static_cast<uint64_t>(p*count/100.0+0.5);
+    uint64_t seen = 0;
+    for(int i=0; i<HISTOGRAM_BUCKETS; i++) {
+        seen += histogram[i];
+        if(seen >= rank && histogram[i]) {
+            // bucket i covers [2^(i-1), 2^i) except the 1st and the last one
+            uint64_t upper = i? (1ull << i)-1: 0;
+            return upper < max? upper: max;
+        }
+    }
+    return max;
+}
+
+void Instrumentation::setEnabled(bool enabled)
+{
+    Instrumentation::enabled.store(enabled, memory_order_relaxed);
+}
+
+int Instrumentation::probe(const char* name, ProbeType type)
+{
+    Registry& r = registry();
+    lock_guard<mutex> lock{r.probesMutex};
+
+    const int count = r.probesCount.load(memory_order_relaxed);
+    for(int i=0; i<count; i++) {
+        if(r.probeNames[i] == name) {
+            return i;
+        }
+    }
+    if(count >= MAX_PROBES) {
+        cerr << "Error: instrumentation probe '" << name << "' cannot be registered - registry is full" << endl;
+        return -1;
+    }
+    r.probeNames[count] = name;
+    r.probeTypes[count] = type;
+    r.probesCount.store(count+1, memory_order_release);
+    return count;
+}
+
+void Instrumentation::record(int probeId, uint64_t micros)
+{
+    if(probeId < 0 || !isEnabled()) {
+        return;
+    }
+
+    ProbeSlot& s = threadSlot(probeId);
+    const uint64_t count = s.count.load(memory_order_relaxed);
+    if(!count || micros < s.min.load(memory_order_relaxed)) {
+        s.min.store(micros, memory_order_relaxed);
+    }
+    if(micros > s.max.load(memory_order_relaxed)) {
+        s.max.store(micros, memory_order_relaxed);
+    }
+    add(s.sum, micros);
+    add(s.histogram[histogramBucket(micros)], 1);
+    s.count.store(count+1, memory_order_relaxed);
+}
+
+void Instrumentation::count(int probeId, uint64_t delta)
+{
+    if(probeId < 0 || !isEnabled()) {
+        return;
+    }
+
+    ProbeSlot& s = threadSlot(probeId);
+    add(s.sum, delta);
+    add(s.count, 1);
+}
+
+vector<Instrumentation::ProbeStats> Instrumentation::snapshot()
+{
+    Registry& r = registry();
+
+    vector<ProbeStats> result{};
+    {
+        lock_guard<mutex> lock{r.probesMutex};
+        const int count = r.probesCount.load(memory_order_acquire);
+        for(int i=0; i<count; i++) {
+            ProbeStats stats{};
+            stats.name = r.probeNames[i];
+            stats.type = r.probeTypes[i];
+            result.push_back(stats);
+        }
+    }
+
+    for(ThreadBlock* b=r.blocks.load(memory_order_acquire); b; b=b->next) {
+        for(size_t i=0; i<result.size(); i++) {
+            ProbeSlot& s = b->slots[i];
+            ProbeStats& stats = result[i];
+            const uint64_t count = s.count.load(memory_order_relaxed);
+            if(!count) {
+                continue;
+            }
+            const uint64_t min = s.min.load(memory_order_relaxed);
+            const uint64_t max = s.max.load(memory_order_relaxed);
+            if(!stats.count || min < stats.min) {
+                stats.min = min;
+            }
+            if(max > stats.max) {
+                stats.max = max;
+            }
+            stats.count += count;
+            stats.sum += s.sum.load(memory_order_relaxed);
+            for(int h=0; h<HISTOGRAM_BUCKETS; h++) {
+                stats.histogram[h] += s.histogram[h].load(memory_order_relaxed);
+            }
+        }
+    }
+
+    vector<ProbeStats> sampled{};
+    for(ProbeStats& stats:result) {
+        if(stats.count) {
+            sampled.push_back(stats);
+        }
+    }
+    return sampled;
+}
+
+string Instrumentation::toJson()
+{
+    vector<ProbeStats> probes = snapshot();
+
+    stringstream json{};
+    json << "{\"enabled\":" << (isEnabled()? "true": "false") << ",\"probes\":[";
+    for(size_t i=0; i<probes.size(); i++) {
+        const ProbeStats& p = probes[i];
+        if(i) {
+            json << ",";
+        }
+        // probe names are identifiers i.e. no escaping is needed
+        json << "{\"name\":\"" << p.name << "\"";
+        if(p.type == ProbeType::TIMER) {
+            json << ",\"type\":\"timer\""
+                 << ",\"count\":" << p.count
+                 << ",\"totalUs\":" << p.sum
+                 << ",\"meanUs\":" << fixed << setprecision(1) << p.mean()
+                 << ",\"minUs\":" << p.min
+                 << ",\"p50Us\":" << p.percentile(50)
+                 << ",\"p90Us\":" << p.percentile(90)
+                 << ",\"p99Us\":" << p.percentile(99)
+                 << ",\"maxUs\":" << p.max
+                 << ",\"histogram\":[";
+            for(int h=0; h<HISTOGRAM_BUCKETS; h++) {
+                json << (h? ",": "") << p.histogram[h];
+            }
+            json << "]";
+        } else {
+            json << ",\"type\":\"counter\""
+                 << ",\"count\":" << p.count
+                 << ",\"total\":" << p.sum;
+        }
+        json << "}";
+    }
+    json << "]}";
+
+    return json.str();
+}
+
+string Instrumentation::toString()
+{
+    vector<ProbeStats> probes = snapshot();
+
+    stringstream s{};
+    s << left << setw(32) << "probe"
+      << right << setw(10) << "count"
+      << setw(14) << "total"
+      << setw(12) << "mean"
+      << setw(12) << "p50"
+      << setw(12) << "p99"
+      << setw(12) << "max" << endl;
+    s << fixed << setprecision(3);
+    for(const ProbeStats& p:probes) {
+        s << left << setw(32) << p.name << right << setw(10) << p.count;
+        if(p.type == ProbeType::TIMER) {
+            s << setw(12) << p.sum/1000.0 << "ms"
+              << setw(10) << p.mean()/1000.0 << "ms"
+              << setw(10) << p.percentile(50)/1000.0 << "ms"
+              << setw(10) << p.percentile(99)/1000.0 << "ms"
+              << setw(10) << p.max/1000.0 << "ms";
+        } else {
+            s << setw(14) << p.sum;
+        }
+        s << endl;
+    }
+
+    return s.str();
+}
+
+void Instrumentation::reset()
+{
+    for(ThreadBlock* b=registry().blocks.load(memory_order_acquire); b; b=b->next) {
+        b->clear();
+    }
+}
+
+} // m8r namespace
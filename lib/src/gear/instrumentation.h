@@ -0,0 +1,161 @@
+/*
+ instrumentation.h     MindForger thinking notebook
+
+ Copyright (C) 2016-2025 Martin Dvorak <martin.dvorak@mindforger.com>
+
+ This program is free software; you can redistribute it and/or
+ modify it under the terms of the GNU General Public License
+ as published by the Free Software Foundation; either version 2
+ of the License, or (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+#ifndef M8R_INSTRUMENTATION_H
+#define M8R_INSTRUMENTATION_H
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace m8r {
+
+/**
+ * @brief Hot path instrumentation registry.
+ *
+ * Probes (timers and counters) are registered by name once, and then
+ * recorded by id. Every thread writes to its own block of slots, therefore
+ * recording is lock-free and doesn't share cache lines among threads.
+ * Snapshot aggregates the blocks of all (also finished) threads.
+ *
+ * When disabled, probe costs a single relaxed atomic load.
+ */
+class Instrumentation
+{
+public:
+    enum class ProbeType {
+        TIMER,
+        COUNTER
+    };
+
+    static constexpr int MAX_PROBES = 64;
+    // log2 buckets: [0,1)us, [1,2)us, [2,4)us, ... the last bucket is open
+    static constexpr int HISTOGRAM_BUCKETS = 24;
+
+    struct ProbeStats {
+        std::string name;
+        ProbeType type;
+        // number of recorded samples
+        uint64_t count;
+        // sum of timer microseconds or counter deltas
+        uint64_t sum;
+        uint64_t min;
+        uint64_t max;
+        uint64_t histogram[HISTOGRAM_BUCKETS];
+
+        double mean() const { return count? static_cast<double>(sum)/count: 0.0; }
+        /**
+         * @brief Percentile estimate (upper bound of histogram bucket) in microseconds.
+         */
+        uint64_t percentile(double p) const;
+    };
+
+private:
+    static std::atomic<bool> enabled;
+
+public:
+    static void setEnabled(bool enabled);
+    static bool isEnabled() { return enabled.load(std::memory_order_relaxed); }
+
+    /**
+     * @brief Get ID of the probe with given name - register it if it doesn't exist.
+     * @return probe ID or -1 if the registry is full.
+     */
+    static int probe(const char* name, ProbeType type=ProbeType::TIMER);
+
+    static void record(int probeId, uint64_t micros);
+    static void count(int probeId, uint64_t delta=1);
+
+    /**
+     * @brief Aggregate probes of all threads - probes w/o samples are skipped.
+     */
+    static std::vector<ProbeStats> snapshot();
+    static std::string toJson();
+    static std::string toString();
+    /**
+     * @brief Clear all samples - probes are kept registered.
+     */
+    static void reset();
+
+    static uint64_t nowMicros() {
+        return static_cast<uint64_t>(
+            std::chrono::duration_cast<std::chrono::microseconds>(
+                std::chrono::steady_clock::now().time_since_epoch()).count());
+    }
+};
+
+/**
+ * @brief Scoped timer recording the lifetime of the scope to a probe.
+ */
+class InstrumentationTimer
+{
+private:
+    int probeId;
+    uint64_t begin;
+
+public:
+    explicit InstrumentationTimer(int probeId)
+        : probeId(probeId),
+          begin(Instrumentation::isEnabled()? Instrumentation::nowMicros(): 0)
+    {}
+    InstrumentationTimer(const InstrumentationTimer&) = delete;
+    InstrumentationTimer(const InstrumentationTimer&&) = delete;
+    InstrumentationTimer& operator=(const InstrumentationTimer&) = delete;
+    InstrumentationTimer& operator=(const InstrumentationTimer&&) = delete;
+    ~InstrumentationTimer() {
+        if(begin) {
+            Instrumentation::record(probeId, Instrumentation::nowMicros()-begin);
+        }
+    }
+
+    /**
+     * @brief Microseconds since the timer start (0 if instrumentation is disabled).
+     */
+    uint64_t elapsedMicros() const {
+        return begin? Instrumentation::nowMicros()-begin: 0;
+    }
+};
+
+} // m8r namespace
+
+#define M8R_INSTRUMENTATION_CONCAT_(A, B) A ## B
+#define M8R_INSTRUMENTATION_CONCAT(A, B) M8R_INSTRUMENTATION_CONCAT_(A, B)
+
+/**
+ * @brief Time the enclosing scope - timer is accessible as VARIABLE.
+ */
+#define M8R_INSTRUMENTATION_TIMER(VARIABLE, NAME) \
+    static const int M8R_INSTRUMENTATION_CONCAT(VARIABLE, ProbeId) \
+        = m8r::Instrumentation::probe(NAME, m8r::Instrumentation::ProbeType::TIMER); \
+    m8r::InstrumentationTimer VARIABLE{M8R_INSTRUMENTATION_CONCAT(VARIABLE, ProbeId)}
+
+/**
+ * @brief Increment counter by DELTA.
+ */
+#define M8R_INSTRUMENTATION_COUNT(NAME, DELTA) \
+    do { \
+        if(m8r::Instrumentation::isEnabled()) { \
+            static const int m8rCounterProbeId \
+                = m8r::Instrumentation::probe(NAME, m8r::Instrumentation::ProbeType::COUNTER); \
+            m8r::Instrumentation::count(m8rCounterProbeId, DELTA); \
+        } \
+    } while(0)
+
+#endif // M8R_INSTRUMENTATION_H
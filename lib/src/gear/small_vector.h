@@ -0,0 +1,154 @@
+/*
+ small_vector.h     MindForger thinking notebook
+
+ Copyright (C) 2016-2025 Martin Dvorak <martin.dvorak@mindforger.com>
+
+ This program is free software; you can redistribute it and/or
+ modify it under the terms of the GNU General Public License
+ as published by the Free Software Foundation; either version 2
+ of the License, or (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+#ifndef M8R_SMALL_VECTOR_H_
+#define M8R_SMALL_VECTOR_H_
+
+#include <cstdlib>
+#include <cstring>
+#include <new>
+#include <stdexcept>
+#include <type_traits>
+#include <sys/types.h>
+
+namespace m8r {
+
+/**
+ * @brief Vector which keeps up to N items inline.
+ *
+ * Most of Outlines and Notes have a few tags and links (if any) - inline
+ * storage avoids a heap block per (non-empty) std::vector. Heap is used
+ * only when the inline capacity is exceeded. Items must be trivially
+ * copyable (pointers).
+ */
+template<typename T, size_t N>
+class SmallVector
+{
+    static_assert(N > 0, "SmallVector inline capacity must be positive");
+    static_assert(std::is_trivially_copyable<T>::value, "SmallVector items must be trivially copyable");
+
+public:
+    typedef T value_type;
+    typedef T* iterator;
+    typedef const T* const_iterator;
+
+private:
+    u_int32_t count;
+    u_int32_t capacity;
+    union {
+        T inlineItems[N];
+        T* heapItems;
+    };
+
+public:
+    SmallVector() : count{0}, capacity{N} {}
+    SmallVector(const SmallVector& other) : count{0}, capacity{N} {
+        assign(other.begin(), other.end());
+    }
+    SmallVector(const SmallVector&&) = delete;
+    SmallVector& operator=(const SmallVector& other) {
+        if(this != &other) {
+            assign(other.begin(), other.end());
+        }
+        return *this;
+    }
+    SmallVector& operator=(const SmallVector&&) = delete;
+    ~SmallVector() {
+        if(!isInline()) {
+            free(heapItems);
+        }
+    }
+
+    T* data() { return isInline()? inlineItems: heapItems; }
+    const T* data() const { return isInline()? inlineItems: heapItems; }
+
+    iterator begin() { return data(); }
+    iterator end() { return data() + count; }
+    const_iterator begin() const { return data(); }
+    const_iterator end() const { return data() + count; }
+
+    size_t size() const { return count; }
+    bool empty() const { return count == 0; }
+    bool isInline() const { return capacity == N; }
+
+    T& operator[](size_t i) { return data()[i]; }
+    const T& operator[](size_t i) const { return data()[i]; }
+    const T& at(size_t i) const {
+        if(i >= count) {
+            throw std::out_of_range("SmallVector index out of range");
+        }
+        return data()[i];
+    }
+    const T& front() const { return data()[0]; }
+    const T& back() const { return data()[count-1]; }
+
+    void reserve(size_t n) {
+        if(n > capacity) {
+            grow(n);
+        }
+    }
+    void push_back(const T& item) {
+        if(count == capacity) {
+            grow(capacity*2);
+        }
+        data()[count++] = item;
+    }
+    void pop_back() { count--; }
+    iterator erase(const_iterator position) {
+        T* items = data();
+        size_t i = static_cast<size_t>(position - items);
+        memmove(items + i, items + i + 1, (count - i - 1)*sizeof(T));
+        count--;
+        return items + i;
+    }
+    template<typename I> void assign(I first, I last) {
+        count = 0;
+        for(; first != last; ++first) {
+            push_back(*first);
+        }
+    }
+
+    /**
+     * @brief Remove items and release heap storage (if any).
+     */
+    void clear() {
+        if(!isInline()) {
+            free(heapItems);
+            capacity = N;
+        }
+        count = 0;
+    }
+
+private:
+    void grow(size_t n) {
+        T* items = static_cast<T*>(malloc(n*sizeof(T)));
+        if(!items) {
+            throw std::bad_alloc{};
+        }
+        memcpy(items, data(), count*sizeof(T));
+        if(!isInline()) {
+            free(heapItems);
+        }
+        heapItems = items;
+        capacity = static_cast<u_int32_t>(n);
+    }
+};
+
+} // m8r namespace
+
+#endif /* M8R_SMALL_VECTOR_H_ */
@@ -0,0 +1,79 @@
+/*
+ string_pool.cpp     MindForger thinking notebook
+
+ Copyright (C) 2016-2025 Martin Dvorak <martin.dvorak@mindforger.com>
+
+ This program is free software; you can redistribute it and/or
+ modify it under the terms of the GNU General Public License
+ as published by the Free Software Foundation; either version 2
+ of the License, or (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+#include "string_pool.h"
+
+using namespace std;
+
+namespace m8r {
+
+StringPool::StringPool()
+    : mutex{},
+      strings{}
+{
+}
+
+StringPool::~StringPool()
+{
+}
+
+const string* StringPool::intern(const string& s)
+{
+    if(s.empty()) {
+        return empty();
+    }
+
+    lock_guard<std::mutex> lock{mutex};
+    auto i = strings.find(s);
+    if(i == strings.end()) {
+        i = strings.emplace(s, 0).first;
+    }
+    i->second++;
+    return &i->first;
+}
+
+void StringPool::release(const string* s)
+{
+    if(s == empty()) {
+        return;
+    }
+
+    lock_guard<std::mutex> lock{mutex};
+    auto i = strings.find(*s);
+    if(i != strings.end() && !--i->second) {
+        strings.erase(i);
+    }
+}
+
+size_t StringPool::size()
+{
+    lock_guard<std::mutex> lock{mutex};
+    return strings.size();
+}
+
+size_t StringPool::getBytes()
+{
+    lock_guard<std::mutex> lock{mutex};
+    size_t bytes = 0;
+    for(const auto& s:strings) {
+        bytes += s.first.size();
+    }
+    return bytes;
+}
+
+} // m8r namespace
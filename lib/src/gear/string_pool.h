@@ -0,0 +1,87 @@
+/*
+ string_pool.h     MindForger thinking notebook
+
+ Copyright (C) 2016-2025 Martin Dvorak <martin.dvorak@mindforger.com>
+
+ This program is free software; you can redistribute it and/or
+ modify it under the terms of the GNU General Public License
+ as published by the Free Software Foundation; either version 2
+ of the License, or (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+#ifndef M8R_STRING_POOL_H_
+#define M8R_STRING_POOL_H_
+
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+#include <sys/types.h>
+
+namespace m8r {
+
+/**
+ * @brief Pool of interned (reference counted) strings.
+ *
+ * Thing names (and autolinking names derived from them) are interned
+ * so that a Thing keeps just a pointer and equal names (like "Introduction"
+ * or "TODO" sections) are stored once. Pool is thread safe as Outlines are
+ * parsed in parallel.
+ */
+class StringPool
+{
+public:
+    static StringPool& getInstance() {
+        // static initialization order fiasco prevention (Things are static too)
+        static StringPool SINGLETON{};
+        return SINGLETON;
+    }
+
+    /**
+     * @brief Empty string which is not pooled i.e. not reference counted.
+     */
+    static const std::string* empty() {
+        static const std::string EMPTY{};
+        return &EMPTY;
+    }
+
+private:
+    std::mutex mutex;
+    // pointers to keys of unordered map are stable (rehashing doesn't move nodes)
+    std::unordered_map<std::string,u_int32_t> strings;
+
+public:
+    explicit StringPool();
+    StringPool(const StringPool&) = delete;
+    StringPool(const StringPool&&) = delete;
+    StringPool& operator=(const StringPool&) = delete;
+    StringPool& operator=(const StringPool&&) = delete;
+    ~StringPool();
+
+    /**
+     * @brief Get pooled instance of the string and increment its reference count.
+     */
+    const std::string* intern(const std::string& s);
+
+    /**
+     * @brief Decrement reference count and drop the string if it's no longer used.
+     */
+    void release(const std::string* s);
+
+    size_t size();
+    /**
+     * @brief Bytes occupied by characters of interned strings (w/o map overhead).
+     */
+    size_t getBytes();
+};
+
+} // m8r namespace
+
+#endif /* M8R_STRING_POOL_H_ */
@@ -20,6 +20,16 @@
 
 #include <cassert>
 
+#if defined(__GNUC__) || defined(__clang__)
+  #if defined(__AVX2__)
+    #include <immintrin.h>
+    #define M8R_FIND_IGNORE_CASE_AVX2
+  #elif defined(__SSE2__)
+    #include <emmintrin.h>
+    #define M8R_FIND_IGNORE_CASE_SSE2
+  #endif
+#endif
+
 using namespace std;
 
 namespace m8r {
@@ -192,4 +202,105 @@ void replaceAll(const std::string& old_s, const std::string& new_s, std::string&
     }
 }
 
+/*
+ * Case insensitive search
+ */
+
+static inline bool stringEqualsIgnoreCase(const char* s, const char* lowerS, size_t size)
+{
+    for(size_t i=0; i<size; i++) {
+        if(charToLower(s[i]) != lowerS[i]) {
+            return false;
+        }
+    }
+    return true;
+}
+
+#if defined(M8R_FIND_IGNORE_CASE_AVX2)
+typedef __m256i SimdBlock;
+static constexpr size_t SIMD_BLOCK_SIZE = 32;
+static inline SimdBlock simdLoad(const char* p) { return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p)); }
+static inline SimdBlock simdSplat(char c) { return _mm256_set1_epi8(c); }
+static inline SimdBlock simdLower(SimdBlock v) {
+    // 'A' <= c <= 'Z' (signed compare ~ UTF-8 bytes are negative i.e. kept)
+    const SimdBlock upper = _mm256_and_si256(
+        _mm256_cmpgt_epi8(v, _mm256_set1_epi8('A'-1)),
+        _mm256_cmpgt_epi8(_mm256_set1_epi8('Z'+1), v));
+    return _mm256_or_si256(v, _mm256_and_si256(upper, _mm256_set1_epi8('a'-'A')));
+}
+static inline uint32_t simdMatches(SimdBlock first, SimdBlock last, SimdBlock blockFirst, SimdBlock blockLast) {
+    return static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_and_si256(
+        _mm256_cmpeq_epi8(first, blockFirst),
+        _mm256_cmpeq_epi8(last, blockLast))));
+}
+#elif defined(M8R_FIND_IGNORE_CASE_SSE2)
+typedef __m128i SimdBlock;
+static constexpr size_t SIMD_BLOCK_SIZE = 16;
+static inline SimdBlock simdLoad(const char* p) { return _mm_loadu_si128(reinterpret_cast<const __m128i*>(p)); }
+static inline SimdBlock simdSplat(char c) { return _mm_set1_epi8(c); }
+static inline SimdBlock simdLower(SimdBlock v) {
+    // 'A' <= c <= 'Z' (signed compare ~ UTF-8 bytes are negative i.e. kept)
+    const SimdBlock upper = _mm_and_si128(
+        _mm_cmpgt_epi8(v, _mm_set1_epi8('A'-1)),
+        _mm_cmplt_epi8(v, _mm_set1_epi8('Z'+1)));
+    return _mm_or_si128(v, _mm_and_si128(upper, _mm_set1_epi8('a'-'A')));
+}
+static inline uint32_t simdMatches(SimdBlock first, SimdBlock last, SimdBlock blockFirst, SimdBlock blockLast) {
+    return static_cast<uint32_t>(_mm_movemask_epi8(_mm_and_si128(
+        _mm_cmpeq_epi8(first, blockFirst),
+        _mm_cmpeq_epi8(last, blockLast))));
+}
+#endif
+
+size_t stringFindIgnoreCase(
+    const char* haystack, size_t haystackSize, const char* lowerNeedle, size_t needleSize, size_t from)
+{
+    if(from > haystackSize || needleSize > haystackSize - from) {
+        return string::npos;
+    }
+    if(needleSize == 0) {
+        return from;
+    }
+
+    const char firstChar = lowerNeedle[0];
+    const char lastChar = lowerNeedle[needleSize-1];
+    // the last position where the needle may start
+    const size_t end = haystackSize - needleSize;
+    size_t i = from;
+
+#if defined(M8R_FIND_IGNORE_CASE_AVX2) || defined(M8R_FIND_IGNORE_CASE_SSE2)
+    // filter: lowercased 1st and last byte of the needle at positions i..i+SIMD_BLOCK_SIZE-1
+    const SimdBlock first = simdSplat(firstChar);
+    const SimdBlock last = simdSplat(lastChar);
+    for(; i + SIMD_BLOCK_SIZE - 1 <= end; i += SIMD_BLOCK_SIZE) {
+        uint32_t candidates = simdMatches(
+            first,
+            last,
+            simdLower(simdLoad(haystack + i)),
+            simdLower(simdLoad(haystack + i + needleSize - 1)));
+        while(candidates) {
+            const size_t candidate = i + __builtin_ctz(candidates);
+            if(needleSize <= 2
+               || stringEqualsIgnoreCase(haystack + candidate + 1, lowerNeedle + 1, needleSize - 2))
+            {
+                return candidate;
+            }
+            candidates &= candidates - 1;
+        }
+    }
+#endif
+
+    // portable scalar search (and the rest of the haystack which doesn't fill SIMD block)
+    for(; i <= end; i++) {
+        if(charToLower(haystack[i]) == firstChar
+           && charToLower(haystack[i + needleSize - 1]) == lastChar
+           && stringEqualsIgnoreCase(haystack + i + 1, lowerNeedle + 1, needleSize > 2? needleSize - 2: 0))
+        {
+            return i;
+        }
+    }
+
+    return string::npos;
+}
+
 } /* namespace */
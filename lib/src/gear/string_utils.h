@@ -20,6 +20,7 @@
 #define M8R_STRING_UTILS_H_
 
 #include <cctype>
+#include <cstdint>
 #include <cstring>
 
 #include <algorithm>
@@ -58,15 +59,23 @@ std::vector<std::string> stringSplit(const std::string s, const std::string rege
  */
 std::string normalizeToNcName(std::string name, char quoteChar);
 
+/**
+ * @brief Lowercase ASCII character (bytes of UTF-8 multi-byte sequences are kept).
+ */
+static inline char charToLower(char c)
+{
+    return c >= 'A' && c <= 'Z'? static_cast<char>(c + ('a'-'A')): c;
+}
+
 /**
  * @brief Check whether the strings are identical while ignoring case.
  */
 static inline bool stringistring(const std::string& a, const std::string& b)
 {
-    unsigned long long asize = a.size();
+    size_t asize = a.size();
     if(b.size()==asize) {
-        for(unsigned int i = 0; i < asize; ++i) {
-            if(tolower(a[i]) != tolower(b[i])) {
+        for(size_t i = 0; i < asize; ++i) {
+            if(charToLower(a[i]) != charToLower(b[i])) {
                 return false;
             }
         }
@@ -75,14 +84,40 @@ static inline bool stringistring(const std::string& a, const std::string& b)
     return false;
 }
 
+/**
+ * @brief Append lowercase copy of the string.
+ *
+ * Only ASCII letters are lowercased (classic locale) - UTF-8 multi-byte
+ * sequences are copied as they are.
+ */
 static inline void stringToLower(const std::string& s, std::string& lowerS)
 {
-    static const std::locale locale;
+    size_t offset = lowerS.size();
+    lowerS.resize(offset + s.size());
     for(std::string::size_type i=0; i<s.length(); ++i) {
-        lowerS += std::tolower(s[i],locale);
+        lowerS[offset + i] = charToLower(s[i]);
     }
 }
 
+/**
+ * @brief Find lowercase needle in the haystack while ignoring case of the haystack.
+ *
+ * Haystack is searched in place w/o allocation - candidate positions are found
+ * by SIMD (AVX2/SSE2 if available) filter which compares lowercased first
+ * and last byte of the needle w/ 16/32 haystack positions at once, candidates
+ * are verified by scalar comparison. Case folding is the same as in case
+ * of stringToLower() i.e. bytes of UTF-8 multi-byte sequences must match exactly.
+ *
+ * @param lowerNeedle   needle lowercased by stringToLower().
+ * @return position of the first match or std::string::npos.
+ */
+size_t stringFindIgnoreCase(
+    const char* haystack, size_t haystackSize, const char* lowerNeedle, size_t needleSize, size_t from=0);
+static inline size_t stringFindIgnoreCase(const std::string& haystack, const std::string& lowerNeedle, size_t from=0)
+{
+    return stringFindIgnoreCase(haystack.data(), haystack.size(), lowerNeedle.data(), lowerNeedle.size(), from);
+}
+
 /**
  * @brief Trim leading and trailing whitespaces.
  *
@@ -197,6 +232,37 @@ static inline std::string stringIntFormat(std::string value, char thousandSep =
 
 void replaceAll(const std::string& old_s, const std::string& new_s, std::string& s);
 
+/**
+ * @brief FNV-1a 64-bit hash - stable across runs and platforms (unlike std::hash).
+ */
+static inline uint64_t stringHash64(const char* s, size_t length, uint64_t hash=14695981039346656037ULL)
+{
+    for(size_t i=0; i<length; i++) {
+        hash ^= static_cast<unsigned char>(s[i]);
+        hash *= 1099511628211ULL;
+    }
+    return hash;
+}
+
+static inline uint64_t stringHash64(const std::string& s)
+{
+    return stringHash64(s.c_str(), s.size());
+}
+
+/**
+ * @brief Hash of text read as lines - the same as stringHash64() of the text
+ * w/ trailing newline (if missing).
+ */
+static inline uint64_t linesHash64(const std::vector<std::string*>& lines)
+{
+    uint64_t hash = 14695981039346656037ULL;
+    for(const std::string* line:lines) {
+        hash = stringHash64(line->c_str(), line->size(), hash);
+        hash = stringHash64("\n", 1, hash);
+    }
+    return hash;
+}
+
 } /* namespace*/
 
 #endif /* M8R_STRING_UTILS_H_ */
@@ -19,10 +19,252 @@
 
 #include "aa_model.h"
 
+#include <cmath>
+#include <cstdint>
+
 namespace m8r {
 
-AssociationAssessmentModel::AssociationAssessmentModel() = default;
+using namespace std;
+
+AssociationAssessmentModel::AssociationAssessmentModel()
+    : modelMutex{},
+      samples{},
+      labels{},
+      positiveSamples{0},
+      newSamples{0},
+      network{},
+      version{0},
+      trainerMutex{},
+      trainer{},
+      training{false}
+{
+}
+
+AssociationAssessmentModel::~AssociationAssessmentModel()
+{
+    lock_guard<mutex> trainerLock{trainerMutex};
+    if(trainer.valid()) {
+        trainer.wait();
+    }
+}
+
+void AssociationAssessmentModel::addSample(const AssociationAssessmentNotesFeature& feature, bool associated)
+{
+    lock_guard<mutex> criticalSection{modelMutex};
+
+    if(labels.size() >= MAX_TRAINING_SAMPLES) {
+        // forget the oldest sample
+        if(labels[0] > .5f) positiveSamples--;
+        samples.erase(samples.begin(), samples.begin()+INPUTS);
+        labels.erase(labels.begin());
+    }
+
+    const float* f = feature.getFeatures();
+    samples.insert(samples.end(), f, f+INPUTS);
+    labels.push_back(associated?1.f:0.f);
+    if(associated) positiveSamples++;
+    newSamples++;
+}
+
+size_t AssociationAssessmentModel::getSamplesCount()
+{
+    lock_guard<mutex> criticalSection{modelMutex};
+    return labels.size();
+}
+
+size_t AssociationAssessmentModel::getNewSamplesCount()
+{
+    lock_guard<mutex> criticalSection{modelMutex};
+    return newSamples;
+}
+
+bool AssociationAssessmentModel::isRetrainable(size_t newSamplesThreshold)
+{
+    return !training && getNewSamplesCount() >= newSamplesThreshold && isTrainable();
+}
+
+bool AssociationAssessmentModel::isTrainable()
+{
+    lock_guard<mutex> criticalSection{modelMutex};
+    return labels.size() >= MIN_TRAINING_SAMPLES
+        && positiveSamples > 0
+        && positiveSamples < labels.size();
+}
+
+bool AssociationAssessmentModel::isTrained()
+{
+    return getNetwork() != nullptr;
+}
+
+shared_ptr<const AssociationAssessmentModel::Network> AssociationAssessmentModel::getNetwork()
+{
+    lock_guard<mutex> criticalSection{modelMutex};
+    return network;
+}
+
+bool AssociationAssessmentModel::train()
+{
+    lock_guard<mutex> trainerLock{trainerMutex};
+    if(training) {
+        return false;
+    }
+    training = true;
+    bool result = trainSync();
+    training = false;
+    return result;
+}
+
+shared_future<bool> AssociationAssessmentModel::trainAsync()
+{
+    lock_guard<mutex> trainerLock{trainerMutex};
+    if(training) {
+        MF_DEBUG("AA model: training already in progress" << endl);
+        promise<bool> p{};
+        p.set_value(false);
+        return shared_future<bool>(p.get_future());
+    }
+
+    training = true;
+    trainer = Executor::getInstance().submit(
+        [this]() {
+            bool result = trainSync();
+            training = false;
+            return result;
+        },
+        Executor::Priority::BACKGROUND).share();
+
+    return trainer;
+}
+
+bool AssociationAssessmentModel::trainSync()
+{
+    MF_DEBUG("AA model: training NN..." << endl);
+
+    // train on a snapshot so that samples can be added while training
+    vector<double> inputs{};
+    vector<double> outputs{};
+    {
+        lock_guard<mutex> criticalSection{modelMutex};
+        if(labels.size() < MIN_TRAINING_SAMPLES || !positiveSamples || positiveSamples == labels.size()) {
+            MF_DEBUG("AA model: not enough samples to train NN" << endl);
+            return false;
+        }
+        inputs.assign(samples.begin(), samples.end());
+        outputs.assign(labels.begin(), labels.end());
+        newSamples = 0;
+    }
+
+    genann* ann = genann_init(INPUTS, 1, HIDDEN_NEURONS, 1);
+    if(!ann) {
+        cerr << "Error: unable to allocate association assessment NN" << endl;
+        return false;
+    }
+    // exact sigmoid - weights are used by batched inference which doesn't use lookup table
+    ann->activation_hidden = genann_act_sigmoid;
+    ann->activation_output = genann_act_sigmoid;
+    // deterministic weights initialization (genann uses global rand()) to [-0.5,0.5]
+    uint32_t seed = 0x4d46u;
+    for(int i=0; i<ann->total_weights; i++) {
+        seed = seed*1664525u + 1013904223u;
+        ann->weight[i] = (seed >> 8)/static_cast<double>(1u << 24) - .5;
+    }
+
+    const size_t count = outputs.size();
+    for(int epoch=0; epoch<TRAINING_EPOCHS; epoch++) {
+        for(size_t i=0; i<count; i++) {
+            genann_train(ann, &inputs[i*INPUTS], &outputs[i], LEARNING_RATE);
+        }
+    }
+
+    // publish inference copy of weights
+    shared_ptr<Network> trained = make_shared<Network>();
+    const double* w = ann->weight;
+    trained->hiddenWeights.assign(w, w+HIDDEN_NEURONS*(1+INPUTS));
+    w += HIDDEN_NEURONS*(1+INPUTS);
+    trained->outputWeights.assign(w, w+1+HIDDEN_NEURONS);
+    genann_free(ann);
+
+    {
+        lock_guard<mutex> criticalSection{modelMutex};
+        network = trained;
+    }
+    version++;
+
+    MF_DEBUG("AA model: NN trained on " << count << " samples" << endl);
+    return true;
+}
+
+/*
+ * Batched forward pass: features are processed column by column so that
+ * the inner loops over rows are multiply-add over contiguous arrays.
+ */
+void AssociationAssessmentModel::evaluate(const AssociationAssessmentFeatureMatrix& features, vector<float>& scores)
+{
+    const size_t rows = features.size();
+    scores.resize(rows);
+    if(!rows) {
+        return;
+    }
+    float* score = scores.data();
+
+    shared_ptr<const Network> nn = getNetwork();
+    if(!nn) {
+        // not trained yet - hand-written metric
+        std::fill(scores.begin(), scores.end(), 0.f);
+        for(int f=0; f<INPUTS; f++) {
+            const float weight = AssociationAssessmentNotesFeature::metricWeight(f);
+            const float* column = features.getColumn(f);
+            for(size_t r=0; r<rows; r++) {
+                score[r] += weight*column[r];
+            }
+        }
+        return;
+    }
+
+    vector<float> hidden(rows);
+    float* h = hidden.data();
+    const float* ow = nn->outputWeights.data();
+    std::fill(scores.begin(), scores.end(), -ow[0]);
+    for(int n=0; n<HIDDEN_NEURONS; n++) {
+        const float* hw = &nn->hiddenWeights[n*(1+INPUTS)];
+        std::fill(hidden.begin(), hidden.end(), -hw[0]);
+        for(int f=0; f<INPUTS; f++) {
+            const float weight = hw[1+f];
+            const float* column = features.getColumn(f);
+            for(size_t r=0; r<rows; r++) {
+                h[r] += weight*column[r];
+            }
+        }
+        const float weight = ow[1+n];
+        for(size_t r=0; r<rows; r++) {
+            score[r] += weight/(1.f+std::exp(-h[r]));
+        }
+    }
+    for(size_t r=0; r<rows; r++) {
+        score[r] = 1.f/(1.f+std::exp(-score[r]));
+    }
+}
+
+float AssociationAssessmentModel::evaluate(const AssociationAssessmentNotesFeature& feature)
+{
+    AssociationAssessmentFeatureMatrix features{};
+    features.add(feature);
+    vector<float> scores{};
+    evaluate(features, scores);
+    return scores[0];
+}
 
-AssociationAssessmentModel::~AssociationAssessmentModel() = default;
+void AssociationAssessmentModel::clear()
+{
+    lock_guard<mutex> criticalSection{modelMutex};
+    samples.clear();
+    labels.clear();
+    positiveSamples = 0;
+    newSamples = 0;
+    if(network) {
+        network.reset();
+        version++;
+    }
+}
 
 } // m8r namespace
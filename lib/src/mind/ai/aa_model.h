@@ -19,15 +19,72 @@
 #ifndef M8R_ASSOCIATION_ASSESSMENT_MODEL_H
 #define M8R_ASSOCIATION_ASSESSMENT_MODEL_H
 
+#include <atomic>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <vector>
+
 #include "aa_notes_feature.h"
+#include "../../gear/executor.h"
+#include "nn/genann.h"
 
 namespace m8r {
 
 /**
  * @brief Associations assessment neural network model.
+ *
+ * Association scorer backed by genann feed forward network with single
+ * hidden layer. The network is trained from user-confirmed associations
+ * (positive samples) and skipped suggestions (negative samples) in
+ * the background - training runs on a private copy of the network
+ * and the trained weights are published atomically, therefore
+ * inference is never blocked by training.
+ *
+ * Until there are enough samples of both classes, the model falls back
+ * to AssociationAssessmentNotesFeature::areNotesAssociatedMetric().
+ *
+ * Inference is batched: all candidate pairs of a Note are scored by one
+ * evaluate() call over a columnar feature matrix.
  */
 class AssociationAssessmentModel
 {
+public:
+    static constexpr int HIDDEN_NEURONS = 8;
+    static constexpr size_t MIN_TRAINING_SAMPLES = 8;
+    static constexpr size_t MAX_TRAINING_SAMPLES = 4096;
+    static constexpr int TRAINING_EPOCHS = 300;
+    static constexpr double LEARNING_RATE = 0.5;
+
+private:
+    static constexpr int INPUTS = AssociationAssessmentNotesFeature::FEATURES_SIZE;
+
+    /*
+     * Inference copy of the trained network weights - genann layout
+     * (per neuron: bias weight followed by input weights) in float.
+     */
+    struct Network {
+        // HIDDEN_NEURONS x (1+INPUTS)
+        std::vector<float> hiddenWeights;
+        // 1+HIDDEN_NEURONS
+        std::vector<float> outputWeights;
+    };
+
+    std::mutex modelMutex;
+    // training samples (row major) and labels guarded by modelMutex
+    std::vector<float> samples;
+    std::vector<float> labels;
+    size_t positiveSamples;
+    // samples added since the last training (window of samples is bounded)
+    size_t newSamples;
+    std::shared_ptr<const Network> network;
+    std::atomic<unsigned> version;
+
+    std::mutex trainerMutex;
+    // background training task submitted to the executor
+    std::shared_future<bool> trainer;
+    std::atomic<bool> training;
+
 public:
     explicit AssociationAssessmentModel();
     AssociationAssessmentModel(const AssociationAssessmentModel&) = delete;
@@ -35,6 +92,55 @@ public:
     AssociationAssessmentModel &operator=(const AssociationAssessmentModel&) = delete;
     AssociationAssessmentModel &operator=(const AssociationAssessmentModel&&) = delete;
     ~AssociationAssessmentModel();
+
+    /**
+     * @brief Add training sample - associated (confirmed) or not associated Notes.
+     */
+    void addSample(const AssociationAssessmentNotesFeature& feature, bool associated);
+    size_t getSamplesCount();
+    size_t getNewSamplesCount();
+    /**
+     * @brief Check whether there are enough samples of both classes to train.
+     */
+    bool isTrainable();
+    /**
+     * @brief Check whether there are enough new samples to retrain (and training isn't running).
+     */
+    bool isRetrainable(size_t newSamplesThreshold);
+    bool isTrained();
+    /**
+     * @brief Model version - incremented whenever new weights are published.
+     */
+    unsigned getVersion() const { return version; }
+    bool isTraining() const { return training; }
+
+    /**
+     * @brief Train network from samples synchronously.
+     */
+    bool train();
+    /**
+     * @brief Train network in the background (executor task).
+     *
+     * Future is immediately set to false if training is already running.
+     */
+    std::shared_future<bool> trainAsync();
+
+    /**
+     * @brief Score all feature matrix rows with one batched forward pass.
+     *
+     * Scores are in [0,1], vector is resized to the number of rows.
+     */
+    void evaluate(const AssociationAssessmentFeatureMatrix& features, std::vector<float>& scores);
+    float evaluate(const AssociationAssessmentNotesFeature& feature);
+
+    /**
+     * @brief Forget samples and trained network.
+     */
+    void clear();
+
+private:
+    bool trainSync();
+    std::shared_ptr<const Network> getNetwork();
 };
 
 }
@@ -35,4 +35,37 @@ void AssociationAssessmentNotesFeature::clearFeatures()
     for(int i=0; i<FEATURES_SIZE; i++) features[i]=0.;
 }
 
+/*
+ * Features matrix
+ */
+
+AssociationAssessmentFeatureMatrix::AssociationAssessmentFeatureMatrix()
+    : rows{0}
+{
+}
+
+AssociationAssessmentFeatureMatrix::~AssociationAssessmentFeatureMatrix()
+{
+}
+
+void AssociationAssessmentFeatureMatrix::reserve(size_t capacity)
+{
+    for(auto& c:columns) c.reserve(capacity);
+}
+
+void AssociationAssessmentFeatureMatrix::clear()
+{
+    for(auto& c:columns) c.clear();
+    rows = 0;
+}
+
+void AssociationAssessmentFeatureMatrix::add(const AssociationAssessmentNotesFeature& feature)
+{
+    const float* f = feature.getFeatures();
+    for(int i=0; i<AssociationAssessmentNotesFeature::FEATURES_SIZE; i++) {
+        columns[i].push_back(f[i]);
+    }
+    rows++;
+}
+
 } // m8r namespace
@@ -20,6 +20,7 @@
 #define M8R_ASSOCIATION_ASSESSMENT_NOTES_FEATURE_H
 
 #include <map>
+#include <vector>
 
 #include "../../debug.h"
 #include "../../model/note.h"
@@ -61,6 +62,8 @@ public:
 
     void clearFeatures();
 
+    const float* getFeatures() const { return features; }
+
     void setHaveMutualRel(bool haveRel) {
         features[IDX_HAVE_MUTUAL_REL] = haveRel?1.f:0.f;
     }
@@ -116,7 +119,7 @@ public:
      * I start from 100% i.e. what makes Ns to be associations. I alocate portions of 100% to
      * each similarity aspect A: 10%*A1+40%*A2+...+5%*AN=100% (<=> if As==1).
      */
-    float areNotesAssociatedMetric() {
+    float areNotesAssociatedMetric() const {
 #ifdef DO_MF_DEBUG
 //        std::cout <<
 //                "------------" << std::endl <<
@@ -128,16 +131,57 @@ public:
 //                "by-descs  : " << features[IDX_SIMILARITY_BY_DESCRIPTIONS] << std::endl
 //                ;
 #endif
-        return
-            // features[IDX_HAVE_MUTUAL_REL] * 0.25 + ... temporarily added to TEXT
-            features[IDX_TYPE_MATCHES] * 0.1f +
-            features[IDX_SAME_OUTLINE] * 0.05f +
-            features[IDX_SIMILARITY_BY_TAGS] * 0.2f +
-            features[IDX_SIMILARITY_BY_TITLES] * 0.2f +
-            features[IDX_SIMILARITY_BY_DESCRIPTIONS] * (0.2f+0.25f) +
-            features[IDX_SIMILARITY_BY_SAME_TARGETS_RELS] * 0.1f
-            ;
+        float metric = 0.f;
+        for(int i=0; i<FEATURES_SIZE; i++) {
+            metric += features[i] * metricWeight(i);
+        }
+        return metric;
     }
+
+    /**
+     * @brief Weight of the feature in the metric - weights sum is 1.
+     */
+    static float metricWeight(int feature) {
+        switch(feature) {
+        // IDX_HAVE_MUTUAL_REL 0.25 ... temporarily added to TEXT
+        case IDX_TYPE_MATCHES: return 0.1f;
+        case IDX_SAME_OUTLINE: return 0.05f;
+        case IDX_SIMILARITY_BY_TAGS: return 0.2f;
+        case IDX_SIMILARITY_BY_TITLES: return 0.2f;
+        case IDX_SIMILARITY_BY_DESCRIPTIONS: return 0.2f+0.25f;
+        case IDX_SIMILARITY_BY_SAME_TARGETS_RELS: return 0.1f;
+        default: return 0.f;
+        }
+    }
+};
+
+/**
+ * @brief Batch of Notes Association Assessment features.
+ *
+ * Features are stored column-wise (structure of arrays) i.e. values
+ * of one feature for all rows are contiguous, which allows the association
+ * model to evaluate the whole batch in tight loops the compiler vectorizes.
+ */
+class AssociationAssessmentFeatureMatrix
+{
+private:
+    size_t rows;
+    std::vector<float> columns[AssociationAssessmentNotesFeature::FEATURES_SIZE];
+
+public:
+    explicit AssociationAssessmentFeatureMatrix();
+    AssociationAssessmentFeatureMatrix(const AssociationAssessmentFeatureMatrix&) = delete;
+    AssociationAssessmentFeatureMatrix(const AssociationAssessmentFeatureMatrix&&) = delete;
+    AssociationAssessmentFeatureMatrix &operator=(const AssociationAssessmentFeatureMatrix&) = delete;
+    AssociationAssessmentFeatureMatrix &operator=(const AssociationAssessmentFeatureMatrix&&) = delete;
+    ~AssociationAssessmentFeatureMatrix();
+
+    void reserve(size_t capacity);
+    void clear();
+    void add(const AssociationAssessmentNotesFeature& feature);
+
+    size_t size() const { return rows; }
+    const float* getColumn(int feature) const { return columns[feature].data(); }
 };
 
 }
@@ -23,10 +23,11 @@ namespace m8r {
 using namespace std;
 
 Ai::Ai(Memory& memory, Mind& mind)
+    : aaModel{new AssociationAssessmentModel{}}
 {
     switch(Configuration::getInstance().getAaAlgorithm()) {
     case Configuration::AssociationAssessmentAlgorithm::BOW:
-        aa = new AiAaBoW{memory,mind};
+        aa = new AiAaBoW{memory,mind,*aaModel};
         break;
     case Configuration::AssociationAssessmentAlgorithm::WEIGHTED_FTS:
         aa = new AiAaWeightedFts{memory,mind};
@@ -39,13 +40,50 @@ Ai::Ai(Memory& memory, Mind& mind)
 Ai::~Ai()
 {
     if(aa) delete aa;
+    // waits for training to finish
+    delete aaModel;
 }
 
-void Ai::trainAaNn()
+void Ai::confirmAssociation(
+    const Note* note,
+    const Note* association,
+    const vector<pair<Note*,float>>& leaderboard)
+{
+    if(!aa || !note || !association) {
+        return;
+    }
+
+    AssociationAssessmentNotesFeature feature{};
+    if(aa->createAaFeature(note, association, feature)) {
+        aaModel->addSample(feature, true);
+    } else {
+        return;
+    }
+
+    // skipped associations
+    for(size_t i=0; i<leaderboard.size(); i++) {
+        const Note* skipped = leaderboard[i].first;
+        if(skipped == association) {
+            if(i+1 < leaderboard.size()) {
+                // jump to the last one
+                i = leaderboard.size()-2;
+            }
+            continue;
+        }
+        if(aa->createAaFeature(note, skipped, feature)) {
+            aaModel->addSample(feature, false);
+        }
+    }
+
+    if(aaModel->isRetrainable(AA_NN_RETRAIN_SAMPLES)) {
+        trainAaNn();
+    }
+}
+
+shared_future<bool> Ai::trainAaNn()
 {
     MF_DEBUG("AI: training AA NN..." << endl);
-    // TODO train NN using a reasonable number of features: createAaFeature()
-    MF_DEBUG("AI: AA NN trained!" << endl);
+    return aaModel->trainAsync();
 }
 
 } // m8r namespace
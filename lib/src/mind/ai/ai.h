@@ -77,7 +77,11 @@ private:
      * Neural network models
      */
 
-    // TODO AssociationAssessmentModel* aaModel;
+    // number of new samples which triggers AA NN (re)training
+    static constexpr size_t AA_NN_RETRAIN_SAMPLES = 8;
+
+    // Associations assessment model trained from user confirmed associations
+    AssociationAssessmentModel* aaModel;
 
 public:
     explicit Ai(Memory& memory, Mind& mind);
@@ -116,6 +120,23 @@ public:
         return aa->getAssociatedNotes(words, associations, self);
     }
 
+    /**
+     * @brief Learn from association of the note confirmed by user.
+     *
+     * Association chosen by user from the leaderboard is a positive sample,
+     * associations ranked higher than the chosen one (and the last one)
+     * are skipped by user i.e. negative samples. Associations assessment
+     * NN is (re)trained in the background once there are enough new samples.
+     *
+     * Synchronized by caller ~ Mind.
+     */
+    void confirmAssociation(
+        const Note* note,
+        const Note* association,
+        const std::vector<std::pair<Note*,float>>& leaderboard);
+
+    AssociationAssessmentModel& getAaModel() { return *aaModel; }
+
     /**
      * @brief Clear, but don't deallocate.
      *
@@ -137,9 +158,9 @@ public:
 private:
 
     /**
-     * @brief Train associations assessment neural network once memory is learned.
+     * @brief Train associations assessment neural network in the background.
      */
-    void trainAaNn();
+    std::shared_future<bool> trainAaNn();
 
 #ifdef DO_MF_DEBUG
 public:
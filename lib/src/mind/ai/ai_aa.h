@@ -23,6 +23,8 @@
 #include <vector>
 
 #include "../../model/outline.h"
+#include "../../gear/lang_utils.h"
+#include "aa_notes_feature.h"
 
 namespace m8r {
 
@@ -73,6 +75,21 @@ public:
      */
     virtual std::shared_future<bool> getAssociatedNotes(const std::string& words, std::vector<std::pair<Note*,float>>& associations, const Note* self) = 0;
 
+    /**
+     * @brief Create association assessment feature for given Notes.
+     *
+     * Features are used to train associations assessment model from
+     * associations confirmed by user.
+     *
+     * @return false if the implementation doesn't use features or Notes are not learned.
+     */
+    virtual bool createAaFeature(const Note* n1, const Note* n2, AssociationAssessmentNotesFeature& feature) {
+        UNUSED_ARG(n1);
+        UNUSED_ARG(n2);
+        UNUSED_ARG(feature);
+        return false;
+    }
+
     /**
      * @brief Clear.
      */
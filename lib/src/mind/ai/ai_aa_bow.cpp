@@ -22,39 +22,41 @@ namespace m8r {
 
 using namespace std;
 
-AiAaBoW::AiAaBoW(Memory& memory, Mind& mind)
+AiAaBoW::AiAaBoW(Memory& memory, Mind& mind, AssociationAssessmentModel& aaModel)
     : mind(mind),
       memory(memory),
+      aaModel(aaModel),
+      aaModelVersion{aaModel.getVersion()},
       lexicon{},
       wordBlacklist{},
-      tokenizer{lexicon,wordBlacklist}
+      tokenizer{lexicon,wordBlacklist},
+      leaderboardToken{},
+      tasksMutex{},
+      tasksFinished{},
+      tasksInFlight{0}
 {
 }
 
 AiAaBoW::~AiAaBoW()
 {
-    // delete dead threads
-    auto zombieIterator
-        = std::remove_if(runningWorkers.begin(),
-                         runningWorkers.end(),
-                         [](const thread* t) { if(!t->joinable()) { delete t; return true; } else return false; });
-    runningWorkers.erase(zombieIterator, runningWorkers.end());
+    // stale leaderboards are not needed anymore, but tasks must finish before this is deleted
+    leaderboardToken.cancel();
+    unique_lock<mutex> tasksLock{tasksMutex};
+    tasksFinished.wait(tasksLock, [this]() { return tasksInFlight == 0; });
 }
 
-void AiAaBoW::addWorkerAndCleanZombies(thread* t)
+void AiAaBoW::taskStarted()
 {
-    lock_guard<mutex> criticalSection{runningWorkersMutex};
-    MF_DEBUG("AA.BoW: workers+zombies " << runningWorkers.size() << endl);
-
-    // IMPROVE: if zombies is erased > future/promise is deleted as well > frontend that has future calls a method on it > crash
-    //   - temporal SOLUTION: threads are deleted on MF exit (i.e. finished threads are kept in memory for whole MF run)
-    //     (see destructor for dead threads code to move in here)
-    //   - IDEA: frontend could use a thread hook to indicate that it got future and t can be freed
-
-    // add new one
-    runningWorkers.push_back(t);
+    lock_guard<mutex> tasksLock{tasksMutex};
+    tasksInFlight++;
+    MF_DEBUG("AA.BoW: tasks in flight " << tasksInFlight << endl);
+}
 
-    MF_DEBUG("AA.BoW: workers " << runningWorkers.size() << endl);
+void AiAaBoW::taskFinished()
+{
+    lock_guard<mutex> tasksLock{tasksMutex};
+    tasksInFlight--;
+    tasksFinished.notify_all();
 }
 
 // it's presumed that caller ensures the correct Mind state & synchronization
@@ -62,15 +64,15 @@ shared_future<bool> AiAaBoW::dream() {
     if(memory.getNotesCount() > Configuration::getInstance().getAsyncMindThreshold()) {
         MF_DEBUG("AA.BoW: ASYNC dream..." << endl);
         mind.incActiveProcesses();
-
-        // packaged task is parametrized by function/method signature (not return type)
-        std::packaged_task<bool (AiAaBoW*,thread*)> learnMemoryTask([](AiAaBoW* a,thread* t) { return a->learnMemorySync(t); });
-        future<bool> result = learnMemoryTask.get_future(); // move
-        thread* t = new thread{};
-        *t = thread(std::move(learnMemoryTask), this, t);
-        addWorkerAndCleanZombies(t);
-
-        return shared_future<bool>(std::move(result));
+        taskStarted();
+
+        return Executor::getInstance().submit(
+            [this]() {
+                bool result = learnMemorySync();
+                taskFinished();
+                return result;
+            },
+            Executor::Priority::BACKGROUND).share();
     } else {
         MF_DEBUG("AA.BoW: SYNC dream..." << endl);
         promise<bool> p{};
@@ -83,9 +85,16 @@ shared_future<bool> AiAaBoW::dream() {
     }
 }
 
-bool AiAaBoW::learnMemorySync(thread* t)
+bool AiAaBoW::learnMemorySync()
 {
     MF_DEBUG("AA.BoW: LEARNING memory to BoW..." << endl);
+    // leaderboard tasks use Ns, BoW and AA matrix > rebuild them exclusively
+    unique_lock<mutex> aaMatrixLock{aaMatrixMutex};
+    {
+        // cached leaderboards refer to Ns and indices of the previous model
+        lock_guard<mutex> leaderboardLock{leaderboardMutex};
+        leaderboardCache.clear();
+    }
     notes.clear();
     memory.getAllNotes(notes);
     // let N know it's indexed in AI
@@ -97,6 +106,8 @@ bool AiAaBoW::learnMemorySync(thread* t)
     lexicon.clear();
     bow.clear();
     for(Note* n:notes) {
+        // lazy memory must not evict N description while it's tokenized
+        OutlineBodiesPin pin{n->getOutline()};
         NoteCharProvider chars{n};
         WordFrequencyList* wfl = new WordFrequencyList{&lexicon};
         tokenizer.tokenize(chars, *wfl);
@@ -125,10 +136,10 @@ bool AiAaBoW::learnMemorySync(thread* t)
     }
 
     // NN to be trained on demand - just initialize it
+    aaMatrixLock.unlock();
 
     mind.persistMindState(Configuration::MindState::THINKING);
     mind.decActiveProcesses();
-    if(t) t->detach(); // indicate that thread finished
 
     MF_DEBUG("AA.BoW: memory LEARNED!" << endl);
     return true;
@@ -136,6 +147,9 @@ bool AiAaBoW::learnMemorySync(thread* t)
 
 // it's presumed that caller ensures the correct Mind state & synchronization
 shared_future<bool> AiAaBoW::getAssociatedNotes(const Note* note, vector<pair<Note*,float>>& associations) {
+    checkAaModelVersion();
+
+    unique_lock<mutex> leaderboardLock{leaderboardMutex};
     auto cachedLeaderboard = leaderboardCache.find(note);
     if(cachedLeaderboard != leaderboardCache.end()) {
         MF_DEBUG("AA.BoW: SYNC leaderboard calculation for '" << note->getName() << "'" << endl);
@@ -156,17 +170,33 @@ shared_future<bool> AiAaBoW::getAssociatedNotes(const Note* note, vector<pair<No
             MF_DEBUG("AA.BoW: leaderboard WIP for '" << note->getName() << "'" << endl);
             return p.get_future(); // move
         } else {
-            mind.incActiveProcesses();
-            MF_DEBUG("AA.BoW: starting THREAD for '" << note->getName() << "'" << endl);
+            // user moved to another N > leaderboards which haven't been calculated yet are stale
+            leaderboardToken.cancel();
+            leaderboardToken = Executor::CancellationToken{};
+            Executor::CancellationToken token = leaderboardToken;
 
-            // packaged task is parametrized by function/method signature (not return type)
-            packaged_task<bool (AiAaBoW*,const Note*,thread*)> calculateLeaderboardTask([](AiAaBoW* a, const Note* n, thread* t) { return a->calculateLeaderboardSync(n,t); });
-            future<bool> result = calculateLeaderboardTask.get_future(); // move
-            thread* t = new thread{};
-            *t = thread(std::move(calculateLeaderboardTask), this, note, t); // run task w/ handle to self thread
-            addWorkerAndCleanZombies(t);
+            leaderboardWip.insert(note);
+            leaderboardLock.unlock();
 
-            return shared_future<bool>(std::move(result));
+            mind.incActiveProcesses();
+            taskStarted();
+            MF_DEBUG("AA.BoW: submitting leaderboard TASK for '" << note->getName() << "'" << endl);
+
+            return Executor::getInstance().submit(
+                [this, note, token]() {
+                    bool result = false;
+                    if(token.isCancelled()) {
+                        MF_DEBUG("AA.BoW: leaderboard for '" << note->getName() << "' CANCELLED" << endl);
+                        lock_guard<mutex> leaderboardLock{leaderboardMutex};
+                        leaderboardWip.erase(note);
+                        mind.decActiveProcesses();
+                    } else {
+                        result = calculateLeaderboardSync(note);
+                    }
+                    taskFinished();
+                    return result;
+                },
+                Executor::Priority::INTERACTIVE).share();
         }
     }
 }
@@ -184,35 +214,31 @@ void AiAaBoW::calculateAaRow(size_t y)
         return;
     }
 
-    float aa;
+    // features of all pairs to calculate are scored by the model in one batch
     AssociationAssessmentNotesFeature aaFeature{};
+    AssociationAssessmentFeatureMatrix aaFeatures{};
+    vector<size_t> xs{};
+    vector<float> aas{};
 
     notes[y]->setAiAaMatrixIndex(y);
+    aaFeatures.reserve(aaMatrix.size());
     for(size_t x=0; x<aaMatrix.size(); x++) {
-        // set diagonal at the end
-        if(x!=y) {
-            // skip if value has been already calculated
-            if(aaMatrix[y][x] == AA_NOT_SET) {
-                Note* n1 = notes[x];
-                Note* n2 = notes[y];
-
-                aaFeature.setHaveMutualRel(false); // TODO
-                aaFeature.setTypeMatches(n1->getType()==n2->getType());
-                aaFeature.setSimilaritySameOutline(n1->getOutline()==n2->getOutline());
-                aaFeature.setSimilarityByTags(calculateSimilarityByTags(n1->getTags(),n2->getTags()));
-                aaFeature.setSimilarityByTitles(calculateSimilarityByTitles(n1->getName(),n2->getName()));
-                aaFeature.setSimilarityByDescription(calculateSimilarityByWords(*bow.get(n1),*bow.get(n2),AA_WORD_RELEVANCY_THRESHOLD));
-                aaFeature.setSimilarityBySameTargetRels(0.0); // TODO nice
-
-                aa = aaFeature.areNotesAssociatedMetric();
-
-                // set AA ranking both below and above diagonal - detection will be faster later (no check x>y needed)
-                aaMatrix[x][y] = aa;
-                aaMatrix[y][x] = aa;
-            }
+        // set diagonal at the end; skip if value has been already calculated
+        if(x!=y && aaMatrix[y][x] == AA_NOT_SET) {
+            calculateAaFeature(x, y, aaFeature);
+            aaFeatures.add(aaFeature);
+            xs.push_back(x);
         }
     }
 
+    aaModel.evaluate(aaFeatures, aas);
+
+    for(size_t i=0; i<xs.size(); i++) {
+        // set AA ranking both below and above diagonal - detection will be faster later (no check x>y needed)
+        aaMatrix[xs[i]][y] = aas[i];
+        aaMatrix[y][xs[i]] = aas[i];
+    }
+
     // set diagonal at the end to indicate calculation is done (consider reentrancy)
     aaMatrix[y][y] = 1.;
 
@@ -234,42 +260,34 @@ void AiAaBoW::precalculateAa()
 #endif
 
     // calculate FULL matrix of Ns associativity assessment for every N1 and N2 tuple
-    float aa;
     AssociationAssessmentNotesFeature aaFeature{};
+    AssociationAssessmentFeatureMatrix aaFeatures{};
+    vector<float> aas{};
+    aaFeatures.reserve(aaMatrix.size());
     for(size_t y=0; y<aaMatrix.size(); y++) {
         notes[y]->setAiAaMatrixIndex(y); // sets index for ALL notes in notes vector
 
 #ifdef DO_MF_DEBUG
         p = c/(UNIQUE_AA_CELLS/100.);
         MF_DEBUG("    " << (int)p << "% AA matrix rankings for '" << notes[y]->getName() << "'" << endl);
+        c += aaMatrix.size()-y;
 #endif
 
         // calculate only values ABOVE diagonal i.e. initialize x=y
-        for(size_t x=y; x<aaMatrix.size(); x++) {
-#ifdef DO_MF_DEBUG
-            c++;
-#endif
+        aaMatrix[y][y] = 1.;
+        aaFeatures.clear();
+        for(size_t x=y+1; x<aaMatrix.size(); x++) {
+            calculateAaFeature(x, y, aaFeature);
+            aaFeatures.add(aaFeature);
+        }
 
-            if(x==y) {
-                aaMatrix[x][y] = 1.;
-            } else {
-                Note* n1 = notes[x];
-                Note* n2 = notes[y];
-
-                aaFeature.setHaveMutualRel(false); // TODO
-                aaFeature.setTypeMatches(n1->getType()==n2->getType());
-                aaFeature.setSimilaritySameOutline(n1->getOutline()==n2->getOutline());
-                aaFeature.setSimilarityByTags(calculateSimilarityByTags(n1->getTags(),n2->getTags()));
-                aaFeature.setSimilarityByTitles(calculateSimilarityByTitles(n1->getName(),n2->getName()));
-                aaFeature.setSimilarityByDescription(calculateSimilarityByWords(*bow.get(n1),*bow.get(n2),AA_WORD_RELEVANCY_THRESHOLD));
-                aaFeature.setSimilarityBySameTargetRels(0.0); // TODO nice
-
-                aa = aaFeature.areNotesAssociatedMetric();
-
-                // set AA ranking both below and above diagonal - detection will be faster later (no check x>y needed)
-                aaMatrix[x][y] = aa;
-                aaMatrix[y][x] = aa;
-            }
+        // row is scored by the model in one batch
+        aaModel.evaluate(aaFeatures, aas);
+
+        for(size_t x=y+1; x<aaMatrix.size(); x++) {
+            // set AA ranking both below and above diagonal - detection will be faster later (no check x>y needed)
+            aaMatrix[x][y] = aas[x-y-1];
+            aaMatrix[y][x] = aas[x-y-1];
         }
     }
 
@@ -280,6 +298,52 @@ void AiAaBoW::precalculateAa()
 #endif
 }
 
+void AiAaBoW::calculateAaFeature(size_t x, size_t y, AssociationAssessmentNotesFeature& aaFeature)
+{
+    Note* n1 = notes[x];
+    Note* n2 = notes[y];
+
+    aaFeature.setHaveMutualRel(false); // TODO
+    aaFeature.setTypeMatches(n1->getType()==n2->getType());
+    aaFeature.setSimilaritySameOutline(n1->getOutline()==n2->getOutline());
+    aaFeature.setSimilarityByTags(calculateSimilarityByTags(n1->getTags(),n2->getTags()));
+    aaFeature.setSimilarityByTitles(calculateSimilarityByTitles(n1->getName(),n2->getName()));
+    aaFeature.setSimilarityByDescription(calculateSimilarityByWords(*bow.get(n1),*bow.get(n2),AA_WORD_RELEVANCY_THRESHOLD));
+    aaFeature.setSimilarityBySameTargetRels(0.0); // TODO nice
+}
+
+// it's presumed that caller ensures the correct Mind state & synchronization
+bool AiAaBoW::createAaFeature(const Note* n1, const Note* n2, AssociationAssessmentNotesFeature& feature)
+{
+    int x = n1->getAiAaMatrixIndex();
+    int y = n2->getAiAaMatrixIndex();
+    if(x == AA_NOT_SET || y == AA_NOT_SET || x == y
+       || static_cast<size_t>(x) >= notes.size() || static_cast<size_t>(y) >= notes.size()
+       || notes[x] != n1 || notes[y] != n2)
+    {
+        // Ns not learned (yet)
+        return false;
+    }
+
+    calculateAaFeature(x, y, feature);
+    return true;
+}
+
+// it's presumed that caller ensures the correct Mind state & synchronization
+void AiAaBoW::checkAaModelVersion()
+{
+    if(aaModelVersion != aaModel.getVersion() && mind.isActiveProcesses()) {
+        MF_DEBUG("AA.BoW: AA model retrained - forgetting AA rankings" << endl);
+        aaModelVersion = aaModel.getVersion();
+        lock_guard<mutex> aaMatrixLock{aaMatrixMutex};
+        lock_guard<mutex> leaderboardLock{leaderboardMutex};
+        leaderboardCache.clear();
+        for(size_t i=0; i<aaMatrix.size(); ++i) {
+            std::fill(aaMatrix[i].begin(), aaMatrix[i].end(), (float)AiAaBoW::AA_NOT_SET);
+        }
+    }
+}
+
 float AiAaBoW::calculateSimilarityByTitles(const string& t1, const string& t2)
 {
     StringCharProvider cp1{t1};
@@ -322,7 +386,7 @@ float AiAaBoW::calculateSimilarityByTitles(const string& t1, const string& t2)
 }
 
 // algorithm is based on similarity by words (for now there are no weights - might be added later if needed by other lib functions)
-float AiAaBoW::calculateSimilarityByTags(const vector<const Tag*>* t1, const vector<const Tag*>* t2)
+float AiAaBoW::calculateSimilarityByTags(const TagVector* t1, const TagVector* t2)
 {
     if(!t1->size()) {
         if(!t2->size()) {
@@ -409,19 +473,20 @@ float AiAaBoW::calculateSimilarityByWords(WordFrequencyList& v1, WordFrequencyLi
     }
 }
 
-bool AiAaBoW::calculateLeaderboardSync(const Note* n, thread* t)
+bool AiAaBoW::calculateLeaderboardSync(const Note* n)
 {
-    MF_DEBUG("AA.BoW: SYNC leaderboard calculation for '" << n->getName() << "' in thread " << t << endl);
+    MF_DEBUG("AA.BoW: SYNC leaderboard calculation for '" << n->getName() << "'" << endl);
 
     // If N was REMOVED, then nobody will ask for leaderboard.
     // If N was MODIFIED, then leaderboard will not be accurate (but it's not critical).
     // If N was ADDED, then I don't have data - no leaderboard provided.
-    if(n->getAiAaMatrixIndex() != AA_NOT_SET) {
-        // check cache
-        auto cachedLeaderboard = leaderboardCache.find(n);
-        if(cachedLeaderboard != leaderboardCache.end()) {
-            return true;
-        }
+    bool cached;
+    {
+        lock_guard<mutex> leaderboardLock{leaderboardMutex};
+        cached = leaderboardCache.find(n) != leaderboardCache.end();
+    }
+    if(!cached && n->getAiAaMatrixIndex() != AA_NOT_SET) {
+        lock_guard<mutex> aaMatrixLock{aaMatrixMutex};
 
         // calculate row/column of AA matrix & build leaderboard
         calculateAaRow(n->getAiAaMatrixIndex());
@@ -487,12 +552,15 @@ bool AiAaBoW::calculateLeaderboardSync(const Note* n, thread* t)
         }
 
         // cache leaderboard (copied)
+        lock_guard<mutex> leaderboardLock{leaderboardMutex};
         leaderboardCache[n] = leaderboard;
     }
 
-    leaderboardWip.erase(n);
+    {
+        lock_guard<mutex> leaderboardLock{leaderboardMutex};
+        leaderboardWip.erase(n);
+    }
     mind.decActiveProcesses();
-    if(t) t->detach(); // indicate that thread finished
     return true;
 }
 
@@ -511,6 +579,12 @@ void AiAaBoW::assertAaSymmetry()
 
 // it's presumed that caller ensures the correct Mind state & synchronization
 bool AiAaBoW::sleep() {
+    lock_guard<mutex> aaMatrixLock{aaMatrixMutex};
+    {
+        // Ns may be deleted while asleep
+        lock_guard<mutex> leaderboardLock{leaderboardMutex};
+        leaderboardCache.clear();
+    }
     lexicon.clear();
     notes.clear();
     outlines.clear();
@@ -522,6 +596,7 @@ bool AiAaBoW::sleep() {
 // it's presumed that caller ensures the correct Mind state & synchronization
 bool AiAaBoW::amnesia() {
     sleep();
+    lock_guard<mutex> aaMatrixLock{aaMatrixMutex};
     aaMatrix.clear();
 
     return true;
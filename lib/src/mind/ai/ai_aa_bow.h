@@ -19,10 +19,14 @@
 #ifndef M8R_AI_ASSOCIATIONS_ASSESSMENT_BOW_H
 #define M8R_AI_ASSOCIATIONS_ASSESSMENT_BOW_H
 
+#include <condition_variable>
 #include <future>
+#include <mutex>
 
 #include "../mind.h"
+#include "../../gear/executor.h"
 #include "ai_aa.h"
+#include "aa_model.h"
 #include "./nlp/markdown_tokenizer.h"
 #include "./nlp/note_char_provider.h"
 #include "./nlp/bag_of_words.h"
@@ -41,7 +45,6 @@ class Mind;
 class AiAaBoW : public AiAssociationsAssessment
 {
 private:
-    static constexpr int THREAD_POOL_SIZE = 2; // IMPROVE thread pool size to be either configured OR #CPU detected and 1/2 or 1/3 used
     static constexpr float AA_NOT_SET = -1.f;
     static constexpr int AA_WORD_RELEVANCY_THRESHOLD = 10; // use 10 words w/ highest weight from vectors (and ignore others - irrelevant can bring noice with volume)
     static constexpr float AA_TITLE_WORD_BONUS = 0.2f;
@@ -49,6 +52,9 @@ private:
 private:
     Mind& mind;
     Memory& memory;
+    AssociationAssessmentModel& aaModel;
+    // model version used to calculate AA matrix rankings
+    unsigned aaModelVersion;
 
     Lexicon lexicon; // IMPROVE merge Standford GloVe word vectors (https://nlp.stanford.edu/projects/glove/)
     CommonWordsBlacklist wordBlacklist;
@@ -72,6 +78,10 @@ private:
     // IMPROVE thing*,float - both O and N to be association
     std::map<const Note*,std::vector<std::pair<Note*,float>>> leaderboardCache;
     std::set<const Note*> leaderboardWip;
+    // leaderboard cache and WIP are shared w/ executor workers
+    std::mutex leaderboardMutex;
+    // AA matrix rows are calculated by one leaderboard task at a time
+    std::mutex aaMatrixMutex;
 
     // associate as you WRITE: word(s) -> O/N
     // IMPROVE std::map<const Note*,std::vector<std::pair<string*,float>>> leaderboardCache;
@@ -82,7 +92,7 @@ private:
     std::vector<std::vector<float>> aaMatrix; // IMPROVE: notesAA and outlinesAA ~ Notes assocications assessment
 
 public:
-    explicit AiAaBoW(Memory& memory, Mind& mind);
+    explicit AiAaBoW(Memory& memory, Mind& mind, AssociationAssessmentModel& aaModel);
     AiAaBoW(const AiAaBoW&) = delete;
     AiAaBoW(const AiAaBoW&&) = delete;
     AiAaBoW &operator=(const AiAaBoW&) = delete;
@@ -121,6 +131,8 @@ public:
         return std::shared_future<bool>(p.get_future());
     }
 
+    virtual bool createAaFeature(const Note* n1, const Note* n2, AssociationAssessmentNotesFeature& feature);
+
     virtual bool sleep();
 
     virtual bool amnesia();
@@ -128,29 +140,29 @@ public:
 private:
 
     /*
-     * Worker threads:
-     *  1. packaged task is assigned to thread
-     *  2. thread performs the task and calls detach() on self when finishes
-     *     to indicate that it's ready to be deleted
-     *  3. if main thread detects that !thread.joinable(), then it can be deleted;
-     *     cleanup is done on any new thread launch AND/OR by this class destructor.
+     * Tasks run on the library-wide executor:
+     *  - leaderboards are INTERACTIVE, dreaming is BACKGROUND
+     *  - leaderboard requests are cancelled when user moves to another N
+     *    (stale tasks finish w/o calculation i.e. future is false)
+     *  - destructor waits for tasks in flight
      */
 
-    // IMPROVE introduce a LIMIT on number of running threads in configuration
-    std::vector<std::thread*> runningWorkers;
-    std::mutex runningWorkersMutex;
+    Executor::CancellationToken leaderboardToken;
+    std::mutex tasksMutex;
+    std::condition_variable tasksFinished;
+    unsigned tasksInFlight;
 
 private:
 
     /**
      * @brief Learn Memory to start thinking.
      */
-    bool learnMemorySync(std::thread* t = nullptr);
+    bool learnMemorySync();
 
     /**
      * @brief Calculate leaderboard and indicate that it has been stored to cache.
      */
-    bool calculateLeaderboardSync(const Note* n, std::thread* t = nullptr);
+    bool calculateLeaderboardSync(const Note* n);
 
     /**
      * @brief Initialize blacklist using common words.
@@ -174,6 +186,16 @@ private:
      */
     void calculateAaRow(size_t y);
 
+    /**
+     * @brief Forget AA rankings calculated by the model if it was retrained.
+     */
+    void checkAaModelVersion();
+
+    /**
+     * @brief Calculate feature of notes[x] and notes[y].
+     */
+    void calculateAaFeature(size_t x, size_t y, AssociationAssessmentNotesFeature& feature);
+
     /**
      * @brief Calculate similarity of two word vectors.
      */
@@ -182,7 +204,7 @@ private:
     /**
      * @brief Calculate similarity of two tag lists.
      */
-    float calculateSimilarityByTags(const std::vector<const Tag*>* t1, const std::vector<const Tag*>* t2);
+    float calculateSimilarityByTags(const TagVector* t1, const TagVector* t2);
 
     /**
      * @brief Calculate similarity of two N/O names.
@@ -200,9 +222,10 @@ private:
     bool getCachedLeaderboard(const Note* n, std::vector<std::pair<Note*,float>>& leaderboard);
 
     /**
-     * @brief Remove finished workers and add new one.
+     * @brief Track task submitted to the executor.
      */
-    void addWorkerAndCleanZombies(std::thread* t);
+    void taskStarted();
+    void taskFinished();
 
 public:
 #ifdef DO_MF_DEBUG
@@ -22,10 +22,12 @@
 #include <future>
 #include <vector>
 #include <map>
+#include <unordered_map>
 
 #include "ai_aa.h"
 #include "../mind.h"
 #include "../../gear/hash_map.h"
+#include "./nlp/bm25_index.h"
 #include "./nlp/common_words_blacklist.h"
 #include "./nlp/markdown_tokenizer.h"
 
@@ -38,22 +40,33 @@ class Memory;
  * @brief Weighted FTS based associations assessment.
  *
  * Description:
- * - This method has own FTS implementation to compute weights and leverage O/N relationships
- *   while searching the best result.
+ * - Ns are indexed by BM25 ranked inverted index w/ weighted N name, N description
+ *   and O name fields to leverage O/N relationships while searching the best result.
+ * - Index is updated incrementally - Os which were modified since the last search are
+ *   re-indexed, index is rebuilt when O/N is deleted (watermark) or removed Ns prevail.
+ * - Top-K (leaderboard) Ns are retrieved using WAND i.e. w/o scoring of all matching Ns.
  * - IMPROVE this class is designed to run SYNCHRONOUSLY - for ASYNC modus operandi Mind/AI/this class
  *   cooperation and synchronization protocols must be architected.
  */
 class AiAaWeightedFts : public AiAssociationsAssessment
 {
-    // in case that FTS for name fails, name is split to words - too many words would take too much time
-    static constexpr int FTS_SEARCH_THRESHOLD_MULTIWORD = 3;
-
 private:
+    struct OutlineStamp {
+        u_int32_t revision;
+        time_t modified;
+        size_t notesCount;
+
+        bool operator==(const OutlineStamp& other) const {
+            return revision==other.revision && modified==other.modified && notesCount==other.notesCount;
+        }
+    };
+
     Mind& mind;
     Memory& memory;
     CommonWordsBlacklist commonWords;
 
-    std::vector<Note*> notes;
+    Bm25Index index;
+    std::unordered_map<const Outline*,OutlineStamp> indexedOutlines;
 
     // IMPROVE in addition to watermark also scope change should be tracked ~ mind.scopeWatermark
     int lastMindDeleteWatermark;
@@ -83,7 +96,8 @@ public:
     virtual std::shared_future<bool> getAssociatedNotes(const std::string& words, std::vector<std::pair<Note*,float>>& associations, const Note* self);
 
     virtual bool sleep() {
-        notes.clear();
+        index.clear();
+        indexedOutlines.clear();
         return true;
     }
 
@@ -91,17 +105,15 @@ public:
         return sleep();
     }
 
+    const Bm25Index& getIndex() const { return index; }
+
 private:
-    void refreshNotes(bool checkWatermark);
-    void tokenizeAndStripString(std::string s, const bool ignoreCase, std::vector<std::string>& words);
+    /**
+     * @brief Index new and modified Os, rebuild index on deletes.
+     */
+    void refreshIndex();
 
     std::shared_future<bool> getAssociatedNotes(const std::string& words, std::vector<std::pair<Note*,float>>& associations, Outline* self);
-
-    // getAssociatedNotes(){assessNs,leaderboard}
-    //   -> assessNsWithFallback(){2lowercase,iterateOs,fallback}
-    //     -> assessNs@O()
-    std::vector<std::pair<Note*,float>>* assessNotesWithFallback(const std::string& regexp, Outline* scope, const Note* self);
-    void assessNotesInOutline(Outline* outline, std::vector<std::pair<Note*,float>>* result, std::vector<std::string>& regexp, const bool ignoreCase);
 };
 
 }
@@ -19,6 +19,7 @@
 #include "autolinking_mind.h"
 
 #include "../../mind.h"
+#include "../../../gear/instrumentation.h"
 
 #ifdef MF_MD_2_HTML_CMARK
 
@@ -51,9 +52,9 @@ void AutolinkingMind::updateTrieIndex()
 {
     // IMPROVE update indices only if an O/N is modified (except writing read timestamps)
 
+    M8R_INSTRUMENTATION_TIMER(timer, "autolinking.index");
 #ifdef DO_MF_DEBUG
     MF_DEBUG("[Autolinking] Rebuilding trie index..." << endl);
-    auto begin = chrono::high_resolution_clock::now();
     int size{};
 #endif
 
@@ -87,10 +88,9 @@ void AutolinkingMind::updateTrieIndex()
     // IMPROVE: add also tags
 
 #ifdef DO_MF_DEBUG
-    auto end = chrono::high_resolution_clock::now();
     MF_DEBUG(
         "[Autolinking] trie w/ " << size << " things updated in: "
-        << chrono::duration_cast<chrono::microseconds>(end-begin).count()/1000000.0 << "ms" << endl);
+        << timer.elapsedMicros()/1000.0 << "ms" << endl);
 #endif
 }
 
@@ -17,6 +17,8 @@
  along with this program. If not, see <http://www.gnu.org/licenses/>.
 */
 #include "cmark_aho_corasick_block_autolinking_preprocessor.h"
+#include "../../../gear/instrumentation.h"
+
 // cmark-gfm headers must NOT be included in header - Win builds fail
 #ifdef MF_MD_2_HTML_CMARK
   #include <cmark-gfm.h>
@@ -287,13 +289,12 @@ void CmarkAhoCorasickBlockAutolinkingPreprocessor::process(
 ) {
 #ifdef MF_MD_2_HTML_CMARK
 
+    M8R_INSTRUMENTATION_TIMER(timer, "autolinking.cmark.aho");
 #ifdef DO_MF_DEBUG
     MF_DEBUG("[Autolinking] begin CMARK" << endl);
     string ds{};
     toString(md, ds);
     MF_DEBUG("[Autolinking] input:" << endl << ">>>" << ds << "<<<" << endl);
-
-    auto begin = chrono::high_resolution_clock::now();
 #endif
 
     insensitive = Configuration::getInstance().isAutolinkingCaseInsensitive();
@@ -359,8 +360,7 @@ void CmarkAhoCorasickBlockAutolinkingPreprocessor::process(
 #ifdef DO_MF_DEBUG
     MF_DEBUG("[Autolinking] output:" << endl << "  >>>" << amd << "<<<" << endl);
 
-    auto end = chrono::high_resolution_clock::now();
-    MF_DEBUG("[Autolinking] MD autolinked in: " << chrono::duration_cast<chrono::microseconds>(end-begin).count()/1000000.0 << "ms" << endl);
+    MF_DEBUG("[Autolinking] MD autolinked in: " << timer.elapsedMicros()/1000.0 << "ms" << endl);
 #endif
 
 #else
@@ -17,6 +17,7 @@
  along with this program. If not, see <http://www.gnu.org/licenses/>.
 */
 #include "cmark_trie_line_autolinking_preprocessor.h"
+#include "../../../gear/instrumentation.h"
 
 /*
  * DEPRECATED
@@ -125,13 +126,12 @@ void CmarkTrieLineAutolinkingPreprocessor::process(
 {
 #ifdef MF_MD_2_HTML_CMARK
 
+    M8R_INSTRUMENTATION_TIMER(timer, "autolinking.cmark.trie");
 #ifdef DO_MF_DEBUG
     MF_DEBUG("[Autolinking] begin CMARK" << endl);
     string ds{};
     toString(md, ds);
     MF_DEBUG("[Autolinking] input:" << endl << ">>>" << ds << "<<<" << endl);
-
-    auto begin = chrono::high_resolution_clock::now();
 #endif
 
     insensitive = Configuration::getInstance().isAutolinkingCaseInsensitive();
@@ -172,8 +172,7 @@ void CmarkTrieLineAutolinkingPreprocessor::process(
 #ifdef DO_MF_DEBUG
     MF_DEBUG("[Autolinking] output:" << endl << ">>>" << amd << "<<<" << endl);
 
-    auto end = chrono::high_resolution_clock::now();
-    MF_DEBUG("[Autolinking] MD autolinked in: " << chrono::duration_cast<chrono::microseconds>(end-begin).count()/1000000.0 << "ms" << endl);
+    MF_DEBUG("[Autolinking] MD autolinked in: " << timer.elapsedMicros()/1000.0 << "ms" << endl);
 #endif
 
 #else
@@ -189,13 +188,12 @@ void CmarkTrieLineAutolinkingPreprocessor::processLineByLine(
 {
 #ifdef MF_MD_2_HTML_CMARK
 
+    M8R_INSTRUMENTATION_TIMER(timer, "autolinking.cmark.trie.aho");
 #ifdef DO_MF_DEBUG
     MF_DEBUG("[Autolinking] begin CMARK-AHO" << endl);
     string ds{};
     toString(md, ds);
     MF_DEBUG("[Autolinking] input:" << endl << ">>" << ds << "<<" << endl);
-
-    auto begin = chrono::high_resolution_clock::now();
 #endif
 
     // TODO rewrite
@@ -245,8 +243,7 @@ void CmarkTrieLineAutolinkingPreprocessor::processLineByLine(
 #ifdef DO_MF_DEBUG
     MF_DEBUG("[Autolinking] output:" << endl << ">>" << amd << "<<" << endl);
 
-    auto end = chrono::high_resolution_clock::now();
-    MF_DEBUG("[Autolinking] MD autolinked in: " << chrono::duration_cast<chrono::microseconds>(end-begin).count()/1000000.0 << "ms" << endl);
+    MF_DEBUG("[Autolinking] MD autolinked in: " << timer.elapsedMicros()/1000.0 << "ms" << endl);
 #endif
 
 #else
@@ -17,6 +17,7 @@
  along with this program. If not, see <http://www.gnu.org/licenses/>.
 */
 #include "naive_autolinking_preprocessor.h"
+#include "../../../gear/instrumentation.h"
 
 #ifndef MF_MD_2_HTML_CMARK
 
@@ -65,13 +66,20 @@ static bool aliasSizeComparator(const Thing* t1, const Thing* t2)
     return t1->getAutolinkingAlias().size() > t2->getAutolinkingAlias().size();
 }
 
+static string thingKey(Thing* t)
+{
+    // things index contains Os and Ns only
+    Outline* o = dynamic_cast<Outline*>(t);
+    return o? o->getKey(): static_cast<Note*>(t)->getKey();
+}
+
 void NaiveAutolinkingPreprocessor::updateThingsIndex()
 {
     // IMPROVE update indices only if an O/N is modified (except writing read timestamps)
 
+    M8R_INSTRUMENTATION_TIMER(timer, "autolinking.naive.index");
 #ifdef DO_MF_DEBUG
     MF_DEBUG("[Autolinking] Updating indices..." << endl);
-    auto begin = chrono::high_resolution_clock::now();
 #endif
 
     things.clear();
@@ -91,8 +99,7 @@ void NaiveAutolinkingPreprocessor::updateThingsIndex()
     for(Thing* t:notes) things.push_back(t);
 
 #ifdef DO_MF_DEBUG
-    auto end = chrono::high_resolution_clock::now();
-    MF_DEBUG("  Indices updated in: " << chrono::duration_cast<chrono::microseconds>(end-begin).count()/1000000.0 << "ms" << endl);
+    MF_DEBUG("  Indices updated in: " << timer.elapsedMicros()/1000.0 << "ms" << endl);
 #endif
 }
 
@@ -190,7 +197,7 @@ void NaiveAutolinkingPreprocessor::process(const vector<string*>& md, string &am
 
                                 MarkdownOutlineRepresentation::toLink(
                                     insensitiveMatch?lowerAlias:t->getAutolinkingAlias(),
-                                    t->getKey(),
+                                    thingKey(t),
                                     nl);
 
                                 *nl += c;
@@ -20,7 +20,12 @@
 
 namespace m8r {
 
-LlamaCppWingman::LlamaCppWingman()
+LlamaCppWingman::LlamaCppWingman(const std::string& url, const std::string& llmModel)
+    : OpenAiWingman(
+          WingmanLlmProviders::WINGMAN_PROVIDER_LLAMACPP,
+          url,
+          "",
+          llmModel)
 {
 }
 
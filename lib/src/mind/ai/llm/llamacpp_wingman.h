@@ -19,6 +19,10 @@
 #ifndef M8R_LLAMACPP_WINGMAN_H
 #define M8R_LLAMACPP_WINGMAN_H
 
+#include <string>
+
+#include "openai_wingman.h"
+
 namespace m8r {
 
 /**
@@ -33,16 +37,19 @@ namespace m8r {
  * - Mistral 7B
  *   - ?.gguf
  *
+ * Wingman talks to the llama.cpp server (llama-server) which provides
+ * OpenAI API compatible chat completions endpoint (incl. streaming)
+ * - no API key is needed and the LLM runs offline.
  */
-class LlamaCppWingman
+class LlamaCppWingman: public OpenAiWingman
 {
 public:
-    explicit LlamaCppWingman();
+    explicit LlamaCppWingman(const std::string& url, const std::string& llmModel);
     LlamaCppWingman(const LlamaCppWingman&) = delete;
     LlamaCppWingman(const LlamaCppWingman&&) = delete;
     LlamaCppWingman& operator =(const LlamaCppWingman&) = delete;
     LlamaCppWingman& operator =(const LlamaCppWingman&&) = delete;
-    ~LlamaCppWingman();
+    ~LlamaCppWingman() override;
 };
 
 }
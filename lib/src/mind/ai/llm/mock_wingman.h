@@ -26,7 +26,7 @@ namespace m8r {
 /**
  * Mock Wingman implementation.
  */
-class MockWingman: Wingman
+class MockWingman: public Wingman
 {
     std::string llmModel;
 
@@ -38,7 +38,7 @@ public:
     MockWingman& operator =(const MockWingman&&) = delete;
     ~MockWingman() override;
 
-    std::string getWingmanLlmModel() const { return llmModel; }
+    virtual std::string getWingmanLlmModel() const override { return llmModel; }
 
     virtual void chat(CommandWingmanChat& command) override;
 };
@@ -18,7 +18,11 @@
 */
 #include "openai_wingman.h"
 
-#include "../../../representations/json/nlohmann/json.hpp"
+#include <algorithm>
+#include <cstring>
+
+#include "../../../representations/json/json_writer.h"
+#include "../../../representations/json/json_sax_parser.h"
 
 #include "../../../gear/string_utils.h"
 
@@ -27,15 +31,217 @@ namespace m8r {
 using namespace std;
 
 /*
- * cURL callback for writing data to string.
+ * OpenAI API chat completion response fields - complete response and streamed
+ * chunks are handled as SAX events (there is no JSon document in memory):
+
+    {
+        "model": "gpt-3.5-turbo-0613",
+        "choices": [
+            {
+                "index": 0,
+                "message": {"role": "assistant", "content": "...LLM answer..."},  (complete response)
+                "delta": {"content": "...LLM answer token..."},                    (streamed chunk)
+                "finish_reason": "stop"
+            }
+        ],
+        "usage": {"prompt_tokens": 26, "completion_tokens": 491, "total_tokens": 517},
+        "error": {"message": "..."}
+    }
+ */
+class OpenAiResponseHandler : public JSonSaxHandler
+{
+public:
+    CommandWingmanChat& command;
+    // streaming listener (nullptr for complete response)
+    WingmanChatListener* listener;
+    string finishReason;
+    int tokens;
+    bool choices;
+    // index of the choice being parsed - only the first choice is the answer
+    size_t choice;
+    bool cancelled;
+
+    explicit OpenAiResponseHandler(CommandWingmanChat& command, WingmanChatListener* listener)
+        : command(command),
+          listener{listener},
+          finishReason{},
+          tokens{0},
+          choices{false},
+          choice{0},
+          cancelled{false}
+    {}
+
+    virtual void onString(const string& path, const string& value) override {
+        if(!path.compare(0, 9, "choices[]")) {
+            choices = true;
+            if(choice) {
+                return;
+            }
+            if(path == "choices[].delta.content") {
+                if(!value.empty()) {
+                    tokens++;
+                    command.answerMarkdown.append(value);
+                    if(listener && !listener->onToken(value)) {
+                        cancelled = true;
+                    }
+                }
+            } else if(path == "choices[].message.content") {
+                command.answerMarkdown.append(value);
+            } else if(path == "choices[].finish_reason") {
+                finishReason = value;
+            }
+        } else if(path == "model") {
+            command.answerLlmModel = value;
+        } else if(path == "error.message") {
+            command.errorMessage = value;
+        }
+    }
+
+    virtual void onNumber(const string& path, const string& value) override {
+        if(!path.compare(0, 9, "choices[]")) {
+            choices = true;
+        } else if(path == "usage.prompt_tokens") {
+            command.promptTokens = atoi(value.c_str());
+        } else if(path == "usage.completion_tokens") {
+            command.answerTokens = atoi(value.c_str());
+        }
+    }
+
+    virtual void onArrayNextItem(const string& path) override {
+        if(path == "choices[]") {
+            choice++;
+        }
+    }
+};
+
+/*
+ * Keep raw HTTP response prefix for error reporting.
+ */
+void openaiKeepResponse(CommandWingmanChat& command, const char* data, size_t size)
+{
+    if(command.httpResponse.size() < OPENAI_RESPONSE_DIAGNOSTICS_SIZE) {
+        command.httpResponse.append(
+            data,
+            std::min(size, OPENAI_RESPONSE_DIAGNOSTICS_SIZE - command.httpResponse.size()));
+    }
+}
+
+/*
+ * Response parsing state shared by cURL/QtNetwork callbacks.
+ */
+struct OpenAiResponseContext {
+    OpenAiResponseHandler handler;
+    JSonSaxParser parser;
+    // incomplete SSE line (cURL chunks are not aligned with lines)
+    string line;
+    bool done;
+
+    explicit OpenAiResponseContext(CommandWingmanChat& command, WingmanChatListener* listener)
+        : handler{command, listener},
+          parser{handler},
+          line{},
+          done{false}
+    {}
+};
+
+/*
+ * Process one server-sent event w/ OpenAI API chat completion chunk:
+ *
+ *   data: {"model":"...","choices":[{"index":0,"delta":{"content":"Hello"},"finish_reason":null}]}
+ *   ...
+ *   data: {"model":"...","choices":[],"usage":{"prompt_tokens":26,"completion_tokens":491}}
+ *   data: [DONE]
+ */
+void openaiStreamEvent(OpenAiResponseContext* ctx, const char* data, size_t size)
+{
+    if(size == 6 && !strncmp(data, "[DONE]", 6)) {
+        ctx->done = true;
+        return;
+    }
+
+    // parser (and its buffers) is reused by all events
+    ctx->parser.reset();
+    ctx->handler.choice = 0;
+    if(!ctx->parser.feed(data, size) || !ctx->parser.finish()) {
+        MF_DEBUG("Error: unable to parse OpenAI JSon stream chunk: '" << string(data, size) << "' " << ctx->parser.getError() << endl);
+    }
+}
+
+/*
+ * Split streamed response data (cURL/QtNetwork chunks are not aligned with lines) to SSE lines.
  */
+void openaiStreamData(OpenAiResponseContext* ctx, const char* data, size_t size)
+{
+    ctx->line.append(data, size);
+    size_t begin = 0;
+    size_t end;
+    while((end = ctx->line.find('\n', begin)) != string::npos) {
+        size_t length = end - begin;
+        if(length && ctx->line[end-1] == '\r') {
+            length--;
+        }
+        if(length > 5 && !ctx->line.compare(begin, 5, "data:")) {
+            size_t dataBegin = begin + 5;
+            if(ctx->line[dataBegin] == ' ') {
+                dataBegin++;
+            }
+            openaiStreamEvent(ctx, ctx->line.data() + dataBegin, begin + length - dataBegin);
+        } else if(length) {
+            // not an event (e.g. JSon error response) - keep it for error reporting
+            openaiKeepResponse(ctx->handler.command, ctx->line.data() + begin, length);
+        }
+        begin = end + 1;
+    }
+    ctx->line.erase(0, begin);
+}
+
+/*
+ * Wingman answer is shown as HTML.
+ */
+void openaiAnswerToHtml(string& answer)
+{
+    // TODO ask GPT for HTML formatted response
+    m8r::replaceAll(
+        "\n",
+        "<br/>",
+        answer);
+}
 
-size_t openaiCurlWriteCallback(void* contents, size_t size, size_t nmemb, std::string* output) {
+#if !defined(__APPLE__) && !defined(_WIN32)
+/*
+ * cURL callback for complete response - JSon is parsed as it arrives.
+ */
+size_t openaiCurlWriteCallback(void* contents, size_t size, size_t nmemb, OpenAiResponseContext* ctx) {
     size_t totalSize = size * nmemb;
-    output->append((char*)contents, totalSize);
+    openaiKeepResponse(ctx->handler.command, (char*)contents, totalSize);
+    ctx->parser.feed((char*)contents, totalSize);
     return totalSize;
 }
 
+/*
+ * cURL callback for streamed response.
+ */
+size_t openaiCurlStreamCallback(void* contents, size_t size, size_t nmemb, OpenAiResponseContext* ctx) {
+    size_t totalSize = size * nmemb;
+    if(ctx->handler.cancelled || ctx->handler.listener->isCancelled()) {
+        // abort the transfer
+        return 0;
+    }
+
+    openaiStreamData(ctx, (char*)contents, totalSize);
+
+    return ctx->handler.cancelled? 0: totalSize;
+}
+
+/*
+ * cURL progress callback - abort the transfer when cancelled (also while waiting for data).
+ */
+int openaiCurlProgressCallback(void* clientp, curl_off_t, curl_off_t, curl_off_t, curl_off_t) {
+    OpenAiResponseContext* ctx = static_cast<OpenAiResponseContext*>(clientp);
+    return ctx->handler.cancelled || ctx->handler.listener->isCancelled()? 1: 0;
+}
+#endif
+
 /*
  * OpenAi Wingman class implementation.
  */
@@ -44,78 +250,105 @@ OpenAiWingman::OpenAiWingman(
     const string& apiKey,
     const std::string& llmModel
 )
-    : Wingman(WingmanLlmProviders::WINGMAN_PROVIDER_OPENAI),
+    : OpenAiWingman(
+          WingmanLlmProviders::WINGMAN_PROVIDER_OPENAI,
+          OPENAI_CHAT_COMPLETIONS_URL,
+          apiKey,
+          llmModel)
+{
+}
+
+OpenAiWingman::OpenAiWingman(
+    WingmanLlmProviders llmProvider,
+    const string& url,
+    const string& apiKey,
+    const string& llmModel
+)
+    : Wingman(llmProvider),
       apiKey{apiKey},
-      llmModel{llmModel}
+      llmModel{llmModel},
+      url{url}
 {
-    MF_DEBUG("OpenAiWingman::OpenAiWingman() apiKey: " << apiKey << endl);
+    MF_DEBUG("OpenAiWingman::OpenAiWingman() url: " << url << " apiKey: " << apiKey << endl);
 }
 
 OpenAiWingman::~OpenAiWingman()
 {
 }
 
+/**
+ * Build OpenAI API chat completions JSon request.
+ */
+string OpenAiWingman::chatRequestJSon(CommandWingmanChat& command, bool stream)
+{
+    /*
+    OpenAI API JSon request example (see unit test):
+
+    {
+        "model": "gpt-3.5-turbo",
+        "messages": [
+            {
+                "role": "system",
+                "content": "You are a helpful assistant."
+            },
+            {
+                "role": "user",
+                "content": "Hey hello! I'm MindForger user - how can you help me?"
+            }
+        ]
+    }
+
+    */
+    string requestJSonStr{};
+    // prompt (possibly w/ whole O as context) is escaped directly to the request
+    requestJSonStr.reserve(command.prompt.size() + llmModel.size() + 192);
+    JSonWriter w{requestJSonStr};
+    w.beginObject();
+    w.key("model").value(llmModel);
+    w.key("messages").beginArray();
+    // system (instruct GPT who it is), user (user prompts), assistant (GPT answers)
+    w.beginObject()
+        .key("role").value("system")
+        // "You are a helpful assistant that returns HTML-formatted answers to the user's prompts."
+        .key("content").value("You are a helpful assistant.")
+        .endObject();
+    // ... more messages like above (with chat history) can be created to provide context
+    w.beginObject()
+        .key("role").value("user")
+        .key("content").value(command.prompt)
+        .endObject();
+    w.endArray();
+    if(stream) {
+        // answer is sent as server-sent events w/ token deltas, last event has usage
+        w.key("stream").value(true);
+        w.key("stream_options").beginObject().key("include_usage").value(true).endObject();
+    }
+    w.endObject();
+
+    MF_DEBUG(
+        "OpenAiWingman::chatRequestJSon() promptJSon:" << endl
+        << ">>>"
+        << requestJSonStr
+        << "<<<"
+        << endl);
+
+    return requestJSonStr;
+}
+
 /**
  * OpenAI cURL GET request.
  *
  * @see https://platform.openai.com/docs/guides/text-generation/chat-completions-api?lang=curl
- * @see https://github.com/nlohmann/json?tab=readme-ov-file
- * @see https://json.nlohmann.me/
  */
 void OpenAiWingman::curlGet(CommandWingmanChat& command) {
 #if !defined(__APPLE__) && !defined(_WIN32)
     CURL* curl = curl_easy_init();
     if (curl) {
 #endif
-        string escapedPrompt{command.prompt};
-        replaceAll("\n", " ", escapedPrompt);
-        replaceAll("\"", "\\\"", escapedPrompt);
-
-        /*
-        OpenAI API JSon request example (see unit test):
-
-        {
-            "messages": [
-                {
-                    "content": "You are a helpful assistant.",
-                    "role": "system"
-                },
-                {
-                    "content": "Hey hello! I'm MindForger user - how can you help me?",
-                    "role": "user"
-                }
-            ],
-            "model": "gpt-3.5-turbo"
-        }
-
-        */
-        nlohmann::json messageSystemJSon{};
-        messageSystemJSon["role"] = "system"; // system (instruct GPT who it is), user (user prompts), assistant (GPT answers)
-        messageSystemJSon["content"] =
-            // "You are a helpful assistant that returns HTML-formatted answers to the user's prompts."
-            "You are a helpful assistant."
-            ;
-        // ... more messages like above (with chat history) can be created to provide context
-        nlohmann::json messageUserJSon{};
-        messageUserJSon["role"] = "user";
-        messageUserJSon["content"] = escapedPrompt;
-
-        nlohmann::json requestJSon;
-        requestJSon["model"] = llmModel;
-        requestJSon["messages"] = nlohmann::json::array(
-            {
-                messageSystemJSon,
-                messageUserJSon,
-            }
-        );
-        string requestJSonStr = requestJSon.dump(4);
-
-        MF_DEBUG(
-            "OpenAiWingman::curlGet() promptJSon:" << endl
-            << ">>>"
-            << requestJSonStr
-            << "<<<"
-            << endl);
+        string requestJSonStr = chatRequestJSon(command, false);
+        command.answerMarkdown.clear();
+        command.errorMessage.clear();
+        OpenAiResponseContext ctx{command, nullptr};
 
 #if defined(_WIN32) || defined(__APPLE__)
         /* Qt Networking examples:
@@ -127,13 +360,15 @@ void OpenAiWingman::curlGet(CommandWingmanChat& command) {
 
         QNetworkAccessManager networkManager;
 
-        QNetworkRequest request(QUrl("https://api.openai.com/v1/chat/completions"));
+        QNetworkRequest request(QUrl(QString::fromStdString(url)));
         request.setHeader(
             QNetworkRequest::ContentTypeHeader,
             "application/json");
-        request.setRawHeader(
-            "Authorization",
-            "Bearer " + QString::fromStdString(apiKey).toUtf8());
+        if(!apiKey.empty()) {
+            request.setRawHeader(
+                "Authorization",
+                "Bearer " + QString::fromStdString(apiKey).toUtf8());
+        }
 
         QNetworkReply* reply = networkManager.post(
             request,
@@ -169,9 +404,10 @@ void OpenAiWingman::curlGet(CommandWingmanChat& command) {
 
         // response: successful response processing
         if(command.status == m8r::WingmanStatusCode::WINGMAN_STATUS_CODE_OK) {
-            QString qCommandResponse = QString{read};
-            command.httpResponse = qCommandResponse.toStdString();
+            command.httpResponse.clear();
+            openaiKeepResponse(command, read.constData(), static_cast<size_t>(read.size()));
             command.errorMessage.clear();
+            ctx.parser.feed(read.constData(), static_cast<size_t>(read.size()));
             command.status = m8r::WingmanStatusCode::WINGMAN_STATUS_CODE_OK;
             MF_DEBUG(
                 "Successful OpenAI Wingman provider response:" << endl <<
@@ -182,7 +418,7 @@ void OpenAiWingman::curlGet(CommandWingmanChat& command) {
         command.httpResponse.clear();
         curl_easy_setopt(
             curl, CURLOPT_URL,
-            "https://api.openai.com/v1/chat/completions");
+            url.c_str());
         curl_easy_setopt(
             curl, CURLOPT_POSTFIELDS,
             requestJSonStr.c_str());
@@ -191,10 +427,13 @@ void OpenAiWingman::curlGet(CommandWingmanChat& command) {
             openaiCurlWriteCallback);
         curl_easy_setopt(
             curl, CURLOPT_WRITEDATA,
-            &command.httpResponse);
+            &ctx);
 
         struct curl_slist* headers = NULL;
-        headers = curl_slist_append(headers, ("Authorization: Bearer " + apiKey).c_str());
+        if(!apiKey.empty()) {
+            // local OpenAI API compatible servers do not require API key
+            headers = curl_slist_append(headers, ("Authorization: Bearer " + apiKey).c_str());
+        }
         headers = curl_slist_append(headers, "Content-Type: application/json");
         curl_easy_setopt(curl, CURLOPT_HTTPHEADER, headers);
 
@@ -228,42 +467,10 @@ void OpenAiWingman::curlGet(CommandWingmanChat& command) {
             return;
         }
 
-        // parse JSon
-        /*
-        OpenAI API JSon response example:
-        {
-            "id": "chatcmpl-8gspbsufrxF42A6JfaiwuxoitQ1fT",
-            "object": "chat.completion",
-            "created": 1705231239,
-            "model": "gpt-3.5-turbo-0613",
-            "choices": [
-                {
-                "index": 0,
-                "message": {
-                    "role": "assistant",
-                    "content": "...LLM answer...",
-                },
-                "logprobs": null,
-                "finish_reason": "stop"
-                }
-            ],
-            "usage": {
-                "prompt_tokens": 26,
-                "completion_tokens": 491,
-                "total_tokens": 517
-            },
-            "system_fingerprint": null
-        }
-        */
-
-        // parse response string to JSon object
-        nlohmann::json httpResponseJSon;
-        try {
-            httpResponseJSon = nlohmann::json::parse(command.httpResponse);
-        } catch (...) {
-            // catch ALL exceptions
+        // JSon response was parsed as it arrived (see OpenAiResponseHandler)
+        if(!ctx.parser.finish()) {
             MF_DEBUG(
-                "Error: unable to parse OpenAI JSon response:" << endl <<
+                "Error: unable to parse OpenAI JSon response (" << ctx.parser.getError() << "):" << endl <<
                 "'" << command.httpResponse << "'" << endl
             );
 
@@ -276,54 +483,21 @@ void OpenAiWingman::curlGet(CommandWingmanChat& command) {
             return;
         }
 
-        MF_DEBUG(
-            "OpenAiWingman::curlGet() parsed response:" << endl
-            << ">>>"
-            << httpResponseJSon.dump(4)
-            << "<<<"
-            << endl);
-
         MF_DEBUG("OpenAiWingman::curlGet() fields:" << endl);
-        if(httpResponseJSon.contains("model")) {
-            httpResponseJSon["model"].get_to(command.answerLlmModel);
-            MF_DEBUG("  model: " << command.answerLlmModel << endl);
-        }
-        if(httpResponseJSon.contains("usage")) {
-            if(httpResponseJSon["usage"].contains("prompt_tokens")) {
-                httpResponseJSon["usage"]["prompt_tokens"].get_to(command.promptTokens);
-                MF_DEBUG("  prompt_tokens: " << command.promptTokens << endl);
-            }
-            if(httpResponseJSon["usage"].contains("completion_tokens")) {
-                httpResponseJSon["usage"]["completion_tokens"].get_to(command.answerTokens);
-                MF_DEBUG("  answer_tokens: " << command.answerTokens << endl);
-            }
-        }
-        if(httpResponseJSon.contains("choices")
-            && httpResponseJSon["choices"].size() > 0
-        ) {
-            // TODO get the last choice rather than the first one
-            auto choice = httpResponseJSon["choices"][0];
-            if(choice.contains("message")
-                && choice["message"].contains("content")
-            ) {
-                choice["message"]["content"].get_to(command.answerMarkdown);
-                // TODO ask GPT for HTML formatted response
-                m8r::replaceAll(
-                    "\n",
-                    "<br/>",
-                    command.answerMarkdown);
-                MF_DEBUG("  answer (HTML): " << command.answerMarkdown << endl);
-            }
-            if(choice.contains("finish_reason")) {
-                string statusStr{};
-                choice["finish_reason"].get_to(statusStr);
-                if(statusStr == "stop") {
+        MF_DEBUG("  model: " << command.answerLlmModel << endl);
+        MF_DEBUG("  prompt_tokens: " << command.promptTokens << endl);
+        MF_DEBUG("  answer_tokens: " << command.answerTokens << endl);
+        if(ctx.handler.choices) {
+            openaiAnswerToHtml(command.answerMarkdown);
+            MF_DEBUG("  answer (HTML): " << command.answerMarkdown << endl);
+            if(!ctx.handler.finishReason.empty()) {
+                if(ctx.handler.finishReason == "stop") {
                     command.status = m8r::WingmanStatusCode::WINGMAN_STATUS_CODE_OK;
                 } else {
                     command.status = m8r::WingmanStatusCode::WINGMAN_STATUS_CODE_ERROR;
                     command.errorMessage.assign(
                         "OpenAI API HTTP required failed with finish_reason: "
-                        + statusStr);
+                        + ctx.handler.finishReason);
                     command.answerMarkdown.clear();
                     command.answerTokens = 0;
                     command.answerLlmModel = llmModel;
@@ -335,12 +509,7 @@ void OpenAiWingman::curlGet(CommandWingmanChat& command) {
             command.answerMarkdown.clear();
             command.answerTokens = 0;
             command.answerLlmModel = llmModel;
-            if(
-                httpResponseJSon.contains("error")
-                && httpResponseJSon["error"].contains("message")
-            ) {
-                httpResponseJSon["error"]["message"].get_to(command.errorMessage);
-            } else {
+            if(command.errorMessage.empty()) {
                 command.errorMessage.assign(
                     "No choices in the OpenAI API HTTP response");
             }
@@ -355,6 +524,155 @@ void OpenAiWingman::curlGet(CommandWingmanChat& command) {
 #endif
 }
 
+void OpenAiWingman::chatStream(CommandWingmanChat& command, WingmanChatListener& listener) {
+    MF_DEBUG("OpenAiWingman::chatStream() prompt:" << endl << command.prompt << endl);
+
+    command.httpResponse.clear();
+    command.answerMarkdown.clear();
+    command.errorMessage.clear();
+    command.answerLlmModel = llmModel;
+    command.promptTokens = 0;
+    command.answerTokens = 0;
+
+    string requestJSonStr = chatRequestJSon(command, true);
+    OpenAiResponseContext ctx{command, &listener};
+    // network error - empty if HTTP response was received
+    string transportError{};
+    long httpStatus = 0;
+
+#if defined(_WIN32) || defined(__APPLE__)
+    QNetworkAccessManager networkManager;
+
+    QNetworkRequest request(QUrl(QString::fromStdString(url)));
+    request.setHeader(
+        QNetworkRequest::ContentTypeHeader,
+        "application/json");
+    request.setRawHeader("Accept", "text/event-stream");
+    if(!apiKey.empty()) {
+        request.setRawHeader(
+            "Authorization",
+            "Bearer " + QString::fromStdString(apiKey).toUtf8());
+    }
+
+    QNetworkReply* reply = networkManager.post(
+        request,
+        QByteArray(requestJSonStr.c_str(), static_cast<int>(requestJSonStr.size()))
+    );
+    QEventLoop loop;
+    // SSE lines are processed as they arrive
+    QObject::connect(reply, &QNetworkReply::readyRead, reply, [reply, &ctx]() {
+        QByteArray read = reply->readAll();
+        openaiStreamData(&ctx, read.constData(), static_cast<size_t>(read.size()));
+        if(ctx.handler.cancelled) {
+            reply->abort();
+        }
+    });
+    // abort the transfer when cancelled (also while waiting for data)
+    QTimer cancelTimer;
+    QObject::connect(&cancelTimer, &QTimer::timeout, reply, [reply, &ctx]() {
+        if(ctx.handler.cancelled || ctx.handler.listener->isCancelled()) {
+            reply->abort();
+        }
+    });
+    cancelTimer.start(100);
+    QObject::connect(reply, &QNetworkReply::finished, &loop, &QEventLoop::quit);
+    loop.exec();
+    cancelTimer.stop();
+
+    httpStatus = reply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt();
+    if(reply->error() != QNetworkReply::NoError && !httpStatus) {
+        transportError = reply->errorString().toStdString();
+    }
+    reply->deleteLater();
+#else
+    CURL* curl = curl_easy_init();
+    if(!curl) {
+        command.status = m8r::WingmanStatusCode::WINGMAN_STATUS_CODE_ERROR;
+        command.errorMessage.assign(
+            "OpenAI API HTTP request failed: unable to initialize cURL");
+        return;
+    }
+
+    curl_easy_setopt(curl, CURLOPT_URL, url.c_str());
+    curl_easy_setopt(curl, CURLOPT_POSTFIELDS, requestJSonStr.c_str());
+    curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, openaiCurlStreamCallback);
+    curl_easy_setopt(curl, CURLOPT_WRITEDATA, &ctx);
+    curl_easy_setopt(curl, CURLOPT_NOPROGRESS, 0L);
+    curl_easy_setopt(curl, CURLOPT_XFERINFOFUNCTION, openaiCurlProgressCallback);
+    curl_easy_setopt(curl, CURLOPT_XFERINFODATA, &ctx);
+    curl_easy_setopt(curl, CURLOPT_NOSIGNAL, 1L);
+
+    struct curl_slist* headers = NULL;
+    if(!apiKey.empty()) {
+        headers = curl_slist_append(headers, ("Authorization: Bearer " + apiKey).c_str());
+    }
+    headers = curl_slist_append(headers, "Content-Type: application/json");
+    headers = curl_slist_append(headers, "Accept: text/event-stream");
+    curl_easy_setopt(curl, CURLOPT_HTTPHEADER, headers);
+
+    CURLcode res = curl_easy_perform(curl);
+    curl_easy_getinfo(curl, CURLINFO_RESPONSE_CODE, &httpStatus);
+
+    curl_easy_cleanup(curl);
+    curl_slist_free_all(headers);
+
+    if(res != CURLE_OK) {
+        transportError = curl_easy_strerror(res);
+    }
+#endif
+
+    // unterminated last line
+    if(!ctx.line.empty() && !ctx.handler.cancelled) {
+        openaiStreamData(&ctx, "\n", 1);
+    }
+
+    command.status = m8r::WingmanStatusCode::WINGMAN_STATUS_CODE_ERROR;
+    if(ctx.handler.cancelled || listener.isCancelled()) {
+        command.errorMessage.assign(WINGMAN_ERROR_CANCELLED);
+    } else if(!transportError.empty()) {
+        command.errorMessage = transportError;
+    } else if(httpStatus >= 400 || ctx.handler.finishReason.empty()) {
+        if(command.errorMessage.empty()) {
+            // JSon error response (if any) sets the error message
+            ctx.parser.reset();
+            ctx.parser.feed(command.httpResponse);
+        }
+        if(command.errorMessage.empty()) {
+            command.errorMessage.assign(
+                "No choices in the OpenAI API HTTP response");
+        }
+    } else if(ctx.handler.finishReason != "stop") {
+        command.errorMessage.assign(
+            "OpenAI API HTTP required failed with finish_reason: "
+            + ctx.handler.finishReason);
+    } else {
+        command.status = m8r::WingmanStatusCode::WINGMAN_STATUS_CODE_OK;
+    }
+
+    if(command.status == WingmanStatusCode::WINGMAN_STATUS_CODE_ERROR) {
+        if(command.errorMessage != WINGMAN_ERROR_CANCELLED) {
+            std::cerr <<
+            "Error: Wingman OpenAI cURL/QtNetwork streaming request failed (error message/HTTP response):" << endl <<
+             "  '" << command.errorMessage << "'" << endl <<
+             "  '" << command.httpResponse << "'" << endl;
+        }
+
+        command.httpResponse.clear();
+        command.answerMarkdown.clear();
+        command.answerTokens = 0;
+        command.answerLlmModel = llmModel;
+        return;
+    }
+
+    if(!command.answerTokens) {
+        // provider w/o usage statistics in the stream
+        command.answerTokens = ctx.handler.tokens;
+    }
+    openaiAnswerToHtml(command.answerMarkdown);
+
+    MF_DEBUG("OpenAiWingman::chatStream() answer:" << endl << command.answerMarkdown << endl);
+}
+
 void OpenAiWingman::chat(CommandWingmanChat& command) {
     MF_DEBUG("OpenAiWingman::chat() prompt:" << endl << command.prompt << endl);
 
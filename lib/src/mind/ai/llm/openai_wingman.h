@@ -32,17 +32,34 @@
 
 namespace m8r {
 
+constexpr const auto OPENAI_CHAT_COMPLETIONS_URL = "https://api.openai.com/v1/chat/completions";
+// raw HTTP response prefix kept for error reporting (response is parsed as it arrives)
+constexpr const size_t OPENAI_RESPONSE_DIAGNOSTICS_SIZE = 4096;
+
 /**
  * OpenAI Wingman implementation.
  */
-class OpenAiWingman: Wingman
+class OpenAiWingman: public Wingman
 {
 private:
     std::string apiKey;
     std::string llmModel;
+    // OpenAI API compatible chat completions endpoint
+    std::string url;
 
+    std::string chatRequestJSon(CommandWingmanChat& command, bool stream);
     void curlGet(CommandWingmanChat& command);
 
+protected:
+    /**
+     * @brief Constructor for OpenAI API compatible providers (llama.cpp server, ...).
+     */
+    explicit OpenAiWingman(
+        WingmanLlmProviders llmProvider,
+        const std::string& url,
+        const std::string& apiKey,
+        const std::string& llmModel);
+
 public:
     explicit OpenAiWingman(const std::string& apiKey, const std::string& llmModel);
     OpenAiWingman(const OpenAiWingman&) = delete;
@@ -51,7 +68,20 @@ public:
     OpenAiWingman& operator =(const OpenAiWingman&&) = delete;
     ~OpenAiWingman() override;
 
+    virtual std::string getWingmanLlmModel() const override { return llmModel; }
+    virtual std::string getWingmanCacheKey() const override {
+        return Wingman::getWingmanCacheKey() + " " + url;
+    }
+    const std::string& getUrl() const { return url; }
+
     virtual void chat(CommandWingmanChat& command) override;
+    /**
+     * @brief Chat using server-sent events (SSE) streaming of the answer.
+     *
+     * Answer tokens are delivered as they are generated by the LLM, the request
+     * is aborted as soon as the listener is cancelled.
+     */
+    virtual void chatStream(CommandWingmanChat& command, WingmanChatListener& listener) override;
 };
 
 }
@@ -31,8 +31,42 @@ Wingman::Wingman(WingmanLlmProviders llmProvider)
     this->llmProvider = llmProvider;
 }
 
+string Wingman::getWingmanCacheKey() const
+{
+    return std::to_string(static_cast<int>(llmProvider)) + " " + getWingmanLlmModel();
+}
+
 Wingman::~Wingman()
 {
 }
 
+void Wingman::chatStream(CommandWingmanChat& command, WingmanChatListener& listener)
+{
+    if(!listener.isCancelled()) {
+        chat(command);
+    }
+
+    if(listener.isCancelled()
+       || (command.status == WingmanStatusCode::WINGMAN_STATUS_CODE_OK
+           && !listener.onToken(command.answerMarkdown)))
+    {
+        command.status = WingmanStatusCode::WINGMAN_STATUS_CODE_ERROR;
+        command.errorMessage.assign(WINGMAN_ERROR_CANCELLED);
+        command.answerMarkdown.clear();
+    }
+}
+
+/*
+ * Wingman chat listener class implementation.
+ */
+
+WingmanChatListener::WingmanChatListener()
+    : cancelled{false}
+{
+}
+
+WingmanChatListener::~WingmanChatListener()
+{
+}
+
 } // m8r namespace
@@ -19,6 +19,7 @@
 #ifndef M8R_WINGMAN_H
 #define M8R_WINGMAN_H
 
+#include <atomic>
 #include <string>
 #include <vector>
 
@@ -64,6 +65,8 @@ constexpr const auto PROMPT_COMPLETE_TEXT = "Complete work-in-progress text: #TE
 // - fix style
 // - create plan ...
 
+constexpr const auto WINGMAN_ERROR_CANCELLED = "Wingman request cancelled";
+
 // Wingman provider service status codes
 enum WingmanStatusCode {
     WINGMAN_STATUS_CODE_OK,
@@ -83,6 +86,37 @@ struct CommandWingmanChat {
     int promptTokens;
     int answerTokens;
     std::string answerMarkdown;
+    // answer served from the Wingman answers cache (no LLM provider request)
+    bool cached;
+};
+
+/**
+ * Wingman streaming chat listener.
+ *
+ * Answer tokens (fragments) are delivered from the worker thread as they
+ * arrive from the LLM provider. The request can be cancelled from any thread
+ * using cancel() - cancelled request finishes with the error status.
+ */
+class WingmanChatListener
+{
+private:
+    std::atomic<bool> cancelled;
+
+public:
+    explicit WingmanChatListener();
+    WingmanChatListener(const WingmanChatListener&) = delete;
+    WingmanChatListener(const WingmanChatListener&&) = delete;
+    WingmanChatListener& operator =(const WingmanChatListener&) = delete;
+    WingmanChatListener& operator =(const WingmanChatListener&&) = delete;
+    virtual ~WingmanChatListener();
+
+    void cancel() { cancelled = true; }
+    bool isCancelled() const { return cancelled; }
+
+    /**
+     * @brief Handle answer token - return false to cancel the request.
+     */
+    virtual bool onToken(const std::string& token) = 0;
 };
 
 
@@ -152,7 +186,24 @@ public:
         return textPrompts;
     }
 
+    /**
+     * @brief Get LLM model used by the Wingman.
+     */
+    virtual std::string getWingmanLlmModel() const = 0;
+    /**
+     * @brief Get provider, endpoint and LLM model which identify Wingman's answers (cache key).
+     */
+    virtual std::string getWingmanCacheKey() const;
+
     virtual void chat(CommandWingmanChat& command) = 0;
+
+    /**
+     * @brief Chat and deliver answer tokens to the listener as they arrive.
+     *
+     * Wingman providers which cannot stream deliver the whole answer
+     * as a single token.
+     */
+    virtual void chatStream(CommandWingmanChat& command, WingmanChatListener& listener);
 };
 
 }
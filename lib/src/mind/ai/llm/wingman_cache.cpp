@@ -0,0 +1,119 @@
+/*
+ wingman_cache.cpp     MindForger thinking notebook
+
+ Copyright (C) 2016-2025 Martin Dvorak <martin.dvorak@mindforger.com>
+
+ This program is free software; you can redistribute it and/or
+ modify it under the terms of the GNU General Public License
+ as published by the Free Software Foundation; either version 2
+ of the License, or (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+#include "wingman_cache.h"
+
+namespace m8r {
+
+using namespace std;
+
+WingmanCache::WingmanCache(size_t capacity)
+    : capacity{capacity?capacity:1},
+      cacheMutex{},
+      lru{},
+      entries{},
+      hits{0},
+      misses{0}
+{
+}
+
+WingmanCache::~WingmanCache()
+{
+}
+
+bool WingmanCache::get(const string& wingmanKey, CommandWingmanChat& command)
+{
+    Key key{wingmanKey, stringHash64(command.prompt)};
+
+    lock_guard<mutex> criticalSection{cacheMutex};
+    auto e = entries.find(key);
+    if(e != entries.end() && e->second.prompt == command.prompt) {
+        hits++;
+        lru.splice(lru.begin(), lru, e->second.lruPosition);
+
+        command.httpResponse.clear();
+        command.status = WingmanStatusCode::WINGMAN_STATUS_CODE_OK;
+        command.errorMessage.clear();
+        command.answerLlmModel = e->second.answerLlmModel;
+        command.promptTokens = e->second.promptTokens;
+        command.answerTokens = e->second.answerTokens;
+        command.answerMarkdown = e->second.answerMarkdown;
+        command.cached = true;
+        return true;
+    }
+
+    misses++;
+    return false;
+}
+
+void WingmanCache::put(const string& wingmanKey, const CommandWingmanChat& command)
+{
+    if(command.status != WingmanStatusCode::WINGMAN_STATUS_CODE_OK || command.cached) {
+        return;
+    }
+
+    Key key{wingmanKey, stringHash64(command.prompt)};
+
+    lock_guard<mutex> criticalSection{cacheMutex};
+    auto e = entries.find(key);
+    if(e != entries.end()) {
+        lru.erase(e->second.lruPosition);
+        entries.erase(e);
+    }
+
+    lru.push_front(key);
+    Entry& entry = entries[key];
+    entry.prompt = command.prompt;
+    entry.answerLlmModel = command.answerLlmModel;
+    entry.promptTokens = command.promptTokens;
+    entry.answerTokens = command.answerTokens;
+    entry.answerMarkdown = command.answerMarkdown;
+    entry.lruPosition = lru.begin();
+
+    while(entries.size() > capacity) {
+        entries.erase(lru.back());
+        lru.pop_back();
+    }
+}
+
+void WingmanCache::clear()
+{
+    lock_guard<mutex> criticalSection{cacheMutex};
+    entries.clear();
+    lru.clear();
+}
+
+size_t WingmanCache::size()
+{
+    lock_guard<mutex> criticalSection{cacheMutex};
+    return entries.size();
+}
+
+unsigned long WingmanCache::getHits()
+{
+    lock_guard<mutex> criticalSection{cacheMutex};
+    return hits;
+}
+
+unsigned long WingmanCache::getMisses()
+{
+    lock_guard<mutex> criticalSection{cacheMutex};
+    return misses;
+}
+
+} // m8r namespace
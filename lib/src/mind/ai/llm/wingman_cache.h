@@ -0,0 +1,96 @@
+/*
+ wingman_cache.h     MindForger thinking notebook
+
+ Copyright (C) 2016-2025 Martin Dvorak <martin.dvorak@mindforger.com>
+
+ This program is free software; you can redistribute it and/or
+ modify it under the terms of the GNU General Public License
+ as published by the Free Software Foundation; either version 2
+ of the License, or (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+#ifndef M8R_WINGMAN_CACHE_H
+#define M8R_WINGMAN_CACHE_H
+
+#include <list>
+#include <map>
+#include <mutex>
+#include <string>
+
+#include "wingman.h"
+#include "../../../gear/string_utils.h"
+
+namespace m8r {
+
+/**
+ * Wingman answers cache.
+ *
+ * LRU cache of successful Wingman answers keyed by Wingman (provider, endpoint
+ * and LLM model - see Wingman::getWingmanCacheKey()) and prompt hash (prompt is
+ * stored and compared on lookup to rule out hash collisions) so that repeated
+ * prompts (re-opened Wingman dialog, the same predefined prompt on the same
+ * Note, ...) do not hit the LLM provider again.
+ *
+ * Cache is thread safe - it's accessed from Wingman worker threads.
+ */
+class WingmanCache
+{
+public:
+    static constexpr size_t DEFAULT_CAPACITY = 256;
+
+private:
+    typedef std::pair<std::string,uint64_t> Key;
+
+    struct Entry {
+        std::string prompt;
+        std::string answerLlmModel;
+        int promptTokens;
+        int answerTokens;
+        std::string answerMarkdown;
+        std::list<Key>::iterator lruPosition;
+    };
+
+    size_t capacity;
+
+    std::mutex cacheMutex;
+    // most recently used key at front
+    std::list<Key> lru;
+    std::map<Key,Entry> entries;
+
+    unsigned long hits;
+    unsigned long misses;
+
+public:
+    explicit WingmanCache(size_t capacity=DEFAULT_CAPACITY);
+    WingmanCache(const WingmanCache&) = delete;
+    WingmanCache(const WingmanCache&&) = delete;
+    WingmanCache& operator =(const WingmanCache&) = delete;
+    WingmanCache& operator =(const WingmanCache&&) = delete;
+    ~WingmanCache();
+
+    /**
+     * @brief Find cached answer for command's prompt and set it to command.
+     *
+     * @return true if the answer was found, false otherwise.
+     */
+    bool get(const std::string& wingmanKey, CommandWingmanChat& command);
+    /**
+     * @brief Cache command's answer - only successful answers are cached.
+     */
+    void put(const std::string& wingmanKey, const CommandWingmanChat& command);
+
+    void clear();
+    size_t size();
+    unsigned long getHits();
+    unsigned long getMisses();
+};
+
+}
+#endif // M8R_WINGMAN_CACHE_H
@@ -0,0 +1,282 @@
+/*
+ bm25_index.cpp     MindForger thinking notebook
+
+ Copyright (C) 2016-2025 Martin Dvorak <martin.dvorak@mindforger.com>
+
+ This program is free software; you can redistribute it and/or
+ modify it under the terms of the GNU General Public License
+ as published by the Free Software Foundation; either version 2
+ of the License, or (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+#include "bm25_index.h"
+
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <limits>
+
+namespace m8r {
+
+using namespace std;
+
+constexpr float Bm25Index::K1;
+constexpr float Bm25Index::B;
+constexpr float Bm25Index::WEIGHT_NAME;
+constexpr float Bm25Index::WEIGHT_DESCRIPTION;
+constexpr float Bm25Index::WEIGHT_OUTLINE_NAME;
+
+Bm25Index::Bm25Index(const CommonWordsBlacklist& commonWords)
+    : commonWords(commonWords),
+      aliveDocuments{0},
+      aliveLength{0}
+{
+}
+
+Bm25Index::~Bm25Index()
+{
+}
+
+void Bm25Index::clear()
+{
+    dictionary.clear();
+    terms.clear();
+    documents.clear();
+    outlineDocuments.clear();
+    aliveDocuments = 0;
+    aliveLength = 0;
+}
+
+void Bm25Index::tokenize(const string& text, vector<string>& tokens) const
+{
+    string w{};
+    for(size_t i=0; i<=text.size(); i++) {
+        const char c = i<text.size()?text[i]:' ';
+        if(isalnum(static_cast<unsigned char>(c)) || static_cast<unsigned char>(c) >= 0x80) {
+            w += static_cast<char>(tolower(static_cast<unsigned char>(c)));
+        } else if(c == '-' && w.size() && i+1<text.size() && isalnum(static_cast<unsigned char>(text[i+1]))) {
+            // words like: self-awareness
+            w += c;
+        } else if(w.size()) {
+            if(w.size()>1 && !commonWords.findWord(w)) {
+                tokens.push_back(w);
+            }
+            w.clear();
+        }
+    }
+}
+
+void Bm25Index::addField(const string& text, float weight, unordered_map<string,float>& frequencies, float& length) const
+{
+    vector<string> tokens{};
+    tokenize(text, tokens);
+    for(const string& t:tokens) {
+        frequencies[t] += weight;
+    }
+    length += weight*tokens.size();
+}
+
+void Bm25Index::addDocument(const Outline* outline, Note* note, const string* outlineName)
+{
+    unordered_map<string,float> frequencies{};
+    float length = 0.f;
+    addField(note->getName(), WEIGHT_NAME, frequencies, length);
+    for(const string* d:note->getDescription()) {
+        if(d) {
+            addField(*d, WEIGHT_DESCRIPTION, frequencies, length);
+        }
+    }
+    if(outlineName) {
+        addField(*outlineName, WEIGHT_OUTLINE_NAME, frequencies, length);
+    }
+    if(frequencies.empty()) {
+        return;
+    }
+
+    uint32_t document = static_cast<uint32_t>(documents.size());
+    documents.push_back(Document{note, length, true});
+    aliveDocuments++;
+    aliveLength += length;
+    outlineDocuments[outline].push_back(document);
+
+    for(auto& f:frequencies) {
+        auto t = dictionary.find(f.first);
+        uint32_t term;
+        if(t == dictionary.end()) {
+            term = static_cast<uint32_t>(terms.size());
+            dictionary[f.first] = term;
+            terms.push_back(Term{{}, 0.f, numeric_limits<float>::max()});
+        } else {
+            term = t->second;
+        }
+        Term& entry = terms[term];
+        // documents are appended ~ postings stay sorted
+        entry.postings.push_back(Posting{document, f.second});
+        entry.maxFrequency = max(entry.maxFrequency, f.second);
+        entry.minLength = min(entry.minLength, length);
+    }
+}
+
+void Bm25Index::addOutline(Outline* outline)
+{
+    // lazy memory must not evict Ns descriptions while they're tokenized
+    OutlineBodiesPin pin{outline};
+
+    // O descriptor N must be registered even if it has no terms
+    outlineDocuments[outline];
+
+    addDocument(outline, outline->getOutlineDescriptorAsNote(), nullptr);
+    for(Note* note:outline->getNotes()) {
+        addDocument(outline, note, &outline->getName());
+    }
+}
+
+void Bm25Index::removeOutline(const Outline* outline)
+{
+    auto o = outlineDocuments.find(outline);
+    if(o != outlineDocuments.end()) {
+        for(uint32_t d:o->second) {
+            if(documents[d].alive) {
+                documents[d].alive = false;
+                aliveDocuments--;
+                aliveLength -= documents[d].length;
+            }
+        }
+        outlineDocuments.erase(o);
+    }
+}
+
+float Bm25Index::idf(const Term& term) const
+{
+    // document frequency includes tombstones until rebuild
+    const float df = static_cast<float>(term.postings.size());
+    return log(1.f + (documents.size() - df + .5f)/(df + .5f));
+}
+
+struct Bm25Index::Cursor {
+    const vector<Posting>* postings;
+    size_t position;
+    float idf;
+    float upperBound;
+
+    uint32_t document() const {
+        return position<postings->size()?(*postings)[position].document:numeric_limits<uint32_t>::max();
+    }
+};
+
+namespace {
+
+bool scoredDocumentComparator(const pair<float,uint32_t>& p1, const pair<float,uint32_t>& p2)
+{
+    // min heap ~ worst document on top, later documents lose ties
+    return p1.first > p2.first || (p1.first == p2.first && p1.second < p2.second);
+}
+
+}
+
+void Bm25Index::search(
+    const string& query,
+    size_t k,
+    vector<pair<Note*,float>>& result,
+    const function<bool(const Note*)>& accept) const
+{
+    result.clear();
+    if(!k || !aliveDocuments) {
+        return;
+    }
+
+    vector<string> tokens{};
+    tokenize(query, tokens);
+    sort(tokens.begin(), tokens.end());
+    tokens.erase(unique(tokens.begin(), tokens.end()), tokens.end());
+
+    const float averageLength = static_cast<float>(aliveLength/aliveDocuments);
+    vector<Cursor> cursors{};
+    for(const string& token:tokens) {
+        auto t = dictionary.find(token);
+        if(t != dictionary.end()) {
+            const Term& term = terms[t->second];
+            Cursor cursor{&term.postings, 0, idf(term), 0.f};
+            cursor.upperBound = cursor.idf*term.maxFrequency*(K1+1.f)
+                /(term.maxFrequency + K1*(1.f-B+B*term.minLength/averageLength));
+            cursors.push_back(cursor);
+        }
+    }
+    if(cursors.empty()) {
+        return;
+    }
+
+    // WAND
+    vector<pair<float,uint32_t>> heap{};
+    const uint32_t end = numeric_limits<uint32_t>::max();
+    while(true) {
+        sort(cursors.begin(), cursors.end(), [](const Cursor& c1, const Cursor& c2) {
+            return c1.document() < c2.document();
+        });
+
+        // pivot ~ the first document which may beat the threshold
+        const float threshold = heap.size()==k?heap.front().first:0.f;
+        float bound = 0.f;
+        size_t pivot = 0;
+        for(; pivot<cursors.size() && cursors[pivot].document()!=end; pivot++) {
+            bound += cursors[pivot].upperBound;
+            if(bound > threshold) {
+                break;
+            }
+        }
+        if(pivot==cursors.size() || cursors[pivot].document()==end) {
+            break;
+        }
+        const uint32_t pivotDocument = cursors[pivot].document();
+
+        if(cursors[0].document() == pivotDocument) {
+            // score pivot document
+            const Document& document = documents[pivotDocument];
+            float score = 0.f;
+            for(Cursor& c:cursors) {
+                if(c.document() != pivotDocument) {
+                    break;
+                }
+                const float f = (*c.postings)[c.position].frequency;
+                score += c.idf*f*(K1+1.f)/(f + K1*(1.f-B+B*document.length/averageLength));
+                c.position++;
+            }
+            if(document.alive
+               && (heap.size()<k || score>threshold)
+               && (!accept || accept(document.note)))
+            {
+                heap.push_back(make_pair(score, pivotDocument));
+                push_heap(heap.begin(), heap.end(), scoredDocumentComparator);
+                if(heap.size() > k) {
+                    pop_heap(heap.begin(), heap.end(), scoredDocumentComparator);
+                    heap.pop_back();
+                }
+            }
+        } else {
+            // documents before pivot cannot beat the threshold ~ skip them
+            for(size_t i=0; i<pivot; i++) {
+                Cursor& c = cursors[i];
+                auto p = lower_bound(
+                    c.postings->begin()+c.position,
+                    c.postings->end(),
+                    pivotDocument,
+                    [](const Posting& posting, uint32_t d) { return posting.document < d; });
+                c.position = p - c.postings->begin();
+            }
+        }
+    }
+
+    sort_heap(heap.begin(), heap.end(), scoredDocumentComparator);
+    for(auto& h:heap) {
+        result.push_back(make_pair(documents[h.second].note, h.first));
+    }
+}
+
+} // m8r namespace
@@ -0,0 +1,141 @@
+/*
+ bm25_index.h     MindForger thinking notebook
+
+ Copyright (C) 2016-2025 Martin Dvorak <martin.dvorak@mindforger.com>
+
+ This program is free software; you can redistribute it and/or
+ modify it under the terms of the GNU General Public License
+ as published by the Free Software Foundation; either version 2
+ of the License, or (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+#ifndef M8R_BM25_INDEX_H
+#define M8R_BM25_INDEX_H
+
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "common_words_blacklist.h"
+#include "../../../model/note.h"
+#include "../../../model/outline.h"
+
+namespace m8r {
+
+/**
+ * @brief BM25 ranked inverted index of Notes.
+ *
+ * Note is indexed as a document w/ weighted fields: N name, N description
+ * and name of N's O (context). Term frequency of a document is the sum
+ * of field weights of term occurrences (BM25F style). Terms are lowercase
+ * alphanumeric tokens (UTF-8 bytes are kept), common words are skipped.
+ *
+ * Top-K documents are retrieved using WAND: every term has an upper bound
+ * of its score contribution, documents which cannot beat the K-th best
+ * score are skipped w/o scoring.
+ *
+ * Index is append-only - removed documents are tombstoned and the index
+ * should be rebuilt once there are too many of them.
+ */
+class Bm25Index
+{
+public:
+    static constexpr float K1 = 1.2f;
+    static constexpr float B = 0.75f;
+
+    static constexpr float WEIGHT_NAME = 3.f;
+    static constexpr float WEIGHT_DESCRIPTION = 1.f;
+    static constexpr float WEIGHT_OUTLINE_NAME = .5f;
+
+private:
+    struct Posting {
+        uint32_t document;
+        float frequency;
+    };
+
+    struct Term {
+        // sorted by document
+        std::vector<Posting> postings;
+        // score upper bound ingredients (valid also after removals)
+        float maxFrequency;
+        float minLength;
+    };
+
+    struct Cursor;
+
+    struct Document {
+        Note* note;
+        float length;
+        bool alive;
+    };
+
+    const CommonWordsBlacklist& commonWords;
+
+    std::unordered_map<std::string,uint32_t> dictionary;
+    std::vector<Term> terms;
+    std::vector<Document> documents;
+    std::unordered_map<const Outline*,std::vector<uint32_t>> outlineDocuments;
+
+    size_t aliveDocuments;
+    double aliveLength;
+
+public:
+    explicit Bm25Index(const CommonWordsBlacklist& commonWords);
+    Bm25Index(const Bm25Index&) = delete;
+    Bm25Index(const Bm25Index&&) = delete;
+    Bm25Index &operator=(const Bm25Index&) = delete;
+    Bm25Index &operator=(const Bm25Index&&) = delete;
+    ~Bm25Index();
+
+    void clear();
+
+    /**
+     * @brief Index O descriptor N and all Ns of the O.
+     */
+    void addOutline(Outline* outline);
+    /**
+     * @brief Tombstone documents of the O.
+     */
+    void removeOutline(const Outline* outline);
+    bool containsOutline(const Outline* outline) const {
+        return outlineDocuments.find(outline) != outlineDocuments.end();
+    }
+
+    size_t size() const { return aliveDocuments; }
+    size_t getRemovedCount() const { return documents.size()-aliveDocuments; }
+    size_t getTermsCount() const { return terms.size(); }
+
+    /**
+     * @brief Find K best matching Ns sorted by score (descending).
+     *
+     * @param accept    filter of Ns (e.g. self or scope) - nullptr to accept all.
+     */
+    void search(
+        const std::string& query,
+        size_t k,
+        std::vector<std::pair<Note*,float>>& result,
+        const std::function<bool(const Note*)>& accept=nullptr) const;
+
+    /**
+     * @brief Split text to lowercase terms (common words are skipped).
+     */
+    void tokenize(const std::string& text, std::vector<std::string>& tokens) const;
+
+private:
+    void addDocument(const Outline* outline, Note* note, const std::string* outlineName);
+    void addField(const std::string& text, float weight, std::unordered_map<std::string,float>& frequencies, float& length) const;
+    float idf(const Term& term) const;
+};
+
+}
+#endif // M8R_BM25_INDEX_H
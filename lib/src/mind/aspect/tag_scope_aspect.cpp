@@ -49,7 +49,7 @@ bool TagsScopeAspect::isInScope(const Note* n) const
     return inScope(n->getTags());
 }
 
-bool TagsScopeAspect::inScope(const std::vector<const Tag*>* thingTags) const
+bool TagsScopeAspect::inScope(const TagVector* thingTags) const
 {
     bool hasAllTags=true;
     for(size_t i=0; i<tags.size(); i++) {
@@ -63,7 +63,7 @@ public:
     void reset() { tags.clear(); }
 
 private:
-    bool inScope(const std::vector<const Tag*>* thingTags) const;
+    bool inScope(const TagVector* thingTags) const;
 };
 
 }
@@ -18,6 +18,10 @@
 */
 #include "filesystem_information.h"
 
+#include <map>
+
+#include "../../gear/executor.h"
+
 using namespace std;
 using namespace m8r::filesystem;
 
@@ -118,7 +122,9 @@ FilesystemInformationSource::FilesystemInformationSource(
     : InformationSource{SourceType::FILESYSTEM, sourcePath},
       mind{mind},
       mdDocumentRepresentation{mdDocumentRepresentation},
-      mfPath{}
+      mfPath{},
+      scanned{false},
+      threads{0}
 {
 }
 
@@ -158,7 +164,42 @@ FilesystemInformationSource::~FilesystemInformationSource()
 FilesystemInformationSource::ErrorCode FilesystemInformationSource::indexToMemory(
     Repository& repository, bool synchronize
 ) {
-    MF_DEBUG("Indexing LIBRARY documents to memory:" << endl);
+    ErrorCode code = scan(repository, synchronize);
+    if(code == ErrorCode::SUCCESS) {
+        code = applyToMemory();
+    }
+    return code;
+}
+
+void FilesystemInformationSource::clearPlan()
+{
+    scanned = false;
+    memoryLibraryPath.clear();
+    manifest.clear();
+    added.clear();
+    modified.clear();
+    renamed.clear();
+    orphans.clear();
+    for(auto p:this->pdfs_paths) {
+        delete p;
+    }
+    pdfs_paths.clear();
+}
+
+string FilesystemInformationSource::toDescriptorKey(const string& relativePath) const
+{
+    string key{memoryLibraryPath};
+    key += FILE_PATH_SEPARATOR;
+    key += relativePath;
+    key += File::EXTENSION_MD_MD;
+    return key;
+}
+
+FilesystemInformationSource::ErrorCode FilesystemInformationSource::scan(
+    Repository& repository, bool synchronize
+) {
+    MF_DEBUG("Scanning LIBRARY documents:" << endl);
+    clearPlan();
 
     if(!isDirectory(locator.c_str())) {
         MF_DEBUG(
@@ -191,101 +232,201 @@ FilesystemInformationSource::ErrorCode FilesystemInformationSource::indexToMemor
         createDirectory(memoryLibIndexPath);
     }
 
-    string memoryInformationSourceIndexPath{memoryLibIndexPath};
-    memoryInformationSourceIndexPath += FILE_PATH_SEPARATOR;
-    memoryInformationSourceIndexPath += normalizeToNcName(this->locator, '_');
-    MF_DEBUG("  Library path in memory: " << memoryInformationSourceIndexPath << endl);
-    if(!synchronize && isDirectory(memoryInformationSourceIndexPath.c_str())) {
+    memoryLibraryPath.assign(memoryLibIndexPath);
+    memoryLibraryPath += FILE_PATH_SEPARATOR;
+    memoryLibraryPath += normalizeToNcName(this->locator, '_');
+    MF_DEBUG("  Library path in memory: " << memoryLibraryPath << endl);
+    if(!synchronize && isDirectory(memoryLibraryPath.c_str())) {
         return ErrorCode::LIBRARY_ALREADY_EXISTS;
+    } else if(!isDirectory(memoryLibraryPath.c_str())) {
+        createDirectory(memoryLibraryPath);
+    }
+
+    // previous scan (empty on the first scan)
+    LibraryManifest previous{};
+    previous.load(memoryLibraryPath+FILE_PATH_SEPARATOR+FILE_MANIFEST_M1ndF0rg3rL1br8ryM8n1f3st);
+    vector<bool> seen(previous.size(), false);
+
+    vector<FileStat> files{};
+    DirectoryWalker walker{threads};
+    walker.walk(locator, files);
+
+    // files are sorted by path > documents are sorted by relative path
+    vector<LibraryDocument> documents{};
+    vector<size_t> unknown{};
+    vector<size_t> fresh{};
+    for(FileStat& file:files) {
+        if(file.path.size() <= locator.size()+1 || !File::fileHasPdfExtension(file.path)) {
+            continue;
+        }
+        pdfs_paths.insert(new string{file.path});
+
+        LibraryDocument document{file.path.substr(locator.size()+1), file.modified, file.size, 0};
+        const LibraryDocument* known = previous.find(document.path);
+        if(known) {
+            seen[known - previous.getDocuments().data()] = true;
+            if(known->hash && known->modified == document.modified && known->size == document.size) {
+                document.hash = known->hash;
+            } else {
+                modified.push_back(documents.size());
+                unknown.push_back(documents.size());
+            }
+        } else {
+            fresh.push_back(documents.size());
+            unknown.push_back(documents.size());
+        }
+        documents.push_back(std::move(document));
+    }
+    MF_DEBUG(
+        "  " << documents.size() << " documents: " << fresh.size() << " new, "
+        << modified.size() << " modified" << endl);
+
+    // hash new and changed documents, check descriptors of new documents
+    vector<char> descriptorExists(documents.size(), 0);
+    auto hash = [this, &documents, &unknown, &descriptorExists](size_t u) {
+        LibraryDocument& document = documents[unknown[u]];
+        document.hash = LibraryManifest::contentHash(
+            locator+FILE_PATH_SEPARATOR+document.path,
+            document.size);
+        descriptorExists[unknown[u]] = isFile(toDescriptorKey(document.path).c_str());
+    };
+    if(unknown.size() >= PARALLEL_THRESHOLD) {
+        Executor::getInstance().parallelFor(unknown.size(), hash, threads);
     } else {
-        createDirectory(memoryInformationSourceIndexPath);
-    }
-
-    indexDirectoryToMemory(locator, memoryPath);
-
-    string outlinePathInMemory{};
-    string relativeDocLibPath{};
-    string outlineDir{};
-    string outlineFilename{};
-    for(auto pdf_path:this->pdfs_paths) {
-        MF_DEBUG("  " << *pdf_path << endl);
-        relativeDocLibPath.assign(pdf_path->substr(locator.size()+1));
-        MF_DEBUG("    " << relativeDocLibPath << endl);
-
-        outlinePathInMemory.assign(memoryInformationSourceIndexPath);
-        outlinePathInMemory += FILE_PATH_SEPARATOR;
-        outlinePathInMemory += relativeDocLibPath;
-        outlinePathInMemory += File::EXTENSION_MD_MD;
-        MF_DEBUG("      " << outlinePathInMemory << endl);
-
-        pathToDirectoryAndFile(outlinePathInMemory, outlineDir, outlineFilename);
-        if(outlineDir.size() && !isDirectory(outlineDir.c_str())) {
-            MF_DEBUG("      creating dir including parent dirs: " << outlinePathInMemory << endl);
-            createDirectories(outlineDir);
+        for(size_t u=0; u<unknown.size(); u++) {
+            hash(u);
         }
+    }
 
-        if(!isFile(outlinePathInMemory.c_str())) {
-            Outline* o=mdDocumentRepresentation.to(*pdf_path, outlinePathInMemory);
-            mind.outlineNew(o);
+    // documents which disappeared are either moved/renamed (same size and hash) or orphans
+    multimap<pair<size_t,uint64_t>,const LibraryDocument*> disappeared{};
+    for(size_t p=0; p<previous.size(); p++) {
+        if(!seen[p]) {
+            const LibraryDocument& document = previous.getDocuments()[p];
+            disappeared.insert(make_pair(make_pair(document.size, document.hash), &document));
+        }
+    }
+    for(size_t f:fresh) {
+        auto d = disappeared.find(make_pair(documents[f].size, documents[f].hash));
+        if(d != disappeared.end() && documents[f].hash) {
+            renamed.push_back(make_pair(d->second->path, f));
+            disappeared.erase(d);
+        } else if(!descriptorExists[f]) {
+            added.push_back(f);
         } else {
-            MF_DEBUG("      SKIPPING creation of O as it already EXISTS");
+            MF_DEBUG("      SKIPPING creation of O as it already EXISTS: " << documents[f].path << endl);
         }
     }
+    for(auto& d:disappeared) {
+        orphans.push_back(d.second->path);
+    }
 
-    string metaPath{
-        memoryInformationSourceIndexPath
-        + FILE_PATH_SEPARATOR
-        + FILE_META_M1ndF0rg3rL1br8ryM3t8
-    };
-    saveMetadata(metaPath, locator);
+    // directories of new descriptor Os
+    set<string> directories{};
+    string directory{}, filename{};
+    for(size_t a:added) {
+        pathToDirectoryAndFile(toDescriptorKey(documents[a].path), directory, filename);
+        directories.insert(directory);
+    }
+    for(auto& r:renamed) {
+        pathToDirectoryAndFile(toDescriptorKey(documents[r.second].path), directory, filename);
+        directories.insert(directory);
+    }
+    for(const string& d:directories) {
+        if(d.size() && !isDirectory(d.c_str())) {
+            MF_DEBUG("      creating dir including parent dirs: " << d << endl);
+            createDirectories(d);
+        }
+    }
+
+    MF_DEBUG(
+        "  Plan: " << added.size() << " to add, " << renamed.size() << " moved, "
+        << orphans.size() << " orphans" << endl);
 
+    // documents are already sorted i.e. indices stay valid
+    manifest.setDocuments(documents);
+    scanned = true;
     return ErrorCode::SUCCESS;
 }
 
-void FilesystemInformationSource::indexDirectoryToMemory(
-    const string& directory,
-    const string& memoryPath
-) {
-    MF_DEBUG(
-        endl <<
-        "INDEXING information source DIR: '" <<
-        directory << "' to memory DIR: '" << memoryPath << "'");
-    DIR* dir;
-    if((dir = opendir(directory.c_str()))) {
-        const struct dirent *entry;
-        if((entry = readdir(dir))) {
-            string path;
-            string* ppath;
-            do {
-                if(entry->d_type == DT_DIR) {
-                    if (strcmp(entry->d_name, ".") == 0 || strcmp(entry->d_name, "..") == 0) {
-                        continue;
-                    }
-                    MF_DEBUG(
-                        endl << "DIVE> " << directory.c_str() << "//" << entry->d_name);
-                    path.assign(directory);
-                    path += FILE_PATH_SEPARATOR;
-                    path += entry->d_name;
+FilesystemInformationSource::ErrorCode FilesystemInformationSource::applyToMemory()
+{
+    if(!scanned) {
+        return ErrorCode::NOT_SCANNED;
+    }
+    MF_DEBUG("Indexing LIBRARY documents to memory:" << endl);
 
-                    indexDirectoryToMemory(path, memoryPath);
-                } else {
-                    MF_DEBUG(
-                        endl << "  FILE: " << directory.c_str() << "//" << entry->d_name);
-                    ppath = new string{directory};
-                    ppath->append(FILE_PATH_SEPARATOR);
-                    ppath->append(entry->d_name);
-
-                    if(File::fileHasPdfExtension(*ppath)) {
-                        pdfs_paths.insert(ppath);
-                    } else {
-                        delete ppath;
-                        ppath = nullptr;
-                    }
-                }
-            } while ((entry = readdir(dir)) != 0);
-            closedir(dir);
+    const vector<LibraryDocument>& documents = manifest.getDocuments();
+
+    // new documents
+    vector<Outline*> outlines{};
+    outlines.reserve(added.size());
+    for(size_t a:added) {
+        const LibraryDocument& document = documents[a];
+        outlines.push_back(
+            mdDocumentRepresentation.to(
+                locator+FILE_PATH_SEPARATOR+document.path,
+                toDescriptorKey(document.path),
+                document.modified));
+    }
+
+    // moved documents - descriptor O is moved as well (it may contain user remarks)
+    vector<Outline*> changed{};
+    string directory{}, filename{};
+    for(auto& r:renamed) {
+        const LibraryDocument& document = documents[r.second];
+        string documentPath{locator+FILE_PATH_SEPARATOR+document.path};
+        string key{toDescriptorKey(document.path)};
+        Outline* o = mind.remind().getOutline(toDescriptorKey(r.first));
+        if(o && mind.outlineMove(o, key)) {
+            pathToDirectoryAndFile(documentPath, directory, filename);
+            o->setName(filename);
+            const vector<string*>& description = o->getDescription();
+            if(description.size()
+               && stringStartsWith(*description[0], MarkdownDocumentRepresentation::DOCUMENT_LINK_PREFIX))
+            {
+                description[0]->assign(MarkdownDocumentRepresentation::toDocumentLink(documentPath));
+            }
+            changed.push_back(o);
+        } else if(!isFile(key.c_str())) {
+            outlines.push_back(mdDocumentRepresentation.to(documentPath, key, document.modified));
+        }
+    }
+
+    // changed documents
+    for(size_t m:modified) {
+        Outline* o = mind.remind().getOutline(toDescriptorKey(documents[m].path));
+        if(o) {
+            o->setModified(documents[m].modified);
+            changed.push_back(o);
+        }
+    }
+
+    // orphans
+    if(orphans.size()) {
+        const Tag* orphanTag = mind.getOntology().findOrCreateTag("orphan");
+        for(const string& orphan:orphans) {
+            Outline* o = mind.remind().getOutline(toDescriptorKey(orphan));
+            if(o && !o->hasTag(orphanTag)) {
+                o->addTag(orphanTag);
+                changed.push_back(o);
+            }
         }
     }
+
+    // indices and caches are updated once for all descriptors
+    mind.outlinesNew(outlines);
+    mind.remember(changed);
+
+    manifest.save(memoryLibraryPath+FILE_PATH_SEPARATOR+FILE_MANIFEST_M1ndF0rg3rL1br8ryM8n1f3st);
+    string metaPath{
+        memoryLibraryPath
+        + FILE_PATH_SEPARATOR
+        + FILE_META_M1ndF0rg3rL1br8ryM3t8
+    };
+    saveMetadata(metaPath, locator);
+
+    return ErrorCode::SUCCESS;
 }
 
 void FilesystemInformationSource::saveMetadata(
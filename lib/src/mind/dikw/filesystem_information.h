@@ -19,8 +19,12 @@
 #ifndef M8R_FILESYSTEM_INFORMATION_H
 #define M8R_FILESYSTEM_INFORMATION_H
 
+#include <utility>
+
 #include "information.h"
+#include "library_manifest.h"
 #include "../../config/configuration.h"
+#include "../../gear/directory_walker.h"
 #include "../../gear/file_utils.h"
 #include "../../gear/string_utils.h"
 #include "../../mind/mind.h"
@@ -36,9 +40,13 @@ public:
         NOT_MINDFORGER_REPOSITORY,
         INVALID_LOCATOR,
         INVALID_MEMORY_PATH,
-        LIBRARY_ALREADY_EXISTS
+        LIBRARY_ALREADY_EXISTS,
+        NOT_SCANNED
     };
 
+    // smaller sets of documents are hashed by the calling thread
+    static constexpr size_t PARALLEL_THRESHOLD = 64;
+
 private:
     // TXT
     std::set<const std::string*> txts;
@@ -66,6 +74,24 @@ private:
 
     std::string mfPath;
 
+    /*
+     * Synchronization plan prepared by scan() and applied by applyToMemory().
+     */
+
+    bool scanned;
+    unsigned threads;
+    // library directory in memory
+    std::string memoryLibraryPath;
+    LibraryManifest manifest;
+    // new documents (manifest indices) which need descriptor O
+    std::vector<size_t> added;
+    // changed documents (manifest indices) w/ existing descriptor O
+    std::vector<size_t> modified;
+    // moved/renamed documents: previous relative path > manifest index
+    std::vector<std::pair<std::string,size_t>> renamed;
+    // relative paths of documents which no longer exist
+    std::vector<std::string> orphans;
+
 public:
     /**
      * @brief Find information sources in given directory.
@@ -115,6 +141,38 @@ public:
      */
     ErrorCode indexToMemory(Repository& repository, bool synchronize = false);
 
+    /**
+     * @brief Scan library documents and prepare synchronization plan.
+     *
+     * Library directory is walked in parallel and the documents are compared
+     * w/ the manifest of the previous scan (paths, sizes, modification times).
+     * Only new and changed documents are hashed (in parallel) - hashes are used
+     * to detect moved/renamed documents. Directories for new descriptor Os are
+     * created.
+     *
+     * Mind is NOT accessed by this method, therefore it can be run by a worker
+     * thread w/o blocking UI.
+     */
+    ErrorCode scan(Repository& repository, bool synchronize = false);
+
+    /**
+     * @brief Apply synchronization plan prepared by scan() to memory.
+     *
+     * Descriptor Os of new documents are created (remembered as one batch), descriptor Os
+     * of moved documents are moved and orphans are tagged. Manifest and library
+     * metadata are saved. Must be called by the thread which owns Mind.
+     */
+    ErrorCode applyToMemory();
+
+    size_t getAddedCount() const { return added.size(); }
+    size_t getModifiedCount() const { return modified.size(); }
+    size_t getRenamedCount() const { return renamed.size(); }
+    size_t getOrphansCount() const { return orphans.size(); }
+    /**
+     * @brief Set number of scanning threads (0 ~ executor workers).
+     */
+    void setThreads(unsigned threads) { this->threads = threads; }
+
     std::set<const std::string*> getPdfs() const { return this->pdfs_paths; }
     std::string getPath() const {return this->locator; }
     void setMfPath(std::string mfPath) { this->mfPath = mfPath; }
@@ -123,8 +181,8 @@ public:
     void saveMetadata(std::string& metaPath, std::string& librarySrcPath);
 
 private:
-    void indexDirectoryToMemory(
-        const std::string& directory, const std::string& memoryPath);
+    std::string toDescriptorKey(const std::string& relativePath) const;
+    void clearPlan();
 };
 
 }
@@ -26,6 +26,8 @@ const std::string InformationSource::DIR_MEMORY_M1ndF0rg3rL1br8ry
     = string{"M1ndF0rg3r-L1br8ry"};
 const std::string InformationSource::FILE_META_M1ndF0rg3rL1br8ryM3t8
     = string{"M1ndF0rg3r-L1br8ry-M3t8"};
+const std::string InformationSource::FILE_MANIFEST_M1ndF0rg3rL1br8ryM8n1f3st
+    = string{"M1ndF0rg3r-L1br8ry-M8n1f3st"};
 
 InformationSource::InformationSource(SourceType type, std::string locator)
     : type{type},
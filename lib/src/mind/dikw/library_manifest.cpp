@@ -0,0 +1,140 @@
+/*
+ library_manifest.cpp     MindForger thinking notebook
+
+ Copyright (C) 2016-2025 Martin Dvorak <martin.dvorak@mindforger.com>
+
+ This program is free software; you can redistribute it and/or
+ modify it under the terms of the GNU General Public License
+ as published by the Free Software Foundation; either version 2
+ of the License, or (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+#include "library_manifest.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+
+#include "../../gear/file_utils.h"
+#include "../../gear/string_utils.h"
+
+using namespace std;
+
+namespace m8r {
+
+const string LibraryManifest::HEADER = string{"# MindForger Library Manifest 1"};
+
+LibraryManifest::LibraryManifest()
+    : documents{}
+{
+}
+
+LibraryManifest::~LibraryManifest()
+{
+}
+
+bool LibraryManifest::load(const string& manifestPath)
+{
+    documents.clear();
+
+    ifstream in{manifestPath};
+    if(!in.is_open()) {
+        return false;
+    }
+    string line{};
+    if(!getline(in, line) || line != HEADER) {
+        MF_DEBUG("Library manifest '" << manifestPath << "' has unknown format" << endl);
+        return false;
+    }
+
+    while(getline(in, line)) {
+        // modified TAB size TAB hash TAB path (path may contain anything but EOL)
+        size_t t1 = line.find('\t');
+        size_t t2 = t1==string::npos? t1: line.find('\t', t1+1);
+        size_t t3 = t2==string::npos? t2: line.find('\t', t2+1);
+        if(t3 == string::npos || t3+1 >= line.size()) {
+            continue;
+        }
+        LibraryDocument document{};
+        document.modified = static_cast<time_t>(strtoll(line.c_str(), nullptr, 10));
+        document.size = static_cast<size_t>(strtoull(line.c_str()+t1+1, nullptr, 10));
+        document.hash = static_cast<uint64_t>(strtoull(line.c_str()+t2+1, nullptr, 16));
+        document.path = line.substr(t3+1);
+        documents.push_back(std::move(document));
+    }
+
+    sort(documents.begin(), documents.end());
+    return true;
+}
+
+bool LibraryManifest::save(const string& manifestPath) const
+{
+    string text{HEADER};
+    text.reserve(documents.size()*100);
+    text += "\n";
+    char buffer[64];
+    for(const LibraryDocument& document:documents) {
+        snprintf(
+            buffer, sizeof(buffer), "%lld\t%llu\t%llx\t",
+            static_cast<long long>(document.modified),
+            static_cast<unsigned long long>(document.size),
+            static_cast<unsigned long long>(document.hash));
+        text += buffer;
+        text += document.path;
+        text += "\n";
+    }
+    return stringToFileAtomic(manifestPath, text);
+}
+
+void LibraryManifest::setDocuments(vector<LibraryDocument>& documents)
+{
+    this->documents.swap(documents);
+    sort(this->documents.begin(), this->documents.end());
+}
+
+const LibraryDocument* LibraryManifest::find(const string& path) const
+{
+    LibraryDocument key{path, 0, 0, 0};
+    auto i = lower_bound(documents.begin(), documents.end(), key);
+    if(i != documents.end() && i->path == path) {
+        return &(*i);
+    }
+    return nullptr;
+}
+
+uint64_t LibraryManifest::contentHash(const string& path, size_t size)
+{
+    ifstream in{path, ios::binary};
+    if(!in.is_open()) {
+        return 0;
+    }
+
+    string sizeString{std::to_string(size)};
+    uint64_t hash = stringHash64(sizeString.c_str(), sizeString.size());
+
+    char buffer[HASH_SAMPLE_SIZE];
+    in.read(buffer, sizeof(buffer));
+    hash = stringHash64(buffer, static_cast<size_t>(in.gcount()), hash);
+    if(size > 2*HASH_SAMPLE_SIZE) {
+        in.clear();
+        in.seekg(static_cast<streamoff>(size-HASH_SAMPLE_SIZE));
+        in.read(buffer, sizeof(buffer));
+        hash = stringHash64(buffer, static_cast<size_t>(in.gcount()), hash);
+    } else if(size > HASH_SAMPLE_SIZE) {
+        // rest of the document
+        in.read(buffer, sizeof(buffer));
+        hash = stringHash64(buffer, static_cast<size_t>(in.gcount()), hash);
+    }
+
+    // 0 is reserved for not calculated hash
+    return hash? hash: 1;
+}
+
+} // m8r namespace
@@ -0,0 +1,98 @@
+/*
+ library_manifest.h     MindForger thinking notebook
+
+ Copyright (C) 2016-2025 Martin Dvorak <martin.dvorak@mindforger.com>
+
+ This program is free software; you can redistribute it and/or
+ modify it under the terms of the GNU General Public License
+ as published by the Free Software Foundation; either version 2
+ of the License, or (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+#ifndef M8R_LIBRARY_MANIFEST_H
+#define M8R_LIBRARY_MANIFEST_H
+
+#include <cstdint>
+#include <ctime>
+#include <string>
+#include <vector>
+
+namespace m8r {
+
+/**
+ * @brief Library document as seen by the last library scan.
+ */
+struct LibraryDocument
+{
+    // path relative to the library source directory
+    std::string path;
+    time_t modified;
+    size_t size;
+    // sampled content hash - 0 if not calculated
+    uint64_t hash;
+
+    bool operator<(const LibraryDocument& other) const { return path < other.path; }
+};
+
+/**
+ * @brief Manifest of library documents found by the last library scan.
+ *
+ * Manifest allows incremental library synchronization: documents whose
+ * size and modification time didn't change are not re-hashed and their
+ * descriptor Os are not touched. Content hashes allow to detect documents
+ * which were moved/renamed since the last scan.
+ *
+ * Manifest is stored in the library directory in memory as text file:
+ *
+ *   # MindForger Library Manifest 1
+ *   modified TAB size TAB hash (hex) TAB relative path
+ */
+class LibraryManifest
+{
+public:
+    static const std::string HEADER;
+    // hash is calculated from size, head and tail of the document
+    static constexpr size_t HASH_SAMPLE_SIZE = 16*1024;
+
+private:
+    // sorted by path
+    std::vector<LibraryDocument> documents;
+
+public:
+    explicit LibraryManifest();
+    LibraryManifest(const LibraryManifest&) = delete;
+    LibraryManifest(const LibraryManifest&&) = delete;
+    LibraryManifest &operator=(const LibraryManifest&) = delete;
+    LibraryManifest &operator=(const LibraryManifest&&) = delete;
+    ~LibraryManifest();
+
+    /**
+     * @brief Load manifest - false if it doesn't exist or it's not valid.
+     */
+    bool load(const std::string& manifestPath);
+    bool save(const std::string& manifestPath) const;
+
+    void clear() { documents.clear(); }
+    size_t size() const { return documents.size(); }
+    const std::vector<LibraryDocument>& getDocuments() const { return documents; }
+    /**
+     * @brief Replace documents - they are sorted by path.
+     */
+    void setDocuments(std::vector<LibraryDocument>& documents);
+    const LibraryDocument* find(const std::string& path) const;
+
+    /**
+     * @brief Calculate sampled content hash of the document (0 if it cannot be read).
+     */
+    static uint64_t contentHash(const std::string& path, size_t size);
+};
+
+}
+#endif // M8R_LIBRARY_MANIFEST_H
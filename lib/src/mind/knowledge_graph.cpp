@@ -118,6 +118,38 @@ KnowledgeGraphNode* KnowledgeGraph::getNode(Note* n)
 }
 
 // TODO this method leaks a lot - knowledge graph nodes
+void KnowledgeGraph::addLinkedNodes(Thing* thing, KnowledgeSubGraph& subgraph)
+{
+    RelationshipGraph& graph = mind->getRelationshipGraph();
+
+    // outgoing links are children, backlinks are parents
+    KnowledgeGraphNode* k;
+    for(bool outgoing:{true, false}) {
+        const vector<RelationshipGraph::Edge>& edges
+            = outgoing? graph.getOutgoing(thing): graph.getIncoming(thing);
+        for(const RelationshipGraph::Edge& e:edges) {
+            if(e.type != RelationshipGraph::EdgeType::LINK) {
+                continue;
+            }
+            // TODO: reuse and delete - map<Thing*,Node*>
+            if(e.thingType == RelationshipGraph::ThingType::OUTLINE) {
+                Outline* o = static_cast<Outline*>(e.thing);
+                k = new KnowledgeGraphNode{KnowledgeGraphNodeType::OUTLINE, o->getName(), outlinesColor, static_cast<unsigned int>(o->getNotesCount())};
+            } else {
+                Note* n = static_cast<Note*>(e.thing);
+                k = new KnowledgeGraphNode{KnowledgeGraphNodeType::NOTE, n->getName(), notesColor};
+                k->setCardinality(n->getOutline()->getDirectNoteChildrenCount(n));
+            }
+            k->setThing(e.thing);
+            if(outgoing) {
+                subgraph.addChild(k);
+            } else {
+                subgraph.addParent(k);
+            }
+        }
+    }
+}
+
 void KnowledgeGraph::getRelatedNodes(KnowledgeGraphNode* centralNode, KnowledgeSubGraph& subgraph)
 {
     subgraph.clear();
@@ -230,13 +262,15 @@ void KnowledgeGraph::getRelatedNodes(KnowledgeGraphNode* centralNode, KnowledgeS
             subgraph.addChild(k);
         }
 
-        const std::vector<const Tag*>* tags = o->getTags();
+        const TagVector* tags = o->getTags();
         for(const Tag* t:*tags) {
             // TODO: reuse and delete - map<Thing*,Node*>
             k = new KnowledgeGraphNode{KnowledgeGraphNodeType::TAG, t->getName(), t->getColor().asLong()};
             subgraph.addChild(k);
         }
 
+        addLinkedNodes(o, subgraph);
+
         subgraph.addParent(outlinesNode);
 
         return;
@@ -260,46 +294,39 @@ void KnowledgeGraph::getRelatedNodes(KnowledgeGraphNode* centralNode, KnowledgeS
             subgraph.addChild(k);
         }
 
-        const std::vector<const Tag*>* tags = n->getTags();
+        const TagVector* tags = n->getTags();
         for(const Tag* t:*tags) {
             // TODO: reuse and delete - map<Thing*,Node*>
             k = new KnowledgeGraphNode{KnowledgeGraphNodeType::TAG, t->getName(), t->getColor().asLong()};
             subgraph.addChild(k);
         }
 
+        addLinkedNodes(n, subgraph);
+
         subgraph.addParent(notesNode);
 
         return;
     } else if(centralNode->getType() == KnowledgeGraphNodeType::TAG) {
         subgraph.setCentralNode(centralNode);
 
-        vector<const Tag*> tags{};
-        tags.push_back(mind->getOntology().findOrCreateTag(centralNode->getName()));
-        // Os
-        vector<Outline*> outlines{};
-        mind->findOutlinesByTags(tags, outlines);
-        if(outlines.size()) {
-            KnowledgeGraphNode* k;
-            for(Outline* o:outlines) {
-                // TODO: reuse and delete - map<Thing*,Node*>
-                k = new KnowledgeGraphNode{KnowledgeGraphNodeType::OUTLINE, o->getName(), outlinesColor, static_cast<unsigned int>(o->getNotesCount())};
-                k->setThing(o);
-                subgraph.addChild(k);
+        const Tag* tag = mind->getOntology().findOrCreateTag(centralNode->getName());
+        // tagged Os and Ns are tag's backward adjacency - no full scan of Os and Ns
+        KnowledgeGraphNode* k;
+        for(const RelationshipGraph::Edge& e:mind->getRelationshipGraph().getIncoming(tag)) {
+            if(e.type != RelationshipGraph::EdgeType::TAG) {
+                continue;
             }
-        }
-
-        // Ns
-        vector<Note*> notes{};
-        mind->findNotesByTags(tags, notes);
-        if(notes.size()) {
-            KnowledgeGraphNode* k;
-            for(Note* n:notes) {
-                // TODO: reuse and delete - map<Thing*,Node*>
+            // TODO: reuse and delete - map<Thing*,Node*>
+            if(e.thingType == RelationshipGraph::ThingType::OUTLINE) {
+                Outline* o = static_cast<Outline*>(e.thing);
+                k = new KnowledgeGraphNode{KnowledgeGraphNodeType::OUTLINE, o->getName(), outlinesColor, static_cast<unsigned int>(o->getNotesCount())};
+            } else {
+                Note* n = static_cast<Note*>(e.thing);
                 k = new KnowledgeGraphNode{KnowledgeGraphNodeType::NOTE, n->getName(), notesColor};
-                k->setThing(n);
                 k->setCardinality(n->getOutline()->getDirectNoteChildrenCount(n));
-                subgraph.addChild(k);
             }
+            k->setThing(e.thing);
+            subgraph.addChild(k);
         }
 
         subgraph.addParent(tagsNode);
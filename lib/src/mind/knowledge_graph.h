@@ -138,6 +138,9 @@ public:
     KnowledgeGraphNode* getNode(Outline* outline);
     KnowledgeGraphNode* getNode(Note* note);
     void getRelatedNodes(KnowledgeGraphNode* centralNode, KnowledgeSubGraph& subgraph);
+
+private:
+    void addLinkedNodes(Thing* thing, KnowledgeSubGraph& subgraph);
 };
 
 }
@@ -0,0 +1,261 @@
+/*
+ lazy_outline_bodies.cpp     MindForger thinking notebook
+
+ Copyright (C) 2016-2025 Martin Dvorak <martin.dvorak@mindforger.com>
+
+ This program is free software; you can redistribute it and/or
+ modify it under the terms of the GNU General Public License
+ as published by the Free Software Foundation; either version 2
+ of the License, or (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+#include "lazy_outline_bodies.h"
+
+namespace m8r {
+
+using namespace std;
+using namespace m8r::filesystem;
+
+LazyOutlineBodies::LazyOutlineBodies(MarkdownOutlineRepresentation& mdRepresentation)
+    : mdRepresentation(mdRepresentation),
+      cap{0},
+      bodiesMutex{},
+      lru{},
+      resident{},
+      residentBytes{0},
+      loads{0},
+      evictions{0}
+{
+}
+
+LazyOutlineBodies::~LazyOutlineBodies()
+{
+}
+
+size_t LazyOutlineBodies::bodiesBytes(const Outline* outline)
+{
+    size_t bytes = 0;
+    for(const Note* n:outline->getNotes()) {
+        for(const string* l:n->description) {
+            bytes += sizeof(string) + l->capacity();
+        }
+    }
+    return bytes;
+}
+
+void LazyOutlineBodies::deleteBodies(Outline* outline)
+{
+    for(Note* n:outline->getNotes()) {
+        for(string* l:n->description) {
+            delete l;
+        }
+        n->description.clear();
+        n->description.shrink_to_fit();
+    }
+}
+
+void LazyOutlineBodies::unload(Outline* outline)
+{
+    lock_guard<mutex> criticalSection{bodiesMutex};
+
+    auto e = resident.find(outline);
+    if(e != resident.end()) {
+        residentBytes -= e->second.bytes;
+        lru.erase(e->second.lruPosition);
+        resident.erase(e);
+    }
+
+    deleteBodies(outline);
+    outline->setBodiesLoader(this);
+    outline->setBodiesResident(false);
+}
+
+void LazyOutlineBodies::load(Outline* outline)
+{
+    lock_guard<mutex> criticalSection{bodiesMutex};
+    if(outline->isBodiesResident()) {
+        // loaded by another thread
+        return;
+    }
+
+    loadLocked(outline);
+}
+
+void LazyOutlineBodies::loadLocked(Outline* outline)
+{
+    Outline* parsed = mdRepresentation.outline(File(outline->getKey()));
+
+    const vector<Note*>& notes = outline->getNotes();
+    const vector<Note*>& parsedNotes = parsed->getNotes();
+    bool sameStructure = notes.size() == parsedNotes.size();
+    for(size_t i=0; sameStructure && i<notes.size(); i++) {
+        sameStructure = notes[i]->getDepth() == parsedNotes[i]->getDepth()
+                        && notes[i]->getName() == parsedNotes[i]->getName();
+    }
+    if(sameStructure) {
+        for(size_t i=0; i<notes.size(); i++) {
+            notes[i]->description.swap(parsedNotes[i]->description);
+        }
+    } else {
+        // file was modified outside of MindForger - match Ns by name
+        cerr << "Error: lazy memory - Notes of '" << outline->getKey()
+             << "' don't match its file - file was modified outside of MindForger" << endl;
+        unordered_multimap<string,Note*> byName{};
+        for(Note* p:parsedNotes) {
+            byName.insert(make_pair(p->getName(), p));
+        }
+        for(Note* n:notes) {
+            auto p = byName.find(n->getName());
+            if(p != byName.end()) {
+                n->description.swap(p->second->description);
+                byName.erase(p);
+            } else {
+                n->description.push_back(new string{""});
+            }
+        }
+    }
+    delete parsed;
+
+    outline->setBodiesResident(true);
+    loads++;
+
+    lru.push_front(outline);
+    Entry& entry = resident[outline];
+    entry.lruPosition = lru.begin();
+    entry.bytes = bodiesBytes(outline);
+    entry.modified = outline->getModified();
+    entry.revision = outline->getRevision();
+    entry.pins = 0;
+    residentBytes += entry.bytes;
+
+    MF_DEBUG("Lazy memory: loaded " << entry.bytes << "B of '" << outline->getKey() << "' > " << residentBytes << "B resident" << endl);
+}
+
+void LazyOutlineBodies::remembered(Outline* outline)
+{
+    if(!isEnabled()) {
+        return;
+    }
+
+    lock_guard<mutex> criticalSection{bodiesMutex};
+    if(!outline->isBodiesResident()) {
+        return;
+    }
+
+    auto e = resident.find(outline);
+    if(e == resident.end()) {
+        // new O
+        lru.push_front(outline);
+        e = resident.insert(make_pair(outline, Entry{lru.begin(), 0, 0, 0, 0})).first;
+        outline->setBodiesLoader(this);
+    } else {
+        residentBytes -= e->second.bytes;
+        lru.splice(lru.begin(), lru, e->second.lruPosition);
+    }
+    e->second.bytes = bodiesBytes(outline);
+    e->second.modified = outline->getModified();
+    e->second.revision = outline->getRevision();
+    residentBytes += e->second.bytes;
+}
+
+void LazyOutlineBodies::keep(Outline* outline)
+{
+    if(outline->getBodiesLoader() == this) {
+        outline->loadBodies();
+        detach(outline);
+        outline->setBodiesLoader(nullptr);
+    }
+}
+
+void LazyOutlineBodies::detach(Outline* outline)
+{
+    lock_guard<mutex> criticalSection{bodiesMutex};
+
+    auto e = resident.find(outline);
+    if(e != resident.end()) {
+        residentBytes -= e->second.bytes;
+        lru.erase(e->second.lruPosition);
+        resident.erase(e);
+    }
+}
+
+void LazyOutlineBodies::pin(Outline* outline)
+{
+    if(outline->getBodiesLoader() != this) {
+        return;
+    }
+
+    lock_guard<mutex> criticalSection{bodiesMutex};
+    if(!outline->isBodiesResident()) {
+        loadLocked(outline);
+    }
+    auto e = resident.find(outline);
+    if(e != resident.end()) {
+        e->second.pins++;
+    }
+}
+
+void LazyOutlineBodies::unpin(Outline* outline)
+{
+    lock_guard<mutex> criticalSection{bodiesMutex};
+    auto e = resident.find(outline);
+    if(e != resident.end() && e->second.pins) {
+        e->second.pins--;
+    }
+}
+
+void LazyOutlineBodies::trim()
+{
+    if(!isEnabled()) {
+        return;
+    }
+
+    lock_guard<mutex> criticalSection{bodiesMutex};
+    auto o = lru.end();
+    while(residentBytes > cap && o != lru.begin()) {
+        --o;
+        if(o == lru.begin()) {
+            // the most recently used O is being read
+            break;
+        }
+        Outline* outline = *o;
+        auto e = resident.find(outline);
+        if(e->second.pins) {
+            // read by a background task
+            continue;
+        }
+        if(outline->getModified() != e->second.modified || outline->getRevision() != e->second.revision) {
+            // changed, but not saved (yet)
+            continue;
+        }
+
+        MF_DEBUG("Lazy memory: evicting " << e->second.bytes << "B of '" << outline->getKey() << "'" << endl);
+        outline->setBodiesResident(false);
+        deleteBodies(outline);
+        residentBytes -= e->second.bytes;
+        resident.erase(e);
+        o = lru.erase(o);
+        evictions++;
+    }
+}
+
+size_t LazyOutlineBodies::getResidentBytes()
+{
+    lock_guard<mutex> criticalSection{bodiesMutex};
+    return residentBytes;
+}
+
+size_t LazyOutlineBodies::getResidentCount()
+{
+    lock_guard<mutex> criticalSection{bodiesMutex};
+    return resident.size();
+}
+
+} // m8r namespace
@@ -0,0 +1,122 @@
+/*
+ lazy_outline_bodies.h     MindForger thinking notebook
+
+ Copyright (C) 2016-2025 Martin Dvorak <martin.dvorak@mindforger.com>
+
+ This program is free software; you can redistribute it and/or
+ modify it under the terms of the GNU General Public License
+ as published by the Free Software Foundation; either version 2
+ of the License, or (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+#ifndef M8R_LAZY_OUTLINE_BODIES_H
+#define M8R_LAZY_OUTLINE_BODIES_H
+
+#include <list>
+#include <mutex>
+#include <unordered_map>
+
+#include "../model/outline.h"
+#include "../representations/markdown/markdown_outline_representation.h"
+
+namespace m8r {
+
+/**
+ * @brief Lazy memory of Notes descriptions (bodies).
+ *
+ * Outlines table, tag cloud and organizers need just O/N names, tags, timestamps
+ * and counts. Lazy memory keeps O header and N skeletons (section headers w/ metadata)
+ * in memory, while Ns descriptions are not learned. Descriptions are loaded by
+ * (re)parsing O's Markdown file on first access and the least recently used Os
+ * are evicted by trim() when the cap is exceeded.
+ *
+ * Readers get Ns descriptions by reference, therefore eviction never happens
+ * on load - trim() is called from a point where no reader may hold descriptions
+ * (main thread between user actions) and readers running in background tasks
+ * must pin the O they read (OutlineBodiesPin). O which was changed and not saved
+ * is never evicted.
+ */
+class LazyOutlineBodies : public OutlineBodiesLoader
+{
+private:
+    struct Entry {
+        std::list<Outline*>::iterator lruPosition;
+        size_t bytes;
+        // O state when bodies were loaded/saved - eviction is safe if it matches
+        time_t modified;
+        u_int32_t revision;
+        // readers which must not lose bodies
+        unsigned pins;
+    };
+
+    MarkdownOutlineRepresentation& mdRepresentation;
+
+    // bytes of Ns descriptions which may be kept in memory, 0 disables lazy memory
+    size_t cap;
+
+    std::mutex bodiesMutex;
+    // resident Os w/ bodies which can be evicted - most recently used first
+    std::list<Outline*> lru;
+    std::unordered_map<Outline*,Entry> resident;
+    size_t residentBytes;
+
+    size_t loads;
+    size_t evictions;
+
+public:
+    explicit LazyOutlineBodies(MarkdownOutlineRepresentation& mdRepresentation);
+    LazyOutlineBodies(const LazyOutlineBodies&) = delete;
+    LazyOutlineBodies(const LazyOutlineBodies&&) = delete;
+    LazyOutlineBodies& operator =(const LazyOutlineBodies&) = delete;
+    LazyOutlineBodies& operator =(const LazyOutlineBodies&&) = delete;
+    virtual ~LazyOutlineBodies();
+
+    /**
+     * @brief Set cap in bytes - 0 disables lazy memory.
+     */
+    void setCap(size_t bytes) { cap = bytes; }
+    size_t getCap() const { return cap; }
+    bool isEnabled() const { return cap > 0; }
+
+    /**
+     * @brief Drop descriptions of just learned O - they will be loaded on demand.
+     */
+    void unload(Outline* outline);
+    /**
+     * @brief O was saved i.e. its file and memory are in sync again.
+     */
+    void remembered(Outline* outline);
+    /**
+     * @brief Load descriptions and keep them in memory for good e.g. O moved to limbo.
+     */
+    void keep(Outline* outline);
+    /**
+     * @brief Evict the least recently used unpinned Os until resident bytes fit the cap.
+     */
+    void trim();
+
+    virtual void load(Outline* outline) override;
+    virtual void detach(Outline* outline) override;
+    virtual void pin(Outline* outline) override;
+    virtual void unpin(Outline* outline) override;
+
+    size_t getResidentBytes();
+    size_t getResidentCount();
+    size_t getLoads() const { return loads; }
+    size_t getEvictions() const { return evictions; }
+
+private:
+    static size_t bodiesBytes(const Outline* outline);
+    static void deleteBodies(Outline* outline);
+    void loadLocked(Outline* outline);
+};
+
+}
+#endif // M8R_LAZY_OUTLINE_BODIES_H
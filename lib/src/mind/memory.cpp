@@ -18,7 +18,10 @@
  */
 #include "memory.h"
 
+#include <sys/stat.h>
+
 #include "../gear/string_utils.h"
+#include "../gear/instrumentation.h"
 
 using namespace std;
 using namespace m8r::filesystem;
@@ -36,9 +39,12 @@ Memory::Memory(
       persistence(new FilesystemPersistence{mdRepresentation, htmlRepresentation}),
       twikiRepresentation{mdRepresentation, persistence},
       csvRepresentation{},
+      outlinesSnapshot{ontology},
+      lazyBodies{mdRepresentation},
       limbo{}
 {
     cache = true;
+    snapshot = true;
     mindScope = nullptr;
 }
 
@@ -60,26 +66,42 @@ void Memory::learn()
 
     repositoryIndexer.index(config.getActiveRepository());
 
+    M8R_INSTRUMENTATION_TIMER(timer, "memory.learn");
 #ifdef DO_MF_DEBUG
     MF_DEBUG(endl << "LEARNING repository in mode " << config.getActiveRepository()->getMode() << ":");
-    auto begin = chrono::high_resolution_clock::now();
 #endif
 
     if(config.getActiveRepository()->getMode() == Repository::RepositoryMode::REPOSITORY) {
+        // lazy memory: learn O headers and N skeletons, N descriptions are loaded on demand
+        lazyBodies.setCap(static_cast<size_t>(config.getLazyMemoryCap())*1024*1024);
+        bool skeletons = lazyBodies.isEnabled();
+
+        // warm start: Outlines of unchanged files are deserialized from snapshot
+        // (snapshot keeps descriptions - it's not used w/ skeletons)
+        const string& snapshotPath = config.getOutlinesSnapshotPath();
+        bool useSnapshot = snapshot && !skeletons && !snapshotPath.empty();
+        if(useSnapshot) {
+            outlinesSnapshot.open(snapshotPath);
+        }
+
         MF_DEBUG(endl << "Markdown files:");
-        for(const string* markdownFile:repositoryIndexer.getMarkdownFiles()) {
-            Outline* outline = mdRepresentation.outline(File(*markdownFile));
-            MF_DEBUG(endl << "  '" << *markdownFile << "' format " << (outline->getFormat()==MarkdownDocument::Format::MINDFORGER?"MF":"MD"));
-
-            // fix O type according to repository type
-            switch(config.getActiveRepository()->getType()) {
-            case Repository::RepositoryType::MINDFORGER:
-                outline->setFormat(MarkdownDocument::Format::MINDFORGER);
-                break;
-            case Repository::RepositoryType::MARKDOWN:
-                outline->setFormat(MarkdownDocument::Format::MARKDOWN);
-                break;
+        // modification time and size captured by indexer ~ no stat() per file
+        for(const FileStat* markdownFile:repositoryIndexer.getMarkdownFiles()) {
+            Outline* outline = useSnapshot
+                ? outlinesSnapshot.get(markdownFile->path, markdownFile->modified, markdownFile->size)
+                : nullptr;
+            if(outline == nullptr) {
+                uint64_t fileHash{0};
+                outline = mdRepresentation.outline(
+                    File(markdownFile->path), markdownFile->modified, skeletons, &fileHash);
+                if(useSnapshot) {
+                    // file was read by parser - its hash is not computed by the snapshot
+                    outlinesSnapshot.setHash(markdownFile->path, fileHash);
+                }
             }
+            MF_DEBUG(endl << "  '" << markdownFile->path << "' format " << (outline->getFormat()==MarkdownDocument::Format::MINDFORGER?"MF":"MD"));
+
+            fixOutlineFormat(outline);
 
             if(outline->isVirgin()) {
                 MF_DEBUG(endl << "    VIRGIN ~ most probably wrongly parsed > SKIPPING it");
@@ -90,10 +112,26 @@ void Memory::learn()
             }
         }
 
+        if(useSnapshot) {
+            MF_DEBUG(endl << "Outlines snapshot: " << outlinesSnapshot.getHits() << " hits, " << outlinesSnapshot.getMisses() << " misses");
+            M8R_INSTRUMENTATION_COUNT("memory.learn.snapshot.hits", outlinesSnapshot.getHits());
+            M8R_INSTRUMENTATION_COUNT("memory.learn.snapshot.misses", outlinesSnapshot.getMisses());
+            if(outlinesSnapshot.isStale()) {
+                outlinesSnapshot.write(snapshotPath, outlines);
+            }
+            outlinesSnapshot.close();
+        }
+
+        if(skeletons) {
+            for(Outline* o:outlines) {
+                lazyBodies.unload(o);
+            }
+        }
+
 #ifdef MF_WIP
         MF_DEBUG(endl << "PDF files:");
-        for(const string* pdfFile:repositoryIndexer.getPdfFiles()) {
-            MF_DEBUG(endl << "  '" << *pdfFile << "'");
+        for(const FileStat* pdfFile:repositoryIndexer.getPdfFiles()) {
+            MF_DEBUG(endl << "  '" << pdfFile->path << "'");
 
             /*
             string INFO_DESCRIPTOR_EXT{".M1ndF0rg3r.md"};
@@ -109,22 +147,22 @@ void Memory::learn()
         }
 
         MF_DEBUG(endl << "TXT files:");
-        for(const string* textFile:repositoryIndexer.getTextFiles()) {
-            MF_DEBUG(endl << "  '" << *textFile << "'");
+        for(const FileStat* textFile:repositoryIndexer.getTextFiles()) {
+            MF_DEBUG(endl << "  '" << textFile->path << "'");
         }
 #endif
 
         MF_DEBUG(endl << "Outline stencils:");
-        for(const string* file:repositoryIndexer.getOutlineStencilsFileNames()) {
-            Stencil* stencil = new Stencil{*file, ResourceType::OUTLINE};
+        for(const FileStat& file:repositoryIndexer.getOutlineStencilsFileNames()) {
+            Stencil* stencil = new Stencil{file.path, ResourceType::OUTLINE};
             persistence->load(stencil);
             outlineStencils.push_back(stencil);
             MF_DEBUG(endl << "  " << stencil->getFilePath());
         }
 
         MF_DEBUG(endl << "Note stencils:");
-        for(const string* file:repositoryIndexer.getNoteStencilsFileNames()) {
-            Stencil* stencil = new Stencil{*file, ResourceType::NOTE};
+        for(const FileStat& file:repositoryIndexer.getNoteStencilsFileNames()) {
+            Stencil* stencil = new Stencil{file.path, ResourceType::NOTE};
             persistence->load(stencil);
             noteStencils.push_back(stencil);
             MF_DEBUG(endl << "  " << stencil->getFilePath());
@@ -135,9 +173,9 @@ void Memory::learn()
     } else {
         MF_DEBUG(endl << "Single markdown file: " << repositoryIndexer.getMarkdownFiles().size());
         if(repositoryIndexer.getMarkdownFiles().size() == 1) {
-            const string* markdownFile = *repositoryIndexer.getMarkdownFiles().begin();
-            Outline* outline = mdRepresentation.outline(File(*markdownFile));
-            MF_DEBUG(endl << "  '" << *markdownFile << "' format " << (outline->getFormat()==MarkdownDocument::Format::MINDFORGER?"MF":"MD"));
+            const FileStat* markdownFile = repositoryIndexer.getMarkdownFiles().front();
+            Outline* outline = mdRepresentation.outline(File(markdownFile->path), markdownFile->modified);
+            MF_DEBUG(endl << "  '" << markdownFile->path << "' format " << (outline->getFormat()==MarkdownDocument::Format::MINDFORGER?"MF":"MD"));
 
             // MD file format determines repository type
             repositoryIndexer.getRepository()->setMode(Repository::RepositoryMode::FILE);
@@ -160,11 +198,114 @@ void Memory::learn()
     }
 
 #ifdef DO_MF_DEBUG
-    auto end = chrono::high_resolution_clock::now();
-    MF_DEBUG("LEARNED in " << chrono::duration_cast<chrono::microseconds>(end-begin).count()/1000.0 << "ms" << endl);
+    MF_DEBUG("LEARNED in " << timer.elapsedMicros()/1000.0 << "ms" << endl);
 #endif
 }
 
+void Memory::fixOutlineFormat(Outline* outline)
+{
+    // fix O type according to repository type
+    switch(config.getActiveRepository()->getType()) {
+    case Repository::RepositoryType::MINDFORGER:
+        outline->setFormat(MarkdownDocument::Format::MINDFORGER);
+        break;
+    case Repository::RepositoryType::MARKDOWN:
+        outline->setFormat(MarkdownDocument::Format::MARKDOWN);
+        break;
+    }
+}
+
+Outline* Memory::learnOutline(const string& filePath)
+{
+    if(!isFile(filePath.c_str())) {
+        return nullptr;
+    }
+
+    Outline* outline = mdRepresentation.outline(
+        File(filePath), fileModificationTime(&filePath), lazyBodies.isEnabled());
+    fixOutlineFormat(outline);
+    Outline* replaced = getOutline(outline->getKey());
+
+    if(outline->isVirgin()) {
+        MF_DEBUG("Memory: VIRGIN O " << filePath << " > SKIPPING it" << endl);
+        delete outline;
+        if(replaced) {
+            unlearnOutlines(filePath);
+        }
+        return nullptr;
+    }
+
+    if(replaced) {
+        // replaced O might be still referenced e.g. by UI or AA
+        std::replace(outlines.begin(), outlines.end(), replaced, outline);
+        outlinesMap[outline->getKey()] = outline;
+        retiredOutlines.push_back(replaced);
+    } else {
+        outlines.push_back(outline);
+        outlinesMap.insert(map<string,Outline*>::value_type(outline->getKey(), outline));
+    }
+    // index new file or update modification time and size of changed file
+    repositoryIndexer.addFile(outline->getKey());
+    if(lazyBodies.isEnabled()) {
+        lazyBodies.unload(outline);
+    }
+
+    MF_DEBUG("Memory: learned O " << filePath << (replaced?" (replaced)":"") << endl);
+    return outline;
+}
+
+vector<Outline*> Memory::unlearnOutlines(const string& path)
+{
+    vector<Outline*> unlearned{};
+    string prefix{path + FILE_PATH_SEPARATOR};
+    for(auto o = outlinesMap.begin(); o != outlinesMap.end(); ) {
+        if(o->first == path || o->first.compare(0, prefix.size(), prefix) == 0) {
+            unlearned.push_back(o->second);
+            o = outlinesMap.erase(o);
+        } else {
+            ++o;
+        }
+    }
+    for(Outline* o:unlearned) {
+        outlines.erase(std::remove(outlines.begin(), outlines.end(), o), outlines.end());
+        retiredOutlines.push_back(o);
+    }
+    repositoryIndexer.removeFiles(path);
+
+    MF_DEBUG("Memory: unlearned " << unlearned.size() << " O(s) " << path << endl);
+    return unlearned;
+}
+
+void Memory::deleteRetiredOutlines()
+{
+    MF_DEBUG("Memory: deleting " << retiredOutlines.size() << " retired O(s)" << endl);
+    for(Outline*& outline:retiredOutlines) {
+        delete outline;
+    }
+    retiredOutlines.clear();
+}
+
+bool Memory::isRemembered(const string& filePath) const
+{
+    auto r = rememberedFiles.find(filePath);
+    if(r == rememberedFiles.end()) {
+        return false;
+    }
+
+    struct stat fileStat;
+    return stat(filePath.c_str(), &fileStat) == 0
+           && fileStat.st_mtime == r->second.first
+           && static_cast<size_t>(fileStat.st_size) == r->second.second;
+}
+
+void Memory::rememberFileStamp(const string& filePath)
+{
+    struct stat fileStat;
+    if(stat(filePath.c_str(), &fileStat) == 0) {
+        rememberedFiles[filePath] = make_pair(fileStat.st_mtime, static_cast<size_t>(fileStat.st_size));
+    }
+}
+
 void Memory::amnesia()
 {
     aware = false;
@@ -185,6 +326,9 @@ void Memory::amnesia()
     }
     limboOutlines.clear();
 
+    deleteRetiredOutlines();
+    rememberedFiles.clear();
+
     for(Stencil*& stencil:outlineStencils) {
         delete stencil;
     }
@@ -236,6 +380,8 @@ void Memory::remember(const std::string& outlineKey)
         o->makeModified();
         o->checkAndFixProperties();
         persistence->save(o);
+        rememberFileStamp(o->getKey());
+        lazyBodies.remembered(o);
     } else {
         throw MindForgerException{
             "Save: unable to find outline w/ given key (" + outlineKey + ") to save"
@@ -253,11 +399,13 @@ void Memory::remember(Outline* outline)
 
     outline->checkAndFixProperties();
     persistence->save(outline);
+    rememberFileStamp(outline->getKey());
 
     if(!getOutline(outline->getKey())) {
         outlines.push_back(outline);
         outlinesMap.insert(map<string,Outline*>::value_type(outline->getKey(), outline));
     }
+    lazyBodies.remembered(outline);
 }
 
 void Memory::exportToHtml(Outline* outline, const string& fileName)
@@ -265,13 +413,28 @@ void Memory::exportToHtml(Outline* outline, const string& fileName)
     persistence->saveAsHtml(outline, fileName);
 }
 
-void Memory::exportToCsv(
+bool Memory::exportToCsv(
         const string& fileName,
         map<const Tag*,int>& tagsCardinality,
         int oheTagEncodingCardinality,
         ProgressCallbackCtx* callbackCtx)
 {
-    csvRepresentation.to(
+    return csvRepresentation.to(
+        outlines,
+        tagsCardinality,
+        fileName,
+        oheTagEncodingCardinality,
+        callbackCtx
+    );
+}
+
+bool Memory::exportToColumnar(
+        const string& fileName,
+        map<const Tag*,int>& tagsCardinality,
+        int oheTagEncodingCardinality,
+        ProgressCallbackCtx* callbackCtx)
+{
+    return csvRepresentation.toColumnar(
         outlines,
         tagsCardinality,
         fileName,
@@ -282,11 +445,27 @@ void Memory::exportToCsv(
 
 void Memory::forget(Outline* outline)
 {
+    // O's file is moved to limbo > Ns descriptions cannot be loaded later
+    lazyBodies.keep(outline);
+
     outlinesMap.erase(outline->getKey());
     limboOutlines.push_back(outline);
     outlines.erase(std::remove(outlines.begin(), outlines.end(), outline), outlines.end());
 }
 
+bool Memory::move(Outline* outline, const string& outlineKey)
+{
+    if(getOutline(outlineKey) || !moveFile(outline->getKey(), outlineKey)) {
+        return false;
+    }
+
+    outlinesMap.erase(outline->getKey());
+    outline->setKey(outlineKey);
+    outlinesMap.insert(map<string,Outline*>::value_type(outline->getKey(), outline));
+    rememberFileStamp(outlineKey);
+    return true;
+}
+
 Memory::~Memory()
 {
     for(Outline*& outline:outlines) {
@@ -295,6 +474,9 @@ Memory::~Memory()
     for(Outline*& outline:limboOutlines) {
         delete outline;
     }
+    for(Outline*& outline:retiredOutlines) {
+        delete outline;
+    }
     for(Stencil*& stencil:outlineStencils) {
         delete stencil;
     }
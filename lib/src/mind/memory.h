@@ -21,6 +21,7 @@
 
 #include <vector>
 #include <map>
+#include <unordered_map>
 
 #include "../debug.h"
 #include "../exceptions.h"
@@ -40,7 +41,9 @@
 #include "../model/resource_types.h"
 #include "../persistence/persistence.h"
 #include "../persistence/filesystem_persistence.h"
+#include "../persistence/outlines_snapshot.h"
 #include "aspect/mind_scope_aspect.h"
+#include "lazy_outline_bodies.h"
 #include "limbo.h"
 
 namespace m8r {
@@ -62,6 +65,14 @@ private:
      */
     bool cache;
 
+    /**
+     * @brief Use snapshot of parsed Outlines on learn().
+     *
+     * If TRUE, then Outlines of files which were not changed since the last
+     * learn() are deserialized from the snapshot instead of being parsed.
+     */
+    bool snapshot;
+
     RepositoryIndexer repositoryIndexer;
     Configuration& config;
     Ontology& ontology;
@@ -69,6 +80,8 @@ private:
     Persistence* persistence;
     TWikiOutlineRepresentation twikiRepresentation;
     CsvOutlineRepresentation csvRepresentation;
+    OutlinesSnapshot outlinesSnapshot;
+    LazyOutlineBodies lazyBodies;
     MindScopeAspect* mindScope;
     Limbo limbo;
 
@@ -78,6 +91,10 @@ private:
     std::vector<Stencil*> noteStencils;
 
     std::vector<Outline*> limboOutlines;
+    // Os replaced/removed on external change of files - might be still referenced
+    std::vector<Outline*> retiredOutlines;
+    // modification time and size of files written by remember() ~ own changes
+    std::unordered_map<std::string,std::pair<time_t,size_t>> rememberedFiles;
 
     // IMPROVE unordered_map
     std::map<std::string,Outline*> outlinesMap;
@@ -104,6 +121,9 @@ public:
      */
     void learn();
     bool isAware() { return aware; }
+    void setSnapshot(bool snapshot) { this->snapshot = snapshot; }
+    const OutlinesSnapshot& getOutlinesSnapshot() const { return outlinesSnapshot; }
+    LazyOutlineBodies& getLazyBodies() { return lazyBodies; }
 
     /**
      * @brief Forget everything.
@@ -121,6 +141,33 @@ public:
      * @brief Learn Outlines map (tree).
      */
     Outline* learnOutlinesMap(const std::string& fileNamePath);
+    Outline* learnOutlinesMap(MarkdownDocument& md) { return mdRepresentation.outline(md); }
+
+    /**
+     * @brief Learn (new or changed) Outline from file.
+     *
+     * Previously learned Outline w/ the same key is replaced and retired - it's
+     * not deallocated until deleteRetiredOutlines() as it might be referenced.
+     *
+     * @return learned Outline or nullptr if file is not a valid Outline.
+     */
+    Outline* learnOutline(const std::string& filePath);
+
+    /**
+     * @brief Unlearn (retire) Outline of removed file or Outlines of removed directory.
+     */
+    std::vector<Outline*> unlearnOutlines(const std::string& path);
+
+    /**
+     * @brief Delete replaced/unlearned Outlines - caller ensures they are not referenced.
+     */
+    void deleteRetiredOutlines();
+    size_t getRetiredOutlinesCount() const { return retiredOutlines.size(); }
+
+    /**
+     * @brief Was file written by remember() and not changed since then?
+     */
+    bool isRemembered(const std::string& filePath) const;
 
     /**
      * @brief Convert TWiki file to MD file (O not instantiated).
@@ -155,7 +202,17 @@ public:
     /**
      * @brief Export memory to CSV.
      */
-    void exportToCsv(
+    bool exportToCsv(
+        const std::string& fileName,
+        std::map<const Tag*,int>& tagsCardinality,
+        int oheTagEncodingCardinality,
+        ProgressCallbackCtx* callbackCtx = nullptr
+    );
+
+    /**
+     * @brief Export memory to columnar binary format (for ML).
+     */
+    bool exportToColumnar(
         const std::string& fileName,
         std::map<const Tag*,int>& tagsCardinality,
         int oheTagEncodingCardinality,
@@ -167,6 +224,13 @@ public:
      */
     void forget(Outline* outline);
 
+    /**
+     * @brief Move Outline's file to the new key (path) and re-key Outline in memory.
+     *
+     * @return false if there already is an Outline w/ given key or file cannot be moved.
+     */
+    bool move(Outline* outline, const std::string& outlineKey);
+
     /**
      * @brief Get Ontology.
      * @return Ontology
@@ -224,6 +288,8 @@ public:
 
 private:
     const OutlineType* toOutlineType(const MarkdownAstSectionMetadata&);
+    void fixOutlineFormat(Outline* outline);
+    void rememberFileStamp(const std::string& filePath);
 
 };
 
@@ -18,6 +18,9 @@
  */
 #include "mind.h"
 
+#include "../gear/executor.h"
+#include "../gear/instrumentation.h"
+
 #ifdef MF_MD_2_HTML_CMARK
   #include "ai/autolinking/autolinking_mind.h"
   #include "ai/autolinking/cmark_aho_corasick_block_autolinking_preprocessor.h"
@@ -38,7 +41,7 @@ Mind::Mind(Configuration &configuration)
       autoInterceptor(new NaiveAutolinkingPreprocessor{*this}),
 #endif
       htmlRepresentation{ontology, autoInterceptor},
-      mdConfigRepresentation(new MarkdownConfigurationRepresentation{}),
+      configStore(new ConfigurationStore{new MarkdownConfigurationRepresentation{}}),
       memory{configuration, ontology, htmlRepresentation},
 #ifdef MF_MD_2_HTML_CMARK
       autolinking{new AutolinkingMind{*this}},
@@ -51,10 +54,15 @@ Mind::Mind(Configuration &configuration)
       tagsScopeAspect{ontology},
       scopeAspect{timeScopeAspect, tagsScopeAspect}
 {
+    // size executor shared by Mind background tasks before anybody uses it
+    Executor::configure(static_cast<unsigned>(config.getWorkerThreads()));
+
     ai = new Ai{memory, *this};
 
     // TODO BEGIN: code before Wingman config persisted
-    config.setWingmanLlmProvider(WingmanLlmProviders::WINGMAN_PROVIDER_OPENAI);
+    if(config.getWingmanLlmProvider() == WingmanLlmProviders::WINGMAN_PROVIDER_NONE) {
+        config.setWingmanLlmProvider(WingmanLlmProviders::WINGMAN_PROVIDER_OPENAI);
+    }
     // TODO END: code before Wingman config persisted
     initWingman();
 
@@ -79,13 +87,18 @@ Mind::Mind(Configuration &configuration)
 Mind::~Mind()
 {
     delete ai;
-    if(wingman) delete wingman;
+    // streaming chats use Wingman cache
+    joinWingmanStreams(true);
     delete knowledgeGraph;
-    delete mdConfigRepresentation;
+    delete configStore;
     delete autoInterceptor;
     delete autolinking;
     delete stats;
 
+    if(outlinesMapLoading.valid()) {
+        // worker thread must not outlive Mind
+        delete outlinesMapLoading.get();
+    }
     if(this->outlinesMap) {
         delete this->outlinesMap;
     }
@@ -107,6 +120,7 @@ bool Mind::learn()
         MF_DEBUG("Learning..." << endl);
         mindAmnesia();
         memory.learn();
+        tagCounters.build(memory.getOutlines());
 #ifdef MF_MD_2_HTML_CMARK
         autolinking->reindex();
 #endif
@@ -189,6 +203,19 @@ bool Mind::sleep()
     }
 }
 
+void Mind::confirmAssociation(
+    const Note* note,
+    const Note* association,
+    const vector<pair<Note*,float>>& leaderboard)
+{
+    lock_guard<mutex> criticalSection{exclusiveMind};
+
+    if(config.getMindState()==Configuration::MindState::THINKING) {
+        MF_DEBUG("Association confirmed: '" << association->getName() << "'" << endl);
+        ai->confirmAssociation(note, association, leaderboard);
+    }
+}
+
 /*
  *  This method does NOT need mutex because it's private and it's called from Mind only
  */
@@ -264,6 +291,9 @@ bool Mind::mindAmnesia()
         mindSleep();
 
         // forget EVERYTHING
+        repositoryWatcher.stop();
+        relationshipGraph.clear();
+        tagCounters.clear();
         memory.amnesia();
 #ifdef MF_MD_2_HTML_CMARK
         autolinking->clear();
@@ -300,10 +330,26 @@ bool Mind::autolinkFindLongestPrefixWord(std::string& s, std::string& r) const
  * Remembering
  */
 
+void Mind::indexOutline(Outline* outline)
+{
+    relationshipGraph.update(outline);
+    tagCounters.update(outline);
+}
+
+void Mind::unindexOutline(Outline* outline)
+{
+    relationshipGraph.remove(outline);
+    tagCounters.remove(outline);
+}
+
 
 void Mind::remember(const std::string& outlineKey)
 {
     memory.remember(outlineKey);
+    Outline* outline = memory.getOutline(outlineKey);
+    if(outline) {
+        indexOutline(outline);
+    }
 
     // TODO onRemembering()
 
@@ -317,6 +363,7 @@ void Mind::remember(const std::string& outlineKey)
 void Mind::remember(Outline* outline)
 {
     memory.remember(outline);
+    indexOutline(outline);
 
 #ifdef MF_MD_2_HTML_CMARK
     if(config.isAutolinking()) {
@@ -325,8 +372,23 @@ void Mind::remember(Outline* outline)
 #endif
 }
 
+void Mind::remember(const vector<Outline*>& outlines)
+{
+    for(Outline* outline:outlines) {
+        memory.remember(outline);
+        indexOutline(outline);
+    }
+
+#ifdef MF_MD_2_HTML_CMARK
+    if(outlines.size() && config.isAutolinking()) {
+        autolinking->reindex();
+    }
+#endif
+}
+
 void Mind::forget(Outline* outline)
 {
+    unindexOutline(outline);
     memory.forget(outline);
 
     // TODO onRemembering()
@@ -385,22 +447,18 @@ void Mind::findNoteFts(
         const FtsSearch searchMode,
         Outline* outline)
 {
-    // IMPROVE make this faster - do NOT convert to lower case, but compare it in that method > will do less
+    M8R_INSTRUMENTATION_TIMER(timer, "mind.search.fts");
+
     // IMPROVE avoid duplicate code - introduce an pre-processing iface (lower/nop) and used one code
     if(searchMode == FtsSearch::IGNORE_CASE) {
-        string s{};
-        stringToLower(outline->getName(), s);
-        if(s.find(pattern)!=string::npos) {
+        // pattern is lowercase, text is matched in place (no lowercase copies)
+        if(stringFindIgnoreCase(outline->getName(), pattern)!=string::npos) {
             result->push_back(outline->getOutlineDescriptorAsNote());
         } else {
             for(string* d:outline->getDescription()) {
-                if(d) {
-                    s.clear();
-                    stringToLower(*d, s);
-                    if(s.find(pattern)!=string::npos) {
-                        result->push_back(outline->getOutlineDescriptorAsNote());
-                        break;
-                    }
+                if(d && stringFindIgnoreCase(*d, pattern)!=string::npos) {
+                    result->push_back(outline->getOutlineDescriptorAsNote());
+                    break;
                 }
             }
         }
@@ -408,19 +466,13 @@ void Mind::findNoteFts(
             if(scopeAspect.isOutOfScope(note)) {
                 continue;
             }
-            s.clear();
-            stringToLower(note->getName(), s);
-            if(s.find(pattern)!=string::npos) {
+            if(stringFindIgnoreCase(note->getName(), pattern)!=string::npos) {
                 result->push_back(note);
             } else {
                 for(string* d:note->getDescription()) {
-                    if(d) {
-                        s.clear();
-                        stringToLower(*d, s);
-                        if(s.find(pattern)!=string::npos) {
-                            result->push_back(note);
-                            break;
-                        }
+                    if(d && stringFindIgnoreCase(*d, pattern)!=string::npos) {
+                        result->push_back(note);
+                        break;
                     }
                 }
             }
@@ -516,42 +568,67 @@ vector<Note*>* Mind::findNoteFts(const string& pattern, FtsSearch searchMode, Ou
     return result;
 }
 
-vector<Note*>* Mind::getReferencedNotes(const Note& note) const
+RelationshipGraph& Mind::getRelationshipGraph()
 {
-    UNUSED_ARG(note);
+    if(!relationshipGraph.isBuilt()) {
+        M8R_INSTRUMENTATION_TIMER(timer, "mind.relationships.build");
+        relationshipGraph.build(memory.getOutlines());
+    }
+    return relationshipGraph;
+}
 
-    return nullptr;
+/**
+ * @brief Get Ns linked from/to the note, optionally only those from given O.
+ */
+static vector<Note*>* getLinkedNotes(
+    RelationshipGraph& graph, const Note& note, const Outline* outline, bool outgoing)
+{
+    vector<Thing*> linked{};
+    graph.getNeighbours(
+        &note,
+        RelationshipGraph::EdgeType::LINK,
+        RelationshipGraph::ThingType::NOTE,
+        outgoing,
+        linked);
+
+    vector<Note*>* result = new vector<Note*>{};
+    for(Thing* t:linked) {
+        Note* n = static_cast<Note*>(t);
+        if(!outline || n->getOutline() == outline) {
+            result->push_back(n);
+        }
+    }
+    return result;
 }
 
-vector<Note*>* Mind::getReferencedNotes(const Note& note, const Outline& outline) const
+vector<Note*>* Mind::getReferencedNotes(const Note& note)
 {
-    UNUSED_ARG(note);
-    UNUSED_ARG(outline);
-
-    return nullptr;
+    return getLinkedNotes(getRelationshipGraph(), note, nullptr, true);
 }
 
-vector<Note*>* Mind::getRefereeNotes(const Note& note) const
+vector<Note*>* Mind::getReferencedNotes(const Note& note, const Outline& outline)
 {
-    UNUSED_ARG(note);
-
-    return nullptr;
+    return getLinkedNotes(getRelationshipGraph(), note, &outline, true);
 }
 
-vector<Note*>* Mind::getRefereeNotes(const Note& note, const Outline& outline) const
+vector<Note*>* Mind::getRefereeNotes(const Note& note)
 {
-    UNUSED_ARG(note);
-    UNUSED_ARG(outline);
+    return getLinkedNotes(getRelationshipGraph(), note, nullptr, false);
+}
 
-    return nullptr;
+vector<Note*>* Mind::getRefereeNotes(const Note& note, const Outline& outline)
+{
+    return getLinkedNotes(getRelationshipGraph(), note, &outline, false);
 }
 
 void Mind::findNotesByTags(const vector<const Tag*>& tags, vector<Note*>& result) const
 {
+    M8R_INSTRUMENTATION_TIMER(timer, "mind.search.tags.notes");
+
     vector<Note*> allNotes{};
     memory.getAllNotes(allNotes);
     for(Note* n:allNotes) {
-        const vector<const Tag*>* thingTags = n->getTags();
+        const TagVector* thingTags = n->getTags();
         bool hasAllTags=true;
         for(size_t i=0; i<tags.size(); i++) {
             if(std::find(
@@ -706,6 +783,8 @@ vector<Note*>* Mind::getNotesOfType(const NoteType& type, const Outline& outline
 
 void Mind::findOutlinesByTags(const std::vector<const Tag*>& tags, std::vector<Outline*>& result) const
 {
+    M8R_INSTRUMENTATION_TIMER(timer, "mind.search.tags.outlines");
+
     for(Outline* o:memory.getOutlines()) {
         bool allMatched = true;
         for(size_t i=0; i<tags.size(); i++) {
@@ -737,48 +816,38 @@ Taxonomy<Tag>& Mind::getTags()
 void Mind::getTagsCardinality(map<const Tag*,int>& tagsCardinality)
 {
     if(ontology.getTags().size()) {
-        for(const Tag* t:ontology.getTags().values()) {
-            // IMPROVE make NONE exclusion faster (checks in three loops below)
-            if(!stringistring(string("none"), t->getName())) {
+        if(scopeAspect.isEnabled()) {
+            // scoped view must be filtered - Os and Ns walk
+            for(const Tag* t:ontology.getTags().values()) {
                 tagsCardinality[t] = 0;
             }
-        }
-        const vector<Outline*>& outlines = memory.getOutlines();
-        bool doO, doN;
-        for(Outline* o:outlines) {
-            doO = false;
-            if(scopeAspect.isEnabled()) {
+            for(Outline* o:memory.getOutlines()) {
                 if(scopeAspect.isInScope(o)) {
-                    doO = true;
-                }
-            } else {
-                doO = true;
-            }
-            if(doO) {
-                for(const Tag* ot:*o->getTags()) {
-                    if(!stringistring(string("none"), ot->getName())) {
-                        tagsCardinality[ot] = tagsCardinality[ot]+1;
+                    for(const Tag* ot:*o->getTags()) {
+                        tagsCardinality[ot]++;
                     }
-                }
-
-                doN = false;
-                for(Note* n:o->getNotes()) {
-                    if(scopeAspect.isEnabled()) {
+                    for(Note* n:o->getNotes()) {
                         if(scopeAspect.isInScope(n)) {
-                            doN = true;
-                        }
-                    } else {
-                        doN = true;
-                    }
-                    if(doN) {
-                        for(const Tag* nt:*n->getTags()) {
-                            if(!stringistring(string("none"), nt->getName())) {
-                                tagsCardinality[nt] = tagsCardinality[nt]+1;
+                            for(const Tag* nt:*n->getTags()) {
+                                tagsCardinality[nt]++;
                             }
                         }
                     }
                 }
             }
+        } else {
+            for(const Tag* t:ontology.getTags().values()) {
+                tagsCardinality[t] = static_cast<int>(tagCounters.getCount(t));
+            }
+        }
+
+        // none tag is not shown in tag cloud, stats, ...
+        for(auto t = tagsCardinality.begin(); t != tagsCardinality.end(); ) {
+            if(stringistring(string("none"), t->first->getName())) {
+                t = tagsCardinality.erase(t);
+            } else {
+                ++t;
+            }
         }
     } else {
         tagsCardinality.clear();
@@ -794,23 +863,17 @@ vector<Tag*>* Mind::getNoteTags(const Outline& outline) const
 
 unsigned Mind::getTagCardinality(const Tag& tag) const
 {
-    UNUSED_ARG(tag);
-
-    return 0;
+    return tagCounters.getCount(&tag);
 }
 
 unsigned Mind::getOutlineTagCardinality(const Tag& tag) const
 {
-    UNUSED_ARG(tag);
-
-    return 0;
+    return tagCounters.getOutlinesCount(&tag);
 }
 
 unsigned Mind::getNoteTagCardinality(const Tag& tag) const
 {
-    UNUSED_ARG(tag);
-
-    return 0;
+    return tagCounters.getNotesCount(&tag);
 }
 
 void Mind::removeTagFromOutlines(const Tag* tag, vector<Outline*>& modifiedOutlines)
@@ -834,11 +897,13 @@ bool Mind::setOutlineUniqueTag(const Tag* tag, const string& outlineKey)
         for(Outline* mo:modifiedOutlines) {
             // persist Os w/ removed T (timestamp not changed)
             memory.remember(mo->getKey());
+            indexOutline(mo);
         }
 
         // mark O as modified
         o->addTag(tag);
         memory.remember(o->getKey());
+        indexOutline(o);
         return true;
     } else {
         return false;
@@ -901,6 +966,14 @@ string Mind::outlineNew(
     return outline?outline->getKey():nullptr;
 }
 
+void Mind::outlinesNew(const vector<Outline*>& outlines)
+{
+    if(outlines.size()) {
+        remember(outlines);
+        onRemembering();
+    }
+}
+
 string Mind::outlineNew(Outline* outline)
 {
     if(outline) {
@@ -949,6 +1022,7 @@ Outline* Mind::outlineClone(const std::string& outlineKey)
         Outline* clonedOutline = new Outline{*o};
         clonedOutline->setKey(memory.createOutlineKey(&o->getName()));
         memory.remember(clonedOutline);
+        indexOutline(clonedOutline);
         onRemembering();
         return clonedOutline;
     } else {
@@ -956,6 +1030,16 @@ Outline* Mind::outlineClone(const std::string& outlineKey)
     }
 }
 
+bool Mind::outlineMove(Outline* outline, const string& outlineKey)
+{
+    if(outline && memory.move(outline, outlineKey)) {
+        indexOutline(outline);
+        onRemembering();
+        return true;
+    }
+    return false;
+}
+
 bool Mind::outlineForget(string outlineKey)
 {
     Outline* o = memory.getOutline(outlineKey);
@@ -1000,7 +1084,9 @@ Outline* Mind::outlinesMapNew(string outlineKey)
         memory.getOntology().getDefaultOutlineType()};
 
     for(Outline* o:getOutlines()) {
-        Note* n = o->getOutlineDescriptorAsNote();
+        // clone O's descriptor as map Ns are owned (deleted) by the map
+        Note* n = new Note(*o->getOutlineDescriptorAsNote());
+        n->clearLinks();
         newOutlinesMap->addNote(n);
 
         n->addLink(
@@ -1026,95 +1112,122 @@ Outline* Mind::outlinesMapNew(string outlineKey)
     return newOutlinesMap;
 }
 
-void Mind::outlinesMapSynchronize(Outline* outlinesMap)
+void Mind::outlinesMapSynchronize(Outline* outlinesMap, Outline::Patch* patch)
 {
-    vector<Note*> osToRemove{};
-
     // ensure that map contains only valid Os
     //   - remove from map: map O NOT in runtime O
     //   - add at the top of map: runtime Os NOT in mapOs
-    MF_DEBUG("Map O links validity check:");
-    vector<string> mapOsKeys{};
-    for(Note* n:outlinesMap->getNotes()) {
+    // Map Ns and Os are matched using hashed keys and the map is rebuilt
+    // in one pass i.e. synchronization is O(n).
+    unordered_map<string,Outline*> mindOs{};
+    mindOs.reserve(getOutlines().size());
+    for(Outline* o:getOutlines()) {
+        mindOs[o->getKey()] = o;
+    }
+
+    const vector<Note*>& mapNs = outlinesMap->getNotes();
+    vector<Note*> validNs{};
+    validNs.reserve(mapNs.size());
+    unordered_set<string> mapOsKeys{};
+    mapOsKeys.reserve(mapNs.size());
+    // depths of removed Ns whose subtrees are being lifted
+    vector<u_int16_t> removedDepths{};
+    size_t removedCount{};
+    bool changed{};
+    size_t changedFrom{}, changedTo{};
+
+    MF_DEBUG("Map O links validity check:" << endl);
+    for(Note* n:mapNs) {
+        const u_int16_t depth = n->getDepth();
+        while(removedDepths.size() && removedDepths.back() >= depth) {
+            removedDepths.pop_back();
+        }
+
+        Outline* o{};
         Link* oLink = n->getLinkByName(LINK_NAME_OUTLINE_KEY);
         if(oLink) {
-            string oKey{oLink->getUrl()};
-            Outline* o = findOutlineByKey(oKey);
-            if(o) {
-                // valid O in MF & map
-                #ifdef MF_DEBUG_LIBRARY
-                MF_DEBUG(
-                    "  VALID  : " << n->getName() << endl <<
-                    "           " << oKey << endl
-                );
-                #endif
-                // refresh N representing O (name, timestamps, ... may be changed by other views)
+            auto mindO = mindOs.find(oLink->getUrl());
+            if(mindO != mindOs.end()) {
+                o = mindO->second;
+            }
+        }
+
+        if(o && mapOsKeys.insert(o->getKey()).second) {
+            // valid O in MF & map: refresh N representing O (name, timestamps, ... may be changed by other views)
+            if(n->getName() != o->getName()
+               || n->getModified() != o->getModified()
+               || n->getRead() != o->getRead()
+               || removedDepths.size())
+            {
                 n->setName(o->getName());
                 n->setModified(o->getModified());
-                n->setModifiedPretty();
                 n->setRead(o->getRead());
-                n->setReadPretty();
-                mapOsKeys.push_back(oKey);
-            } else {
-                MF_DEBUG("  INVALID (no O for link): " << n->getName() << endl);
-                osToRemove.push_back(n);
+                // children of removed N are moved up
+                n->setDepth(static_cast<u_int16_t>(depth - removedDepths.size()));
+                if(!changed) {
+                    changedFrom = validNs.size();
+                    changed = true;
+                }
+                changedTo = validNs.size();
             }
+            validNs.push_back(n);
         } else {
-            MF_DEBUG("  INVALID (missing link): " << n->getName() << endl);
-            osToRemove.push_back(n);
+            MF_DEBUG("  INVALID (" << (oLink?"no O for link":"missing link") << "): " << n->getName() << endl);
+            removedDepths.push_back(depth);
+            removedCount++;
+            delete n;
         }
     }
     MF_DEBUG("DONE O links validity check" << endl);
 
-    if(osToRemove.size()) {
-        MF_DEBUG("Removing Ns with INVALID O key:" << endl);
-        for(auto oToRemove:osToRemove) {
-            MF_DEBUG("  " << oToRemove->getName() << endl);
-            delete oToRemove;
-            outlinesMap->removeNote(oToRemove);
-        }
-        osToRemove.clear();
-    }
-
     // find mind keys which are NOT in map > prepend them to map
-    vector<Outline*> osToAdd{};
-    MF_DEBUG("Finding mind keys to be ADDED to map:" << endl);
-    for(auto mindO: getOutlines()) {
-        if(find(mapOsKeys.begin(), mapOsKeys.end(), mindO->getKey()) == mapOsKeys.end()) {
-            MF_DEBUG("  " << mindO->getKey() << endl);
-
+    vector<Note*> newNs{};
+    MF_DEBUG("ADDING mind keys to map:" << endl);
+    const vector<Outline*>& mindOsList = getOutlines();
+    for(auto it = mindOsList.rbegin(); it != mindOsList.rend(); ++it) {
+        Outline* o = *it;
+        if(mapOsKeys.find(o->getKey()) == mapOsKeys.end()) {
             // TODO skip keys w/ "," ~ https://github.com/dvorka/mindforger/issues/1518 workaround
             // TODO remove this code once #1518 is fixed
-            if(find(mindO->getKey().begin(), mindO->getKey().end(), ',') == mindO->getKey().end()) {
-                osToAdd.push_back(mindO);
-            } else {
-                MF_DEBUG("    SKIPPING key w/ ','" << endl);
+            if(find(o->getKey().begin(), o->getKey().end(), ',') != o->getKey().end()) {
+                MF_DEBUG("  SKIPPING key w/ ','" << o->getKey() << endl);
                 continue;
             }
+            MF_DEBUG("  " << o->getKey() << endl);
 
+            // clone O's descriptor to get N which might be deleted later
+            Note* n = new Note(*o->getOutlineDescriptorAsNote());
+            n->setOutline(outlinesMap);
+            n->clearLinks();
+            n->addLink(
+                new Link{
+                    LINK_NAME_OUTLINE_KEY,
+                    o->getKey()
+                }
+            );
+            n->addLink(
+                new Link{
+                    LINK_NAME_OUTLINE_PATH,
+                    Mind::outlineMapKey2Relative(o->getKey())
+                }
+            );
+            newNs.push_back(n);
         }
     }
-    MF_DEBUG("ADDING mind keys to map:" << endl);
-    for(auto o:osToAdd) {
-        MF_DEBUG("  " << o->getKey() << endl);
-        // clone O's descriptor to get N which might be deleted later
-        Note* n = new Note(*o->getOutlineDescriptorAsNote());
 
-        n->clearLinks();
-        n->addLink(
-            new Link{
-                LINK_NAME_OUTLINE_KEY,
-                o->getKey()
-            }
-        );
-        n->addLink(
-            new Link{
-                LINK_NAME_OUTLINE_PATH,
-                Mind::outlineMapKey2Relative(o->getKey())
-            }
-        );
-
-        outlinesMap->addNote(n , 0);
+    Outline::Patch result{Outline::Patch::Diff::NO, 0, 0};
+    if(newNs.size() || removedCount) {
+        newNs.insert(newNs.end(), validNs.begin(), validNs.end());
+        outlinesMap->setNotes(newNs);
+        result.diff = Outline::Patch::Diff::MOVE;
+        result.count = newNs.size()? newNs.size()-1: 0;
+    } else if(changed) {
+        result.diff = Outline::Patch::Diff::CHANGE;
+        result.start = changedFrom;
+        result.count = changedTo - changedFrom;
+    }
+    if(patch) {
+        *patch = result;
     }
 }
 
@@ -1123,8 +1236,11 @@ Outline* Mind::outlinesMapLearn(string outlineKey)
     #ifdef MF_DEBUG_LIBRARY
     MF_DEBUG("Learning Os map from " << outlineKey << endl);
     #endif
-    Outline* outlinesMap = memory.learnOutlinesMap(outlineKey);
+    return outlinesMapNormalize(memory.learnOutlinesMap(outlineKey));
+}
 
+Outline* Mind::outlinesMapNormalize(Outline* outlinesMap)
+{
     vector<Note*> osToRemove{};
 
     // normalization: set Ns types to O + resolve O links to absolute
@@ -1168,37 +1284,74 @@ Outline* Mind::outlinesMapLearn(string outlineKey)
         MF_DEBUG("Removing Ns with MISSING relative O key:" << endl);
         for(auto oToRemove:osToRemove) {
             MF_DEBUG("  " << oToRemove->getName() << endl);
-            delete oToRemove;
             outlinesMap->removeNote(oToRemove);
+            delete oToRemove;
         }
         osToRemove.clear();
     }
 
-    // synchronize map's Os with mind's Os
-    outlinesMapSynchronize(outlinesMap);
-
     return outlinesMap;
 }
 
-Outline* Mind::outlinesMapGet()
+bool Mind::outlinesMapPrepare()
 {
-    if(this->outlinesMap) {
-        // ensure consistency between mind's and map's Os
-        outlinesMapSynchronize(this->outlinesMap);
+    if(!outlinesMapLoading.valid()) {
+        outlinesMapLoadingPath = config.getOutlinesMapPath();
+        if(this->outlinesMap || !isFile(outlinesMapLoadingPath.c_str())) {
+            // nothing to parse - map is synchronized (or created) by outlinesMapGet()
+            return true;
+        }
 
-        return this->outlinesMap;
+        // worker thread does I/O and Markdown parsing only - it doesn't touch ontology
+        const string* outlinesMapPath = &outlinesMapLoadingPath;
+        outlinesMapLoading = Executor::getInstance().submit(
+            [outlinesMapPath]() {
+                MarkdownDocument* md = new MarkdownDocument{outlinesMapPath};
+                md->from();
+                return md;
+            },
+            Executor::Priority::INTERACTIVE).share();
     }
 
-    string outlinesMapPath{config.getOutlinesMapPath()};
+    return outlinesMapLoading.wait_for(chrono::microseconds(0)) == future_status::ready;
+}
 
-    if(isFile(outlinesMapPath.c_str())) {
-        // load existing Os map
-        this->outlinesMap = outlinesMapLearn(outlinesMapPath);
-    } else {
-        // create new Os map
-        this->outlinesMap = outlinesMapNew(outlinesMapPath);
+Outline* Mind::outlinesMapGet(Outline::Patch* patch)
+{
+    bool loaded{};
+    if(outlinesMapLoading.valid()) {
+        // create the map from Markdown parsed by the worker thread
+        MarkdownDocument* md = outlinesMapLoading.get();
+        outlinesMapLoading = shared_future<MarkdownDocument*>{};
+        if(!this->outlinesMap) {
+            this->outlinesMap = outlinesMapNormalize(memory.learnOutlinesMap(*md));
+            loaded = true;
+        }
+        delete md;
+    }
+
+    if(!this->outlinesMap) {
+        string outlinesMapPath{config.getOutlinesMapPath()};
 
-        outlinesMapRemember();
+        if(isFile(outlinesMapPath.c_str())) {
+            // load existing Os map
+            this->outlinesMap = outlinesMapLearn(outlinesMapPath);
+        } else {
+            // create new Os map
+            this->outlinesMap = outlinesMapNew(outlinesMapPath);
+
+            outlinesMapRemember();
+        }
+        loaded = true;
+    }
+
+    // ensure consistency between mind's and map's Os
+    outlinesMapSynchronize(this->outlinesMap, patch);
+    if(patch && loaded) {
+        // (re)loaded map must be rendered from scratch
+        patch->diff = Outline::Patch::Diff::MOVE;
+        patch->start = 0;
+        patch->count = this->outlinesMap->getNotesCount()? this->outlinesMap->getNotesCount()-1: 0;
     }
 
     return this->outlinesMap;
@@ -1246,9 +1399,6 @@ Note* Mind::noteNew(
         n->setProgress(progress);
         n->completeProperties(n->getModified());
 
-        n->setReadPretty();
-        n->setModifiedPretty();
-
         o->addNote(n, NO_PARENT==offset?0:offset);
         return n;
     } else {
@@ -1284,6 +1434,8 @@ Outline* Mind::noteRefactor(Note* noteToRefactor, const string& targetOutlineKey
 
             memory.remember(sourceOutline);
             memory.remember(targetOutline);
+            indexOutline(sourceOutline);
+            indexOutline(targetOutline);
 
             return targetOutline;
         } else {
@@ -1301,6 +1453,7 @@ Outline* Mind::noteForget(Note* note)
         deleteWatermark++;
 
         note->getOutline()->forgetNote(note);
+        indexOutline(o);
         return o;
     } else {
         throw MindForgerException("Unable find Outline from which should be the Note deleted!");
@@ -1361,6 +1514,172 @@ void Mind::onRemembering()
     allNotesCache.clear();
 }
 
+/*
+ * Repository changes
+ */
+
+bool Mind::repositoryWatch()
+{
+    if(memory.isAware()
+         && config.getActiveRepository()
+         && config.getActiveRepository()->getMode() == Repository::RepositoryMode::REPOSITORY)
+    {
+        return repositoryWatcher.watch(memory.getRepositoryIndexer().getMemoryDirectory());
+    }
+    return false;
+}
+
+size_t Mind::repositoryLearnChanges(int timeoutMillis)
+{
+    vector<RepositoryChange> changes{};
+    if(!repositoryWatcher.poll(changes, timeoutMillis)) {
+        return 0;
+    }
+
+    lock_guard<mutex> criticalSection{exclusiveMind};
+
+    size_t learned = 0;
+    for(const RepositoryChange& change:changes) {
+        switch(change.type) {
+        case RepositoryChange::Type::CREATED:
+        case RepositoryChange::Type::MODIFIED:
+            learned += repositoryLearnChange(change.path);
+            break;
+        case RepositoryChange::Type::DELETED:
+            learned += repositoryUnlearnChange(change.path);
+            break;
+        case RepositoryChange::Type::RESCAN:
+            learned += repositoryRescan();
+            break;
+        }
+    }
+
+    if(learned) {
+        // Os were replaced/removed > evict caches of Ns
+        deleteWatermark++;
+        onRemembering();
+#ifdef MF_MD_2_HTML_CMARK
+        if(config.isAutolinking()) {
+            autolinking->reindex();
+        }
+#endif
+    }
+    repositoryDeleteRetired();
+
+    MF_DEBUG("Mind: learned " << learned << " O(s) from " << changes.size() << " repository changes" << endl);
+    return learned;
+}
+
+size_t Mind::repositoryLearnChange(const string& path)
+{
+    if(memory.isRemembered(path)) {
+        // file written by Mind
+        return 0;
+    }
+
+    Outline* replaced = memory.getOutline(path);
+    Outline* outline = memory.learnOutline(path);
+    if(replaced) {
+        unindexOutline(replaced);
+    }
+    if(outline) {
+        indexOutline(outline);
+        for(RepositoryChangeListener* l:repositoryChangeListeners) {
+            l->learned(outline, replaced);
+        }
+        return 1;
+    } else if(replaced) {
+        // file is no longer a valid O > it was unlearned
+        for(RepositoryChangeListener* l:repositoryChangeListeners) {
+            l->unlearned(replaced);
+        }
+        return 1;
+    }
+    return 0;
+}
+
+size_t Mind::repositoryUnlearnChange(const string& path)
+{
+    vector<Outline*> unlearned = memory.unlearnOutlines(path);
+    for(Outline* o:unlearned) {
+        unindexOutline(o);
+        for(RepositoryChangeListener* l:repositoryChangeListeners) {
+            l->unlearned(o);
+        }
+    }
+    return unlearned.size();
+}
+
+size_t Mind::repositoryRescan()
+{
+    RepositoryIndexer& indexer = memory.getRepositoryIndexer();
+    // modification time and size of files before rescan
+    unordered_map<string,pair<time_t,size_t>> stamps{};
+    for(const FileStat* f:indexer.getMarkdownFiles()) {
+        stamps[f->path] = make_pair(f->modified, f->size);
+    }
+    indexer.index(config.getActiveRepository());
+
+    // learning changes indexer's files > collect paths first
+    set<string> files{};
+    vector<string> changed{};
+    for(const FileStat* f:indexer.getMarkdownFiles()) {
+        files.insert(f->path);
+        auto s = stamps.find(f->path);
+        if(s == stamps.end()
+             || s->second.first != f->modified
+             || s->second.second != f->size)
+        {
+            changed.push_back(f->path);
+        }
+    }
+
+    size_t learned = 0;
+    for(const string& path:changed) {
+        learned += repositoryLearnChange(path);
+    }
+
+    vector<string> removed{};
+    for(Outline* o:memory.getOutlines()) {
+        if(files.find(o->getKey()) == files.end()) {
+            removed.push_back(o->getKey());
+        }
+    }
+    for(const string& k:removed) {
+        learned += repositoryUnlearnChange(k);
+    }
+
+    return learned;
+}
+
+void Mind::repositoryDeleteRetired()
+{
+    if(!memory.getRetiredOutlinesCount()) {
+        return;
+    }
+
+    switch(config.getMindState()) {
+    case Configuration::MindState::SLEEPING:
+        if(!activeProcesses) {
+            memory.deleteRetiredOutlines();
+        }
+        break;
+    case Configuration::MindState::THINKING:
+        // AA knows Ns of retired Os and it's stale anyway > forget and learn again
+        if(mindSleep()) {
+            persistMindState(Configuration::MindState::SLEEPING);
+            memory.deleteRetiredOutlines();
+            if(config.getAsyncMindThreshold() > memory.getNotesCount()) {
+                mindDream();
+            }
+        }
+        break;
+    default:
+        // DREAMING > retired Os are deleted on the next change
+        break;
+    }
+}
+
 MindStatistics* Mind::getStatistics()
 {
     // IMPROVE cache it until memory is dirty
@@ -1441,8 +1760,7 @@ unique_ptr<vector<Outline*>> Mind::findOutlineByNameFts(const string& pattern) c
 Outline* Mind::findOutlineByKey(const string& key) const
 {
     if(key.size()) {
-        vector<Outline*> outlines = memory.getOutlines();
-        for(Outline* outline:outlines) {
+        for(Outline* outline:memory.getOutlines()) {
             if(key.compare(outline->getKey()) == 0) {
                 return outline;
             }
@@ -1462,10 +1780,18 @@ void Mind::initWingman()
         switch(config.getWingmanLlmProvider()) {
         case WingmanLlmProviders::WINGMAN_PROVIDER_OPENAI:
             MF_DEBUG("  MIND Wingman init: OpenAI" << endl);
-            wingman = (Wingman*)new OpenAiWingman{
+            wingman = std::make_shared<OpenAiWingman>(
                 config.getWingmanApiKey(),
                 config.getWingmanLlmModel()
-            };
+            );
+            wingmanLlmProvider = config.getWingmanLlmProvider();
+            return;
+        case WingmanLlmProviders::WINGMAN_PROVIDER_LLAMACPP:
+            MF_DEBUG("  MIND Wingman init: llama.cpp" << endl);
+            wingman = std::make_shared<LlamaCppWingman>(
+                config.getWingmanLlamaCppUrl(),
+                config.getWingmanLlmModel()
+            );
             wingmanLlmProvider = config.getWingmanLlmProvider();
             return;
         // case BARD:
@@ -1473,9 +1799,9 @@ void Mind::initWingman()
         //  return;
         case WingmanLlmProviders::WINGMAN_PROVIDER_MOCK:
             MF_DEBUG("  MIND Wingman init: MOCK" << endl);
-            wingman = (Wingman*)new MockWingman{
+            wingman = std::make_shared<MockWingman>(
                 "mock-llm-model"
-            };
+            );
             wingmanLlmProvider = config.getWingmanLlmProvider();
             return;
         default:
@@ -1485,7 +1811,7 @@ void Mind::initWingman()
     }
 
     MF_DEBUG("MIND Wingman init: DISABLED" << endl);
-    wingman = nullptr;
+    wingman.reset();
     wingmanLlmProvider = WingmanLlmProviders::WINGMAN_PROVIDER_NONE;
 }
 
@@ -1495,15 +1821,21 @@ Wingman* Mind::getWingman()
         initWingman();
     }
 
-    return this->wingman;
+    return this->wingman.get();
 }
 
 CommandWingmanChat Mind::wingmanChat(CommandWingmanChat& command)
 {
     MF_DEBUG("MIND: Wingman chat..." << endl);
 
-    if(getWingman()) {
-        getWingman()->chat(command);
+    Wingman* w = getWingman();
+    if(w) {
+        command.cached = false;
+        const string wingmanKey{w->getWingmanCacheKey()};
+        if(!wingmanCache.get(wingmanKey, command)) {
+            w->chat(command);
+            wingmanCache.put(wingmanKey, command);
+        }
         MF_DEBUG("MIND: DONE Wingman chat" << endl);
     } else {
         MF_DEBUG("ERROR: MIND Wingman chat - Wingman NOT configured and/or initialized" << endl);
@@ -1514,4 +1846,67 @@ CommandWingmanChat Mind::wingmanChat(CommandWingmanChat& command)
     return command;
 }
 
+shared_future<bool> Mind::wingmanChatStream(
+    shared_ptr<CommandWingmanChat> command,
+    shared_ptr<WingmanChatListener> listener)
+{
+    MF_DEBUG("MIND: Wingman streaming chat..." << endl);
+
+    joinWingmanStreams(false);
+
+    command->cached = false;
+    getWingman();
+    // stream owns Wingman - provider may be changed while it's streaming
+    shared_ptr<Wingman> w = wingman;
+    if(!w) {
+        MF_DEBUG("ERROR: MIND Wingman chat - Wingman NOT configured and/or initialized" << endl);
+        command->errorMessage = "ERROR: Wingman NOT configured and/or initialized";
+        command->status = WingmanStatusCode::WINGMAN_STATUS_CODE_ERROR;
+
+        promise<bool> p{};
+        p.set_value(false);
+        return shared_future<bool>(p.get_future());
+    }
+
+    // network bound request doesn't run on the executor - it would block a worker
+    WingmanCache* cache = &wingmanCache;
+    std::packaged_task<bool ()> chatTask(
+        [w, cache, command, listener]() {
+            const string wingmanKey{w->getWingmanCacheKey()};
+            if(cache->get(wingmanKey, *command)) {
+                if(listener->isCancelled() || !listener->onToken(command->answerMarkdown)) {
+                    command->status = WingmanStatusCode::WINGMAN_STATUS_CODE_ERROR;
+                    command->errorMessage.assign(WINGMAN_ERROR_CANCELLED);
+                    command->answerMarkdown.clear();
+                }
+            } else {
+                w->chatStream(*command, *listener);
+                cache->put(wingmanKey, *command);
+            }
+            MF_DEBUG("MIND: DONE Wingman streaming chat" << endl);
+            return command->status == WingmanStatusCode::WINGMAN_STATUS_CODE_OK;
+        });
+
+    wingmanStreams.push_back(WingmanStream{listener, chatTask.get_future().share(), thread{}});
+    WingmanStream& stream = wingmanStreams.back();
+    stream.thread = thread{std::move(chatTask)};
+
+    return stream.result;
+}
+
+void Mind::joinWingmanStreams(bool cancel)
+{
+    for(auto s=wingmanStreams.begin(); s!=wingmanStreams.end(); ) {
+        if(cancel) {
+            s->listener->cancel();
+        }
+        if(cancel || s->result.wait_for(chrono::seconds(0)) == future_status::ready) {
+            s->thread.join();
+            s = wingmanStreams.erase(s);
+        } else {
+            ++s;
+        }
+    }
+}
+
 } /* namespace */
@@ -20,23 +20,34 @@
 #define M8R_MIND_H_
 
 #include <inttypes.h>
+#include <future>
+#include <list>
 #include <memory>
 #include <mutex>
 #include <regex>
+#include <thread>
+#include <unordered_set>
 #include <vector>
 
 #include "memory.h"
+#include "mind_listener.h"
 #include "knowledge_graph.h"
+#include "relationship_graph.h"
+#include "tags_cardinality.h"
 #include "ai/ai.h"
 #include "ai/llm/wingman.h"
 #include "ai/llm/openai_wingman.h"
 #include "ai/llm/mock_wingman.h"
+#include "ai/llm/llamacpp_wingman.h"
+#include "ai/llm/wingman_cache.h"
 #include "associated_notes.h"
 #include "ontology/thing_class_rel_triple.h"
 #include "aspect/mind_scope_aspect.h"
 #include "../config/configuration.h"
 #include "../representations/representation_interceptor.h"
 #include "../representations/markdown/markdown_configuration_representation.h"
+#include "../persistence/configuration_store.h"
+#include "../repository_watcher.h"
 
 namespace m8r {
 
@@ -149,7 +160,11 @@ private:
     Ontology ontology;
     RepresentationInterceptor* autoInterceptor;
     HtmlOutlineRepresentation htmlRepresentation;
-    MarkdownConfigurationRepresentation* mdConfigRepresentation;
+    /**
+     * Debounced configuration persistence - mind state changes are frequent
+     * and may come from worker threads, therefore they must NOT cause disk I/O.
+     */
+    ConfigurationStore* configStore;
     Memory memory;
     AutolinkingMind* autolinking;
     MindStatistics* stats;
@@ -162,10 +177,17 @@ private:
      * - Outline link is *relative* on the filesystem and absolute (resolved) in runtime
      */
     Outline* outlinesMap;
+    // Os map file parsed by outlinesMapPrepare() in a worker thread
+    std::string outlinesMapLoadingPath;
+    std::shared_future<MarkdownDocument*> outlinesMapLoading;
 
     std::string outlineMapKey2Relative(const std::string& outlineKey) const;
     std::string outlineMapKey2Absolute(const std::string& outlineKey) const;
-    void outlinesMapSynchronize(Outline* outlinesMap);
+    void outlinesMapSynchronize(Outline* outlinesMap, Outline::Patch* patch=nullptr);
+    Outline* outlinesMapNormalize(Outline* outlinesMap);
+    // keep O indices (relationships, tags cardinality) in sync w/ memory
+    void indexOutline(Outline* outline);
+    void unindexOutline(Outline* outline);
 
     /**
      * Atomic mind state changes and asynchronous computations synchronization
@@ -205,15 +227,42 @@ private:
      */
     WingmanLlmProviders wingmanLlmProvider;
     /**
-     * Wingman
+     * Wingman - shared w/ streaming chats which may outlive provider change.
      */
-    Wingman* wingman;
+    std::shared_ptr<Wingman> wingman;
+    /**
+     * Wingman answers cache (shared by all providers, keyed by LLM model).
+     */
+    WingmanCache wingmanCache;
+    /**
+     * Streaming Wingman chats - threads are joined when a new chat is started
+     * (finished ones) and on Mind destruction (in-flight ones are cancelled).
+     */
+    struct WingmanStream {
+        std::shared_ptr<WingmanChatListener> listener;
+        std::shared_future<bool> result;
+        std::thread thread;
+    };
+    std::list<WingmanStream> wingmanStreams;
 
     /**
      * @brief Knowledge graph mind representation.
      */
     KnowledgeGraph* knowledgeGraph;
 
+    /**
+     * @brief O/N/Tag links, tags and membership w/ forward and backward adjacency.
+     *
+     * Graph is built lazily on the first query (Ns bodies must be loaded) and
+     * then it's updated incrementally whenever O is remembered, learned or forgotten.
+     */
+    RelationshipGraph relationshipGraph;
+
+    /**
+     * @brief Os/Ns tagged by every tag - maintained whenever O is remembered, learned or forgotten.
+     */
+    TagsCardinality tagCounters;
+
     /**
      * @brief Semantic view of Memory.
      *
@@ -245,6 +294,12 @@ private:
      */
     std::vector<Note*> allNotesCache;
 
+    /**
+     * @brief Watcher of changes made to repository outside of MindForger.
+     */
+    RepositoryWatcher repositoryWatcher;
+    std::vector<RepositoryChangeListener*> repositoryChangeListeners;
+
     /**
      * @brief Time scope.
      */
@@ -272,12 +327,17 @@ public:
     int getDeleteWatermark() const { return deleteWatermark; }
 
     /**
-     * @brief Synchronize both desired and current state and persist it.
+     * @brief Get configuration persistence to be used to save configuration changes.
+     */
+    ConfigurationStore* getConfigurationStore() const { return configStore; }
+
+    /**
+     * @brief Synchronize both desired and current state and schedule its persistence.
      */
     void persistMindState(Configuration::MindState mindState) {
         config.setMindState(mindState);
         config.setDesiredMindState(mindState);
-        mdConfigRepresentation->save(config);
+        configStore->save(config);
     }
 
     /*
@@ -311,6 +371,37 @@ public:
      */
     bool amnesia();
 
+    /*
+     * REPOSITORY CHANGES
+     */
+
+    /**
+     * @brief Watch learned repository for changes made outside of MindForger (Linux only).
+     */
+    bool repositoryWatch();
+    void repositoryUnwatch() { repositoryWatcher.stop(); }
+    bool isRepositoryWatched() const { return repositoryWatcher.isWatching(); }
+
+    /**
+     * @brief Learn changes detected by repository watcher - to be invoked periodically.
+     *
+     * Only new and changed Outlines are (re)learned, Outlines of removed files are
+     * unlearned, listeners are notified and Mind caches/indices updated. Changes
+     * of files written by Mind itself are ignored.
+     *
+     * @return number of (re/un)learned Outlines.
+     */
+    size_t repositoryLearnChanges(int timeoutMillis=0);
+
+    void addRepositoryChangeListener(RepositoryChangeListener* listener) {
+        repositoryChangeListeners.push_back(listener);
+    }
+    void removeRepositoryChangeListener(RepositoryChangeListener* listener) {
+        repositoryChangeListeners.erase(
+            std::remove(repositoryChangeListeners.begin(), repositoryChangeListeners.end(), listener),
+            repositoryChangeListeners.end());
+    }
+
     /*
      *  AI
      */
@@ -351,6 +442,11 @@ public:
      */
     void remember(Outline* outline);
 
+    /**
+     * @brief Remember batch of Outlines and update mind (indices if needed) once.
+     */
+    void remember(const std::vector<Outline*>& outlines);
+
     /**
      * @brief Remember existing Outline and update mind (indices if needed).
      */
@@ -415,14 +511,19 @@ public:
     /**
      * @brief Get Notes references by note (outgoing).
      */
-    std::vector<Note*>* getReferencedNotes(const Note& note) const;
-    std::vector<Note*>* getReferencedNotes(const Note& note, const Outline& outline) const;
+    std::vector<Note*>* getReferencedNotes(const Note& note);
+    std::vector<Note*>* getReferencedNotes(const Note& note, const Outline& outline);
 
     /**
      * @brief Get Notes that reference the note (incoming).
      */
-    std::vector<Note*>* getRefereeNotes(const Note& note) const;
-    std::vector<Note*>* getRefereeNotes(const Note& note, const Outline& outline) const;
+    std::vector<Note*>* getRefereeNotes(const Note& note);
+    std::vector<Note*>* getRefereeNotes(const Note& note, const Outline& outline);
+
+    /**
+     * @brief Get relationship graph (built on the first call).
+     */
+    RelationshipGraph& getRelationshipGraph();
 
     /*
      * LABELS and TAGS
@@ -523,6 +624,17 @@ public:
      */
     std::shared_future<bool> getAssociatedNotes(AssociatedNotes& associations);
 
+    /**
+     * @brief User confirmed association by choosing it from Note's associations.
+     *
+     * Confirmed (and skipped) associations are used to train associations
+     * assessment model in the background.
+     */
+    void confirmAssociation(
+        const Note* note,
+        const Note* association,
+        const std::vector<std::pair<Note*,float>>& leaderboard);
+
     /*
      * OUTLINE MGMT
      */
@@ -541,6 +653,10 @@ public:
             Stencil* outlineStencil = nullptr
     );
     std::string outlineNew(Outline* outline);
+    /**
+     * @brief Remember batch of new Outlines - inferred knowledge is flushed once for the whole batch.
+     */
+    void outlinesNew(const std::vector<Outline*>& outlines);
 
 
     /**
@@ -560,6 +676,11 @@ public:
      */
     bool outlineForget(std::string outlineKey);
 
+    /**
+     * @brief Move Outline's file to the new key (path) - Outline is not saved.
+     */
+    bool outlineMove(Outline* outline, const std::string& outlineKey);
+
     /*
      * OUTLINE MAP (TREE)
      */
@@ -569,13 +690,26 @@ public:
      */
     Outline* outlinesMapNew(std::string outlineKey);
     /**
-     * @brief Load Os map (tree).
+     * @brief Load Os map (tree) - map is NOT synchronized w/ Os.
      */
     Outline* outlinesMapLearn(std::string outlineKey);
     /**
-     * @brief Load or create Os map (tree).
+     * @brief Parse Os map (tree) file in a worker thread.
+     *
+     * Parsing of the map is the expensive part of outlinesMapGet() - frontend
+     * can prepare the map w/o blocking and poll until it's ready. Worker thread
+     * parses Markdown only, map Ns are created by outlinesMapGet() as they
+     * use (shared) ontology.
+     *
+     * @return true if outlinesMapGet() can be called w/o parsing.
+     */
+    bool outlinesMapPrepare();
+    /**
+     * @brief Load or create Os map (tree) and synchronize it w/ Os.
+     *
+     * @param patch     changes made to map's Ns by the synchronization.
      */
-    Outline* outlinesMapGet();
+    Outline* outlinesMapGet(Outline::Patch* patch=nullptr);
     /**
      * @brief Save Os map (tree).
      */
@@ -686,7 +820,27 @@ public:
      * WINGMAN
      */
     Wingman* getWingman();
+    WingmanCache& getWingmanCache() { return wingmanCache; }
     CommandWingmanChat wingmanChat(CommandWingmanChat& command);
+    /**
+     * @brief Asynchronous streaming Wingman chat.
+     *
+     * Answer tokens are delivered to the listener from a worker thread,
+     * the request can be cancelled using the listener. Command and listener
+     * are shared w/ the worker thread - command may be read once the returned
+     * future is ready.
+     */
+    std::shared_future<bool> wingmanChatStream(
+        std::shared_ptr<CommandWingmanChat> command,
+        std::shared_ptr<WingmanChatListener> listener);
+
+private:
+    /**
+     * @brief Join finished streaming chats - cancel and join all of them if requested.
+     */
+    void joinWingmanStreams(bool cancel);
+
+public:
 
     /*
      * DIAGNOSTICS
@@ -729,6 +883,14 @@ private:
      */
     void onRemembering();
 
+    size_t repositoryLearnChange(const std::string& path);
+    size_t repositoryUnlearnChange(const std::string& path);
+    size_t repositoryRescan();
+    /**
+     * @brief Delete Os replaced/unlearned on repository changes once AA forgot their Ns.
+     */
+    void repositoryDeleteRetired();
+
     void findNoteFts(
             std::vector<Note*>* result,
             const std::string& pattern,
@@ -34,5 +34,29 @@ public:
     virtual void forget(Note* note) = 0;
 };
 
+/**
+ * @brief Listener used for subscriptions to Outlines (un)learned on repository changes.
+ *
+ * Indices (FTS, tags, autolinking, associations, ...) can use it to update
+ * incrementally instead of a full reload.
+ */
+class RepositoryChangeListener
+{
+public:
+    virtual ~RepositoryChangeListener() {}
+
+    /**
+     * @brief Outline was learned from a new or changed file.
+     *
+     * @param replaced  previous version of the Outline or nullptr - it's valid during
+     *                  the callback only, listener must drop references to it.
+     */
+    virtual void learned(Outline* outline, Outline* replaced) = 0;
+    /**
+     * @brief Outline of removed file was unlearned - it's valid during the callback only.
+     */
+    virtual void unlearned(Outline* outline) = 0;
+};
+
 }
 #endif // M8R_MIND_LISTENER_H
@@ -24,6 +24,7 @@
 
 #include "thing_class_rel_triple.h"
 #include "taxonomy.h"
+#include "relationship_store.h"
 
 #include "../../config/palette.h"
 #include "../../model/tag.h"
@@ -148,6 +149,11 @@ private:
     RelationshipType* RELATIONSHIP_TYPE_OPPOSITE_OF;
     RelationshipType* RELATIONSHIP_TYPE_DEPENDS_ON;
 
+    /**
+     * Explicit relationships among Things (adjacency by Thing ID).
+     */
+    RelationshipStore relationships;
+
     /**
      * Ontology metamodel captures meta-model level relationships among O types, N types,
      * relationship types and tags e.g. child-rel opposite-of parent-rel.
@@ -204,6 +210,8 @@ public:
     const NoteType* findOrCreateNoteType(const std::string& key);
     const NoteType* getDefaultNoteType() const { return defaultNoteType; }
     Taxonomy<NoteType>& getNoteTypes() { return noteTypeTaxonomy; }
+
+    RelationshipStore& getRelationships() { return relationships; }
 };
 
 class OntologyProvider {
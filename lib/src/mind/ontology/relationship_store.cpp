@@ -0,0 +1,104 @@
+/*
+ relationship_store.cpp     MindForger thinking notebook
+
+ Copyright (C) 2016-2025 Martin Dvorak <martin.dvorak@mindforger.com>
+
+ This program is free software; you can redistribute it and/or
+ modify it under the terms of the GNU General Public License
+ as published by the Free Software Foundation; either version 2
+ of the License, or (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+#include "relationship_store.h"
+
+#include <algorithm>
+
+using namespace std;
+
+namespace m8r {
+
+RelationshipStore::RelationshipStore()
+    : adjacency{},
+      count{0}
+{
+}
+
+RelationshipStore::~RelationshipStore()
+{
+}
+
+void RelationshipStore::add(Relationship* relationship)
+{
+    adjacency[relationship->getSubject()->getId()].push_back(relationship);
+    if(relationship->getObject() != relationship->getSubject()) {
+        adjacency[relationship->getObject()->getId()].push_back(relationship);
+    }
+    count++;
+}
+
+void RelationshipStore::detach(ThingId id, const Relationship* relationship)
+{
+    auto i = adjacency.find(id);
+    if(i != adjacency.end()) {
+        vector<Relationship*>& rs = i->second;
+        rs.erase(std::remove(rs.begin(), rs.end(), relationship), rs.end());
+        if(rs.empty()) {
+            adjacency.erase(i);
+        }
+    }
+}
+
+bool RelationshipStore::remove(Relationship* relationship)
+{
+    const vector<Relationship*>& rs = getRelationships(relationship->getSubject());
+    if(std::find(rs.begin(), rs.end(), relationship) == rs.end()) {
+        return false;
+    }
+
+    detach(relationship->getSubject()->getId(), relationship);
+    detach(relationship->getObject()->getId(), relationship);
+    count--;
+    return true;
+}
+
+void RelationshipStore::remove(const Thing* thing)
+{
+    auto i = adjacency.find(thing->getId());
+    if(i != adjacency.end()) {
+        vector<Relationship*> rs{i->second};
+        for(Relationship* r:rs) {
+            remove(r);
+        }
+    }
+}
+
+void RelationshipStore::clear()
+{
+    adjacency.clear();
+    count = 0;
+}
+
+const vector<Relationship*>& RelationshipStore::getRelationships(const Thing* thing) const
+{
+    static const vector<Relationship*> NO_RELATIONSHIPS{};
+
+    auto i = adjacency.find(thing->getId());
+    if(i != adjacency.end()) {
+        return i->second;
+    }
+    return NO_RELATIONSHIPS;
+}
+
+size_t RelationshipStore::getRelationshipsCount(const Thing* thing) const
+{
+    return getRelationships(thing).size();
+}
+
+} // m8r namespace
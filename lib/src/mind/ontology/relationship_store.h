@@ -0,0 +1,72 @@
+/*
+ relationship_store.h     MindForger thinking notebook
+
+ Copyright (C) 2016-2025 Martin Dvorak <martin.dvorak@mindforger.com>
+
+ This program is free software; you can redistribute it and/or
+ modify it under the terms of the GNU General Public License
+ as published by the Free Software Foundation; either version 2
+ of the License, or (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+#ifndef M8R_RELATIONSHIP_STORE_H_
+#define M8R_RELATIONSHIP_STORE_H_
+
+#include <unordered_map>
+#include <vector>
+
+#include "thing_class_rel_triple.h"
+
+namespace m8r {
+
+/**
+ * @brief Central adjacency store of explicit relationships.
+ *
+ * Relationships are indexed by subject and object Thing IDs - both
+ * incoming and outgoing relationships are distinguished using subject.
+ * Things w/o relationships (vast majority of Notes) have no footprint.
+ * Store doesn't own relationships.
+ */
+class RelationshipStore
+{
+private:
+    std::unordered_map<ThingId,std::vector<Relationship*>> adjacency;
+    size_t count;
+
+public:
+    explicit RelationshipStore();
+    RelationshipStore(const RelationshipStore&) = delete;
+    RelationshipStore(const RelationshipStore&&) = delete;
+    RelationshipStore& operator=(const RelationshipStore&) = delete;
+    RelationshipStore& operator=(const RelationshipStore&&) = delete;
+    ~RelationshipStore();
+
+    void add(Relationship* relationship);
+    bool remove(Relationship* relationship);
+    /**
+     * @brief Remove all relationships of given Thing e.g. when it's forgotten.
+     */
+    void remove(const Thing* thing);
+    void clear();
+
+    /**
+     * @brief Get Thing's incoming and outgoing relationships.
+     */
+    const std::vector<Relationship*>& getRelationships(const Thing* thing) const;
+    size_t getRelationshipsCount(const Thing* thing) const;
+    size_t size() const { return count; }
+
+private:
+    void detach(ThingId id, const Relationship* relationship);
+};
+
+} // m8r namespace
+
+#endif /* M8R_RELATIONSHIP_STORE_H_ */
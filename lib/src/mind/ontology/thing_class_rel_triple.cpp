@@ -26,42 +26,64 @@ using namespace std;
  * Thing
  */
 
-long Thing::sequence = 0;
+atomic<ThingId> Thing::sequence{0};
 
 Thing::Thing()
-    : key{std::to_string(++sequence)},
-      name{}
+    : id{getNextId()},
+      name{StringPool::empty()},
+      autolinkingName{StringPool::empty()},
+      autolinkingAbbr{StringPool::empty()},
+      autolinkingAlias{StringPool::empty()}
 {
 }
 
 Thing::Thing(const string name)
+    : Thing{}
 {
     setName(name);
 }
 
 Thing::~Thing()
 {
+    releaseAutolinkingNames();
+    StringPool::getInstance().release(name);
+}
+
+void Thing::setName(const string& name)
+{
+    // intern first so that the string is not dropped from pool if name is not changed
+    const string* interned = StringPool::getInstance().intern(name);
+    releaseAutolinkingNames();
+    StringPool::getInstance().release(this->name);
+    this->name = interned;
+    autolinkName();
 }
 
 void Thing::autolinkName()
 {
-    if(name.size()) {
-        auto pos = name.find(":");
-        if(pos != string::npos) {
-            autolinkingAlias = name.substr(0, pos);
-            autolinkingAbbr = autolinkingAlias;
-            autolinkingName = name.substr(pos+1);
-            autolinkingName = stringLeftTrim(autolinkingName);
-        } else {
-            autolinkingAlias = name;
-            autolinkingName = name;
-            autolinkingAbbr.clear();
-        }
+    auto pos = name->find(":");
+    if(pos != string::npos) {
+        StringPool& pool = StringPool::getInstance();
+        autolinkingAlias = pool.intern(name->substr(0, pos));
+        autolinkingAbbr = pool.intern(*autolinkingAlias);
+        string n = name->substr(pos+1);
+        autolinkingName = pool.intern(stringLeftTrim(n));
     } else {
-        autolinkingAlias.clear();
-        autolinkingName.clear();
-        autolinkingAbbr.clear();
+        // borrow name i.e. no pool reference
+        autolinkingAlias = name;
+        autolinkingName = name;
+    }
+}
+
+void Thing::releaseAutolinkingNames()
+{
+    StringPool& pool = StringPool::getInstance();
+    for(const string* s:{autolinkingName, autolinkingAbbr, autolinkingAlias}) {
+        if(s != name) {
+            pool.release(s);
+        }
     }
+    autolinkingName = autolinkingAbbr = autolinkingAlias = StringPool::empty();
 }
 
 /*
@@ -77,7 +99,10 @@ ThingInTime::ThingInTime()
 }
 
 ThingInTime::ThingInTime(const std::string name)
-    : Thing{name}
+    : Thing{name},
+      created{},
+      read{},
+      modified{}
 {
 }
 
@@ -85,26 +110,6 @@ ThingInTime::~ThingInTime()
 {
 }
 
-time_t ThingInTime::getCreated() const
-{
-    return created;
-}
-
-void ThingInTime::setCreated()
-{
-    this->modified = datetimeNow();
-}
-
-void ThingInTime::setCreated(time_t created)
-{
-    this->created = created;
-}
-
-time_t ThingInTime::getModified() const
-{
-    return modified;
-}
-
 void ThingInTime::setModified()
 {
     this->modified = datetimeNow();
@@ -112,12 +117,11 @@ void ThingInTime::setModified()
 
 void ThingInTime::setModified(time_t modified)
 {
-    MF_ASSERT_FUTURE_TIMESTAMPS(created, read, modified, this->getKey() << "# " << name, name);
+    MF_ASSERT_FUTURE_TIMESTAMPS(created, read, modified, "#" << id << " " << *name, *name);
 
     this->modified = modified;
 }
 
-
 /*
  * Class
  */
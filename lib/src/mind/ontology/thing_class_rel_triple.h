@@ -19,13 +19,14 @@
 #ifndef M8R_THING_CLASS_REL_TRIPLE_H_
 #define M8R_THING_CLASS_REL_TRIPLE_H_
 
+#include <atomic>
 #include <string>
-#include <set>
 
 #include "../../debug.h"
 #include "../../config/color.h"
 #include "../../gear/string_utils.h"
 #include "../../gear/datetime_utils.h"
+#include "../../gear/string_pool.h"
 
 /*
  * Thing, Class, Relationship, RelationshipType and Triple
@@ -37,47 +38,48 @@ namespace m8r {
 
 class Relationship;
 
+/**
+ * @brief Thing identifier - unique within the process.
+ */
+typedef u_int32_t ThingId;
+
 /**
  * @brief Ontology Thing.
  *
+ * Thing is instantiated for every Outline and Note i.e. its memory footprint
+ * is critical: identifier is an integer, names are interned to m8r::StringPool
+ * and relationships are kept by m8r::RelationshipStore rather than by Things.
+ *
  * See m8r::Ontology.
  */
 class Thing
 {
 private:
-    static long sequence;
+    static std::atomic<ThingId> sequence;
 
 public:
-    static std::string getNextKey() { return std::to_string(++sequence); }
+    static ThingId getNextId() { return ++sequence; }
 
 protected:
     /**
      * @brief Thing identifier.
      */
-    std::string key;
+    ThingId id;
 
     /**
-     * @brief Display name.
-     */
-    std::string name;
-
-    /**
-     * @brief Relationships.
-     *
-     * Explicit relationships (both incoming and outgoing) distinquished
-     * using subject.
+     * @brief Display name (interned).
      */
-    std::set<Relationship*> relationships;
+    const std::string* name;
 
     /*
      * Transient fields
      */
 
-    // name used for autolinking
-    std::string autolinkingName;
-    std::string autolinkingAbbr;
+    // name used for autolinking (interned or borrowed name)
+    const std::string* autolinkingName;
+    const std::string* autolinkingAbbr;
     // autolinking: abbrev (if exists), name otherwise
-    std::string autolinkingAlias;
+    const std::string* autolinkingAlias;
 
 public:
     Thing();
@@ -88,26 +90,17 @@ public:
     Thing& operator=(const Thing&&) = delete;
     virtual ~Thing();
 
-    /**
-     * @brief Get think key.
-     *
-     * Key might be set on get.
-     *
-     * @return unique thing identifier.
-     */
-    virtual std::string& getKey() { return key; }
+    ThingId getId() const { return id; }
 
-    const std::string& getName() const { return name; }
-    virtual void setName(const std::string& name) { this->name = name; autolinkName(); }
-    const std::string& getAutolinkingName() const { return autolinkingName; }
-    const std::string& getAutolinkingAbbr() const { return autolinkingAbbr; }
-    const std::string& getAutolinkingAlias() const { return autolinkingAlias; }
+    const std::string& getName() const { return *name; }
+    void setName(const std::string& name);
+    const std::string& getAutolinkingName() const { return *autolinkingName; }
+    const std::string& getAutolinkingAbbr() const { return *autolinkingAbbr; }
+    const std::string& getAutolinkingAlias() const { return *autolinkingAlias; }
 
-    const std::set<Relationship*> getRelationships() const { return relationships; }
-    size_t getRelationshipsCount() const { return relationships.size(); }
-
-protected:
+private:
     void autolinkName();
+    void releaseAutolinkingNames();
 };
 
 /**
@@ -128,11 +121,11 @@ public:
     ThingInTime& operator=(const ThingInTime&&) = delete;
     virtual ~ThingInTime();
 
-    virtual time_t getCreated() const;
-    virtual void setCreated();
-    virtual void setCreated(time_t created);
+    time_t getCreated() const { return created; }
+    void setCreated() { created = datetimeNow(); }
+    void setCreated(time_t created) { this->created = created; }
 
-    virtual time_t getModified() const;
+    time_t getModified() const { return modified; }
     virtual void setModified();
     virtual void setModified(time_t modified);
 
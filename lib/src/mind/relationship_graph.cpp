@@ -0,0 +1,575 @@
+/*
+ relationship_graph.cpp     MindForger thinking notebook
+
+ Copyright (C) 2016-2025 Martin Dvorak <martin.dvorak@mindforger.com>
+
+ This program is free software; you can redistribute it and/or
+ modify it under the terms of the GNU General Public License
+ as published by the Free Software Foundation; either version 2
+ of the License, or (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+#include "relationship_graph.h"
+
+#include <algorithm>
+#include <unordered_set>
+
+#include "../gear/file_utils.h"
+#include "../gear/string_utils.h"
+
+using namespace std;
+
+namespace m8r {
+
+RelationshipGraph::RelationshipGraph()
+    : vertices{},
+      keys{},
+      pending{},
+      built{false}
+{
+}
+
+RelationshipGraph::~RelationshipGraph()
+{
+}
+
+void RelationshipGraph::clear()
+{
+    vertices.clear();
+    keys.clear();
+    pending.clear();
+    built = false;
+}
+
+/*
+ * Indexing
+ */
+
+void RelationshipGraph::build(const vector<Outline*>& outlines)
+{
+    clear();
+
+    // keys 1st so that links are resolved regardless of Os order
+    for(Outline* o:outlines) {
+        Vertex& ov = vertex(o, ThingType::OUTLINE);
+        setKey(ov, o->getId(), o->getKey());
+        for(Note* n:o->getNotes()) {
+            Vertex& nv = vertex(n, ThingType::NOTE);
+            addEdge(o->getId(), ov, n->getId(), nv, EdgeType::MEMBER);
+            setKey(nv, n->getId(), n->getKey());
+            nv.revision = n->getRevision();
+            nv.modified = n->getModified();
+        }
+    }
+    for(Outline* o:outlines) {
+        index(o->getId(), vertices.at(o->getId()), o->getKey(), o->getDescription(), o->getLinks(), o->getTags());
+        for(Note* n:o->getNotes()) {
+            index(n->getId(), vertices.at(n->getId()), o->getKey(), n->getDescription(), n->getLinks(), n->getTags());
+        }
+    }
+
+    built = true;
+}
+
+void RelationshipGraph::update(Outline* outline)
+{
+    if(!built) {
+        // graph is built on the next query
+        return;
+    }
+
+    const ThingId oid = outline->getId();
+    Vertex& ov = vertex(outline, ThingType::OUTLINE);
+
+    // Ns which are no longer O members (forgotten, refactored, ...)
+    unordered_set<ThingId> members{};
+    for(Note* n:outline->getNotes()) {
+        members.insert(n->getId());
+    }
+    vector<ThingId> stale{};
+    for(const Edge& e:ov.outgoing) {
+        if(e.type == EdgeType::MEMBER && members.find(e.id) == members.end()) {
+            stale.push_back(e.id);
+        }
+    }
+    for(ThingId id:stale) {
+        removeVertex(id);
+    }
+
+    setKey(ov, oid, outline->getKey());
+    vector<Note*> changed{};
+    for(Note* n:outline->getNotes()) {
+        const ThingId id = n->getId();
+        bool isNew = vertices.find(id) == vertices.end();
+        Vertex& nv = vertex(n, ThingType::NOTE);
+
+        // N might be moved from another O
+        auto member = std::find_if(nv.incoming.begin(), nv.incoming.end(), [](const Edge& e) {
+            return e.type == EdgeType::MEMBER;
+        });
+        if(member == nv.incoming.end() || member->id != oid) {
+            if(member != nv.incoming.end()) {
+                auto previous = vertices.find(member->id);
+                if(previous != vertices.end()) {
+                    vector<Edge>& es = previous->second.outgoing;
+                    es.erase(std::remove_if(es.begin(), es.end(), [id](const Edge& e) {
+                        return e.id == id && e.type == EdgeType::MEMBER;
+                    }), es.end());
+                }
+                nv.incoming.erase(member);
+            }
+            addEdge(oid, ov, id, nv, EdgeType::MEMBER);
+        }
+
+        const string key = n->getKey();
+        if(isNew || key != nv.key || n->getRevision() != nv.revision || n->getModified() != nv.modified) {
+            setKey(nv, id, key);
+            nv.revision = n->getRevision();
+            nv.modified = n->getModified();
+            changed.push_back(n);
+        }
+    }
+
+    // O's description and tags are always re-scanned (single description)
+    index(oid, ov, outline->getKey(), outline->getDescription(), outline->getLinks(), outline->getTags());
+    for(Note* n:changed) {
+        index(n->getId(), vertices.at(n->getId()), outline->getKey(), n->getDescription(), n->getLinks(), n->getTags());
+    }
+}
+
+void RelationshipGraph::remove(Outline* outline)
+{
+    if(built) {
+        removeVertex(outline->getId());
+    }
+}
+
+RelationshipGraph::Vertex& RelationshipGraph::vertex(Thing* thing, ThingType type)
+{
+    auto i = vertices.find(thing->getId());
+    if(i == vertices.end()) {
+        Vertex& v = vertices[thing->getId()];
+        v.thing = thing;
+        v.type = type;
+        v.revision = 0;
+        v.modified = 0;
+        return v;
+    }
+    return i->second;
+}
+
+const RelationshipGraph::Vertex* RelationshipGraph::find(const Thing* thing) const
+{
+    auto i = vertices.find(thing->getId());
+    return i == vertices.end()? nullptr: &i->second;
+}
+
+void RelationshipGraph::setKey(Vertex& v, ThingId id, const string& key)
+{
+    if(v.key == key) {
+        return;
+    }
+
+    if(!v.key.empty()) {
+        auto k = keys.find(v.key);
+        if(k != keys.end() && k->second == id) {
+            keys.erase(k);
+        }
+        // links to the old key are broken now
+        unlinkIncoming(id, v);
+    }
+
+    v.key = key;
+    // 1st O/N w/ the key wins (GitHub would mangle duplicate sections w/ suffix)
+    if(key.empty() || !keys.insert(make_pair(key, id)).second) {
+        return;
+    }
+
+    auto p = pending.find(key);
+    if(p != pending.end()) {
+        vector<ThingId> sources{};
+        sources.swap(p->second);
+        pending.erase(p);
+        for(ThingId s:sources) {
+            auto sv = vertices.find(s);
+            if(sv != vertices.end()) {
+                vector<string>& unresolved = sv->second.unresolved;
+                auto u = std::find(unresolved.begin(), unresolved.end(), key);
+                if(u != unresolved.end()) {
+                    unresolved.erase(u);
+                }
+                addEdge(s, sv->second, id, v, EdgeType::LINK);
+            }
+        }
+    }
+}
+
+void RelationshipGraph::index(
+    ThingId id,
+    Vertex& v,
+    const string& outlineKey,
+    const vector<string*>& description,
+    const LinkVector& links,
+    const TagVector* tags)
+{
+    clearOutgoing(id, v);
+
+    vector<string> urls{};
+    parseLinks(description, urls);
+    for(Link* l:links) {
+        urls.push_back(l->getUrl());
+    }
+    string key{};
+    for(const string& url:urls) {
+        if(linkToKey(outlineKey, url, key)) {
+            addLink(id, v, key);
+        }
+    }
+
+    if(tags) {
+        for(const Tag* t:*tags) {
+            // Tags are owned by ontology, graph just references them
+            Vertex& tv = vertex(const_cast<Tag*>(t), ThingType::TAG);
+            addEdge(id, v, t->getId(), tv, EdgeType::TAG);
+        }
+    }
+}
+
+void RelationshipGraph::addEdge(ThingId fromId, Vertex& from, ThingId toId, Vertex& to, EdgeType type)
+{
+    from.outgoing.push_back(Edge{to.thing, toId, type, to.type});
+    to.incoming.push_back(Edge{from.thing, fromId, type, from.type});
+}
+
+void RelationshipGraph::addLink(ThingId id, Vertex& v, const string& key)
+{
+    auto k = keys.find(key);
+    if(k != keys.end()) {
+        if(k->second == id) {
+            return;
+        }
+        for(const Edge& e:v.outgoing) {
+            if(e.id == k->second && e.type == EdgeType::LINK) {
+                return;
+            }
+        }
+        addEdge(id, v, k->second, vertices.at(k->second), EdgeType::LINK);
+    } else if(std::find(v.unresolved.begin(), v.unresolved.end(), key) == v.unresolved.end()) {
+        v.unresolved.push_back(key);
+        pending[key].push_back(id);
+    }
+}
+
+void RelationshipGraph::clearOutgoing(ThingId id, Vertex& v)
+{
+    vector<Edge> members{};
+    for(const Edge& e:v.outgoing) {
+        if(e.type == EdgeType::MEMBER) {
+            members.push_back(e);
+            continue;
+        }
+        auto to = vertices.find(e.id);
+        if(to != vertices.end()) {
+            vector<Edge>& es = to->second.incoming;
+            auto i = std::find_if(es.begin(), es.end(), [id, &e](const Edge& incoming) {
+                return incoming.id == id && incoming.type == e.type;
+            });
+            if(i != es.end()) {
+                es.erase(i);
+            }
+        }
+    }
+    v.outgoing.swap(members);
+
+    for(const string& key:v.unresolved) {
+        auto p = pending.find(key);
+        if(p != pending.end()) {
+            vector<ThingId>& sources = p->second;
+            sources.erase(std::remove(sources.begin(), sources.end(), id), sources.end());
+            if(sources.empty()) {
+                pending.erase(p);
+            }
+        }
+    }
+    v.unresolved.clear();
+}
+
+void RelationshipGraph::unlinkIncoming(ThingId id, Vertex& v)
+{
+    if(v.key.empty()) {
+        return;
+    }
+
+    vector<Edge> remaining{};
+    for(const Edge& e:v.incoming) {
+        if(e.type != EdgeType::LINK) {
+            remaining.push_back(e);
+            continue;
+        }
+        auto from = vertices.find(e.id);
+        if(from != vertices.end()) {
+            vector<Edge>& es = from->second.outgoing;
+            auto i = std::find_if(es.begin(), es.end(), [id](const Edge& outgoing) {
+                return outgoing.id == id && outgoing.type == EdgeType::LINK;
+            });
+            if(i != es.end()) {
+                es.erase(i);
+            }
+            from->second.unresolved.push_back(v.key);
+            pending[v.key].push_back(e.id);
+        }
+    }
+    v.incoming.swap(remaining);
+}
+
+void RelationshipGraph::removeVertex(ThingId id)
+{
+    auto i = vertices.find(id);
+    if(i == vertices.end()) {
+        return;
+    }
+
+    Vertex& v = i->second;
+    clearOutgoing(id, v);
+    unlinkIncoming(id, v);
+    for(const Edge& e:v.incoming) {
+        auto from = vertices.find(e.id);
+        if(from != vertices.end()) {
+            vector<Edge>& es = from->second.outgoing;
+            es.erase(std::remove_if(es.begin(), es.end(), [id](const Edge& outgoing) {
+                return outgoing.id == id;
+            }), es.end());
+        }
+    }
+    vector<ThingId> members{};
+    for(const Edge& e:v.outgoing) {
+        members.push_back(e.id);
+    }
+    auto k = keys.find(v.key);
+    if(k != keys.end() && k->second == id) {
+        keys.erase(k);
+    }
+    vertices.erase(i);
+
+    for(ThingId m:members) {
+        removeVertex(m);
+    }
+}
+
+/*
+ * Queries
+ */
+
+const vector<RelationshipGraph::Edge>& RelationshipGraph::getOutgoing(const Thing* thing) const
+{
+    static const vector<Edge> NO_EDGES{};
+
+    const Vertex* v = find(thing);
+    return v? v->outgoing: NO_EDGES;
+}
+
+const vector<RelationshipGraph::Edge>& RelationshipGraph::getIncoming(const Thing* thing) const
+{
+    static const vector<Edge> NO_EDGES{};
+
+    const Vertex* v = find(thing);
+    return v? v->incoming: NO_EDGES;
+}
+
+const vector<string>& RelationshipGraph::getUnresolved(const Thing* thing) const
+{
+    static const vector<string> NO_KEYS{};
+
+    const Vertex* v = find(thing);
+    return v? v->unresolved: NO_KEYS;
+}
+
+void RelationshipGraph::getNeighbours(
+    const Thing* thing,
+    EdgeType edgeType,
+    ThingType thingType,
+    bool outgoing,
+    vector<Thing*>& neighbours) const
+{
+    for(const Edge& e:(outgoing? getOutgoing(thing): getIncoming(thing))) {
+        if(e.type == edgeType && e.thingType == thingType) {
+            neighbours.push_back(e.thing);
+        }
+    }
+}
+
+void RelationshipGraph::expand(
+    const Thing* thing,
+    unsigned hops,
+    size_t limit,
+    vector<Thing*>& result,
+    bool includeMembers) const
+{
+    const Vertex* start = find(thing);
+    if(!start) {
+        return;
+    }
+
+    // Tags are not traversed - they would connect (almost) everything
+    unordered_set<ThingId> visited{thing->getId()};
+    vector<const Vertex*> frontier{start};
+    vector<const Vertex*> next{};
+    for(unsigned hop=0; hop<hops && !frontier.empty(); hop++) {
+        for(const Vertex* v:frontier) {
+            for(const vector<Edge>* es:{&v->outgoing, &v->incoming}) {
+                for(const Edge& e:*es) {
+                    if(e.type == EdgeType::TAG || (e.type == EdgeType::MEMBER && !includeMembers)) {
+                        continue;
+                    }
+                    if(visited.insert(e.id).second) {
+                        if(result.size() >= limit) {
+                            return;
+                        }
+                        result.push_back(e.thing);
+                        next.push_back(&vertices.at(e.id));
+                    }
+                }
+            }
+        }
+        frontier.swap(next);
+        next.clear();
+    }
+}
+
+size_t RelationshipGraph::getEdgesCount() const
+{
+    size_t count = 0;
+    for(const auto& v:vertices) {
+        count += v.second.outgoing.size();
+    }
+    return count;
+}
+
+size_t RelationshipGraph::getUnresolvedCount() const
+{
+    size_t count = 0;
+    for(const auto& p:pending) {
+        count += p.second.size();
+    }
+    return count;
+}
+
+/*
+ * Links
+ */
+
+void RelationshipGraph::parseLinks(const vector<string*>& lines, vector<string>& urls)
+{
+    for(const string* line:lines) {
+        if(!line) {
+            continue;
+        }
+        size_t offset = 0;
+        while((offset = line->find("](", offset)) != string::npos) {
+            size_t begin = offset + 2;
+            size_t end = line->find(')', begin);
+            if(end == string::npos) {
+                break;
+            }
+            string url = line->substr(begin, end-begin);
+            // [label](url "title") and [label](<url>)
+            size_t space = url.find(' ');
+            if(space != string::npos) {
+                url.erase(space);
+            }
+            if(url.size() > 1 && url.front() == '<' && url.back() == '>') {
+                url = url.substr(1, url.size()-2);
+            }
+            if(!url.empty()) {
+                urls.push_back(url);
+            }
+            offset = end;
+        }
+    }
+}
+
+bool RelationshipGraph::linkToKey(const string& outlineKey, const string& url, string& key)
+{
+    if(url.find("://") != string::npos || stringStartsWith(url, "mailto:")) {
+        return false;
+    }
+
+    string path{}, fragment{};
+    size_t hash = url.find('#');
+    if(hash == string::npos) {
+        path = url;
+    } else {
+        path = url.substr(0, hash);
+        fragment = url.substr(hash+1);
+    }
+
+    // %20 ~ space, ...
+    string decoded{};
+    for(size_t i=0; i<path.size(); i++) {
+        if(path[i] == '%' && i+2 < path.size() && isxdigit(path[i+1]) && isxdigit(path[i+2])) {
+            decoded += static_cast<char>(stoi(path.substr(i+1, 2), nullptr, 16));
+            i += 2;
+        } else {
+            decoded += path[i];
+        }
+    }
+
+    if(decoded.empty()) {
+        key = outlineKey;
+    } else {
+        if(!stringEndsWith(decoded, ".md")) {
+            return false;
+        }
+        string absolute{};
+        if(decoded[0] != '/' && decoded[0] != FILE_PATH_SEPARATOR[0]) {
+            string directory{}, file{};
+            pathToDirectoryAndFile(outlineKey, directory, file);
+            absolute = directory + FILE_PATH_SEPARATOR + decoded;
+        } else {
+            absolute = decoded;
+        }
+
+        // lexical normalization (file doesn't have to exist): a/./b/../c ~ a/c
+        vector<string> segments{};
+        string segment{};
+        for(size_t i=0; i<=absolute.size(); i++) {
+            if(i == absolute.size() || absolute[i] == '/' || absolute[i] == FILE_PATH_SEPARATOR[0]) {
+                if(segment == "..") {
+                    if(!segments.empty()) {
+                        segments.pop_back();
+                    }
+                } else if(!segment.empty() && segment != ".") {
+                    segments.push_back(segment);
+                }
+                segment.clear();
+            } else {
+                segment += absolute[i];
+            }
+        }
+        key.clear();
+        for(const string& s:segments) {
+            if(!key.empty() || absolute[0] == '/' || absolute[0] == FILE_PATH_SEPARATOR[0]) {
+                key += FILE_PATH_SEPARATOR;
+            }
+            key += s;
+        }
+    }
+
+    if(!fragment.empty()) {
+        key += "#";
+        string lowerFragment{};
+        stringToLower(fragment, lowerFragment);
+        key += lowerFragment;
+    }
+
+    return true;
+}
+
+} // m8r namespace
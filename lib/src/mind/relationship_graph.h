@@ -0,0 +1,180 @@
+/*
+ relationship_graph.h     MindForger thinking notebook
+
+ Copyright (C) 2016-2025 Martin Dvorak <martin.dvorak@mindforger.com>
+
+ This program is free software; you can redistribute it and/or
+ modify it under the terms of the GNU General Public License
+ as published by the Free Software Foundation; either version 2
+ of the License, or (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+#ifndef M8R_RELATIONSHIP_GRAPH_H
+#define M8R_RELATIONSHIP_GRAPH_H
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "../model/outline.h"
+#include "../model/note.h"
+#include "../model/tag.h"
+
+namespace m8r {
+
+/**
+ * @brief Graph of Outlines, Notes and Tags w/ forward and backward adjacency.
+ *
+ * Vertices are Os, Ns and Tags (keyed by ThingId), edges are:
+ *
+ *   LINK   ... O/N links O/N using Markdown link (description or metadata)
+ *   TAG    ... O/N is tagged by Tag
+ *   MEMBER ... O contains N
+ *
+ * Every vertex keeps outgoing and incoming edge lists (hashed adjacency lists)
+ * so that neighbours and backlinks are O(degree). Links whose target doesn't
+ * exist (yet) are kept as unresolved and they are resolved once O/N w/ given key
+ * is indexed e.g. created or renamed.
+ *
+ * Graph is updated incrementally per O: only Ns whose revision, modification
+ * time or key changed are re-scanned. Graph doesn't own Things - it must be updated
+ * (or cleared) whenever indexed O or N is deleted.
+ */
+class RelationshipGraph
+{
+public:
+    enum class EdgeType : u_int8_t {
+        LINK,
+        TAG,
+        MEMBER
+    };
+
+    enum class ThingType : u_int8_t {
+        OUTLINE,
+        NOTE,
+        TAG
+    };
+
+    /**
+     * @brief Edge to the other vertex.
+     */
+    struct Edge {
+        Thing* thing;
+        ThingId id;
+        EdgeType type;
+        ThingType thingType;
+    };
+
+private:
+    struct Vertex {
+        Thing* thing;
+        ThingType type;
+        // O/N key used to resolve links
+        std::string key;
+        // change detection
+        u_int32_t revision;
+        time_t modified;
+
+        std::vector<Edge> outgoing;
+        std::vector<Edge> incoming;
+        // keys of link targets which are not indexed
+        std::vector<std::string> unresolved;
+    };
+
+    std::unordered_map<ThingId,Vertex> vertices;
+    // O/N key -> vertex
+    std::unordered_map<std::string,ThingId> keys;
+    // unresolved link target key -> linking vertices
+    std::unordered_map<std::string,std::vector<ThingId>> pending;
+
+    bool built;
+
+public:
+    explicit RelationshipGraph();
+    RelationshipGraph(const RelationshipGraph&) = delete;
+    RelationshipGraph(const RelationshipGraph&&) = delete;
+    RelationshipGraph& operator=(const RelationshipGraph&) = delete;
+    RelationshipGraph& operator=(const RelationshipGraph&&) = delete;
+    ~RelationshipGraph();
+
+    /**
+     * @brief Index all Os and their Ns.
+     */
+    void build(const std::vector<Outline*>& outlines);
+    bool isBuilt() const { return built; }
+    void clear();
+
+    /**
+     * @brief Index new or modified O and its Ns - Ns which are no longer O members are removed.
+     */
+    void update(Outline* outline);
+    /**
+     * @brief Remove O and its Ns e.g. when O is forgotten.
+     */
+    void remove(Outline* outline);
+
+    const std::vector<Edge>& getOutgoing(const Thing* thing) const;
+    const std::vector<Edge>& getIncoming(const Thing* thing) const;
+    /**
+     * @brief Get neighbours of given type reachable using edges of given type.
+     */
+    void getNeighbours(
+        const Thing* thing,
+        EdgeType edgeType,
+        ThingType thingType,
+        bool outgoing,
+        std::vector<Thing*>& neighbours) const;
+    /**
+     * @brief Breadth first expansion (both directions) up to hops from thing w/ at most limit Things.
+     */
+    void expand(
+        const Thing* thing,
+        unsigned hops,
+        size_t limit,
+        std::vector<Thing*>& result,
+        bool includeMembers=true) const;
+    const std::vector<std::string>& getUnresolved(const Thing* thing) const;
+
+    size_t getVerticesCount() const { return vertices.size(); }
+    size_t getEdgesCount() const;
+    size_t getUnresolvedCount() const;
+
+    /**
+     * @brief Resolve Markdown link URL in O to O/N key.
+     *
+     * @return false if the URL doesn't point to O/N e.g. it's web or image link.
+     */
+    static bool linkToKey(const std::string& outlineKey, const std::string& url, std::string& key);
+    /**
+     * @brief Get URLs of Markdown links (inline links) in the text.
+     */
+    static void parseLinks(const std::vector<std::string*>& lines, std::vector<std::string>& urls);
+
+private:
+    Vertex& vertex(Thing* thing, ThingType type);
+    const Vertex* find(const Thing* thing) const;
+    void setKey(Vertex& v, ThingId id, const std::string& key);
+    void index(
+        ThingId id,
+        Vertex& v,
+        const std::string& outlineKey,
+        const std::vector<std::string*>& description,
+        const LinkVector& links,
+        const TagVector* tags);
+    void addEdge(ThingId fromId, Vertex& from, ThingId toId, Vertex& to, EdgeType type);
+    void addLink(ThingId id, Vertex& v, const std::string& key);
+    void clearOutgoing(ThingId id, Vertex& v);
+    void unlinkIncoming(ThingId id, Vertex& v);
+    void removeVertex(ThingId id);
+};
+
+} // m8r namespace
+
+#endif // M8R_RELATIONSHIP_GRAPH_H
@@ -0,0 +1,95 @@
+/*
+ tags_cardinality.cpp     MindForger thinking notebook
+
+ Copyright (C) 2016-2025 Martin Dvorak <martin.dvorak@mindforger.com>
+
+ This program is free software; you can redistribute it and/or
+ modify it under the terms of the GNU General Public License
+ as published by the Free Software Foundation; either version 2
+ of the License, or (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+#include "tags_cardinality.h"
+
+using namespace std;
+
+namespace m8r {
+
+TagsCardinality::TagsCardinality()
+    : occurrences{},
+      cardinality{}
+{
+}
+
+TagsCardinality::~TagsCardinality()
+{
+}
+
+void TagsCardinality::build(const vector<Outline*>& outlines)
+{
+    clear();
+    for(Outline* o:outlines) {
+        update(o);
+    }
+}
+
+void TagsCardinality::clear()
+{
+    occurrences.clear();
+    cardinality.clear();
+}
+
+void TagsCardinality::update(Outline* outline)
+{
+    Occurrences& o = occurrences[outline->getId()];
+    count(o, -1);
+
+    o.outlineTags.assign(outline->getTags()->begin(), outline->getTags()->end());
+    o.noteTags.clear();
+    for(Note* n:outline->getNotes()) {
+        o.noteTags.insert(o.noteTags.end(), n->getTags()->begin(), n->getTags()->end());
+    }
+    count(o, 1);
+}
+
+void TagsCardinality::remove(const Outline* outline)
+{
+    auto o = occurrences.find(outline->getId());
+    if(o != occurrences.end()) {
+        count(o->second, -1);
+        occurrences.erase(o);
+    }
+}
+
+void TagsCardinality::count(const Occurrences& o, int delta)
+{
+    for(const Tag* t:o.outlineTags) {
+        Cardinality& c = cardinality[t];
+        c.outlines += delta;
+    }
+    for(const Tag* t:o.noteTags) {
+        Cardinality& c = cardinality[t];
+        c.notes += delta;
+    }
+}
+
+unsigned TagsCardinality::getOutlinesCount(const Tag* tag) const
+{
+    auto c = cardinality.find(tag);
+    return c == cardinality.end()? 0: c->second.outlines;
+}
+
+unsigned TagsCardinality::getNotesCount(const Tag* tag) const
+{
+    auto c = cardinality.find(tag);
+    return c == cardinality.end()? 0: c->second.notes;
+}
+
+} // m8r namespace
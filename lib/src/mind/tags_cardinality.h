@@ -0,0 +1,84 @@
+/*
+ tags_cardinality.h     MindForger thinking notebook
+
+ Copyright (C) 2016-2025 Martin Dvorak <martin.dvorak@mindforger.com>
+
+ This program is free software; you can redistribute it and/or
+ modify it under the terms of the GNU General Public License
+ as published by the Free Software Foundation; either version 2
+ of the License, or (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+#ifndef M8R_TAGS_CARDINALITY_H
+#define M8R_TAGS_CARDINALITY_H
+
+#include <unordered_map>
+#include <vector>
+
+#include "../model/outline.h"
+#include "../model/tag.h"
+
+namespace m8r {
+
+/**
+ * @brief Number of Os and Ns tagged by every tag.
+ *
+ * Counters are maintained incrementally per O: tags of O and its Ns are
+ * remembered so that O update subtracts previous occurrences and adds current
+ * ones - cardinality of any tag is O(1) and all tags are O(#tags).
+ */
+class TagsCardinality
+{
+public:
+    struct Cardinality {
+        unsigned outlines;
+        unsigned notes;
+    };
+
+private:
+    struct Occurrences {
+        std::vector<const Tag*> outlineTags;
+        std::vector<const Tag*> noteTags;
+    };
+
+    std::unordered_map<ThingId,Occurrences> occurrences;
+    std::unordered_map<const Tag*,Cardinality> cardinality;
+
+public:
+    explicit TagsCardinality();
+    TagsCardinality(const TagsCardinality&) = delete;
+    TagsCardinality(const TagsCardinality&&) = delete;
+    TagsCardinality& operator=(const TagsCardinality&) = delete;
+    TagsCardinality& operator=(const TagsCardinality&&) = delete;
+    ~TagsCardinality();
+
+    void build(const std::vector<Outline*>& outlines);
+    void clear();
+    /**
+     * @brief Count tags of new or modified O and its Ns.
+     */
+    void update(Outline* outline);
+    /**
+     * @brief Stop counting tags of O and its Ns e.g. when O is forgotten.
+     */
+    void remove(const Outline* outline);
+
+    unsigned getOutlinesCount(const Tag* tag) const;
+    unsigned getNotesCount(const Tag* tag) const;
+    unsigned getCount(const Tag* tag) const { return getOutlinesCount(tag) + getNotesCount(tag); }
+    const std::unordered_map<const Tag*,Cardinality>& getCardinality() const { return cardinality; }
+
+private:
+    void count(const Occurrences& o, int delta);
+};
+
+} // m8r namespace
+
+#endif // M8R_TAGS_CARDINALITY_H
@@ -24,7 +24,7 @@ namespace m8r {
 
 string EisenhowerMatrix::createEisenhowerMatrixKey() {
     return Organizer::createOrganizerKey(
-        set<string>{}, "repository", Thing::getNextKey(), "/", "eisehnower-matrix"
+        set<string>{}, "repository", std::to_string(Thing::getNextId()), "/", "eisehnower-matrix"
     );
 }
 
@@ -32,8 +32,8 @@ EisenhowerMatrix::EisenhowerMatrix(const std::string& name)
     : Organizer{name, Organizer::OrganizerType::EISENHOWER_MATRIX},
       sortBy{EisenhowerMatrix::SortBy::IMPORTANCE}
 {
-    if(!this->name.length()) {
-        this->name = "Eisenhower Matrix";
+    if(name.empty()) {
+        setName("Eisenhower Matrix");
     }
 }
 
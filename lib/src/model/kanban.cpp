@@ -25,7 +25,7 @@ namespace m8r {
 string Kanban::createKanbanKey()
 {
     return Organizer::createOrganizerKey(
-        set<string>{}, "repository", Thing::getNextKey(), "/", "kanban"
+        set<string>{}, "repository", std::to_string(Thing::getNextId()), "/", "kanban"
     );
 }
 
@@ -33,8 +33,8 @@ Kanban::Kanban(const std::string& name)
     : Organizer{name, Organizer::OrganizerType::KANBAN},
       columnTags{}
 {
-    if(!this->name.length()) {
-        this->name = "Kanban";
+    if(name.empty()) {
+        setName("Kanban");
     }
 
     initColumnTags();
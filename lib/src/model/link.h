@@ -21,6 +21,8 @@
 
 #include <string>
 
+#include "../gear/small_vector.h"
+
 namespace m8r {
 
 /**
@@ -50,5 +52,10 @@ public:
     std::string& getUrl() { return url; }
 };
 
+/**
+ * @brief Links of an Outline or Note - typically none or just one.
+ */
+typedef SmallVector<Link*, 1> LinkVector;
+
 }
 #endif // M8R_LINK_H
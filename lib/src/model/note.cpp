@@ -25,27 +25,25 @@ namespace m8r {
 Note::Note(const NoteType* type, Outline* outline)
     : ThingInTime{},
       outline(outline),
-      flags{},
-      depth{},
-      tags{},
-      links{},
       type{type},
       description{},
-      modifiedPretty{},
+      tags{},
+      links{},
+      deadline{},
+      flags{},
       revision{},
-      readPretty{},
       reads{},
-      progress{},
-      deadline{},
-      aiAaMatrixIndex{}
+      aiAaMatrixIndex{},
+      depth{},
+      progress{}
 {
 }
 
 Note::Note(const Note& n)
     : Note{n.type, nullptr}
 {
-    name = n.name;
-    autolinkName();
+    setName(n.getName());
+    n.loadDescription();
     if(n.description.size()) {
         for(string* s:n.description) {
             description.push_back(new string(*s));
@@ -63,9 +61,7 @@ Note::Note(const Note& n)
     // share old N's similarity assessment
     aiAaMatrixIndex = n.aiAaMatrixIndex;
 
-    if(n.tags.size()) {
-        tags.insert(tags.end(), n.tags.begin(), n.tags.end());
-    }
+    tags = n.tags;
 
     if(n.links.size()) {
         for(Link* l:n.links) {
@@ -88,7 +84,7 @@ Note::~Note()
 
 string Note::getMangledName() const
 {
-    string result = name;
+    string result = *name;
     if(result.size()) {
         // non-alpha or non-num to -
         for(size_t i=0; i<result.size(); i++) {
@@ -137,7 +133,6 @@ void Note::setDepth(u_int16_t depth)
 void Note::makeModified()
 {
     setModified();
-    setModifiedPretty();
     incRevision();
 
     if(outline) outline->makeModified();
@@ -151,38 +146,16 @@ void Note::setModified()
 void Note::setModified(time_t modified)
 {
     ThingInTime::setModified(modified);
-
-    setModifiedPretty();
-}
-
-const string& Note::getModifiedPretty() const
-{
-    return modifiedPretty;
-}
-
-void Note::setModifiedPretty()
-{
-    this->modifiedPretty = datetimeToPrettyHtml(modified);
-}
-
-void Note::setModifiedPretty(const string& modifiedPretty)
-{
-    this->modifiedPretty = modifiedPretty;
 }
 
-const string& Note::getReadPretty() const
+string Note::getModifiedPretty() const
 {
-    return readPretty;
+    return datetimeToPrettyHtml(modified);
 }
 
-void Note::setReadPretty()
+string Note::getReadPretty() const
 {
-    this->readPretty = datetimeToPrettyHtml(read);
-}
-
-void Note::setReadPretty(const string& readPretty)
-{
-    this->readPretty = readPretty;
+    return datetimeToPrettyHtml(read);
 }
 
 u_int8_t Note::getProgress() const
@@ -203,7 +176,6 @@ time_t Note::getRead() const
 void Note::setRead(time_t read)
 {
     this->read = read;
-    setReadPretty();
 }
 
 void Note::makeRead()
@@ -245,7 +217,7 @@ const Tag* Note::getPrimaryTag() const
     }
 }
 
-const vector<const Tag*>* Note::getTags() const
+const TagVector* Note::getTags() const
 {
     return &tags;
 }
@@ -276,8 +248,7 @@ void Note::setTags(const vector<const Tag*>* tags)
 }
 
 void Note::addName(const string& s) {
-    name += s;
-    autolinkName();
+    setName(*name + s);
 }
 
 const NoteType* Note::getType() const
@@ -290,14 +261,24 @@ void Note::clear()
     description.clear();
 }
 
+void Note::loadDescription() const
+{
+    // O descriptor N shares O's description which is always in memory
+    if(outline && !outline->isBodiesResident() && !Outline::isOutlineDescriptorNoteType(type)) {
+        outline->loadBodies();
+    }
+}
+
 const vector<string*>& Note::getDescription() const
 {
+    loadDescription();
     return description;
 }
 
 string Note::getDescriptionAsString(const std::string& separator) const
 {
     // IMPROVE cache narrowed description for performance & return it by reference
+    loadDescription();
     string result{};
     if(description.size()) {
         for(string *s:description) {
@@ -310,11 +291,13 @@ string Note::getDescriptionAsString(const std::string& separator) const
 
 void Note::setDescription(const vector<string*>& description)
 {
+    loadDescription();
     this->description = description;
 }
 
 void Note::moveDescription(std::vector<std::string*>& target)
 {
+    loadDescription();
     if(description.size()) {
         // IMPROVE find a more efficient method - perhaps an algorithm function
         for(auto& s:description) {
@@ -326,12 +309,14 @@ void Note::moveDescription(std::vector<std::string*>& target)
 
 void Note::clearDescription()
 {
+    loadDescription();
     this->description.clear();
 }
 
 void Note::addDescription(const vector<string*>& d)
 {
     // IMPROVE why not description.push_back(d);
+    loadDescription();
     description.insert(description.end(),d.begin(),d.end());
 }
 
@@ -342,6 +327,8 @@ Outline* Note::getOutline() const
 
 void Note::setOutline(Outline* outline)
 {
+    // description can be loaded only from the file of the current O
+    loadDescription();
     this->outline = outline;
 }
 
@@ -357,6 +344,7 @@ string& Note::getOutlineKey() const
 void Note::addDescriptionLine(string *line)
 {
     if(line) {
+        loadDescription();
         description.push_back(line);
     }
 }
@@ -417,12 +405,12 @@ void Note::completeProperties(const time_t outlineModificationTime)
         reads = revision;
     }
 
+    loadDescription();
     if(description.empty()) {
         description.push_back(new string{""});
     }
 
     checkAndFixProperties();
-    setModifiedPretty();
 }
 
 void Note::checkAndFixProperties()
@@ -437,17 +425,16 @@ void Note::checkAndFixProperties()
         created = modified;
     }
 
-    if(name.empty()) {
-        name.assign("Note");
-        autolinkName();
+    if(name->empty()) {
+        setName("Note");
     }
 
-    MF_ASSERT_FUTURE_TIMESTAMPS(created, read, modified, outline->getKey() << " # " << name, name);
+    MF_ASSERT_FUTURE_TIMESTAMPS(created, read, modified, outline->getKey() << " # " << *name, *name);
 }
 
-string& Note::getKey()
+string Note::getKey() const
 {
-    key.clear();
+    string key{};
     key.append(outline->getKey());
     key.append("#");
     key.append(getMangledName());
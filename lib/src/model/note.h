@@ -33,6 +33,7 @@
 namespace m8r {
 
 class Outline;
+class LazyOutlineBodies;
 
 // Outline key - resolved O path which may change if the repository is moved
 constexpr const auto LINK_NAME_OUTLINE_KEY = "Outline key";
@@ -52,40 +53,45 @@ constexpr const auto LINK_NAME_OUTLINE_PATH = "Outline path";
  */
 class Note : public ThingInTime
 {
+    // lazy memory moves descriptions w/o loading them
+    friend class LazyOutlineBodies;
+
 private:
     static constexpr int FLAG_MASK_POST_DECLARED_SECTION = 1;
     static constexpr int FLAG_MASK_TRAILING_HASHES_SECTION = 1<<1;
 
 private:
+    /*
+     * Fields are ordered by alignment to avoid padding.
+     */
+
     // parent outline - might be changed on refactoring
     Outline* outline;
 
-    // various format, structure, semantic, ... flags (bit)
-    int flags;
-
-    // [0,inf)
-    u_int16_t depth;
-
-    // IMPROVE hashset
-    std::vector<const Tag*> tags;
-    std::vector<Link*> links;
     const NoteType* type;
     std::vector<std::string*> description;
+    TagVector tags;
+    LinkVector links;
+
+    time_t deadline;
+
+    // various format, structure, semantic, ... flags (bit)
+    int flags;
 
-    std::string modifiedPretty;
     u_int32_t revision;
-    std::string readPretty;
     u_int32_t reads;
 
-    u_int8_t progress;
-    time_t deadline;
-
     /*
      * Transient fields
      */
 
     int aiAaMatrixIndex;
 
+    // [0,inf)
+    u_int16_t depth;
+
+    u_int8_t progress;
+
 public:
     Note() = delete;
     explicit Note(const NoteType* type, Outline* outline);
@@ -99,7 +105,10 @@ public:
     void completeProperties(const time_t outlineModificationTime);
     void checkAndFixProperties();
 
-    virtual std::string& getKey() override;
+    /**
+     * @brief Get N key i.e. O key and mangled N name (composed on demand).
+     */
+    std::string getKey() const;
 
     /**
      * @brief Return GitHub compatible mangled name to ensure compatiblity between GitHub and MindForger # links.
@@ -114,18 +123,17 @@ public:
     virtual void setModified() override;
     virtual void setModified(time_t modified) override;
     void makeModified();
-    const std::string& getModifiedPretty() const;
-    void setModifiedPretty();
-    void setModifiedPretty(const std::string& modifiedPretty);
+    /**
+     * @brief Render modification time for UI on demand (not stored in N).
+     */
+    std::string getModifiedPretty() const;
     std::string& getOutlineKey() const;
     u_int8_t getProgress() const;
     void setProgress(u_int8_t progress);
     time_t getRead() const;
     void setRead(time_t read);
     void makeRead();
-    const std::string& getReadPretty() const;
-    void setReadPretty();
-    void setReadPretty(const std::string& readPretty);
+    std::string getReadPretty() const;
     u_int32_t getReads() const;
     void setReads(u_int32_t reads);
     u_int32_t getRevision() const;
@@ -133,10 +141,11 @@ public:
     void incRevision();
     void incReads() { reads++; }
     const Tag* getPrimaryTag() const;
-    const std::vector<const Tag*>* getTags() const;
+    const TagVector* getTags() const;
     void addTag(const Tag* tag);
     void setTag(const Tag* tag);
     void setTags(const std::vector<const Tag*>* tags);
+    void setTags(const TagVector& tags) { this->tags = tags; }
     bool hasTag(const Tag* tag) const {
         if(std::find(tags.begin(), tags.end(), tag) == tags.end()) {
             return false;
@@ -165,7 +174,7 @@ public:
     void setOutline(Outline* outline);
 
     void addLink(Link* link);
-    const std::vector<Link*>& getLinks() const { return links; }
+    const LinkVector& getLinks() const { return links; }
     Link* getLinkByName(const std::string& name) const;
     size_t getLinksCount() const { return links.size(); }
     void clearLinks() {
@@ -187,6 +196,12 @@ public:
 
     int getAiAaMatrixIndex() const { return aiAaMatrixIndex; }
     void setAiAaMatrixIndex(int i) { aiAaMatrixIndex = i; }
+
+private:
+    /**
+     * @brief Ensure description is in memory - it might be unloaded by lazy memory.
+     */
+    void loadDescription() const;
 };
 
 } // m8r namespace
@@ -44,6 +44,7 @@ std::string Organizer::createOrganizerKey(
 
 Organizer::Organizer(const std::string& name, OrganizerType organizerType)
     : Thing{name},
+      key{},
       quadrantTags{},
       organizerType{organizerType},
       filterBy{Organizer::FilterBy::OUTLINES_NOTES},
@@ -54,6 +55,7 @@ Organizer::Organizer(const std::string& name, OrganizerType organizerType)
 
 Organizer::Organizer(const Organizer& o)
     : Thing{o.getName()},
+      key{},
       quadrantTags{},
       organizerType{o.organizerType},
       filterBy{o.getFilterBy()},
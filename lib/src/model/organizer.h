@@ -61,6 +61,8 @@ public:
     );
 
 private:
+    std::string key;
+
     std::vector<std::reference_wrapper<std::set<std::string>>> quadrantTags;
 
 public:
@@ -115,6 +117,7 @@ public:
     std::set<std::string>& getStringTagsForQuadrant(unsigned column);
     std::vector<const Tag*> getTagsForQuadrant(unsigned column, Ontology& ontology);
 
+    std::string& getKey() { return key; }
     void setKey(const std::string& key) { this->key = key; }
 
     std::set<std::string>& getUpperRightTags() {
@@ -62,6 +62,7 @@ void Outline::sortByRead(vector<Note*>& ns)
 Outline::Outline(const OutlineType* type)
     : ThingInTime{},
       memoryLocation(OutlineMemoryLocation::NORMAL),
+      key{std::to_string(id)},
       flags{},
       format(MarkdownDocument::Format::MINDFORGER),
       preamble{},
@@ -69,7 +70,6 @@ Outline::Outline(const OutlineType* type)
       links{},
       type{type},
       description{},
-      modifiedPretty{},
       revision{},
       reads{},
       importance{},
@@ -80,11 +80,17 @@ Outline::Outline(const OutlineType* type)
       bytesize{},
       dirty{false},
       readOnly{false},
-      timeScope{}
+      timeScope{},
+      bodiesLoader{nullptr},
+      bodiesResident{true}
 {
 }
 
 Outline::~Outline() {
+    if(bodiesLoader) {
+        bodiesLoader->detach(this);
+    }
+
     for(string* d:description) {
         delete d;
     }
@@ -112,7 +118,6 @@ void Outline::resetClonedOutline(Outline* o)
     o->setModified();
     o->setCreated(modified);
     o->setRead(modified);
-    o->setModifiedPretty();
     o->completeProperties(modified);
     o->outlineDescriptorAsNote = nullptr;
 }
@@ -120,6 +125,7 @@ void Outline::resetClonedOutline(Outline* o)
 Outline::Outline(const Outline& o)
     : ThingInTime{},
       memoryLocation(OutlineMemoryLocation::NORMAL),
+      key{},
       flags{},
       format(o.format),
       preamble{},
@@ -127,7 +133,6 @@ Outline::Outline(const Outline& o)
       links{},
       type{o.type},
       description{},
-      modifiedPretty{},
       revision{},
       reads{},
       importance{},
@@ -138,13 +143,12 @@ Outline::Outline(const Outline& o)
       bytesize{},
       dirty{},
       readOnly{},
-      timeScope{}
+      timeScope{},
+      bodiesLoader{nullptr},
+      bodiesResident{true}
 {
-    key.clear();
-
     // IMPROVE i18n
-    name = "Copy of " + o.name;
-    autolinkName();
+    setName("Copy of " + o.getName());
     if(o.description.size()) {
         for(string* s:o.description) {
             description.push_back(new string(*s));
@@ -176,9 +180,7 @@ Outline::Outline(const Outline& o)
     progress = o.progress;
     bytesize = o.bytesize;
 
-    if(o.tags.size()) {
-        tags.insert(tags.end(), o.tags.begin(), o.tags.end());
-    }
+    tags = o.tags;
 
     outlineDescriptorAsNote = new Note(&NOTE_4_OUTLINE_TYPE, this);
 
@@ -236,13 +238,10 @@ void Outline::completeProperties(const time_t fileModificationTime)
     if(notes.size()) {
         for(Note* n:notes) {
             n->completeProperties(modified);
-            n->setModifiedPretty();
-            n->setReadPretty();
         }
     }
 
     checkAndFixProperties();
-    setModifiedPretty();
 }
 
 void Outline::checkAndFixProperties()
@@ -262,7 +261,6 @@ void Outline::checkAndFixProperties()
 
     if(latestNote > modified) {
         modified = latestNote;
-        setModifiedPretty();
     }
     if(revision > reads) {
         reads = revision;
@@ -274,18 +272,17 @@ void Outline::checkAndFixProperties()
         created = modified;
     }
 
-    if(name.empty()) {
-        name.assign("Outline");
-        autolinkName();
+    if(name->empty()) {
+        setName("Outline");
     }
 
-    MF_ASSERT_FUTURE_TIMESTAMPS(created, read, modified, getKey(), name);
+    MF_ASSERT_FUTURE_TIMESTAMPS(created, read, modified, getKey(), *name);
 }
 
 bool Outline::isVirgin() const
 {
     if(notes.empty() &&
-       !name.compare("Outline") &&
+       !name->compare("Outline") &&
        importance==0 &&
        urgency==0 &&
        progress==0
@@ -302,7 +299,6 @@ void Outline::notifyChange(Note* note)
     revision++;
 
     note->setModified(modified);
-    note->setModifiedPretty(datetimeToPrettyHtml(modified));
     note->incRevision();
 }
 
@@ -335,7 +331,7 @@ const Tag* Outline::getPrimaryTag() const
     }
 }
 
-const vector<const Tag*>* Outline::getTags() const
+const TagVector* Outline::getTags() const
 {
     return &tags;
 }
@@ -359,23 +355,12 @@ void Outline::setTag(const Tag* tag)
 void Outline::makeModified()
 {
     setModified();
-    setModifiedPretty();
     incRevision();
 }
 
-const string& Outline::getModifiedPretty() const
-{
-    return modifiedPretty;
-}
-
-void Outline::setModifiedPretty()
-{
-    this->modifiedPretty = datetimeToPrettyHtml(modified);
-}
-
-void Outline::setModifiedPretty(const string& modifiedPretty)
+string Outline::getModifiedPretty() const
 {
-    this->modifiedPretty = modifiedPretty;
+    return datetimeToPrettyHtml(modified);
 }
 
 const vector<Note*>& Outline::getNotes() const
@@ -501,7 +486,6 @@ void Outline::resetClonedNote(Note* n)
     n->setModified();
     n->setModified(n->getModified());
     n->setRead(n->getModified());
-    n->setModifiedPretty();
     n->completeProperties(n->getModified());
 }
 
@@ -1094,10 +1078,10 @@ void Outline::setMemoryLocation(OutlineMemoryLocation memoryLocation)
 
 Note* Outline::getOutlineDescriptorAsNote()
 {
-    outlineDescriptorAsNote->setName(name);
+    outlineDescriptorAsNote->setName(*name);
     outlineDescriptorAsNote->setDescription(description);
 
-    outlineDescriptorAsNote->setTags(&tags);
+    outlineDescriptorAsNote->setTags(tags);
 
     outlineDescriptorAsNote->setCreated(created);
     outlineDescriptorAsNote->setModified(modified);
@@ -19,6 +19,7 @@
 #ifndef M8R_OUTLINE_H_
 #define M8R_OUTLINE_H_
 
+#include <atomic>
 #include <string>
 #include <vector>
 
@@ -35,6 +36,7 @@
 namespace m8r {
 
 class Note;
+class Outline;
 
 enum class OutlineMemoryLocation {
     NORMAL,
@@ -42,6 +44,29 @@ enum class OutlineMemoryLocation {
     LIMBO
 };
 
+/**
+ * @brief Loader of Note descriptions (bodies) of lazily learned Outlines.
+ */
+class OutlineBodiesLoader
+{
+public:
+    virtual ~OutlineBodiesLoader() {}
+
+    /**
+     * @brief Materialize descriptions of O's Notes.
+     */
+    virtual void load(Outline* outline) = 0;
+    /**
+     * @brief Stop tracking O - it's deleted or its bodies are kept in memory for good.
+     */
+    virtual void detach(Outline* outline) = 0;
+    /**
+     * @brief Load descriptions and keep them in memory until unpin() - pins are counted.
+     */
+    virtual void pin(Outline* outline) = 0;
+    virtual void unpin(Outline* outline) = 0;
+};
+
 /**
  * @brief Outline - a set of thoughts.
  *
@@ -114,6 +139,7 @@ private:
      * of associated repository, can be used as ID.
      */
     // IMPROVE make Key object w/ equals - std::string and sequence integer for fast equals
+    std::string key;
 
     // various format, structure, semantic, ... flags (bit)
     int flags;
@@ -122,12 +148,11 @@ private:
 
     std::vector<std::string*> preamble;
     // IMPROVE hashset
-    std::vector<const Tag*> tags;
-    std::vector<Link*> links;
+    TagVector tags;
+    LinkVector links;
     const OutlineType* type;
     std::vector<std::string*> description;
 
-    std::string modifiedPretty;
     u_int32_t revision;
     u_int32_t reads;
 
@@ -165,6 +190,16 @@ private:
      */
     TimeScope timeScope;
 
+    /**
+     * @brief Lazy memory: loader of Ns descriptions or nullptr if O was not learned lazily.
+     */
+    OutlineBodiesLoader* bodiesLoader;
+
+    /**
+     * @brief Lazy memory: FALSE if Ns descriptions are not in memory and must be loaded.
+     */
+    std::atomic<bool> bodiesResident;
+
 public:
     Outline() = delete;
     explicit Outline(const OutlineType* type);
@@ -198,7 +233,7 @@ public:
      */
     bool isVirgin() const;
 
-    virtual std::string& getKey();
+    std::string& getKey();
     void setKey(const std::string key);
     MarkdownDocument::Format getFormat() const { return format; }
     void setFormat(MarkdownDocument::Format format) { this->format = format; }
@@ -214,7 +249,7 @@ public:
     int8_t getImportance() const;
     void setImportance(int8_t importance);
     const Tag* getPrimaryTag() const;
-    const std::vector<const Tag*>* getTags() const;
+    const TagVector* getTags() const;
     void setTag(const Tag* tag);
     void setTags(const std::vector<const Tag*>* tags);
     void addTag(const Tag* tag);
@@ -233,9 +268,10 @@ public:
         return Tag::hasTagStrings(this->tags, filterTags);
     }
     void makeModified();
-    const std::string& getModifiedPretty() const;
-    void setModifiedPretty();
-    void setModifiedPretty(const std::string& modifiedPretty);
+    /**
+     * @brief Render modification time for UI on demand (not stored in O).
+     */
+    std::string getModifiedPretty() const;
     int8_t getProgress() const;
     void setProgress(int8_t progress);
     u_int32_t getRevision() const;
@@ -339,12 +375,29 @@ public:
     bool isReadOnly() const { return readOnly; }
     void setReadOnly(bool readOnly) { this->readOnly = readOnly; }
 
+    /*
+     * Lazy memory
+     */
+
+    OutlineBodiesLoader* getBodiesLoader() const { return bodiesLoader; }
+    void setBodiesLoader(OutlineBodiesLoader* loader) { bodiesLoader = loader; }
+    bool isBodiesResident() const { return bodiesResident; }
+    void setBodiesResident(bool resident) { bodiesResident = resident; }
+    /**
+     * @brief Ensure that Ns descriptions are in memory.
+     */
+    void loadBodies() {
+        if(!bodiesResident && bodiesLoader) {
+            bodiesLoader->load(this);
+        }
+    }
+
     /*
      * Links
      */
 
     void addLink(Link* link);
-    const std::vector<Link*>& getLinks() const { return links; }
+    const LinkVector& getLinks() const { return links; }
     size_t getLinksCount() const { return links.size(); }
 
     /*
@@ -417,6 +470,30 @@ struct Outline::Patch {
 #endif
 };
 
+/**
+ * @brief Scoped pin of O's Notes descriptions for readers running in background tasks.
+ */
+class OutlineBodiesPin
+{
+private:
+    OutlineBodiesLoader* loader;
+    Outline* outline;
+
+public:
+    explicit OutlineBodiesPin(Outline* outline)
+        : loader(outline->getBodiesLoader()), outline(outline)
+    {
+        if(loader) loader->pin(outline);
+    }
+    OutlineBodiesPin(const OutlineBodiesPin&) = delete;
+    OutlineBodiesPin(const OutlineBodiesPin&&) = delete;
+    OutlineBodiesPin& operator =(const OutlineBodiesPin&) = delete;
+    OutlineBodiesPin& operator =(const OutlineBodiesPin&&) = delete;
+    ~OutlineBodiesPin() {
+        if(loader) loader->unpin(outline);
+    }
+};
+
 } // m8r namespace
 
 #endif /* M8R_OUTLINE_H_ */
@@ -46,6 +46,11 @@ Tags::Tags(std::vector<const Tag*> ts)
 
 }
 
+Tags::Tags(const TagVector& ts)
+    : tags(ts.begin(), ts.end())
+{
+}
+
 Tags::~Tags()
 {
 }
@@ -19,13 +19,22 @@
 #ifndef M8R_TAG_H_
 #define M8R_TAG_H_
 
+#include <set>
 #include <string>
 
 #include "../config/color.h"
 #include "../mind/ontology/thing_class_rel_triple.h"
+#include "../gear/small_vector.h"
 
 namespace m8r {
 
+class Tag;
+
+/**
+ * @brief Tags of an Outline or Note - most of them have at most two tags.
+ */
+typedef SmallVector<const Tag*, 2> TagVector;
+
 /**
  * Tag is a member of an extensible set of labels w/ a predefined base.
  * Labels are loaded from the configuration (default set populated on installation).
@@ -117,7 +126,7 @@ public:
     }
 
     static bool hasTagStrings(
-        const std::vector<const Tag*>& thingTags,
+        const TagVector& thingTags,
         std::vector<std::string>& filterTags
     ) {
         if(!filterTags.size()) {
@@ -140,7 +149,7 @@ public:
     }
     // IMPROVE: consolidate ^v methods (iterator parameter, vector version removal)
     static bool hasTagStrings(
-        const std::vector<const Tag*>& thingTags,
+        const TagVector& thingTags,
         std::set<std::string>& filterTags
     ) {
         if(!filterTags.size()) {
@@ -192,7 +201,7 @@ public:
     virtual ~Tag();
 
     bool equals(const std::string& s) const {
-        return this->name == s;
+        return *name == s;
     }
 
     const Color& getColor() const { return color; }
@@ -272,6 +281,7 @@ private:
 public:
     explicit Tags();
     explicit Tags(std::vector<const Tag*> ts);
+    explicit Tags(const TagVector& ts);
     Tags(const Tags&) = delete;
     Tags(const Tags&&) = delete;
     Tags& operator=(const Tags&) = delete;
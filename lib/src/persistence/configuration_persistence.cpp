@@ -18,12 +18,28 @@
 */
 #include "configuration_persistence.h"
 
+#include "../gear/file_utils.h"
+
+using namespace std;
+
 namespace m8r {
 
 ConfigurationPersistence::~ConfigurationPersistence()
 {
 }
 
+bool ConfigurationPersistence::write(const Documents& documents)
+{
+    bool success = true;
+    for(const pair<string,string>& document:documents) {
+        if(!stringToFileAtomic(document.first, document.second)) {
+            cerr << "Error: unable to save configuration to " << document.first << endl;
+            success = false;
+        }
+    }
+    return success;
+}
+
 RepositoryConfigurationPersistence::~RepositoryConfigurationPersistence()
 {
 }
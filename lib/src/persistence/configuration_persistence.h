@@ -19,6 +19,10 @@
 #ifndef M8R_CONFIGURATION_PERSISTENCE_H
 #define M8R_CONFIGURATION_PERSISTENCE_H
 
+#include <string>
+#include <utility>
+#include <vector>
+
 #include "../config/configuration.h"
 
 namespace m8r {
@@ -27,9 +31,22 @@ class Configuration;
 
 class ConfigurationPersistence
 {
+public:
+    // serialized configuration: (path, content) pairs
+    typedef std::vector<std::pair<std::string,std::string>> Documents;
+
 public:
     virtual ~ConfigurationPersistence();
 
+    /**
+     * @brief Serialize configuration to documents w/o any I/O.
+     */
+    virtual void serialize(Configuration& c, Documents& documents) = 0;
+    /**
+     * @brief Write serialized configuration documents - true on success.
+     */
+    static bool write(const Documents& documents);
+
     /**
      * @brief Load configuration.
      */
@@ -0,0 +1,155 @@
+/*
+ configuration_store.cpp     MindForger thinking notebook
+
+ Copyright (C) 2016-2025 Martin Dvorak <martin.dvorak@mindforger.com>
+
+ This program is free software; you can redistribute it and/or
+ modify it under the terms of the GNU General Public License
+ as published by the Free Software Foundation; either version 2
+ of the License, or (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+#include "configuration_store.h"
+
+using namespace std;
+
+namespace m8r {
+
+ConfigurationStore::ConfigurationStore(
+        ConfigurationPersistence* delegate,
+        int saveDelayMillis)
+    : delegate{delegate},
+      saveDelay{saveDelayMillis},
+      storeMutex{},
+      flusherCondition{},
+      pending{},
+      dirty{false},
+      writing{false},
+      deadline{},
+      shutdown{false},
+      saveRequests{0},
+      writes{0},
+      writeMutex{}
+{
+    flusher = thread{&ConfigurationStore::flusherLoop, this};
+}
+
+ConfigurationStore::~ConfigurationStore()
+{
+    {
+        lock_guard<mutex> storeLock{storeMutex};
+        shutdown = true;
+    }
+    flusherCondition.notify_all();
+    if(flusher.joinable()) {
+        flusher.join();
+    }
+
+    // do not lose changes made just before exit
+    write();
+
+    delete delegate;
+}
+
+bool ConfigurationStore::load(Configuration& c)
+{
+    // pending changes would overwrite just loaded configuration later
+    write();
+
+    lock_guard<mutex> writeLock{writeMutex};
+    return delegate->load(c);
+}
+
+void ConfigurationStore::save(Configuration& c)
+{
+    {
+        // serialized under lock > concurrent savers can't swap older snapshot in last
+        lock_guard<mutex> storeLock{storeMutex};
+        Documents snapshot{};
+        delegate->serialize(c, snapshot);
+        saveRequests++;
+        pending.swap(snapshot);
+        if(dirty) {
+            // coalesce with already scheduled save - deadline is NOT postponed
+            // so that frequent changes are persisted w/ bounded latency
+            return;
+        }
+        dirty = true;
+        deadline = chrono::steady_clock::now() + saveDelay;
+    }
+    flusherCondition.notify_one();
+}
+
+void ConfigurationStore::flush()
+{
+    write();
+}
+
+bool ConfigurationStore::isDirty()
+{
+    lock_guard<mutex> storeLock{storeMutex};
+    return dirty || writing;
+}
+
+unsigned long ConfigurationStore::getSaveRequestsCount()
+{
+    lock_guard<mutex> storeLock{storeMutex};
+    return saveRequests;
+}
+
+unsigned long ConfigurationStore::getWritesCount()
+{
+    lock_guard<mutex> storeLock{storeMutex};
+    return writes;
+}
+
+void ConfigurationStore::flusherLoop()
+{
+    unique_lock<mutex> storeLock{storeMutex};
+    while(!shutdown) {
+        if(!dirty) {
+            flusherCondition.wait(storeLock);
+        } else if(chrono::steady_clock::now() < deadline) {
+            flusherCondition.wait_until(storeLock, deadline);
+        } else {
+            storeLock.unlock();
+            write();
+            storeLock.lock();
+        }
+    }
+}
+
+void ConfigurationStore::write()
+{
+    // lock order: writeMutex > storeMutex
+    lock_guard<mutex> writeLock{writeMutex};
+
+    Documents documents{};
+    bool scheduled;
+    {
+        lock_guard<mutex> storeLock{storeMutex};
+        documents.swap(pending);
+        scheduled = dirty;
+        dirty = false;
+        writing = scheduled;
+    }
+
+    if(scheduled) {
+        // snapshot is just written - flusher doesn't touch configuration
+        MF_DEBUG("Configuration store: writing configuration" << endl);
+        ConfigurationPersistence::write(documents);
+
+        lock_guard<mutex> storeLock{storeMutex};
+        writing = false;
+        writes++;
+    }
+}
+
+} // m8r namespace
@@ -0,0 +1,112 @@
+/*
+ configuration_store.h     MindForger thinking notebook
+
+ Copyright (C) 2016-2025 Martin Dvorak <martin.dvorak@mindforger.com>
+
+ This program is free software; you can redistribute it and/or
+ modify it under the terms of the GNU General Public License
+ as published by the Free Software Foundation; either version 2
+ of the License, or (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+#ifndef M8R_CONFIGURATION_STORE_H
+#define M8R_CONFIGURATION_STORE_H
+
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+#include "configuration_persistence.h"
+
+namespace m8r {
+
+/**
+ * @brief Debounced configuration persistence.
+ *
+ * Configuration store decorates configuration persistence (typically
+ * Markdown configuration representation) so that save requests are cheap:
+ * save() serializes configuration to an in-memory snapshot (no I/O) and
+ * a background flusher thread writes the latest snapshot once the save delay
+ * elapses. Any number of save requests issued within the delay is coalesced
+ * to a single write.
+ *
+ * Store can be used from any thread (UI, AA workers, ...). Pending changes
+ * are flushed on load(), on explicit flush() and on store destruction.
+ */
+class ConfigurationStore : public ConfigurationPersistence
+{
+public:
+    static constexpr int DEFAULT_SAVE_DELAY_MILLIS = 1000;
+
+private:
+    // decorated persistence (owned)
+    ConfigurationPersistence* delegate;
+    std::chrono::milliseconds saveDelay;
+
+    // pending configuration snapshot guarded by storeMutex
+    std::mutex storeMutex;
+    std::condition_variable flusherCondition;
+    Documents pending;
+    bool dirty;
+    bool writing;
+    std::chrono::steady_clock::time_point deadline;
+    bool shutdown;
+    unsigned long saveRequests;
+    unsigned long writes;
+
+    // serializes delegate I/O (background flusher vs. explicit flush/load)
+    std::mutex writeMutex;
+
+    std::thread flusher;
+
+public:
+    explicit ConfigurationStore(
+            ConfigurationPersistence* delegate,
+            int saveDelayMillis=DEFAULT_SAVE_DELAY_MILLIS);
+    ConfigurationStore(const ConfigurationStore&) = delete;
+    ConfigurationStore(const ConfigurationStore&&) = delete;
+    ConfigurationStore& operator=(const ConfigurationStore&) = delete;
+    ConfigurationStore& operator=(const ConfigurationStore&&) = delete;
+    virtual ~ConfigurationStore();
+
+    /**
+     * @brief Flush pending changes and load configuration.
+     */
+    virtual bool load(Configuration& c);
+    /**
+     * @brief Snapshot configuration and schedule its save - returns immediately, no I/O.
+     *
+     * Configuration is serialized on the calling thread, therefore the flusher
+     * never reads configuration which may be concurrently modified. Snapshot
+     * is taken and made pending atomically, so the latest save always wins.
+     */
+    virtual void save(Configuration& c);
+    virtual void serialize(Configuration& c, Documents& documents) { delegate->serialize(c, documents); }
+
+    /**
+     * @brief Persist pending changes (if any) synchronously.
+     */
+    void flush();
+
+    bool isDirty();
+    unsigned long getSaveRequestsCount();
+    unsigned long getWritesCount();
+
+private:
+    void flusherLoop();
+    /**
+     * @brief Write pending configuration snapshot (if any).
+     */
+    void write();
+};
+
+}
+#endif // M8R_CONFIGURATION_STORE_H
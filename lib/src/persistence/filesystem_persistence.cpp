@@ -20,6 +20,8 @@
 
 #include <sys/stat.h>
 
+#include "../gear/instrumentation.h"
+
 using namespace std;
 
 namespace m8r {
@@ -98,6 +100,8 @@ bool FilesystemPersistence::isWriteable(const string& outlineKey)
 
 void FilesystemPersistence::save(Outline* outline)
 {
+    M8R_INSTRUMENTATION_TIMER(timer, "persistence.save");
+
     string* text = mdRepresentation.to(outline);
     if(text!=nullptr) {
         MF_DEBUG("Saving O: " << outline->getKey() << endl);
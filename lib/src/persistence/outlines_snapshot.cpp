@@ -0,0 +1,525 @@
+/*
+ outlines_snapshot.cpp     MindForger thinking notebook
+
+ Copyright (C) 2016-2025 Martin Dvorak <martin.dvorak@mindforger.com>
+
+ This program is free software; you can redistribute it and/or
+ modify it under the terms of the GNU General Public License
+ as published by the Free Software Foundation; either version 2
+ of the License, or (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+#include "outlines_snapshot.h"
+
+#include <cstring>
+
+#ifndef _WIN32
+  #include <fcntl.h>
+  #include <sys/mman.h>
+  #include <unistd.h>
+#endif
+
+#include "../gear/datetime_utils.h"
+#include "../gear/file_utils.h"
+#include "../gear/string_utils.h"
+
+namespace m8r {
+
+using namespace std;
+
+const string OutlinesSnapshot::MAGIC = string{"MFSNAP01"};
+
+/*
+ * Serialization
+ */
+
+constexpr uint8_t SNAPSHOT_FLAG_POST_DECLARED_SECTION = 1;
+constexpr uint8_t SNAPSHOT_FLAG_TRAILING_HASHES_SECTION = 1<<1;
+
+template<typename T> void snapshotWrite(string& out, T value)
+{
+    out.append(reinterpret_cast<const char*>(&value), sizeof(value));
+}
+
+void snapshotWrite(string& out, const string& s)
+{
+    snapshotWrite<uint32_t>(out, s.size());
+    out.append(s);
+}
+
+void snapshotWriteLines(string& out, const vector<string*>& lines)
+{
+    snapshotWrite<uint32_t>(out, lines.size());
+    for(const string* l:lines) {
+        snapshotWrite(out, *l);
+    }
+}
+
+void snapshotWriteTags(string& out, const TagVector* tags)
+{
+    snapshotWrite<uint32_t>(out, tags->size());
+    for(const Tag* t:*tags) {
+        snapshotWrite(out, t->getName());
+    }
+}
+
+void snapshotWriteLinks(string& out, const LinkVector& links)
+{
+    snapshotWrite<uint32_t>(out, links.size());
+    for(Link* l:links) {
+        snapshotWrite(out, l->getName());
+        snapshotWrite(out, l->getUrl());
+    }
+}
+
+/*
+ * Bounds checked reader of mapped snapshot - any read beyond the end
+ * invalidates the reader (and returns zero/empty values).
+ */
+class SnapshotReader
+{
+private:
+    const char* p;
+    const char* end;
+    bool ok;
+
+public:
+    explicit SnapshotReader(const char* begin, size_t size)
+        : p{begin}, end{begin+size}, ok{true}
+    {}
+
+    bool isOk() const { return ok; }
+    const char* position() const { return p; }
+
+    template<typename T> T read()
+    {
+        T value{};
+        if(ok && static_cast<size_t>(end-p) >= sizeof(T)) {
+            memcpy(&value, p, sizeof(T));
+            p += sizeof(T);
+        } else {
+            ok = false;
+        }
+        return value;
+    }
+
+    bool read(const char*& s, uint32_t& length)
+    {
+        length = read<uint32_t>();
+        if(ok && static_cast<size_t>(end-p) >= length) {
+            s = p;
+            p += length;
+            return true;
+        }
+        ok = false;
+        length = 0;
+        return false;
+    }
+
+    string readString()
+    {
+        const char* s;
+        uint32_t length;
+        if(read(s, length)) {
+            return string{s, length};
+        }
+        return string{};
+    }
+
+    string* readNewString()
+    {
+        const char* s;
+        uint32_t length;
+        if(read(s, length)) {
+            return new string{s, length};
+        }
+        return nullptr;
+    }
+
+    void skip(size_t length)
+    {
+        if(ok && static_cast<size_t>(end-p) >= length) {
+            p += length;
+        } else {
+            ok = false;
+        }
+    }
+};
+
+/*
+ * OutlinesSnapshot
+ */
+
+OutlinesSnapshot::OutlinesSnapshot(Ontology& ontology)
+    : ontology(ontology),
+      data{nullptr},
+      dataSize{0},
+#ifdef _WIN32
+      buffer{nullptr},
+#endif
+      entries{},
+      validations{},
+      hits{0},
+      misses{0},
+      touches{0}
+{
+}
+
+OutlinesSnapshot::~OutlinesSnapshot()
+{
+    close();
+}
+
+bool OutlinesSnapshot::open(const string& path)
+{
+    close();
+    hits = misses = touches = 0;
+
+#ifdef _WIN32
+    if(!isFile(path.c_str())) {
+        return false;
+    }
+    buffer = fileToString(path);
+    if(buffer == nullptr) {
+        return false;
+    }
+    data = buffer->data();
+    dataSize = buffer->size();
+#else
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if(fd < 0) {
+        return false;
+    }
+    struct stat fileStat;
+    if(::fstat(fd, &fileStat) != 0 || fileStat.st_size <= 0) {
+        ::close(fd);
+        return false;
+    }
+    void* mapped = ::mmap(nullptr, fileStat.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    // mapping stays valid after the descriptor is closed
+    ::close(fd);
+    if(mapped == MAP_FAILED) {
+        cerr << "Error: unable to map Outlines snapshot " << path << ": " << strerror(errno) << endl;
+        return false;
+    }
+    data = static_cast<const char*>(mapped);
+    dataSize = fileStat.st_size;
+#endif
+
+    // index entries
+    SnapshotReader reader{data, dataSize};
+    if(dataSize < MAGIC.size() || memcmp(data, MAGIC.data(), MAGIC.size())) {
+        MF_DEBUG("Outlines snapshot: unknown format of " << path << endl);
+        close();
+        return false;
+    }
+    reader.skip(MAGIC.size());
+    uint32_t count = reader.read<uint32_t>();
+    entries.reserve(count);
+    for(uint32_t i=0; i<count && reader.isOk(); i++) {
+        string filePath = reader.readString();
+        Entry entry;
+        entry.validation.modified = reader.read<int64_t>();
+        entry.validation.size = reader.read<uint64_t>();
+        entry.validation.hash = reader.read<uint64_t>();
+        entry.length = reader.read<uint32_t>();
+        entry.offset = reader.position()-data;
+        reader.skip(entry.length);
+        if(reader.isOk()) {
+            entries[filePath] = entry;
+        }
+    }
+    if(!reader.isOk()) {
+        cerr << "Error: Outlines snapshot " << path << " is corrupted - ignoring it" << endl;
+        close();
+        return false;
+    }
+
+    MF_DEBUG("Outlines snapshot: " << entries.size() << " entries in " << path << endl);
+    return true;
+}
+
+void OutlinesSnapshot::close()
+{
+#ifdef _WIN32
+    if(buffer) {
+        delete buffer;
+        buffer = nullptr;
+    }
+#else
+    if(data) {
+        ::munmap(const_cast<char*>(data), dataSize);
+    }
+#endif
+    data = nullptr;
+    dataSize = 0;
+
+    entries.clear();
+    validations.clear();
+}
+
+uint64_t OutlinesSnapshot::contentHash(const string& content)
+{
+    uint64_t hash = stringHash64(content);
+    if(!content.empty() && content.back() != '\n') {
+        hash = stringHash64("\n", 1, hash);
+    }
+    return hash;
+}
+
+bool OutlinesSnapshot::validate(const string& filePath, Validation& validation, const Validation* snapshot)
+{
+    if(snapshot == nullptr || snapshot->size != validation.size) {
+        // new or changed file - it's hashed by the parser (see setHash())
+        return false;
+    }
+    if(snapshot->modified == validation.modified) {
+        validation.hash = snapshot->hash;
+        return true;
+    }
+
+    // modification time differs - content hash decides
+    string* content = fileToString(filePath);
+    if(content == nullptr) {
+        return false;
+    }
+    validation.hash = contentHash(*content);
+    delete content;
+
+    return snapshot->hash == validation.hash;
+}
+
+Outline* OutlinesSnapshot::get(const string& filePath)
+{
+    struct stat fileStat;
+    if(stat(filePath.c_str(), &fileStat) != 0) {
+        misses++;
+        return nullptr;
+    }
+    return get(filePath, fileStat.st_mtime, fileStat.st_size);
+}
+
+Outline* OutlinesSnapshot::get(const string& filePath, time_t modified, size_t size)
+{
+    auto e = entries.find(filePath);
+    const Entry* entry = e==entries.end()?nullptr:&e->second;
+
+    Validation validation{modified, size, 0};
+    if(validate(filePath, validation, entry?&entry->validation:nullptr)) {
+        Outline* outline = deserialize(*entry);
+        if(outline) {
+            validations[filePath] = validation;
+            hits++;
+            if(entry->validation.modified != validation.modified) {
+                // snapshot entry must be rewritten w/ the new modification time
+                touches++;
+            }
+
+            // the same post-processing as in case of parsed Outline
+            outline->setKey(filePath);
+            outline->completeProperties(validation.modified);
+            return outline;
+        }
+    }
+
+    // Outline will be parsed by caller > remember validation for snapshot write
+    validations[filePath] = validation;
+    misses++;
+    return nullptr;
+}
+
+void OutlinesSnapshot::setHash(const string& filePath, uint64_t hash)
+{
+    auto v = validations.find(filePath);
+    if(v != validations.end()) {
+        v->second.hash = hash;
+    }
+}
+
+Outline* OutlinesSnapshot::deserialize(const Entry& entry)
+{
+    SnapshotReader reader{data+entry.offset, entry.length};
+
+    // mirrors MarkdownOutlineRepresentation::outline()
+    Outline* outline = new Outline{ontology.getDefaultOutlineType()};
+    outline->setFormat(static_cast<MarkdownDocument::Format>(reader.read<uint8_t>()));
+    uint8_t flags = reader.read<uint8_t>();
+    if(flags & SNAPSHOT_FLAG_POST_DECLARED_SECTION) outline->setPostDeclaredSection();
+    if(flags & SNAPSHOT_FLAG_TRAILING_HASHES_SECTION) outline->setTrailingHashesSection();
+    outline->setName(reader.readString());
+    const OutlineType* outlineType = ontology.getOutlineTypes().get(reader.readString());
+    outline->setType(outlineType?outlineType:ontology.getDefaultOutlineType());
+    outline->setCreated(reader.read<int64_t>());
+    outline->setModified(reader.read<int64_t>());
+    outline->setRevision(reader.read<uint32_t>());
+    outline->setRead(reader.read<int64_t>());
+    outline->setReads(reader.read<uint32_t>());
+    outline->setImportance(reader.read<int8_t>());
+    outline->setUrgency(reader.read<int8_t>());
+    outline->setProgress(reader.read<int8_t>());
+    outline->setBytesize(reader.read<uint32_t>());
+    TimeScope timeScope{};
+    timeScope.years = reader.read<uint8_t>();
+    timeScope.months = reader.read<uint8_t>();
+    timeScope.days = reader.read<uint8_t>();
+    timeScope.hours = reader.read<uint8_t>();
+    timeScope.minutes = reader.read<uint8_t>();
+    timeScope.recalculateRelativeSecs();
+    if(timeScope.relativeSecs) {
+        outline->setTimeScope(timeScope);
+    }
+    uint32_t count = reader.read<uint32_t>();
+    for(uint32_t i=0; i<count && reader.isOk(); i++) {
+        string name = reader.readString();
+        outline->addLink(new Link{name, reader.readString()});
+    }
+    count = reader.read<uint32_t>();
+    for(uint32_t i=0; i<count && reader.isOk(); i++) {
+        outline->addTag(ontology.findOrCreateTag(reader.readString()));
+    }
+    count = reader.read<uint32_t>();
+    for(uint32_t i=0; i<count && reader.isOk(); i++) {
+        outline->addPreambleLine(reader.readNewString());
+    }
+    count = reader.read<uint32_t>();
+    for(uint32_t i=0; i<count && reader.isOk(); i++) {
+        outline->addDescriptionLine(reader.readNewString());
+    }
+
+    // Ns
+    uint32_t notesCount = reader.read<uint32_t>();
+    for(uint32_t n=0; n<notesCount && reader.isOk(); n++) {
+        const NoteType* noteType = ontology.getNoteTypes().get(reader.readString());
+        Note* note = new Note{noteType?noteType:ontology.getDefaultNoteType(), outline};
+        flags = reader.read<uint8_t>();
+        if(flags & SNAPSHOT_FLAG_POST_DECLARED_SECTION) note->setPostDeclaredSection();
+        if(flags & SNAPSHOT_FLAG_TRAILING_HASHES_SECTION) note->setTrailingHashesSection();
+        note->setName(reader.readString());
+        note->setDepth(reader.read<uint16_t>());
+        count = reader.read<uint32_t>();
+        for(uint32_t i=0; i<count && reader.isOk(); i++) {
+            note->addDescriptionLine(reader.readNewString());
+        }
+        note->setCreated(reader.read<int64_t>());
+        note->setModified(reader.read<int64_t>());
+        note->setRevision(reader.read<uint32_t>());
+        note->setRead(reader.read<int64_t>());
+        note->setReads(reader.read<uint32_t>());
+        note->setDeadline(reader.read<int64_t>());
+        note->setProgress(reader.read<uint8_t>());
+        count = reader.read<uint32_t>();
+        for(uint32_t i=0; i<count && reader.isOk(); i++) {
+            string name = reader.readString();
+            note->addLink(new Link{name, reader.readString()});
+        }
+        count = reader.read<uint32_t>();
+        for(uint32_t i=0; i<count && reader.isOk(); i++) {
+            note->addTag(ontology.findOrCreateTag(reader.readString()));
+        }
+        outline->addNote(note);
+    }
+
+    if(!reader.isOk()) {
+        MF_DEBUG("Outlines snapshot: corrupted entry > Outline will be parsed" << endl);
+        delete outline;
+        return nullptr;
+    }
+    return outline;
+}
+
+void OutlinesSnapshot::serialize(Outline* outline, string& out)
+{
+    snapshotWrite<uint8_t>(out, static_cast<uint8_t>(outline->getFormat()));
+    snapshotWrite<uint8_t>(
+        out,
+        (outline->isPostDeclaredSection()?SNAPSHOT_FLAG_POST_DECLARED_SECTION:0)
+        | (outline->isTrailingHashesSection()?SNAPSHOT_FLAG_TRAILING_HASHES_SECTION:0));
+    snapshotWrite(out, outline->getName());
+    snapshotWrite(out, outline->getType()->getName());
+    snapshotWrite<int64_t>(out, outline->getCreated());
+    snapshotWrite<int64_t>(out, outline->getModified());
+    snapshotWrite<uint32_t>(out, outline->getRevision());
+    snapshotWrite<int64_t>(out, outline->getRead());
+    snapshotWrite<uint32_t>(out, outline->getReads());
+    snapshotWrite<int8_t>(out, outline->getImportance());
+    snapshotWrite<int8_t>(out, outline->getUrgency());
+    snapshotWrite<int8_t>(out, outline->getProgress());
+    snapshotWrite<uint32_t>(out, outline->getBytesize());
+    const TimeScope& timeScope = outline->getTimeScope();
+    snapshotWrite<uint8_t>(out, timeScope.years);
+    snapshotWrite<uint8_t>(out, timeScope.months);
+    snapshotWrite<uint8_t>(out, timeScope.days);
+    snapshotWrite<uint8_t>(out, timeScope.hours);
+    snapshotWrite<uint8_t>(out, timeScope.minutes);
+    snapshotWriteLinks(out, outline->getLinks());
+    snapshotWriteTags(out, outline->getTags());
+    snapshotWriteLines(out, outline->getPreamble());
+    snapshotWriteLines(out, outline->getDescription());
+
+    snapshotWrite<uint32_t>(out, outline->getNotes().size());
+    for(Note* n:outline->getNotes()) {
+        snapshotWrite(out, n->getType()->getName());
+        snapshotWrite<uint8_t>(
+            out,
+            (n->isPostDeclaredSection()?SNAPSHOT_FLAG_POST_DECLARED_SECTION:0)
+            | (n->isTrailingHashesSection()?SNAPSHOT_FLAG_TRAILING_HASHES_SECTION:0));
+        snapshotWrite(out, n->getName());
+        snapshotWrite<uint16_t>(out, n->getDepth());
+        snapshotWriteLines(out, n->getDescription());
+        snapshotWrite<int64_t>(out, n->getCreated());
+        snapshotWrite<int64_t>(out, n->getModified());
+        snapshotWrite<uint32_t>(out, n->getRevision());
+        snapshotWrite<int64_t>(out, n->getRead());
+        snapshotWrite<uint32_t>(out, n->getReads());
+        snapshotWrite<int64_t>(out, n->getDeadline());
+        snapshotWrite<uint8_t>(out, n->getProgress());
+        snapshotWriteLinks(out, n->getLinks());
+        snapshotWriteTags(out, n->getTags());
+    }
+}
+
+bool OutlinesSnapshot::write(const string& path, const vector<Outline*>& outlines)
+{
+    string out{};
+    out.reserve(dataSize?dataSize:outlines.size()*1024);
+    out.append(MAGIC);
+    snapshotWrite<uint32_t>(out, 0);
+
+    uint32_t count = 0;
+    for(Outline* o:outlines) {
+        auto v = validations.find(o->getKey());
+        if(v == validations.end()) {
+            continue;
+        }
+
+        snapshotWrite(out, o->getKey());
+        snapshotWrite<int64_t>(out, v->second.modified);
+        snapshotWrite<uint64_t>(out, v->second.size);
+        snapshotWrite<uint64_t>(out, v->second.hash);
+        size_t lengthOffset = out.size();
+        snapshotWrite<uint32_t>(out, 0);
+        serialize(o, out);
+        uint32_t length = out.size()-lengthOffset-sizeof(uint32_t);
+        memcpy(&out[lengthOffset], &length, sizeof(length));
+        count++;
+    }
+    memcpy(&out[MAGIC.size()], &count, sizeof(count));
+
+    MF_DEBUG("Outlines snapshot: writing " << count << " Outlines (" << out.size() << "B) to " << path << endl);
+    // snapshot lives in per-user cache directory which is created on demand
+    string directory{}, file{};
+    pathToDirectoryAndFile(path, directory, file);
+    if(!isDirectory(directory.c_str()) && !createDirectory(directory)) {
+        return false;
+    }
+    return stringToFileAtomic(path, out);
+}
+
+} // m8r namespace
@@ -0,0 +1,160 @@
+/*
+ outlines_snapshot.h     MindForger thinking notebook
+
+ Copyright (C) 2016-2025 Martin Dvorak <martin.dvorak@mindforger.com>
+
+ This program is free software; you can redistribute it and/or
+ modify it under the terms of the GNU General Public License
+ as published by the Free Software Foundation; either version 2
+ of the License, or (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+#ifndef M8R_OUTLINES_SNAPSHOT_H
+#define M8R_OUTLINES_SNAPSHOT_H
+
+#include <cstdint>
+#include <ctime>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "../mind/ontology/ontology.h"
+#include "../model/outline.h"
+#include "../model/note.h"
+
+namespace m8r {
+
+/**
+ * @brief Binary snapshot of parsed Outlines.
+ *
+ * Snapshot is a cache of Outlines (incl. Notes, tags, types, timestamps,
+ * links and descriptions) which were parsed from Markdown files of a
+ * repository. It allows warm start w/o lexing and parsing of files
+ * which were not changed since the snapshot was written.
+ *
+ * Every snapshot entry is validated against its file: entry is valid if
+ * the file size matches and either the file modification time matches
+ * or the hash of the file content matches (e.g. a file touched by git).
+ * Files which must be parsed are not hashed by the snapshot - the hash
+ * of the content read by the parser is set by the caller.
+ *
+ * Snapshot file is memory mapped (read to memory on Windows) on open()
+ * and only the index of entries is built - Outlines are deserialized
+ * on get(). Format (host byte order):
+ *
+ *   magic "MFSNAP01" (8B), entries count (uint32)
+ *   entry: path, mtime (int64), size (uint64), hash (uint64),
+ *          Outline record length (uint32), Outline record
+ *
+ * Strings are serialized as length (uint32) followed by bytes.
+ */
+class OutlinesSnapshot
+{
+public:
+    static const std::string MAGIC;
+
+private:
+    struct Validation {
+        int64_t modified;
+        uint64_t size;
+        uint64_t hash;
+    };
+
+    struct Entry {
+        Validation validation;
+        size_t offset;
+        size_t length;
+    };
+
+    Ontology& ontology;
+
+    // mapped snapshot
+    const char* data;
+    size_t dataSize;
+#ifdef _WIN32
+    std::string* buffer;
+#endif
+
+    std::unordered_map<std::string,Entry> entries;
+    // validations of files returned by get() - written w/ Outlines
+    std::unordered_map<std::string,Validation> validations;
+
+    size_t hits;
+    size_t misses;
+    // hits of files w/ different modification time (validated by content hash)
+    size_t touches;
+
+public:
+    explicit OutlinesSnapshot(Ontology& ontology);
+    OutlinesSnapshot(const OutlinesSnapshot&) = delete;
+    OutlinesSnapshot(const OutlinesSnapshot&&) = delete;
+    OutlinesSnapshot& operator=(const OutlinesSnapshot&) = delete;
+    OutlinesSnapshot& operator=(const OutlinesSnapshot&&) = delete;
+    ~OutlinesSnapshot();
+
+    /**
+     * @brief Map snapshot file and index its entries.
+     *
+     * @return false if snapshot doesn't exist or it is not valid (snapshot is empty).
+     */
+    bool open(const std::string& path);
+    /**
+     * @brief Unmap snapshot file and forget validations (statistics are kept).
+     */
+    void close();
+
+    /**
+     * @brief Get Outline for given Markdown file.
+     *
+     * @return Outline deserialized from snapshot if the file was not changed,
+     *         nullptr otherwise (Outline must be parsed by caller).
+     */
+    Outline* get(const std::string& filePath);
+    /**
+     * @brief Get Outline for given Markdown file w/ known modification time and size (no stat).
+     */
+    Outline* get(const std::string& filePath, time_t modified, size_t size);
+    /**
+     * @brief Set content hash of a file which was parsed by caller after get() miss.
+     */
+    void setHash(const std::string& filePath, uint64_t hash);
+
+    /**
+     * @brief Write snapshot of given Outlines.
+     *
+     * Outlines of files which were not checked by get() are skipped. Snapshot
+     * directory is created if it doesn't exist.
+     */
+    bool write(const std::string& path, const std::vector<Outline*>& outlines);
+
+    /**
+     * @brief Snapshot must be written if any file was (re)parsed, touched or removed.
+     */
+    bool isStale() const { return misses > 0 || touches > 0 || hits != entries.size(); }
+
+    size_t size() const { return entries.size(); }
+    size_t getHits() const { return hits; }
+    size_t getMisses() const { return misses; }
+    size_t getTouches() const { return touches; }
+
+    /**
+     * @brief Hash of file content which matches the hash of lines read by Markdown lexer.
+     */
+    static uint64_t contentHash(const std::string& content);
+
+private:
+    static bool validate(const std::string& filePath, Validation& validation, const Validation* snapshot);
+
+    Outline* deserialize(const Entry& entry);
+    void serialize(Outline* outline, std::string& out);
+};
+
+}
+#endif // M8R_OUTLINES_SNAPSHOT_H
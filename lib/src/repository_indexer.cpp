@@ -18,6 +18,10 @@
  */
 #include "repository_indexer.h"
 
+#include <algorithm>
+
+#include "gear/instrumentation.h"
+
 using namespace std;
 using namespace m8r::filesystem;
 
@@ -35,26 +39,8 @@ void RepositoryIndexer::clear()
 {
     repository = nullptr;
 
-    for(const string* f:allFiles) {
-        delete f;
-    }
     allFiles.clear();
-
-    // markdowns (strings were cleared as a part of allFiles strings)
-    markdowns.clear();
-    // txt
-    texts.clear();
-    // PDFs
-    pdfs.clear();
-
-    for(const string* s:outlineStencils) {
-        delete s;
-    }
     outlineStencils.clear();
-
-    for(const string* s:noteStencils) {
-        delete s;
-    }
     noteStencils.clear();
 }
 
@@ -100,9 +86,9 @@ void RepositoryIndexer::index(Repository* repository)
 }
 
 void RepositoryIndexer::updateIndex() {
+    M8R_INSTRUMENTATION_TIMER(timer, "repository.index");
 #ifdef DO_MF_DEBUG
     MF_DEBUG(endl << "Indexing repository:" << endl << "  " << repository->getDir());
-    auto begin = chrono::high_resolution_clock::now();
 #endif
 
     updateIndexMemory(memoryDirectory);
@@ -115,8 +101,7 @@ void RepositoryIndexer::updateIndex() {
     }
 
 #ifdef DO_MF_DEBUG
-    auto end = chrono::high_resolution_clock::now();
-    MF_DEBUG(endl << "Repository indexed in " << chrono::duration_cast<chrono::microseconds>(end-begin).count()/1000.0 << "ms");
+    MF_DEBUG(endl << "Repository indexed in " << timer.elapsedMicros()/1000.0 << "ms");
 #endif
 }
 
@@ -124,104 +109,91 @@ void RepositoryIndexer::updateIndexMemory(const string& directory)
 {
     if(repository->getMode() == Repository::RepositoryMode::REPOSITORY) {
         MF_DEBUG(endl << "INDEXING memory DIR: " << directory);
-        DIR* dir;
-        if((dir = opendir(directory.c_str()))) {
-            const struct dirent *entry;
-            if((entry = readdir(dir))) {
-                string path;
-                string* ppath;
-                do {
-                    if(entry->d_type == DT_DIR) {
-                        if (strcmp(entry->d_name, ".") == 0 || strcmp(entry->d_name, "..") == 0) {
-                            continue;
-                        }
-                        //MF_DEBUG(endl << "DIVE> " << directory.c_str() << "//" << entry->d_name);
-                        path.assign(directory);
-                        path += FILE_PATH_SEPARATOR;
-                        path += entry->d_name;
-
-                        updateIndexMemory(path);
-                    } else {
-                        MF_DEBUG(endl << "  FILE: " << directory.c_str() << "//" << entry->d_name);
-                        ppath = new string{directory};
-                        ppath->append(FILE_PATH_SEPARATOR);
-                        ppath->append(entry->d_name);
-
-                        allFiles.insert(ppath);
-                        if(File::fileHasMarkdownExtension(*ppath)) {
-                            markdowns.insert(ppath);
-                        } else if(File::fileHasPdfExtension(*ppath)) {
-                            pdfs.insert(ppath);
-                        } else if(File::fileHasTextExtension(*ppath)) {
-                            texts.insert(ppath);
-                        }
-                    }
-                } while ((entry = readdir(dir)) != 0);
-                closedir(dir);
-            }
-        }
+        DirectoryWalker walker{};
+        walker.walk(directory, allFiles);
+        MF_DEBUG(endl << "  FILES: " << allFiles.size());
     } else {
         MF_DEBUG(endl << "INDEXING memory single FILE: " << repository->getFile() << " in " << repository->getDir());
+        allFiles.clear();
         if(repository->getFile().size()) {
-            string* path = new string{repository->getDir()};
-            path->append(FILE_PATH_SEPARATOR);
-            path->append(repository->getFile());
-            allFiles.insert(path);
-            if(File::fileHasMarkdownExtension(*path)) {
-                markdowns.insert(path);
-            }
+            string path{repository->getDir()};
+            path.append(FILE_PATH_SEPARATOR);
+            path.append(repository->getFile());
+            FileStat file{};
+            DirectoryWalker::stat(path, file);
+            allFiles.push_back(file);
         }
     }
 }
 
-void RepositoryIndexer::updateIndexStencils(const string& directory, set<const std::string*>& stencils)
+void RepositoryIndexer::updateIndexStencils(const string& directory, vector<FileStat>& stencils)
 {
     MF_DEBUG(endl << "INDEXING stencils DIR: " << directory);
-    DIR *dir;
-    if((dir = opendir(directory.c_str()))) {
-        const struct dirent *entry;
-        if((entry = readdir(dir))) {
-            string *path;
-            do {
-                if(entry->d_type != DT_DIR) {
-                    MF_DEBUG(endl << "  FILE: " << directory.c_str() << "//" << entry->d_name);
-                    path = new string{directory};
-                    path->append(FILE_PATH_SEPARATOR);
-                    path->append(entry->d_name);
-                    if(File::fileHasMarkdownExtension(*path)) {
-                        stencils.insert(path);
-                    }
-                }
-            } while ((entry = readdir(dir)) != 0);
-            closedir(dir);
-        }
+    DirectoryWalker walker{1, false};
+    walker.walk(directory, stencils);
+    stencils.erase(
+        remove_if(stencils.begin(), stencils.end(), [](const FileStat& f) {
+            return !File::fileHasMarkdownExtension(f.path);
+        }),
+        stencils.end());
+}
+
+bool RepositoryIndexer::addFile(const string& path)
+{
+    FileStat file{};
+    DirectoryWalker::stat(path, file);
+
+    auto f = lower_bound(allFiles.begin(), allFiles.end(), file);
+    if(f != allFiles.end() && f->path == path) {
+        *f = file;
+        return false;
     }
+    allFiles.insert(f, file);
+    return true;
 }
 
-const set<const string*> RepositoryIndexer::getMarkdownFiles() const {
-    return markdowns;
+size_t RepositoryIndexer::removeFiles(const string& path)
+{
+    string prefix{path + FILE_PATH_SEPARATOR};
+    auto removed = remove_if(allFiles.begin(), allFiles.end(), [&](const FileStat& f) {
+        return f.path == path || f.path.compare(0, prefix.size(), prefix) == 0;
+    });
+    size_t count = distance(removed, allFiles.end());
+    allFiles.erase(removed, allFiles.end());
+    return count;
 }
 
-const set<const string*> RepositoryIndexer::getPdfFiles() const {
-    return pdfs;
+const FileStat* RepositoryIndexer::getFile(const string& path) const
+{
+    FileStat file{path, 0, 0};
+    auto f = lower_bound(allFiles.begin(), allFiles.end(), file);
+    if(f != allFiles.end() && f->path == path) {
+        return &(*f);
+    }
+    return nullptr;
 }
 
-const set<const string*> RepositoryIndexer::getTextFiles() const {
-    return texts;
+const vector<const FileStat*> RepositoryIndexer::getFiles(bool (*hasExtension)(const string&)) const
+{
+    vector<const FileStat*> files{};
+    for(const FileStat& f:allFiles) {
+        if(hasExtension(f.path)) {
+            files.push_back(&f);
+        }
+    }
+    return files;
 }
 
-const set<const string*> RepositoryIndexer::getAllOutlineFileNames() const {
-    return allFiles;
+const vector<const FileStat*> RepositoryIndexer::getMarkdownFiles() const {
+    return getFiles(File::fileHasMarkdownExtension);
 }
 
-const set<const std::string*> RepositoryIndexer::getOutlineStencilsFileNames() const
-{
-    return outlineStencils;
+const vector<const FileStat*> RepositoryIndexer::getPdfFiles() const {
+    return getFiles(File::fileHasPdfExtension);
 }
 
-const set<const std::string*> RepositoryIndexer::getNoteStencilsFileNames() const
-{
-    return noteStencils;
+const vector<const FileStat*> RepositoryIndexer::getTextFiles() const {
+    return getFiles(File::fileHasTextExtension);
 }
 
 char* RepositoryIndexer::getTagsFromPath() {
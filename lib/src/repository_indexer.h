@@ -34,6 +34,7 @@
 #include <vector>
 
 #include "debug.h"
+#include "gear/directory_walker.h"
 #include "gear/file_utils.h"
 #include "gear/string_utils.h"
 #include "config/configuration.h"
@@ -77,19 +78,14 @@ private:
     std::string outlineStencilsDirectory;
     std::string noteStencilsDirectory;
 
-    std::set<const std::string*> allFiles;
-    std::set<const std::string*> markdowns;
-    std::set<const std::string*> outlineStencils;
-    std::set<const std::string*> noteStencils;
-
     /*
-     * DIKW: information artifacts
+     * File tables sorted by path w/ modification time and size captured
+     * by the directory walk - reused by loader and snapshot validator.
      */
 
-    // PDFs
-    std::set<const std::string*> pdfs;
-    // TXTs
-    std::set<const std::string*> texts;
+    std::vector<FileStat> allFiles;
+    std::vector<FileStat> outlineStencils;
+    std::vector<FileStat> noteStencils;
 
 public:
     explicit RepositoryIndexer();
@@ -100,13 +96,23 @@ public:
     virtual ~RepositoryIndexer();
 
     Repository* getRepository() const { return repository; }
+    const std::string& getMemoryDirectory() const { return memoryDirectory; }
+
+    /*
+     * DIKW: information artifacts (sorted by path)
+     */
 
-    const std::set<const std::string*> getMarkdownFiles() const;
-    const std::set<const std::string*> getPdfFiles() const;
-    const std::set<const std::string*> getTextFiles() const;
-    const std::set<const std::string*> getAllOutlineFileNames() const;
-    const std::set<const std::string*> getOutlineStencilsFileNames() const;
-    const std::set<const std::string*> getNoteStencilsFileNames() const;
+    const std::vector<const FileStat*> getMarkdownFiles() const;
+    const std::vector<const FileStat*> getPdfFiles() const;
+    const std::vector<const FileStat*> getTextFiles() const;
+    const std::vector<FileStat>& getAllOutlineFileNames() const { return allFiles; }
+    const std::vector<FileStat>& getOutlineStencilsFileNames() const { return outlineStencils; }
+    const std::vector<FileStat>& getNoteStencilsFileNames() const { return noteStencils; }
+
+    /**
+     * @brief Find indexed file (binary search) - nullptr if file is not indexed.
+     */
+    const FileStat* getFile(const std::string& path) const;
     char* getTagsFromPath();
 
     /**
@@ -119,6 +125,20 @@ public:
      */
     void updateIndex();
 
+    /**
+     * @brief Add file to the index e.g. on file creation detected by repository watcher.
+     *
+     * @return false if file is already indexed (its modification time and size are updated).
+     */
+    bool addFile(const std::string& path);
+
+    /**
+     * @brief Remove file or directory (i.e. all files w/ path prefix) from the index.
+     *
+     * @return number of files removed from the index.
+     */
+    size_t removeFiles(const std::string& path);
+
     /**
      * @brief Clear all fields.
      */
@@ -126,7 +146,8 @@ public:
 
 private:
     void updateIndexMemory(const std::string& directory);
-    void updateIndexStencils(const std::string& directory, std::set<const std::string*>& stencils);
+    void updateIndexStencils(const std::string& directory, std::vector<FileStat>& stencils);
+    const std::vector<const FileStat*> getFiles(bool (*hasExtension)(const std::string&)) const;
 };
 
 } /* namespace */
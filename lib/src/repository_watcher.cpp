@@ -0,0 +1,270 @@
+/*
+ repository_watcher.cpp     MindForger thinking notebook
+
+ Copyright (C) 2016-2025 Martin Dvorak <martin.dvorak@mindforger.com>
+
+ This program is free software; you can redistribute it and/or
+ modify it under the terms of the GNU General Public License
+ as published by the Free Software Foundation; either version 2
+ of the License, or (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+#include "repository_watcher.h"
+
+#ifdef __linux__
+  #include <dirent.h>
+  #include <poll.h>
+  #include <sys/inotify.h>
+  #include <unistd.h>
+#endif
+
+#include <cerrno>
+#include <cstring>
+
+#include "gear/lang_utils.h"
+
+namespace m8r {
+
+using namespace std;
+using namespace m8r::filesystem;
+
+#ifdef __linux__
+constexpr uint32_t WATCH_MASK
+    = IN_CLOSE_WRITE | IN_CREATE | IN_DELETE | IN_MOVED_FROM | IN_MOVED_TO | IN_ONLYDIR;
+#endif
+
+/*
+ * Coalesce change w/ the previous change of the same path.
+ */
+void addRepositoryChange(
+    vector<RepositoryChange>& changes,
+    unordered_map<string,size_t>& index,
+    RepositoryChange::Type type,
+    const string& path,
+    bool directory=false)
+{
+    auto i = index.find(path);
+    if(i == index.end()) {
+        index[path] = changes.size();
+        changes.push_back(RepositoryChange{type, path, directory});
+        return;
+    }
+
+    RepositoryChange& change = changes[i->second];
+    if(type == RepositoryChange::Type::DELETED) {
+        if(change.type == RepositoryChange::Type::CREATED) {
+            // created and deleted ~ nothing happened
+            change.path.clear();
+            index.erase(i);
+        } else {
+            change.type = RepositoryChange::Type::DELETED;
+            change.directory = directory;
+        }
+    } else if(change.type != RepositoryChange::Type::CREATED) {
+        change.type = RepositoryChange::Type::MODIFIED;
+    }
+}
+
+bool RepositoryWatcher::isSupported()
+{
+#ifdef __linux__
+    return true;
+#else
+    return false;
+#endif
+}
+
+RepositoryWatcher::RepositoryWatcher()
+    : directory{},
+      inotifyDescriptor{-1},
+      watches{}
+{
+}
+
+RepositoryWatcher::~RepositoryWatcher()
+{
+    stop();
+}
+
+bool RepositoryWatcher::watch(const string& directory)
+{
+    stop();
+
+#ifdef __linux__
+    inotifyDescriptor = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    if(inotifyDescriptor < 0) {
+        cerr << "Error: unable to initialize repository watcher: " << strerror(errno) << endl;
+        return false;
+    }
+
+    this->directory = directory;
+    addWatches(directory, nullptr);
+    if(watches.empty()) {
+        stop();
+        return false;
+    }
+
+    MF_DEBUG("Repository watcher: watching " << watches.size() << " directories in " << directory << endl);
+    return true;
+#else
+    UNUSED_ARG(directory);
+    return false;
+#endif
+}
+
+void RepositoryWatcher::stop()
+{
+#ifdef __linux__
+    if(inotifyDescriptor >= 0) {
+        // closing the descriptor removes all watches
+        close(inotifyDescriptor);
+    }
+#endif
+    inotifyDescriptor = -1;
+    watches.clear();
+    directory.clear();
+}
+
+void RepositoryWatcher::addWatches(const string& directory, vector<RepositoryChange>* created)
+{
+#ifdef __linux__
+    int wd = inotify_add_watch(inotifyDescriptor, directory.c_str(), WATCH_MASK);
+    if(wd < 0) {
+        cerr << "Error: unable to watch directory " << directory << ": " << strerror(errno) << endl;
+        return;
+    }
+    watches[wd] = directory;
+
+    DIR* dir;
+    if((dir = opendir(directory.c_str()))) {
+        const struct dirent* entry;
+        string path{};
+        while((entry = readdir(dir)) != nullptr) {
+            if(strcmp(entry->d_name, ".") == 0 || strcmp(entry->d_name, "..") == 0) {
+                continue;
+            }
+            path.assign(directory);
+            path += FILE_PATH_SEPARATOR;
+            path += entry->d_name;
+
+            bool isDir = entry->d_type == DT_DIR
+                         || (entry->d_type == DT_UNKNOWN && isDirectory(path.c_str()));
+            if(isDir) {
+                addWatches(path, created);
+            } else if(created && File::fileHasMarkdownExtension(path)) {
+                // files created before the watch was added
+                created->push_back(RepositoryChange{RepositoryChange::Type::CREATED, path, false});
+            }
+        }
+        closedir(dir);
+    }
+#else
+    UNUSED_ARG(directory);
+    UNUSED_ARG(created);
+#endif
+}
+
+void RepositoryWatcher::removeWatches(const string& directory)
+{
+#ifdef __linux__
+    string prefix{directory + FILE_PATH_SEPARATOR};
+    for(auto w = watches.begin(); w != watches.end(); ) {
+        if(w->second == directory || w->second.compare(0, prefix.size(), prefix) == 0) {
+            inotify_rm_watch(inotifyDescriptor, w->first);
+            w = watches.erase(w);
+        } else {
+            ++w;
+        }
+    }
+#else
+    UNUSED_ARG(directory);
+#endif
+}
+
+size_t RepositoryWatcher::poll(vector<RepositoryChange>& changes, int timeoutMillis)
+{
+    changes.clear();
+    if(!isWatching()) {
+        return 0;
+    }
+
+#ifdef __linux__
+    struct pollfd pfd;
+    pfd.fd = inotifyDescriptor;
+    pfd.events = POLLIN;
+    pfd.revents = 0;
+    if(::poll(&pfd, 1, timeoutMillis) <= 0) {
+        return 0;
+    }
+
+    vector<RepositoryChange> batch{};
+    unordered_map<string,size_t> index{};
+    alignas(struct inotify_event) char buffer[EVENTS_BUFFER_SIZE];
+    ssize_t length;
+    while((length = read(inotifyDescriptor, buffer, sizeof(buffer))) > 0) {
+        for(char* p = buffer; p < buffer + length; ) {
+            const struct inotify_event* event = reinterpret_cast<const struct inotify_event*>(p);
+            p += sizeof(struct inotify_event) + event->len;
+
+            if(event->mask & IN_Q_OVERFLOW) {
+                MF_DEBUG("Repository watcher: events queue overflow" << endl);
+                addRepositoryChange(batch, index, RepositoryChange::Type::RESCAN, directory);
+                continue;
+            }
+            if(event->mask & IN_IGNORED) {
+                watches.erase(event->wd);
+                continue;
+            }
+            auto w = watches.find(event->wd);
+            if(w == watches.end() || !event->len) {
+                continue;
+            }
+
+            string path{w->second};
+            path += FILE_PATH_SEPARATOR;
+            path += event->name;
+
+            if(event->mask & IN_ISDIR) {
+                if(event->mask & (IN_CREATE | IN_MOVED_TO)) {
+                    vector<RepositoryChange> created{};
+                    addWatches(path, &created);
+                    for(auto& c:created) {
+                        addRepositoryChange(batch, index, c.type, c.path);
+                    }
+                } else if(event->mask & (IN_DELETE | IN_MOVED_FROM)) {
+                    removeWatches(path);
+                    addRepositoryChange(batch, index, RepositoryChange::Type::DELETED, path, true);
+                }
+            } else if(File::fileHasMarkdownExtension(path)) {
+                if(event->mask & (IN_CREATE | IN_MOVED_TO)) {
+                    addRepositoryChange(batch, index, RepositoryChange::Type::CREATED, path);
+                } else if(event->mask & IN_CLOSE_WRITE) {
+                    addRepositoryChange(batch, index, RepositoryChange::Type::MODIFIED, path);
+                } else if(event->mask & (IN_DELETE | IN_MOVED_FROM)) {
+                    addRepositoryChange(batch, index, RepositoryChange::Type::DELETED, path);
+                }
+            }
+        }
+    }
+
+    for(RepositoryChange& c:batch) {
+        if(!c.path.empty()) {
+            changes.push_back(std::move(c));
+        }
+    }
+    MF_DEBUG("Repository watcher: " << changes.size() << " changes" << endl);
+#else
+    UNUSED_ARG(timeoutMillis);
+#endif
+
+    return changes.size();
+}
+
+} // m8r namespace
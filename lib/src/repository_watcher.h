@@ -0,0 +1,110 @@
+/*
+ repository_watcher.h     MindForger thinking notebook
+
+ Copyright (C) 2016-2025 Martin Dvorak <martin.dvorak@mindforger.com>
+
+ This program is free software; you can redistribute it and/or
+ modify it under the terms of the GNU General Public License
+ as published by the Free Software Foundation; either version 2
+ of the License, or (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+#ifndef M8R_REPOSITORY_WATCHER_H_
+#define M8R_REPOSITORY_WATCHER_H_
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "debug.h"
+#include "gear/file_utils.h"
+
+namespace m8r {
+
+/**
+ * @brief Change of a file (or directory) in a watched repository.
+ */
+struct RepositoryChange
+{
+    enum class Type {
+        CREATED,
+        MODIFIED,
+        DELETED,
+        // events were lost (kernel queue overflow) > repository must be rescanned
+        RESCAN
+    };
+
+    Type type;
+    std::string path;
+    // deleted directory ~ all files w/ path prefix are deleted
+    bool directory;
+};
+
+/**
+ * @brief Repository watcher - incremental alternative to repository re-indexing.
+ *
+ * Watcher recursively watches memory directory using Linux inotify and reports
+ * changes of Markdown files made outside of MindForger (git pull, sync tools,
+ * external editors) so that only changed Outlines are (re)learned.
+ *
+ * Watcher is not thread safe, changes are expected to be polled periodically
+ * by a single thread. Watching is supported on Linux only.
+ */
+class RepositoryWatcher
+{
+private:
+    static constexpr size_t EVENTS_BUFFER_SIZE = 64*1024;
+
+    std::string directory;
+    int inotifyDescriptor;
+    // watch descriptor > directory
+    std::unordered_map<int,std::string> watches;
+
+public:
+    static bool isSupported();
+
+    explicit RepositoryWatcher();
+    RepositoryWatcher(const RepositoryWatcher&) = delete;
+    RepositoryWatcher(const RepositoryWatcher&&) = delete;
+    RepositoryWatcher& operator=(const RepositoryWatcher&) = delete;
+    RepositoryWatcher& operator=(const RepositoryWatcher&&) = delete;
+    virtual ~RepositoryWatcher();
+
+    /**
+     * @brief Start watching directory and its subdirectories.
+     */
+    bool watch(const std::string& directory);
+    void stop();
+    bool isWatching() const { return inotifyDescriptor >= 0; }
+    const std::string& getDirectory() const { return directory; }
+    size_t getWatchesCount() const { return watches.size(); }
+
+    /**
+     * @brief Get Markdown files changes since the last poll.
+     *
+     * Changes of a file are coalesced e.g. file which was created and modified
+     * is reported as created, file which was created and deleted is not reported.
+     *
+     * @param timeoutMillis  wait for changes up to given time, 0 returns immediately.
+     * @return number of changes.
+     */
+    size_t poll(std::vector<RepositoryChange>& changes, int timeoutMillis=0);
+
+private:
+    /**
+     * @brief Watch directory and its subdirectories, created Markdown files are reported.
+     */
+    void addWatches(const std::string& directory, std::vector<RepositoryChange>* created);
+    void removeWatches(const std::string& directory);
+};
+
+} // m8r namespace
+
+#endif /* M8R_REPOSITORY_WATCHER_H_ */
@@ -18,14 +18,42 @@
 */
 #include "csv_outline_representation.h"
 
+#include <condition_variable>
+#include <iterator>
+#include <mutex>
+
+#include "../../gear/executor.h"
+
 using namespace std;
 using namespace m8r::filesystem;
 
 namespace m8r {
 
 const std::string CsvOutlineRepresentation::DELIMITER_CSV_HEADER = string{","};
-
-CsvOutlineRepresentation::CsvOutlineRepresentation()
+const std::string CsvOutlineRepresentation::COLUMNAR_MAGIC = string{"MFCOL01\n"};
+constexpr uint8_t CsvOutlineRepresentation::COLUMNAR_TYPE_INT64;
+constexpr uint8_t CsvOutlineRepresentation::COLUMNAR_TYPE_STRING;
+constexpr uint8_t CsvOutlineRepresentation::COLUMNAR_TYPE_UINT8;
+
+// O/N CSV line
+// id,     type, title, offset, depth, reads, writes, created, modified, read, description
+// string, o/n,  int,   int,    int,   int,   int,    long,    long,     long, string
+const vector<string> CsvOutlineRepresentation::COLUMNS = {
+    "id",
+    "type",
+    "title",
+    "offset",
+    "depth",
+    "reads",
+    "writes",
+    "created",
+    "modified",
+    "read",
+    "description"
+};
+
+CsvOutlineRepresentation::CsvOutlineRepresentation(unsigned threads)
+    : threads{threads}
 {
 }
 
@@ -33,6 +61,131 @@ CsvOutlineRepresentation::~CsvOutlineRepresentation()
 {
 }
 
+/*
+ * Buffered writer of the export file.
+ */
+
+FILE* csvOpen(const string& fileName)
+{
+    FILE* f = fopen(fileName.c_str(), "wb");
+    if(f) {
+        setvbuf(f, nullptr, _IOFBF, CsvOutlineRepresentation::WRITE_BUFFER_SIZE);
+    } else {
+        cerr << "Error: unable to open file " << fileName << endl;
+    }
+    return f;
+}
+
+bool csvWrite(FILE* f, const void* data, size_t size)
+{
+    return !size || fwrite(data, 1, size, f) == size;
+}
+
+bool csvClose(FILE* f, const string& fileName, bool success)
+{
+    if(fclose(f) != 0 || !success) {
+        cerr << "Error: unable to write file " << fileName << endl;
+        return false;
+    }
+    return true;
+}
+
+void CsvOutlineRepresentation::prepareOheTags(
+    const map<const Tag*,int>& tagsCardinality,
+    int oheTagEncodingCardinality,
+    OheColumns& oheColumns,
+    vector<string>& oheColumnNames)
+{
+    // prepare top tags: filter out entries w/ low cardinality
+    if(oheTagEncodingCardinality > -1) {
+        for(auto t:tagsCardinality) {
+            if(t.second >= oheTagEncodingCardinality) {
+                oheColumns[t.first] = oheColumnNames.size();
+                oheColumnNames.push_back(normalizeToNcName(t.first->getName(), '_'));
+            }
+        }
+    }
+}
+
+bool CsvOutlineRepresentation::pipeline(
+    size_t count,
+    const function<void(size_t)>& format,
+    const function<bool(size_t)>& consume,
+    ProgressCallbackCtx* callbackCtx)
+{
+    mutex pipelineMutex{};
+    condition_variable formatted{};
+    condition_variable consumed{};
+    vector<char> done(count, 0);
+    size_t next = 0;
+    size_t written = 0;
+    bool aborted = false;
+
+    auto worker = [&]() {
+        unique_lock<mutex> pipelineLock{pipelineMutex};
+        while(true) {
+            consumed.wait(pipelineLock, [&]{
+                return aborted || next >= count || next < written + FORMAT_WINDOW;
+            });
+            if(aborted || next >= count) {
+                return;
+            }
+            size_t i = next++;
+
+            pipelineLock.unlock();
+            format(i);
+            pipelineLock.lock();
+
+            done[i] = 1;
+            formatted.notify_one();
+        }
+    };
+
+    Executor& executor = Executor::getInstance();
+    size_t workersCount = threads? threads: executor.getWorkersCount();
+    if(workersCount > count) workersCount = count;
+    Executor::TaskGroup workers{executor, Executor::Priority::BACKGROUND};
+    for(size_t w=0; w<workersCount; w++) {
+        workers.run(worker);
+    }
+
+    bool success = true;
+    for(size_t i=0; i<count && success; i++) {
+        bool self = false;
+        {
+            unique_lock<mutex> pipelineLock{pipelineMutex};
+            if(next == i) {
+                // item is not claimed by any worker (pool is busy) > format it here
+                next++;
+                self = true;
+            } else {
+                formatted.wait(pipelineLock, [&]{ return done[i] != 0; });
+            }
+        }
+        if(self) {
+            format(i);
+        }
+
+        success = consume(i);
+
+        {
+            lock_guard<mutex> pipelineLock{pipelineMutex};
+            written = i+1;
+            aborted = !success;
+        }
+        consumed.notify_all();
+
+        if(callbackCtx) {
+            callbackCtx->updateProgress((i+1)/(float)count);
+        }
+    }
+
+    // workers which haven't started yet find the pipeline drained/aborted
+    workers.wait();
+
+    return success;
+}
+
 /**
  * @brief Serialize O to CSV in "Recent view" style
  *
@@ -54,46 +207,39 @@ bool CsvOutlineRepresentation::to(
 
     if(sourceFile.getName().size()) {
         if(os.size()) {
-            // prepare top tags: filter out entries w/ low cardinality
-            vector<const Tag*> oheTags{};
-            if(oheTagEncodingCardinality > -1) {
-                for(auto t:tagsCardinality) {
-                    if(t.second >= oheTagEncodingCardinality) {
-                        oheTags.push_back(t.first);
-                    }
-                }
-            }
-            vector<string> escapedOheTags{};
-            for(auto t:oheTags) {
-                escapedOheTags.push_back(normalizeToNcName(t->getName(), '_'));
-            }
-
-            std::ofstream out{};
-            try {
-                out.open(sourceFile.getName());
-
-                float exported{0.0};
-                toHeader(out, escapedOheTags);
-                for(Outline* o:os) {
-                    MF_DEBUG("  Exporting O: " << o->getName() << " / " << o->getKey() << endl);
-                    to(o, oheTags, out);
+            OheColumns oheColumns{};
+            vector<string> oheColumnNames{};
+            prepareOheTags(tagsCardinality, oheTagEncodingCardinality, oheColumns, oheColumnNames);
 
-                    if(callbackCtx) {
-                        callbackCtx->updateProgress(++exported/(float)os.size());
-                    }
-                }
-            } catch(const std::ofstream::failure& e) {
-                cerr << "Error: unable to open/write file "
-                     << sourceFile.getName()
-                     << " " << e.what();
-                try {
-                    out.close();
-                } catch(const std::ofstream::failure& e) {}
+            FILE* out = csvOpen(sourceFile.getName());
+            if(!out) {
+                return false;
+            }
 
+            string header{};
+            toHeader(header, oheColumnNames);
+            bool success = csvWrite(out, header.data(), header.size());
+
+            // Outlines formatted in parallel, written in order
+            vector<string> chunks(os.size());
+            success = success && pipeline(
+                os.size(),
+                [&](size_t i) {
+                    MF_DEBUG("  Exporting O: " << os[i]->getName() << " / " << os[i]->getKey() << endl);
+                    // lazy memory must not evict Ns descriptions while O is formatted
+                    OutlineBodiesPin pin{os[i]};
+                    to(os[i], oheColumns, oheColumnNames.size(), chunks[i]);
+                },
+                [&](size_t i) {
+                    bool written = csvWrite(out, chunks[i].data(), chunks[i].size());
+                    string{}.swap(chunks[i]);
+                    return written;
+                },
+                callbackCtx);
+
+            if(!csvClose(out, sourceFile.getName(), success)) {
                 return false;
             }
-            out.flush();
-            out.close();
 
             MF_DEBUG("FINISHED export of MIND to CSV " << sourceFile.getName() << endl);
             return true;
@@ -105,110 +251,317 @@ bool CsvOutlineRepresentation::to(
     return false;
 }
 
-void CsvOutlineRepresentation::toHeader(std::ofstream& out, vector<string>& extraColumns)
+void CsvOutlineRepresentation::toHeader(string& out, const vector<string>& extraColumns)
 {
-
-    // O/N CSV line
-    // id,     type, title, offset, depth, reads, writes, created, modified, read, description
-    // string, o/n,  int,   int,    int,   int,   int,    long,    long,     long, string
-
     string header{};
-
-    string columns[] = {
-        "id",
-        "type",
-        "title",
-        "offset",
-        "depth",
-        "reads",
-        "writes",
-        "created",
-        "modified",
-        "read",
-        "description"
-    };
-    for(auto c:columns) {
+    for(auto& c:COLUMNS) {
         header += c;
         header += DELIMITER_CSV_HEADER;
     }
-    for(auto c:extraColumns) {
+    for(auto& c:extraColumns) {
         header += c;
         header += DELIMITER_CSV_HEADER;
     }
     header.pop_back();
     header += "\n";
 
-    out << header;
+    out += header;
 }
 
 void CsvOutlineRepresentation::to(
-    Outline* o, vector<const Tag*> oheTags, ofstream& out
+    Outline* o, const OheColumns& oheColumns, size_t oheCount, string& out
 ) {
-    MF_DEBUG("\n  " << o->getName());
-
     string s{};
+    // OHE values template: ,0,0,...,0
+    string oheTemplate{};
+    for(size_t i=0; i<oheCount; i++) {
+        oheTemplate += ",0";
+    }
 
     // O
-    out << o->getKey() << ",";
-    out << "o,";
-    s.clear(); quoteValue(o->getName(), s);
-    out << s << ",";
+    out += o->getKey();
+    out += ",o,";
+    quoteValue(o->getName(), s);
+    out += s;
     // O's offset and depth == 0
-    out << "0,";
-    out << "0,";
-    out << o->getReads() << ",";
-    out << o->getRevision() << ",";
-    out << o->getCreated() << ",";
-    out << o->getModified() << ",";
-    out << o->getRead() << ",";
+    out += ",0,0,";
+    out += std::to_string(o->getReads());
+    out += ",";
+    out += std::to_string(o->getRevision());
+    out += ",";
+    out += std::to_string(o->getCreated());
+    out += ",";
+    out += std::to_string(o->getModified());
+    out += ",";
+    out += std::to_string(o->getRead());
+    out += ",";
     s.clear(); quoteValue(o->getDescriptionAsString(" "), s);
-    out << s;
-
-    for(auto t:oheTags) {
-        if(o->hasTag(t)) {
-            out << ",1";
-        } else {
-            out << ",0";
-        }
+    out += s;
+    if(oheCount) {
+        s.assign(oheTemplate);
+        oheValues(o->getTags(), oheColumns, s);
+        out += s;
     }
-
-    out << "\n";
+    out += "\n";
 
     // Ns
     const vector<Note*>& ns = o->getNotes();
     int offset = 1;
     for(Note* n:ns) {
-        MF_DEBUG("    " << n->getName());
-        out << n->getKey() << ",";
-        out << "n,";
+        out += n->getKey();
+        out += ",n,";
         s.clear(); quoteValue(n->getName(), s);
-        out << s << ",";
+        out += s;
+        out += ",";
         // N's offset: <1,inf>
-        out << offset++ << ",";
+        out += std::to_string(offset++);
+        out += ",";
         // N's depth: <1,inf>
-        out << (n->getDepth()+1) << ",";
-        out << n->getReads() << ",";
-        out << n->getRevision() << ",";
-        out << n->getCreated() << ",";
-        out << n->getModified() << ",";
-        out << n->getRead() << ",";
-        MF_DEBUG(" B ");
+        out += std::to_string(n->getDepth()+1);
+        out += ",";
+        out += std::to_string(n->getReads());
+        out += ",";
+        out += std::to_string(n->getRevision());
+        out += ",";
+        out += std::to_string(n->getCreated());
+        out += ",";
+        out += std::to_string(n->getModified());
+        out += ",";
+        out += std::to_string(n->getRead());
+        out += ",";
         s.clear(); quoteValue(n->getDescriptionAsString(" "), s);
-        MF_DEBUG(" F ");
-        out << s;
+        out += s;
+        if(oheCount) {
+            s.assign(oheTemplate);
+            oheValues(n->getTags(), oheColumns, s);
+            out += s;
+        }
+        out += "\n";
+    }
+}
 
-        for(auto t:oheTags) {
-            if(n->hasTag(t)) {
-                out << ",1";
-            } else {
-                out << ",0";
+/*
+ * Set 1s in OHE values template for tags w/ OHE column - O(tags) hash lookups.
+ */
+void CsvOutlineRepresentation::oheValues(
+    const TagVector* tags, const OheColumns& oheColumns, string& values)
+{
+    if(tags) {
+        for(const Tag* t:*tags) {
+            auto column = oheColumns.find(t);
+            if(column != oheColumns.end()) {
+                values[2*column->second+1] = '1';
+            }
+        }
+    }
+}
+
+/*
+ * Columnar export.
+ */
+
+void CsvOutlineRepresentation::ColumnarRows::append(ColumnarRows& rows)
+{
+    ids.insert(ids.end(), make_move_iterator(rows.ids.begin()), make_move_iterator(rows.ids.end()));
+    types.insert(types.end(), make_move_iterator(rows.types.begin()), make_move_iterator(rows.types.end()));
+    titles.insert(titles.end(), make_move_iterator(rows.titles.begin()), make_move_iterator(rows.titles.end()));
+    offsets.insert(offsets.end(), rows.offsets.begin(), rows.offsets.end());
+    depths.insert(depths.end(), rows.depths.begin(), rows.depths.end());
+    reads.insert(reads.end(), rows.reads.begin(), rows.reads.end());
+    writes.insert(writes.end(), rows.writes.begin(), rows.writes.end());
+    created.insert(created.end(), rows.created.begin(), rows.created.end());
+    modified.insert(modified.end(), rows.modified.begin(), rows.modified.end());
+    read.insert(read.end(), rows.read.begin(), rows.read.end());
+    descriptions.insert(descriptions.end(), make_move_iterator(rows.descriptions.begin()), make_move_iterator(rows.descriptions.end()));
+    ohe.insert(ohe.end(), rows.ohe.begin(), rows.ohe.end());
+}
+
+void CsvOutlineRepresentation::toColumnar(
+    Outline* o, const OheColumns& oheColumns, size_t oheCount, ColumnarRows& rows
+) {
+    auto oheRow = [&](const TagVector* tags) {
+        size_t row = rows.ohe.size();
+        rows.ohe.resize(row + oheCount, 0);
+        if(tags && oheCount) {
+            for(const Tag* t:*tags) {
+                auto column = oheColumns.find(t);
+                if(column != oheColumns.end()) {
+                    rows.ohe[row + column->second] = 1;
+                }
             }
         }
+    };
+
+    // O
+    rows.ids.push_back(o->getKey());
+    rows.types.push_back("o");
+    rows.titles.push_back(o->getName());
+    rows.offsets.push_back(0);
+    rows.depths.push_back(0);
+    rows.reads.push_back(o->getReads());
+    rows.writes.push_back(o->getRevision());
+    rows.created.push_back(o->getCreated());
+    rows.modified.push_back(o->getModified());
+    rows.read.push_back(o->getRead());
+    rows.descriptions.push_back(o->getDescriptionAsString(" "));
+    oheRow(o->getTags());
+
+    // Ns
+    int offset = 1;
+    for(Note* n:o->getNotes()) {
+        rows.ids.push_back(n->getKey());
+        rows.types.push_back("n");
+        rows.titles.push_back(n->getName());
+        rows.offsets.push_back(offset++);
+        rows.depths.push_back(n->getDepth()+1);
+        rows.reads.push_back(n->getReads());
+        rows.writes.push_back(n->getRevision());
+        rows.created.push_back(n->getCreated());
+        rows.modified.push_back(n->getModified());
+        rows.read.push_back(n->getRead());
+        rows.descriptions.push_back(n->getDescriptionAsString(" "));
+        oheRow(n->getTags());
+    }
+}
 
-        out << "\n";
-        MF_DEBUG(" ... DONE" << endl);
-        out.flush();
+bool columnarWriteDescriptor(FILE* out, uint8_t type, const string& name)
+{
+    uint32_t length = name.size();
+    return csvWrite(out, &type, sizeof(type))
+        && csvWrite(out, &length, sizeof(length))
+        && csvWrite(out, name.data(), name.size());
+}
+
+bool columnarWrite(FILE* out, const vector<int64_t>& column)
+{
+    return csvWrite(out, column.data(), column.size()*sizeof(int64_t));
+}
+
+bool columnarWrite(FILE* out, const vector<string>& column)
+{
+    vector<uint64_t> offsets{};
+    offsets.reserve(column.size()+1);
+    uint64_t offset = 0;
+    offsets.push_back(offset);
+    for(auto& s:column) {
+        offset += s.size();
+        offsets.push_back(offset);
+    }
+    if(!csvWrite(out, offsets.data(), offsets.size()*sizeof(uint64_t))) {
+        return false;
     }
+    for(auto& s:column) {
+        if(!csvWrite(out, s.data(), s.size())) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool CsvOutlineRepresentation::toColumnar(
+    const vector<Outline*>& os,
+    const map<const Tag*,int>& tagsCardinality,
+    const File& sourceFile,
+    int oheTagEncodingCardinality,
+    ProgressCallbackCtx* callbackCtx
+) {
+    MF_DEBUG("Exporting Memory to columnar binary "
+        << sourceFile.getName()
+        << " with OHE " << oheTagEncodingCardinality << " ..."
+        << endl
+    );
+
+    if(!sourceFile.getName().size()) {
+        cerr << "Error: target file name is empty";
+        return false;
+    }
+    if(!os.size()) {
+        return false;
+    }
+
+    OheColumns oheColumns{};
+    vector<string> oheColumnNames{};
+    prepareOheTags(tagsCardinality, oheTagEncodingCardinality, oheColumns, oheColumnNames);
+    const size_t oheCount = oheColumnNames.size();
+
+    // Outlines formatted in parallel, gathered in order
+    ColumnarRows rows{};
+    vector<ColumnarRows> chunks(os.size());
+    pipeline(
+        os.size(),
+        [&](size_t i) {
+            OutlineBodiesPin pin{os[i]};
+            toColumnar(os[i], oheColumns, oheCount, chunks[i]);
+        },
+        [&](size_t i) {
+            rows.append(chunks[i]);
+            chunks[i] = ColumnarRows{};
+            return true;
+        },
+        callbackCtx);
+
+    FILE* out = csvOpen(sourceFile.getName());
+    if(!out) {
+        return false;
+    }
+
+    uint64_t rowsCount = rows.ids.size();
+    uint32_t columnsCount = COLUMNS.size() + oheCount;
+    bool success = csvWrite(out, COLUMNAR_MAGIC.data(), COLUMNAR_MAGIC.size())
+        && csvWrite(out, &rowsCount, sizeof(rowsCount))
+        && csvWrite(out, &columnsCount, sizeof(columnsCount));
+
+    // descriptors
+    const uint8_t types[] = {
+        COLUMNAR_TYPE_STRING, // id
+        COLUMNAR_TYPE_STRING, // type
+        COLUMNAR_TYPE_STRING, // title
+        COLUMNAR_TYPE_INT64,  // offset
+        COLUMNAR_TYPE_INT64,  // depth
+        COLUMNAR_TYPE_INT64,  // reads
+        COLUMNAR_TYPE_INT64,  // writes
+        COLUMNAR_TYPE_INT64,  // created
+        COLUMNAR_TYPE_INT64,  // modified
+        COLUMNAR_TYPE_INT64,  // read
+        COLUMNAR_TYPE_STRING  // description
+    };
+    for(size_t c=0; c<COLUMNS.size() && success; c++) {
+        success = columnarWriteDescriptor(out, types[c], COLUMNS[c]);
+    }
+    for(size_t c=0; c<oheCount && success; c++) {
+        success = columnarWriteDescriptor(out, COLUMNAR_TYPE_UINT8, oheColumnNames[c]);
+    }
+
+    // data
+    success = success
+        && columnarWrite(out, rows.ids)
+        && columnarWrite(out, rows.types)
+        && columnarWrite(out, rows.titles)
+        && columnarWrite(out, rows.offsets)
+        && columnarWrite(out, rows.depths)
+        && columnarWrite(out, rows.reads)
+        && columnarWrite(out, rows.writes)
+        && columnarWrite(out, rows.created)
+        && columnarWrite(out, rows.modified)
+        && columnarWrite(out, rows.read)
+        && columnarWrite(out, rows.descriptions);
+    if(success && oheCount) {
+        // transpose row major OHE to columns
+        vector<uint8_t> column(rowsCount);
+        for(size_t c=0; c<oheCount && success; c++) {
+            for(size_t r=0; r<rowsCount; r++) {
+                column[r] = rows.ohe[r*oheCount + c];
+            }
+            success = csvWrite(out, column.data(), column.size());
+        }
+    }
+
+    if(!csvClose(out, sourceFile.getName(), success)) {
+        return false;
+    }
+
+    MF_DEBUG("FINISHED export of MIND to columnar binary " << sourceFile.getName() << endl);
+    return true;
 }
 
 void CsvOutlineRepresentation::quoteValue(const std::string& is, std::string& os)
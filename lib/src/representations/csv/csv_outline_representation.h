@@ -19,7 +19,12 @@
 #ifndef M8R_CSV_OUTLINE_REPRESENTATION_H
 #define M8R_CSV_OUTLINE_REPRESENTATION_H
 
+#include <cstdint>
+#include <cstdio>
+#include <functional>
 #include <iostream>
+#include <map>
+#include <unordered_map>
 #include <vector>
 
 #include "../../model/outline.h"
@@ -35,15 +40,62 @@ namespace m8r {
  * CSV format is therefore designed to make loading of CSVs as datasets to ML frameworks.
  * No library is used to make things simple - also parsing is not needed, just serialization.
  *
+ * Export is a pipeline: Outlines are formatted to rows by the workers of
+ * the shared executor (each Outline is formatted independently) and formatted Outlines
+ * are written by the calling thread in the original order through a large
+ * write buffer. Workers are allowed to get at most FORMAT_WINDOW Outlines
+ * ahead of the writer to bound memory consumption.
+ *
+ * Besides CSV, the same rows can be exported to the columnar binary format
+ * (see toColumnar()) which can be memory mapped by ML tools w/o parsing.
+ *
  * @see https://tools.ietf.org/html/rfc4180
  */
 class CsvOutlineRepresentation
 {
+public:
+    // tag -> OHE column index
+    typedef std::unordered_map<const Tag*,size_t> OheColumns;
+
+    static constexpr size_t WRITE_BUFFER_SIZE = 1<<20;
+    static constexpr size_t FORMAT_WINDOW = 64;
+
+    // columnar binary format
+    static const std::string COLUMNAR_MAGIC;
+    static constexpr uint8_t COLUMNAR_TYPE_INT64 = 1;
+    static constexpr uint8_t COLUMNAR_TYPE_STRING = 2;
+    static constexpr uint8_t COLUMNAR_TYPE_UINT8 = 3;
+
 private:
     static const std::string DELIMITER_CSV_HEADER;
+    static const std::vector<std::string> COLUMNS;
+
+    /*
+     * Rows of one (or more) Outline in columnar form.
+     */
+    struct ColumnarRows {
+        std::vector<std::string> ids;
+        std::vector<std::string> types;
+        std::vector<std::string> titles;
+        std::vector<int64_t> offsets;
+        std::vector<int64_t> depths;
+        std::vector<int64_t> reads;
+        std::vector<int64_t> writes;
+        std::vector<int64_t> created;
+        std::vector<int64_t> modified;
+        std::vector<int64_t> read;
+        std::vector<std::string> descriptions;
+        // OHE tags: rows x OHE columns (row major)
+        std::vector<uint8_t> ohe;
+
+        void append(ColumnarRows& rows);
+    };
+
+    // worker threads used to format Outlines (0 ~ executor workers)
+    unsigned threads;
 
 public:
-    explicit CsvOutlineRepresentation();
+    explicit CsvOutlineRepresentation(unsigned threads=0);
     CsvOutlineRepresentation(const CsvOutlineRepresentation&) = delete;
     CsvOutlineRepresentation(const CsvOutlineRepresentation&&) = delete;
     CsvOutlineRepresentation& operator =(const CsvOutlineRepresentation&) = delete;
@@ -70,12 +122,57 @@ public:
         ProgressCallbackCtx* callbackCtx = nullptr
     );
 
-    void toHeader(std::ofstream& out, std::vector<std::string>& extraColumns);
-    void to(Outline* o, std::vector<const Tag*> oheTags, std::ofstream& out);
+    /**
+     * @brief Serialize given Outlines to columnar binary format.
+     *
+     * Rows and columns are the same as in case of CSV. Format (host byte
+     * order i.e. little endian on all supported platforms):
+     *
+     *   magic "MFCOL01\n" (8B), rows (uint64), columns (uint32)
+     *   columns descriptors: type (uint8), name length (uint32), name
+     *   columns data (in the order of descriptors):
+     *     int64   ... rows x int64
+     *     string  ... (rows+1) x uint64 offsets, UTF-8 bytes (w/o quoting)
+     *     uint8   ... rows x uint8 (OHE tag columns)
+     *
+     * Parameters are the same as in case of to().
+     */
+    bool toColumnar(
+        const std::vector<Outline*>& os,
+        const std::map<const Tag*,int>& tagsCardinality,
+        const filesystem::File& sourceFile,
+        int oheTagEncodingCardinality,
+        ProgressCallbackCtx* callbackCtx = nullptr
+    );
+
+    void toHeader(std::string& out, const std::vector<std::string>& extraColumns);
+    /**
+     * @brief Append O and its Ns as CSV rows to given string.
+     */
+    void to(Outline* o, const OheColumns& oheColumns, size_t oheCount, std::string& out);
 
 private:
-    void quoteValue(const std::string& is, std::string& os);
+    void prepareOheTags(
+        const std::map<const Tag*,int>& tagsCardinality,
+        int oheTagEncodingCardinality,
+        OheColumns& oheColumns,
+        std::vector<std::string>& oheColumnNames);
+
+    void toColumnar(Outline* o, const OheColumns& oheColumns, size_t oheCount, ColumnarRows& rows);
+
+    /**
+     * @brief Format items on executor workers, consume them in order on the calling thread.
+     *
+     * @return false if consumer failed (export is aborted).
+     */
+    bool pipeline(
+        size_t count,
+        const std::function<void(size_t)>& format,
+        const std::function<bool(size_t)>& consume,
+        ProgressCallbackCtx* callbackCtx);
 
+    void quoteValue(const std::string& is, std::string& os);
+    void oheValues(const TagVector* tags, const OheColumns& oheColumns, std::string& values);
 };
 
 }
@@ -18,17 +18,54 @@
  */
 #include "html_outline_representation.h"
 
+#include <unordered_set>
+
+#include "../../gear/executor.h"
+#include "../../gear/instrumentation.h"
+
 namespace m8r {
 
 using namespace std;
 
+/**
+ * @brief Does Markdown contain link reference (or footnote) definition?
+ *
+ * Reference definitions are document wide i.e. such O cannot be transcoded by sections.
+ */
+static bool hasLinkReferenceDefinitions(const string& markdown)
+{
+    size_t lineStart = 0;
+    while(lineStart < markdown.size()) {
+        size_t i = lineStart;
+        // up to 3 spaces of indentation
+        while(i < markdown.size() && i-lineStart < 3 && markdown[i] == ' ') {
+            i++;
+        }
+        size_t lineEnd = markdown.find('\n', i);
+        if(lineEnd == string::npos) {
+            lineEnd = markdown.size();
+        }
+        if(i < lineEnd && markdown[i] == '[') {
+            size_t label = markdown.find("]:", i);
+            if(label != string::npos && label < lineEnd) {
+                return true;
+            }
+        }
+        lineStart = lineEnd+1;
+    }
+    return false;
+}
+
 HtmlOutlineRepresentation::HtmlOutlineRepresentation(
         Ontology& ontology,
         RepresentationInterceptor* descriptionInterceptor)
     : config(Configuration::getInstance()),
       exportColors{},
       lf{exportColors},
-      markdownRepresentation(ontology, descriptionInterceptor)
+      markdownRepresentation(ontology, descriptionInterceptor),
+      sectionRendering(true),
+      threads(0),
+      fragmentsSize(0)
 {
 #if defined MF_MD_2_HTML_CMARK
     markdownTranscoder = new CmarkGfmMarkdownTranscoder{};
@@ -104,7 +141,7 @@ void HtmlOutlineRepresentation::organizerTypeToHtml(
     html += " </span>";
 }
 
-void HtmlOutlineRepresentation::tagsToHtml(const vector<const Tag*>* tags, string& html)
+void HtmlOutlineRepresentation::tagsToHtml(const TagVector* tags, string& html)
 {
     //text += "&nbsp;&nbsp;<table cellspacing='0' border='0' style='color: #ffffff; background-color: #00cc00; font-weight: normal;'><tr><td>urgent</td></tr></table>";
     if(!tags->empty()) {
@@ -285,6 +322,7 @@ string* HtmlOutlineRepresentation::to(const string* markdown, string* html, stri
         header(*html, basePath, standalone, yScrollTo);
 
         if(markdown->size() > 0) {
+            M8R_INSTRUMENTATION_TIMER(timer, "html.transcode");
 #ifdef MF_NO_MD_2_HTML
             html->append("<pre>");
             html->append(*markdown);
@@ -322,6 +360,8 @@ string* HtmlOutlineRepresentation::to(
         bool metadata,
         int yScrollTo)
 {
+    M8R_INSTRUMENTATION_TIMER(timer, "html.render.outline");
+
     if(!metadata) {
         return toNoMeta(outline, html, standalone, yScrollTo);
     }
@@ -439,27 +479,48 @@ string* HtmlOutlineRepresentation::to(
             );
         }
         // Ns
+        bool transcoded = false;
         if(whole) {
             const vector<Note*>& notes=outline->getNotes();
             if(notes.size()) {
-                string noteMd{};
-                for(Note* note:notes) {
-                    outlineMd.append("\n");
+                // raw theme shows Markdown in <pre> > no transcoding
+                bool bySections
+                    = sectionRendering
+                      && config.isUiHtmlTheme()
+                      && markdownTranscoder
+                      && !hasLinkReferenceDefinitions(outlineMd);
+                vector<string> notesMd(notes.size());
+                for(size_t i=0; i<notes.size(); i++) {
                     // TODO MD representation to render also tags as HTML injected code (under section)
                     markdownRepresentation.to(
-                        note,
-                        &noteMd,
+                        notes[i],
+                        &notesMd[i],
                         outline->getFormat()==MarkdownDocument::Format::MINDFORGER,
                         autolinking
                     );
-                    outlineMd.append(noteMd);
-                    noteMd.clear();
+                    bySections = bySections && !hasLinkReferenceDefinitions(notesMd[i]);
+                }
+
+                if(bySections) {
+                    // MD 2 HTML by sections
+                    html->clear();
+                    header(*html, &path, false, yScrollTo);
+                    toSections(outline, outlineMd, notesMd, *html);
+                    footer(*html);
+                    transcoded = true;
+                } else {
+                    for(const string& noteMd:notesMd) {
+                        outlineMd.append("\n");
+                        outlineMd.append(noteMd);
+                    }
                 }
             }
         }
 
         // MD 2 HTML
-        to(&outlineMd, html, &path, false, yScrollTo);
+        if(!transcoded) {
+            to(&outlineMd, html, &path, false, yScrollTo);
+        }
         // inject custom HTML header
         html->replace(
                     html->find("<body>"), // <body> element index
@@ -477,12 +538,108 @@ string* HtmlOutlineRepresentation::to(
     return html;
 }
 
+void HtmlOutlineRepresentation::toSections(
+        Outline* outline,
+        const string& outlineMarkdown,
+        const vector<string>& notesMarkdown,
+        string& html)
+{
+    M8R_INSTRUMENTATION_TIMER(timer, "html.transcode.sections");
+
+    // section 0 is O descriptor, section i is N i-1
+    const vector<Note*>& notes = outline->getNotes();
+    const size_t count = notes.size()+1;
+    auto sectionMarkdown = [&outlineMarkdown, &notesMarkdown](size_t s) -> const string& {
+        return s? notesMarkdown[s-1]: outlineMarkdown;
+    };
+
+    // reuse fragments of sections whose Markdown didn't change
+    std::hash<string> hasher{};
+    vector<HtmlFragment*> sections(count);
+    vector<size_t> dirty{};
+    size_t dirtySize = 0;
+    for(size_t s=0; s<count; s++) {
+        const string& markdown = sectionMarkdown(s);
+        const size_t hash = hasher(markdown);
+        HtmlFragment& fragment
+            = fragments[s? notes[s-1]: outline->getOutlineDescriptorAsNote()];
+        if(!fragment.valid
+           || fragment.markdownHash != hash
+           || fragment.markdownSize != markdown.size())
+        {
+            fragmentsSize -= fragment.html.size();
+            fragment.html.clear();
+            fragment.valid = true;
+            fragment.markdownHash = hash;
+            fragment.markdownSize = markdown.size();
+            dirty.push_back(s);
+            dirtySize += markdown.size();
+        }
+        sections[s] = &fragment;
+    }
+    M8R_INSTRUMENTATION_COUNT("html.fragments.hits", count-dirty.size());
+    M8R_INSTRUMENTATION_COUNT("html.fragments.misses", dirty.size());
+
+    // transcode dirty sections - fragments are independent i.e. can be created concurrently
+    auto transcode = [this, &sectionMarkdown, &sections, &dirty](size_t d) {
+        markdownTranscoder->to(
+            RepresentationType::HTML,
+            &sectionMarkdown(dirty[d]),
+            &sections[dirty[d]]->html);
+    };
+    if(dirtySize >= PARALLEL_THRESHOLD && dirty.size() > 1) {
+        // sections differ in size > lanes take next section when done
+        Executor::getInstance().parallelFor(dirty.size(), transcode, threads);
+    } else {
+        for(size_t d=0; d<dirty.size(); d++) {
+            transcode(d);
+        }
+    }
+    for(size_t s:dirty) {
+        fragmentsSize += sections[s]->html.size();
+    }
+
+    // assemble HTML in the order of sections
+    size_t size = html.size();
+    for(HtmlFragment* fragment:sections) {
+        size += fragment->html.size();
+    }
+    html.reserve(size + 100);
+    for(HtmlFragment* fragment:sections) {
+        html += fragment->html;
+    }
+
+    // keep only fragments of this O if cache is too big
+    if(fragmentsSize > FRAGMENTS_CACHE_LIMIT) {
+        unordered_set<const Note*> keep{};
+        keep.insert(outline->getOutlineDescriptorAsNote());
+        keep.insert(notes.begin(), notes.end());
+        fragmentsSize = 0;
+        for(auto f=fragments.begin(); f!=fragments.end(); ) {
+            if(keep.count(f->first)) {
+                fragmentsSize += f->second.html.size();
+                ++f;
+            } else {
+                f = fragments.erase(f);
+            }
+        }
+    }
+}
+
+void HtmlOutlineRepresentation::clearFragments()
+{
+    fragments.clear();
+    fragmentsSize = 0;
+}
+
 string* HtmlOutlineRepresentation::to(
     const Note* note,
     string* html,
     bool autolinking,
     int yScrollTo)
 {
+    M8R_INSTRUMENTATION_TIMER(timer, "html.render.note");
+
     string* markdown = new string{};
     markdown->reserve(MarkdownOutlineRepresentation::AVG_NOTE_SIZE);
     markdownRepresentation.to(note, markdown, true, autolinking);
@@ -21,6 +21,7 @@
 
 #include <string>
 #include <vector>
+#include <unordered_map>
 
 #include "../../config/configuration.h"
 #include "../../model/note.h"
@@ -71,6 +72,25 @@ public:
  */
 class HtmlOutlineRepresentation
 {
+public:
+    // dirty sections w/ less Markdown bytes than this are transcoded by the calling thread
+    static constexpr size_t PARALLEL_THRESHOLD = 64*1024;
+    // cached HTML fragments of other Os are dropped when cache exceeds this size
+    static constexpr size_t FRAGMENTS_CACHE_LIMIT = 32*1024*1024;
+
+private:
+    /**
+     * @brief HTML fragment of O section (N or O descriptor) and Markdown it was created from.
+     */
+    struct HtmlFragment {
+        bool valid;
+        size_t markdownHash;
+        size_t markdownSize;
+        std::string html;
+
+        HtmlFragment() : valid(false), markdownHash(0), markdownSize(0) {}
+    };
+
 private:
     // Performance hints:
     //  - += is ~2x faster than append() (depends on cpp lib implementation)
@@ -83,6 +103,12 @@ private:
     MarkdownOutlineRepresentation markdownRepresentation;
     MarkdownTranscoder* markdownTranscoder;
 
+    // whole O is transcoded section by section (concurrently) w/ HTML fragments reuse
+    bool sectionRendering;
+    unsigned threads;
+    std::unordered_map<const Note*, HtmlFragment> fragments;
+    size_t fragmentsSize;
+
 public:
     /**
      * @brief Html O representation.
@@ -148,16 +174,33 @@ public:
     void outlineTypeToHtml(const OutlineType* outlineType, std::string& html);
     void noteTypeToHtml(const NoteType* noteType, std::string& html);
     void organizerTypeToHtml(const Organizer* organizer, std::string& html);
-    void tagsToHtml(const std::vector<const Tag*>* tags, std::string& html);
+    void tagsToHtml(const TagVector* tags, std::string& html);
     void outlineMetadataToHtml(const Outline* outline, std::string& html);
 
     MarkdownOutlineRepresentation& getMarkdownRepresentation() { return markdownRepresentation; }
 
+    /**
+     * @brief Render whole O by sections - only sections whose Markdown changed are transcoded.
+     */
+    void setSectionRendering(bool enable) { sectionRendering = enable; }
+    bool isSectionRendering() const { return sectionRendering; }
+    /**
+     * @brief Set number of threads used to transcode large sections (0 ~ executor workers).
+     */
+    void setThreads(unsigned threads) { this->threads = threads; }
+    size_t getFragmentsCount() const { return fragments.size(); }
+    void clearFragments();
+
 private:
     void header(std::string& html, std::string* basePath, bool standalone, int yScrollTo);
     void footer(std::string& html);
 
     std::string* toNoMeta(Outline* outline, std::string* html, bool standalone, int yScrollTo);
+    void toSections(
+        Outline* outline,
+        const std::string& outlineMarkdown,
+        const std::vector<std::string>& notesMarkdown,
+        std::string& html);
 };
 
 } // m8r namespace
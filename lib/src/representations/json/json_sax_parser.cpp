@@ -0,0 +1,333 @@
+/*
+ json_sax_parser.cpp     MindForger thinking notebook
+
+ Copyright (C) 2016-2025 Martin Dvorak <martin.dvorak@mindforger.com>
+
+ This program is free software; you can redistribute it and/or
+ modify it under the terms of the GNU General Public License
+ as published by the Free Software Foundation; either version 2
+ of the License, or (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+#include "json_sax_parser.h"
+
+using namespace std;
+
+namespace m8r {
+
+JSonSaxParser::JSonSaxParser(JSonSaxHandler& handler)
+    : handler(handler),
+      state{State::VALUE},
+      containers{},
+      path{},
+      token{},
+      tokenIsKey{false},
+      unicode{0},
+      unicodeDigits{0},
+      highSurrogate{0},
+      offset{0},
+      error{}
+{
+}
+
+JSonSaxParser::~JSonSaxParser()
+{
+}
+
+void JSonSaxParser::reset()
+{
+    state = State::VALUE;
+    containers.clear();
+    path.clear();
+    token.clear();
+    highSurrogate = 0;
+    offset = 0;
+    error.clear();
+}
+
+bool JSonSaxParser::fail(const char* message, size_t position)
+{
+    state = State::ERROR;
+    error.assign(message);
+    error += " at offset ";
+    error += std::to_string(offset + position);
+    return false;
+}
+
+void JSonSaxParser::valueDone()
+{
+    if(containers.empty()) {
+        state = State::DONE;
+    } else {
+        state = containers.back().object? State::OBJECT_COMMA_OR_END: State::ARRAY_COMMA_OR_END;
+    }
+}
+
+bool JSonSaxParser::literalDone()
+{
+    if(token == "true" || token == "false") {
+        handler.onBoolean(path, token[0] == 't');
+    } else if(token == "null") {
+        handler.onNull(path);
+    } else {
+        if(token[0] != '-' && (token[0] < '0' || token[0] > '9')) {
+            return false;
+        }
+        for(char c:token) {
+            if((c < '0' || c > '9') && c != '-' && c != '+' && c != '.' && c != 'e' && c != 'E') {
+                return false;
+            }
+        }
+        handler.onNumber(path, token);
+    }
+    valueDone();
+    return true;
+}
+
+void JSonSaxParser::appendUtf8(unsigned codePoint)
+{
+    if(codePoint < 0x80) {
+        token += static_cast<char>(codePoint);
+    } else if(codePoint < 0x800) {
+        token += static_cast<char>(0xC0 | (codePoint >> 6));
+        token += static_cast<char>(0x80 | (codePoint & 0x3F));
+    } else if(codePoint < 0x10000) {
+        token += static_cast<char>(0xE0 | (codePoint >> 12));
+        token += static_cast<char>(0x80 | ((codePoint >> 6) & 0x3F));
+        token += static_cast<char>(0x80 | (codePoint & 0x3F));
+    } else {
+        token += static_cast<char>(0xF0 | (codePoint >> 18));
+        token += static_cast<char>(0x80 | ((codePoint >> 12) & 0x3F));
+        token += static_cast<char>(0x80 | ((codePoint >> 6) & 0x3F));
+        token += static_cast<char>(0x80 | (codePoint & 0x3F));
+    }
+}
+
+bool JSonSaxParser::feed(const char* chunk, size_t size)
+{
+    if(state == State::ERROR) {
+        return false;
+    }
+
+    size_t i = 0;
+    while(i < size) {
+        const char c = chunk[i];
+        switch(state) {
+        case State::STRING: {
+            if(highSurrogate && c != '\\') {
+                // unpaired surrogate
+                appendUtf8(0xFFFD);
+                highSurrogate = 0;
+            }
+            // characters w/o escaping are appended at once
+            size_t run = i;
+            while(run < size
+                  && chunk[run] != '"'
+                  && chunk[run] != '\\'
+                  && static_cast<unsigned char>(chunk[run]) >= 0x20)
+            {
+                run++;
+            }
+            token.append(chunk + i, run - i);
+            if(run == size) {
+                i = run;
+                continue;
+            }
+            i = run;
+            if(chunk[i] == '"') {
+                if(tokenIsKey) {
+                    path.resize(containers.back().pathLength);
+                    if(!path.empty()) {
+                        path += '.';
+                    }
+                    path += token;
+                    state = State::COLON;
+                } else {
+                    handler.onString(path, token);
+                    valueDone();
+                }
+            } else if(chunk[i] == '\\') {
+                state = State::STRING_ESCAPE;
+            } else {
+                return fail("Control character in JSon string", i);
+            }
+            break;
+        }
+        case State::STRING_ESCAPE:
+            if(c != 'u' && highSurrogate) {
+                appendUtf8(0xFFFD);
+                highSurrogate = 0;
+            }
+            state = State::STRING;
+            switch(c) {
+            case '"': token += '"'; break;
+            case '\\': token += '\\'; break;
+            case '/': token += '/'; break;
+            case 'b': token += '\b'; break;
+            case 'f': token += '\f'; break;
+            case 'n': token += '\n'; break;
+            case 'r': token += '\r'; break;
+            case 't': token += '\t'; break;
+            case 'u':
+                unicode = 0;
+                unicodeDigits = 0;
+                state = State::STRING_UNICODE;
+                break;
+            default:
+                return fail("Invalid JSon string escape", i);
+            }
+            break;
+        case State::STRING_UNICODE: {
+            unsigned digit;
+            if(c >= '0' && c <= '9') {
+                digit = static_cast<unsigned>(c - '0');
+            } else if(c >= 'a' && c <= 'f') {
+                digit = static_cast<unsigned>(c - 'a' + 10);
+            } else if(c >= 'A' && c <= 'F') {
+                digit = static_cast<unsigned>(c - 'A' + 10);
+            } else {
+                return fail("Invalid JSon unicode escape", i);
+            }
+            unicode = (unicode << 4) | digit;
+            if(++unicodeDigits == 4) {
+                state = State::STRING;
+                if(highSurrogate) {
+                    if(unicode >= 0xDC00 && unicode <= 0xDFFF) {
+                        appendUtf8(0x10000 + ((highSurrogate - 0xD800) << 10) + (unicode - 0xDC00));
+                        highSurrogate = 0;
+                        break;
+                    }
+                    appendUtf8(0xFFFD);
+                    highSurrogate = 0;
+                }
+                if(unicode >= 0xD800 && unicode <= 0xDBFF) {
+                    highSurrogate = unicode;
+                } else if(unicode >= 0xDC00 && unicode <= 0xDFFF) {
+                    appendUtf8(0xFFFD);
+                } else {
+                    appendUtf8(unicode);
+                }
+            }
+            break;
+        }
+        case State::LITERAL:
+            if((c >= '0' && c <= '9') || (c >= 'a' && c <= 'z') || c == '-' || c == '+' || c == '.' || c == 'E') {
+                token += c;
+                break;
+            }
+            if(!literalDone()) {
+                return fail("Invalid JSon literal", i);
+            }
+            // delimiter is processed in the new state
+            continue;
+        case State::ERROR:
+            return false;
+        default:
+            if(c == ' ' || c == '\n' || c == '\r' || c == '\t') {
+                break;
+            }
+            switch(state) {
+            case State::ARRAY_VALUE_OR_END:
+                if(c == ']') {
+                    path.resize(containers.back().pathLength);
+                    containers.pop_back();
+                    valueDone();
+                    break;
+                }
+                // fall through
+            case State::VALUE:
+                if(c == '{') {
+                    containers.push_back(Container{true, path.size()});
+                    state = State::OBJECT_KEY_OR_END;
+                } else if(c == '[') {
+                    containers.push_back(Container{false, path.size()});
+                    path += "[]";
+                    state = State::ARRAY_VALUE_OR_END;
+                } else if(c == '"') {
+                    token.clear();
+                    tokenIsKey = false;
+                    state = State::STRING;
+                } else if(c == '-' || (c >= '0' && c <= '9') || c == 't' || c == 'f' || c == 'n') {
+                    token.assign(1, c);
+                    state = State::LITERAL;
+                } else {
+                    return fail("Unexpected character in JSon value", i);
+                }
+                break;
+            case State::OBJECT_KEY_OR_END:
+                if(c == '}') {
+                    path.resize(containers.back().pathLength);
+                    containers.pop_back();
+                    valueDone();
+                    break;
+                }
+                // fall through
+            case State::OBJECT_KEY:
+                if(c != '"') {
+                    return fail("JSon object key expected", i);
+                }
+                token.clear();
+                tokenIsKey = true;
+                state = State::STRING;
+                break;
+            case State::COLON:
+                if(c != ':') {
+                    return fail("JSon colon expected", i);
+                }
+                state = State::VALUE;
+                break;
+            case State::OBJECT_COMMA_OR_END:
+                if(c == ',') {
+                    state = State::OBJECT_KEY;
+                } else if(c == '}') {
+                    path.resize(containers.back().pathLength);
+                    containers.pop_back();
+                    valueDone();
+                } else {
+                    return fail("JSon comma or end of object expected", i);
+                }
+                break;
+            case State::ARRAY_COMMA_OR_END:
+                if(c == ',') {
+                    handler.onArrayNextItem(path);
+                    state = State::VALUE;
+                } else if(c == ']') {
+                    path.resize(containers.back().pathLength);
+                    containers.pop_back();
+                    valueDone();
+                } else {
+                    return fail("JSon comma or end of array expected", i);
+                }
+                break;
+            case State::DONE:
+                return fail("Unexpected data after JSon document", i);
+            default:
+                break;
+            }
+        }
+        i++;
+    }
+
+    offset += size;
+    return true;
+}
+
+bool JSonSaxParser::finish()
+{
+    if(state == State::LITERAL && !literalDone()) {
+        fail("Invalid JSon literal", 0);
+    }
+    if(state != State::DONE && state != State::ERROR) {
+        fail("Incomplete JSon document", 0);
+    }
+    return state == State::DONE;
+}
+
+} // m8r namespace
@@ -0,0 +1,140 @@
+/*
+ json_sax_parser.h     MindForger thinking notebook
+
+ Copyright (C) 2016-2025 Martin Dvorak <martin.dvorak@mindforger.com>
+
+ This program is free software; you can redistribute it and/or
+ modify it under the terms of the GNU General Public License
+ as published by the Free Software Foundation; either version 2
+ of the License, or (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+#ifndef M8R_JSON_SAX_PARSER_H
+#define M8R_JSON_SAX_PARSER_H
+
+#include <string>
+#include <vector>
+
+namespace m8r {
+
+/**
+ * @brief JSon SAX parser events handler.
+ *
+ * Scalar values are reported w/ path of the value: object members are
+ * separated by dot, array items are [] (w/o index) e.g. value of
+ * {"choices":[{"delta":{"content":"Hi"}}]} is reported as choices[].delta.content
+ */
+class JSonSaxHandler
+{
+public:
+    explicit JSonSaxHandler() {}
+    JSonSaxHandler(const JSonSaxHandler&) = delete;
+    JSonSaxHandler(const JSonSaxHandler&&) = delete;
+    JSonSaxHandler& operator=(const JSonSaxHandler&) = delete;
+    JSonSaxHandler& operator=(const JSonSaxHandler&&) = delete;
+    virtual ~JSonSaxHandler() {}
+
+    virtual void onString(const std::string& path, const std::string& value) = 0;
+    /**
+     * @brief Number is reported as it was written in JSon (handler converts it as needed).
+     */
+    virtual void onNumber(const std::string& path, const std::string& value) = 0;
+    virtual void onBoolean(const std::string&, bool) {}
+    virtual void onNull(const std::string&) {}
+    /**
+     * @brief Next (2nd, 3rd, ...) item of the array at path follows - handler can count items.
+     */
+    virtual void onArrayNextItem(const std::string&) {}
+};
+
+/**
+ * @brief Incremental (push) JSon SAX parser.
+ *
+ * JSon may be fed in chunks of any size as they arrive e.g. from the network -
+ * chunk boundary may split any token (string, escape sequence, number, ...).
+ * Values are reported to the handler as soon as they are complete, no document
+ * is built. Parser (and its buffers) can be reused for next document using reset().
+ */
+class JSonSaxParser
+{
+private:
+    enum class State {
+        VALUE,
+        OBJECT_KEY_OR_END,
+        OBJECT_KEY,
+        COLON,
+        OBJECT_COMMA_OR_END,
+        ARRAY_VALUE_OR_END,
+        ARRAY_COMMA_OR_END,
+        STRING,
+        STRING_ESCAPE,
+        STRING_UNICODE,
+        LITERAL,
+        DONE,
+        ERROR
+    };
+
+    struct Container {
+        bool object;
+        // length of the container path
+        size_t pathLength;
+    };
+
+    JSonSaxHandler& handler;
+
+    State state;
+    std::vector<Container> containers;
+    std::string path;
+    // string or literal being parsed
+    std::string token;
+    bool tokenIsKey;
+    unsigned unicode;
+    unsigned unicodeDigits;
+    unsigned highSurrogate;
+    size_t offset;
+    std::string error;
+
+public:
+    explicit JSonSaxParser(JSonSaxHandler& handler);
+    JSonSaxParser(const JSonSaxParser&) = delete;
+    JSonSaxParser(const JSonSaxParser&&) = delete;
+    JSonSaxParser& operator=(const JSonSaxParser&) = delete;
+    JSonSaxParser& operator=(const JSonSaxParser&&) = delete;
+    ~JSonSaxParser();
+
+    /**
+     * @brief Parse next chunk of JSon.
+     *
+     * @return false if JSon is not valid.
+     */
+    bool feed(const char* chunk, size_t size);
+    bool feed(const std::string& chunk) { return feed(chunk.data(), chunk.size()); }
+    /**
+     * @brief Signal end of the input.
+     *
+     * @return true if complete and valid JSon document was parsed.
+     */
+    bool finish();
+    void reset();
+
+    bool isDone() const { return state == State::DONE; }
+    bool isError() const { return state == State::ERROR; }
+    const std::string& getError() const { return error; }
+
+private:
+    bool fail(const char* message, size_t position);
+    void valueDone();
+    bool literalDone();
+    void appendUtf8(unsigned codePoint);
+};
+
+} // m8r namespace
+
+#endif // M8R_JSON_SAX_PARSER_H
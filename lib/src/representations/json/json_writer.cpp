@@ -0,0 +1,176 @@
+/*
+ json_writer.cpp     MindForger thinking notebook
+
+ Copyright (C) 2016-2025 Martin Dvorak <martin.dvorak@mindforger.com>
+
+ This program is free software; you can redistribute it and/or
+ modify it under the terms of the GNU General Public License
+ as published by the Free Software Foundation; either version 2
+ of the License, or (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+#include "json_writer.h"
+
+#include <cstring>
+
+using namespace std;
+
+namespace m8r {
+
+JSonWriter::JSonWriter(string& out)
+    : out(out),
+      nonEmpty{},
+      afterKey{false}
+{
+}
+
+JSonWriter::~JSonWriter()
+{
+}
+
+void JSonWriter::separate()
+{
+    if(afterKey) {
+        afterKey = false;
+        return;
+    }
+    if(!nonEmpty.empty()) {
+        if(nonEmpty.back()) {
+            out += ',';
+        } else {
+            nonEmpty.back() = true;
+        }
+    }
+}
+
+JSonWriter& JSonWriter::beginObject()
+{
+    separate();
+    out += '{';
+    nonEmpty.push_back(false);
+    return *this;
+}
+
+JSonWriter& JSonWriter::endObject()
+{
+    nonEmpty.pop_back();
+    out += '}';
+    return *this;
+}
+
+JSonWriter& JSonWriter::beginArray()
+{
+    separate();
+    out += '[';
+    nonEmpty.push_back(false);
+    return *this;
+}
+
+JSonWriter& JSonWriter::endArray()
+{
+    nonEmpty.pop_back();
+    out += ']';
+    return *this;
+}
+
+JSonWriter& JSonWriter::key(const char* name)
+{
+    separate();
+    out += '"';
+    escape(name, strlen(name), out);
+    out += "\":";
+    afterKey = true;
+    return *this;
+}
+
+JSonWriter& JSonWriter::value(const char* s)
+{
+    return value(s, strlen(s));
+}
+
+JSonWriter& JSonWriter::value(const char* s, size_t size)
+{
+    separate();
+    out += '"';
+    escape(s, size, out);
+    out += '"';
+    return *this;
+}
+
+JSonWriter& JSonWriter::value(const vector<string*>& lines, const char* separator)
+{
+    separate();
+    out += '"';
+    size_t separatorSize = strlen(separator);
+    for(size_t i=0; i<lines.size(); i++) {
+        if(i) {
+            escape(separator, separatorSize, out);
+        }
+        if(lines[i]) {
+            escape(lines[i]->data(), lines[i]->size(), out);
+        }
+    }
+    out += '"';
+    return *this;
+}
+
+JSonWriter& JSonWriter::value(bool b)
+{
+    separate();
+    out += b? "true": "false";
+    return *this;
+}
+
+JSonWriter& JSonWriter::value(long long n)
+{
+    separate();
+    out += std::to_string(n);
+    return *this;
+}
+
+JSonWriter& JSonWriter::valueNull()
+{
+    separate();
+    out += "null";
+    return *this;
+}
+
+void JSonWriter::escape(const char* s, size_t size, string& out)
+{
+    static const char* HEX = "0123456789abcdef";
+
+    // runs of characters which don't need escaping are appended at once
+    size_t run = 0;
+    for(size_t i=0; i<size; i++) {
+        const unsigned char c = static_cast<unsigned char>(s[i]);
+        if(c >= 0x20 && c != '"' && c != '\\') {
+            continue;
+        }
+
+        out.append(s + run, i - run);
+        run = i + 1;
+        switch(c) {
+        case '"': out += "\\\""; break;
+        case '\\': out += "\\\\"; break;
+        case '\n': out += "\\n"; break;
+        case '\r': out += "\\r"; break;
+        case '\t': out += "\\t"; break;
+        case '\b': out += "\\b"; break;
+        case '\f': out += "\\f"; break;
+        default:
+            out += "\\u00";
+            out += HEX[c >> 4];
+            out += HEX[c & 0xF];
+        }
+    }
+    out.append(s + run, size - run);
+}
+
+} // m8r namespace
@@ -0,0 +1,82 @@
+/*
+ json_writer.h     MindForger thinking notebook
+
+ Copyright (C) 2016-2025 Martin Dvorak <martin.dvorak@mindforger.com>
+
+ This program is free software; you can redistribute it and/or
+ modify it under the terms of the GNU General Public License
+ as published by the Free Software Foundation; either version 2
+ of the License, or (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+#ifndef M8R_JSON_WRITER_H
+#define M8R_JSON_WRITER_H
+
+#include <string>
+#include <vector>
+
+namespace m8r {
+
+/**
+ * @brief Streaming JSon encoder.
+ *
+ * JSon is written directly to the output string as methods are called - there
+ * is no intermediate document (DOM), string values are escaped in a single pass
+ * straight from the source (e.g. prompt or N description lines). Commas are
+ * inserted automatically, nesting is the responsibility of the caller:
+ *
+ *   w.beginObject().key("model").value(model).key("messages").beginArray()...
+ */
+class JSonWriter
+{
+private:
+    std::string& out;
+    // per nesting level: true if a member/item was already written
+    std::vector<bool> nonEmpty;
+    bool afterKey;
+
+public:
+    explicit JSonWriter(std::string& out);
+    JSonWriter(const JSonWriter&) = delete;
+    JSonWriter(const JSonWriter&&) = delete;
+    JSonWriter& operator=(const JSonWriter&) = delete;
+    JSonWriter& operator=(const JSonWriter&&) = delete;
+    ~JSonWriter();
+
+    JSonWriter& beginObject();
+    JSonWriter& endObject();
+    JSonWriter& beginArray();
+    JSonWriter& endArray();
+    JSonWriter& key(const char* name);
+
+    JSonWriter& value(const std::string& s) { return value(s.data(), s.size()); }
+    JSonWriter& value(const char* s);
+    JSonWriter& value(const char* s, size_t size);
+    /**
+     * @brief Write lines as a single string value w/ separator between lines.
+     */
+    JSonWriter& value(const std::vector<std::string*>& lines, const char* separator);
+    JSonWriter& value(bool b);
+    JSonWriter& value(long long n);
+    JSonWriter& value(int n) { return value(static_cast<long long>(n)); }
+    JSonWriter& valueNull();
+
+    /**
+     * @brief Append escaped (w/o quotes) s to out.
+     */
+    static void escape(const char* s, size_t size, std::string& out);
+
+private:
+    void separate();
+};
+
+} // m8r namespace
+
+#endif // M8R_JSON_WRITER_H
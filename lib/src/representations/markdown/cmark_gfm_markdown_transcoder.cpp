@@ -20,6 +20,12 @@
 #include "cmark_gfm_markdown_transcoder.h"
 // cmark-gfm headers must NOT be included in header (Win build fails otherwise)
 #ifdef MF_MD_2_HTML_CMARK
+  #include <cstddef>
+  #include <cstdlib>
+  #include <cstring>
+  #include <iostream>
+  #include <vector>
+
   #include <cmark-gfm.h>
   #include <cmark-gfm-core-extensions.h>
   #include <registry.h>
@@ -30,28 +36,176 @@ namespace m8r {
 
 using namespace std;
 
-CmarkGfmMarkdownTranscoder::CmarkGfmMarkdownTranscoder() : config(Configuration::getInstance())
+#ifdef MF_MD_2_HTML_CMARK
+
+/**
+ * @brief Per-thread bump allocator for cmark AST.
+ *
+ * cmark frees AST node by node - arena ignores it and rewinds all chunks
+ * at once after the conversion. Chunks are kept for the next conversion
+ * up to RETAINED_SIZE.
+ */
+class CmarkArena
 {
-    cmarkOptions = lastMfOptions = 0;
+public:
+    static constexpr size_t ALIGNMENT = alignof(std::max_align_t) > sizeof(size_t)
+        ? alignof(std::max_align_t): sizeof(size_t);
+    static constexpr size_t CHUNK_SIZE = 256*1024;
+    static constexpr size_t RETAINED_SIZE = 4*1024*1024;
+
+private:
+    struct Chunk {
+        char* data;
+        size_t size;
+        size_t used;
+    };
+
+    vector<Chunk> chunks;
+    size_t current;
+    // the most recent allocation can be grown in place
+    char* last;
+
+public:
+    explicit CmarkArena() : current(0), last(nullptr) {}
+    CmarkArena(const CmarkArena&) = delete;
+    CmarkArena(const CmarkArena&&) = delete;
+    CmarkArena &operator=(const CmarkArena&) = delete;
+    CmarkArena &operator=(const CmarkArena&&) = delete;
+    ~CmarkArena() {
+        for(Chunk& chunk:chunks) {
+            free(chunk.data);
+        }
+    }
+
+    void* calloc(size_t count, size_t size) {
+        if(size && count > static_cast<size_t>(-1)/size) {
+            outOfMemory();
+        }
+        void* p = allocate(count*size);
+        memset(p, 0, count*size);
+        return p;
+    }
 
+    void* realloc(void* p, size_t size) {
+        if(!p) {
+            return allocate(size);
+        }
+        char* payload = static_cast<char*>(p);
+        const size_t oldSize = payloadSize(payload);
+        if(size <= oldSize) {
+            return p;
+        }
+        // grow the last allocation in place
+        Chunk& chunk = chunks[current];
+        if(payload == last) {
+            const size_t growth = align(size) - align(oldSize);
+            if(chunk.size - chunk.used >= growth) {
+                chunk.used += growth;
+                setPayloadSize(payload, size);
+                return p;
+            }
+        }
+        void* grown = allocate(size);
+        memcpy(grown, p, oldSize);
+        return grown;
+    }
+
+    /**
+     * @brief Rewind all chunks - all allocations are invalidated.
+     */
+    void reset() {
+        size_t retained = 0;
+        size_t keep = 0;
+        for(; keep<chunks.size() && retained+chunks[keep].size <= RETAINED_SIZE; keep++) {
+            retained += chunks[keep].size;
+            chunks[keep].used = 0;
+        }
+        for(size_t c=keep; c<chunks.size(); c++) {
+            free(chunks[c].data);
+        }
+        chunks.resize(keep);
+        current = 0;
+        last = nullptr;
+    }
+
+private:
+    static size_t align(size_t size) { return (size + ALIGNMENT - 1) & ~(ALIGNMENT - 1); }
+    static size_t payloadSize(char* payload) {
+        size_t size;
+        memcpy(&size, payload-ALIGNMENT, sizeof(size_t));
+        return size;
+    }
+    static void setPayloadSize(char* payload, size_t size) {
+        memcpy(payload-ALIGNMENT, &size, sizeof(size_t));
+    }
+    static void outOfMemory() {
+        cerr << "Error: cmark arena allocation failed" << endl;
+        abort();
+    }
+
+    void* allocate(size_t size) {
+        // allocation is prefixed by its size (aligned header)
+        const size_t needed = ALIGNMENT + align(size);
+        while(current < chunks.size() && chunks[current].size - chunks[current].used < needed) {
+            current++;
+        }
+        if(current == chunks.size()) {
+            Chunk chunk{};
+            chunk.size = needed;
+            if(chunk.size < CHUNK_SIZE) {
+                chunk.size = CHUNK_SIZE;
+            }
+            chunk.data = static_cast<char*>(malloc(chunk.size));
+            if(!chunk.data) {
+                outOfMemory();
+            }
+            chunks.push_back(chunk);
+        }
+        Chunk& chunk = chunks[current];
+        char* payload = chunk.data + chunk.used + ALIGNMENT;
+        chunk.used += needed;
+        setPayloadSize(payload, size);
+        last = payload;
+        return payload;
+    }
+};
+
+// thread's pooled transcoding context
+static thread_local CmarkArena cmarkArena{};
+
+static void* cmarkArenaCalloc(size_t count, size_t size) { return cmarkArena.calloc(count, size); }
+static void* cmarkArenaRealloc(void* p, size_t size) { return cmarkArena.realloc(p, size); }
+static void cmarkArenaFree(void* p) { UNUSED_ARG(p); }
+
+static cmark_mem CMARK_ARENA_MEM = {cmarkArenaCalloc, cmarkArenaRealloc, cmarkArenaFree};
+
+#endif // MF_MD_2_HTML_CMARK
+
+CmarkGfmMarkdownTranscoder::CmarkGfmMarkdownTranscoder()
+    : config(Configuration::getInstance()),
+      syntaxExtensions(nullptr)
+{
 #ifdef MF_MD_2_HTML_CMARK
     cmark_gfm_core_extensions_ensure_registered();
     // free extensions at application exit (cmark-gfm is not able to register/unregister more than once)
     std::atexit(cmark_release_plugins);
+
+    // TODO control which extensions to use in MindForger config
+    syntaxExtensions = cmark_list_syntax_extensions(cmark_get_default_mem_allocator());
 #endif
 }
 
 CmarkGfmMarkdownTranscoder::~CmarkGfmMarkdownTranscoder()
 {
+#ifdef MF_MD_2_HTML_CMARK
+    if(syntaxExtensions) {
+        cmark_llist_free(cmark_get_default_mem_allocator(), syntaxExtensions);
+    }
+#endif
 }
 
 string* CmarkGfmMarkdownTranscoder::to(RepresentationType format, const string* markdown, string* html)
 {
-    // options
-    unsigned int mfOptions = config.getMd2HtmlOptions();
-    if(mfOptions != lastMfOptions) {
-        lastMfOptions = mfOptions;
-    }
 #ifdef MF_MD_2_HTML_CMARK
     if(format == RepresentationType::HTML) {
         // preprocessing: cmark-gfm is NOT able to render sections w/ depth > 6 (###### at most)
@@ -65,34 +219,38 @@ string* CmarkGfmMarkdownTranscoder::to(RepresentationType format, const string*
             overflow=i>=CMARK_MAX_SECTION_DEPTH?i-CMARK_MAX_SECTION_DEPTH:0;
         }
 
-        // TODO make this method which takes input and provides output: cmark_to_html()
-        cmark_mem* mem = cmark_get_default_mem_allocator();
-        // TODO control which extensions to use in MindForger config
-        cmark_llist* syntax_extensions = cmark_list_syntax_extensions(mem);
-        // TODO parse options
-        cmark_parser* parser = cmark_parser_new(CMARK_OPT_DEFAULT | CMARK_OPT_UNSAFE);
-        for (cmark_llist* tmp = syntax_extensions; tmp; tmp = tmp->next) {
+        const int cmarkOptions
+            = CMARK_OPT_DEFAULT
+              | CMARK_OPT_UNSAFE
+              | static_cast<int>(config.getMd2HtmlOptions() & CMARK_OPTIONS_MASK);
+
+        // parser (AST, line buffers, ...) lives in thread's arena > it's setup is cheap
+        cmark_parser* parser = cmark_parser_new_with_mem(cmarkOptions, &CMARK_ARENA_MEM);
+        for(cmark_llist* tmp = syntaxExtensions; tmp; tmp = tmp->next) {
             cmark_parser_attach_syntax_extension(parser, (cmark_syntax_extension*)tmp->data);
         }
         cmark_parser_feed(parser, markdown->c_str()+overflow, markdown->size()-overflow);
 
-        //cmark_node* doc = cmark_parse_document (markdown->c_str(), markdown->size(), CMARK_OPT_DEFAULT | CMARK_OPT_UNSAFE);
         cmark_node* doc = cmark_parser_finish(parser);
         if(doc) {
-            char *rendered_html = cmark_render_html_with_mem(doc, CMARK_OPT_DEFAULT | CMARK_OPT_UNSAFE, parser->syntax_extensions, mem);
+            // rendered HTML may be huge > it's not kept in the arena
+            char *rendered_html = cmark_render_html_with_mem(
+                doc, cmarkOptions, parser->syntax_extensions, cmark_get_default_mem_allocator());
             if (rendered_html) {
                 html->append(rendered_html);
                 free(rendered_html);
             }
+            // let extensions release their (non-arena) data
             cmark_node_free(doc);
         }
-        cmark_llist_free(mem, syntax_extensions);
         cmark_parser_free(parser);
+        cmarkArena.reset();
     }
     else {
         html->append(*markdown);
     }
 #else
+    UNUSED_ARG(format);
     html->append(*markdown);
 #endif
     return html;
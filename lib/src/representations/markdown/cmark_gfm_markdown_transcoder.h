@@ -23,6 +23,9 @@
 #include "../../gear/lang_utils.h"
 #include "../../config/configuration.h"
 
+// cmark-gfm headers must NOT be included in header (Win build fails otherwise)
+struct _cmark_llist;
+
 namespace m8r {
 
     /**
@@ -40,18 +43,24 @@ enum class CmarkGfmOption
  * @brief cmark based Markdown to HTML transcoder.
  *
  * https://github.com/github/cmark-gfm
+ *
+ * Transcoder is reentrant i.e. to() can be called concurrently. Every thread
+ * has its own (pooled) context: cmark AST is allocated from thread's arena
+ * which is rewound (not freed) after each conversion, therefore rendering
+ * of small Ns is not dominated by heap allocations and parser setup.
  */
 class CmarkGfmMarkdownTranscoder : public MarkdownTranscoder
 {
+public:
+    // lower 16 bits of MF MD 2 HTML options are cmark options
+    static constexpr unsigned int CMARK_OPTIONS_MASK = 0xFFFF;
+
+private:
     Configuration& config;
 
-    /**
-    * @brief MindForger MD 2 HTML options.
-    *
-    * If MF options don't change, then Cmark options doesn't have to be recalculated.
-    */
-    unsigned int lastMfOptions;
-    unsigned int cmarkOptions;
+    // syntax extensions list is created once and shared by all parsers
+    struct _cmark_llist* syntaxExtensions;
+
 public:
     explicit CmarkGfmMarkdownTranscoder();
     CmarkGfmMarkdownTranscoder(const CmarkGfmMarkdownTranscoder&) = delete;
@@ -33,9 +33,12 @@ constexpr const auto CONFIG_SETTING_MIND_STATE = "* Mind state: ";
 constexpr const auto CONFIG_SETTING_MIND_TIME_SCOPE_LABEL = "* Time scope: ";
 constexpr const auto CONFIG_SETTING_MIND_TAGS_SCOPE_LABEL = "* Tags scope: ";
 constexpr const auto CONFIG_SETTING_MIND_DISTRIBUTOR_INTERVAL = "* Async refresh interval (ms): ";
+constexpr const auto CONFIG_SETTING_MIND_LAZY_MEMORY_CAP = "* Lazy memory cap (MB): ";
+constexpr const auto CONFIG_SETTING_MIND_WORKER_THREADS = "* Worker threads: ";
 constexpr const auto CONFIG_SETTING_MIND_AUTOLINKING = "* Autolinking: ";
 constexpr const auto CONFIG_SETTING_MIND_WINGMAN_PROVIDER = "* Wingman LLM provider: ";
 constexpr const auto CONFIG_SETTING_MIND_OPENAI_KEY = "* Wingman's OpenAI API key: ";
+constexpr const auto CONFIG_SETTING_MIND_LLAMACPP_URL = "* Wingman's llama.cpp server URL: ";
 
 // application
 constexpr const auto CONFIG_SETTING_STARTUP_VIEW_LABEL = "* Startup view: ";
@@ -396,6 +399,32 @@ void MarkdownConfigurationRepresentation::configurationSection(
                         }
                         i %= 10000;
                         c.setDistributorSleepInterval(i);
+                    } else if(line->find(CONFIG_SETTING_MIND_LAZY_MEMORY_CAP) != std::string::npos) {
+                        string t = line->substr(strlen(CONFIG_SETTING_MIND_LAZY_MEMORY_CAP));
+                        int i;
+                        try {
+                          i = std::stoi(t);
+                        }
+                        catch(...) {
+                          i = Configuration::DEFAULT_LAZY_MEMORY_CAP;
+                        }
+                        if(i<0) {
+                            i = Configuration::DEFAULT_LAZY_MEMORY_CAP;
+                        }
+                        c.setLazyMemoryCap(i);
+                    } else if(line->find(CONFIG_SETTING_MIND_WORKER_THREADS) != std::string::npos) {
+                        string t = line->substr(strlen(CONFIG_SETTING_MIND_WORKER_THREADS));
+                        int i;
+                        try {
+                          i = std::stoi(t);
+                        }
+                        catch(...) {
+                          i = Configuration::DEFAULT_WORKER_THREADS;
+                        }
+                        if(i<0) {
+                            i = Configuration::DEFAULT_WORKER_THREADS;
+                        }
+                        c.setWorkerThreads(i);
                     } else if(line->find(CONFIG_SETTING_MIND_AUTOLINKING) != std::string::npos) {
                         if(line->find("yes") != std::string::npos) {
                             c.setAutolinking(true);
@@ -408,12 +437,20 @@ void MarkdownConfigurationRepresentation::configurationSection(
                                 WingmanLlmProviders::WINGMAN_PROVIDER_OPENAI)) != std::string::npos
                         ) {
                             c.setWingmanLlmProvider(WingmanLlmProviders::WINGMAN_PROVIDER_OPENAI);
+                        } else if(line->find(
+                            c.getWingmanLlmProviderAsString(
+                                WingmanLlmProviders::WINGMAN_PROVIDER_LLAMACPP)) != std::string::npos
+                        ) {
+                            c.setWingmanLlmProvider(WingmanLlmProviders::WINGMAN_PROVIDER_LLAMACPP);
                         } else {
                             c.setWingmanLlmProvider(WingmanLlmProviders::WINGMAN_PROVIDER_NONE);
                         }
                     } else if(line->find(CONFIG_SETTING_MIND_OPENAI_KEY) != std::string::npos) {
                         string k = line->substr(strlen(CONFIG_SETTING_MIND_OPENAI_KEY));
                         c.setWingmanOpenAiApiKey(k);
+                    } else if(line->find(CONFIG_SETTING_MIND_LLAMACPP_URL) != std::string::npos) {
+                        string u = line->substr(strlen(CONFIG_SETTING_MIND_LLAMACPP_URL));
+                        c.setWingmanLlamaCppUrl(u);
                     }
                 }
             }
@@ -455,6 +492,20 @@ void MarkdownConfigurationRepresentation::configurationSection(
     }
 }
 
+void MarkdownConfigurationRepresentation::serialize(Configuration& c, Documents& documents)
+{
+    documents.clear();
+    documents.push_back(make_pair(c.getConfigFilePath(), string{}));
+    to(&c, documents.back().second);
+
+    // repository configuration path is available only if MF in repository mode
+    if(c.hasRepositoryConfiguration()) {
+        string* md = mdRepositoryCfgRepresentation.to(c);
+        documents.push_back(make_pair(c.getRepositoryConfigFilePath(), std::move(*md)));
+        delete md;
+    }
+}
+
 string* MarkdownConfigurationRepresentation::to(Configuration& c)
 {
     string* md = new string{};
@@ -503,12 +554,20 @@ string& MarkdownConfigurationRepresentation::to(Configuration* c, string& md)
          CONFIG_SETTING_MIND_DISTRIBUTOR_INTERVAL << (c?c->getDistributorSleepInterval():Configuration::DEFAULT_DISTRIBUTOR_SLEEP_INTERVAL+1) << endl <<
          "    * Sleep interval (miliseconds) between asynchronous mind-related evaluations (associations, ...)" << endl <<
          "    * Examples: 500, 1000, 3000, 5000" << endl <<
+         CONFIG_SETTING_MIND_LAZY_MEMORY_CAP << (c?c->getLazyMemoryCap():Configuration::DEFAULT_LAZY_MEMORY_CAP) << endl <<
+         "    * Memory (MB) for Notes descriptions - they are loaded on demand and least recently used are evicted; 0 keeps all of them in memory" << endl <<
+         "    * Examples: 0, 64, 256" << endl <<
+         CONFIG_SETTING_MIND_WORKER_THREADS << (c?c->getWorkerThreads():Configuration::DEFAULT_WORKER_THREADS) << endl <<
+         "    * Threads used for background computations (associations, indexing, rendering, ...); 0 uses the number of CPUs" << endl <<
+         "    * Examples: 0, 2, 8" << endl <<
          CONFIG_SETTING_MIND_AUTOLINKING << (c?(c->isAutolinking()?"yes":"no"):(Configuration::DEFAULT_AUTOLINKING?"yes":"no")) << endl <<
          "    * Examples: yes, no" << endl <<
          CONFIG_SETTING_MIND_WINGMAN_PROVIDER << Configuration::getWingmanLlmProviderAsString(c?c->getWingmanLlmProvider():Configuration::DEFAULT_WINGMAN_LLM_PROVIDER) << endl <<
-         "    * Examples: none, openai" << endl <<
+         "    * Examples: none, openai, llamacpp" << endl <<
          CONFIG_SETTING_MIND_OPENAI_KEY << (c?c->getWingmanOpenAiApiKey():"") << endl <<
          "    * OpenAI API key generated at https://platform.openai.com/api-keys to be used by Wingman as LLM provider" << endl <<
+         CONFIG_SETTING_MIND_LLAMACPP_URL << (c?c->getWingmanLlamaCppUrl():Configuration::DEFAULT_WINGMAN_LLAMACPP_URL) << endl <<
+         "    * Chat completions endpoint of a local (offline) llama.cpp server, or any other OpenAI API compatible server" << endl <<
          endl <<
 
          "# " << CONFIG_SECTION_APP << endl <<
@@ -650,22 +709,15 @@ void MarkdownConfigurationRepresentation::save(const File* file, Configuration*
     }
 #endif
 
-    string md{};
-    to(c,md);
-
     if(c) {
         MF_DEBUG("Saving configuration to file " << c->getConfigFilePath() << endl);
-        std::ofstream out(c->getConfigFilePath());
-        out << md;
-        out.close();
-
-        // repository configuration path is available only if MF in repository mode
-        if(c->hasRepositoryConfiguration()) {
-            MF_DEBUG("Saving repository configuration to " << c->getRepositoryConfigFilePath() << endl);
-            MarkdownRepositoryConfigurationRepresentation repositorCfgMd{};
-            repositorCfgMd.save(*c);
-        }
+        Documents documents{};
+        serialize(*c, documents);
+        write(documents);
     } else if(file) {
+        string md{};
+        to(c,md);
+
         MF_DEBUG("Saving configuration to FILE " << file->getName() << endl);
         std::ofstream out(file->getName());
         out << md;
@@ -88,6 +88,10 @@ public:
      * @brief Save configuration to file.
      */
     virtual void save(Configuration& c) { save(nullptr, &c); }
+    /**
+     * @brief Serialize configuration and repository configuration (if any) to Markdown.
+     */
+    virtual void serialize(Configuration& c, Documents& documents);
     /**
      * @brief Save initial configuration file.
      */
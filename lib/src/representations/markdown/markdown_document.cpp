@@ -26,6 +26,7 @@ MarkdownDocument::MarkdownDocument(const std::string* filePath)
 {
     this->filePath = filePath;
     this->fileSize = 0;
+    this->fileHash = 0;
     this->modified = 0;
     this->ast = nullptr;
     this->format = Format::MINDFORGER;
@@ -34,6 +35,7 @@ MarkdownDocument::MarkdownDocument(const std::string* filePath)
 void MarkdownDocument::clear()
 {
     this->fileSize = 0;
+    this->fileHash = 0;
     this->modified = 0;
     this->name.clear();
     if(ast!=nullptr) {
@@ -44,16 +46,22 @@ void MarkdownDocument::clear()
 }
 
 void MarkdownDocument::from()
+{
+    from(fileModificationTime(filePath));
+}
+
+void MarkdownDocument::from(time_t modified, bool skeleton)
 {
     clear();
-    modified = fileModificationTime(filePath);
+    this->modified = modified;
     MarkdownLexerSections lexer{filePath};
     lexer.tokenize();
+    fileHash = lexer.getFileHash();
     // IMPROVE the rest of this section could be shared by file & text
     if(lexer.getLexems().size()) {
         fileSize = lexer.getFileSize();
         // must be pointer (circular header dep)
-        MarkdownParserSections parser{lexer};
+        MarkdownParserSections parser{lexer, skeleton};
         parser.parse();
         format = parser.hasMetadata()?Format::MINDFORGER:Format::MARKDOWN;
         // parser is deleted on return, but AST is kept
@@ -60,6 +60,7 @@ private:
     const std::string* filePath;
     Format format;
     unsigned fileSize;
+    uint64_t fileHash;
     time_t modified;
 
     /**
@@ -78,6 +79,12 @@ public:
     virtual ~MarkdownDocument();
 
     void from();
+    /**
+     * @brief Parse file whose modification time is already known (no stat).
+     *
+     * Skeleton parse skips bodies of sections other than preamble and the first one.
+     */
+    void from(time_t modified, bool skeleton=false);
     void from(const std::string* text);
     bool isParsed() const { return ast==nullptr; }
     void clear();
@@ -85,6 +92,10 @@ public:
     const std::string* getFilePath() const;
     Format getFormat() const { return format; }
     unsigned getFileSize() const;
+    /**
+     * @brief Hash of parsed file content (see linesHash64()).
+     */
+    uint64_t getFileHash() const { return fileHash; }
     time_t getModified() const { return modified; }
     std::string* getName();
     /**
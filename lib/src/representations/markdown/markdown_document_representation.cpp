@@ -22,6 +22,14 @@ using namespace std;
 
 namespace m8r {
 
+const string MarkdownDocumentRepresentation::DOCUMENT_LINK_PREFIX
+    = string{"This is a notebook for the document: "};
+
+string MarkdownDocumentRepresentation::toDocumentLink(const string& documentPath)
+{
+    return DOCUMENT_LINK_PREFIX + "[" + documentPath + "](" + documentPath + ")";
+}
+
 MarkdownDocumentRepresentation::MarkdownDocumentRepresentation(Ontology& ontology)
     : ontology{ontology}
 {
@@ -33,7 +41,8 @@ MarkdownDocumentRepresentation::~MarkdownDocumentRepresentation()
 
 Outline* MarkdownDocumentRepresentation::to(
     const string& documentPath,
-    const string& outlinePath
+    const string& outlinePath,
+    time_t modified
 ) {
     Outline* o = new Outline{ontology.findOrCreateOutlineType(OutlineType::KeyPdf())};
 
@@ -53,10 +62,7 @@ Outline* MarkdownDocumentRepresentation::to(
     o->addTag(ontology.findOrCreateTag("pdf"));
     o->addTag(ontology.findOrCreateTag("library-document"));
 
-    o->addDescriptionLine(
-        new string{
-            "This is a notebook for the document: "
-            "[" + documentPath + "](" + documentPath + ")"});
+    o->addDescriptionLine(new string{toDocumentLink(documentPath)});
     o->addDescriptionLine(new string{""});
     o->addDescriptionLine(new string{"---"});
     o->addDescriptionLine(new string{""});
@@ -79,9 +85,8 @@ Outline* MarkdownDocumentRepresentation::to(
     o->addDescriptionLine(new string{""});
 
     // set O modification time identical to the document
-    o->setCreated(fileModificationTime(&documentPath));
+    o->setCreated(modified? modified: fileModificationTime(&documentPath));
     o->setModified(o->getCreated());
-    o->setModifiedPretty();
 
     o->checkAndFixProperties();
 
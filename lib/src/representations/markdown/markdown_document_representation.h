@@ -29,6 +29,14 @@ namespace m8r {
 
 class MarkdownDocumentRepresentation
 {
+public:
+    static const std::string DOCUMENT_LINK_PREFIX;
+
+    /**
+     * @brief Descriptor O description line which interlinks O w/ the document.
+     */
+    static std::string toDocumentLink(const std::string& documentPath);
+
 private:
     Ontology& ontology;
 
@@ -40,9 +48,15 @@ public:
     MarkdownDocumentRepresentation &operator=(const MarkdownDocumentRepresentation&&) = delete;
     ~MarkdownDocumentRepresentation();
 
+    /**
+     * @brief Create descriptor O of the document.
+     *
+     * @param modified  document modification time - 0 to get it from filesystem.
+     */
     Outline* to(
         const std::string& documentPath,
-        const std::string& filePath
+        const std::string& filePath,
+        time_t modified=0
     );
 };
 
@@ -18,6 +18,8 @@
  */
 #include "markdown_lexer_sections.h"
 
+#include <algorithm>
+
 using namespace std;
 
 namespace m8r {
@@ -172,6 +174,7 @@ MarkdownLexerSections::MarkdownLexerSections(const string* filePath)
 {
     this->filePath = filePath;
     this->fileSize = 0;
+    this->fileHash = 0;
     this->inCodeBlock = false;
     this->lastBrTokensOffset = 0;
 }
@@ -199,7 +202,10 @@ MarkdownLexerSections::~MarkdownLexerSections()
 void MarkdownLexerSections::tokenize()
 {
     fileSize = 0;
-    if(fileToLines(filePath, lines, fileSize)) {
+    bool read = fileToLines(filePath, lines, fileSize);
+    // lines are hashed before parser moves them away
+    fileHash = linesHash64(lines);
+    if(read) {
         // IMPROVE body of this function can be shared by file & text
         lexems.push_back(MarkdownSymbolTable::LEXEM.BEGIN_DOC);
 
@@ -856,4 +862,20 @@ string* MarkdownLexerSections::getText(const MarkdownLexem* lexem)
     return nullptr;
 }
 
+const char* MarkdownLexerSections::getTextSpan(const MarkdownLexem* lexem, size_t& length) const
+{
+    if(lexem!=nullptr && lexem->getOff()<lines.size() && lines[lexem->getOff()]!=nullptr) {
+        const string* line = lines[lexem->getOff()];
+        if(lexem->getLng()==MarkdownLexem::WHOLE_LINE) {
+            length = line->size();
+            return line->data();
+        } else if(lexem->getIdx()<=line->size()) {
+            length = std::min<size_t>(lexem->getLng(), line->size()-lexem->getIdx());
+            return line->data()+lexem->getIdx();
+        }
+    }
+    length = 0;
+    return nullptr;
+}
+
 } // m8r namespace
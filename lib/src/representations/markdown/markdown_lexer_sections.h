@@ -110,6 +110,8 @@ private:
     bool inCodeBlock;
 
     size_t fileSize;
+    // hash of file lines (see linesHash64())
+    uint64_t fileHash;
     std::vector<std::string*> lines;
     // IMPROVE prepare a LexemPool: vector + MarkdownLexem[1000] and allocate from there (performance)
     std::vector<MarkdownLexem*> lexems;
@@ -130,9 +132,15 @@ public:
      * Returns text, caller is expected to destroy it.
      */
     std::string* getText(const MarkdownLexem*);
+    /**
+     * Returns pointer to lexem's text within its line and sets text length - no copy
+     * is made. Text is valid until the line is moved away by getText().
+     */
+    const char* getTextSpan(const MarkdownLexem* lexem, size_t& length) const;
 
     void setFilePath(const std::string*& filePath) { this->filePath = filePath; }
     size_t getFileSize() const { return fileSize; }
+    uint64_t getFileHash() const { return fileHash; }
     const std::vector<MarkdownLexem*>& getLexems() const { return lexems; }
     const std::vector<std::string*>& getLines() const { return lines; }
     const MarkdownSymbolTable& getSymbolTable() const { return symbolTable; }
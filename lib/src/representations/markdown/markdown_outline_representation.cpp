@@ -19,6 +19,7 @@
 #include "markdown_outline_representation.h"
 
 #include "../../mind/ontology/ontology.h"
+#include "../../gear/instrumentation.h"
 
 namespace m8r {
 
@@ -103,8 +104,24 @@ Note* MarkdownOutlineRepresentation::note(vector<MarkdownAstNodeSection*>* ast,
 
 Outline* MarkdownOutlineRepresentation::outline(const File& file)
 {
+    return outline(file, fileModificationTime(&file.name));
+}
+
+Outline* MarkdownOutlineRepresentation::outline(
+    const File& file, time_t modified, bool skeleton, uint64_t* fileHash)
+{
+    M8R_INSTRUMENTATION_TIMER(timer, "markdown.parse");
+
     MarkdownDocument md{&file.name};
-    md.from();
+    md.from(modified, skeleton);
+    if(fileHash) {
+        *fileHash = md.getFileHash();
+    }
+    return outline(md);
+}
+
+Outline* MarkdownOutlineRepresentation::outline(MarkdownDocument& md)
+{
     vector<MarkdownAstNodeSection*>* ast = md.moveAst();
 
     Outline* o = outline(ast);
@@ -113,7 +130,6 @@ Outline* MarkdownOutlineRepresentation::outline(const File& file)
         o->setKey(*md.getFilePath());
         o->setBytesize(md.getFileSize());
         o->completeProperties(md.getModified());
-        o->setModifiedPretty(datetimeToPrettyHtml(o->getModified()));
     }
     return o;
 }
@@ -436,7 +452,7 @@ string* MarkdownOutlineRepresentation::to(Outline* outline, string* md)
 
 }
 
-string MarkdownOutlineRepresentation::to(const vector<const Tag*>* tags)
+string MarkdownOutlineRepresentation::to(const TagVector* tags)
 {
     string s;
     if(tags->size()) {
@@ -460,7 +476,7 @@ string* MarkdownOutlineRepresentation::toLink(const string& label, const string&
     return md;
 }
 
-string MarkdownOutlineRepresentation::to(const vector<Link*>& links)
+string MarkdownOutlineRepresentation::to(const LinkVector& links)
 {
     string s;
     if(links.size()) {
@@ -79,6 +79,20 @@ public:
     virtual ~MarkdownOutlineRepresentation();
 
     virtual Outline* outline(const filesystem::File& file) override;
+    /**
+     * @brief Parse Outline from file whose modification time is already known.
+     *
+     * Skeleton Outline has Notes w/o descriptions (lazy memory loads them on demand).
+     * Hash of the parsed file content is set to fileHash (if not nullptr).
+     */
+    Outline* outline(
+        const filesystem::File& file, time_t modified, bool skeleton=false, uint64_t* fileHash=nullptr);
+    /**
+     * @brief Create Outline from already parsed Markdown document (no I/O).
+     *
+     * Document can be parsed in any thread, Outline must be created by the ontology owner.
+     */
+    Outline* outline(MarkdownDocument& md);
     virtual Outline* header(const std::string* md);
     virtual Note* note(const filesystem::File& file);
     virtual Note* note(const std::string* md);
@@ -93,7 +107,7 @@ public:
     virtual std::string* to(const Note* note, std::string* md, bool includeMetadata=true, bool autolinking=false);
     virtual std::string* toDescription(const Note* note, std::string* md, bool autolinking=false);
 
-    static std::string to(const std::vector<const Tag*>* tags);
+    static std::string to(const TagVector* tags);
     static std::string* toLink(const std::string& label, const std::string& link, std::string* md);
 
     /**
@@ -107,7 +121,7 @@ private:
     Outline* outline(std::vector<MarkdownAstNodeSection*>* ast);
     Note* note(std::vector<MarkdownAstNodeSection*>* ast, const size_t astindex=0, Outline* outline=nullptr);
     void toHeader(Outline* outline, std::string* md);
-    std::string to(const std::vector<Link*>& links);
+    std::string to(const LinkVector& links);
 };
 
 } // m8r namespace
@@ -18,6 +18,9 @@
  */
 
 #include "markdown_parser_sections.h"
+
+#include <algorithm>
+#include <cstring>
 #include "../../definitions.h"
 
 const char *DEFAULT_NAME= "A thing";
@@ -32,8 +35,10 @@ namespace m8r {
  * MarkdownParserSections
  */
 
-MarkdownParserSections::MarkdownParserSections(MarkdownLexerSections& lexer)
-    : lexer(lexer)
+MarkdownParserSections::MarkdownParserSections(MarkdownLexerSections& lexer, bool skeleton)
+    : lexer(lexer),
+      metadataExist{false},
+      skeleton{skeleton}
 {
     this->ast = nullptr;
 }
@@ -64,528 +69,510 @@ void MarkdownParserSections::parse()
     }
 }
 
-const MarkdownLexem* MarkdownParserSections::lookahead(size_t offset)
-{
-    if(offset<lexer.size()) {
-        return lexer[offset];
-    } else {
-        return nullptr;
-    }
-}
-
-const MarkdownLexem* MarkdownParserSections::lookahead(MarkdownLexemType lexemType, size_t offset)
+bool MarkdownParserSections::isSection(const MarkdownLexem* lexem)
 {
-    if(offset<lexer.size() && lexer[offset]->getType()==lexemType) {
-        return lexer[offset];
-    } else {
-        return nullptr;
-    }
+    return lexem->getType()==MarkdownLexemType::SECTION
+             ||
+           lexem->getType()==MarkdownLexemType::SECTION_equals
+             ||
+           lexem->getType()==MarkdownLexemType::SECTION_hyphens;
 }
 
-const MarkdownLexem* MarkdownParserSections::lookaheadNot(MarkdownLexemType lexemType, size_t offset)
+void MarkdownParserSections::skipWhitespaces(size_t& i)
 {
-    if(offset<lexer.size() && lexer[offset]->getType()!=lexemType) {
-        return lexer[offset];
-    } else {
-        return nullptr;
+    while(i<lexer.size() && lexer[i]->getType()==MarkdownLexemType::WHITESPACES) {
+        ++i;
     }
 }
 
-const MarkdownLexem* MarkdownParserSections::lookaheadSection(size_t offset)
+bool MarkdownParserSections::isBodyParsed() const
 {
-    if(offset<lexer.size()
-         &&
-      (lexer[offset]->getType()==MarkdownLexemType::SECTION
-         ||
-       lexer[offset]->getType()==MarkdownLexemType::SECTION_equals
-         ||
-       lexer[offset]->getType()==MarkdownLexemType::SECTION_hyphens))
-    {
-        return lexer[offset];
-    } else {
-        return nullptr;
-    }
+    // body of the section which is being parsed: preamble or the first section ~ O
+    return !skeleton
+        || ast->empty()
+        || (ast->size()==1 && ast->at(0)->isPreambleSection());
 }
 
-const MarkdownLexem* MarkdownParserSections::lookaheadNotSection(size_t offset)
+/*
+ * The grammar is parsed by a state machine in a single pass over lexems - every lexem
+ * is visited once (no lookahead re-scans) and section body lines are moved from lexer
+ * to the AST as they are visited:
+ *
+ *   BODY ... lines of preamble/section body
+ *   SECTION ... section lexem (# or post declared section)
+ *   SECTION_NAME ... section name after #
+ *   SECTION_METADATA ... optional HTML comment w/ metadata after section name
+ *   METADATA_PROPERTY ... metadata properties
+ *   SECTION_EOL ... skip the rest of section line
+ *
+ * i is always the index of the next lexem to be consumed.
+ */
+void MarkdownParserSections::markdownRule()
 {
-    if(offset<lexer.size()
-         &&
-      lexer[offset]->getType()!=MarkdownLexemType::SECTION
-         &&
-      lexer[offset]->getType()!=MarkdownLexemType::SECTION_equals
-         &&
-      lexer[offset]->getType()!=MarkdownLexemType::SECTION_hyphens)
-    {
-        return lexer[offset];
+    enum class State {
+        BODY,
+        SECTION,
+        SECTION_NAME,
+        SECTION_METADATA,
+        METADATA_PROPERTY,
+        SECTION_EOL,
+        DONE
+    };
+
+    const size_t n = lexer.size();
+    // skip BEGIN_DOC
+    size_t i = 1;
+
+    MarkdownAstNodeSection* section = nullptr;
+    vector<string*>* body = nullptr;
+    unsigned depth = 0;
+    string* name;
+    time_t t;
+    vector<string*>* tags;
+    vector<Link*>* links;
+    // false if body lines are left in lexer (skeleton)
+    bool parseBody = true;
+
+    State state;
+    if(i<n && isSection(lexer[i])) {
+        state = State::SECTION;
     } else {
-        return nullptr;
+        section = new MarkdownAstNodeSection();
+        section->setPreamble();
+        body = new vector<string*>();
+        state = State::BODY;
     }
-}
 
-void MarkdownParserSections::markdownRule()
-{
-    MarkdownAstNodeSection* section;
-    size_t offset = 0;
+    while(i<n && state!=State::DONE) {
+        const MarkdownLexem* l = lexer[i];
+        switch(state) {
+        case State::BODY:
+            switch(l->getType()) {
+            case MarkdownLexemType::SECTION:
+            case MarkdownLexemType::SECTION_equals:
+            case MarkdownLexemType::SECTION_hyphens:
+                section->setBody(body);
+                ast->push_back(section);
+                section = nullptr;
+                body = nullptr;
+                state = State::SECTION;
+                break;
+            case MarkdownLexemType::LINE:
+                if(parseBody && (name=lexer.getText(l))!=nullptr) {
+                    body->push_back(name);
+                }
+                // skip line's BR
+                if(++i<n && lexer[i]->getType()==MarkdownLexemType::BR) {
+                    ++i;
+                }
+                break;
+            case MarkdownLexemType::BR:
+                // empty line
+                if(parseBody && (name=lexer.getText(l))!=nullptr) {
+                    body->push_back(name);
+                }
+                ++i;
+                break;
+            default:
+                // IMPROVE skipping unknown lexems
+                ++i;
+            }
+            break;
 
-    preambleRule(offset);
-    while((section=sectionRule(offset))!=nullptr) {
-        ast->push_back(section);
-    }
-}
+        case State::SECTION:
+            if(l->getType()==MarkdownLexemType::SECTION) {
+                depth = l->getDepth();
+                ++i;
+                state = State::SECTION_NAME;
+            } else {
+                // lexer ensures existence of LINE and BR right after SECTION_*
+                depth = l->getType()==MarkdownLexemType::SECTION_equals?0:1;
+                section = new MarkdownAstNodeSection(i+1<n?lexer.getText(lexer[i+1]):nullptr);
+                section->setPostDeclaredSection();
+                section->setDepth(depth);
+                // skip SECTION_*, LINE and BR
+                i += 3;
+                body = new vector<string*>();
+                parseBody = isBodyParsed();
+                state = State::BODY;
+            }
+            break;
 
-void MarkdownParserSections::preambleRule(size_t& offset)
-{
-    // IMPROVE test w/o calling method doing the same checks
-    if(lookaheadSection(offset+1) == nullptr) {
-        MarkdownAstNodeSection* result = new MarkdownAstNodeSection();
-        result->setPreamble();
-        result->setBody(sectionBodyRule(offset));
-        ast->push_back(result);
-    }
-}
+        case State::SECTION_NAME:
+            switch(l->getType()) {
+            case MarkdownLexemType::WHITESPACES:
+                ++i;
+                break;
+            case MarkdownLexemType::TEXT:
+                section = new MarkdownAstNodeSection(sectionNameRule(i));
+                state = State::SECTION_METADATA;
+                break;
+            case MarkdownLexemType::HTML_COMMENT_BEGIN:
+            case MarkdownLexemType::BR:
+                // section w/ empty name like '##   <!-- Metadata... ' or '##   '
+                section = new MarkdownAstNodeSection(new string{});
+                state = State::SECTION_METADATA;
+                break;
+            case MarkdownLexemType::SECTION:
+            case MarkdownLexemType::SECTION_equals:
+            case MarkdownLexemType::SECTION_hyphens:
+                // section w/o name - the rest of the document cannot be parsed
+                state = State::DONE;
+                break;
+            default:
+                // ... this is most probably timebomb - certain part of the document might be skipped
+                ++i;
+            }
+            break;
 
-MarkdownAstNodeSection* MarkdownParserSections::sectionRule(size_t& offset)
-{
-    if(offset+1<lexer.size()) {
-        MarkdownAstNodeSection* result;
-        unsigned depth;
-        switch(lexer[offset+1]->getType()) {
-        case MarkdownLexemType::SECTION:
-            depth=lexer[offset+1]->getDepth();
-            result=sectionHeaderRule(++offset);
-            if(result!=nullptr) {
-                // detect trailing spaces (no metadata) like ### Section w/ depth 3 ###
-                string* n = result->getText();
-                if(n && n->size()>=5 && n->at(n->size()-1)=='#')
-                {
-                    bool t = true;
-                    if(depth) {
-                        for(uint i=n->size()-2; i>n->size()-2-depth; i--) {
-                            if(n->at(i)!='#') {
-                                t = false;
-                                break;
-                            }
-                        }
-                    }
-                    if(t && n->size()>depth+1 && n->at(n->size()-1-1-depth)==' ') {
-                        result->setTrailingHashesSection();
-                        n->assign(n->substr(0, n->size()-(1+depth+1)));
-                    }
+        case State::SECTION_METADATA:
+            skipWhitespaces(i);
+            state = State::SECTION_EOL;
+            if(i<n && lexer[i]->getType()==MarkdownLexemType::HTML_COMMENT_BEGIN) {
+                skipWhitespaces(++i);
+                if(i<n && lexer[i]->getType()==MarkdownLexemType::META_BEGIN) {
+                    skipWhitespaces(++i);
+                    metadataExist = true;
+                    state = State::METADATA_PROPERTY;
                 }
+            }
+            break;
 
-                result->setDepth(depth);
-                result->setBody(sectionBodyRule(offset));
-                return result;
+        case State::METADATA_PROPERTY: {
+            MarkdownAstSectionMetadata& meta = section->getMetadata();
+            ++i;
+            switch(l->getType()) {
+            case MarkdownLexemType::META_PROPERTY_created:
+                if((t = parsePropertyValueTimestamp(i))!=0) {
+                    meta.setCreated(t);
+                }
+                break;
+            case MarkdownLexemType::META_PROPERTY_importance:
+                meta.setImportance(parsePropertyValueFraction(i));
+                break;
+            case MarkdownLexemType::META_PROPERTY_tags:
+                tags = parsePropertyValueTags(i);
+                meta.setTags(tags);
+                delete tags;
+                break;
+            case MarkdownLexemType::META_PROPERTY_modified:
+                if((t = parsePropertyValueTimestamp(i))!=0) {
+                    meta.setModified(t);
+                }
+                break;
+            case MarkdownLexemType::META_PROPERTY_progress:
+                meta.setProgress(parsePropertyValuePercent(i));
+                break;
+            case MarkdownLexemType::META_PROPERTY_read:
+                if((t = parsePropertyValueTimestamp(i))!=0) {
+                    meta.setRead(t);
+                }
+                break;
+            case MarkdownLexemType::META_PROPERTY_reads:
+                meta.setReads(parsePropertyValueInteger(i));
+                break;
+            case MarkdownLexemType::META_PROPERTY_revision:
+                meta.setRevision(parsePropertyValueInteger(i));
+                break;
+            case MarkdownLexemType::META_PROPERTY_type:
+                meta.setType(parsePropertyValueString(i));
+                break;
+            case MarkdownLexemType::META_PROPERTY_urgency:
+                meta.setUrgency(parsePropertyValueFraction(i));
+                break;
+            case MarkdownLexemType::META_PROPERTY_scope:
+                meta.setTimeScope(parsePropertyValueTimeScope(i));
+                break;
+            case MarkdownLexemType::META_PROPERTY_deadline:
+                if((t = parsePropertyValueTimestamp(i))!=0) {
+                    meta.setDeadline(t);
+                }
+                break;
+            case MarkdownLexemType::META_PROPERTY_links:
+                links = parsePropertyValueLinks(i);
+                meta.setLinks(links);
+                delete links;
+                break;
+            default:
+                // end of metadata (HTML comment end, unknown property, ...)
+                state = State::SECTION_EOL;
+                break;
+            }
+            if(i<n && lexer[i]->getType()==MarkdownLexemType::META_PROPERTY_DELIMITER) {
+                ++i;
             }
+            skipWhitespaces(i);
             break;
-        case MarkdownLexemType::SECTION_equals:
-        case MarkdownLexemType::SECTION_hyphens:
-            // lexer ensures existence of LINE and BR right after SECTION_*
-            depth = lexer[offset+1]->getType()==MarkdownLexemType::SECTION_equals?0:1;
-            ++offset; // move to point to SECTION_*
-            result = new MarkdownAstNodeSection(lexer.getText(lexer[++offset])); // move to LINE
-            result->setPostDeclaredSection();
-            result->setDepth(depth);
-            ++offset; // skip BR
-            result->setBody(sectionBodyRule(offset));
-            return result;
-        default:
-            return nullptr;
         }
-    }
-    return nullptr;
-}
-
-void MarkdownParserSections::skipBr(size_t& offset)
-{
-    // skip section line's BR
-    if(lookahead(MarkdownLexemType::BR, offset + 1) != nullptr) {
-        ++offset;
-    }
-}
 
-MarkdownAstNodeSection* MarkdownParserSections::sectionHeaderRule(size_t& offset)
-{
-    const MarkdownLexem* next;
-    string* name;
-    // seek to section token - may skip a part of the document
-    while((next=lookahead(offset+1))!=nullptr
-            &&
-          next->getType()!=MarkdownLexemType::SECTION && next->getType()!=MarkdownLexemType::SECTION_equals && next->getType()!=MarkdownLexemType::SECTION_hyphens)
-    {
-        if((name=sectionNameRule(offset))!=nullptr) {
-            MarkdownAstNodeSection* result = new MarkdownAstNodeSection(name);
-            if(sectionMetadataRule(result->getMetadata(), offset)) {
-                // skip section line's BR
-                skipBr(offset);
-                // TODO
-                return result;
+        case State::SECTION_EOL:
+            if(l->getType()==MarkdownLexemType::BR) {
+                // section line's BR
+                ++i;
+                sectionHeaderRule(section, depth);
+                body = new vector<string*>();
+                parseBody = isBodyParsed();
+                state = State::BODY;
             } else {
-                // skip section line's BR
-                skipBr(offset);
-                return result;
+                ++i;
             }
-        } else {
-            offset++;
-        }
-    }
-    return nullptr;
-}
-
-void MarkdownParserSections::skipWhitespaces(size_t& offset)
-{
-    while(lookahead(MarkdownLexemType::WHITESPACES,offset+1)!=nullptr) {
-        ++offset;
-    }
-}
+            break;
 
-void MarkdownParserSections::skipEOL(size_t& offset)
-{
-    while(lookaheadNot(MarkdownLexemType::BR,offset+1)!=nullptr) {
-        ++offset;
+        case State::DONE:
+            break;
+        }
     }
-}
 
-void MarkdownParserSections::skipSectionBody(size_t& offset)
-{
-    while(lookaheadNotSection(offset+1)!=nullptr) {
-        ++offset;
+    // finish the last section
+    switch(state) {
+    case State::BODY:
+        section->setBody(body);
+        ast->push_back(section);
+        break;
+    case State::SECTION_METADATA:
+    case State::METADATA_PROPERTY:
+    case State::SECTION_EOL:
+        sectionHeaderRule(section, depth);
+        section->setBody(new vector<string*>());
+        ast->push_back(section);
+        break;
+    default:
+        // section w/o name
+        ;
     }
 }
 
-string* MarkdownParserSections::sectionNameRule(size_t& offset)
+void MarkdownParserSections::sectionHeaderRule(MarkdownAstNodeSection* section, unsigned depth)
 {
-    skipWhitespaces(offset);
-    const MarkdownLexem* next;
-    if((next=lookahead(offset+1))!=nullptr
-          &&
-        next->getType()==MarkdownLexemType::TEXT)
+    // detect trailing spaces (no metadata) like ### Section w/ depth 3 ###
+    string* n = section->getText();
+    if(n && n->size()>=5 && n->at(n->size()-1)=='#')
     {
-        string* name = new string();
-        string* text = nullptr;
-        while((next=lookahead(offset+1))!=nullptr
-                &&
-              (next->getType()==MarkdownLexemType::WHITESPACES || next->getType()==MarkdownLexemType::TEXT))
-        {
-            text = lexer.getText(next);
-            if(text!=nullptr) {
-                name->append(*text);
-                delete text;
-                text = nullptr;
-            } else {
-                if(name->size()) {
-                    name->append(" ");
+        bool t = true;
+        if(depth) {
+            for(uint i=n->size()-2; i>n->size()-2-depth; i--) {
+                if(n->at(i)!='#') {
+                    t = false;
+                    break;
                 }
             }
-            ++offset;
-        }
-        text = lexer.getText(next);
-        if(text!=nullptr) {
-            if(next->getType()==MarkdownLexemType::WHITESPACES) {
-                name->erase(name->size()-1, text->size());
-            }
-            delete text;
-            text = nullptr;
-        }
-        return name;
-    } else {
-        // handle section w/ empty name like: '##   <!-- Metadata... '
-        if(next->getType()==MarkdownLexemType::HTML_COMMENT_BEGIN) {
-            return new string();
         }
-
-        // handle section w/ empty name, no metadata and traling spaces like: '##   '
-        if(next->getType()==MarkdownLexemType::BR) {
-            return new string();
+        if(t && n->size()>depth+1 && n->at(n->size()-1-1-depth)==' ') {
+            section->setTrailingHashesSection();
+            n->assign(n->substr(0, n->size()-(1+depth+1)));
         }
-
-        // ... this is most probably timebomb - certain part of the document might be skipped
-        return nullptr;
     }
+
+    section->setDepth(depth);
 }
 
-bool MarkdownParserSections::sectionMetadataRule(
-        MarkdownAstSectionMetadata& meta,
-        size_t& offset)
+string* MarkdownParserSections::sectionNameRule(size_t& i)
 {
-    skipWhitespaces(offset);
-    const MarkdownLexem* next;
-    if((next=lookahead(MarkdownLexemType::HTML_COMMENT_BEGIN,offset+1))!=nullptr) {
-        skipWhitespaces(++offset);
-        if((next=lookahead(MarkdownLexemType::META_BEGIN,offset+1))!=nullptr) {
-            skipWhitespaces(++offset);
-            bool done=false;
-            time_t t;
-            vector<string*>* tags;
-            vector<Link*>* links;
-            while(!done && (next=lookahead(offset+1))!=nullptr) {
-                offset++;
-                switch(next->getType()) {
-                case MarkdownLexemType::META_PROPERTY_created:
-                    if((t = parsePropertyValueTimestamp(offset))!=0) {
-                        meta.setCreated(t);
-                    }
-                    break;
-                case MarkdownLexemType::META_PROPERTY_importance:
-                    meta.setImportance(parsePropertyValueFraction(offset));
-                    break;
-                case MarkdownLexemType::META_PROPERTY_tags:
-                    tags = parsePropertyValueTags(offset);
-                    meta.setTags(tags);
-                    delete tags;
-                    break;
-                case MarkdownLexemType::META_PROPERTY_modified:
-                    if((t = parsePropertyValueTimestamp(offset))!=0) {
-                        meta.setModified(t);
-                    }
-                    break;
-                case MarkdownLexemType::META_PROPERTY_progress:
-                    meta.setProgress(parsePropertyValuePercent(offset));
-                    break;
-                case MarkdownLexemType::META_PROPERTY_read:
-                    if((t = parsePropertyValueTimestamp(offset))!=0) {
-                        meta.setRead(t);
-                    }
-                    break;
-                case MarkdownLexemType::META_PROPERTY_reads:
-                    meta.setReads(parsePropertyValueInteger(offset));
-                    break;
-                case MarkdownLexemType::META_PROPERTY_revision:
-                    meta.setRevision(parsePropertyValueInteger(offset));
-                    break;
-                case MarkdownLexemType::META_PROPERTY_type:
-                    meta.setType(parsePropertyValueString(offset));
-                    break;
-                case MarkdownLexemType::META_PROPERTY_urgency:
-                    meta.setUrgency(parsePropertyValueFraction(offset));
-                    break;
-                case MarkdownLexemType::META_PROPERTY_scope:
-                    meta.setTimeScope(parsePropertyValueTimeScope(offset));
-                    break;
-                case MarkdownLexemType::META_PROPERTY_deadline:
-                    if((t = parsePropertyValueTimestamp(offset))!=0) {
-                        meta.setDeadline(t);
-                    }
-                    break;
-                case MarkdownLexemType::META_PROPERTY_links:
-                    links = parsePropertyValueLinks(offset);
-                    meta.setLinks(links);
-                    delete links;
-                    break;
-                default:
-                    done=true;
-                    break;
-                }
-                if(lookahead(MarkdownLexemType::META_PROPERTY_DELIMITER, offset+1)) {
-                    ++offset;
-                }
-                skipWhitespaces(offset);
+    string* name = new string();
+    const char* text;
+    size_t length;
+    while(i<lexer.size()
+            &&
+          (lexer[i]->getType()==MarkdownLexemType::WHITESPACES || lexer[i]->getType()==MarkdownLexemType::TEXT))
+    {
+        if((text=lexer.getTextSpan(lexer[i], length))!=nullptr) {
+            name->append(text, length);
+        } else {
+            if(name->size()) {
+                name->append(" ");
             }
-
-            metadataExist = true;
         }
+        ++i;
     }
-
-    skipEOL(offset);
-    return false;
+    return name;
 }
 
-const MarkdownLexem* MarkdownParserSections::parsePropertyValue(size_t& offset)
+const MarkdownLexem* MarkdownParserSections::parsePropertyValue(size_t& i)
 {
-    if(lookahead(MarkdownLexemType::META_NAMEVALUE_DELIMITER, offset+1)!=nullptr) {
-        skipWhitespaces(++offset);
-        const MarkdownLexem* result;
-        if((result=lookahead(MarkdownLexemType::META_PROPERTY_VALUE, offset+1))!=nullptr) {
-            skipWhitespaces(++offset);
+    if(i<lexer.size() && lexer[i]->getType()==MarkdownLexemType::META_NAMEVALUE_DELIMITER) {
+        skipWhitespaces(++i);
+        if(i<lexer.size() && lexer[i]->getType()==MarkdownLexemType::META_PROPERTY_VALUE) {
+            const MarkdownLexem* result = lexer[i];
+            skipWhitespaces(++i);
             return result;
         }
     }
     return nullptr;
 }
 
-time_t MarkdownParserSections::parsePropertyValueTimestamp(size_t& offset)
+/*
+ * Copy value to NUL terminated buffer so that it can be parsed by C functions w/o allocation.
+ */
+const char* MarkdownParserSections::parsePropertyValue(size_t& i, char* buffer, size_t bufferSize, size_t& length)
 {
-    const MarkdownLexem* valueLexem = parsePropertyValue(offset);
+    const MarkdownLexem* valueLexem = parsePropertyValue(i);
     if(valueLexem != nullptr) {
-        struct tm tm;
-        // C-style initialization as GCC doesn't like {}
-        memset(&tm, 0, sizeof tm);
-        string* s = lexer.getText(valueLexem);
-        datetimeFrom(s->c_str(), &tm);
-        delete s;
-        time_t result = datetimeSeconds(&tm);
-        return result;
+        const char* value = lexer.getTextSpan(valueLexem, length);
+        if(value != nullptr) {
+            length = std::min(length, bufferSize-1);
+            memcpy(buffer, value, length);
+            buffer[length] = 0;
+            return buffer;
+        }
+    }
+    length = 0;
+    return nullptr;
+}
+
+time_t MarkdownParserSections::parsePropertyValueTimestamp(size_t& i)
+{
+    char buffer[PROPERTY_VALUE_BUFFER_SIZE];
+    size_t length;
+    if(parsePropertyValue(i, buffer, sizeof(buffer), length) != nullptr) {
+        return datetimeParse(buffer, length);
     }
     return 0;
 }
 
-int MarkdownParserSections::parsePropertyValueInteger(size_t& offset)
+int MarkdownParserSections::parsePropertyValueInteger(size_t& i)
 {
-    const MarkdownLexem* valueLexem = parsePropertyValue(offset);
-    if(valueLexem != nullptr) {
-        string* s = lexer.getText(valueLexem);
-        // IMPROVE do this in C++
-        int result = atoi(s->c_str());
-        delete s;
-        return result;
+    char buffer[PROPERTY_VALUE_BUFFER_SIZE];
+    size_t length;
+    if(parsePropertyValue(i, buffer, sizeof(buffer), length) != nullptr) {
+        return atoi(buffer);
     }
     return 0;
 }
 
-vector<string*>* MarkdownParserSections::parsePropertyValueTags(size_t& offset)
+vector<string*>* MarkdownParserSections::parsePropertyValueTags(size_t& i)
 {
-    const MarkdownLexem* valueLexem = parsePropertyValue(offset);
+    const MarkdownLexem* valueLexem = parsePropertyValue(i);
     if(valueLexem != nullptr) {
-        string* s = lexer.getText(valueLexem);
-        if(s!=nullptr) {
-            if(s->size()) {
-                vector<string*>* result = new vector<string*>();
-                string buffer;
-                bool ws{};
-                for(size_t i=0; i<s->size(); i++) {
-                    switch(s->at(i)) {
-                    case ' ':
-                        ws = true;
-                        break;
-                    case ',':
-                        if(buffer.size()) {
-                            result->push_back(new string(buffer));
-                            buffer.clear();
-                        }
-                        ws = false;
-                        break;
-                    default:
-                        if(ws && buffer.size()) {
-                            buffer += ' ';
+        size_t length;
+        const char* s = lexer.getTextSpan(valueLexem, length);
+        if(s!=nullptr && length) {
+            vector<string*>* result = new vector<string*>();
+            // tag is created only once it's complete - no intermediate strings
+            string* tag = nullptr;
+            bool ws{};
+            for(size_t c=0; c<length; c++) {
+                switch(s[c]) {
+                case ' ':
+                    ws = true;
+                    break;
+                case ',':
+                    if(tag) {
+                        result->push_back(tag);
+                        tag = nullptr;
+                    }
+                    ws = false;
+                    break;
+                default:
+                    if(tag) {
+                        if(ws) {
+                            *tag += ' ';
                         }
-                        buffer += s->at(i);
-                        ws = false;
-                        break;
+                    } else {
+                        tag = new string{};
                     }
+                    *tag += s[c];
+                    ws = false;
+                    break;
                 }
-                if(buffer.size()) {
-                    result->push_back(new string(buffer));
-                    buffer.clear();
-                }
-                delete s;
-                return result;
-            } else {
-                delete s;
             }
+            if(tag) {
+                result->push_back(tag);
+            }
+            return result;
         }
     }
     return nullptr;
 }
 
-string* MarkdownParserSections::parsePropertyValueString(size_t& offset)
+string* MarkdownParserSections::parsePropertyValueString(size_t& i)
 {
-    const MarkdownLexem* valueLexem = parsePropertyValue(offset);
+    const MarkdownLexem* valueLexem = parsePropertyValue(i);
     if(valueLexem != nullptr) {
-        string* s = lexer.getText(valueLexem);
-        if(s!=nullptr) {
-            if(s->size()) {
-                return s;
-            } else {
-                delete s;
-            }
+        size_t length;
+        const char* s = lexer.getTextSpan(valueLexem, length);
+        if(s!=nullptr && length) {
+            return new string{s, length};
         }
     }
     return nullptr;
 }
 
-int MarkdownParserSections::parsePropertyValueFraction(size_t& offset)
+int MarkdownParserSections::parsePropertyValueFraction(size_t& i)
 {
-    const MarkdownLexem* valueLexem = parsePropertyValue(offset);
+    const MarkdownLexem* valueLexem = parsePropertyValue(i);
     if(valueLexem != nullptr) {
-        string* s = lexer.getText(valueLexem);
-        if(s!=nullptr) {
-            if(s->size()) {
-                int r = (int)s->at(0) - '0';
-                delete s;
-                return r;
-            } else {
-                delete s;
-            }
+        size_t length;
+        const char* s = lexer.getTextSpan(valueLexem, length);
+        if(s!=nullptr && length) {
+            return (int)s[0] - '0';
         }
     }
     return 0;
 }
 
-int MarkdownParserSections::parsePropertyValuePercent(size_t& offset)
+int MarkdownParserSections::parsePropertyValuePercent(size_t& i)
 {
-    const MarkdownLexem* valueLexem = parsePropertyValue(offset);
-    if(valueLexem != nullptr) {
-        string* s = lexer.getText(valueLexem);
-        if(s!=nullptr) {
-            if(s->size()) {
-                s->resize(s->size()-1);
-                int result = atoi(s->c_str());
-                delete s;
-                return result;
-            } else {
-                delete s;
-            }
-        }
+    char buffer[PROPERTY_VALUE_BUFFER_SIZE];
+    size_t length;
+    if(parsePropertyValue(i, buffer, sizeof(buffer), length) != nullptr && length) {
+        // strip %
+        buffer[length-1] = 0;
+        return atoi(buffer);
     }
     return 0;
 }
 
-TimeScope MarkdownParserSections::parsePropertyValueTimeScope(size_t& offset)
+TimeScope MarkdownParserSections::parsePropertyValueTimeScope(size_t& i)
 {
-    const MarkdownLexem* valueLexem = parsePropertyValue(offset);
+    const MarkdownLexem* valueLexem = parsePropertyValue(i);
     TimeScope result{};
     if(valueLexem != nullptr) {
-        string* s = lexer.getText(valueLexem);
-        if(s!=nullptr) {
-            if(s->size()) {
-                TimeScope::fromString(*s, result);
-            }
-            delete s;
+        size_t length;
+        const char* s = lexer.getTextSpan(valueLexem, length);
+        if(s!=nullptr && length) {
+            TimeScope::fromString(string{s, length}, result);
         }
     }
     return result;
 }
 
-Link* MarkdownParserSections::parseLink(const std::string& s)
+Link* MarkdownParserSections::parseLink(const char* s, size_t length)
 {
-    if(s.size()>4 && s[0]=='[' && s[s.size()-1]==')') {
-        size_t i;
-        if((i=s.find("](")) != std::string::npos) {
-            return new Link{s.substr(1,i-1),s.substr(i+2,s.size()-3-i)};
+    if(length>4 && s[0]=='[' && s[length-1]==')') {
+        for(size_t i=1; i+1<length; i++) {
+            if(s[i]==']' && s[i+1]=='(') {
+                return new Link{string{s+1, i-1}, string{s+i+2, length-3-i}};
+            }
         }
     }
     return nullptr;
 }
 
-vector<Link*>* MarkdownParserSections::parsePropertyValueLinks(size_t& offset)
+vector<Link*>* MarkdownParserSections::parsePropertyValueLinks(size_t& i)
 {
-    const MarkdownLexem* valueLexem = parsePropertyValue(offset);
+    const MarkdownLexem* valueLexem = parsePropertyValue(i);
     if(valueLexem != nullptr) {
-        string* t = lexer.getText(valueLexem);
-        if(t != nullptr) {
-            if(t->size()) {
-                vector<Link*>* result = new vector<Link*>{};
-
-                istringstream split(*t);
-                string s;
-                while(getline(split, s, ',')) {
-                    Link* l;
-                    if((l=parseLink(s))!=nullptr) {
-                        result->push_back(l);
-                    }
+        size_t length;
+        const char* t = lexer.getTextSpan(valueLexem, length);
+        if(t!=nullptr && length) {
+            vector<Link*>* result = new vector<Link*>{};
+
+            // split by , in place
+            size_t begin = 0;
+            while(begin < length) {
+                const char* end = static_cast<const char*>(memchr(t+begin, ',', length-begin));
+                size_t e = end?end-t:length;
+                Link* l;
+                if((l=parseLink(t+begin, e-begin))!=nullptr) {
+                    result->push_back(l);
                 }
-                delete t;
+                begin = e+1;
+            }
 
-                if(result->size()) {
-                    return result;
-                } else {
-                    delete result;
-                    return nullptr;
-                }
+            if(result->size()) {
+                return result;
             } else {
-                delete t;
-                return nullptr;
+                delete result;
             }
         }
     }
@@ -593,32 +580,4 @@ vector<Link*>* MarkdownParserSections::parsePropertyValueLinks(size_t& offset)
     return nullptr;
 }
 
-vector<string*>* MarkdownParserSections::sectionBodyRule(size_t& offset)
-{
-    vector<string*>* result = new vector<string*>();
-    string* s;
-    const MarkdownLexem* l;
-    while((l=lookaheadNotSection(offset+1))!=nullptr) {
-        ++offset;
-        switch(l->getType()) {
-        case MarkdownLexemType::LINE:
-            if((s=lexer.getText(l))!=nullptr) {
-                result->push_back(s);
-            }
-            // skip line's BR
-            skipBr(offset);
-            break;
-        case MarkdownLexemType::BR:
-            // empty line
-            if((s=lexer.getText(l))!=nullptr) {
-                result->push_back(s);
-            }
-            break;
-        default:
-            ; // IMPROVE skipping unknown lexems
-        }
-    }
-    return result;
-}
-
 } // m8r namespace
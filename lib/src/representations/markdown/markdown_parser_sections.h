@@ -34,9 +34,13 @@ class MarkdownAstNodeSection;
 class MarkdownAstSectionMetadata;
 
 /**
- * @brief Markdown recursive-descent parser for section-level granularity AST.
+ * @brief Markdown parser for section-level granularity AST.
  *
- * OPTIMISTIC Markdown RDP expects syntactically valid input - it allows simplification
+ * Parser is a state machine which consumes lexems in a single pass - no lookahead
+ * re-scans of lexems, section body lines are moved from lexer to AST and metadata
+ * values are parsed in place from lexer lines.
+ *
+ * OPTIMISTIC Markdown parser expects syntactically valid input - it allows simplification
  * of the parsing process while ensuring reasonable performance as it may implement just
  * minimal robustness.
  */
@@ -52,8 +56,14 @@ private:
      */
     bool metadataExist;
 
+    /**
+     * @brief true if bodies of sections other than preamble and the first
+     * section are skipped (lazy memory learns just Notes skeletons).
+     */
+    bool skeleton;
+
 public:
-    explicit MarkdownParserSections(MarkdownLexerSections& lexer);
+    explicit MarkdownParserSections(MarkdownLexerSections& lexer, bool skeleton=false);
     MarkdownParserSections(const MarkdownParserSections&) = delete;
     MarkdownParserSections(const MarkdownParserSections&&);
     MarkdownParserSections &operator=(const MarkdownParserSections&) = delete;
@@ -73,34 +83,28 @@ public:
     bool hasMetadata() const { return metadataExist; }
 
 private:
-    inline const MarkdownLexem* lookahead(size_t offset);
-    inline const MarkdownLexem* lookahead(MarkdownLexemType, size_t offset);
-    inline const MarkdownLexem* lookaheadNot(MarkdownLexemType, size_t offset);
-    inline const MarkdownLexem* lookaheadSection(size_t offset);
-    inline const MarkdownLexem* lookaheadNotSection(size_t offset);
-    inline void skipWhitespaces(size_t& offset);
-    inline void skipEOL(size_t& offset);
-    inline void skipSectionBody(size_t& offset);
-    inline void skipBr(size_t& offset);
+    // metadata values (timestamps, numbers) are short
+    static constexpr size_t PROPERTY_VALUE_BUFFER_SIZE = 64;
+
+    inline static bool isSection(const MarkdownLexem* lexem);
+    inline void skipWhitespaces(size_t& i);
+    inline bool isBodyParsed() const;
 
     void markdownRule();
-    void preambleRule(size_t& offset);
-    MarkdownAstNodeSection* sectionRule(size_t& offset);
-    MarkdownAstNodeSection* sectionHeaderRule(size_t& offset);
-    std::string* sectionNameRule(size_t& offset);
-    bool sectionMetadataRule(MarkdownAstSectionMetadata& meta, size_t& offset);
-    std::vector<std::string*>* sectionBodyRule(size_t& offset);
-
-    const MarkdownLexem* parsePropertyValue(size_t& offset);
-    time_t parsePropertyValueTimestamp(size_t& offset);
-    int parsePropertyValueInteger(size_t& offset);
-    int parsePropertyValueFraction(size_t& offset);
-    int parsePropertyValuePercent(size_t& offset);
-    TimeScope parsePropertyValueTimeScope(size_t& offset);
-    std::string* parsePropertyValueString(size_t& offset);
-    std::vector<std::string*>* parsePropertyValueTags(size_t& offset);
-    std::vector<Link*>* parsePropertyValueLinks(size_t& offset);
-    Link* parseLink(const std::string& s);
+    void sectionHeaderRule(MarkdownAstNodeSection* section, unsigned depth);
+    std::string* sectionNameRule(size_t& i);
+
+    const MarkdownLexem* parsePropertyValue(size_t& i);
+    const char* parsePropertyValue(size_t& i, char* buffer, size_t bufferSize, size_t& length);
+    time_t parsePropertyValueTimestamp(size_t& i);
+    int parsePropertyValueInteger(size_t& i);
+    int parsePropertyValueFraction(size_t& i);
+    int parsePropertyValuePercent(size_t& i);
+    TimeScope parsePropertyValueTimeScope(size_t& i);
+    std::string* parsePropertyValueString(size_t& i);
+    std::vector<std::string*>* parsePropertyValueTags(size_t& i);
+    std::vector<Link*>* parsePropertyValueLinks(size_t& i);
+    Link* parseLink(const char* s, size_t length);
 };
 
 } // m8r namespace
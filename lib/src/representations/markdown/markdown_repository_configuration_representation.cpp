@@ -240,7 +240,7 @@ Organizer* MarkdownRepositoryConfigurationRepresentation
                 Organizer::createOrganizerKey(
                     keys,
                     c.getMemoryPath(),
-                    Thing::getNextKey(),
+                    std::to_string(Thing::getNextId()),
                     FILE_PATH_SEPARATOR
                 )
             );
@@ -378,9 +378,10 @@ void MarkdownRepositoryConfigurationRepresentation::save(
         MF_DEBUG(
             "Saving repository configuration to file "
             << c->getRepositoryConfigFilePath() << endl);
-        std::ofstream out(c->getRepositoryConfigFilePath());
-        out << md;
-        out.close();
+        if(!stringToFileAtomic(c->getRepositoryConfigFilePath(), md)) {
+            cerr << "Error: unable to save repository configuration to "
+                 << c->getRepositoryConfigFilePath() << endl;
+        }
     } else {
         MF_DEBUG(
             "Saving repository configuration to File " << file->getName() << endl);
@@ -0,0 +1,134 @@
+/*
+ benchmark_report.cpp     MindForger thinking notebook
+
+ Copyright (C) 2016-2025 Martin Dvorak <martin.dvorak@mindforger.com>
+
+ This program is free software; you can redistribute it and/or
+ modify it under the terms of the GNU General Public License
+ as published by the Free Software Foundation; either version 2
+ of the License, or (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+#include "benchmark_report.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <numeric>
+
+#include "../../src/representations/json/nlohmann/json.hpp"
+
+using namespace std;
+using json = nlohmann::json;
+
+namespace m8r {
+
+BenchmarkReport::BenchmarkReport()
+    : scenarios{},
+      properties{}
+{
+}
+
+BenchmarkReport::~BenchmarkReport()
+{
+}
+
+void BenchmarkReport::setProperty(const string& key, const string& value)
+{
+    for(auto& p:properties) {
+        if(p.first == key) {
+            p.second = value;
+            return;
+        }
+    }
+    properties.push_back(make_pair(key, value));
+}
+
+void BenchmarkReport::add(const string& scenario, double milliseconds)
+{
+    // few scenarios > linear search keeps the order in which they were run
+    for(Scenario& s:scenarios) {
+        if(s.name == scenario) {
+            s.samples.push_back(milliseconds);
+            return;
+        }
+    }
+    scenarios.push_back(Scenario{scenario, {milliseconds}});
+}
+
+double BenchmarkReport::percentile(const vector<double>& sorted, double p)
+{
+    if(sorted.empty()) {
+        return 0;
+    }
+    const double rank = p / 100.0 * (sorted.size() - 1);
+    const size_t lower = static_cast<size_t>(rank);
+    if(lower + 1 >= sorted.size()) {
+        return sorted.back();
+    }
+    return sorted[lower] + (rank - lower) * (sorted[lower+1] - sorted[lower]);
+}
+
+string BenchmarkReport::toJson() const
+{
+    json report{};
+    json props = json::object();
+    for(const auto& p:properties) {
+        props[p.first] = p.second;
+    }
+    report["properties"] = props;
+
+    json results = json::array();
+    for(const Scenario& s:scenarios) {
+        vector<double> sorted{s.samples};
+        sort(sorted.begin(), sorted.end());
+        const double total = accumulate(sorted.begin(), sorted.end(), 0.0);
+        results.push_back({
+            {"name", s.name},
+            {"unit", "ms"},
+            {"samples", sorted.size()},
+            {"total", total},
+            {"min", sorted.front()},
+            {"mean", total / sorted.size()},
+            {"p50", percentile(sorted, 50)},
+            {"p90", percentile(sorted, 90)},
+            {"p95", percentile(sorted, 95)},
+            {"p99", percentile(sorted, 99)},
+            {"max", sorted.back()}
+        });
+    }
+    report["scenarios"] = results;
+
+    return report.dump(2);
+}
+
+string BenchmarkReport::toString() const
+{
+    string result{};
+    char line[200];
+    snprintf(line, sizeof(line), "%-16s %8s %10s %10s %10s %10s %10s\n",
+             "scenario", "samples", "mean", "p50", "p90", "p99", "max");
+    result += line;
+    for(const Scenario& s:scenarios) {
+        vector<double> sorted{s.samples};
+        sort(sorted.begin(), sorted.end());
+        snprintf(line, sizeof(line), "%-16s %8zu %10.3f %10.3f %10.3f %10.3f %10.3f\n",
+                 s.name.c_str(),
+                 sorted.size(),
+                 accumulate(sorted.begin(), sorted.end(), 0.0) / sorted.size(),
+                 percentile(sorted, 50),
+                 percentile(sorted, 90),
+                 percentile(sorted, 99),
+                 sorted.back());
+        result += line;
+    }
+    return result;
+}
+
+} // m8r namespace
@@ -0,0 +1,106 @@
+/*
+ benchmark_report.h     MindForger thinking notebook
+
+ Copyright (C) 2016-2025 Martin Dvorak <martin.dvorak@mindforger.com>
+
+ This program is free software; you can redistribute it and/or
+ modify it under the terms of the GNU General Public License
+ as published by the Free Software Foundation; either version 2
+ of the License, or (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+#ifndef M8R_BENCHMARK_REPORT_H
+#define M8R_BENCHMARK_REPORT_H
+
+#include <chrono>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace m8r {
+
+/**
+ * @brief Timings of benchmark scenarios and their statistics.
+ *
+ * Report is serialized to JSON so that results can be compared across
+ * releases by tools:
+ *
+ *   {"scenarios": [{"name": "fts", "unit": "ms", "samples": 100,
+ *                   "min": ..., "mean": ..., "p50": ..., "p90": ...,
+ *                   "p95": ..., "p99": ..., "max": ...}, ...], ...}
+ */
+class BenchmarkReport
+{
+public:
+    struct Scenario
+    {
+        std::string name;
+        // sample durations in ms
+        std::vector<double> samples;
+    };
+
+    /**
+     * @brief Measure duration of a block: timer adds sample on destruction.
+     */
+    class Timer
+    {
+    private:
+        BenchmarkReport& report;
+        std::string scenario;
+        std::chrono::steady_clock::time_point begin;
+
+    public:
+        Timer(BenchmarkReport& report, const std::string& scenario)
+            : report(report), scenario(scenario), begin(std::chrono::steady_clock::now()) {}
+        Timer(const Timer&) = delete;
+        Timer(const Timer&&) = delete;
+        Timer& operator=(const Timer&) = delete;
+        Timer& operator=(const Timer&&) = delete;
+        ~Timer() {
+            report.add(
+                scenario,
+                std::chrono::duration<double,std::milli>(std::chrono::steady_clock::now()-begin).count());
+        }
+    };
+
+private:
+    std::vector<Scenario> scenarios;
+    // key/value description of the environment and repository
+    std::vector<std::pair<std::string,std::string>> properties;
+
+public:
+    explicit BenchmarkReport();
+    BenchmarkReport(const BenchmarkReport&) = delete;
+    BenchmarkReport(const BenchmarkReport&&) = delete;
+    BenchmarkReport& operator=(const BenchmarkReport&) = delete;
+    BenchmarkReport& operator=(const BenchmarkReport&&) = delete;
+    ~BenchmarkReport();
+
+    void setProperty(const std::string& key, const std::string& value);
+    void add(const std::string& scenario, double milliseconds);
+    const std::vector<Scenario>& getScenarios() const { return scenarios; }
+
+    /**
+     * @brief Percentile using linear interpolation between closest ranks.
+     *
+     * @param sorted    samples sorted ascending.
+     * @param p         percentile from [0, 100].
+     */
+    static double percentile(const std::vector<double>& sorted, double p);
+
+    std::string toJson() const;
+    /**
+     * @brief Human readable table.
+     */
+    std::string toString() const;
+};
+
+}
+#endif // M8R_BENCHMARK_REPORT_H
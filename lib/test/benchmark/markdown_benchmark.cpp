@@ -89,3 +89,66 @@ TEST(MarkdownParserBenchmark, DISABLED_ParserNoMeta)
     MF_DEBUG(endl << (ITERATIONS*0.77) << "MiB (" << ITERATIONS << "x0.77MiB) MDs parsed in " << chrono::duration_cast<chrono::microseconds>(end-begin).count()/1000.0 << "ms");
     MF_DEBUG(" ~ AVG: " << chrono::duration_cast<chrono::microseconds>(end-begin).count()/1000000.0 << "ms" << endl);
 }
+
+/*
+ * Generate Outline w/ deep section nesting and heavy metadata.
+ */
+void generateDeepMetaOutline(string& md, int sections, int depth)
+{
+    md.assign(
+        "# Benchmark Outline <!-- Metadata: type: Grow; created: 2020-01-01 10:00:00; reads: 10; "
+        "read: 2024-01-01 10:00:00; revision: 10; modified: 2024-01-01 10:00:00; importance: 3/5; "
+        "urgency: 2/5; progress: 50%; tags: benchmark, deep nesting, metadata; -->\n"
+        "Outline description.\n\n");
+    for(int s=0; s<sections; s++) {
+        md.append(1+s%depth+1, '#');
+        md += " Section " + std::to_string(s);
+        md +=
+            " <!-- Metadata: type: Idea; created: 2020-01-01 10:00:00; reads: 42; read: 2024-01-01 10:00:00; "
+            "revision: 7; modified: 2024-01-01 10:00:00; importance: 4/5; urgency: 1/5; progress: 80%; "
+            "tags: cool, important, todo, later, ml; "
+            "links: [Outline](../outline.md),[Note](../note.md#section); "
+            "deadline: 2025-01-01 10:00:00; scope: 1y2m3d4h5m; -->\n";
+        for(int l=0; l<4; l++) {
+            md += "Section body line with some **Markdown** text and [link](https://www.mindforger.com).\n";
+        }
+        md += "\n";
+    }
+}
+
+TEST(MarkdownParserBenchmark, DISABLED_ParserDeepNestingHeavyMetadata)
+{
+    // GIVEN
+    string md{};
+    generateDeepMetaOutline(md, 20000, 12);
+    const double mb = md.size()/(1024.0*1024.0);
+
+    // WHEN
+    const int ITERATIONS = 10;
+    chrono::nanoseconds lexing{0};
+    chrono::nanoseconds parsing{0};
+    for(int i=0; i<ITERATIONS; i++) {
+        auto begin = chrono::high_resolution_clock::now();
+        MarkdownLexerSections lexer{};
+        lexer.tokenize(&md);
+        auto lexed = chrono::high_resolution_clock::now();
+        MarkdownParserSections parser{lexer};
+        parser.parse();
+        auto end = chrono::high_resolution_clock::now();
+        lexing += lexed-begin;
+        parsing += end-lexed;
+
+        // THEN
+        ASSERT_TRUE(parser.hasMetadata());
+        ASSERT_EQ(20000+1, parser.size());
+        ASSERT_EQ(5, parser.getAst()->at(1)->getMetadata().getTags().size());
+        ASSERT_EQ(2, parser.getAst()->at(1)->getMetadata().getLinks().size());
+    }
+
+    double lexingSeconds = chrono::duration_cast<chrono::microseconds>(lexing).count()/1000000.0;
+    double parsingSeconds = chrono::duration_cast<chrono::microseconds>(parsing).count()/1000000.0;
+    cout << endl
+         << ITERATIONS << "x " << mb << "MB outline w/ " << 20000 << " sections:" << endl
+         << "  parser: " << (ITERATIONS*mb/parsingSeconds) << " MB/s" << endl
+         << "  lexer + parser: " << (ITERATIONS*mb/(lexingSeconds+parsingSeconds)) << " MB/s" << endl;
+}
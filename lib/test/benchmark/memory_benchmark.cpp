@@ -0,0 +1,239 @@
+/*
+ memory_benchmark.cpp     MindForger thinking notebook
+
+ Copyright (C) 2016-2025 Martin Dvorak <martin.dvorak@mindforger.com>
+
+ This program is free software; you can redistribute it and/or
+ modify it under the terms of the GNU General Public License
+ as published by the Free Software Foundation; either version 2
+ of the License, or (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <set>
+#include <string>
+#include <vector>
+
+#if defined(__GLIBC__)
+  #include <malloc.h>
+#endif
+
+#include <gtest/gtest.h>
+
+#include "../../src/mind/ontology/ontology.h"
+#include "../../src/model/outline.h"
+#include "../../src/model/note.h"
+
+using namespace std;
+using namespace m8r;
+
+namespace {
+
+/*
+ * Replica of Thing/Note memory layout prior interned names, integer
+ * keys, inline tags/links and central relationship store.
+ */
+
+class LegacyThing
+{
+public:
+    string key;
+    string name;
+    set<Relationship*> relationships;
+    string autolinkingName;
+    string autolinkingAbbr;
+    string autolinkingAlias;
+
+    LegacyThing() : key{}, name{}, relationships{}, autolinkingName{}, autolinkingAbbr{}, autolinkingAlias{} {}
+    virtual ~LegacyThing() {}
+
+    virtual void setName(const string& name) {
+        this->name = name;
+        auto pos = name.find(":");
+        if(pos != string::npos) {
+            autolinkingAlias = name.substr(0, pos);
+            autolinkingAbbr = autolinkingAlias;
+            autolinkingName = name.substr(pos+1);
+        } else {
+            autolinkingAlias = name;
+            autolinkingName = name;
+            autolinkingAbbr.clear();
+        }
+    }
+};
+
+class LegacyThingInTime : public LegacyThing
+{
+public:
+    time_t created;
+    time_t read;
+    time_t modified;
+
+    LegacyThingInTime() : LegacyThing{}, created{}, read{}, modified{} {}
+    virtual ~LegacyThingInTime() {}
+};
+
+class LegacyNote : public LegacyThingInTime
+{
+public:
+    Outline* outline;
+    int flags;
+    u_int16_t depth;
+    vector<const Tag*> tags;
+    vector<Link*> links;
+    const NoteType* type;
+    vector<string*> description;
+    u_int32_t revision;
+    u_int32_t reads;
+    u_int8_t progress;
+    time_t deadline;
+    int aiAaMatrixIndex;
+
+    LegacyNote(const NoteType* type, Outline* outline)
+        : LegacyThingInTime{}, outline{outline}, flags{}, depth{}, tags{}, links{}, type{type},
+          description{}, revision{}, reads{}, progress{}, deadline{}, aiAaMatrixIndex{} {}
+    virtual ~LegacyNote() {
+        for(Link* l:links) delete l;
+    }
+};
+
+size_t heapInUse()
+{
+#if defined(__GLIBC__) && (__GLIBC__ > 2 || (__GLIBC__ == 2 && __GLIBC_MINOR__ >= 33))
+    struct mallinfo2 info = mallinfo2();
+    return info.uordblks + info.hblkhd;
+#else
+    // heap statistics not available on this platform
+    return 0;
+#endif
+}
+
+/**
+ * @brief Synthetic N properties: names repeat (like Introduction, TODO, ...), few tags and links.
+ */
+struct NoteProperties
+{
+    string name;
+    vector<const Tag*> tags;
+    bool link;
+};
+
+}
+
+/*
+ * Heap and object size of 1M Notes (30% repeated section names, 0-3 tags,
+ * 10% w/ link; -O1 build) - interning costs ~20% on construction:
+ *
+ *   sizeof(LegacyNote): 368B  sizeof(Note): 184B
+ *   legacy layout : 529B/N  656ms
+ *   compact layout: 215B/N  776ms
+ */
+TEST(MemoryBenchmark, DISABLED_NoteLayout)
+{
+    const size_t NOTES = 1000000;
+    const vector<string> sections{
+        "Introduction", "TODO", "Summary", "Links", "Notes", "Conclusion", "GTD: Getting Things Done"};
+    const vector<string> words{
+        "MindForger", "thinking", "Notebook", "markdown", "outline", "association", "knowledge", "search"};
+
+    Ontology ontology{};
+    vector<const Tag*> tags{
+        ontology.findOrCreateTag(Tag::KeyCool()),
+        ontology.findOrCreateTag(Tag::KeyImportant()),
+        ontology.findOrCreateTag(Tag::KeyTodo()),
+        ontology.findOrCreateTag(Tag::KeyDone())};
+    Outline outline{ontology.getDefaultOutlineType()};
+    outline.setKey("/home/user/mindforger-repository/memory/benchmark.md");
+
+    cout << "Generating " << NOTES << " N properties..." << endl;
+    mt19937 random{42};
+    uniform_int_distribution<size_t> percent(0, 99);
+    uniform_int_distribution<size_t> section(0, sections.size()-1);
+    uniform_int_distribution<size_t> word(0, words.size()-1);
+    uniform_int_distribution<size_t> tag(0, tags.size()-1);
+    vector<NoteProperties> properties(NOTES);
+    for(NoteProperties& p:properties) {
+        if(percent(random) < 30) {
+            p.name = sections[section(random)];
+        } else {
+            p.name = words[word(random)] + " " + words[word(random)] + " " + std::to_string(percent(random));
+        }
+        size_t t = percent(random);
+        size_t tagsCount = t < 50? 0: t < 80? 1: t < 95? 2: 3;
+        for(size_t i=0; i<tagsCount; i++) {
+            p.tags.push_back(tags[(i + tag(random)) % tags.size()]);
+        }
+        p.link = percent(random) < 10;
+    }
+
+    cout << "sizeof(LegacyNote): " << sizeof(LegacyNote) << "B" << endl
+         << "sizeof(Note)      : " << sizeof(Note) << "B" << endl;
+
+    // legacy layout
+    size_t heap = heapInUse();
+    auto begin = chrono::high_resolution_clock::now();
+    vector<LegacyNote*> legacyNotes{};
+    legacyNotes.reserve(NOTES);
+    for(NoteProperties& p:properties) {
+        LegacyNote* n = new LegacyNote{ontology.getDefaultNoteType(), &outline};
+        n->key = std::to_string(legacyNotes.size());
+        n->setName(p.name);
+        for(const Tag* t:p.tags) {
+            if(std::find(n->tags.begin(), n->tags.end(), t) == n->tags.end()) {
+                n->tags.push_back(t);
+            }
+        }
+        if(p.link) {
+            n->links.push_back(new Link{"Outline key", outline.getKey()});
+        }
+        legacyNotes.push_back(n);
+    }
+    auto end = chrono::high_resolution_clock::now();
+    size_t legacyBytes = heapInUse() - heap;
+    cout << "Legacy layout : " << legacyBytes/NOTES << "B/N, "
+         << chrono::duration_cast<chrono::milliseconds>(end-begin).count() << "ms" << endl;
+    for(LegacyNote* n:legacyNotes) {
+        delete n;
+    }
+    legacyNotes.clear();
+
+    // compact layout
+    heap = heapInUse();
+    begin = chrono::high_resolution_clock::now();
+    vector<Note*> notes{};
+    notes.reserve(NOTES);
+    for(NoteProperties& p:properties) {
+        Note* n = new Note{ontology.getDefaultNoteType(), &outline};
+        n->setName(p.name);
+        for(const Tag* t:p.tags) {
+            n->addTag(t);
+        }
+        if(p.link) {
+            n->addLink(new Link{"Outline key", outline.getKey()});
+        }
+        notes.push_back(n);
+    }
+    end = chrono::high_resolution_clock::now();
+    size_t compactBytes = heapInUse() - heap;
+    cout << "Compact layout: " << compactBytes/NOTES << "B/N, "
+         << chrono::duration_cast<chrono::milliseconds>(end-begin).count() << "ms" << endl
+         << "Interned names: " << StringPool::getInstance().size() << endl;
+    for(Note* n:notes) {
+        delete n;
+    }
+
+    EXPECT_LT(sizeof(Note), sizeof(LegacyNote));
+    if(legacyBytes && compactBytes) {
+        EXPECT_LT(compactBytes, legacyBytes);
+    }
+}
@@ -0,0 +1,261 @@
+/*
+ mindforger_lib_benchmarks.cpp     MindForger thinking notebook
+
+ Copyright (C) 2016-2025 Martin Dvorak <martin.dvorak@mindforger.com>
+
+ This program is free software; you can redistribute it and/or
+ modify it under the terms of the GNU General Public License
+ as published by the Free Software Foundation; either version 2
+ of the License, or (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <set>
+#include <string>
+#include <vector>
+
+#include "../../src/version.h"
+#include "../../src/gear/file_utils.h"
+#include "../../src/mind/mind.h"
+#include "../../src/mind/ai/autolinking/naive_autolinking_preprocessor.h"
+#include "../../src/representations/html/html_outline_representation.h"
+
+#include "synthetic_repository.h"
+#include "benchmark_report.h"
+
+using namespace std;
+using namespace m8r;
+
+/*
+ * MindForger library benchmarks.
+ *
+ * Repository with given shape is generated (deterministically) and timed
+ * scenarios are run on it. Statistics are printed and written as JSON
+ * so that results can be tracked across releases:
+ *
+ *   ./mindforger-lib-benchmarks --outlines 1000 --notes 20 --output mf-2.0.0.json
+ *   ./mindforger-lib-benchmarks --scenarios learn,fts --iterations 10
+ */
+
+static const char* SCENARIOS[] = {
+    "learn", "learn-snapshot", "fts", "tag-query", "aa-dream", "html-render", "autolinking", "save"
+};
+
+static void usage()
+{
+    cout << "Usage: mindforger-lib-benchmarks [options]" << endl
+         << "  --outlines N     number of generated Outlines (100)" << endl
+         << "  --notes N        Notes per Outline (20)" << endl
+         << "  --tags N         size of tag vocabulary (50)" << endl
+         << "  --tags-per-note N  max tags per Outline/Note (3)" << endl
+         << "  --links N        max links per Note (2)" << endl
+         << "  --bytes N        average description size in bytes (1024)" << endl
+         << "  --words N        size of vocabulary (5000)" << endl
+         << "  --seed N         generator seed (42)" << endl
+         << "  --iterations N   repetitions of whole repository scenarios (5)" << endl
+         << "  --samples N      samples of per Outline/Note/query scenarios (100)" << endl
+         << "  --scenarios a,b  scenarios to run (all):";
+    for(const char* s:SCENARIOS) cout << " " << s;
+    cout << endl
+         << "  --directory DIR  where to generate the repository (temp directory)" << endl
+         << "  --output FILE    JSON report file (stdout)" << endl;
+}
+
+int main(int argc, char* argv[])
+{
+    SyntheticRepositoryProfile profile{};
+    unsigned iterations = 5;
+    unsigned samples = 100;
+    set<string> scenarios{begin(SCENARIOS), end(SCENARIOS)};
+    string directory{getSystemTempPath() + FILE_PATH_SEPARATOR + "mindforger-benchmark-repository"};
+    string output{};
+
+    for(int i=1; i<argc; i++) {
+        const string option{argv[i]};
+        if(option == "--help" || option == "-h") {
+            usage();
+            return 0;
+        }
+        if(i+1 >= argc) {
+            cerr << "Error: missing value of " << option << endl;
+            usage();
+            return 1;
+        }
+        const char* value = argv[++i];
+        const unsigned number = static_cast<unsigned>(strtoul(value, nullptr, 10));
+        if(option == "--outlines") profile.outlines = number;
+        else if(option == "--notes") profile.notesPerOutline = number;
+        else if(option == "--tags") profile.tags = number;
+        else if(option == "--tags-per-note") profile.tagsPerNote = number;
+        else if(option == "--links") profile.linksPerNote = number;
+        else if(option == "--bytes") profile.descriptionBytes = number;
+        else if(option == "--words") profile.words = number;
+        else if(option == "--seed") profile.seed = strtoull(value, nullptr, 10);
+        else if(option == "--iterations") iterations = number;
+        else if(option == "--samples") samples = number;
+        else if(option == "--directory") directory = value;
+        else if(option == "--output") output = value;
+        else if(option == "--scenarios") {
+            scenarios.clear();
+            for(string& s:stringSplit(value, ",")) {
+                scenarios.insert(s);
+            }
+        } else {
+            cerr << "Error: unknown option " << option << endl;
+            usage();
+            return 1;
+        }
+    }
+    if(!profile.outlines || !iterations || !samples) {
+        cerr << "Error: number of outlines, iterations and samples must be positive" << endl;
+        return 1;
+    }
+
+    /*
+     * Repository
+     */
+
+    if(isDirectoryOrFileExists(directory.c_str())) {
+        removeDirectoryRecursively(directory.c_str());
+    }
+    createDirectory(directory);
+    SyntheticRepository generator{profile};
+    const string repositoryPath = generator.generate(directory + FILE_PATH_SEPARATOR + "mindforger-repository");
+    cerr << "Generated " << profile.outlines << " Os w/ " << profile.notesPerOutline << " Ns ("
+         << generator.getBytes() << "B) to " << repositoryPath << endl;
+
+    MarkdownRepositoryConfigurationRepresentation repositoryConfigRepresentation{};
+    Configuration& config = Configuration::getInstance();
+    config.clear();
+    config.setConfigFilePath(directory + FILE_PATH_SEPARATOR + ".mindforger.md");
+    config.setActiveRepository(
+        config.addRepository(RepositoryIndexer::getRepositoryForPath(repositoryPath)),
+        repositoryConfigRepresentation);
+
+    BenchmarkReport report{};
+    report.setProperty("version", MINDFORGER_VERSION);
+    report.setProperty("seed", std::to_string(profile.seed));
+    report.setProperty("outlines", std::to_string(profile.outlines));
+    report.setProperty("notesPerOutline", std::to_string(profile.notesPerOutline));
+    report.setProperty("tags", std::to_string(profile.tags));
+    report.setProperty("tagsPerNote", std::to_string(profile.tagsPerNote));
+    report.setProperty("linksPerNote", std::to_string(profile.linksPerNote));
+    report.setProperty("descriptionBytes", std::to_string(profile.descriptionBytes));
+    report.setProperty("words", std::to_string(profile.words));
+    report.setProperty("repositoryBytes", std::to_string(generator.getBytes()));
+    report.setProperty("iterations", std::to_string(iterations));
+    report.setProperty("samples", std::to_string(samples));
+
+    /*
+     * Scenarios
+     */
+
+    if(scenarios.count("learn")) {
+        for(unsigned i=0; i<iterations; i++) {
+            Mind mind(config);
+            mind.remind().setSnapshot(false);
+            BenchmarkReport::Timer timer{report, "learn"};
+            mind.learn();
+        }
+    }
+    if(scenarios.count("learn-snapshot")) {
+        {
+            // write snapshot
+            Mind mind(config);
+            mind.learn();
+        }
+        for(unsigned i=0; i<iterations; i++) {
+            Mind mind(config);
+            BenchmarkReport::Timer timer{report, "learn-snapshot"};
+            mind.learn();
+        }
+    }
+
+    Mind mind(config);
+    mind.learn();
+    report.setProperty("notes", std::to_string(mind.remind().getNotesCount()));
+    const vector<Outline*> outlines{mind.remind().getOutlines()};
+    vector<Note*> notes{};
+    mind.remind().getAllNotes(notes);
+    if(outlines.empty() || notes.empty()) {
+        cerr << "Error: no Outlines/Notes learned from " << repositoryPath << endl;
+        return 1;
+    }
+
+    if(scenarios.count("fts")) {
+        for(unsigned i=0; i<samples; i++) {
+            const string& word = generator.getWords()[generator.skewed(profile.words)];
+            BenchmarkReport::Timer timer{report, "fts"};
+            delete mind.findNoteFts(word, FtsSearch::IGNORE_CASE);
+        }
+    }
+    if(scenarios.count("tag-query")) {
+        vector<const Tag*> tags{};
+        vector<Note*> result{};
+        for(unsigned i=0; i<samples; i++) {
+            tags.clear();
+            result.clear();
+            for(unsigned t=1+generator.uniform(2); t; t--) {
+                tags.push_back(
+                    mind.getOntology().findOrCreateTag(
+                        generator.getTags()[generator.skewed(profile.tags)]));
+            }
+            BenchmarkReport::Timer timer{report, "tag-query"};
+            mind.findNotesByTags(tags, result);
+        }
+    }
+    if(scenarios.count("aa-dream")) {
+        for(unsigned i=0; i<iterations; i++) {
+            mind.sleep();
+            BenchmarkReport::Timer timer{report, "aa-dream"};
+            mind.think().get();
+        }
+    }
+    if(scenarios.count("html-render")) {
+        HtmlExportColorsRepresentation colors{};
+        HtmlOutlineRepresentation htmlRepresentation{mind.getOntology(), colors, nullptr};
+        string html{};
+        for(unsigned i=0; i<samples; i++) {
+            Outline* o = outlines[i % outlines.size()];
+            html.clear();
+            BenchmarkReport::Timer timer{report, "html-render"};
+            htmlRepresentation.to(o, &html, false, false, true, true);
+        }
+    }
+    if(scenarios.count("autolinking")) {
+        NaiveAutolinkingPreprocessor autolinker{mind};
+        string amd{};
+        for(unsigned i=0; i<samples; i++) {
+            Note* n = notes[generator.uniform(notes.size())];
+            amd.clear();
+            BenchmarkReport::Timer timer{report, "autolinking"};
+            autolinker.process(n->getDescription(), amd);
+        }
+    }
+    if(scenarios.count("save")) {
+        for(unsigned i=0; i<samples; i++) {
+            Outline* o = outlines[i % outlines.size()];
+            BenchmarkReport::Timer timer{report, "save"};
+            mind.remember(o);
+        }
+    }
+
+    cerr << report.toString();
+    if(output.size()) {
+        stringToFile(output, report.toJson());
+        cerr << "Report written to " << output << endl;
+    } else {
+        cout << report.toJson() << endl;
+    }
+
+    return 0;
+}
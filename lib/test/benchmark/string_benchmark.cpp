@@ -0,0 +1,106 @@
+/*
+ string_benchmark.cpp     MindForger markdown test
+
+ Copyright (C) 2016-2025 Martin Dvorak <martin.dvorak@mindforger.com>
+
+ This program is free software; you can redistribute it and/or
+ modify it under the terms of the GNU General Public License
+ as published by the Free Software Foundation; either version 2
+ of the License, or (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <chrono>
+#include <iostream>
+#include <locale>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "../../src/gear/string_utils.h"
+
+using namespace std;
+using namespace m8r;
+
+/*
+ * Case insensitive FTS on 256MB corpus (3.2M lines of ~80B) w/ a pattern
+ * which is rarely present i.e. all lines are searched (SSE2, -O1 build):
+ *
+ *   LOCALE lowercase copy + find : 5211ms
+ *   ASCII lowercase copy + find  :  561ms
+ *   SIMD in place search         :  186ms
+ */
+TEST(StringBenchmark, DISABLED_FindIgnoreCase)
+{
+    const size_t CORPUS_SIZE = 256*1024*1024;
+    const vector<string> words{
+        "MindForger", "thinking", "Notebook", "markdown", "IDE", "outline", "Note", "tag",
+        "Příliš", "žluťoučký", "kůň", "association", "Knowledge", "search", "the", "of"};
+
+    cout << "Generating " << CORPUS_SIZE/(1024*1024) << "MB corpus..." << endl;
+    mt19937 random{42};
+    uniform_int_distribution<size_t> word(0, words.size()-1);
+    vector<string> corpus{};
+    size_t corpusSize = 0;
+    while(corpusSize < CORPUS_SIZE) {
+        string line{};
+        while(line.size() < 80) {
+            line += words[word(random)];
+            line += ' ';
+        }
+        corpusSize += line.size();
+        corpus.push_back(line);
+    }
+    const string pattern{"notebook ide search the"};
+    cout << corpus.size() << " lines generated" << endl;
+
+    // std::tolower() w/ locale lowercase copy
+    auto begin = chrono::high_resolution_clock::now();
+    size_t matches = 0;
+    string s{};
+    static const std::locale locale;
+    for(const string& line:corpus) {
+        s.clear();
+        for(char c:line) {
+            s += std::tolower(c, locale);
+        }
+        if(s.find(pattern) != string::npos) matches++;
+    }
+    auto end = chrono::high_resolution_clock::now();
+    cout << "LOCALE lowercase copy + find: " << matches << " matches in "
+         << chrono::duration_cast<chrono::microseconds>(end-begin).count()/1000.0 << "ms" << endl;
+    size_t expected = matches;
+
+    // stringToLower() copy
+    begin = chrono::high_resolution_clock::now();
+    matches = 0;
+    for(const string& line:corpus) {
+        s.clear();
+        stringToLower(line, s);
+        if(s.find(pattern) != string::npos) matches++;
+    }
+    end = chrono::high_resolution_clock::now();
+    cout << "ASCII lowercase copy + find: " << matches << " matches in "
+         << chrono::duration_cast<chrono::microseconds>(end-begin).count()/1000.0 << "ms" << endl;
+    EXPECT_EQ(expected, matches);
+
+    // in place search
+    begin = chrono::high_resolution_clock::now();
+    matches = 0;
+    for(const string& line:corpus) {
+        if(stringFindIgnoreCase(line, pattern) != string::npos) matches++;
+    }
+    end = chrono::high_resolution_clock::now();
+    cout << "SIMD in place search: " << matches << " matches in "
+         << chrono::duration_cast<chrono::microseconds>(end-begin).count()/1000.0 << "ms" << endl;
+    EXPECT_EQ(expected, matches);
+}
@@ -0,0 +1,216 @@
+/*
+ synthetic_repository.cpp     MindForger thinking notebook
+
+ Copyright (C) 2016-2025 Martin Dvorak <martin.dvorak@mindforger.com>
+
+ This program is free software; you can redistribute it and/or
+ modify it under the terms of the GNU General Public License
+ as published by the Free Software Foundation; either version 2
+ of the License, or (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+#include "synthetic_repository.h"
+
+#include <ctime>
+
+#include "../../src/config/configuration.h"
+#include "../../src/gear/file_utils.h"
+
+using namespace std;
+
+namespace m8r {
+
+SyntheticRepository::SyntheticRepository(const SyntheticRepositoryProfile& profile)
+    : profile(profile),
+      state{profile.seed},
+      words{},
+      tags{},
+      repositoryPath{},
+      bytes{}
+{
+    if(!this->profile.words) this->profile.words = 1;
+    if(!this->profile.tags) this->profile.tags = 1;
+
+    words.reserve(this->profile.words);
+    for(unsigned i=0; i<this->profile.words; i++) {
+        words.push_back(word(i));
+    }
+    tags.reserve(this->profile.tags);
+    for(unsigned i=0; i<this->profile.tags; i++) {
+        tags.push_back("tag-" + word(i));
+    }
+}
+
+SyntheticRepository::~SyntheticRepository()
+{
+}
+
+uint64_t SyntheticRepository::next()
+{
+    uint64_t z = (state += 0x9E3779B97F4A7C15ull);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+    return z ^ (z >> 31);
+}
+
+unsigned SyntheticRepository::skewed(unsigned n)
+{
+    // product of two uniform numbers: P(k) ~ log(n/k)
+    const uint64_t a = uniform(n), b = uniform(n);
+    return static_cast<unsigned>(a * b / n);
+}
+
+string SyntheticRepository::word(unsigned i)
+{
+    // pronounceable unique word: 1..n syllables given by digits of i in base 5*14
+    static const char* consonants = "bdfgklmnprstvz";
+    static const char* vowels = "aeiou";
+    string w{};
+    do {
+        const unsigned syllable = i % 70;
+        w += consonants[syllable % 14];
+        w += vowels[syllable / 14];
+        i /= 70;
+    } while(i);
+    return w;
+}
+
+string SyntheticRepository::outlineFileName(unsigned i)
+{
+    return "outline-" + std::to_string(i) + ".md";
+}
+
+void SyntheticRepository::sentence(string& md, unsigned count)
+{
+    for(unsigned w=0; w<count; w++) {
+        const string& word = words[skewed(profile.words)];
+        if(w) {
+            md += ' ';
+            md += word;
+        } else {
+            md += static_cast<char>(toupper(word[0]));
+            md += word.substr(1);
+        }
+    }
+    md += '.';
+}
+
+void SyntheticRepository::metadata(string& md, const char* type, unsigned tagsCount)
+{
+    // timestamps in 2015-2024 - formatted w/o time zone to be reproducible
+    char created[50], modified[50];
+    const time_t createdTs = 1420070400 + static_cast<time_t>(uniform(5*365*24*60*60));
+    const time_t modifiedTs = createdTs + static_cast<time_t>(uniform(4*365*24*60*60));
+    struct tm datetime;
+#ifndef _WIN32
+    gmtime_r(&createdTs, &datetime);
+    strftime(created, sizeof(created), "%Y-%m-%d %H:%M:%S", &datetime);
+    gmtime_r(&modifiedTs, &datetime);
+    strftime(modified, sizeof(modified), "%Y-%m-%d %H:%M:%S", &datetime);
+#else
+    gmtime_s(&datetime, &createdTs);
+    strftime(created, sizeof(created), "%Y-%m-%d %H:%M:%S", &datetime);
+    gmtime_s(&datetime, &modifiedTs);
+    strftime(modified, sizeof(modified), "%Y-%m-%d %H:%M:%S", &datetime);
+#endif
+    const unsigned revision = 1 + uniform(50);
+
+    md += " <!-- Metadata: type: ";
+    md += type;
+    md += "; ";
+    if(tagsCount) {
+        md += "tags: ";
+        for(unsigned t=0; t<tagsCount; t++) {
+            if(t) md += ",";
+            md += tags[skewed(profile.tags)];
+        }
+        md += "; ";
+    }
+    md += "created: "; md += created;
+    md += "; reads: "; md += std::to_string(revision + uniform(100));
+    md += "; read: "; md += modified;
+    md += "; revision: "; md += std::to_string(revision);
+    md += "; modified: "; md += modified;
+    md += "; importance: "; md += std::to_string(uniform(6));
+    md += "/5; urgency: "; md += std::to_string(uniform(6));
+    md += "/5; progress: "; md += std::to_string(uniform(11)*10);
+    md += "%; -->\n";
+}
+
+string SyntheticRepository::outline(unsigned o)
+{
+    // every O has own PRNG sequence so that Os can be generated independently
+    state = profile.seed ^ (0x9E3779B97F4A7C15ull * (o + 1));
+
+    // average sentence of 10 words has ~60B
+    const unsigned sentences = profile.descriptionBytes/60 + 1;
+
+    string md{};
+    md.reserve(profile.notesPerOutline * (profile.descriptionBytes + 300) + 1024);
+    md += "# ";
+    sentence(md, 2 + uniform(4));
+    md.pop_back();
+    metadata(md, "Outline", uniform(profile.tagsPerNote + 1));
+    for(unsigned s=0; s<sentences; s++) {
+        sentence(md, 5 + uniform(11));
+        md += s%4==3? "\n\n": " ";
+    }
+    md += "\n";
+
+    for(unsigned n=0; n<profile.notesPerOutline; n++) {
+        md += "\n";
+        // depth 1..3
+        md += n && uniform(3)? (uniform(3)? "### ": "## "): "## ";
+        sentence(md, 1 + uniform(5));
+        md.pop_back();
+        metadata(md, "Note", uniform(profile.tagsPerNote + 1));
+
+        const unsigned noteSentences = 1 + uniform(2*sentences);
+        const unsigned links = profile.outlines > 1? uniform(profile.linksPerNote + 1): 0;
+        for(unsigned s=0; s<noteSentences; s++) {
+            sentence(md, 5 + uniform(11));
+            if(s < links) {
+                // popular Os are linked more often
+                unsigned target = skewed(profile.outlines);
+                if(target == o) target = (o + 1) % profile.outlines;
+                md += " See [";
+                md += words[uniform(profile.words)];
+                md += "](";
+                md += outlineFileName(target);
+                md += ").";
+            }
+            md += s%4==3? "\n\n": " ";
+        }
+        md += "\n";
+    }
+
+    return md;
+}
+
+string SyntheticRepository::generate(const string& directory)
+{
+    repositoryPath = directory;
+    createDirectory(repositoryPath);
+    for(auto d:{DIRNAME_MEMORY, DIRNAME_MIND, DIRNAME_LIMBO}) {
+        createDirectory(repositoryPath + FILE_PATH_SEPARATOR + d);
+    }
+
+    bytes = 0;
+    const string memoryPath{repositoryPath + FILE_PATH_SEPARATOR + DIRNAME_MEMORY + FILE_PATH_SEPARATOR};
+    for(unsigned o=0; o<profile.outlines; o++) {
+        const string md = outline(o);
+        bytes += md.size();
+        stringToFile(memoryPath + outlineFileName(o), md);
+    }
+
+    return repositoryPath;
+}
+
+} // m8r namespace
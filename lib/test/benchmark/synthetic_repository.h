@@ -0,0 +1,114 @@
+/*
+ synthetic_repository.h     MindForger thinking notebook
+
+ Copyright (C) 2016-2025 Martin Dvorak <martin.dvorak@mindforger.com>
+
+ This program is free software; you can redistribute it and/or
+ modify it under the terms of the GNU General Public License
+ as published by the Free Software Foundation; either version 2
+ of the License, or (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+#ifndef M8R_SYNTHETIC_REPOSITORY_H
+#define M8R_SYNTHETIC_REPOSITORY_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace m8r {
+
+/**
+ * @brief Shape of the generated repository.
+ */
+struct SyntheticRepositoryProfile
+{
+    unsigned outlines = 100;
+    unsigned notesPerOutline = 20;
+    // size of tag vocabulary and max number of tags per O/N
+    unsigned tags = 50;
+    unsigned tagsPerNote = 3;
+    // max number of links per N to Ns in other Os
+    unsigned linksPerNote = 2;
+    // average O/N description size in bytes
+    unsigned descriptionBytes = 1024;
+    unsigned words = 5000;
+    std::uint64_t seed = 42;
+};
+
+/**
+ * @brief Deterministic generator of MindForger repositories for benchmarks.
+ *
+ * The same profile always gives byte-identical repository on any platform
+ * i.e. only own PRNG and integer arithmetic is used (std::*_distribution
+ * results are implementation specific). Words, tags and link targets
+ * follow skewed (Zipf like) distribution - few are very frequent, most
+ * of them are rare - like in real repositories.
+ */
+class SyntheticRepository
+{
+private:
+    SyntheticRepositoryProfile profile;
+    std::uint64_t state;
+
+    std::vector<std::string> words;
+    std::vector<std::string> tags;
+
+    std::string repositoryPath;
+    size_t bytes;
+
+public:
+    explicit SyntheticRepository(const SyntheticRepositoryProfile& profile);
+    SyntheticRepository(const SyntheticRepository&) = delete;
+    SyntheticRepository(const SyntheticRepository&&) = delete;
+    SyntheticRepository& operator=(const SyntheticRepository&) = delete;
+    SyntheticRepository& operator=(const SyntheticRepository&&) = delete;
+    ~SyntheticRepository();
+
+    /**
+     * @brief Generate MindForger repository (memory/, mind/ and limbo/) in the directory.
+     *
+     * @return path to the repository.
+     */
+    std::string generate(const std::string& directory);
+
+    /**
+     * @brief Generate Markdown of i-th Outline.
+     */
+    std::string outline(unsigned i);
+
+    static std::string outlineFileName(unsigned i);
+
+    const SyntheticRepositoryProfile& getProfile() const { return profile; }
+    const std::vector<std::string>& getWords() const { return words; }
+    const std::vector<std::string>& getTags() const { return tags; }
+    size_t getBytes() const { return bytes; }
+
+    /**
+     * @brief Deterministic pseudo random number (SplitMix64).
+     */
+    std::uint64_t next();
+    /**
+     * @brief Uniform number from [0, n).
+     */
+    unsigned uniform(unsigned n) { return static_cast<unsigned>(next() % n); }
+    /**
+     * @brief Skewed number from [0, n) - small values are much more probable.
+     */
+    unsigned skewed(unsigned n);
+
+private:
+    static std::string word(unsigned i);
+    void sentence(std::string& md, unsigned words);
+    void metadata(std::string& md, const char* type, unsigned tagsCount);
+};
+
+}
+#endif // M8R_SYNTHETIC_REPOSITORY_H
@@ -17,13 +17,15 @@
 
 TEMPLATE = subdirs
 
-SUBDIRS = lib src
+SUBDIRS = lib src benchmark
 
 # where to find the sub projects - give the folders
 lib.subdir  = ../../lib
 src.subdir  = ./src
+benchmark.subdir  = ./benchmark
 
 # build dependencies
 src.depends = lib
+benchmark.depends = lib
 
 # eof
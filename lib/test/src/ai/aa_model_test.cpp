@@ -0,0 +1,149 @@
+/*
+ aa_model_test.cpp     MindForger thinking notebook
+
+ Copyright (C) 2016-2025 Martin Dvorak <martin.dvorak@mindforger.com>
+
+ This program is free software; you can redistribute it and/or
+ modify it under the terms of the GNU General Public License
+ as published by the Free Software Foundation; either version 2
+ of the License, or (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <cmath>
+#include <vector>
+
+#include "../../../src/mind/ai/aa_model.h"
+
+#include <gtest/gtest.h>
+
+using namespace std;
+
+void setAaTestFeature(m8r::AssociationAssessmentNotesFeature& feature, int i)
+{
+    // deterministic pseudo random features in [0,1]
+    feature.setTypeMatches(i%2);
+    feature.setSimilaritySameOutline(i%3 == 0);
+    feature.setSimilarityByTags(((i*37)%101)/100.f);
+    feature.setSimilarityByTitles(((i*53)%97)/96.f);
+    feature.setSimilarityByDescription(((i*71)%89)/88.f);
+    feature.setSimilarityBySameTargetRels(((i*13)%7)/6.f);
+}
+
+TEST(AiAaModelTestCase, UntrainedFallsBackToMetric)
+{
+    m8r::AssociationAssessmentModel model{};
+    EXPECT_FALSE(model.isTrained());
+
+    m8r::AssociationAssessmentNotesFeature feature{};
+    m8r::AssociationAssessmentFeatureMatrix features{};
+    for(int i=0; i<100; i++) {
+        setAaTestFeature(feature, i);
+        features.add(feature);
+    }
+    vector<float> scores{};
+    model.evaluate(features, scores);
+
+    ASSERT_EQ(100, scores.size());
+    for(int i=0; i<100; i++) {
+        setAaTestFeature(feature, i);
+        EXPECT_NEAR(feature.areNotesAssociatedMetric(), scores[i], 1e-5);
+    }
+}
+
+TEST(AiAaModelTestCase, TrainAndBatchEvaluate)
+{
+    m8r::AssociationAssessmentModel model{};
+    m8r::AssociationAssessmentNotesFeature feature{};
+
+    // not trainable w/o negative samples
+    for(size_t i=0; i<m8r::AssociationAssessmentModel::MIN_TRAINING_SAMPLES; i++) {
+        setAaTestFeature(feature, i);
+        model.addSample(feature, true);
+    }
+    EXPECT_FALSE(model.isTrainable());
+    EXPECT_FALSE(model.train());
+    model.clear();
+
+    // user associates Ns by tags regardless other features
+    const int SAMPLES = 200;
+    for(int i=0; i<SAMPLES; i++) {
+        setAaTestFeature(feature, i);
+        model.addSample(feature, ((i*37)%101)/100.f > .5f);
+    }
+    EXPECT_EQ(SAMPLES, model.getSamplesCount());
+    EXPECT_TRUE(model.isTrainable());
+
+    unsigned version = model.getVersion();
+    auto trained = model.trainAsync();
+    EXPECT_TRUE(trained.get());
+    EXPECT_TRUE(model.isTrained());
+    EXPECT_EQ(version+1, model.getVersion());
+
+    // batched inference
+    m8r::AssociationAssessmentFeatureMatrix features{};
+    for(int i=0; i<SAMPLES; i++) {
+        setAaTestFeature(feature, i);
+        features.add(feature);
+    }
+    vector<float> scores{};
+    model.evaluate(features, scores);
+    ASSERT_EQ(SAMPLES, scores.size());
+
+    int correct = 0;
+    for(int i=0; i<SAMPLES; i++) {
+        EXPECT_GE(scores[i], 0.f);
+        EXPECT_LE(scores[i], 1.f);
+        if((scores[i] > .5f) == (((i*37)%101)/100.f > .5f)) {
+            correct++;
+        }
+
+        // batch and single pair evaluation are the same
+        setAaTestFeature(feature, i);
+        EXPECT_NEAR(model.evaluate(feature), scores[i], 1e-6);
+    }
+    EXPECT_GT(correct, SAMPLES*9/10);
+
+    model.clear();
+    EXPECT_FALSE(model.isTrained());
+}
+
+TEST(AiAaModelTestCase, RetrainWhenSamplesWindowIsFull)
+{
+    m8r::AssociationAssessmentModel model{};
+    m8r::AssociationAssessmentNotesFeature feature{};
+    const size_t RETRAIN_SAMPLES = 8;
+
+    // samples window is full and the model is trained
+    const size_t window = m8r::AssociationAssessmentModel::MAX_TRAINING_SAMPLES;
+    for(size_t i=0; i<window; i++) {
+        setAaTestFeature(feature, i);
+        model.addSample(feature, ((i*37)%101)/100.f > .5f);
+    }
+    EXPECT_TRUE(model.isRetrainable(RETRAIN_SAMPLES));
+    EXPECT_TRUE(model.train());
+    EXPECT_EQ(0, model.getNewSamplesCount());
+    EXPECT_FALSE(model.isRetrainable(RETRAIN_SAMPLES));
+
+    // new samples evict the oldest ones...
+    for(size_t i=0; i<RETRAIN_SAMPLES; i++) {
+        setAaTestFeature(feature, window+i);
+        model.addSample(feature, i%2);
+    }
+    EXPECT_EQ(window, model.getSamplesCount());
+    EXPECT_EQ(RETRAIN_SAMPLES, model.getNewSamplesCount());
+
+    // ... but the model is still retrained
+    EXPECT_TRUE(model.isRetrainable(RETRAIN_SAMPLES));
+    unsigned version = model.getVersion();
+    EXPECT_TRUE(model.trainAsync().get());
+    EXPECT_EQ(version+1, model.getVersion());
+    EXPECT_FALSE(model.isRetrainable(RETRAIN_SAMPLES));
+}
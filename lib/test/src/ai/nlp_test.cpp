@@ -33,6 +33,9 @@
 #include "../../../src/mind/ai/nlp/lexicon.h"
 #include "../../../src/mind/ai/nlp/word_frequency_list.h"
 #include "../../../src/mind/ai/nlp/bag_of_words.h"
+#include "../../../src/mind/ai/nlp/bm25_index.h"
+
+#include "../test_utils.h"
 
 #include <gtest/gtest.h>
 
@@ -301,9 +304,136 @@ TEST(AiNlpTestCase, DISABLED_AaUniverseBow)
  * AA: FTS
  */
 
+TEST(AiNlpTestCase, Bm25Index)
+{
+    m8r::TestSandbox box{"", true};
+    box.addMdFile(
+        "physics.md",
+        "# Physics\nNatural science.\n\n"
+        "## Albert Einstein\nRelativity theory of Albert Einstein.\n\n"
+        "## Relativity\nSpecial and general relativity.\n\n"
+        "## Quantum Mechanics\nQuantum theory.\n");
+    box.addMdFile(
+        "people.md",
+        "# People\nPeople.\n\n"
+        "## Einstein\nPhysicist.\n\n"
+        "## Bohr\nQuantum mechanics and Einstein debates.\n");
+    m8r::MarkdownRepositoryConfigurationRepresentation repositoryConfigRepresentation{};
+    m8r::Configuration& config = m8r::Configuration::getInstance();
+    config.clear();
+    config.setConfigFilePath(box.configPath);
+    config.setActiveRepository(config.addRepository(m8r::RepositoryIndexer::getRepositoryForPath(box.repositoryPath)), repositoryConfigRepresentation);
+    m8r::Mind mind(config);
+    mind.learn();
+    ASSERT_EQ(2, mind.remind().getOutlinesCount());
+
+    m8r::CommonWordsBlacklist commonWords{};
+    m8r::Bm25Index index{commonWords};
+    for(m8r::Outline* o:mind.remind().getOutlines()) {
+        index.addOutline(o);
+    }
+    EXPECT_EQ(7, index.size());
+
+    // tokenization: lowercase, common words skipped
+    vector<string> tokens{};
+    index.tokenize("The Self-Awareness of Albert!", tokens);
+    ASSERT_EQ(2, tokens.size());
+    EXPECT_EQ("self-awareness", tokens[0]);
+    EXPECT_EQ("albert", tokens[1]);
+
+    // name matches outrank description matches
+    vector<pair<m8r::Note*,float>> all{};
+    index.search("einstein relativity", 100, all);
+    ASSERT_EQ(4, all.size());
+    EXPECT_EQ("Albert Einstein", all[0].first->getName());
+    for(size_t i=1; i<all.size(); i++) {
+        EXPECT_GE(all[i-1].second, all[i].second);
+    }
+
+    // WAND top-K is the prefix of the full ranking
+    for(size_t k=1; k<all.size(); k++) {
+        vector<pair<m8r::Note*,float>> top{};
+        index.search("einstein relativity", k, top);
+        ASSERT_EQ(k, top.size());
+        for(size_t i=0; i<k; i++) {
+            EXPECT_EQ(all[i].first, top[i].first);
+            EXPECT_FLOAT_EQ(all[i].second, top[i].second);
+        }
+    }
+
+    // filter
+    vector<pair<m8r::Note*,float>> filtered{};
+    m8r::Note* best = all[0].first;
+    index.search("einstein relativity", 1, filtered, [best](const m8r::Note* n) { return n != best; });
+    ASSERT_EQ(1, filtered.size());
+    EXPECT_EQ(all[1].first, filtered[0].first);
+
+    // removed O is not found
+    index.removeOutline(best->getOutline());
+    EXPECT_EQ(3, index.size());
+    EXPECT_EQ(4, index.getRemovedCount());
+    index.search("relativity", 10, filtered);
+    EXPECT_EQ(0, filtered.size());
+    index.search("unknown", 10, filtered);
+    EXPECT_EQ(0, filtered.size());
+}
+
 TEST(AiNlpTestCase, AaRepositoryFts)
 {
-    // TODO AaRepositoryFts
+    m8r::TestSandbox box{"", true};
+    string physicsPath = box.addMdFile(
+        "physics.md",
+        "# Physics\nNatural science.\n\n"
+        "## Albert Einstein\nRelativity theory.\n\n"
+        "## Quantum Mechanics\nQuantum theory.\n");
+    box.addMdFile(
+        "people.md",
+        "# People\nPeople.\n\n"
+        "## Einstein\nPhysicist.\n\n"
+        "## Bohr\nQuantum mechanics.\n");
+    m8r::MarkdownRepositoryConfigurationRepresentation repositoryConfigRepresentation{};
+    m8r::Configuration& config = m8r::Configuration::getInstance();
+    config.clear();
+    config.setConfigFilePath(box.configPath);
+    config.setActiveRepository(config.addRepository(m8r::RepositoryIndexer::getRepositoryForPath(box.repositoryPath)), repositoryConfigRepresentation);
+    config.setAaAlgorithm(m8r::Configuration::AssociationAssessmentAlgorithm::WEIGHTED_FTS);
+    m8r::Mind mind(config);
+    mind.learn();
+    ASSERT_TRUE(mind.think().get());
+
+    // associations of N exclude N itself
+    m8r::Outline* physics = mind.remind().getOutline(physicsPath);
+    ASSERT_NE(nullptr, physics);
+    m8r::Note* einstein = physics->getNoteByName("Albert Einstein");
+    ASSERT_NE(nullptr, einstein);
+    m8r::AssociatedNotes associations{m8r::ResourceType::NOTE, einstein};
+    ASSERT_TRUE(mind.getAssociatedNotes(associations).get());
+    vector<pair<m8r::Note*,float>>* leaderboard = associations.getAssociations();
+    ASSERT_LE(1, leaderboard->size());
+    EXPECT_EQ("Einstein", (*leaderboard)[0].first->getName());
+    EXPECT_FLOAT_EQ(1.f, (*leaderboard)[0].second);
+    for(auto& a:*leaderboard) {
+        EXPECT_NE(einstein, a.first);
+    }
+
+    // modified N is re-indexed
+    m8r::AssociatedNotes before{m8r::ResourceType::WORD, "superconductivity"};
+    EXPECT_FALSE(mind.getAssociatedNotes(before).get());
+    m8r::Note* bohr = mind.remind().getOutlines()[0]==physics
+        ? mind.remind().getOutlines()[1]->getNoteByName("Bohr")
+        : mind.remind().getOutlines()[0]->getNoteByName("Bohr");
+    ASSERT_NE(nullptr, bohr);
+    bohr->setName("Bohr and superconductivity");
+    bohr->makeModified();
+    m8r::AssociatedNotes after{m8r::ResourceType::WORD, "superconductivity"};
+    ASSERT_TRUE(mind.getAssociatedNotes(after).get());
+    ASSERT_EQ(1, after.getAssociations()->size());
+    EXPECT_EQ(bohr, (*after.getAssociations())[0].first);
+
+    // forgotten N is not associated
+    mind.noteForget(bohr);
+    m8r::AssociatedNotes forgotten{m8r::ResourceType::WORD, "superconductivity"};
+    EXPECT_FALSE(mind.getAssociatedNotes(forgotten).get());
 }
 
 TEST(AiNlpTestCase, AaUniverseFts)
@@ -0,0 +1,314 @@
+/*
+ wingman_http_stand_in.cpp     MindForger thinking notebook
+
+ Copyright (C) 2016-2025 Martin Dvorak <martin.dvorak@mindforger.com>
+
+ This program is free software; you can redistribute it and/or
+ modify it under the terms of the GNU General Public License
+ as published by the Free Software Foundation; either version 2
+ of the License, or (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+#include "wingman_http_stand_in.h"
+
+#include <cerrno>
+#include <chrono>
+#include <cstring>
+
+#ifndef _WIN32
+  #include <arpa/inet.h>
+  #include <netinet/in.h>
+  #include <poll.h>
+  #include <sys/socket.h>
+  #include <unistd.h>
+#endif
+
+#include "../../../src/representations/json/nlohmann/json.hpp"
+#include "../../../src/gear/lang_utils.h"
+
+#ifndef MSG_NOSIGNAL
+  // macOS
+  #define MSG_NOSIGNAL 0
+#endif
+
+namespace m8r {
+
+using namespace std;
+
+#ifndef _WIN32
+/*
+ * Send all data - false if the client closed the connection.
+ */
+bool standInSend(int clientSocket, const string& data)
+{
+    size_t sent = 0;
+    while(sent < data.size()) {
+        ssize_t n = ::send(clientSocket, data.data()+sent, data.size()-sent, MSG_NOSIGNAL);
+        if(n <= 0) {
+            return false;
+        }
+        sent += n;
+    }
+    return true;
+}
+
+bool standInSendEvent(int clientSocket, const string& data)
+{
+    return standInSend(clientSocket, "data: " + data + "\n\n");
+}
+#endif
+
+WingmanHttpStandIn::WingmanHttpStandIn(Wingman& backend, int port)
+    : backend(backend),
+      port{port},
+      serverSocket{-1},
+      running{false},
+      tokenDelayMillis{0},
+      requests{0}
+{
+}
+
+WingmanHttpStandIn::~WingmanHttpStandIn()
+{
+    stop();
+}
+
+string WingmanHttpStandIn::getUrl() const
+{
+    return "http://127.0.0.1:" + std::to_string(port) + "/v1/chat/completions";
+}
+
+bool WingmanHttpStandIn::start()
+{
+#ifdef _WIN32
+    cerr << "Error: Wingman HTTP stand-in is not supported on Windows" << endl;
+    return false;
+#else
+    if(running) {
+        return true;
+    }
+
+    serverSocket = ::socket(AF_INET, SOCK_STREAM, 0);
+    if(serverSocket < 0) {
+        cerr << "Error: Wingman HTTP stand-in unable to create socket: " << strerror(errno) << endl;
+        return false;
+    }
+    int reuse = 1;
+    ::setsockopt(serverSocket, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse));
+
+    struct sockaddr_in address;
+    memset(&address, 0, sizeof(address));
+    address.sin_family = AF_INET;
+    address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    address.sin_port = htons(static_cast<uint16_t>(port));
+    socklen_t addressLength = sizeof(address);
+    if(::bind(serverSocket, (struct sockaddr*)&address, addressLength) < 0
+       || ::listen(serverSocket, 8) < 0
+       || ::getsockname(serverSocket, (struct sockaddr*)&address, &addressLength) < 0)
+    {
+        cerr << "Error: Wingman HTTP stand-in unable to listen on port " << port << ": " << strerror(errno) << endl;
+        ::close(serverSocket);
+        serverSocket = -1;
+        return false;
+    }
+    port = ntohs(address.sin_port);
+
+    MF_DEBUG("Wingman HTTP stand-in listening on: " << getUrl() << endl);
+
+    running = true;
+    acceptor = thread{&WingmanHttpStandIn::acceptLoop, this};
+    return true;
+#endif
+}
+
+void WingmanHttpStandIn::stop()
+{
+#ifndef _WIN32
+    running = false;
+    if(acceptor.joinable()) {
+        acceptor.join();
+    }
+    if(serverSocket >= 0) {
+        ::close(serverSocket);
+        serverSocket = -1;
+    }
+#endif
+}
+
+void WingmanHttpStandIn::acceptLoop()
+{
+#ifndef _WIN32
+    while(running) {
+        // poll w/ timeout so that stop() is noticed
+        struct pollfd pfd;
+        pfd.fd = serverSocket;
+        pfd.events = POLLIN;
+        pfd.revents = 0;
+        if(::poll(&pfd, 1, 100) <= 0) {
+            continue;
+        }
+
+        int clientSocket = ::accept(serverSocket, nullptr, nullptr);
+        if(clientSocket >= 0) {
+            serve(clientSocket);
+            ::close(clientSocket);
+        }
+    }
+#endif
+}
+
+/*
+ * Serve OpenAI API chat completions request.
+ */
+void WingmanHttpStandIn::serve(int clientSocket)
+{
+#ifdef _WIN32
+    UNUSED_ARG(clientSocket);
+#else
+    // read HTTP header and body (Content-Length)
+    string request{};
+    size_t headerEnd = string::npos;
+    size_t contentLength = 0;
+    char buffer[4096];
+    while(true) {
+        if(headerEnd == string::npos) {
+            headerEnd = request.find("\r\n\r\n");
+            if(headerEnd != string::npos) {
+                string header{request.substr(0, headerEnd)};
+                for(char& c:header) c = tolower(c);
+                size_t cl = header.find("content-length:");
+                if(cl != string::npos) {
+                    contentLength = strtoul(header.c_str()+cl+15, nullptr, 10);
+                }
+                headerEnd += 4;
+            }
+        }
+        if(headerEnd != string::npos && request.size() >= headerEnd + contentLength) {
+            break;
+        }
+
+        ssize_t n = ::recv(clientSocket, buffer, sizeof(buffer), 0);
+        if(n <= 0) {
+            return;
+        }
+        request.append(buffer, n);
+    }
+    requests++;
+
+    // parse request
+    CommandWingmanChat command{};
+    bool stream = false;
+    try {
+        auto requestJSon = nlohmann::json::parse(request.substr(headerEnd, contentLength));
+        if(requestJSon.contains("stream") && requestJSon["stream"].is_boolean()) {
+            stream = requestJSon["stream"].get<bool>();
+        }
+        if(requestJSon.contains("messages")) {
+            for(auto& message:requestJSon["messages"]) {
+                if(message.contains("role") && message["role"] == "user"
+                   && message.contains("content") && message["content"].is_string())
+                {
+                    message["content"].get_to(command.prompt);
+                }
+            }
+        }
+    } catch (...) {
+        standInSend(
+            clientSocket,
+            "HTTP/1.1 400 Bad Request\r\nContent-Type: application/json\r\nConnection: close\r\n\r\n"
+            "{\"error\": {\"message\": \"Invalid JSon request\"}}");
+        return;
+    }
+
+    backend.chat(command);
+
+    if(command.status != WingmanStatusCode::WINGMAN_STATUS_CODE_OK) {
+        nlohmann::json errorJSon;
+        errorJSon["error"]["message"] = command.errorMessage;
+        standInSend(
+            clientSocket,
+            "HTTP/1.1 500 Internal Server Error\r\nContent-Type: application/json\r\nConnection: close\r\n\r\n"
+            + errorJSon.dump());
+        return;
+    }
+
+    nlohmann::json usageJSon;
+    usageJSon["prompt_tokens"] = command.promptTokens;
+    usageJSon["completion_tokens"] = command.answerTokens;
+    usageJSon["total_tokens"] = command.promptTokens + command.answerTokens;
+
+    if(!stream) {
+        nlohmann::json choiceJSon;
+        choiceJSon["index"] = 0;
+        choiceJSon["message"]["role"] = "assistant";
+        choiceJSon["message"]["content"] = command.answerMarkdown;
+        choiceJSon["finish_reason"] = "stop";
+        nlohmann::json responseJSon;
+        responseJSon["object"] = "chat.completion";
+        responseJSon["model"] = command.answerLlmModel;
+        responseJSon["choices"] = nlohmann::json::array({choiceJSon});
+        responseJSon["usage"] = usageJSon;
+        string body{responseJSon.dump()};
+
+        standInSend(
+            clientSocket,
+            "HTTP/1.1 200 OK\r\nContent-Type: application/json\r\nConnection: close\r\n"
+            "Content-Length: " + std::to_string(body.size()) + "\r\n\r\n" + body);
+        return;
+    }
+
+    if(!standInSend(
+        clientSocket,
+        "HTTP/1.1 200 OK\r\nContent-Type: text/event-stream\r\n"
+        "Cache-Control: no-cache\r\nConnection: close\r\n\r\n"))
+    {
+        return;
+    }
+
+    // stream answer as tokens split after spaces
+    nlohmann::json chunkJSon;
+    chunkJSon["object"] = "chat.completion.chunk";
+    chunkJSon["model"] = command.answerLlmModel;
+    nlohmann::json choiceJSon;
+    choiceJSon["index"] = 0;
+    choiceJSon["finish_reason"] = nullptr;
+    const string& answer = command.answerMarkdown;
+    size_t begin = 0;
+    while(begin < answer.size()) {
+        size_t end = answer.find(' ', begin);
+        end = end == string::npos? answer.size(): end+1;
+
+        choiceJSon["delta"]["content"] = answer.substr(begin, end-begin);
+        chunkJSon["choices"] = nlohmann::json::array({choiceJSon});
+        if(!standInSendEvent(clientSocket, chunkJSon.dump())) {
+            MF_DEBUG("Wingman HTTP stand-in: client closed the stream" << endl);
+            return;
+        }
+        begin = end;
+
+        if(tokenDelayMillis > 0) {
+            this_thread::sleep_for(chrono::milliseconds(tokenDelayMillis));
+        }
+    }
+
+    choiceJSon["delta"] = nlohmann::json::object();
+    choiceJSon["finish_reason"] = "stop";
+    chunkJSon["choices"] = nlohmann::json::array({choiceJSon});
+    standInSendEvent(clientSocket, chunkJSon.dump());
+
+    chunkJSon["choices"] = nlohmann::json::array();
+    chunkJSon["usage"] = usageJSon;
+    standInSendEvent(clientSocket, chunkJSon.dump());
+
+    standInSendEvent(clientSocket, "[DONE]");
+#endif
+}
+
+} // m8r namespace
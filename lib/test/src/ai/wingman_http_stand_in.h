@@ -0,0 +1,84 @@
+/*
+ wingman_http_stand_in.h     MindForger thinking notebook
+
+ Copyright (C) 2016-2025 Martin Dvorak <martin.dvorak@mindforger.com>
+
+ This program is free software; you can redistribute it and/or
+ modify it under the terms of the GNU General Public License
+ as published by the Free Software Foundation; either version 2
+ of the License, or (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+#ifndef M8R_WINGMAN_HTTP_STAND_IN_H
+#define M8R_WINGMAN_HTTP_STAND_IN_H
+
+#include <atomic>
+#include <string>
+#include <thread>
+
+#include "../../../src/mind/ai/llm/wingman.h"
+
+namespace m8r {
+
+/**
+ * Wingman HTTP stand-in.
+ *
+ * Minimal local HTTP server which speaks OpenAI API chat completions
+ * (incl. server-sent events streaming) and answers prompts using a backend
+ * Wingman (typically MockWingman). It stands in for the LLM provider in unit
+ * tests: OpenAI/llama.cpp Wingmans are pointed to getUrl() instead of the real
+ * provider.
+ *
+ * Requests are served sequentially by a single thread, only POST requests
+ * with Content-Length are supported. Not available on Windows.
+ */
+class WingmanHttpStandIn
+{
+private:
+    Wingman& backend;
+
+    int port;
+    int serverSocket;
+    std::atomic<bool> running;
+    std::thread acceptor;
+
+    // delay between streamed tokens (simulates LLM generation)
+    std::atomic<int> tokenDelayMillis;
+    std::atomic<unsigned long> requests;
+
+public:
+    /**
+     * @param port  port to listen on - 0 for an ephemeral port.
+     */
+    explicit WingmanHttpStandIn(Wingman& backend, int port=0);
+    WingmanHttpStandIn(const WingmanHttpStandIn&) = delete;
+    WingmanHttpStandIn(const WingmanHttpStandIn&&) = delete;
+    WingmanHttpStandIn& operator =(const WingmanHttpStandIn&) = delete;
+    WingmanHttpStandIn& operator =(const WingmanHttpStandIn&&) = delete;
+    ~WingmanHttpStandIn();
+
+    /**
+     * @brief Start listening on 127.0.0.1 - returns false on failure.
+     */
+    bool start();
+    void stop();
+
+    int getPort() const { return port; }
+    std::string getUrl() const;
+    void setTokenDelay(int millis) { tokenDelayMillis = millis; }
+    unsigned long getRequestsCount() const { return requests; }
+
+private:
+    void acceptLoop();
+    void serve(int clientSocket);
+};
+
+}
+#endif // M8R_WINGMAN_HTTP_STAND_IN_H
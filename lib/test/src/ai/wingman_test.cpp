@@ -0,0 +1,206 @@
+/*
+ wingman_test.cpp     MindForger thinking notebook
+
+ Copyright (C) 2016-2025 Martin Dvorak <martin.dvorak@mindforger.com>
+
+ This program is free software; you can redistribute it and/or
+ modify it under the terms of the GNU General Public License
+ as published by the Free Software Foundation; either version 2
+ of the License, or (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <chrono>
+#include <iostream>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "../../../src/mind/ai/llm/wingman.h"
+#include "../../../src/mind/ai/llm/mock_wingman.h"
+#include "../../../src/mind/ai/llm/openai_wingman.h"
+#include "../../../src/mind/ai/llm/llamacpp_wingman.h"
+#include "../../../src/mind/ai/llm/wingman_cache.h"
+#include "wingman_http_stand_in.h"
+
+#include <gtest/gtest.h>
+
+using namespace std;
+
+class CollectingChatListener : public m8r::WingmanChatListener
+{
+public:
+    std::mutex tokensMutex;
+    vector<string> tokens;
+    size_t cancelAfter;
+
+    explicit CollectingChatListener(size_t cancelAfter=0)
+        : tokensMutex{}, tokens{}, cancelAfter{cancelAfter}
+    {}
+
+    virtual bool onToken(const string& token) override {
+        lock_guard<mutex> criticalSection{tokensMutex};
+        tokens.push_back(token);
+        return !cancelAfter || tokens.size() < cancelAfter;
+    }
+};
+
+m8r::CommandWingmanChat wingmanCommand(const string& prompt)
+{
+    m8r::CommandWingmanChat command{
+        prompt,
+        "",
+        m8r::WingmanStatusCode::WINGMAN_STATUS_CODE_ERROR,
+        "",
+        "",
+        0,
+        0,
+        "",
+        false
+    };
+    return command;
+}
+
+#ifndef _WIN32
+TEST(WingmanTestCase, LlamaCppStreamingChat)
+{
+    m8r::MockWingman mock{"mock-llm-model"};
+    m8r::WingmanHttpStandIn standIn{mock};
+    ASSERT_TRUE(standIn.start());
+
+    m8r::LlamaCppWingman wingman{standIn.getUrl(), "llama"};
+
+    // non-streaming chat
+    m8r::CommandWingmanChat command = wingmanCommand("Summarize MindForger");
+    wingman.chat(command);
+    EXPECT_EQ(m8r::WingmanStatusCode::WINGMAN_STATUS_CODE_OK, command.status);
+    EXPECT_EQ("chat(MOCK, 'Summarize MindForger')", command.answerMarkdown);
+    EXPECT_EQ("mock-llm-model", command.answerLlmModel);
+
+    // long answer: only a bounded prefix of the raw response is kept
+    const string longPrompt(3 * m8r::OPENAI_RESPONSE_DIAGNOSTICS_SIZE, 'x');
+    command = wingmanCommand(longPrompt);
+    wingman.chat(command);
+    EXPECT_EQ(m8r::WingmanStatusCode::WINGMAN_STATUS_CODE_OK, command.status);
+    EXPECT_EQ("chat(MOCK, '" + longPrompt + "')", command.answerMarkdown);
+    EXPECT_EQ(m8r::OPENAI_RESPONSE_DIAGNOSTICS_SIZE, command.httpResponse.size());
+
+    // streaming chat: answer arrives as tokens
+    command = wingmanCommand("Summarize MindForger");
+    CollectingChatListener listener{};
+    wingman.chatStream(command, listener);
+    EXPECT_EQ(m8r::WingmanStatusCode::WINGMAN_STATUS_CODE_OK, command.status);
+    EXPECT_EQ("chat(MOCK, 'Summarize MindForger')", command.answerMarkdown);
+    EXPECT_EQ(42, command.promptTokens);
+    EXPECT_EQ(42198, command.answerTokens);
+    ASSERT_EQ(3, listener.tokens.size());
+    string concatenated{};
+    for(auto& t:listener.tokens) concatenated += t;
+    EXPECT_EQ(command.answerMarkdown, concatenated);
+    EXPECT_EQ(3, standIn.getRequestsCount());
+
+    standIn.stop();
+}
+
+TEST(WingmanTestCase, StreamingChatCancel)
+{
+    m8r::MockWingman mock{"mock-llm-model"};
+    m8r::WingmanHttpStandIn standIn{mock};
+    standIn.setTokenDelay(50);
+    ASSERT_TRUE(standIn.start());
+
+    m8r::LlamaCppWingman wingman{standIn.getUrl(), "llama"};
+
+    // listener cancels the request after the first token
+    m8r::CommandWingmanChat command = wingmanCommand("one two three four five six seven eight nine ten");
+    CollectingChatListener listener{1};
+    auto start = chrono::steady_clock::now();
+    wingman.chatStream(command, listener);
+    auto elapsed = chrono::duration_cast<chrono::milliseconds>(chrono::steady_clock::now() - start).count();
+    EXPECT_EQ(m8r::WingmanStatusCode::WINGMAN_STATUS_CODE_ERROR, command.status);
+    EXPECT_EQ(m8r::WINGMAN_ERROR_CANCELLED, command.errorMessage);
+    EXPECT_TRUE(command.answerMarkdown.empty());
+    EXPECT_EQ(1, listener.tokens.size());
+    // the rest of the answer (11 tokens * 50ms) was not awaited
+    EXPECT_LT(elapsed, 500);
+
+    // cancellation before the request
+    command = wingmanCommand("Summarize MindForger");
+    CollectingChatListener cancelled{};
+    cancelled.cancel();
+    wingman.chatStream(command, cancelled);
+    EXPECT_EQ(m8r::WingmanStatusCode::WINGMAN_STATUS_CODE_ERROR, command.status);
+    EXPECT_EQ(0, cancelled.tokens.size());
+
+    standIn.stop();
+}
+#endif
+
+TEST(WingmanTestCase, Cache)
+{
+    m8r::MockWingman mock{"mock-llm-model"};
+    m8r::WingmanCache cache{2};
+
+    m8r::CommandWingmanChat command = wingmanCommand("A");
+    EXPECT_FALSE(cache.get("mock-llm-model", command));
+    mock.chat(command);
+    cache.put("mock-llm-model", command);
+    EXPECT_EQ(1, cache.size());
+
+    // hit
+    m8r::CommandWingmanChat hit = wingmanCommand("A");
+    EXPECT_TRUE(cache.get("mock-llm-model", hit));
+    EXPECT_TRUE(hit.cached);
+    EXPECT_EQ(m8r::WingmanStatusCode::WINGMAN_STATUS_CODE_OK, hit.status);
+    EXPECT_EQ(command.answerMarkdown, hit.answerMarkdown);
+    // different model is a miss
+    EXPECT_FALSE(cache.get("other-llm-model", hit));
+
+    // errors are not cached
+    m8r::CommandWingmanChat error = wingmanCommand("E");
+    error.status = m8r::WingmanStatusCode::WINGMAN_STATUS_CODE_ERROR;
+    cache.put("mock-llm-model", error);
+    EXPECT_EQ(1, cache.size());
+
+    // LRU eviction: A is used, B is evicted by C
+    m8r::CommandWingmanChat b = wingmanCommand("B");
+    mock.chat(b);
+    cache.put("mock-llm-model", b);
+    EXPECT_TRUE(cache.get("mock-llm-model", hit));
+    m8r::CommandWingmanChat c = wingmanCommand("C");
+    mock.chat(c);
+    cache.put("mock-llm-model", c);
+    EXPECT_EQ(2, cache.size());
+    b = wingmanCommand("B");
+    EXPECT_FALSE(cache.get("mock-llm-model", b));
+    hit = wingmanCommand("A");
+    EXPECT_TRUE(cache.get("mock-llm-model", hit));
+}
+
+TEST(WingmanTestCase, CacheKey)
+{
+    m8r::LlamaCppWingman local{"http://localhost:8080/v1/chat/completions", "llama"};
+    m8r::LlamaCppWingman remote{"http://remote:8080/v1/chat/completions", "llama"};
+    m8r::OpenAiWingman openAi{"api-key", "llama"};
+    m8r::MockWingman mock{"llama"};
+
+    // the same LLM model served by different endpoints/providers must not share answers
+    EXPECT_NE(local.getWingmanCacheKey(), remote.getWingmanCacheKey());
+    EXPECT_NE(local.getWingmanCacheKey(), openAi.getWingmanCacheKey());
+    EXPECT_NE(openAi.getWingmanCacheKey(), mock.getWingmanCacheKey());
+
+    m8r::WingmanCache cache{2};
+    m8r::CommandWingmanChat command = wingmanCommand("A");
+    mock.chat(command);
+    cache.put(local.getWingmanCacheKey(), command);
+    m8r::CommandWingmanChat hit = wingmanCommand("A");
+    EXPECT_TRUE(cache.get(local.getWingmanCacheKey(), hit));
+    EXPECT_FALSE(cache.get(remote.getWingmanCacheKey(), hit));
+}
@@ -0,0 +1,96 @@
+/*
+ synthetic_repository_test.cpp     MindForger thinking notebook
+
+ Copyright (C) 2016-2025 Martin Dvorak <martin.dvorak@mindforger.com>
+
+ This program is free software; you can redistribute it and/or
+ modify it under the terms of the GNU General Public License
+ as published by the Free Software Foundation; either version 2
+ of the License, or (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+#include <algorithm>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "../../../src/mind/mind.h"
+#include "../../benchmark/synthetic_repository.h"
+#include "../../benchmark/benchmark_report.h"
+#include "../test_utils.h"
+
+using namespace std;
+
+TEST(SyntheticRepositoryTestCase, Deterministic)
+{
+    m8r::SyntheticRepositoryProfile profile{};
+    profile.outlines = 20;
+    profile.notesPerOutline = 5;
+
+    m8r::SyntheticRepository a{profile}, b{profile};
+    for(unsigned o=0; o<profile.outlines; o++) {
+        ASSERT_EQ(a.outline(o), b.outline(o));
+    }
+    // Os don't depend on generation order
+    EXPECT_EQ(a.outline(3), b.outline(3));
+    EXPECT_NE(a.outline(3), a.outline(4));
+
+    profile.seed++;
+    m8r::SyntheticRepository c{profile};
+    EXPECT_NE(a.outline(0), c.outline(0));
+}
+
+TEST(SyntheticRepositoryTestCase, Learn)
+{
+    m8r::SyntheticRepositoryProfile profile{};
+    profile.outlines = 10;
+    profile.notesPerOutline = 7;
+    profile.tags = 5;
+
+    m8r::TestSandbox box{""};
+    m8r::SyntheticRepository generator{profile};
+    string repositoryPath = generator.generate(box.testHomePath + FILE_PATH_SEPARATOR + "synthetic-repository");
+    EXPECT_LT(profile.outlines * profile.notesPerOutline * profile.descriptionBytes / 2, generator.getBytes());
+
+    m8r::MarkdownRepositoryConfigurationRepresentation repositoryConfigRepresentation{};
+    m8r::Configuration& config = m8r::Configuration::getInstance();
+    config.clear();
+    config.setConfigFilePath(box.configPath);
+    config.setActiveRepository(config.addRepository(m8r::RepositoryIndexer::getRepositoryForPath(repositoryPath)), repositoryConfigRepresentation);
+    m8r::Mind mind(config);
+    mind.learn();
+
+    EXPECT_EQ(profile.outlines, mind.remind().getOutlinesCount());
+    EXPECT_EQ(profile.outlines * profile.notesPerOutline, mind.remind().getNotesCount());
+    vector<const m8r::Tag*> tags{mind.getOntology().findOrCreateTag(generator.getTags()[0])};
+    vector<m8r::Note*> tagged{};
+    mind.findNotesByTags(tags, tagged);
+    EXPECT_LT(0, tagged.size());
+}
+
+TEST(SyntheticRepositoryTestCase, Percentiles)
+{
+    m8r::BenchmarkReport report{};
+    for(int i=100; i>0; i--) {
+        report.add("scenario", i);
+    }
+    ASSERT_EQ(1, report.getScenarios().size());
+    vector<double> sorted{report.getScenarios()[0].samples};
+    sort(sorted.begin(), sorted.end());
+    EXPECT_DOUBLE_EQ(1, m8r::BenchmarkReport::percentile(sorted, 0));
+    EXPECT_DOUBLE_EQ(50.5, m8r::BenchmarkReport::percentile(sorted, 50));
+    EXPECT_DOUBLE_EQ(99.01, m8r::BenchmarkReport::percentile(sorted, 99));
+    EXPECT_DOUBLE_EQ(100, m8r::BenchmarkReport::percentile(sorted, 100));
+
+    string json = report.toJson();
+    EXPECT_NE(string::npos, json.find("\"p99\""));
+    EXPECT_NE(string::npos, json.find("\"name\": \"scenario\""));
+}
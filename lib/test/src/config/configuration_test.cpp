@@ -19,6 +19,7 @@
 
 #include "../../../src/representations/markdown/markdown_configuration_representation.h"
 #include "../../../src/config/repository_configuration.h"
+#include "../../../src/persistence/configuration_store.h"
 
 #include <gtest/gtest.h>
 #include "../test_utils.h"
@@ -237,3 +238,116 @@ TEST(ConfigurationTestCase, SaveAndLoad)
         c.setActiveRepository(nullptr, repositoryConfigRepresentation);
     }
 }
+
+TEST(ConfigurationTestCase, StoreCoalescesSaves)
+{
+    // GIVEN
+    m8r::TestSandbox box{"", true};
+    string configPath{box.configPath};
+    string tmpConfigPath{configPath + ".tmp"};
+    remove(configPath.c_str());
+
+    m8r::MarkdownRepositoryConfigurationRepresentation repositoryConfigRepresentation{};
+    m8r::Configuration& c = m8r::Configuration::getInstance();
+    c.clear();
+    c.setConfigFilePath(configPath);
+    c.setActiveRepository(
+        c.addRepository(m8r::RepositoryIndexer::getRepositoryForPath(box.repositoryPath)),
+        repositoryConfigRepresentation
+    );
+    // long delay ensures that the background flusher does NOT write
+    m8r::ConfigurationStore store{new m8r::MarkdownConfigurationRepresentation{}, 60000};
+
+    // WHEN
+    for(int i=0; i<1000; i++) {
+        c.setMindState(i%2?m8r::Configuration::MindState::THINKING:m8r::Configuration::MindState::SLEEPING);
+        store.save(c);
+    }
+
+    // THEN
+    EXPECT_TRUE(store.isDirty());
+    EXPECT_EQ(1000, store.getSaveRequestsCount());
+    EXPECT_EQ(0, store.getWritesCount());
+    EXPECT_FALSE(m8r::isFile(configPath.c_str()));
+
+    store.flush();
+
+    EXPECT_FALSE(store.isDirty());
+    EXPECT_EQ(1, store.getWritesCount());
+    EXPECT_TRUE(m8r::isFile(configPath.c_str()));
+    EXPECT_FALSE(m8r::isFile(tmpConfigPath.c_str()));
+}
+
+TEST(ConfigurationTestCase, StoreSnapshot)
+{
+    // GIVEN
+    m8r::TestSandbox box{"", true};
+    string configPath{box.configPath};
+    remove(configPath.c_str());
+
+    m8r::MarkdownRepositoryConfigurationRepresentation repositoryConfigRepresentation{};
+    m8r::Configuration& c = m8r::Configuration::getInstance();
+    c.clear();
+    c.setConfigFilePath(configPath);
+    c.setActiveRepository(
+        c.addRepository(m8r::RepositoryIndexer::getRepositoryForPath(box.repositoryPath)),
+        repositoryConfigRepresentation
+    );
+    m8r::ConfigurationStore store{new m8r::MarkdownConfigurationRepresentation{}, 60000};
+
+    // WHEN configuration is modified after save
+    c.setDistributorSleepInterval(1234);
+    store.save(c);
+    c.setDistributorSleepInterval(4321);
+    store.flush();
+
+    // THEN configuration as it was on save() is written
+    string* md = m8r::fileToString(configPath);
+    ASSERT_NE(nullptr, md);
+    EXPECT_NE(string::npos, md->find("Async refresh interval (ms): 1234"));
+    EXPECT_EQ(string::npos, md->find("Async refresh interval (ms): 4321"));
+    delete md;
+
+    c.setDistributorSleepInterval(m8r::Configuration::DEFAULT_DISTRIBUTOR_SLEEP_INTERVAL);
+}
+
+TEST(ConfigurationTestCase, StoreBackgroundFlush)
+{
+    // GIVEN
+    m8r::TestSandbox box{"", true};
+    string configPath{box.configPath};
+    remove(configPath.c_str());
+
+    m8r::MarkdownRepositoryConfigurationRepresentation repositoryConfigRepresentation{};
+    m8r::Configuration& c = m8r::Configuration::getInstance();
+    c.clear();
+    c.setConfigFilePath(configPath);
+    c.setActiveRepository(
+        c.addRepository(m8r::RepositoryIndexer::getRepositoryForPath(box.repositoryPath)),
+        repositoryConfigRepresentation
+    );
+    m8r::ConfigurationStore store{new m8r::MarkdownConfigurationRepresentation{}, 20};
+
+    // WHEN
+    std::vector<std::thread> savers{};
+    for(int t=0; t<4; t++) {
+        savers.push_back(std::thread{[&store,&c]() {
+            for(int i=0; i<100; i++) {
+                store.save(c);
+            }
+        }});
+    }
+    for(auto& saver:savers) {
+        saver.join();
+    }
+    for(int i=0; i<100 && store.isDirty(); i++) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    }
+
+    // THEN
+    EXPECT_FALSE(store.isDirty());
+    EXPECT_EQ(400, store.getSaveRequestsCount());
+    EXPECT_GE(store.getWritesCount(), 1);
+    EXPECT_LT(store.getWritesCount(), 400);
+    EXPECT_TRUE(m8r::isFile(configPath.c_str()));
+}
@@ -0,0 +1,176 @@
+/*
+ csv_test.cpp     MindForger CSV test
+
+ Copyright (C) 2016-2025 Martin Dvorak <martin.dvorak@mindforger.com>
+
+ This program is free software; you can redistribute it and/or
+ modify it under the terms of the GNU General Public License
+ as published by the Free Software Foundation; either version 2
+ of the License, or (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <cstring>
+#include <sstream>
+
+#include <gtest/gtest.h>
+
+#include "../test_utils.h"
+#include "../../../src/mind/ontology/ontology.h"
+#include "../../../src/representations/csv/csv_outline_representation.h"
+
+using namespace std;
+
+namespace m8r {
+
+class CsvTestOutlines
+{
+public:
+    Ontology ontology;
+    vector<Outline*> outlines;
+    map<const Tag*,int> tagsCardinality;
+
+    explicit CsvTestOutlines(int count)
+        : ontology{}, outlines{}, tagsCardinality{}
+    {
+        const Tag* cool = ontology.findOrCreateTag(Tag::KeyCool());
+        const Tag* important = ontology.findOrCreateTag(Tag::KeyImportant());
+        for(int i=0; i<count; i++) {
+            Outline* o = new Outline{ontology.getDefaultOutlineType()};
+            o->setKey("/tmp/o-" + std::to_string(i) + ".md");
+            o->setName("Outline, \"" + std::to_string(i) + "\"");
+            o->addTag(i%2?important:cool);
+            tagsCardinality[i%2?important:cool]++;
+            for(int j=0; j<2; j++) {
+                Note* n = new Note{ontology.getDefaultNoteType(), o};
+                n->setName("Note " + std::to_string(j));
+                n->addTag(cool);
+                tagsCardinality[cool]++;
+                o->addNote(n);
+            }
+            outlines.push_back(o);
+        }
+    }
+    ~CsvTestOutlines()
+    {
+        for(Outline* o:outlines) {
+            delete o;
+        }
+    }
+};
+
+void csvLines(const string& text, vector<string>& lines)
+{
+    istringstream is{text};
+    string line{};
+    while(getline(is, line)) {
+        lines.push_back(line);
+    }
+}
+
+} // m8r namespace
+
+TEST(CsvTestCase, ExportOrderAndOhe)
+{
+    // GIVEN
+    m8r::CsvTestOutlines data{100};
+    string path{m8r::platformSpecificPath("/tmp/mf-unit-csv-export.csv")};
+    remove(path.c_str());
+    m8r::CsvOutlineRepresentation csv{4};
+
+    // WHEN
+    ASSERT_TRUE(csv.to(data.outlines, data.tagsCardinality, path, 0));
+
+    // THEN
+    string* content = m8r::fileToString(path);
+    ASSERT_NE(nullptr, content);
+    vector<string> lines{};
+    m8r::csvLines(*content, lines);
+    delete content;
+
+    // header + O + 2 Ns for every O
+    ASSERT_EQ(1+100*3, lines.size());
+    // OHE columns order is given by tags cardinality map
+    bool coolFirst = lines[0].find(",cool,important") != string::npos;
+    EXPECT_EQ(
+        string{"id,type,title,offset,depth,reads,writes,created,modified,read,description,"}
+        + (coolFirst?"cool,important":"important,cool"),
+        lines[0]);
+    string coolOhe{coolFirst?",1,0":",0,1"};
+    string importantOhe{coolFirst?",0,1":",1,0"};
+    // Outlines must be written in the original order
+    for(int i=0; i<100; i++) {
+        const string& oLine = lines[1+i*3];
+        string key{"/tmp/o-" + std::to_string(i) + ".md,o,\"Outline, \"\"" + std::to_string(i) + "\"\"\""};
+        EXPECT_EQ(0, oLine.find(key)) << oLine;
+        EXPECT_EQ(i%2?importantOhe:coolOhe, oLine.substr(oLine.size()-4));
+        EXPECT_EQ(coolOhe, lines[1+i*3+1].substr(lines[1+i*3+1].size()-4));
+        EXPECT_NE(string::npos, lines[1+i*3+2].find(",n,\"Note 1\",2,1,")) << lines[1+i*3+2];
+    }
+    remove(path.c_str());
+}
+
+TEST(CsvTestCase, ExportWithoutOhe)
+{
+    // GIVEN
+    m8r::CsvTestOutlines data{3};
+    string out{};
+    m8r::CsvOutlineRepresentation::OheColumns oheColumns{};
+
+    // WHEN
+    m8r::CsvOutlineRepresentation csv{};
+    csv.toHeader(out, {});
+    for(m8r::Outline* o:data.outlines) {
+        csv.to(o, oheColumns, 0, out);
+    }
+
+    // THEN
+    vector<string> lines{};
+    m8r::csvLines(out, lines);
+    ASSERT_EQ(1+3*3, lines.size());
+    EXPECT_EQ("id,type,title,offset,depth,reads,writes,created,modified,read,description", lines[0]);
+    EXPECT_EQ(string::npos, lines[1].find(",0,1"));
+}
+
+TEST(CsvTestCase, ExportColumnar)
+{
+    // GIVEN
+    m8r::CsvTestOutlines data{10};
+    string path{m8r::platformSpecificPath("/tmp/mf-unit-csv-export.mfcol")};
+    remove(path.c_str());
+    m8r::CsvOutlineRepresentation csv{2};
+
+    // WHEN
+    ASSERT_TRUE(csv.toColumnar(data.outlines, data.tagsCardinality, path, 0));
+
+    // THEN
+    string* content = m8r::fileToString(path);
+    ASSERT_NE(nullptr, content);
+    ASSERT_LT(8+8+4, content->size());
+    EXPECT_EQ(m8r::CsvOutlineRepresentation::COLUMNAR_MAGIC, content->substr(0, 8));
+    uint64_t rows;
+    uint32_t columns;
+    memcpy(&rows, content->data()+8, sizeof(rows));
+    memcpy(&columns, content->data()+16, sizeof(columns));
+    EXPECT_EQ(10*3, rows);
+    // 11 columns + 2 OHE tags
+    EXPECT_EQ(13, columns);
+
+    // 1st descriptor: id string
+    const char* d = content->data()+20;
+    EXPECT_EQ(m8r::CsvOutlineRepresentation::COLUMNAR_TYPE_STRING, static_cast<uint8_t>(d[0]));
+    uint32_t nameLength;
+    memcpy(&nameLength, d+1, sizeof(nameLength));
+    EXPECT_EQ(2, nameLength);
+    EXPECT_EQ("id", string(d+5, nameLength));
+
+    delete content;
+    remove(path.c_str());
+}
@@ -175,3 +175,57 @@ TEST(DateTimeGearTestCase, MdDateTimeParsing)
     cout << endl;
     EXPECT_EQ(116, datetime.tm_year);
 }
+
+static time_t strptimeSeconds(const char* s)
+{
+    struct tm datetime;
+    // C-style initialization as GCC doesn't like {}
+    memset(&datetime, 0, sizeof datetime);
+    datetimeFrom(s, &datetime);
+    return datetimeSeconds(&datetime);
+}
+
+#ifndef _WIN32
+TEST(DateTimeGearTestCase, FastParsing)
+{
+    const char* originalTz = getenv("TZ");
+    string tzBackup{originalTz?originalTz:""};
+
+    // fast parser must give the same results as strptime() + mktime() incl. DST switch days
+    const char* timezones[] = { "UTC", "Europe/Prague", "America/New_York", "Australia/Sydney" };
+    char s[50];
+    for(const char* tz:timezones) {
+        setenv("TZ", tz, 1);
+        tzset();
+        datetimeTimezoneChanged();
+
+        unsigned checked = 0;
+        for(int y=1995; y<=2030; y++) {
+            for(int m=1; m<=12; m++) {
+                for(int d=1; d<=31; d+=(d%7==1?1:6)) {
+                    for(int h=0; h<24; h+=(h<4?1:7)) {
+                        snprintf(s, sizeof(s), "%04d-%02d-%02d %02d:%02d:%02d", y, m, d, h, (d*7)%60, (h*13)%60);
+                        ASSERT_EQ(strptimeSeconds(s), datetimeParse(s, strlen(s))) << s << " @ " << tz;
+                        checked++;
+                    }
+                }
+            }
+        }
+        cout << tz << ": " << checked << " timestamps" << endl;
+    }
+
+    // non-padded input falls back to strptime()
+    const char* loose = "2016-5-2 21:30:28";
+    EXPECT_EQ(strptimeSeconds(loose), datetimeParse(loose, strlen(loose)));
+    const char* garbage = "yesterday";
+    EXPECT_EQ(strptimeSeconds(garbage), datetimeParse(garbage, strlen(garbage)));
+
+    if(originalTz) {
+        setenv("TZ", tzBackup.c_str(), 1);
+    } else {
+        unsetenv("TZ");
+    }
+    tzset();
+    datetimeTimezoneChanged();
+}
+#endif //_WIN32
@@ -0,0 +1,119 @@
+/*
+ executor_test.cpp     MindForger application test
+
+ Copyright (C) 2016-2025 Martin Dvorak <martin.dvorak@mindforger.com>
+
+ This program is free software; you can redistribute it and/or
+ modify it under the terms of the GNU General Public License
+ as published by the Free Software Foundation; either version 2
+ of the License, or (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <atomic>
+#include <chrono>
+#include <future>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "gear/executor.h"
+
+using namespace std;
+
+TEST(ExecutorGearTestCase, SubmitAndParallelFor)
+{
+    // GIVEN
+    m8r::Executor executor{3};
+    EXPECT_EQ(3u, executor.getWorkersCount());
+
+    // WHEN
+    future<int> answer = executor.submit([]() { return 42; });
+    vector<int> squares(1000, 0);
+    executor.parallelFor(squares.size(), [&squares](size_t i) { squares[i] = static_cast<int>(i*i); });
+
+    // THEN
+    EXPECT_EQ(42, answer.get());
+    for(size_t i=0; i<squares.size(); i++) {
+        ASSERT_EQ(static_cast<int>(i*i), squares[i]);
+    }
+
+    // WHEN nested fork/join from workers doesn't starve the pool
+    atomic<int> leaves{0};
+    executor.parallelFor(8, [&executor, &leaves](size_t) {
+        executor.parallelFor(8, [&leaves](size_t) { leaves++; });
+    });
+
+    // THEN
+    EXPECT_EQ(64, leaves.load());
+}
+
+TEST(ExecutorGearTestCase, PrioritiesAndCancellation)
+{
+    // GIVEN single worker blocked by a task
+    m8r::Executor executor{1};
+    promise<void> gate{};
+    shared_future<void> opened = gate.get_future().share();
+    future<void> blocker = executor.submit([opened]() { opened.wait(); }, m8r::Executor::Priority::INTERACTIVE);
+
+    vector<int> order{};
+    mutex orderMutex{};
+    auto record = [&order, &orderMutex](int i) {
+        lock_guard<mutex> lock{orderMutex};
+        order.push_back(i);
+    };
+
+    // WHEN
+    m8r::Executor::CancellationToken token{};
+    future<void> background = executor.submit([&record]() { record(2); }, m8r::Executor::Priority::BACKGROUND);
+    future<void> stale = executor.submit([&record]() { record(3); }, m8r::Executor::Priority::INTERACTIVE, token);
+    future<void> interactive = executor.submit([&record]() { record(1); }, m8r::Executor::Priority::INTERACTIVE);
+    token.cancel();
+    gate.set_value();
+    blocker.get();
+    background.get();
+    interactive.get();
+
+    // THEN interactive task overtakes background one, cancelled task is dropped
+    ASSERT_EQ(2u, order.size());
+    EXPECT_EQ(1, order[0]);
+    EXPECT_EQ(2, order[1]);
+    EXPECT_THROW(stale.get(), future_error);
+    EXPECT_EQ(1u, executor.getDroppedCount());
+}
+
+TEST(ExecutorGearTestCase, Composition)
+{
+    // GIVEN
+    m8r::Executor executor{2};
+
+    // WHEN
+    shared_future<int> a = executor.submit([]() { return 20; }).share();
+    shared_future<int> b = executor.then(a, [](const shared_future<int>& f) { return f.get()+22; });
+    vector<shared_future<int>> all{a, b};
+    shared_future<void> both = executor.whenAll(all);
+    executor.wait(both);
+
+    // THEN
+    EXPECT_EQ(20, a.get());
+    EXPECT_EQ(42, b.get());
+
+    // WHEN group tasks which haven't been picked by workers run on wait()
+    atomic<int> done{0};
+    {
+        m8r::Executor::TaskGroup group{executor};
+        for(int i=0; i<100; i++) {
+            group.run([&done]() { done++; });
+        }
+        group.wait();
+        EXPECT_EQ(100, done.load());
+    }
+}
@@ -0,0 +1,128 @@
+/*
+ fuzzy_finder_test.cpp     MindForger application test
+
+ Copyright (C) 2016-2025 Martin Dvorak <martin.dvorak@mindforger.com>
+
+ This program is free software; you can redistribute it and/or
+ modify it under the terms of the GNU General Public License
+ as published by the Free Software Foundation; either version 2
+ of the License, or (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <chrono>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "gear/fuzzy_finder.h"
+
+using namespace std;
+
+static vector<string> names(m8r::FuzzyFinder& finder, const vector<m8r::FuzzyFinder::Match>& matches)
+{
+    vector<string> result{};
+    for(const m8r::FuzzyFinder::Match& m:matches) {
+        result.push_back(finder.getName(m.index));
+    }
+    return result;
+}
+
+TEST(FuzzyFinderGearTestCase, Modes)
+{
+    // GIVEN
+    m8r::FuzzyFinder finder{};
+    finder.index(vector<string>{
+        "Personal Finance",
+        "Finance",
+        "My finances and savings",
+        "Refinancing",
+        "Fine arts",
+        "Linux kernel",
+    });
+    vector<m8r::FuzzyFinder::Match> matches{};
+
+    // WHEN/THEN empty query matches all
+    EXPECT_EQ(6u, finder.find("", m8r::FuzzyFinder::Mode::KEYWORDS, true, 100, matches));
+    EXPECT_EQ(6u, matches.size());
+    EXPECT_EQ(0u, matches[0].index);
+
+    // WHEN/THEN prefix
+    EXPECT_EQ(2u, finder.find("fin", m8r::FuzzyFinder::Mode::PREFIX, true, 100, matches));
+    EXPECT_EQ("Finance", names(finder, matches)[0]);
+    EXPECT_EQ("Fine arts", names(finder, matches)[1]);
+    EXPECT_EQ(0u, finder.find("fin", m8r::FuzzyFinder::Mode::PREFIX, false, 100, matches));
+
+    // WHEN/THEN keywords: all keywords must match, name start and word start first
+    EXPECT_EQ(4u, finder.find("financ", m8r::FuzzyFinder::Mode::KEYWORDS, true, 100, matches));
+    EXPECT_EQ("Finance", names(finder, matches)[0]);
+    EXPECT_EQ("Refinancing", names(finder, matches)[3]);
+    EXPECT_EQ(1u, finder.find("financ sav", m8r::FuzzyFinder::Mode::KEYWORDS, true, 100, matches));
+    EXPECT_EQ("My finances and savings", names(finder, matches)[0]);
+    EXPECT_EQ(2u, finder.find("Financ", m8r::FuzzyFinder::Mode::KEYWORDS, false, 100, matches));
+
+    // WHEN/THEN fuzzy
+    EXPECT_EQ(1u, finder.find("lnxkrn", m8r::FuzzyFinder::Mode::FUZZY, true, 100, matches));
+    EXPECT_EQ("Linux kernel", names(finder, matches)[0]);
+    finder.find("pf", m8r::FuzzyFinder::Mode::FUZZY, true, 100, matches);
+    EXPECT_EQ("Personal Finance", names(finder, matches)[0]);
+
+    // WHEN/THEN limit
+    EXPECT_EQ(5u, finder.find("fin", m8r::FuzzyFinder::Mode::KEYWORDS, true, 2, matches));
+    EXPECT_EQ(2u, matches.size());
+}
+
+TEST(FuzzyFinderGearTestCase, IncrementalAndParallel)
+{
+    // GIVEN index which is scored in parallel
+    vector<string> ns{};
+    for(int i=0; i<200000; i++) {
+        ns.push_back("Note " + to_string(i) + (i%7? " about software": " about hardware"));
+    }
+    m8r::FuzzyFinder finder{};
+    finder.setThreads(4);
+    finder.index(ns);
+    m8r::FuzzyFinder singleThreaded{};
+    singleThreaded.setThreads(1);
+    singleThreaded.index(ns);
+
+    // WHEN typing
+    vector<m8r::FuzzyFinder::Match> matches{}, expected{};
+    string query{};
+    for(char c:string{"hard 14"}) {
+        query += c;
+        auto begin = chrono::steady_clock::now();
+        size_t count = finder.find(query, m8r::FuzzyFinder::Mode::KEYWORDS, true, 1000, matches);
+        auto end = chrono::steady_clock::now();
+        cout << "'" << query << "' " << count << " matches in "
+             << chrono::duration_cast<chrono::microseconds>(end-begin).count()/1000.0 << "ms" << endl;
+
+        // THEN narrowed and parallel result is the same as full single threaded scan
+        singleThreaded.find("", m8r::FuzzyFinder::Mode::KEYWORDS, true, 0, expected);
+        EXPECT_EQ(count, singleThreaded.find(query, m8r::FuzzyFinder::Mode::KEYWORDS, true, 1000, expected));
+        ASSERT_EQ(expected.size(), matches.size());
+        for(size_t i=0; i<matches.size(); i++) {
+            EXPECT_EQ(expected[i].index, matches[i].index);
+            EXPECT_EQ(expected[i].score, matches[i].score);
+        }
+    }
+
+    // THEN
+    EXPECT_EQ(1000u, matches.size());
+    EXPECT_EQ("Note 14 about hardware", finder.getName(matches[0].index));
+
+    // WHEN query is changed (not narrowed)
+    size_t count = finder.find("soft", m8r::FuzzyFinder::Mode::KEYWORDS, true, 10, matches);
+
+    // THEN
+    EXPECT_EQ(200000u - 200000u/7 - 1, count);
+}
@@ -0,0 +1,135 @@
+/*
+ instrumentation_test.cpp     MindForger application test
+
+ Copyright (C) 2016-2025 Martin Dvorak <martin.dvorak@mindforger.com>
+
+ This program is free software; you can redistribute it and/or
+ modify it under the terms of the GNU General Public License
+ as published by the Free Software Foundation; either version 2
+ of the License, or (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "gear/instrumentation.h"
+
+using namespace std;
+
+static const m8r::Instrumentation::ProbeStats* findProbe(
+    const vector<m8r::Instrumentation::ProbeStats>& probes, const string& name)
+{
+    for(const m8r::Instrumentation::ProbeStats& p:probes) {
+        if(p.name == name) {
+            return &p;
+        }
+    }
+    return nullptr;
+}
+
+TEST(InstrumentationGearTestCase, TimersAndCounters)
+{
+    // GIVEN
+    m8r::Instrumentation::setEnabled(true);
+    m8r::Instrumentation::reset();
+    int probe = m8r::Instrumentation::probe("test.timer");
+    EXPECT_EQ(probe, m8r::Instrumentation::probe("test.timer"));
+
+    // WHEN
+    m8r::Instrumentation::record(probe, 1);
+    m8r::Instrumentation::record(probe, 100);
+    m8r::Instrumentation::record(probe, 1000);
+    {
+        M8R_INSTRUMENTATION_TIMER(timer, "test.scope");
+        this_thread::sleep_for(chrono::milliseconds(2));
+        EXPECT_GE(timer.elapsedMicros(), 2000u);
+    }
+    for(int i=0; i<3; i++) {
+        M8R_INSTRUMENTATION_COUNT("test.counter", 5);
+    }
+
+    // THEN
+    vector<m8r::Instrumentation::ProbeStats> probes = m8r::Instrumentation::snapshot();
+    cout << m8r::Instrumentation::toString();
+
+    const m8r::Instrumentation::ProbeStats* t = findProbe(probes, "test.timer");
+    ASSERT_NE(nullptr, t);
+    EXPECT_EQ(3u, t->count);
+    EXPECT_EQ(1101u, t->sum);
+    EXPECT_EQ(1u, t->min);
+    EXPECT_EQ(1000u, t->max);
+    EXPECT_EQ(127u, t->percentile(50));
+    EXPECT_EQ(1000u, t->percentile(99));
+
+    const m8r::Instrumentation::ProbeStats* s = findProbe(probes, "test.scope");
+    ASSERT_NE(nullptr, s);
+    EXPECT_EQ(1u, s->count);
+    EXPECT_GE(s->min, 2000u);
+
+    const m8r::Instrumentation::ProbeStats* c = findProbe(probes, "test.counter");
+    ASSERT_NE(nullptr, c);
+    EXPECT_EQ(m8r::Instrumentation::ProbeType::COUNTER, c->type);
+    EXPECT_EQ(3u, c->count);
+    EXPECT_EQ(15u, c->sum);
+
+    string json = m8r::Instrumentation::toJson();
+    cout << json << endl;
+    EXPECT_NE(string::npos, json.find("{\"name\":\"test.timer\",\"type\":\"timer\",\"count\":3,\"totalUs\":1101"));
+    EXPECT_NE(string::npos, json.find("{\"name\":\"test.counter\",\"type\":\"counter\",\"count\":3,\"total\":15}"));
+
+    // WHEN disabled
+    m8r::Instrumentation::setEnabled(false);
+    m8r::Instrumentation::record(probe, 1);
+    m8r::Instrumentation::setEnabled(true);
+
+    // THEN
+    EXPECT_EQ(3u, findProbe(m8r::Instrumentation::snapshot(), "test.timer")->count);
+
+    // WHEN reset
+    m8r::Instrumentation::reset();
+
+    // THEN
+    EXPECT_EQ(nullptr, findProbe(m8r::Instrumentation::snapshot(), "test.timer"));
+}
+
+TEST(InstrumentationGearTestCase, Threads)
+{
+    // GIVEN
+    m8r::Instrumentation::setEnabled(true);
+    m8r::Instrumentation::reset();
+    int probe = m8r::Instrumentation::probe("test.threads", m8r::Instrumentation::ProbeType::COUNTER);
+
+    // WHEN samples are recorded by finished as well as by reused thread blocks
+    for(int round=0; round<2; round++) {
+        vector<thread> threads{};
+        for(int t=0; t<4; t++) {
+            threads.push_back(thread{[probe]() {
+                for(int i=0; i<1000; i++) {
+                    m8r::Instrumentation::count(probe);
+                }
+            }});
+        }
+        for(thread& t:threads) {
+            t.join();
+        }
+    }
+
+    // THEN
+    vector<m8r::Instrumentation::ProbeStats> probes = m8r::Instrumentation::snapshot();
+    const m8r::Instrumentation::ProbeStats* p = findProbe(probes, "test.threads");
+    ASSERT_NE(nullptr, p);
+    EXPECT_EQ(8000u, p->count);
+    EXPECT_EQ(8000u, p->sum);
+}
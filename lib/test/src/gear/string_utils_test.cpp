@@ -134,3 +134,35 @@ TEST(StringGearTestCase, StringTweaks)
 
     ASSERT_STREQ("a2345", s.c_str());
 }
+
+TEST(StringGearTestCase, FindIgnoreCase)
+{
+    // GIVEN haystacks of various lengths (SIMD blocks and scalar tail)
+    string haystack{
+        "Lorem IPSUM dolor sit amet, Příliš žluťoučký kůň, CONSECTETUR adipiscing elit. "
+        "Sed do EIUSMOD tempor incididunt ut labore et dolore MAGNA aliqua. Ut enim ad minim."};
+    vector<string> needles{
+        "l", "lorem", "ipsum", "sit amet", "příliš", "žluťoučký kůň", "consectetur",
+        "eiusmod tempor", "minim.", "magna aliqua", "ut", "x", "notfound", "minim. ", ""};
+
+    // WHEN/THEN search matches lowercase copy search
+    string lower{};
+    for(size_t size=0; size<=haystack.size(); size++) {
+        string h{haystack.substr(0, size)};
+        lower.clear();
+        stringToLower(h, lower);
+        for(const string& needle:needles) {
+            for(size_t from=0; from<=size+1; from+=7) {
+                ASSERT_EQ(lower.find(needle, from), stringFindIgnoreCase(h, needle, from))
+                    << "'" << needle << "' in '" << h << "' from " << from;
+            }
+        }
+    }
+
+    // uppercase UTF-8 is not folded (the same as stringToLower())
+    EXPECT_EQ(string::npos, stringFindIgnoreCase(string{"PŘÍLIŠ"}, string{"příliš"}));
+    EXPECT_EQ(0, stringFindIgnoreCase(string{"PříLIš"}, string{"příliš"}));
+
+    EXPECT_TRUE(stringistring("MindForger", "mindforger"));
+    EXPECT_FALSE(stringistring("MindForger", "mindforge"));
+}
@@ -74,6 +74,70 @@ TEST(HtmlTestCase, Outline)
     EXPECT_NE(std::string::npos, html.find("Stroustrup"));
 }
 
+TEST(HtmlTestCase, OutlineSections)
+{
+    string fileName{"/lib/test/resources/benchmark-repository/memory/meta.md"};
+    fileName.insert(0, getMindforgerGitHomePath());
+
+    m8r::MarkdownRepositoryConfigurationRepresentation repositoryConfigRepresentation{};
+    m8r::Configuration& config = m8r::Configuration::getInstance();
+    config.clear();
+    config.setConfigFilePath("/tmp/cfg-htc-os.md");
+    config.setActiveRepository(
+        config.addRepository(m8r::RepositoryIndexer::getRepositoryForPath(fileName)),
+        repositoryConfigRepresentation
+    );
+    m8r::Mind mind(config);
+    m8r::HtmlColorsMock dummyColors{};
+    m8r::HtmlOutlineRepresentation htmlRepresentation{mind.remind().getOntology(), dummyColors, nullptr};
+    mind.learn();
+    mind.think().get();
+
+    ASSERT_GE(mind.remind().getOutlinesCount(), 1);
+    m8r::Outline* outline = mind.remind().getOutlines()[0];
+    ASSERT_GE(outline->getNotesCount(), 2);
+
+    // whole O rendered by sections
+    htmlRepresentation.setSectionRendering(true);
+    htmlRepresentation.setThreads(4);
+    string html{};
+    htmlRepresentation.to(outline, &html, false, false, true, true);
+    EXPECT_NE(std::string::npos, html.find("Stroustrup"));
+#ifndef MF_NO_MD_2_HTML
+    EXPECT_EQ(outline->getNotesCount()+1, htmlRepresentation.getFragmentsCount());
+#endif
+
+    // unchanged O > fragments reused
+    string again{};
+    htmlRepresentation.to(outline, &again, false, false, true, true);
+    EXPECT_EQ(html, again);
+
+    // changed N > only its section is re-rendered
+    m8r::Note* note = outline->getNotes()[1];
+    note->addDescriptionLine(new string{"SectionRenderingMarker"});
+    again.clear();
+    htmlRepresentation.to(outline, &again, false, false, true, true);
+    EXPECT_NE(std::string::npos, again.find("SectionRenderingMarker"));
+    EXPECT_NE(std::string::npos, again.find("Stroustrup"));
+
+    // raw theme > Markdown is shown as is, no sections are transcoded
+    htmlRepresentation.clearFragments();
+    config.setUiHtmlCssPath(m8r::UI_HTML_THEME_CSS_RAW);
+    string raw{};
+    htmlRepresentation.to(outline, &raw, false, false, true, true);
+    EXPECT_NE(std::string::npos, raw.find("<pre># "));
+    EXPECT_EQ(0u, htmlRepresentation.getFragmentsCount());
+    config.setUiHtmlCssPath(m8r::UI_DEFAULT_HTML_CSS_THEME);
+
+    // whole O rendered at once
+    htmlRepresentation.setSectionRendering(false);
+    htmlRepresentation.clearFragments();
+    string whole{};
+    htmlRepresentation.to(outline, &whole, false, false, true, true);
+    EXPECT_NE(std::string::npos, whole.find("SectionRenderingMarker"));
+    EXPECT_EQ(0u, htmlRepresentation.getFragmentsCount());
+}
+
 TEST(HtmlTestCase, Note)
 {
     string fileName{"/lib/test/resources/benchmark-repository/memory/meta.md"};
@@ -682,3 +682,70 @@ TEST(RepositoryIndexerTestCase, MakePathRelative)
 
     delete repository;
 }
+
+TEST(RepositoryIndexerTestCase, FileTable)
+{
+    string repositoryPath{m8r::platformSpecificPath("/tmp/mf-unit-repository-indexer-table")};
+    map<string,string> pathToContent;
+    m8r::createEmptyRepository(repositoryPath, pathToContent);
+
+    // nested directories w/ files created in non-sorted order
+    string memoryPath{repositoryPath + FILE_PATH_SEPARATOR + "memory"};
+    vector<string> directories{"z", "a", m8r::platformSpecificPath("a/b"), "m"};
+    for(const string& d:directories) {
+        m8r::createDirectory(memoryPath + FILE_PATH_SEPARATOR + d);
+    }
+    vector<string> files{
+        m8r::platformSpecificPath("z/last.md"),
+        "first.md",
+        m8r::platformSpecificPath("a/b/deep.md"),
+        m8r::platformSpecificPath("m/paper.pdf"),
+        m8r::platformSpecificPath("a/notes.txt"),
+        m8r::platformSpecificPath("m/middle.md")
+    };
+    for(const string& f:files) {
+        m8r::stringToFile(memoryPath + FILE_PATH_SEPARATOR + f, "# " + f + "\n");
+    }
+
+    m8r::RepositoryIndexer repositoryIndexer{};
+    m8r::Repository* repository = m8r::RepositoryIndexer::getRepositoryForPath(repositoryPath);
+    repositoryIndexer.index(repository);
+
+    // table is sorted by path and it has metadata captured by the walk
+    const vector<m8r::FileStat>& table = repositoryIndexer.getAllOutlineFileNames();
+    ASSERT_EQ(files.size(), table.size());
+    for(size_t i=1; i<table.size(); i++) {
+        EXPECT_LT(table[i-1].path, table[i].path);
+    }
+    for(const string& f:files) {
+        const m8r::FileStat* file = repositoryIndexer.getFile(memoryPath + FILE_PATH_SEPARATOR + f);
+        ASSERT_NE(nullptr, file);
+        EXPECT_EQ(f.size()+3, file->size);
+        EXPECT_EQ(m8r::fileModificationTime(&file->path), file->modified);
+    }
+    EXPECT_EQ(nullptr, repositoryIndexer.getFile(memoryPath + FILE_PATH_SEPARATOR + "missing.md"));
+    EXPECT_EQ(4, repositoryIndexer.getMarkdownFiles().size());
+    EXPECT_EQ(1, repositoryIndexer.getPdfFiles().size());
+    EXPECT_EQ(1, repositoryIndexer.getTextFiles().size());
+
+    // parallel walk gives the same table as sequential walk
+    vector<m8r::FileStat> sequential{}, parallel{};
+    m8r::DirectoryWalker{1}.walk(memoryPath, sequential);
+    m8r::DirectoryWalker{4}.walk(memoryPath, parallel);
+    ASSERT_EQ(sequential.size(), parallel.size());
+    for(size_t i=0; i<sequential.size(); i++) {
+        EXPECT_EQ(sequential[i].path, parallel[i].path);
+    }
+
+    // incremental updates keep the table sorted
+    string added{memoryPath + FILE_PATH_SEPARATOR + "b.md"};
+    m8r::stringToFile(added, "# B\n");
+    EXPECT_TRUE(repositoryIndexer.addFile(added));
+    EXPECT_FALSE(repositoryIndexer.addFile(added));
+    EXPECT_EQ(added, table[2].path);
+    EXPECT_EQ(4, repositoryIndexer.getFile(added)->size);
+    EXPECT_EQ(2, repositoryIndexer.removeFiles(memoryPath + FILE_PATH_SEPARATOR + "a"));
+    EXPECT_EQ(files.size()-1, table.size());
+
+    delete repository;
+}
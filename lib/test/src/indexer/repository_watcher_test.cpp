@@ -0,0 +1,172 @@
+/*
+ repository_watcher_test.cpp     MindForger repository watcher test
+
+ Copyright (C) 2016-2025 Martin Dvorak <martin.dvorak@mindforger.com>
+
+ This program is free software; you can redistribute it and/or
+ modify it under the terms of the GNU General Public License
+ as published by the Free Software Foundation; either version 2
+ of the License, or (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <cstdio>
+#include <map>
+#include <string>
+
+#include <gtest/gtest.h>
+
+#include "../../../src/repository_watcher.h"
+#include "../../../src/mind/mind.h"
+#include "../../../src/representations/markdown/markdown_repository_configuration_representation.h"
+
+#include "../test_utils.h"
+
+using namespace std;
+
+#ifdef __linux__
+
+namespace m8r {
+
+class RepositoryChangeListenerMock : public RepositoryChangeListener
+{
+public:
+    map<string,Outline*> learnedOutlines;
+    map<string,Outline*> replacedOutlines;
+    vector<string> unlearnedOutlines;
+
+    virtual void learned(Outline* outline, Outline* replaced) override {
+        learnedOutlines[outline->getKey()] = outline;
+        if(replaced) {
+            replacedOutlines[outline->getKey()] = replaced;
+        }
+    }
+    virtual void unlearned(Outline* outline) override {
+        unlearnedOutlines.push_back(outline->getKey());
+    }
+};
+
+} // m8r namespace
+
+TEST(RepositoryWatcherTestCase, CoalescedChanges)
+{
+    // GIVEN
+    m8r::TestSandbox box{"", true};
+    string modifiedPath = box.addMdFile("modified.md", "# Modified\nOutline.\n");
+    string deletedPath = box.addMdFile("deleted.md", "# Deleted\nOutline.\n");
+    string memoryPath{box.repositoryPath + "/memory"};
+    m8r::RepositoryWatcher watcher{};
+    ASSERT_TRUE(watcher.watch(memoryPath));
+    vector<m8r::RepositoryChange> changes{};
+    EXPECT_EQ(0, watcher.poll(changes));
+
+    // WHEN files are created, modified and deleted (incl. files in a new directory)
+    string createdPath{memoryPath + "/created.md"};
+    m8r::stringToFile(createdPath, "# Created\n");
+    m8r::stringToFile(createdPath, "# Created\nOutline.\n");
+    m8r::stringToFile(modifiedPath, "# Modified\nModified Outline.\n");
+    std::remove(deletedPath.c_str());
+    string transientPath{memoryPath + "/transient.md"};
+    m8r::stringToFile(transientPath, "# Transient\n");
+    std::remove(transientPath.c_str());
+    m8r::stringToFile(memoryPath + "/ignored.txt", "Not a Markdown.");
+    string directoryPath{memoryPath + "/directory"};
+    m8r::createDirectory(directoryPath);
+    m8r::stringToFile(directoryPath + "/nested.md", "# Nested\n");
+
+    // THEN changes are coalesced per file
+    ASSERT_LT(0, watcher.poll(changes, 500));
+    map<string,m8r::RepositoryChange::Type> byPath{};
+    for(auto& c:changes) {
+        byPath[c.path] = c.type;
+    }
+    EXPECT_EQ(4, byPath.size());
+    EXPECT_EQ(m8r::RepositoryChange::Type::CREATED, byPath[createdPath]);
+    EXPECT_EQ(m8r::RepositoryChange::Type::MODIFIED, byPath[modifiedPath]);
+    EXPECT_EQ(m8r::RepositoryChange::Type::DELETED, byPath[deletedPath]);
+    EXPECT_EQ(m8r::RepositoryChange::Type::CREATED, byPath[directoryPath + "/nested.md"]);
+    EXPECT_EQ(2, watcher.getWatchesCount());
+
+    // WHEN directory is deleted
+    m8r::removeDirectoryRecursively(directoryPath.c_str());
+
+    // THEN it's reported as deleted directory
+    watcher.poll(changes, 500);
+    bool directoryDeleted = false;
+    for(auto& c:changes) {
+        if(c.path == directoryPath) {
+            directoryDeleted = c.directory && c.type == m8r::RepositoryChange::Type::DELETED;
+        }
+    }
+    EXPECT_TRUE(directoryDeleted);
+    EXPECT_EQ(1, watcher.getWatchesCount());
+}
+
+TEST(RepositoryWatcherTestCase, LearnChanges)
+{
+    // GIVEN
+    m8r::TestSandbox box{"", true};
+    string modifiedPath = box.addMdFile("modified.md", "# Modified\nOutline.\n\n## Note\nNote.\n");
+    string deletedPath = box.addMdFile("deleted.md", "# Deleted\nOutline.\n");
+    string keptPath = box.addMdFile("kept.md", "# Kept\nOutline.\n");
+    string createdPath{box.repositoryPath + "/memory/created.md"};
+
+    m8r::MarkdownRepositoryConfigurationRepresentation repositoryConfigRepresentation{};
+    m8r::Configuration& config = m8r::Configuration::getInstance();
+    config.clear();
+    config.setConfigFilePath(box.configPath);
+    config.setActiveRepository(
+        config.addRepository(m8r::RepositoryIndexer::getRepositoryForPath(box.repositoryPath)),
+        repositoryConfigRepresentation
+    );
+    m8r::Mind mind(config);
+    mind.learn();
+    ASSERT_EQ(3, mind.remind().getOutlinesCount());
+    ASSERT_TRUE(mind.repositoryWatch());
+    m8r::RepositoryChangeListenerMock listener{};
+    mind.addRepositoryChangeListener(&listener);
+    m8r::Outline* kept = mind.remind().getOutline(keptPath);
+    m8r::Outline* modified = mind.remind().getOutline(modifiedPath);
+
+    // WHEN repository is changed outside of MindForger
+    m8r::stringToFile(modifiedPath, "# Modified\nOutline.\n\n## Note\nNote.\n\n## New Note\nNew.\n");
+    m8r::stringToFile(createdPath, "# Created\nOutline.\n");
+    std::remove(deletedPath.c_str());
+
+    // THEN only changed Os are (un)learned
+    EXPECT_EQ(3, mind.repositoryLearnChanges(500));
+    EXPECT_EQ(3, mind.remind().getOutlinesCount());
+    EXPECT_EQ(kept, mind.remind().getOutline(keptPath));
+    ASSERT_NE(nullptr, mind.remind().getOutline(modifiedPath));
+    EXPECT_EQ(2, mind.remind().getOutline(modifiedPath)->getNotesCount());
+    ASSERT_NE(nullptr, mind.remind().getOutline(createdPath));
+    EXPECT_EQ(nullptr, mind.remind().getOutline(deletedPath));
+    EXPECT_EQ(2, listener.learnedOutlines.size());
+    EXPECT_EQ(modified, listener.replacedOutlines[modifiedPath]);
+    EXPECT_EQ(1, listener.unlearnedOutlines.size());
+    EXPECT_EQ(deletedPath, listener.unlearnedOutlines[0]);
+    // replaced and unlearned Os are deleted
+    EXPECT_EQ(0, mind.remind().getRetiredOutlinesCount());
+    // index is kept current
+    EXPECT_EQ(3, mind.remind().getRepositoryIndexer().getMarkdownFiles().size());
+
+    // WHEN O is saved by MindForger
+    m8r::Outline* created = mind.remind().getOutline(createdPath);
+    created->setName("Created and saved");
+    mind.remember(createdPath);
+
+    // THEN own change is ignored
+    EXPECT_EQ(0, mind.repositoryLearnChanges(500));
+    EXPECT_EQ(created, mind.remind().getOutline(createdPath));
+
+    mind.removeRepositoryChangeListener(&listener);
+}
+
+#endif
@@ -17,11 +17,15 @@
  along with this program. If not, see <http://www.gnu.org/licenses/>.
  */
 
+#include <map>
+
 #include <gtest/gtest.h>
 
 #include "../test_utils.h"
 #include "../../../src/mind/ai/llm/wingman.h"
 #include "../../../src/representations/json/nlohmann/json.hpp"
+#include "../../../src/representations/json/json_writer.h"
+#include "../../../src/representations/json/json_sax_parser.h"
 #include "../../../src/gear/string_utils.h"
 
 using namespace std;
@@ -153,3 +157,134 @@ TEST(JSonTestCase, ParseOpenAiResponse)
         491,
         answerTokens);
 }
+
+namespace m8r {
+
+class CollectingSaxHandler : public JSonSaxHandler
+{
+public:
+    vector<string> events;
+    map<string,int> nextItems;
+
+    virtual void onString(const string& path, const string& value) override {
+        events.push_back(path + "=\"" + value + "\"");
+    }
+    virtual void onNumber(const string& path, const string& value) override {
+        events.push_back(path + "=" + value);
+    }
+    virtual void onBoolean(const string& path, bool value) override {
+        events.push_back(path + "=" + (value? "true": "false"));
+    }
+    virtual void onNull(const string& path) override {
+        events.push_back(path + "=null");
+    }
+    virtual void onArrayNextItem(const string& path) override {
+        nextItems[path]++;
+    }
+};
+
+} // m8r namespace
+
+TEST(JSonTestCase, StreamingWriter)
+{
+    // GIVEN
+    string prompt{"Who is the \"godfather\" of C++?\n\tC:\\ \x01 \xc5\xbelu\xc5\xa5ou\xc4\x8dk\xc3\xbd"};
+    string line1{"# Line"};
+    string line2{"\"quoted\""};
+    vector<string*> lines{&line1, &line2};
+
+    // WHEN
+    string json{};
+    m8r::JSonWriter w{json};
+    w.beginObject();
+    w.key("model").value("gpt-3.5-turbo");
+    w.key("messages").beginArray();
+    w.beginObject().key("role").value("user").key("content").value(prompt).endObject();
+    w.beginObject().key("role").value("user").key("content").value(lines, "\n").endObject();
+    w.endArray();
+    w.key("stream").value(true);
+    w.key("n").value(1);
+    w.key("stop").valueNull();
+    w.key("empty").beginArray().endArray();
+    w.endObject();
+
+    // THEN escaped in place and parsed back to the original strings
+    EXPECT_EQ(
+        "{\"model\":\"gpt-3.5-turbo\",\"messages\":["
+        "{\"role\":\"user\",\"content\":\"Who is the \\\"godfather\\\" of C++?\\n\\tC:\\\\ \\u0001 \xc5\xbelu\xc5\xa5ou\xc4\x8dk\xc3\xbd\"},"
+        "{\"role\":\"user\",\"content\":\"# Line\\n\\\"quoted\\\"\"}],"
+        "\"stream\":true,\"n\":1,\"stop\":null,\"empty\":[]}",
+        json);
+    auto parsed = nlohmann::json::parse(json);
+    EXPECT_EQ(prompt, parsed["messages"][0]["content"].get<string>());
+    EXPECT_EQ("# Line\n\"quoted\"", parsed["messages"][1]["content"].get<string>());
+}
+
+TEST(JSonTestCase, SaxParserChunks)
+{
+    // GIVEN
+    string httpResponseStr{"{\"id\": \"chatcmpl-8gsp\",\"created\": 1705231239,\"model\": \"gpt-3.5-turbo-0613\",\"choices\": [{\"index\": 0,\"message\": {\"role\": \"assistant\",\"content\": \"LLM \\\"answer\\\":\\n42 \\u010d \\ud83d\\ude00\"},\"logprobs\": null,\"finish_reason\": \"stop\"}],\"usage\": {\"prompt_tokens\": 26,\"completion_tokens\": -4.91e2},\"done\": [true, false, [], {}]}"};
+    vector<string> expected{
+        "id=\"chatcmpl-8gsp\"",
+        "created=1705231239",
+        "model=\"gpt-3.5-turbo-0613\"",
+        "choices[].index=0",
+        "choices[].message.role=\"assistant\"",
+        "choices[].message.content=\"LLM \"answer\":\n42 \xc4\x8d \xf0\x9f\x98\x80\"",
+        "choices[].logprobs=null",
+        "choices[].finish_reason=\"stop\"",
+        "usage.prompt_tokens=26",
+        "usage.completion_tokens=-4.91e2",
+        "done[]=true",
+        "done[]=false",
+    };
+
+    // WHEN fed at once
+    m8r::CollectingSaxHandler whole{};
+    m8r::JSonSaxParser parser{whole};
+    EXPECT_TRUE(parser.feed(httpResponseStr));
+    EXPECT_TRUE(parser.finish());
+    // THEN
+    EXPECT_EQ(expected, whole.events);
+
+    // WHEN fed byte by byte (tokens, escapes and surrogates split by chunk boundary)
+    m8r::CollectingSaxHandler bytes{};
+    m8r::JSonSaxParser bytesParser{bytes};
+    for(char c:httpResponseStr) {
+        ASSERT_TRUE(bytesParser.feed(&c, 1));
+    }
+    EXPECT_TRUE(bytesParser.finish());
+    // THEN
+    EXPECT_EQ(expected, bytes.events);
+
+    // WHEN parser is reused for top level scalar
+    m8r::CollectingSaxHandler scalar{};
+    m8r::JSonSaxParser scalarParser{scalar};
+    EXPECT_TRUE(scalarParser.feed("42"));
+    EXPECT_FALSE(scalarParser.isDone());
+    EXPECT_TRUE(scalarParser.finish());
+    ASSERT_EQ(1, scalar.events.size());
+    EXPECT_EQ("=42", scalar.events[0]);
+
+    // WHEN arrays have more items
+    m8r::CollectingSaxHandler items{};
+    m8r::JSonSaxParser itemsParser{items};
+    EXPECT_TRUE(itemsParser.feed("{\"choices\":[{\"a\":1},{\"a\":2},{\"a\":3}],\"x\":[[1,2],[3]],\"y\":[]}"));
+    EXPECT_TRUE(itemsParser.finish());
+    // THEN
+    EXPECT_EQ(2, items.nextItems["choices[]"]);
+    EXPECT_EQ(1, items.nextItems["x[]"]);
+    EXPECT_EQ(1, items.nextItems["x[][]"]);
+    EXPECT_EQ(0, items.nextItems.count("y[]"));
+
+    // WHEN invalid or incomplete JSon
+    for(const char* invalid:{"{\"a\" 1}", "{\"a\":1,}", "[1 2]", "{\"a\":tru}", "\"\\x\"", "{\"a\":1", "{} {}"}) {
+        m8r::CollectingSaxHandler h{};
+        m8r::JSonSaxParser p{h};
+        bool valid = p.feed(invalid);
+        valid = p.finish() && valid;
+        // THEN
+        EXPECT_FALSE(valid) << invalid;
+        EXPECT_FALSE(p.getError().empty()) << invalid;
+    }
+}
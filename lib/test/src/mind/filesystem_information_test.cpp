@@ -22,7 +22,7 @@
 #include "../test_utils.h"
 #include "../../../src/mind/dikw/filesystem_information.h"
 
-#include "../../src/debug.h"
+#include "../../../src/debug.h"
 
 using namespace std;
 
@@ -82,3 +82,93 @@ TEST(FilesystemInformationTestCase, IndexPdfs) {
     EXPECT_TRUE(is.getPdfs().size());
     // TODO assert Os descriptors existence
 }
+
+static m8r::Outline* findOutlineByName(m8r::Mind& mind, const string& name)
+{
+    for(m8r::Outline* o:mind.remind().getOutlines()) {
+        if(o->getName() == name) {
+            return o;
+        }
+    }
+    return nullptr;
+}
+
+/**
+ * @brief Test incremental library synchronization driven by the manifest.
+ */
+TEST(FilesystemInformationTestCase, SynchronizePdfs) {
+    // GIVEN
+    m8r::TestSandbox box{"", true};
+    string libraryPath{box.testHomePath+"/sync-library"};
+    m8r::createDirectories(libraryPath+"/sub");
+    m8r::stringToFile(libraryPath+"/a.pdf", "%PDF-1.4 document A");
+    m8r::stringToFile(libraryPath+"/b.pdf", "%PDF-1.4 document B which will be moved");
+    m8r::stringToFile(libraryPath+"/sub/c.pdf", "%PDF-1.4 document C");
+    m8r::stringToFile(libraryPath+"/sub/c.txt", "not a PDF");
+
+    m8r::Ontology ontology{};
+    m8r::MarkdownDocumentRepresentation mddr{ontology};
+
+    m8r::MarkdownRepositoryConfigurationRepresentation repositoryConfigRepresentation{};
+    m8r::Configuration& config = m8r::Configuration::getInstance();
+    config.clear();
+    config.setConfigFilePath("/tmp/cfg-fitc-sp.md");
+    config.setActiveRepository(
+        config.addRepository(m8r::RepositoryIndexer::getRepositoryForPath(box.repositoryPath)),
+        repositoryConfigRepresentation
+    );
+    m8r::Mind mind(config);
+    mind.learn();
+    mind.think().get();
+    size_t outlinesCount = mind.remind().getOutlinesCount();
+
+    // WHEN library is indexed
+    m8r::FilesystemInformationSource is{libraryPath, mind, mddr};
+    is.setThreads(2);
+    ASSERT_EQ(m8r::FilesystemInformationSource::ErrorCode::SUCCESS, is.indexToMemory(*config.getActiveRepository()));
+
+    // THEN descriptors of all PDFs are created
+    EXPECT_EQ(3, is.getPdfs().size());
+    EXPECT_EQ(3, is.getAddedCount());
+    EXPECT_EQ(outlinesCount+3, mind.remind().getOutlinesCount());
+    ASSERT_NE(nullptr, findOutlineByName(mind, "b.pdf"));
+
+    // WHEN library is synchronized w/o changes
+    m8r::FilesystemInformationSource unchanged{libraryPath, mind, mddr};
+    EXPECT_EQ(
+        m8r::FilesystemInformationSource::ErrorCode::LIBRARY_ALREADY_EXISTS,
+        unchanged.indexToMemory(*config.getActiveRepository()));
+    ASSERT_EQ(m8r::FilesystemInformationSource::ErrorCode::SUCCESS, unchanged.indexToMemory(*config.getActiveRepository(), true));
+
+    // THEN nothing is done
+    EXPECT_EQ(0, unchanged.getAddedCount());
+    EXPECT_EQ(0, unchanged.getModifiedCount());
+    EXPECT_EQ(0, unchanged.getRenamedCount());
+    EXPECT_EQ(0, unchanged.getOrphansCount());
+    EXPECT_EQ(outlinesCount+3, mind.remind().getOutlinesCount());
+
+    // WHEN document is moved, deleted and added
+    m8r::moveFile(libraryPath+"/b.pdf", libraryPath+"/sub/b2.pdf");
+    remove((libraryPath+"/a.pdf").c_str());
+    m8r::stringToFile(libraryPath+"/d.pdf", "%PDF-1.4 document D");
+    m8r::FilesystemInformationSource changed{libraryPath, mind, mddr};
+    // scan can be run by a worker thread, changes are applied to memory later
+    ASSERT_EQ(m8r::FilesystemInformationSource::ErrorCode::SUCCESS, changed.scan(*config.getActiveRepository(), true));
+    EXPECT_EQ(outlinesCount+3, mind.remind().getOutlinesCount());
+    ASSERT_EQ(m8r::FilesystemInformationSource::ErrorCode::SUCCESS, changed.applyToMemory());
+
+    // THEN moved document's descriptor is moved, orphan is tagged and new descriptor created
+    EXPECT_EQ(1, changed.getAddedCount());
+    EXPECT_EQ(1, changed.getRenamedCount());
+    EXPECT_EQ(1, changed.getOrphansCount());
+    EXPECT_EQ(outlinesCount+4, mind.remind().getOutlinesCount());
+    EXPECT_EQ(nullptr, findOutlineByName(mind, "b.pdf"));
+    m8r::Outline* moved = findOutlineByName(mind, "b2.pdf");
+    ASSERT_NE(nullptr, moved);
+    EXPECT_TRUE(m8r::isFile(moved->getKey().c_str()));
+    EXPECT_NE(string::npos, moved->getDescription()[0]->find("sub/b2.pdf"));
+    m8r::Outline* orphan = findOutlineByName(mind, "a.pdf");
+    ASSERT_NE(nullptr, orphan);
+    EXPECT_TRUE(orphan->hasTag(mind.getOntology().findOrCreateTag("orphan")));
+    EXPECT_NE(nullptr, findOutlineByName(mind, "d.pdf"));
+}
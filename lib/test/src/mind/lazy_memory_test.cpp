@@ -0,0 +1,248 @@
+/*
+ lazy_memory_test.cpp     MindForger lazy memory test
+
+ Copyright (C) 2016-2025 Martin Dvorak <martin.dvorak@mindforger.com>
+
+ This program is free software; you can redistribute it and/or
+ modify it under the terms of the GNU General Public License
+ as published by the Free Software Foundation; either version 2
+ of the License, or (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <cstdio>
+#include <map>
+#include <memory>
+#include <string>
+
+#include <gtest/gtest.h>
+
+#include "../test_utils.h"
+#include "../../../src/mind/mind.h"
+#include "../../../src/mind/ai/nlp/bm25_index.h"
+#include "../../../src/representations/markdown/markdown_repository_configuration_representation.h"
+
+using namespace std;
+
+extern char* getMindforgerGitHomePath();
+
+namespace m8r {
+
+void prepareLazyMemoryRepository(TestSandbox& box)
+{
+    string resourcesPath{string{getMindforgerGitHomePath()} + "/lib/test/resources/"};
+    for(auto r:{"basic-repository", "bugs-repository", "links-repository", "i18n-repository", "universe-repository"}) {
+        string target{box.repositoryPath + "/memory/" + r};
+        createDirectory(target);
+        copyDirectoryRecursively((resourcesPath + r + "/memory").c_str(), target.c_str());
+    }
+    copyFile(
+        resourcesPath + "benchmark-repository/memory/meta.md",
+        box.repositoryPath + "/memory/meta.md");
+}
+
+unique_ptr<Mind> learnLazyMemoryRepository(TestSandbox& box, int lazyMemoryCap)
+{
+    MarkdownRepositoryConfigurationRepresentation repositoryConfigRepresentation{};
+    Configuration& config = Configuration::getInstance();
+    config.clear();
+    config.setConfigFilePath(box.configPath);
+    config.setActiveRepository(
+        config.addRepository(RepositoryIndexer::getRepositoryForPath(box.repositoryPath)),
+        repositoryConfigRepresentation
+    );
+    config.setLazyMemoryCap(lazyMemoryCap);
+    unique_ptr<Mind> mind{new Mind{config}};
+    mind->remind().setSnapshot(false);
+    mind->learn();
+    return mind;
+}
+
+void dumpLazyMemoryOutlines(Mind& mind, map<string,string>& dump)
+{
+    MarkdownOutlineRepresentation mdr{mind.getOntology(), nullptr};
+    dump.clear();
+    for(Outline* o:mind.remind().getOutlines()) {
+        string* md = mdr.to(o);
+        dump[o->getKey()] = *md;
+        delete md;
+        // UI trims lazy memory when it switches O
+        mind.remind().getLazyBodies().trim();
+    }
+}
+
+} // m8r namespace
+
+TEST(LazyMemoryTestCase, LoadAndEvict)
+{
+    // GIVEN
+    m8r::TestSandbox box{"", true};
+    m8r::prepareLazyMemoryRepository(box);
+    map<string,string> eager{};
+    map<string,string> lazy{};
+    unique_ptr<m8r::Mind> mind = m8r::learnLazyMemoryRepository(box, 0);
+    m8r::dumpLazyMemoryOutlines(*mind, eager);
+    size_t notesCount = mind->remind().getNotesCount();
+    ASSERT_LT(10, eager.size());
+
+    // WHEN lazy memory w/ 1MB cap
+    mind = m8r::learnLazyMemoryRepository(box, 1);
+    m8r::LazyOutlineBodies& lazyBodies = mind->remind().getLazyBodies();
+
+    // THEN Os and N skeletons are learned, but Ns descriptions are NOT in memory
+    ASSERT_EQ(eager.size(), mind->remind().getOutlinesCount());
+    EXPECT_EQ(notesCount, mind->remind().getNotesCount());
+    EXPECT_EQ(0, lazyBodies.getResidentCount());
+    EXPECT_EQ(0, lazyBodies.getLoads());
+    for(m8r::Outline* o:mind->remind().getOutlines()) {
+        EXPECT_FALSE(o->isBodiesResident());
+    }
+
+    // WHEN all descriptions are accessed
+    m8r::dumpLazyMemoryOutlines(*mind, lazy);
+
+    // THEN they are loaded on demand, the same as eagerly learned and evicted to fit the cap
+    EXPECT_EQ(eager.size(), lazyBodies.getLoads());
+    EXPECT_EQ(eager, lazy);
+    EXPECT_LT(0, lazyBodies.getEvictions());
+    EXPECT_TRUE(lazyBodies.getResidentBytes() <= lazyBodies.getCap() || lazyBodies.getResidentCount() == 1);
+}
+
+TEST(LazyMemoryTestCase, ModifiedOutlines)
+{
+    // GIVEN
+    m8r::TestSandbox box{"", true};
+    m8r::prepareLazyMemoryRepository(box);
+    unique_ptr<m8r::Mind> mind = m8r::learnLazyMemoryRepository(box, 1);
+    map<string,string> dump{};
+    string savedKey{box.repositoryPath + "/memory/basic-repository/outline.md"};
+    string unsavedKey{box.repositoryPath + "/memory/universe-repository/universe.md"};
+
+    // WHEN a N is changed and saved
+    m8r::Outline* saved = mind->remind().getOutline(savedKey);
+    ASSERT_NE(nullptr, saved);
+    ASSERT_LT(0, saved->getNotesCount());
+    saved->getNotes()[0]->addDescriptionLine(new string{"Lazy saved line."});
+    saved->getNotes()[0]->makeModified();
+    mind->remind().remember(savedKey);
+    // ... and another N is changed, but NOT saved
+    m8r::Outline* unsaved = mind->remind().getOutline(unsavedKey);
+    ASSERT_NE(nullptr, unsaved);
+    ASSERT_LT(0, unsaved->getNotesCount());
+    unsaved->getNotes()[0]->addDescriptionLine(new string{"Lazy unsaved line."});
+    unsaved->getNotes()[0]->makeModified();
+
+    // ... and all descriptions are accessed (evictions)
+    m8r::dumpLazyMemoryOutlines(*mind, dump);
+
+    // THEN saved change is (re)loaded and unsaved O is never evicted
+    EXPECT_LT(0, mind->remind().getLazyBodies().getEvictions());
+    EXPECT_TRUE(unsaved->isBodiesResident());
+    EXPECT_NE(string::npos, saved->getNotes()[0]->getDescriptionAsString().find("Lazy saved line."));
+    EXPECT_NE(string::npos, unsaved->getNotes()[0]->getDescriptionAsString().find("Lazy unsaved line."));
+
+    // WHEN O is forgotten (file moved to limbo)
+    mind->remind().forget(saved);
+
+    // THEN its descriptions are kept in memory for good
+    EXPECT_TRUE(saved->isBodiesResident());
+    EXPECT_EQ(nullptr, saved->getBodiesLoader());
+    EXPECT_NE(string::npos, saved->getNotes()[0]->getDescriptionAsString().find("Lazy saved line."));
+}
+
+TEST(LazyMemoryTestCase, PinnedOutlines)
+{
+    // GIVEN
+    m8r::TestSandbox box{"", true};
+    m8r::prepareLazyMemoryRepository(box);
+    unique_ptr<m8r::Mind> mind = m8r::learnLazyMemoryRepository(box, 1);
+    m8r::LazyOutlineBodies& lazyBodies = mind->remind().getLazyBodies();
+    map<string,string> dump{};
+    string pinnedKey{box.repositoryPath + "/memory/basic-repository/outline.md"};
+    m8r::Outline* pinned = mind->remind().getOutline(pinnedKey);
+    ASSERT_NE(nullptr, pinned);
+
+    // WHEN O is pinned by a reader (twice) and all descriptions are accessed
+    lazyBodies.pin(pinned);
+    EXPECT_TRUE(pinned->isBodiesResident());
+    {
+        m8r::OutlineBodiesPin pin{pinned};
+        m8r::dumpLazyMemoryOutlines(*mind, dump);
+    }
+
+    // THEN loads don't evict, trim() evicts other Os, but not the pinned one
+    EXPECT_LT(0, lazyBodies.getEvictions());
+    EXPECT_TRUE(pinned->isBodiesResident());
+
+    // WHEN the last pin is released
+    size_t evictions = lazyBodies.getEvictions();
+    lazyBodies.unpin(pinned);
+    m8r::dumpLazyMemoryOutlines(*mind, dump);
+
+    // THEN O can be evicted
+    EXPECT_LT(evictions, lazyBodies.getEvictions());
+    EXPECT_FALSE(pinned->isBodiesResident());
+}
+
+TEST(LazyMemoryTestCase, CsvExport)
+{
+    // GIVEN
+    m8r::TestSandbox box{"", true};
+    m8r::prepareLazyMemoryRepository(box);
+    string eagerPath{box.repositoryPath + "/eager.csv"};
+    string lazyPath{box.repositoryPath + "/lazy.csv"};
+    map<const m8r::Tag*,int> tagsCardinality{};
+    unique_ptr<m8r::Mind> mind = m8r::learnLazyMemoryRepository(box, 0);
+    ASSERT_TRUE(mind->remind().exportToCsv(eagerPath, tagsCardinality, -1, nullptr));
+
+    // WHEN Os are exported by parallel workers from lazy memory
+    mind = m8r::learnLazyMemoryRepository(box, 1);
+    m8r::LazyOutlineBodies& lazyBodies = mind->remind().getLazyBodies();
+    ASSERT_TRUE(mind->remind().exportToCsv(lazyPath, tagsCardinality, -1, nullptr));
+
+    // THEN descriptions are loaded on demand and the export is the same as from eager memory
+    EXPECT_EQ(mind->remind().getOutlinesCount(), lazyBodies.getLoads());
+    unique_ptr<string> eager{m8r::fileToString(eagerPath)};
+    unique_ptr<string> lazy{m8r::fileToString(lazyPath)};
+    ASSERT_TRUE(eager && lazy);
+    EXPECT_EQ(*eager, *lazy);
+    // ... and workers released their pins
+    lazyBodies.trim();
+    EXPECT_TRUE(lazyBodies.getResidentBytes() <= lazyBodies.getCap() || lazyBodies.getResidentCount() == 1);
+}
+
+TEST(LazyMemoryTestCase, FtsIndex)
+{
+    // GIVEN
+    m8r::TestSandbox box{"", true};
+    m8r::prepareLazyMemoryRepository(box);
+    m8r::CommonWordsBlacklist commonWords{};
+    unique_ptr<m8r::Mind> mind = m8r::learnLazyMemoryRepository(box, 0);
+    m8r::Bm25Index eager{commonWords};
+    for(m8r::Outline* o:mind->remind().getOutlines()) {
+        eager.addOutline(o);
+    }
+
+    // WHEN Os are indexed from lazy memory
+    mind = m8r::learnLazyMemoryRepository(box, 1);
+    m8r::LazyOutlineBodies& lazyBodies = mind->remind().getLazyBodies();
+    m8r::Bm25Index lazy{commonWords};
+    for(m8r::Outline* o:mind->remind().getOutlines()) {
+        lazy.addOutline(o);
+    }
+
+    // THEN descriptions are loaded on demand and the index is the same as from eager memory
+    EXPECT_EQ(mind->remind().getOutlinesCount(), lazyBodies.getLoads());
+    EXPECT_EQ(eager.size(), lazy.size());
+    EXPECT_EQ(eager.getTermsCount(), lazy.getTermsCount());
+    // ... and indexer released its pins
+    lazyBodies.trim();
+    EXPECT_TRUE(lazyBodies.getResidentBytes() <= lazyBodies.getCap() || lazyBodies.getResidentCount() == 1);
+}
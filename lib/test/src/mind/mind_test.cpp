@@ -18,9 +18,12 @@
  */
 
 #include <stddef.h>
+#include <atomic>
+#include <chrono>
 #include <iostream>
 #include <iterator>
 #include <string>
+#include <thread>
 #include <vector>
 
 #include <gtest/gtest.h>
@@ -34,6 +37,8 @@
 
 #include "../../../src/representations/markdown/markdown_outline_representation.h"
 
+#include "../test_utils.h"
+
 extern char* getMindforgerGitHomePath();
 
 using namespace std;
@@ -313,3 +318,181 @@ TEST(MindTestCase, CommonWordsBlacklist) {
     ASSERT_TRUE(blacklist.findWord("you"));
     ASSERT_TRUE(blacklist.findWord("the"));
 }
+
+static vector<string> outlinesMapKeys(const m8r::Outline* outlinesMap)
+{
+    vector<string> keys{};
+    for(m8r::Note* n:outlinesMap->getNotes()) {
+        keys.push_back(n->getLinkByName(m8r::LINK_NAME_OUTLINE_KEY)->getUrl());
+    }
+    return keys;
+}
+
+TEST(MindTestCase, OutlinesMapSynchronization) {
+    m8r::TestSandbox box{"", true};
+    box.addMdFile("a.md", "# A\nA.\n");
+    box.addMdFile("b.md", "# B\nB.\n");
+    string cPath = box.addMdFile("c.md", "# C\nC.\n");
+    m8r::MarkdownRepositoryConfigurationRepresentation repositoryConfigRepresentation{};
+    m8r::Configuration& config = m8r::Configuration::getInstance();
+    config.clear();
+    config.setConfigFilePath(box.configPath);
+    config.setActiveRepository(config.addRepository(m8r::RepositoryIndexer::getRepositoryForPath(box.repositoryPath)), repositoryConfigRepresentation);
+
+    vector<string> keys{};
+    {
+        m8r::Mind mind(config);
+        mind.learn();
+
+        // new map (nothing to parse) > rendered from scratch
+        m8r::Outline::Patch patch{};
+        EXPECT_TRUE(mind.outlinesMapPrepare());
+        m8r::Outline* outlinesMap = mind.outlinesMapGet(&patch);
+        ASSERT_NE(nullptr, outlinesMap);
+        EXPECT_EQ(3, outlinesMap->getNotesCount());
+        EXPECT_EQ(m8r::Outline::Patch::Diff::MOVE, patch.diff);
+        EXPECT_EQ(2, patch.count);
+
+        // no change
+        EXPECT_EQ(outlinesMap, mind.outlinesMapGet(&patch));
+        EXPECT_EQ(m8r::Outline::Patch::Diff::NO, patch.diff);
+
+        // renamed O > single N changed in place
+        keys = outlinesMapKeys(outlinesMap);
+        mind.remind().getOutline(keys[1])->setName("Renamed");
+        mind.outlinesMapGet(&patch);
+        EXPECT_EQ(m8r::Outline::Patch::Diff::CHANGE, patch.diff);
+        EXPECT_EQ(1, patch.start);
+        EXPECT_EQ(0, patch.count);
+        EXPECT_EQ("Renamed", outlinesMap->getNotes()[1]->getName());
+
+        // new O is prepended, removed O is dropped
+        string dPath = box.addMdFile("d.md", "# D\nD.\n");
+        mind.remind().learnOutline(dPath);
+        remove(cPath.c_str());
+        mind.remind().unlearnOutlines(cPath);
+        mind.outlinesMapGet(&patch);
+        EXPECT_EQ(m8r::Outline::Patch::Diff::MOVE, patch.diff);
+        EXPECT_EQ(0, patch.start);
+        EXPECT_EQ(2, patch.count);
+        keys = outlinesMapKeys(outlinesMap);
+        ASSERT_EQ(3, keys.size());
+        EXPECT_EQ(dPath, keys[0]);
+        EXPECT_EQ(keys.end(), find(keys.begin(), keys.end(), cPath));
+        for(const string& k:keys) {
+            EXPECT_NE(nullptr, mind.findOutlineByKey(k));
+        }
+        mind.outlinesMapRemember();
+    }
+
+    // map loaded from file in a worker thread
+    m8r::Mind mind(config);
+    mind.learn();
+    while(!mind.outlinesMapPrepare()) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    m8r::Outline::Patch patch{};
+    m8r::Outline* outlinesMap = mind.outlinesMapGet(&patch);
+    EXPECT_EQ(m8r::Outline::Patch::Diff::MOVE, patch.diff);
+    EXPECT_EQ(keys, outlinesMapKeys(outlinesMap));
+}
+
+TEST(MindTestCase, TagsCardinality) {
+    m8r::TestSandbox box{"", true};
+    string aPath = box.addMdFile("a.md",
+        "# A <!-- Metadata: type: Outline; tags: cool,todo; -->\nA.\n\n"
+        "## N1 <!-- Metadata: type: Note; tags: cool; -->\nN1.\n\n"
+        "## N2 <!-- Metadata: type: Note; tags: none; -->\nN2.\n");
+    string bPath = box.addMdFile("b.md",
+        "# B\nB.\n\n"
+        "## N3 <!-- Metadata: type: Note; tags: cool; -->\nN3.\n");
+    m8r::MarkdownRepositoryConfigurationRepresentation repositoryConfigRepresentation{};
+    m8r::Configuration& config = m8r::Configuration::getInstance();
+    config.clear();
+    config.setConfigFilePath(box.configPath);
+    config.setActiveRepository(config.addRepository(m8r::RepositoryIndexer::getRepositoryForPath(box.repositoryPath)), repositoryConfigRepresentation);
+
+    m8r::Mind mind(config);
+    mind.learn();
+    m8r::Ontology& ontology = mind.getOntology();
+    const m8r::Tag* cool = ontology.findOrCreateTag("cool");
+    const m8r::Tag* todo = ontology.findOrCreateTag("todo");
+    const m8r::Tag* none = ontology.findOrCreateTag("none");
+
+    // learned Os and Ns are counted, none tag is not in cloud
+    map<const m8r::Tag*,int> cardinality{};
+    mind.getTagsCardinality(cardinality);
+    EXPECT_EQ(3, cardinality[cool]);
+    EXPECT_EQ(1, cardinality[todo]);
+    EXPECT_EQ(cardinality.end(), cardinality.find(none));
+    EXPECT_EQ(1, mind.getOutlineTagCardinality(*cool));
+    EXPECT_EQ(2, mind.getNoteTagCardinality(*cool));
+    EXPECT_EQ(3, mind.getTagCardinality(*cool));
+
+    // remembered O is recounted
+    m8r::Outline* a = mind.remind().getOutline(aPath);
+    ASSERT_NE(nullptr, a);
+    a->getNotes()[1]->addTag(todo);
+    mind.remember(a);
+    EXPECT_EQ(2, mind.getTagCardinality(*todo));
+    EXPECT_EQ(1, mind.getNoteTagCardinality(*todo));
+
+    // forgotten O is no longer counted
+    mind.forget(mind.remind().getOutline(bPath));
+    cardinality.clear();
+    mind.getTagsCardinality(cardinality);
+    EXPECT_EQ(2, cardinality[cool]);
+    EXPECT_EQ(2, cardinality[todo]);
+}
+
+class CountingChatListener : public m8r::WingmanChatListener
+{
+public:
+    std::atomic<int> tokens;
+
+    explicit CountingChatListener() : tokens{0} {}
+
+    virtual bool onToken(const string&) override {
+        tokens++;
+        return true;
+    }
+};
+
+TEST(MindTestCase, WingmanChatStream) {
+    m8r::TestSandbox box{"", true};
+    m8r::MarkdownRepositoryConfigurationRepresentation repositoryConfigRepresentation{};
+    m8r::Configuration& config = m8r::Configuration::getInstance();
+    config.clear();
+    config.setConfigFilePath(box.configPath);
+    config.setActiveRepository(config.addRepository(m8r::RepositoryIndexer::getRepositoryForPath(box.repositoryPath)), repositoryConfigRepresentation);
+    config.setWingmanLlmProvider(m8r::WingmanLlmProviders::WINGMAN_PROVIDER_MOCK);
+
+    std::shared_ptr<m8r::CommandWingmanChat> command{};
+    std::shared_ptr<CountingChatListener> listener{};
+    std::shared_future<bool> result{};
+    {
+        m8r::Mind mind(config);
+        for(int i=0; i<2; i++) {
+            command = std::make_shared<m8r::CommandWingmanChat>(m8r::CommandWingmanChat{
+                "Hi!", "", m8r::WingmanStatusCode::WINGMAN_STATUS_CODE_ERROR, "", "", 0, 0, "", false});
+            listener = std::make_shared<CountingChatListener>();
+            result = mind.wingmanChatStream(command, listener);
+            ASSERT_TRUE(result.get());
+            EXPECT_EQ(m8r::WingmanStatusCode::WINGMAN_STATUS_CODE_OK, command->status);
+            EXPECT_FALSE(command->answerMarkdown.empty());
+            EXPECT_LT(0, listener->tokens.load());
+            // 2nd answer is served from the cache
+            EXPECT_EQ(i == 1, command->cached);
+        }
+
+        // stream in flight is cancelled and joined on Mind destruction
+        command = std::make_shared<m8r::CommandWingmanChat>(m8r::CommandWingmanChat{
+            "Bye!", "", m8r::WingmanStatusCode::WINGMAN_STATUS_CODE_ERROR, "", "", 0, 0, "", false});
+        listener = std::make_shared<CountingChatListener>();
+        result = mind.wingmanChatStream(command, listener);
+    }
+    EXPECT_EQ(std::future_status::ready, result.wait_for(std::chrono::seconds(0)));
+    EXPECT_TRUE(listener->isCancelled());
+
+    config.setWingmanLlmProvider(m8r::WingmanLlmProviders::WINGMAN_PROVIDER_NONE);
+}
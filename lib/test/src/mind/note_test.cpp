@@ -933,3 +933,64 @@ TEST(NoteTestCase, DirectNoteChildren) {
     EXPECT_EQ("2", directChildren[1]->getName());
     EXPECT_EQ("4", directChildren[2]->getName());
 }
+
+TEST(NoteTestCase, CompactLayout) {
+    m8r::Ontology ontology{};
+    m8r::Outline* o = new m8r::Outline{ontology.getDefaultOutlineType()};
+    o->setName("O");
+    o->setKey("o.md");
+    m8r::Note* n1 = new m8r::Note{ontology.getDefaultNoteType(), o};
+    m8r::Note* n2 = new m8r::Note{ontology.getDefaultNoteType(), o};
+    o->addNote(n1);
+    o->addNote(n2);
+    m8r::StringPool& pool = m8r::StringPool::getInstance();
+    size_t poolSize = pool.size();
+
+    // IDs
+    EXPECT_NE(n1->getId(), n2->getId());
+    EXPECT_NE(o->getId(), n1->getId());
+
+    // equal names are interned just once
+    n1->setName("Introduction");
+    n2->setName("Introduction");
+    EXPECT_EQ(&n1->getName(), &n2->getName());
+    EXPECT_EQ(&n1->getName(), &n1->getAutolinkingAlias());
+    EXPECT_EQ(poolSize+1, pool.size());
+    EXPECT_EQ("o.md#introduction", n1->getKey());
+
+    n2->setName("GTD: Getting Things Done");
+    EXPECT_EQ("GTD", n2->getAutolinkingAlias());
+    EXPECT_EQ("GTD", n2->getAutolinkingAbbr());
+    EXPECT_EQ("Getting Things Done", n2->getAutolinkingName());
+    EXPECT_EQ("", n1->getAutolinkingAbbr());
+    EXPECT_EQ(poolSize+4, pool.size());
+
+    // tags are inline unless there are more of them
+    n1->addTag(ontology.findOrCreateTag(m8r::Tag::KeyCool()));
+    n1->addTag(ontology.findOrCreateTag(m8r::Tag::KeyTodo()));
+    n1->addTag(ontology.findOrCreateTag(m8r::Tag::KeyCool()));
+    EXPECT_EQ(2, n1->getTags()->size());
+    EXPECT_TRUE(n1->getTags()->isInline());
+    n1->addTag(ontology.findOrCreateTag(m8r::Tag::KeyDone()));
+    EXPECT_EQ(3, n1->getTags()->size());
+    EXPECT_FALSE(n1->getTags()->isInline());
+    EXPECT_TRUE(n1->hasTag(ontology.findOrCreateTag(m8r::Tag::KeyTodo())));
+    EXPECT_EQ(m8r::Tag::KeyCool(), n1->getPrimaryTag()->getName());
+
+    // relationships are kept by central store
+    {
+        m8r::RelationshipType dependsOn{m8r::RelationshipType::KeyDependsOn(), nullptr, m8r::Color::MF_RED()};
+        m8r::Relationship r{"r", n1, &dependsOn, n2};
+        ontology.getRelationships().add(&r);
+        EXPECT_EQ(1, ontology.getRelationships().getRelationshipsCount(n1));
+        EXPECT_EQ(1, ontology.getRelationships().getRelationshipsCount(n2));
+        EXPECT_EQ(0, ontology.getRelationships().getRelationshipsCount(o));
+        ontology.getRelationships().remove(n2);
+        EXPECT_EQ(0, ontology.getRelationships().size());
+        EXPECT_EQ(0, ontology.getRelationships().getRelationshipsCount(n1));
+    }
+
+    // names are dropped from pool w/ their Things
+    delete o;
+    EXPECT_EQ(poolSize-1, pool.size());
+}
@@ -0,0 +1,194 @@
+/*
+ outlines_snapshot_test.cpp     MindForger Outlines snapshot test
+
+ Copyright (C) 2016-2025 Martin Dvorak <martin.dvorak@mindforger.com>
+
+ This program is free software; you can redistribute it and/or
+ modify it under the terms of the GNU General Public License
+ as published by the Free Software Foundation; either version 2
+ of the License, or (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <cstdio>
+#include <vector>
+#include <map>
+#include <string>
+#include <thread>
+
+#include <gtest/gtest.h>
+
+#include "../test_utils.h"
+#include "../../../src/mind/mind.h"
+#include "../../../src/persistence/outlines_snapshot.h"
+#include "../../../src/representations/markdown/markdown_repository_configuration_representation.h"
+
+using namespace std;
+
+extern char* getMindforgerGitHomePath();
+
+namespace m8r {
+
+/*
+ * Outline as string incl. values which are not serialized to Markdown.
+ */
+void dumpLearnedOutlines(Mind& mind, map<string,string>& dump)
+{
+    MarkdownOutlineRepresentation mdr{mind.getOntology(), nullptr};
+    dump.clear();
+    for(Outline* o:mind.remind().getOutlines()) {
+        string* md = mdr.to(o);
+        string& d = dump[o->getKey()];
+        d += *md;
+        d += "\nbytesize: " + std::to_string(o->getBytesize());
+        d += "\nmodifiedPretty: " + o->getModifiedPretty();
+        d += "\nformat: " + std::to_string(static_cast<int>(o->getFormat()));
+        d += "\ntype: " + o->getType()->getName();
+        for(Note* n:o->getNotes()) {
+            d += "\nN: " + n->getName() + " " + n->getType()->getName()
+                 + " " + n->getModifiedPretty() + " " + n->getReadPretty()
+                 + " " + std::to_string(n->getDescription().size());
+        }
+        delete md;
+    }
+}
+
+void learnSnapshotRepository(TestSandbox& box, map<string,string>& dump, size_t& hits, size_t& misses)
+{
+    MarkdownRepositoryConfigurationRepresentation repositoryConfigRepresentation{};
+    Configuration& config = Configuration::getInstance();
+    config.clear();
+    config.setConfigFilePath(box.configPath);
+    config.setActiveRepository(
+        config.addRepository(RepositoryIndexer::getRepositoryForPath(box.repositoryPath)),
+        repositoryConfigRepresentation
+    );
+    Mind mind(config);
+    mind.learn();
+    mind.think().get();
+
+    dumpLearnedOutlines(mind, dump);
+    hits = mind.remind().getOutlinesSnapshot().getHits();
+    misses = mind.remind().getOutlinesSnapshot().getMisses();
+}
+
+} // m8r namespace
+
+TEST(OutlinesSnapshotTestCase, WarmStart)
+{
+    // GIVEN
+    m8r::TestSandbox box{"", true};
+    string resourcesPath{string{getMindforgerGitHomePath()} + "/lib/test/resources/"};
+    for(auto r:{"basic-repository", "bugs-repository", "links-repository", "i18n-repository", "universe-repository"}) {
+        string target{box.repositoryPath + "/memory/" + r};
+        m8r::createDirectory(target);
+        m8r::copyDirectoryRecursively((resourcesPath + r + "/memory").c_str(), target.c_str());
+    }
+    m8r::copyFile(
+        resourcesPath + "benchmark-repository/memory/meta.md",
+        box.repositoryPath + "/memory/meta.md");
+    // virgin Outlines are skipped by learn() > never snapshotted
+    std::remove((box.repositoryPath + "/memory/bugs-repository/bug-140-syntax-highlighting.md").c_str());
+
+    map<string,string> cold{};
+    map<string,string> warm{};
+    size_t hits, misses;
+
+    // WHEN cold start
+    m8r::learnSnapshotRepository(box, cold, hits, misses);
+
+    // THEN everything parsed and snapshot written
+    ASSERT_LT(10, cold.size());
+    EXPECT_EQ(0, hits);
+    EXPECT_LE(cold.size(), misses);
+    // snapshot is kept in per-user cache, not in the (synchronized) repository
+    string snapshotPath{m8r::Configuration::getInstance().getOutlinesSnapshotPath()};
+    ASSERT_TRUE(m8r::isFile(snapshotPath.c_str()));
+    EXPECT_EQ(string::npos, snapshotPath.find(box.repositoryPath));
+    EXPECT_NE(string::npos, snapshotPath.find(m8r::DIRNAME_M8R_CACHE));
+
+    // WHEN warm start
+    m8r::learnSnapshotRepository(box, warm, hits, misses);
+
+    // THEN Outlines are deserialized and identical to parsed ones
+    EXPECT_EQ(cold.size(), hits);
+    EXPECT_EQ(0, misses);
+    ASSERT_EQ(cold.size(), warm.size());
+    for(auto& o:cold) {
+        EXPECT_EQ(o.second, warm[o.first]) << o.first;
+    }
+
+    // WHEN a file is changed
+    string changedPath{box.repositoryPath + "/memory/meta.md"};
+    string* changed = m8r::fileToString(changedPath);
+    changed->append("\n# Snapshot Test Note\nNew Note.\n");
+    m8r::stringToFile(changedPath, *changed);
+    delete changed;
+    m8r::learnSnapshotRepository(box, warm, hits, misses);
+
+    // THEN only changed file is parsed
+    EXPECT_EQ(cold.size()-1, hits);
+    EXPECT_EQ(1, misses);
+    EXPECT_NE(string::npos, warm[changedPath].find("Snapshot Test Note"));
+
+    // WHEN file is touched w/o content change (modification time differs)
+    this_thread::sleep_for(chrono::milliseconds(1100));
+    changed = m8r::fileToString(changedPath);
+    m8r::stringToFile(changedPath, *changed);
+    delete changed;
+    string* snapshot = m8r::fileToString(snapshotPath);
+    m8r::learnSnapshotRepository(box, warm, hits, misses);
+
+    // THEN content hash (of changed file computed by parser) validates the snapshot entry
+    EXPECT_EQ(cold.size(), hits);
+    EXPECT_EQ(0, misses);
+    // AND snapshot is rewritten w/ the new modification time
+    string* rewritten = m8r::fileToString(snapshotPath);
+    EXPECT_EQ(snapshot->size(), rewritten->size());
+    EXPECT_NE(*snapshot, *rewritten);
+    delete snapshot;
+    delete rewritten;
+}
+
+TEST(OutlinesSnapshotTestCase, ContentHash)
+{
+    // lexer hashes lines, snapshot hashes file content - hashes must match
+    for(string content:{"", "\n", "# O\n", "# O\nDescription.", "# O\n\n## N\r\nDescription.\n\n"}) {
+        vector<string*> lines{};
+        m8r::stringToLines(&content, lines);
+        EXPECT_EQ(m8r::OutlinesSnapshot::contentHash(content), m8r::linesHash64(lines)) << content;
+        for(string* l:lines) {
+            delete l;
+        }
+    }
+}
+
+TEST(OutlinesSnapshotTestCase, CorruptedSnapshot)
+{
+    // GIVEN
+    m8r::TestSandbox box{"", true};
+    box.addMdFile("snapshot.md", "# Snapshot\nOutline.\n\n## Note\nNote.\n");
+    map<string,string> cold{};
+    map<string,string> warm{};
+    size_t hits, misses;
+    m8r::learnSnapshotRepository(box, cold, hits, misses);
+
+    // WHEN snapshot is truncated
+    string snapshotPath{m8r::Configuration::getInstance().getOutlinesSnapshotPath()};
+    string* snapshot = m8r::fileToString(snapshotPath);
+    m8r::stringToFile(snapshotPath, snapshot->substr(0, snapshot->size()/2));
+    delete snapshot;
+    m8r::learnSnapshotRepository(box, warm, hits, misses);
+
+    // THEN it's ignored and Outlines are parsed
+    EXPECT_EQ(0, hits);
+    EXPECT_EQ(1, misses);
+    EXPECT_EQ(cold, warm);
+}
@@ -0,0 +1,172 @@
+/*
+ relationship_graph_test.cpp     MindForger thinking notebook
+
+ Copyright (C) 2016-2025 Martin Dvorak <martin.dvorak@mindforger.com>
+
+ This program is free software; you can redistribute it and/or
+ modify it under the terms of the GNU General Public License
+ as published by the Free Software Foundation; either version 2
+ of the License, or (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+#include <algorithm>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "../../../src/mind/relationship_graph.h"
+#include "../../../src/mind/ontology/ontology.h"
+
+using namespace std;
+
+namespace m8r {
+
+Note* createRelationshipGraphNote(Ontology& ontology, Outline* o, const string& name, const string& description)
+{
+    Note* n = new Note{ontology.getDefaultNoteType(), o};
+    n->setName(name);
+    if(!description.empty()) {
+        n->addDescriptionLine(new string{description});
+    }
+    o->addNote(n);
+    return n;
+}
+
+bool containsThing(const vector<Thing*>& things, const Thing* thing)
+{
+    return std::find(things.begin(), things.end(), thing) != things.end();
+}
+
+} // m8r namespace
+
+TEST(RelationshipGraphTestCase, LinkToKey)
+{
+    string key{};
+
+    // same O section, sibling O, relative paths and titles
+    EXPECT_TRUE(m8r::RelationshipGraph::linkToKey("/r/memory/a.md", "#Section", key));
+    EXPECT_EQ("/r/memory/a.md#section", key);
+    EXPECT_TRUE(m8r::RelationshipGraph::linkToKey("/r/memory/a.md", "b.md", key));
+    EXPECT_EQ("/r/memory/b.md", key);
+    EXPECT_TRUE(m8r::RelationshipGraph::linkToKey("/r/memory/x/a.md", "../y/./b%20c.md#s-1", key));
+    EXPECT_EQ("/r/memory/y/b c.md#s-1", key);
+    EXPECT_TRUE(m8r::RelationshipGraph::linkToKey("a.md", "b.md", key));
+    EXPECT_EQ("b.md", key);
+
+    // not O/N
+    EXPECT_FALSE(m8r::RelationshipGraph::linkToKey("/r/memory/a.md", "https://mindforger.com/a.md", key));
+    EXPECT_FALSE(m8r::RelationshipGraph::linkToKey("/r/memory/a.md", "mailto:me@mindforger.com", key));
+    EXPECT_FALSE(m8r::RelationshipGraph::linkToKey("/r/memory/a.md", "image.png", key));
+
+    vector<string*> lines{};
+    string line{"See [A](a.md \"title\"), [B](<b.md#x>) and [broken](c.md"};
+    lines.push_back(&line);
+    vector<string> urls{};
+    m8r::RelationshipGraph::parseLinks(lines, urls);
+    ASSERT_EQ(2, urls.size());
+    EXPECT_EQ("a.md", urls[0]);
+    EXPECT_EQ("b.md#x", urls[1]);
+}
+
+TEST(RelationshipGraphTestCase, BuildAndUpdate)
+{
+    // GIVEN
+    m8r::Ontology ontology{};
+    m8r::Outline* a = new m8r::Outline{ontology.getDefaultOutlineType()};
+    a->setName("A");
+    a->setKey("/m/a.md");
+    a->addTag(ontology.findOrCreateTag(m8r::Tag::KeyCool()));
+    m8r::Note* a1 = m8r::createRelationshipGraphNote(ontology, a, "First", "Go to [B2](b.md#second) and [C](c.md).");
+    m8r::Note* a2 = m8r::createRelationshipGraphNote(ontology, a, "Second", "Back to [first](#first).");
+    a2->addTag(ontology.findOrCreateTag(m8r::Tag::KeyCool()));
+    m8r::Outline* b = new m8r::Outline{ontology.getDefaultOutlineType()};
+    b->setName("B");
+    b->setKey("/m/b.md");
+    m8r::Note* b1 = m8r::createRelationshipGraphNote(ontology, b, "Second", "");
+    b1->addLink(new m8r::Link{"a", "a.md"});
+
+    // WHEN
+    m8r::RelationshipGraph graph{};
+    graph.build({a, b});
+
+    // THEN N/O links, backlinks, tags and membership
+    vector<m8r::Thing*> things{};
+    graph.getNeighbours(a1, m8r::RelationshipGraph::EdgeType::LINK, m8r::RelationshipGraph::ThingType::NOTE, true, things);
+    ASSERT_EQ(1, things.size());
+    EXPECT_EQ(b1, things[0]);
+    things.clear();
+    graph.getNeighbours(a1, m8r::RelationshipGraph::EdgeType::LINK, m8r::RelationshipGraph::ThingType::NOTE, false, things);
+    ASSERT_EQ(1, things.size());
+    EXPECT_EQ(a2, things[0]);
+    things.clear();
+    graph.getNeighbours(a, m8r::RelationshipGraph::EdgeType::LINK, m8r::RelationshipGraph::ThingType::NOTE, false, things);
+    EXPECT_EQ(1, things.size());
+    things.clear();
+    graph.getNeighbours(ontology.findOrCreateTag(m8r::Tag::KeyCool()), m8r::RelationshipGraph::EdgeType::TAG, m8r::RelationshipGraph::ThingType::NOTE, false, things);
+    EXPECT_EQ(1, things.size());
+    things.clear();
+    graph.getNeighbours(ontology.findOrCreateTag(m8r::Tag::KeyCool()), m8r::RelationshipGraph::EdgeType::TAG, m8r::RelationshipGraph::ThingType::OUTLINE, false, things);
+    EXPECT_EQ(1, things.size());
+    things.clear();
+    graph.getNeighbours(a, m8r::RelationshipGraph::EdgeType::MEMBER, m8r::RelationshipGraph::ThingType::NOTE, true, things);
+    EXPECT_EQ(2, things.size());
+    ASSERT_EQ(1, graph.getUnresolved(a1).size());
+    EXPECT_EQ("/m/c.md", graph.getUnresolved(a1)[0]);
+
+    // THEN k-hop expansion w/o members: a2 > a1 > b1 > a
+    things.clear();
+    graph.expand(a2, 1, 100, things, false);
+    EXPECT_EQ(1, things.size());
+    things.clear();
+    graph.expand(a2, 3, 100, things, false);
+    EXPECT_EQ(3, things.size());
+    EXPECT_TRUE(m8r::containsThing(things, a));
+    things.clear();
+    graph.expand(a2, 3, 2, things, false);
+    EXPECT_EQ(2, things.size());
+
+    // WHEN target O of unresolved link is created
+    m8r::Outline* c = new m8r::Outline{ontology.getDefaultOutlineType()};
+    c->setName("C");
+    c->setKey("/m/c.md");
+    graph.update(c);
+    // THEN link is resolved
+    EXPECT_EQ(0, graph.getUnresolvedCount());
+    things.clear();
+    graph.getNeighbours(c, m8r::RelationshipGraph::EdgeType::LINK, m8r::RelationshipGraph::ThingType::NOTE, false, things);
+    EXPECT_EQ(1, things.size());
+
+    // WHEN linked N is renamed
+    b1->setName("Renamed");
+    graph.update(b);
+    // THEN link becomes unresolved
+    EXPECT_EQ(1, graph.getUnresolvedCount());
+    things.clear();
+    graph.getNeighbours(a1, m8r::RelationshipGraph::EdgeType::LINK, m8r::RelationshipGraph::ThingType::NOTE, true, things);
+    EXPECT_EQ(0, things.size());
+
+    // WHEN N is forgotten
+    size_t vertices = graph.getVerticesCount();
+    a->forgetNote(a2);
+    graph.update(a);
+    // THEN its vertex and (back)links are removed
+    EXPECT_EQ(vertices-1, graph.getVerticesCount());
+    EXPECT_EQ(1, graph.getIncoming(a1).size());
+
+    // WHEN O is removed
+    graph.remove(c);
+    // THEN links to it are unresolved
+    EXPECT_EQ(2, graph.getUnresolvedCount());
+
+    delete a;
+    delete b;
+    delete c;
+}
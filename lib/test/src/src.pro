@@ -123,32 +123,49 @@ win32{
 SOURCES += \
     ./test_utils.cpp \
     ./indexer/repository_indexer_test.cpp \
+    ./indexer/repository_watcher_test.cpp \
     ./config/configuration_test.cpp \
     ./markdown/markdown_test.cpp \
     ./html/html_test.cpp \
     ./json/json_test.cpp \
+    ./csv/csv_test.cpp \
     ../benchmark/markdown_benchmark.cpp \
     ../benchmark/html_benchmark.cpp \
     ../benchmark/trie_benchmark.cpp \
     ../benchmark/ai_benchmark.cpp \
+    ../benchmark/string_benchmark.cpp \
+    ../benchmark/memory_benchmark.cpp \
+    ../benchmark/synthetic_repository.cpp \
+    ../benchmark/benchmark_report.cpp \
+    ./benchmark/synthetic_repository_test.cpp \
     ./ai/nlp_test.cpp \
     ./ai/autolinking_test.cpp \
     ./ai/autolinking_cmark_test.cpp \
+    ./ai/wingman_test.cpp \
+    ./ai/wingman_http_stand_in.cpp \
+    ./ai/aa_model_test.cpp \
     ./gear/datetime_test.cpp \
     ./gear/string_utils_test.cpp \
     ./gear/file_utils_test.cpp \
     ./gear/trie_test.cpp \
+    ./gear/instrumentation_test.cpp \
+    ./gear/fuzzy_finder_test.cpp \
+    ./gear/executor_test.cpp \
     ./mind/fts_test.cpp \
+    ./mind/lazy_memory_test.cpp \
     ./mind/memory_test.cpp \
     ./mind/mind_test.cpp \
     ./mind/note_test.cpp \
     ./mindforger_lib_unit_tests.cpp \
     ./mind/organizer_test.cpp \
     ./mind/outline_test.cpp \
+    ./mind/relationship_graph_test.cpp \
+    ./mind/outlines_snapshot_test.cpp \
     ./mind/filesystem_information_test.cpp
 
 HEADERS += \
-    ./test_gear.h
+    ./test_gear.h \
+    ./ai/wingman_http_stand_in.h
 
 # ########################################
 # Diagnostics